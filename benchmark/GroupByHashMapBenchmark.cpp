@@ -147,6 +147,8 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
 
         runTests<AvgExpression>(results, multiplicity, valueIdType, true,
                                 false);
+        runTests<AvgExpression>(results, multiplicity, valueIdType, true,
+                                false, numParallelThreads);
 
         //-----------------------------------------------------------------------------------------------------
         runTests<SumExpression>(results, multiplicity, valueIdType, false,
@@ -154,6 +156,8 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
 
         runTests<SumExpression>(results, multiplicity, valueIdType, true,
                                 false);
+        runTests<SumExpression>(results, multiplicity, valueIdType, true,
+                                false, numParallelThreads);
 
         //-----------------------------------------------------------------------------------------------------
         runTests<CountExpression>(results, multiplicity, valueIdType, false,
@@ -161,6 +165,8 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
 
         runTests<CountExpression>(results, multiplicity, valueIdType, true,
                                   false);
+        runTests<CountExpression>(results, multiplicity, valueIdType, true,
+                                  false, numParallelThreads);
 
         //-----------------------------------------------------------------------------------------------------
         runTests<MinExpression>(results, multiplicity, valueIdType, false,
@@ -168,6 +174,8 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
 
         runTests<MinExpression>(results, multiplicity, valueIdType, true,
                                 false);
+        runTests<MinExpression>(results, multiplicity, valueIdType, true,
+                                false, numParallelThreads);
 
         //-----------------------------------------------------------------------------------------------------
         runTests<MaxExpression>(results, multiplicity, valueIdType, false,
@@ -175,6 +183,8 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
 
         runTests<MaxExpression>(results, multiplicity, valueIdType, true,
                                 false);
+        runTests<MaxExpression>(results, multiplicity, valueIdType, true,
+                                false, numParallelThreads);
       }
     }
   }
@@ -188,6 +198,9 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
 
         runTests<AvgExpression, SumExpression>(results, multiplicity,
                                                valueIdType, true, false);
+        runTests<AvgExpression, SumExpression>(results, multiplicity,
+                                               valueIdType, true, false,
+                                               numParallelThreads);
 
         //-----------------------------------------------------------------------------------------------------
         runTests<AvgExpression, MaxExpression>(results, multiplicity,
@@ -195,6 +208,9 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
 
         runTests<AvgExpression, MaxExpression>(results, multiplicity,
                                                valueIdType, true, false);
+        runTests<AvgExpression, MaxExpression>(results, multiplicity,
+                                               valueIdType, true, false,
+                                               numParallelThreads);
 
         //-----------------------------------------------------------------------------------------------------
         runTests<AvgExpression, MinExpression>(results, multiplicity,
@@ -202,6 +218,9 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
 
         runTests<AvgExpression, MinExpression>(results, multiplicity,
                                                valueIdType, true, false);
+        runTests<AvgExpression, MinExpression>(results, multiplicity,
+                                               valueIdType, true, false,
+                                               numParallelThreads);
 
         //-----------------------------------------------------------------------------------------------------
         runTests<AvgExpression, CountExpression>(results, multiplicity,
@@ -209,6 +228,9 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
 
         runTests<AvgExpression, CountExpression>(results, multiplicity,
                                                  valueIdType, true, false);
+        runTests<AvgExpression, CountExpression>(results, multiplicity,
+                                                 valueIdType, true, false,
+                                                 numParallelThreads);
       }
     }
   }
@@ -219,6 +241,9 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
                                       ValueIdType::Strings, false, false);
       runTests<GroupConcatExpression>(results, multiplicity,
                                       ValueIdType::Strings, true, false);
+      runTests<GroupConcatExpression>(results, multiplicity,
+                                      ValueIdType::Strings, true, false,
+                                      numParallelThreads);
     }
   }
 
@@ -240,6 +265,9 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
   static constexpr size_t multiplicities[] = {
       5'000'000, 500'000, 50'000, 5'000, 500, 50, 5, 3, 1};
   static constexpr size_t randomStringLength = 3;
+  // The number of threads for the parallel hash map aggregation, which is
+  // compared to the aggregation by a single thread.
+  static constexpr size_t numParallelThreads = 8;
 
   template <typename T>
   static void computeGroupBy(QueryExecutionContext* qec,
@@ -338,7 +366,8 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
 
   template <typename T1, typename T2 = std::nullopt_t>
   void runTests(BenchmarkResults& results, size_t multiplicity,
-                ValueIdType valueTypes, bool optimizationEnabled, bool sorted) {
+                ValueIdType valueTypes, bool optimizationEnabled, bool sorted,
+                size_t numThreads = 1) {
     // For coin flipping if `ValueIdType` is `RandomlyMixed`
     std::uniform_int_distribution<uint8_t> distribution(0, 1);
 
@@ -354,13 +383,15 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
     buffer << "M: " << multiplicity
            << ", T: " << determineTypeString(valueTypes)
            << ", OP: " << opString.str() << ", MAP: " << std::boolalpha
-           << optimizationEnabled << ", SORTED: " << sorted;
+           << optimizationEnabled << ", SORTED: " << sorted
+           << ", THREADS: " << numThreads;
     auto& group = results.addGroup(buffer.str());
     group.metadata().addKeyValuePair("Rows", numInputRows);
     group.metadata().addKeyValuePair("Multiplicity", multiplicity);
     group.metadata().addKeyValuePair("Type", determineTypeString(valueTypes));
     group.metadata().addKeyValuePair("Sorted", sorted);
     group.metadata().addKeyValuePair("HashMap", optimizationEnabled);
+    group.metadata().addKeyValuePair("Threads", numThreads);
     group.metadata().addKeyValuePair("Operation", opString.str());
 
     // Create `ValuesForTesting` object
@@ -426,6 +457,8 @@ class GroupByHashMapBenchmark : public BenchmarkInterface {
         qec, std::move(table), variables, false, sortedColumns,
         std::move(localVocab));
 
+    setRuntimeParameter<&RuntimeParameters::groupByHashMapNumThreads_>(
+        numThreads);
     for (size_t i = 0; i < numMeasurements; i++)
       group.addMeasurement(std::to_string(i), [&]() {
         if constexpr (ql::concepts::same_as<T2, std::nullopt_t>) {
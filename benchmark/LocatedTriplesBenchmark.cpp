@@ -0,0 +1,168 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "index/LocatedTriples.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/CancellationHandle.h"
+#include "util/Random.h"
+
+namespace ad_benchmark {
+
+// Benchmarks for the data structures that store the located triples (the delta
+// triples of SPARQL UPDATEs) per block of a permutation: locating triples,
+// adding and erasing them in batches, merging them into the blocks of the
+// index during a scan, and copying them for a snapshot.
+class LocatedTriplesBenchmark : public BenchmarkInterface {
+  // The synthetic permutation consists of `numBlocks` blocks. Block `i`
+  // contains the subjects `[i * subjectsPerBlock, (i + 1) * subjectsPerBlock)`
+  // with one triple per subject.
+  static constexpr size_t numBlocks = 1'000;
+  static constexpr size_t subjectsPerBlock = 1'000;
+  static constexpr size_t graph = 1;
+
+  static Id V(uint64_t index) {
+    return Id::makeFromVocabIndex(VocabIndex::make(index));
+  }
+
+  static CompressedBlockMetadata::PermutedTriple permutedTriple(uint64_t s,
+                                                                uint64_t p,
+                                                                uint64_t o) {
+    return {V(s), V(p), V(o), V(graph)};
+  }
+
+  // The metadata of the blocks of the synthetic permutation.
+  static std::vector<CompressedBlockMetadata> makeBlockMetadata() {
+    std::vector<CompressedBlockMetadata> metadata;
+    for (size_t i = 0; i < numBlocks; ++i) {
+      auto first = permutedTriple(i * subjectsPerBlock, 0, 0);
+      auto last = permutedTriple((i + 1) * subjectsPerBlock - 1, 0, 0);
+      metadata.push_back(CompressedBlockMetadata{
+          {{}, subjectsPerBlock, first, last, std::nullopt, false}, i});
+    }
+    return metadata;
+  }
+
+  // The content of the block with the given index.
+  static IdTable makeBlock(size_t blockIndex) {
+    IdTable block{4, ad_utility::makeUnlimitedAllocator<Id>()};
+    block.reserve(subjectsPerBlock);
+    for (size_t s = blockIndex * subjectsPerBlock;
+         s < (blockIndex + 1) * subjectsPerBlock; ++s) {
+      block.push_back(std::array{V(s), V(0), V(0), V(graph)});
+    }
+    return block;
+  }
+
+  // `numTriples` random distinct triples, with subjects from the complete
+  // range of the permutation.
+  static std::vector<IdTriple<0>> makeRandomTriples(size_t numTriples) {
+    ad_utility::SlowRandomIntGenerator<uint64_t> subject{
+        0, numBlocks * subjectsPerBlock - 1, ad_utility::RandomSeed::make(42)};
+    ad_utility::SlowRandomIntGenerator<uint64_t> predicate{
+        1, 100, ad_utility::RandomSeed::make(43)};
+    std::vector<IdTriple<0>> triples;
+    triples.reserve(numTriples);
+    for (size_t i = 0; i < numTriples; ++i) {
+      // The object makes the triples distinct.
+      triples.push_back(IdTriple<0>{
+          std::array{V(subject()), V(predicate()), V(i), V(graph)}});
+    }
+    return triples;
+  }
+
+ public:
+  std::string name() const final {
+    return "Locating, adding, merging, and erasing located triples";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    const std::vector<size_t> numsTriples{1'000, 10'000, 100'000, 1'000'000};
+    std::vector<std::string> rowNames;
+    for (size_t numTriples : numsTriples) {
+      rowNames.push_back(std::to_string(numTriples));
+    }
+    auto& table = results.addTable(
+        "Time for the given number of located triples", rowNames,
+        {"#triples", "locate", "locate (8 threads)", "add (1 batch)",
+         "add (100 batches)", "merge all blocks", "copy and modify 1 block",
+         "erase (1 batch)"});
+
+    const auto metadata = makeBlockMetadata();
+    const qlever::KeyOrder keyOrder{0, 1, 2, 3};
+    auto cancellationHandle =
+        std::make_shared<ad_utility::CancellationHandle<>>();
+
+    for (size_t row = 0; row < numsTriples.size(); ++row) {
+      auto triples = makeRandomTriples(numsTriples.at(row));
+      std::vector<LocatedTriple> locatedTriples;
+      table.addMeasurement(row, 1, [&]() {
+        locatedTriples = LocatedTriple::locateTriplesInPermutation(
+            triples, metadata, keyOrder, true, cancellationHandle);
+      });
+      std::vector<LocatedTriple> locatedInParallel;
+      table.addMeasurement(row, 2, [&]() {
+        locatedInParallel = LocatedTriple::locateTriplesInPermutation(
+            triples, metadata, keyOrder, true, cancellationHandle, 8);
+      });
+      AD_CORRECTNESS_CHECK(locatedInParallel == locatedTriples);
+
+      LocatedTriplesPerBlock locatedTriplesPerBlock;
+      locatedTriplesPerBlock.setOriginalMetadata(metadata);
+      table.addMeasurement(
+          row, 3, [&]() { locatedTriplesPerBlock.add(locatedTriples); });
+
+      // Adding in many small batches (like many small updates) modifies the
+      // same blocks over and over again.
+      table.addMeasurement(row, 4, [&]() {
+        LocatedTriplesPerBlock incremental;
+        ql::span<const LocatedTriple> remaining{locatedTriples};
+        size_t batchSize = remaining.size() / 100;
+        while (!remaining.empty()) {
+          auto batch = remaining.subspan(0, std::min(batchSize + 1,
+                                                     remaining.size()));
+          incremental.add(batch);
+          remaining = remaining.subspan(batch.size());
+        }
+      });
+
+      // Merge the located triples into each block of the permutation (like a
+      // full scan of the permutation).
+      std::vector<IdTable> blocks;
+      for (size_t i = 0; i < numBlocks; ++i) {
+        blocks.push_back(makeBlock(i));
+      }
+      table.addMeasurement(row, 5, [&]() {
+        size_t numRows = 0;
+        for (size_t i = 0; i < numBlocks; ++i) {
+          if (locatedTriplesPerBlock.containsTriples(i)) {
+            numRows +=
+                locatedTriplesPerBlock.mergeTriples(i, blocks.at(i), 3, true)
+                    .numRows();
+          }
+        }
+        AD_CORRECTNESS_CHECK(numRows > 0);
+      });
+
+      // Copy the located triples (like for a snapshot of the delta triples
+      // after each update) and then modify a single block of the original.
+      table.addMeasurement(row, 6, [&]() {
+        auto copy = locatedTriplesPerBlock;
+        std::array change{locatedTriples.front()};
+        locatedTriplesPerBlock.erase(change);
+        locatedTriplesPerBlock.add(change);
+      });
+
+      table.addMeasurement(
+          row, 7, [&]() { locatedTriplesPerBlock.erase(locatedTriples); });
+      AD_CORRECTNESS_CHECK(locatedTriplesPerBlock.numTriples() == 0);
+    }
+    return results;
+  }
+};
+
+AD_REGISTER_BENCHMARK(LocatedTriplesBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,133 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "absl/strings/str_cat.h"
+#include "util/Cache.h"
+#include "util/ConcurrentCache.h"
+#include "util/DefaultValueSizeGetter.h"
+#include "util/Random.h"
+#include "util/ShardedConcurrentCache.h"
+#include "util/jthread.h"
+
+namespace ad_benchmark {
+
+// Benchmarks for the contention on the cache for (partial) query results: Many
+// threads concurrently look up results in the cache, like many small queries
+// (each of which looks up every operation of its query plan in the cache).
+// The cache with a single lock (`ConcurrentCache`) is compared to the sharded
+// cache (`ShardedConcurrentCache`) that is used for the `QueryResultCache`.
+class QueryResultCacheBenchmark : public BenchmarkInterface {
+  using Lru = ad_utility::LRUCache<std::string, std::string,
+                                   ad_utility::StringSizeGetter<std::string>>;
+  using SingleLockCache = ad_utility::ConcurrentCache<Lru>;
+  using ShardedCache = ad_utility::ShardedConcurrentCache<Lru>;
+
+  // The number of distinct keys and the number of lookups per thread.
+  static constexpr size_t numKeys = 10'000;
+  static constexpr size_t numLookupsPerThread = 100'000;
+
+  // Keys with a length similar to the cache keys of small query plans.
+  static std::vector<std::string> makeKeys() {
+    std::vector<std::string> keys;
+    keys.reserve(numKeys);
+    for (size_t i = 0; i < numKeys; ++i) {
+      keys.push_back(absl::StrCat("JOIN (SCAN POS with P = <p>, O = ", i,
+                                  ") [0] | SCAN PSO with P = <q>"));
+    }
+    return keys;
+  }
+
+  // Run `numThreads` threads that each look up `numLookupsPerThread` random
+  // keys from `keys` in the `cache`. With probability `missRatio`, the key is
+  // made unique, such that the lookup is a miss and the value has to be
+  // computed and inserted.
+  template <typename Cache>
+  static void runLookups(Cache& cache, const std::vector<std::string>& keys,
+                         size_t numThreads, double missRatio) {
+    auto alwaysSuitable = [](const std::string&) { return true; };
+    std::vector<ad_utility::JThread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        ad_utility::FastRandomIntGenerator<size_t> randomIndex{
+            ad_utility::RandomSeed::make(t)};
+        ad_utility::RandomDoubleGenerator randomDouble{
+            0.0, 1.0, ad_utility::RandomSeed::make(t + numThreads)};
+        for (size_t i = 0; i < numLookupsPerThread; ++i) {
+          const auto& key = keys[randomIndex() % keys.size()];
+          bool miss = randomDouble() < missRatio;
+          auto result = cache.computeOnce(
+              miss ? absl::StrCat(key, " ", t, " ", i) : key,
+              [&key]() { return key; }, false, alwaysSuitable);
+          AD_CORRECTNESS_CHECK(result._resultPointer != nullptr);
+        }
+      });
+    }
+  }
+
+  // Create a cache of type `Cache` that contains all the `keys` and is limited
+  // to twice as many entries (so that the misses cause evictions).
+  template <typename Cache>
+  static std::unique_ptr<Cache> makeFilledCache(
+      const std::vector<std::string>& keys) {
+    std::unique_ptr<Cache> cache;
+    if constexpr (std::is_same_v<Cache, ShardedCache>) {
+      cache = std::make_unique<Cache>(ShardedCache::defaultNumShards,
+                                      2 * keys.size());
+    } else {
+      cache = std::make_unique<Cache>(2 * keys.size());
+    }
+    for (const auto& key : keys) {
+      cache->computeOnce(
+          key, [&key]() { return key; }, false,
+          [](const std::string&) { return true; });
+    }
+    return cache;
+  }
+
+ public:
+  std::string name() const final {
+    return "Concurrent lookups in the cache for query results";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    const std::vector<size_t> numsThreads{1, 4, 16, 64};
+    std::vector<std::string> rowNames;
+    for (size_t numThreads : numsThreads) {
+      rowNames.push_back(std::to_string(numThreads));
+    }
+    auto& table = results.addTable(
+        absl::StrCat("Time for ", numLookupsPerThread, " lookups per thread"),
+        rowNames,
+        {"#threads", "single lock (hits)", "sharded (hits)",
+         "single lock (10% misses)", "sharded (10% misses)"});
+
+    const auto keys = makeKeys();
+    for (size_t row = 0; row < numsThreads.size(); ++row) {
+      size_t numThreads = numsThreads.at(row);
+      size_t column = 1;
+      for (double missRatio : {0.0, 0.1}) {
+        auto singleLockCache = makeFilledCache<SingleLockCache>(keys);
+        table.addMeasurement(row, column++, [&]() {
+          runLookups(*singleLockCache, keys, numThreads, missRatio);
+        });
+        auto shardedCache = makeFilledCache<ShardedCache>(keys);
+        table.addMeasurement(row, column++, [&]() {
+          runLookups(*shardedCache, keys, numThreads, missRatio);
+        });
+      }
+    }
+    return results;
+  }
+};
+
+AD_REGISTER_BENCHMARK(QueryResultCacheBenchmark);
+}  // namespace ad_benchmark
@@ -147,6 +147,12 @@ int main(int argc, char** argv) {
       "endpoint might change at any point in time. If you control the "
       "endpoints, you can override this setting. This will disable the sibling "
       "optimization where VALUES are dynamically pushed into `SERVICE`.");
+  add("disk-cache-dir", po::value<std::string>(&config.diskCacheDirectory_),
+      "If set, results that were expensive to compute are also cached in this "
+      "directory, where they survive restarts of the server. The size of this "
+      "cache and the minimal computation time of a result for it to be "
+      "cached can be set via the runtime parameters `disk-cache-max-size` and "
+      "`disk-cache-min-computation-time`.");
   add("persist-updates", po::bool_switch(&config.persistUpdates_),
       "If set, then SPARQL UPDATES will be persisted on disk. Otherwise they "
       "will be lost when the engine is stopped");
@@ -0,0 +1,120 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/AdaptiveQueryPlanning.h"
+
+#include <algorithm>
+
+#include "engine/Filter.h"
+#include "engine/Join.h"
+#include "engine/MultiColumnJoin.h"
+#include "engine/QueryExecutionTree.h"
+#include "util/Log.h"
+
+namespace qlever::adaptiveQueryPlanning {
+
+namespace {
+// Return true iff the `operation` is a materialization point, that is, an
+// operation whose size estimate is derived from the estimates of its children
+// and which the planner could have placed differently.
+bool isMaterializationPoint(const Operation& operation) {
+  return dynamic_cast<const Join*>(&operation) != nullptr ||
+         dynamic_cast<const MultiColumnJoin*>(&operation) != nullptr ||
+         dynamic_cast<const Filter*>(&operation) != nullptr;
+}
+
+// The recursive implementation of `findNextMaterializationPoint`.
+QueryExecutionTree* findNextMaterializationPointImpl(
+    QueryExecutionTree& tree,
+    const ad_utility::HashSet<std::string>& computedCacheKeys) {
+  if (tree.isCached() || computedCacheKeys.contains(tree.getCacheKey())) {
+    return nullptr;
+  }
+  // With a `LIMIT` or `OFFSET`, the subtree is possibly computed only
+  // partially, so it must not be computed completely in advance.
+  if (!tree.getRootOperation()->getLimitOffset().isUnconstrained()) {
+    return nullptr;
+  }
+  for (QueryExecutionTree* child : tree.getRootOperation()->getChildren()) {
+    auto* next = findNextMaterializationPointImpl(*child, computedCacheKeys);
+    if (next != nullptr) {
+      return next;
+    }
+  }
+  return isMaterializationPoint(*tree.getRootOperation()) ? &tree : nullptr;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+bool isMisestimated(size_t estimatedSize, size_t actualSize, double factor) {
+  if (factor <= 0) {
+    return false;
+  }
+  auto estimated = static_cast<double>(std::max(estimatedSize, size_t{1}));
+  auto actual = static_cast<double>(std::max(actualSize, size_t{1}));
+  return std::max(estimated, actual) > factor * std::min(estimated, actual);
+}
+
+// _____________________________________________________________________________
+QueryExecutionTree* findNextMaterializationPoint(
+    QueryExecutionTree& tree,
+    const ad_utility::HashSet<std::string>& computedCacheKeys) {
+  auto* next = findNextMaterializationPointImpl(tree, computedCacheKeys);
+  return next == &tree ? nullptr : next;
+}
+
+// _____________________________________________________________________________
+QueryExecutionTree planAdaptively(
+    const std::function<QueryExecutionTree()>& planQuery,
+    const std::function<void(QueryExecutionTree&)>& prepareForExecution,
+    double factor) {
+  QueryExecutionTree plan = planQuery();
+  auto* qec = plan.getRootOperation()->getExecutionContext();
+  // Without a cache, the computed results can't be reused by a new plan.
+  if (factor <= 0 || qec->disableCaching()) {
+    return plan;
+  }
+  ad_utility::HashSet<std::string> computedCacheKeys;
+  size_t numReplans = 0;
+  while (numReplans < maxNumReplans) {
+    auto* subtree = findNextMaterializationPoint(plan, computedCacheKeys);
+    if (subtree == nullptr) {
+      break;
+    }
+    size_t estimatedSize = subtree->getSizeEstimate();
+    prepareForExecution(*subtree);
+    // The result is requested lazily. If it is lazy, the parent of the subtree
+    // can consume it lazily as well, and materializing it here would change
+    // the execution of the query (and its memory consumption), so the subtree
+    // is skipped without consuming the result.
+    auto result = subtree->getResult(true);
+    computedCacheKeys.insert(subtree->getCacheKey());
+    if (!result->isFullyMaterialized()) {
+      continue;
+    }
+    size_t actualSize = result->idTable().numRows();
+    // A result that is not in the cache (e.g. because it is too large) can't be
+    // reused by a new plan, so a new plan would neither know its exact size nor
+    // avoid computing it again. Keep the current plan and hand it the result.
+    if (!qec->getQueryTreeCache().cacheContains(QueryCacheKey{
+            subtree->getCacheKey(), qec->locatedTriplesState().index_})) {
+      subtree->getRootOperation()->precomputedResultFromAdaptivePlanning() =
+          std::move(result);
+      break;
+    }
+    if (!isMisestimated(estimatedSize, actualSize, factor)) {
+      continue;
+    }
+    AD_LOG_INFO << "Planning the query again, because the result of \""
+                << subtree->getRootOperation()->getDescriptor() << "\" has "
+                << actualSize << " rows, but was estimated to have "
+                << estimatedSize << " rows" << std::endl;
+    plan = planQuery();
+    ++numReplans;
+  }
+  return plan;
+}
+
+}  // namespace qlever::adaptiveQueryPlanning
@@ -0,0 +1,63 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_ADAPTIVEQUERYPLANNING_H
+#define QLEVER_SRC_ENGINE_ADAPTIVEQUERYPLANNING_H
+
+#include <functional>
+#include <string>
+
+#include "util/HashSet.h"
+
+class QueryExecutionTree;
+
+// Adaptive query planning: The query planner relies on size estimates (for
+// example, a constant selectivity for each `FILTER`), which can be off by
+// orders of magnitude. To correct the worst of these estimates, the joins and
+// filters of a plan (the "materialization points") are executed bottom-up
+// before the plan as a whole. When the size of such a result differs from its
+// estimate by more than a given factor, the query is planned again. The new
+// plan finds the computed results in the `QueryResultCache`, where they have
+// their exact size and a cost of zero (see
+// `QueryExecutionTree::hasMisestimatedCachedResult`). All subtrees that are
+// part of both plans are thus only computed once. Only results that would be
+// materialized anyway are computed in advance: subtrees with a `LIMIT` or
+// `OFFSET` (and their children) are skipped, as are subtrees whose result can
+// be computed lazily.
+namespace qlever::adaptiveQueryPlanning {
+
+// The maximal number of times that a query is planned again.
+constexpr size_t maxNumReplans = 3;
+
+// Return true iff `factor` is positive and `estimatedSize` and `actualSize`
+// differ by more than `factor` in either direction. Sizes of zero are treated
+// as one, so that estimates close to zero don't count as misestimates.
+bool isMisestimated(size_t estimatedSize, size_t actualSize, double factor);
+
+// Return the first materialization point of the `tree` in post-order that has
+// to be computed before the rest of the `tree`. Subtrees that are cached, whose
+// cache key is in `computedCacheKeys`, or that have a `LIMIT` or `OFFSET` are
+// skipped, as is the root of the `tree` itself (computing it means executing
+// the query). Return `nullptr` if there is no such materialization point.
+QueryExecutionTree* findNextMaterializationPoint(
+    QueryExecutionTree& tree,
+    const ad_utility::HashSet<std::string>& computedCacheKeys);
+
+// Plan a query adaptively with the given `factor` (see above): `planQuery`
+// creates a plan based on the current content of the cache, and
+// `prepareForExecution` is called on each subtree before it is computed (e.g.
+// to set the cancellation handle and the time limit). Return the final plan.
+// If a computed result could not be stored in the cache, planning stops and the
+// current plan is returned with that result already set (see
+// `Operation::precomputedResultFromAdaptivePlanning`). A subtree whose result
+// is lazy is not consumed and not considered for planning again.
+QueryExecutionTree planAdaptively(
+    const std::function<QueryExecutionTree()>& planQuery,
+    const std::function<void(QueryExecutionTree&)>& prepareForExecution,
+    double factor);
+
+}  // namespace qlever::adaptiveQueryPlanning
+
+#endif  // QLEVER_SRC_ENGINE_ADAPTIVEQUERYPLANNING_H
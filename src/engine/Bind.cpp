@@ -8,6 +8,7 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/ExistsJoin.h"
+#include "engine/MorselHelpers.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
@@ -184,17 +185,46 @@ Result Bind::computeResult(bool requestLaziness) {
 IdTable Bind::computeExpressionBind(
     LocalVocab* localVocab, IdTable idTable,
     const sparqlExpression::SparqlExpression* expression) const {
+  idTable.addEmptyColumn();
+  auto outputColumn = idTable.getColumn(idTable.numColumns() - 1);
+  // The input additionally contains the (still empty) output column, which is
+  // not referenced by any variable.
+  auto input = idTable.asStaticView<0>();
+
+  qlever::morselHelpers::Morsels morsels{input.numRows()};
+  if (!morsels.isParallel()) {
+    evaluateExpressionIntoColumn(localVocab, input, outputColumn, expression);
+    return idTable;
+  }
+
+  // Evaluate the morsels of the input independently and in parallel. Each
+  // morsel writes to its own part of the output column and has its own local
+  // vocab for the newly created words, which are merged in the end.
+  std::vector<LocalVocab> morselVocabs(morsels.size());
+  morsels.forEach([&](size_t morsel, size_t begin, size_t end) {
+    evaluateExpressionIntoColumn(&morselVocabs.at(morsel),
+                                 input.asRowRangeView(begin, end),
+                                 outputColumn.subspan(begin, end - begin),
+                                 expression);
+  });
+  localVocab->mergeWith(morselVocabs);
+  return idTable;
+}
+
+// _____________________________________________________________________________
+void Bind::evaluateExpressionIntoColumn(
+    LocalVocab* localVocab, const IdTableView<0>& input,
+    ql::span<Id> outputColumn,
+    const sparqlExpression::SparqlExpression* expression) const {
+  AD_CORRECTNESS_CHECK(input.numRows() == outputColumn.size());
   sparqlExpression::EvaluationContext evaluationContext(
-      *getExecutionContext(), _subtree->getVariableColumns(),
-      idTable.asStaticView<0>(), getExecutionContext()->getAllocator(),
-      *localVocab, cancellationHandle_, deadline_);
+      *getExecutionContext(), _subtree->getVariableColumns(), input,
+      getExecutionContext()->getAllocator(), *localVocab, cancellationHandle_,
+      deadline_);
 
   sparqlExpression::ExpressionResult expressionResult =
       expression->evaluate(&evaluationContext);
 
-  idTable.addEmptyColumn();
-  auto outputColumn = idTable.getColumn(idTable.numColumns() - 1);
-
   auto visitor = CPP_template_lambda_mut(&)(typename T)(T && singleResult)(
       requires sparqlExpression::SingleExpressionResult<T>) {
     constexpr static bool isVariable = std::is_same_v<T, ::Variable>;
@@ -203,7 +233,7 @@ IdTable Bind::computeExpressionBind(
     if constexpr (isVariable) {
       auto columnIndex =
           getInternallyVisibleVariableColumns().at(singleResult).columnIndex_;
-      auto inputColumn = idTable.getColumn(columnIndex);
+      auto inputColumn = input.getColumn(columnIndex);
       AD_CORRECTNESS_CHECK(inputColumn.size() == outputColumn.size());
       ad_utility::chunkedCopy(inputColumn, outputColumn.begin(), CHUNK_SIZE,
                               [this]() { checkCancellation(); });
@@ -241,8 +271,6 @@ IdTable Bind::computeExpressionBind(
   };
 
   std::visit(visitor, std::move(expressionResult));
-
-  return idTable;
 }
 
 // _____________________________________________________________________________
@@ -53,11 +53,20 @@ class Bind : public Operation {
   static IdTable cloneSubView(const IdTableView<0>& idTable,
                               const std::pair<size_t, size_t>& subrange);
 
-  // Implementation for the binding of arbitrary expressions.
+  // Implementation for the binding of arbitrary expressions. Large inputs are
+  // evaluated in parallel, see `MorselHelpers.h`.
   IdTable computeExpressionBind(
       LocalVocab* localVocab, IdTable idTable,
       const sparqlExpression::SparqlExpression* expression) const;
 
+  // Evaluate the `expression` on the `input` and write the results to the
+  // `outputColumn`, which must have the same size as the `input`. New words are
+  // added to the `localVocab`.
+  void evaluateExpressionIntoColumn(
+      LocalVocab* localVocab, const IdTableView<0>& input,
+      ql::span<Id> outputColumn,
+      const sparqlExpression::SparqlExpression* expression) const;
+
   [[nodiscard]] VariableToColumnMap computeVariableToColumnMap() const override;
 };
 
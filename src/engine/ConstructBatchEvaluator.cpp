@@ -80,9 +80,8 @@ EvaluatedVariableValues ConstructBatchEvaluator::evaluateVariableByColumn(
     }
   }
 
-  // Phase 2: batch-resolve cache misses. `missIds` is deduplicated and sorted
-  // (inherited from `sortedIndices`), satisfying the `idsToStringAndType`
-  // precondition for sequential VocabIndex I/O.
+  // Phase 2: batch-resolve cache misses. `missIds` is deduplicated (inherited
+  // from `sortedIndices`), so each word is resolved only once.
   auto missResolved =
       ql::exportIds::idsToStringAndType(index, missIds, localVocab);
   for (auto&& [id, resolved, rows] :
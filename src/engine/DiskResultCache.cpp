@@ -0,0 +1,409 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/DiskResultCache.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "index/DeltaTriples.h"
+#include "util/CryptographicHashUtils.h"
+#include "util/Iterators.h"
+#include "util/Log.h"
+#include "util/Serializer/CompressedSerializer.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeArrayOrTuple.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+
+using ad_utility::MemorySize;
+using ad_utility::serialization::FileReadSerializer;
+using ad_utility::serialization::FileWriteSerializer;
+using ad_utility::serialization::ZstdReadSerializer;
+using ad_utility::serialization::ZstdWriteSerializer;
+
+namespace {
+// The rows of a result are written in blocks of (uncompressed) about this size,
+// which are also the chunks of a lazily read result.
+constexpr MemorySize blockSize = MemorySize::megabytes(8);
+
+// The metadata of an entry that is stored in front of the rows.
+struct EntryHeader {
+  std::string cacheKey_;
+  std::string indexFingerprint_;
+  uint64_t numColumns_ = 0;
+  std::vector<ColumnIndex> sortedBy_;
+  uint64_t numRows_ = 0;
+
+  AD_SERIALIZE_FRIEND_FUNCTION(EntryHeader) {
+    serializer | arg.cacheKey_;
+    serializer | arg.indexFingerprint_;
+    serializer | arg.numColumns_;
+    serializer | arg.sortedBy_;
+    serializer | arg.numRows_;
+  }
+};
+
+// Read the magic bytes and the format version from the `serializer` and
+// return true iff they are the ones of the current format.
+bool readAndCheckFormat(FileReadSerializer& serializer) {
+  std::decay_t<decltype(DiskResultCache::magicBytes)> magicBytes{};
+  serializer >> magicBytes;
+  if (magicBytes != DiskResultCache::magicBytes) {
+    return false;
+  }
+  uint16_t version;
+  serializer >> version;
+  return version == DiskResultCache::formatVersion;
+}
+
+// Read the next block of rows from the `serializer` into the rows
+// `[offset, offset + numRows)` of the `idTable`.
+template <typename Serializer>
+void readBlock(Serializer& serializer, IdTable& idTable, size_t offset,
+               size_t numRows) {
+  for (auto column : idTable.getColumns()) {
+    auto block = column.subspan(offset, numRows);
+    serializer >> block;
+  }
+}
+
+using CompressedReader = ZstdReadSerializer<FileReadSerializer>;
+}  // namespace
+
+// _____________________________________________________________________________
+DiskResultCache::DiskResultCache(std::filesystem::path directory,
+                                 MemorySize maxSize)
+    : directory_{std::move(directory)} {
+  state_.wlock()->maxSize_ = maxSize;
+  std::filesystem::create_directories(directory_);
+  loadEntriesFromDirectory();
+}
+
+// _____________________________________________________________________________
+bool DiskResultCache::isApplicable(
+    const LocatedTriplesState& locatedTriplesState) {
+  auto isEmpty = [](const auto& locatedTriplesPerBlock) {
+    return locatedTriplesPerBlock.numTriples() == 0;
+  };
+  return ql::ranges::all_of(locatedTriplesState.locatedTriplesPerBlock_,
+                            isEmpty) &&
+         ql::ranges::all_of(locatedTriplesState.internalLocatedTriplesPerBlock_,
+                            isEmpty);
+}
+
+// _____________________________________________________________________________
+std::string DiskResultCache::fileName(std::string_view cacheKey,
+                                      std::string_view indexFingerprint) {
+  auto hash = ad_utility::HashSha256{}(
+      absl::StrCat(indexFingerprint, "\n", cacheKey));
+  return absl::StrCat(absl::StrJoin(hash, "", ad_utility::hexFormatter),
+                      fileExtension);
+}
+
+// _____________________________________________________________________________
+std::optional<Result> DiskResultCache::read(
+    std::string_view cacheKey, std::string_view indexFingerprint, bool lazy,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  auto name = fileName(cacheKey, indexFingerprint);
+  {
+    auto state = state_.wlock();
+    auto it = state->entries_.find(name);
+    if (it == state->entries_.end()) {
+      ++numMisses_;
+      return std::nullopt;
+    }
+    it->second.lastAccess_ = ++state->accessCounter_;
+  }
+
+  // Note: The file might have been evicted concurrently, and the hash of the
+  // file name might collide, so the entry might still turn out to be a miss.
+  std::optional<CompressedReader> reader;
+  EntryHeader header;
+  try {
+    FileReadSerializer fileReader{(directory_ / name).string()};
+    if (!readAndCheckFormat(fileReader)) {
+      ++numMisses_;
+      return std::nullopt;
+    }
+    reader.emplace(std::move(fileReader));
+    reader.value() >> header;
+  } catch (const std::exception& e) {
+    AD_LOG_WARN << "Could not read the cached result from the file " << name
+                << ": " << e.what() << std::endl;
+    ++numMisses_;
+    return std::nullopt;
+  }
+  if (header.cacheKey_ != cacheKey ||
+      header.indexFingerprint_ != indexFingerprint) {
+    ++numMisses_;
+    return std::nullopt;
+  }
+  ++numHits_;
+
+  if (!lazy) {
+    IdTable idTable{header.numColumns_, allocator};
+    idTable.resize(header.numRows_);
+    size_t offset = 0;
+    while (true) {
+      uint64_t numRowsInBlock;
+      reader.value() >> numRowsInBlock;
+      if (numRowsInBlock == 0) {
+        break;
+      }
+      readBlock(reader.value(), idTable, offset, numRowsInBlock);
+      offset += numRowsInBlock;
+    }
+    AD_CORRECTNESS_CHECK(offset == header.numRows_);
+    return Result{std::move(idTable), std::move(header.sortedBy_),
+                  LocalVocab{}};
+  }
+
+  // The serializer is move-only, so it is shared by the (copyable) lambda.
+  auto sharedReader =
+      std::make_shared<CompressedReader>(std::move(reader).value());
+  auto getNextBlock = [sharedReader, numColumns = header.numColumns_,
+                       allocator]() -> std::optional<Result::IdTableVocabPair> {
+    uint64_t numRowsInBlock;
+    *sharedReader >> numRowsInBlock;
+    if (numRowsInBlock == 0) {
+      return std::nullopt;
+    }
+    IdTable idTable{numColumns, allocator};
+    idTable.resize(numRowsInBlock);
+    readBlock(*sharedReader, idTable, 0, numRowsInBlock);
+    return Result::IdTableVocabPair{std::move(idTable), LocalVocab{}};
+  };
+  return Result{Result::LazyResult{ad_utility::InputRangeFromGetCallable{
+                    std::move(getNextBlock)}},
+                std::move(header.sortedBy_)};
+}
+
+// _____________________________________________________________________________
+bool DiskResultCache::tryWrite(std::string_view cacheKey,
+                               std::string_view indexFingerprint,
+                               const Result& result) {
+  AD_CONTRACT_CHECK(result.isFullyMaterialized());
+  const auto& localVocab = result.localVocab();
+  if (!localVocab.empty() ||
+      !localVocab.getOwnedLocalBlankNodeBlocks().empty()) {
+    return false;
+  }
+  const IdTable& idTable = result.idTable();
+  auto name = fileName(cacheKey, indexFingerprint);
+  {
+    auto state = state_.wlock();
+    auto uncompressedSize = MemorySize::bytes(
+        idTable.numRows() * idTable.numColumns() * sizeof(Id));
+    if (state->entries_.contains(name) || uncompressedSize > state->maxSize_) {
+      return false;
+    }
+  }
+
+  // Write the file under a temporary name first, so that concurrent readers
+  // never see an incomplete file.
+  auto temporaryPath = directory_ / absl::StrCat(name, ".tmp-",
+                                                 numTemporaryFiles_++);
+  try {
+    FileWriteSerializer fileWriter{temporaryPath.string()};
+    fileWriter << magicBytes;
+    fileWriter << formatVersion;
+    ZstdWriteSerializer<FileWriteSerializer> writer{std::move(fileWriter)};
+    writer << EntryHeader{std::string{cacheKey}, std::string{indexFingerprint},
+                          idTable.numColumns(), result.sortedBy(),
+                          idTable.numRows()};
+    size_t rowsPerBlock = std::max(
+        size_t{1},
+        blockSize.getBytes() /
+            std::max(size_t{1}, idTable.numColumns() * sizeof(Id)));
+    for (size_t offset = 0; offset < idTable.numRows();
+         offset += rowsPerBlock) {
+      uint64_t numRowsInBlock =
+          std::min(rowsPerBlock, idTable.numRows() - offset);
+      writer << numRowsInBlock;
+      for (auto column : idTable.getColumns()) {
+        writer << column.subspan(offset, numRowsInBlock);
+      }
+    }
+    writer << uint64_t{0};
+    writer.close();
+  } catch (const std::exception& e) {
+    AD_LOG_WARN << "Could not write a result to the disk cache: " << e.what()
+                << std::endl;
+    std::filesystem::remove(temporaryPath);
+    return false;
+  }
+
+  auto size = MemorySize::bytes(std::filesystem::file_size(temporaryPath));
+  auto state = state_.wlock();
+  if (size > state->maxSize_) {
+    std::filesystem::remove(temporaryPath);
+    return false;
+  }
+  if (auto it = state->entries_.find(name); it != state->entries_.end()) {
+    // The same result was written concurrently, the file is replaced below.
+    state->totalSize_ -= it->second.size_;
+    state->entries_.erase(it);
+  }
+  evictEntries(*state, size);
+  std::filesystem::rename(temporaryPath, directory_ / name);
+  state->entries_.emplace(name, Entry{size, ++state->accessCounter_});
+  state->totalSize_ += size;
+  ++numWrites_;
+  return true;
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::writeInBackground(std::string cacheKey,
+                                        std::string indexFingerprint,
+                                        std::shared_ptr<const Result> result) {
+  AD_CONTRACT_CHECK(result != nullptr);
+  {
+    std::lock_guard lock{pendingWritesMutex_};
+    if (numPendingWrites_ >= maxNumPendingWrites) {
+      return;
+    }
+    ++numPendingWrites_;
+  }
+  // Note: The number of pending writes includes the one that is currently
+  // being written, so the queue is never full and `push` never blocks.
+  writeQueue_.push([this, cacheKey = std::move(cacheKey),
+                    indexFingerprint = std::move(indexFingerprint),
+                    result = std::move(result)]() {
+    try {
+      tryWrite(cacheKey, indexFingerprint, *result);
+    } catch (const std::exception& e) {
+      // Exceptions must not escape the tasks of the `writeQueue_`.
+      AD_LOG_WARN << "Could not write a result to the disk cache: "
+                  << e.what() << std::endl;
+    }
+    std::lock_guard lock{pendingWritesMutex_};
+    --numPendingWrites_;
+    pendingWritesDone_.notify_all();
+  });
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::waitForPendingWrites() {
+  std::unique_lock lock{pendingWritesMutex_};
+  pendingWritesDone_.wait(lock, [this]() { return numPendingWrites_ == 0; });
+}
+
+// _____________________________________________________________________________
+bool DiskResultCache::contains(std::string_view cacheKey,
+                               std::string_view indexFingerprint) const {
+  return state_.wlock()->entries_.contains(
+      fileName(cacheKey, indexFingerprint));
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::setMaxSize(MemorySize maxSize) {
+  auto state = state_.wlock();
+  state->maxSize_ = maxSize;
+  evictEntries(*state, MemorySize::bytes(0));
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::clear() {
+  waitForPendingWrites();
+  auto state = state_.wlock();
+  for (const auto& [name, entry] : state->entries_) {
+    removeFile(name);
+  }
+  state->entries_.clear();
+  state->totalSize_ = MemorySize::bytes(0);
+}
+
+// _____________________________________________________________________________
+auto DiskResultCache::stats() const -> Stats {
+  auto state = state_.wlock();
+  return {state->entries_.size(), state->totalSize_, numHits_.load(),
+          numMisses_.load(), numWrites_.load()};
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::loadEntriesFromDirectory() {
+  struct FoundFile {
+    std::string name_;
+    MemorySize size_;
+    std::filesystem::file_time_type lastWriteTime_;
+  };
+  std::vector<FoundFile> files;
+  for (const auto& file : std::filesystem::directory_iterator{directory_}) {
+    if (!file.is_regular_file()) {
+      continue;
+    }
+    auto name = file.path().filename().string();
+    if (name.find(absl::StrCat(fileExtension, ".tmp-")) != std::string::npos) {
+      // An incomplete file from a write that was interrupted.
+      std::filesystem::remove(file.path());
+      continue;
+    }
+    if (file.path().extension() != fileExtension) {
+      continue;
+    }
+    bool hasCurrentFormat = false;
+    try {
+      FileReadSerializer reader{file.path().string()};
+      hasCurrentFormat = readAndCheckFormat(reader);
+    } catch (const std::exception&) {
+      // Files that are too short to contain the header are ignored.
+    }
+    if (!hasCurrentFormat) {
+      AD_LOG_WARN << "Ignoring the file " << file.path()
+                  << " in the disk cache, it does not have the current format"
+                  << std::endl;
+      continue;
+    }
+    files.push_back(FoundFile{std::move(name),
+                              MemorySize::bytes(file.file_size()),
+                              file.last_write_time()});
+  }
+  ql::ranges::sort(files, {}, &FoundFile::lastWriteTime_);
+
+  auto state = state_.wlock();
+  for (auto& file : files) {
+    state->totalSize_ += file.size_;
+    state->entries_.emplace(std::move(file.name_),
+                            Entry{file.size_, ++state->accessCounter_});
+  }
+  evictEntries(*state, MemorySize::bytes(0));
+  AD_LOG_INFO << "Loaded " << state->entries_.size()
+              << " results with a total size of "
+              << state->totalSize_.asString() << " from the disk cache in "
+              << directory_ << std::endl;
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::evictEntries(State& state, MemorySize sizeToAdd) {
+  // Note: The number of entries is small compared to the cost of writing an
+  // entry, so a linear search for the least recently used entry is fine.
+  while (!state.entries_.empty() &&
+         state.totalSize_ + sizeToAdd > state.maxSize_) {
+    auto leastRecentlyUsed = ql::ranges::min_element(
+        state.entries_, {}, [](const auto& nameAndEntry) {
+          return nameAndEntry.second.lastAccess_;
+        });
+    removeFile(leastRecentlyUsed->first);
+    state.totalSize_ -= leastRecentlyUsed->second.size_;
+    state.entries_.erase(leastRecentlyUsed);
+  }
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::removeFile(const std::string& name) const {
+  // Note: Results that are currently read lazily can still be read after the
+  // file was removed, because they keep the file open.
+  std::error_code errorCode;
+  std::filesystem::remove(directory_ / name, errorCode);
+  if (errorCode) {
+    AD_LOG_WARN << "Could not remove the file " << name
+                << " from the disk cache: " << errorCode.message()
+                << std::endl;
+  }
+}
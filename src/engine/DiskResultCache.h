@@ -0,0 +1,181 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_DISKRESULTCACHE_H
+#define QLEVER_SRC_ENGINE_DISKRESULTCACHE_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "engine/Result.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+#include "util/TaskQueue.h"
+
+struct LocatedTriplesState;
+
+// A second tier of the `QueryResultCache` on disk, which survives restarts of
+// the engine. Results that were expensive to compute are written to a file in
+// a dedicated directory, so that they are still available when they have been
+// evicted from the in-memory cache (or were too large for it in the first
+// place), and after a restart. When the in-memory cache misses, the result is
+// read from disk instead of being computed (lazily, if the operation was
+// requested lazily).
+//
+// The key of an entry is the cache key of the operation together with the
+// fingerprint of the index (see `IndexImpl::getIndexFingerprint`), so that the
+// entries of different indices in the same directory, or of a previous build
+// of the same index, cannot be mixed up. Results are only stored or looked up
+// when there are no delta triples (see `isApplicable`): the cache keys only
+// distinguish versions of the delta triples within the same run of the
+// engine. Results with a non-empty `LocalVocab` are not stored, because the
+// local vocab entries and blank nodes cannot yet be restored reliably while
+// queries are running (see `NamedResultCacheSerializer.h`).
+//
+// Each entry is a single file `<hash><fileExtension>`, which consists of a
+// header (`magicBytes` and `formatVersion`) followed by the zstd-compressed
+// cache key, index fingerprint, number of columns, sortedness, number of rows,
+// and the rows in blocks. When the total size of the files exceeds the maximal
+// size, the least recently used entries are deleted.
+//
+// Results are written by a background thread (see `writeInBackground`), so
+// that the queries that computed them don't have to wait for the disk.
+class DiskResultCache {
+ public:
+  static constexpr std::string_view fileExtension = ".qlever-result";
+  static constexpr std::array magicBytes{'Q', 'L', 'E', 'V', 'E', 'R', '.',
+                                         'R', 'E', 'S', 'U', 'L', 'T'};
+  // Has to be increased when the format of the files is changed. Files with a
+  // different version are ignored.
+  static constexpr uint16_t formatVersion = 2;
+  // The maximal number of results that wait to be written by
+  // `writeInBackground`. Results that would exceed it are not written, so that
+  // the pending results don't keep too much memory alive.
+  static constexpr size_t maxNumPendingWrites = 8;
+
+  // Statistics for the `cache-stats` command.
+  struct Stats {
+    size_t numEntries_ = 0;
+    ad_utility::MemorySize totalSize_ = ad_utility::MemorySize::bytes(0);
+    size_t numHits_ = 0;
+    size_t numMisses_ = 0;
+    size_t numWrites_ = 0;
+  };
+
+ private:
+  struct Entry {
+    ad_utility::MemorySize size_;
+    // The value of `State::accessCounter_` at the last access, used for the
+    // LRU eviction.
+    uint64_t lastAccess_;
+  };
+  struct State {
+    // The entries by their file name.
+    ad_utility::HashMap<std::string, Entry> entries_;
+    ad_utility::MemorySize totalSize_ = ad_utility::MemorySize::bytes(0);
+    ad_utility::MemorySize maxSize_;
+    uint64_t accessCounter_ = 0;
+  };
+
+  std::filesystem::path directory_;
+  mutable ad_utility::Synchronized<State, std::mutex> state_;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+  std::atomic<size_t> numWrites_ = 0;
+  // Used to create unique names for the temporary files of concurrent writes.
+  std::atomic<uint64_t> numTemporaryFiles_ = 0;
+  // The number of results that were passed to `writeInBackground` and have not
+  // been written yet.
+  size_t numPendingWrites_ = 0;
+  std::mutex pendingWritesMutex_;
+  std::condition_variable pendingWritesDone_;
+  // The background thread for `writeInBackground`. It is declared last, so
+  // that it is destroyed (and the pending writes are finished) before the
+  // other members.
+  ad_utility::TaskQueue<false> writeQueue_{maxNumPendingWrites, 1,
+                                           "DiskResultCache"};
+
+ public:
+  // Create a cache in the given `directory` (which is created if it doesn't
+  // exist yet) with the given maximal total size of the files. The entries
+  // that are already in the directory (from a previous run) are loaded, with
+  // the most recently written files being the most recently used entries.
+  DiskResultCache(std::filesystem::path directory,
+                  ad_utility::MemorySize maxSize);
+
+  // Return true iff results that are computed with the `locatedTriplesState`
+  // may be stored in and read from the cache, i.e. iff there are no delta
+  // triples.
+  static bool isApplicable(const LocatedTriplesState& locatedTriplesState);
+
+  // The name of the file for the given `cacheKey` and `indexFingerprint`.
+  static std::string fileName(std::string_view cacheKey,
+                              std::string_view indexFingerprint);
+
+  // Read the result for the given `cacheKey` and `indexFingerprint`. If `lazy`
+  // is true, the rows are read block by block while the `Result` is consumed.
+  // Return `std::nullopt` if there is no such entry, or the entry was written
+  // for an index with a different fingerprint.
+  std::optional<Result> read(
+      std::string_view cacheKey, std::string_view indexFingerprint, bool lazy,
+      const ad_utility::AllocatorWithLimit<Id>& allocator);
+
+  // Write the fully materialized `result` for the given `cacheKey` and
+  // `indexFingerprint` to the cache, unless the cache already contains it, its
+  // local vocab is not empty, or it is larger than the maximal size of the
+  // cache. Return true iff the result was written.
+  bool tryWrite(std::string_view cacheKey, std::string_view indexFingerprint,
+                const Result& result);
+
+  // Call `tryWrite` for the `result` on the background thread and return
+  // immediately. The `result` is kept alive until it was written. If there
+  // already are `maxNumPendingWrites` pending writes, the result is not
+  // written.
+  void writeInBackground(std::string cacheKey, std::string indexFingerprint,
+                         std::shared_ptr<const Result> result);
+
+  // Block until all the results that were passed to `writeInBackground` have
+  // been written (or skipped).
+  void waitForPendingWrites();
+
+  // Return true iff the cache contains an entry for `cacheKey` and
+  // `indexFingerprint`.
+  bool contains(std::string_view cacheKey,
+                std::string_view indexFingerprint) const;
+
+  // Set the maximal total size of the files, and delete the least recently
+  // used entries until the total size is within the new limit.
+  void setMaxSize(ad_utility::MemorySize maxSize);
+
+  // Delete all the entries (after the pending writes were finished).
+  void clear();
+
+  Stats stats() const;
+
+  const std::filesystem::path& directory() const { return directory_; }
+
+ private:
+  // Register the files that are already in the `directory_`.
+  void loadEntriesFromDirectory();
+
+  // Delete the least recently used entries until the total size plus
+  // `sizeToAdd` is at most the maximal size.
+  void evictEntries(State& state, ad_utility::MemorySize sizeToAdd);
+
+  // Delete the file of the entry with the given `name` from the `directory_`.
+  void removeFile(const std::string& name) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_DISKRESULTCACHE_H
@@ -29,6 +29,7 @@
 #include "index/IndexImpl.h"
 #include "rdfTypes/RdfEscaping.h"
 #include "util/ConstexprUtils.h"
+#include "util/InputRangeUtils.h"
 #include "util/ValueIdentity.h"
 #include "util/http/MediaTypes.h"
 #include "util/json.h"
@@ -303,23 +304,78 @@ ExportQueryExecutionTrees::constructQueryResultBindingsToQLeverJSON(
 }
 
 // _____________________________________________________________________________
-// Create the row indicated by rowIndex from IdTable in QLeverJSON format.
-nlohmann::json idTableToQLeverJSONRow(
-    const QueryExecutionTree& qet,
+// The strings and types of the `Id`s of a single column of a result, see
+// `ql::exportIds::idToStringAndType`.
+using ColumnStrings =
+    std::vector<std::optional<std::pair<std::string, const char*>>>;
+
+// The maximal number of rows for which the strings are resolved at once during
+// the export of a result. Larger blocks are split into several chunks, which
+// bounds the memory that is needed for the resolved strings.
+static constexpr uint64_t exportChunkSize = 16'384;
+
+// _____________________________________________________________________________
+// Split the `rows` of a block into consecutive chunks of at most
+// `exportChunkSize` rows.
+static std::vector<ql::ranges::iota_view<uint64_t, uint64_t>> splitIntoChunks(
+    ql::ranges::iota_view<uint64_t, uint64_t> rows) {
+  std::vector<ql::ranges::iota_view<uint64_t, uint64_t>> chunks;
+  uint64_t begin = *ql::ranges::begin(rows);
+  uint64_t end = begin + ql::ranges::size(rows);
+  for (uint64_t chunkBegin = begin; chunkBegin < end;
+       chunkBegin += exportChunkSize) {
+    chunks.emplace_back(chunkBegin,
+                        std::min(end, chunkBegin + exportChunkSize));
+  }
+  return chunks;
+}
+
+// _____________________________________________________________________________
+// Resolve the `Id`s in the given `rows` of the `block` to strings, one column
+// at a time. All the `Id`s of a column are passed to
+// `ql::exportIds::idsToStringAndType` at once, such that the words that are
+// stored in the on-disk vocabulary are read in a single batch instead of with
+// one random read per cell. Entry `j` of the result holds the strings of
+// `columns[j]` (and is empty if `columns[j]` is `std::nullopt`).
+template <bool removeQuotesAndAngleBrackets = false,
+          typename EscapeFunction = ql::identity>
+static std::vector<ColumnStrings> resolveColumnsToStrings(
+    const Index& index, const TableConstRefWithVocab& block,
+    ql::ranges::iota_view<uint64_t, uint64_t> rows,
+    const QueryExecutionTree::ColumnIndicesAndTypes& columns,
+    EscapeFunction&& escapeFunction = EscapeFunction{}) {
+  std::vector<ColumnStrings> result;
+  result.reserve(columns.size());
+  for (const auto& column : columns) {
+    if (!column.has_value()) {
+      result.emplace_back();
+      continue;
+    }
+    auto ids = block.idTable()
+                   .getColumn(column->columnIndex_)
+                   .subspan(*ql::ranges::begin(rows), ql::ranges::size(rows));
+    result.push_back(
+        ql::exportIds::idsToStringAndType<removeQuotesAndAngleBrackets>(
+            index, ids, block.localVocab(), escapeFunction));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+// Create the `rowIndex`-th row of the given `strings` (as obtained from
+// `resolveColumnsToStrings`) in QLeverJSON format.
+static nlohmann::json stringsToQLeverJSONRow(
     const QueryExecutionTree::ColumnIndicesAndTypes& columns,
-    const LocalVocab& localVocab, const size_t rowIndex,
-    const IdTableView<0>& data) {
+    const std::vector<ColumnStrings>& strings, size_t rowIndex) {
   // We need the explicit `array` constructor for the special case of zero
   // variables.
   auto row = nlohmann::json::array();
-  for (const auto& opt : columns) {
-    if (!opt) {
+  for (size_t j = 0; j < columns.size(); ++j) {
+    if (!columns[j]) {
       row.emplace_back(nullptr);
       continue;
     }
-    const auto& currentId = data(rowIndex, opt->columnIndex_);
-    const auto& optionalStringAndXsdType = ql::exportIds::idToStringAndType(
-        qet.getQec()->getIndex(), currentId, localVocab);
+    const auto& optionalStringAndXsdType = strings[j][rowIndex];
     if (!optionalStringAndXsdType.has_value()) {
       row.emplace_back(nullptr);
       continue;
@@ -341,25 +397,36 @@ auto ExportQueryExecutionTrees::idTableToQLeverJSONBindings(
     std::shared_ptr<const Result> result, uint64_t& resultSize,
     CancellationHandle cancellationHandle) {
   AD_CORRECTNESS_CHECK(result != nullptr);
+  using LoopControl = ad_utility::LoopControl<std::string>;
 
-  auto rowIndicies = getRowIndices(limitAndOffset, *result, resultSize);
-  return ad_utility::OwningView(std::move(rowIndicies)) |
-         ql::views::transform(
-             [&qet, columns = std::move(columns), result = std::move(result),
-              cancellationHandle =
-                  std::move(cancellationHandle)](const auto& tableWithView) {
-               return ql::ranges::transform_view(
-                   tableWithView.view_, [&](uint64_t rowIndex) {
-                     cancellationHandle->throwIfCancelled();
-                     TableConstRefWithVocab tableWithVocab =
-                         tableWithView.tableWithVocab_;
-                     return idTableToQLeverJSONRow(
-                                qet, columns, tableWithVocab.localVocab(),
-                                rowIndex, tableWithVocab.idTable())
-                         .dump();
-                   });
-             }) |
-         ql::views::join;
+  auto rowIndices = getRowIndices(limitAndOffset, *result, resultSize);
+  // For each block, resolve the strings chunk by chunk and column by column
+  // (see `resolveColumnsToStrings`), and then yield the rows of the chunk.
+  return ad_utility::CachingContinuableTransformInputRange(
+      ad_utility::OwningView(std::move(rowIndices)),
+      [&qet, columns = std::move(columns), result = std::move(result),
+       cancellationHandle = std::move(cancellationHandle)](
+          const TableWithRange& tableWithRange) {
+        auto resolveChunk =
+            [&qet, columns, cancellationHandle,
+             tableWithVocab = tableWithRange.tableWithVocab_](
+                const ql::ranges::iota_view<uint64_t, uint64_t>& rows) {
+              auto strings = resolveColumnsToStrings(
+                  qet.getQec()->getIndex(), tableWithVocab, rows, columns);
+              std::vector<std::string> jsonRows;
+              jsonRows.reserve(ql::ranges::size(rows));
+              for (size_t i = 0; i < ql::ranges::size(rows); ++i) {
+                cancellationHandle->throwIfCancelled();
+                jsonRows.push_back(
+                    stringsToQLeverJSONRow(columns, strings, i).dump());
+              }
+              return LoopControl::yieldAll(std::move(jsonRows));
+            };
+        return LoopControl::yieldAll(
+            ad_utility::CachingContinuableTransformInputRange(
+                splitIntoChunks(tableWithRange.view_),
+                std::move(resolveChunk)));
+      });
 };
 
 // Convert a stringvalue and optional type to JSON binding.
@@ -510,40 +577,39 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
   uint64_t resultSize = 0;
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
-      for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
-        if (selectedColumnIndices[j].has_value()) {
-          const auto& val = selectedColumnIndices[j].value();
-          Id id = pair.idTable()(i, val.columnIndex_);
-          auto optionalStringAndType =
-              ql::exportIds::idToStringAndType<format == MediaType::csv>(
-                  qet.getQec()->getIndex(), id, pair.localVocab(),
-                  escapeFunction);
-          if (optionalStringAndType.has_value()) [[likely]] {
-            STREAMABLE_YIELD(optionalStringAndType.value().first);
+    for (const auto& rows : splitIntoChunks(range)) {
+      auto strings = resolveColumnsToStrings<format == MediaType::csv>(
+          qet.getQec()->getIndex(), pair, rows, selectedColumnIndices,
+          escapeFunction);
+      for (size_t i = 0; i < ql::ranges::size(rows); ++i) {
+        for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
+          if (selectedColumnIndices[j].has_value()) {
+            const auto& optionalStringAndType = strings[j][i];
+            if (optionalStringAndType.has_value()) [[likely]] {
+              STREAMABLE_YIELD(optionalStringAndType.value().first);
+            }
+          }
+          if (j + 1 < selectedColumnIndices.size()) {
+            STREAMABLE_YIELD(separator);
           }
         }
-        if (j + 1 < selectedColumnIndices.size()) {
-          STREAMABLE_YIELD(separator);
-        }
+        STREAMABLE_YIELD('\n');
+        cancellationHandle->throwIfCancelled();
       }
-      STREAMABLE_YIELD('\n');
-      cancellationHandle->throwIfCancelled();
     }
   }
   AD_LOG_DEBUG << "Done creating readable result.\n";
 }
 
 // _____________________________________________________________________________
-// Convert a single ID to an XML binding of the given `variable`.
-template <typename IndexType, typename LocalVocabType>
-static std::string idToXMLBinding(std::string_view variable, Id id,
-                                  const IndexType& index,
-                                  const LocalVocabType& localVocab) {
+// Convert the string and type of a single ID (as obtained from
+// `ql::exportIds::idToStringAndType`) to an XML binding of the given
+// `variable`.
+static std::string stringAndTypeToXMLBinding(
+    std::string_view variable,
+    const std::optional<std::pair<std::string, const char*>>& optionalValue) {
   using namespace std::string_view_literals;
   using namespace std::string_literals;
-  const auto& optionalValue =
-      ql::exportIds::idToStringAndType(index, id, localVocab);
   if (!optionalValue.has_value()) {
     return ""s;
   }
@@ -645,18 +711,20 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
   uint64_t resultSize = 0;
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
-      STREAMABLE_YIELD("\n  <result>");
-      for (auto& selectedColIdx : selectedColumnIndices) {
-        if (selectedColIdx.has_value()) {
-          const auto& val = selectedColIdx.value();
-          Id id = pair.idTable()(i, val.columnIndex_);
-          STREAMABLE_YIELD(idToXMLBinding(
-              val.variable_, id, qet.getQec()->getIndex(), pair.localVocab()));
+    for (const auto& rows : splitIntoChunks(range)) {
+      auto strings = resolveColumnsToStrings(
+          qet.getQec()->getIndex(), pair, rows, selectedColumnIndices);
+      for (size_t i = 0; i < ql::ranges::size(rows); ++i) {
+        STREAMABLE_YIELD("\n  <result>");
+        for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
+          if (selectedColumnIndices[j].has_value()) {
+            STREAMABLE_YIELD(stringAndTypeToXMLBinding(
+                selectedColumnIndices[j].value().variable_, strings[j][i]));
+          }
         }
+        STREAMABLE_YIELD("\n  </result>");
+        cancellationHandle->throwIfCancelled();
       }
-      STREAMABLE_YIELD("\n  </result>");
-      cancellationHandle->throwIfCancelled();
     }
   }
   STREAMABLE_YIELD("\n</results>");
@@ -690,15 +758,15 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
       qet.selectedVariablesToColumnIndices(selectClause, false);
   ql::erase(columns, std::nullopt);
 
-  auto getBinding = [&](const TableConstRefWithVocab& pair, const uint64_t& i) {
+  // Get the binding for the `i`-th row of the given `strings` (as obtained
+  // from `resolveColumnsToStrings`).
+  auto getBinding = [&](const std::vector<ColumnStrings>& strings, size_t i) {
     auto binding = nlohmann::ordered_json::object();
-    for (const auto& column : columns) {
-      auto optionalStringAndType = ql::exportIds::idToStringAndType(
-          qet.getQec()->getIndex(), pair.idTable()(i, column->columnIndex_),
-          pair.localVocab());
+    for (size_t j = 0; j < columns.size(); ++j) {
+      const auto& optionalStringAndType = strings[j][i];
       if (optionalStringAndType.has_value()) [[likely]] {
         const auto& [stringValue, xsdType] = optionalStringAndType.value();
-        binding[column->variable_] =
+        binding[columns[j]->variable_] =
             stringAndTypeToBinding(stringValue, xsdType);
       }
     }
@@ -711,17 +779,21 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
   uint64_t resultSize = 0;
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
-      if (!isFirstRow) [[likely]] {
-        STREAMABLE_YIELD(",");
-      }
-      if (columns.empty()) {
-        STREAMABLE_YIELD("{}");
-      } else {
-        STREAMABLE_YIELD(getBinding(pair, i));
+    for (const auto& rows : splitIntoChunks(range)) {
+      auto strings = resolveColumnsToStrings(qet.getQec()->getIndex(), pair,
+                                             rows, columns);
+      for (size_t i = 0; i < ql::ranges::size(rows); ++i) {
+        if (!isFirstRow) [[likely]] {
+          STREAMABLE_YIELD(",");
+        }
+        if (columns.empty()) {
+          STREAMABLE_YIELD("{}");
+        } else {
+          STREAMABLE_YIELD(getBinding(strings, i));
+        }
+        cancellationHandle->throwIfCancelled();
+        isFirstRow = false;
       }
-      cancellationHandle->throwIfCancelled();
-      isFirstRow = false;
     }
   }
 
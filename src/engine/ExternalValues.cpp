@@ -9,16 +9,19 @@
 
 #include "engine/ExternalValues.h"
 
+#include <algorithm>
+
 #include "absl/strings/str_cat.h"
 #include "util/HashSet.h"
 
 // ____________________________________________________________________________
 ExternalValues::ExternalValues(QueryExecutionContext* qec,
                                parsedQuery::SparqlValues parsedValues,
-                               std::string name)
+                               std::string name, bool valuesInCacheKey)
     : Operation(qec),
       Values(qec, std::move(parsedValues)),
-      name_(std::move(name)) {}
+      name_(std::move(name)),
+      valuesInCacheKey_(valuesInCacheKey) {}
 
 // ____________________________________________________________________________
 ExternalValues::ExternalValues(QueryExecutionContext* qec,
@@ -36,10 +39,14 @@ ExternalValues::ExternalValues(QueryExecutionContext* qec,
             values._variables = query.variables_;
             return values;
           }(),
-          query.name_) {}
+          query.name_, query.valuesInCacheKey_) {}
 
 // ____________________________________________________________________________
 std::string ExternalValues::getCacheKeyImpl() const {
+  if (valuesInCacheKey_) {
+    return absl::StrCat("EXTERNAL VALUES '", name_, "' ",
+                        Values::getCacheKeyImpl());
+  }
   // ExternalValues must only be used with caching disabled.
   throw std::runtime_error(
       "ExternalValues does not support cache keys. "
@@ -48,12 +55,32 @@ std::string ExternalValues::getCacheKeyImpl() const {
 
 // ____________________________________________________________________________
 Result ExternalValues::computeResult(bool requestLaziness) {
-  AD_CONTRACT_CHECK(getExecutionContext()->disableCaching(),
+  AD_CONTRACT_CHECK(valuesInCacheKey_ ||
+                        getExecutionContext()->disableCaching(),
                     "ExternalValues can only be used when caching is disabled. "
                     "Set the runtime parameter `disable-caching` to true.");
   return Values::computeResult(requestLaziness);
 }
 
+// ____________________________________________________________________________
+uint64_t ExternalValues::getSizeEstimateBeforeLimit() {
+  size_t numRows = parsedValues()._values.size();
+  return valuesInCacheKey_ ? std::max(numRows, size_t{1}) : numRows;
+}
+
+// ____________________________________________________________________________
+size_t ExternalValues::getCostEstimate() {
+  return getSizeEstimateBeforeLimit();
+}
+
+// ____________________________________________________________________________
+float ExternalValues::getMultiplicity(size_t col) {
+  if (valuesInCacheKey_ && parsedValues()._values.empty()) {
+    return 1.0f;
+  }
+  return Values::getMultiplicity(col);
+}
+
 // ____________________________________________________________________________
 std::string ExternalValues::getDescriptor() const {
   return absl::StrCat("EXTERNAL VALUES '", name_, "'");
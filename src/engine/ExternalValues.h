@@ -24,23 +24,27 @@ struct ExternalValuesQuery;
 // query parsing and planning. For an example usage of this feature end-to-end
 // see `QLeverTest.cpp`. Note: `ExternalValues` can currently only be
 // used if caching is disabled (else an exception will be thrown from the
-// `getCacheKey` and `computeResult` member function).
+// `getCacheKey` and `computeResult` member function). The exception are
+// `ExternalValues` with `valuesInCacheKey` set, see `PreparedQuery.h`.
 class ExternalValues : private Values, virtual public Operation {
  private:
   std::string name_;
+  // If true, the current values are part of the cache key. The owner of the
+  // `QueryExecutionTree` then has to refresh the cache keys after each call to
+  // `updateValues` (see `QueryExecutionTree::recursivelyRebind`).
+  bool valuesInCacheKey_ = false;
 
  public:
   // Inherit public member functions from `Values` that are not overridden.
   using Values::computeVariableToColumnMap;
   using Values::getChildren;
-  using Values::getCostEstimate;
-  using Values::getMultiplicity;
   using Values::getResultWidth;
   using Values::resultSortedOn;
 
   // Create operation from parsed values and name.
   ExternalValues(QueryExecutionContext* qec,
-                 parsedQuery::SparqlValues parsedValues, std::string name);
+                 parsedQuery::SparqlValues parsedValues, std::string name,
+                 bool valuesInCacheKey = false);
 
   // Create operation from an `ExternalValuesQuery`. The variables are taken
   // from the query, and the values start empty.
@@ -62,6 +66,12 @@ class ExternalValues : private Values, virtual public Operation {
   // Override to ensure external values are never considered empty.
   bool knownEmptyResult() override { return false; }
 
+  // With `valuesInCacheKey_`, the values are typically only set after the
+  // query planning, so empty values are estimated as a single row. Otherwise,
+  // these are the estimates of `Values`.
+  size_t getCostEstimate() override;
+  float getMultiplicity(size_t col) override;
+
   std::string getDescriptor() const override;
   Result computeResult(bool requestLaziness) override;
   std::string getCacheKeyImpl() const override;
@@ -74,6 +84,7 @@ class ExternalValues : private Values, virtual public Operation {
   }
 
  private:
+  uint64_t getSizeEstimateBeforeLimit() override;
   std::unique_ptr<Operation> cloneImpl() const override;
 };
 
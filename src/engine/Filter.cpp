@@ -6,16 +6,20 @@
 
 #include "engine/Filter.h"
 
+#include <cmath>
 #include <sstream>
 
 #include "backports/algorithm.h"
 #include "engine/CallFixedSize.h"
 #include "engine/ExistsJoin.h"
+#include "engine/IndexScan.h"
+#include "engine/MorselHelpers.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "global/RuntimeParameters.h"
+#include "index/IndexImpl.h"
 
 using std::endl;
 
@@ -102,8 +106,14 @@ Result Filter::computeResult(bool requestLaziness) {
   ad_utility::callFixedSizeVi(
       width, [this, &subRes, &result, &resultLocalVocab](auto WIDTH) {
         for (Result::IdTableVocabPair& pair : subRes->idTables()) {
-          computeFilterImpl<WIDTH>(result, std::move(pair.idTable_),
-                                   subRes->sortedBy());
+          if (qlever::morselHelpers::Morsels{pair.idTable_.numRows()}
+                  .isParallel()) {
+            result.insertAtEnd(
+                filterIdTable(subRes->sortedBy(), std::move(pair.idTable_)));
+          } else {
+            computeFilterImpl<WIDTH>(result, std::move(pair.idTable_),
+                                     subRes->sortedBy());
+          }
           resultLocalVocab.mergeWith(pair.localVocab_);
         }
       });
@@ -120,11 +130,41 @@ CPP_template_def(typename Table)(requires IdTableLike<Table>)
   size_t width = idTable.numColumns();
   IdTable result{width, getExecutionContext()->getAllocator()};
 
-  auto impl = [this, &result, &idTable, &sortedBy](auto WIDTH) {
-    return this->computeFilterImpl<WIDTH>(result, AD_FWD(idTable),
-                                          std::move(sortedBy));
-  };
-  ad_utility::callFixedSizeVi(width, impl);
+  qlever::morselHelpers::Morsels morsels{idTable.numRows()};
+  if (!morsels.isParallel()) {
+    auto impl = [this, &result, &idTable, &sortedBy](auto WIDTH) {
+      return this->computeFilterImpl<WIDTH>(result, AD_FWD(idTable),
+                                            std::move(sortedBy));
+    };
+    ad_utility::callFixedSizeVi(width, impl);
+    return result;
+  }
+
+  // Filter the morsels of the input independently and in parallel, and then
+  // concatenate the results in the order of the morsels. Each morsel is sorted
+  // like the complete input, so the binary search optimizations for sorted
+  // inputs still apply.
+  auto input = idTable.template asStaticView<0>();
+  std::vector<IdTable> morselResults;
+  morselResults.reserve(morsels.size());
+  for (size_t i = 0; i < morsels.size(); ++i) {
+    morselResults.emplace_back(width, getExecutionContext()->getAllocator());
+  }
+  morsels.forEach([&](size_t morsel, size_t begin, size_t end) {
+    ad_utility::callFixedSizeVi(width, [&](auto WIDTH) {
+      computeFilterImpl<WIDTH>(morselResults.at(morsel),
+                               input.asRowRangeView(begin, end), sortedBy);
+    });
+  });
+  size_t totalSize = 0;
+  for (const auto& morselResult : morselResults) {
+    totalSize += morselResult.numRows();
+  }
+  result.reserve(totalSize);
+  for (const auto& morselResult : morselResults) {
+    result.insertAtEnd(morselResult);
+    checkCancellation();
+  }
   return result;
 }
 
@@ -230,13 +270,67 @@ CPP_template_def(int WIDTH,
 
 // _____________________________________________________________________________
 uint64_t Filter::getSizeEstimateBeforeLimit() {
+  uint64_t inputSizeEstimate = _subtree->getSizeEstimate();
+  if (auto estimate =
+          getSizeEstimateFromPredicateStatistics(inputSizeEstimate)) {
+    return estimate.value();
+  }
   return _expression
       .getEstimatesForFilterExpression(
-          _subtree->getSizeEstimate(),
+          inputSizeEstimate,
           _subtree->getRootOperation()->getPrimarySortKeyVariable())
       .sizeEstimate;
 }
 
+// _____________________________________________________________________________
+std::optional<uint64_t> Filter::getSizeEstimateFromPredicateStatistics(
+    uint64_t inputSizeEstimate) const {
+  auto comparison =
+      _expression.getComparisonWithConstant(getLocalVocabContext());
+  if (!comparison.has_value()) {
+    return std::nullopt;
+  }
+  // Find an `IndexScan` that binds the variable as its object.
+  auto findScan = [&variable = comparison->variable_](
+                      const QueryExecutionTree& tree,
+                      const auto& self) -> const IndexScan* {
+    const auto* scan =
+        dynamic_cast<const IndexScan*>(tree.getRootOperation().get());
+    if (scan != nullptr && scan->object() == variable &&
+        !scan->predicate().isVariable()) {
+      return scan;
+    }
+    for (const QueryExecutionTree* child :
+         tree.getRootOperation()->getChildren()) {
+      if (const auto* result = self(*child, self)) {
+        return result;
+      }
+    }
+    return nullptr;
+  };
+  const IndexScan* scan = findScan(*_subtree, findScan);
+  if (scan == nullptr) {
+    return std::nullopt;
+  }
+  const auto& index = getIndex().getImpl();
+  auto predicate = scan->predicate().toValueId(index);
+  if (!predicate.has_value()) {
+    return std::nullopt;
+  }
+  // The `LocalVocab` keeps a constant that is not contained in the vocabulary
+  // alive during the estimation.
+  LocalVocab localVocab;
+  Id value = prefilterExpressions::PrefilterExpression::
+      getValueIdFromIdOrLocalVocabEntry(comparison->value_, localVocab);
+  auto fraction = index.getPredicateStatistics().estimateFraction(
+      predicate.value(), comparison->comparison_, value);
+  if (!fraction.has_value()) {
+    return std::nullopt;
+  }
+  return static_cast<uint64_t>(
+      std::ceil(static_cast<double>(inputSizeEstimate) * fraction.value()));
+}
+
 // _____________________________________________________________________________
 size_t Filter::getCostEstimate() {
   return _subtree->getCostEstimate() +
@@ -70,6 +70,14 @@ class Filter : public Operation {
   // be updated.
   void setPrefilterExpressionForChildren();
 
+  // If the expression is a comparison of a variable with a constant (e.g.
+  // `?x < 42`) and the variable is bound as the object of an `IndexScan` with
+  // a fixed predicate in the `_subtree`, estimate the size of the result using
+  // the `PredicateStatistics` of the index. Return `std::nullopt` if this is
+  // not possible.
+  std::optional<uint64_t> getSizeEstimateFromPredicateStatistics(
+      uint64_t inputSizeEstimate) const;
+
   Result computeResult(bool requestLaziness) override;
 
   // Perform the actual filter operation of the data provided.
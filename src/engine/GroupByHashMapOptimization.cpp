@@ -80,12 +80,32 @@ void GroupConcatAggregationData::addValueImpl(
 }
 
 // _____________________________________________________________________________
-GroupConcatAggregationData::GroupConcatAggregationData(
-    std::string_view separator)
-    : separator_{separator} {
-  currentValue_.reserve(20000);
+void GroupConcatAggregationData::merge(
+    const GroupConcatAggregationData& other,
+    [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+  // Nothing was added to `other`, or this is already undefined.
+  if (other.first_ || undefined_) {
+    return;
+  }
+  if (other.undefined_) {
+    undefined_ = true;
+    first_ = false;
+    return;
+  }
+  if (first_) {
+    first_ = false;
+  } else {
+    currentValue_.append(separator_);
+  }
+  currentValue_.append(other.currentValue_);
 }
 
+// _____________________________________________________________________________
+GroupConcatAggregationData::GroupConcatAggregationData(
+    std::string_view separator,
+    const ad_utility::AllocatorWithLimit<char>& allocator)
+    : currentValue_{allocator}, separator_{separator} {}
+
 // _____________________________________________________________________________
 void GroupConcatAggregationData::reset() {
   undefined_ = false;
@@ -11,6 +11,7 @@
 #include "engine/sparqlExpressions/AggregateExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "util/AllocatorWithLimit.h"
 
 // _____________________________________________________________________________
 // For `AVG`, add value to sum if it is numeric, otherwise
@@ -48,6 +49,15 @@ struct AvgAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // Merge the values aggregated by `other` into this (used for the parallel
+  // hash map aggregation).
+  void merge(const AvgAggregationData& other,
+             [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    error_ = error_ || other.error_;
+    sum_ += other.sum_;
+    count_ += other.count_;
+  }
+
   void reset() { *this = AvgAggregationData{}; }
 };
 
@@ -67,6 +77,12 @@ struct CountAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void merge(const CountAggregationData& other,
+             [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    count_ += other.count_;
+  }
+
   void reset() { *this = CountAggregationData{}; }
 };
 
@@ -94,6 +110,14 @@ struct ExtremumAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void merge(const ExtremumAggregationData& other,
+             const sparqlExpression::EvaluationContext* ctx) {
+    if (other.firstValueSet_) {
+      addValue(other.currentValue_, ctx);
+    }
+  }
+
   void reset() { *this = ExtremumAggregationData{}; }
 };
 
@@ -137,6 +161,15 @@ struct SumAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void merge(const SumAggregationData& other,
+             [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    error_ = error_ || other.error_;
+    intSumValid_ = intSumValid_ && other.intSumValid_;
+    sum_ += other.sum_;
+    intSum_ += other.intSum_;
+  }
+
   void reset() { *this = SumAggregationData{}; }
 };
 
@@ -144,9 +177,12 @@ struct SumAggregationData {
 struct GroupConcatAggregationData {
   using ValueGetter =
       sparqlExpression::detail::LiteralValueGetterWithoutStrFunction;
+  // The concatenated string counts against the memory limit of the query.
+  using String = std::basic_string<char, std::char_traits<char>,
+                                   ad_utility::AllocatorWithLimit<char>>;
   bool undefined_ = false;
   bool first_ = true;
-  std::string currentValue_;
+  String currentValue_;
   std::string_view separator_;
 
   // _____________________________________________________________________________
@@ -167,7 +203,14 @@ struct GroupConcatAggregationData {
   [[nodiscard]] ValueId calculateResult(const LocalVocabContext& context,
                                         LocalVocab* localVocab) const;
 
-  explicit GroupConcatAggregationData(std::string_view separator);
+  // Append the values concatenated by `other` (which were added after the
+  // values of this) to this.
+  void merge(const GroupConcatAggregationData& other,
+             [[maybe_unused]] const sparqlExpression::EvaluationContext*);
+
+  GroupConcatAggregationData(
+      std::string_view separator,
+      const ad_utility::AllocatorWithLimit<char>& allocator);
 
   void reset();
 };
@@ -189,6 +232,14 @@ struct SampleAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void merge(const SampleAggregationData& other,
+             [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    if (!value_.has_value()) {
+      value_ = other.value_;
+    }
+  }
+
   void reset() { *this = SampleAggregationData{}; }
 };
 
@@ -15,6 +15,7 @@
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/LazyGroupBy.h"
+#include "engine/MorselHelpers.h"
 #include "engine/Sort.h"
 #include "engine/StripColumns.h"
 #include "engine/sparqlExpressions/AggregateExpression.h"
@@ -1195,6 +1196,13 @@ GroupByImpl::checkIfHashMapOptimizationPossible(
   if (!std::dynamic_pointer_cast<const Sort>(_subtree->getRootOperation())) {
     return std::nullopt;
   }
+  // If the sorted input is already cached, the sort is for free and the
+  // aggregation of the sorted input is cheaper than the hash map.
+  const auto* qec = getExecutionContext();
+  if (qec->getQueryTreeCache().cacheContains(QueryCacheKey{
+          _subtree->getCacheKey(), qec->locatedTriplesState().index_})) {
+    return std::nullopt;
+  }
   return computeUnsequentialProcessingMetadata(aliases, _groupByVariables);
 }
 
@@ -1480,15 +1488,23 @@ GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::getHashEntries(
     hashEntries.push_back(iterator->second);
   }
 
+  resizeAggregationData();
+  return hashEntries;
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::HashMapAggregationData<
+    NUM_GROUP_COLUMNS>::resizeAggregationData() {
   // CPP_template_lambda(capture)(typenames...)(arg)(requires ...)`
-  auto resizeVectors = CPP_template_lambda()(typename T)(
+  auto resizeVectors = CPP_template_lambda(this)(typename T)(
       T & arg, size_t numberOfGroups,
       [[maybe_unused]] const HashMapAggregateTypeWithData& info)(
       requires true) {
     if constexpr (ql::concepts::same_as<typename T::value_type,
                                         GroupConcatAggregationData>) {
       arg.resize(numberOfGroups,
-                 GroupConcatAggregationData{info.separator_.value()});
+                 GroupConcatAggregationData{info.separator_.value(), alloc_});
     } else {
       arg.resize(numberOfGroups);
     }
@@ -1507,8 +1523,54 @@ GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::getHashEntries(
         aggregation);
     ++idx;
   }
+}
 
-  return hashEntries;
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+auto GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::partitionGroups(
+    size_t numPartitions) const -> std::vector<std::vector<const Group*>> {
+  AD_CONTRACT_CHECK(numPartitions > 0);
+  std::vector<std::vector<const Group*>> partitions(numPartitions);
+  for (const Group& group : map_) {
+    // Use the upper bits of the hash, the lower bits determine the bucket in
+    // the hash map of the partition.
+    size_t hash = map_.hash_function()(group.first);
+    partitions[(hash >> 32) % numPartitions].push_back(&group);
+  }
+  return partitions;
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::mergeGroups(
+    const HashMapAggregationData& other,
+    const std::vector<const Group*>& groups,
+    const sparqlExpression::EvaluationContext* ctx) {
+  AD_CONTRACT_CHECK(aggregationData_.size() == other.aggregationData_.size());
+  // The pairs of the offset in this and the offset in `other` of each group.
+  std::vector<std::pair<size_t, size_t>> offsets;
+  offsets.reserve(groups.size());
+  for (const Group* group : groups) {
+    auto [iterator, wasAdded] =
+        map_.try_emplace(group->first, getNumberOfGroups());
+    offsets.emplace_back(iterator->second, group->second);
+  }
+  resizeAggregationData();
+
+  for (size_t i = 0; i < aggregationData_.size(); ++i) {
+    std::visit(
+        [&offsets, &otherData = other.aggregationData_.at(i), ctx](
+            auto& aggregationDataVector) {
+          const auto& otherVector =
+              std::get<std::decay_t<decltype(aggregationDataVector)>>(
+                  otherData);
+          for (auto [offset, otherOffset] : offsets) {
+            aggregationDataVector.at(offset).merge(otherVector.at(otherOffset),
+                                                   ctx);
+          }
+        },
+        aggregationData_.at(i));
+  }
 }
 
 // _____________________________________________________________________________
@@ -1772,6 +1834,132 @@ static constexpr auto makeProcessGroupsVisitor =
       };
     };
 
+// _____________________________________________________________________________
+sparqlExpression::EvaluationContext
+GroupByImpl::createEvaluationContextForHashMap(
+    LocalVocab& localVocab, const IdTableView<0>& inputTable) const {
+  sparqlExpression::EvaluationContext evaluationContext(
+      *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
+      getExecutionContext()->getAllocator(), localVocab, cancellationHandle_,
+      deadline_);
+  evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
+      _groupByVariables.begin(), _groupByVariables.end()};
+  evaluationContext._isPartOfGroupBy = true;
+  return evaluationContext;
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::aggregateRowsWithHashMap(
+    HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+    const std::vector<HashMapAliasInformation>& aggregateAliases,
+    sparqlExpression::EvaluationContext& evaluationContext,
+    const std::vector<size_t>& columnIndices, size_t beginRow, size_t endRow,
+    ad_utility::Timer& lookupTimer, ad_utility::Timer& aggregationTimer) const {
+  const auto& inputTable = evaluationContext._inputTable;
+  // Process (up to) `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows at a time.
+  for (size_t i = beginRow; i < endRow; i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
+    checkCancellation();
+
+    evaluationContext._beginIndex = i;
+    evaluationContext._endIndex =
+        std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, endRow);
+
+    auto currentBlockSize = evaluationContext.size();
+
+    // Perform HashMap lookup once for all groups in current block
+    using U = typename HashMapAggregationData<
+        NUM_GROUP_COLUMNS>::template ArrayOrVector<ql::span<const Id>>;
+    U groupValues;
+    resizeIfVector(groupValues, columnIndices.size());
+
+    // TODO<C++23> use views::enumerate
+    size_t j = 0;
+    for (auto& idx : columnIndices) {
+      groupValues[j] = inputTable.getColumn(idx).subspan(
+          evaluationContext._beginIndex, currentBlockSize);
+      ++j;
+    }
+    lookupTimer.cont();
+    auto hashEntries = aggregationData.getHashEntries(groupValues);
+    lookupTimer.stop();
+
+    aggregationTimer.cont();
+    for (const auto& aggregateAlias : aggregateAliases) {
+      for (const auto& aggregate : aggregateAlias.aggregateInfo_) {
+        sparqlExpression::ExpressionResult expressionResult =
+            GroupByImpl::evaluateChildExpressionOfAggregateFunction(
+                aggregate, evaluationContext);
+
+        auto& aggregationDataVariant =
+            aggregationData.getAggregationDataVariant(
+                aggregate.aggregateDataIndex_);
+
+        std::visit(makeProcessGroupsVisitor(currentBlockSize,
+                                            &evaluationContext, hashEntries),
+                   std::move(expressionResult), aggregationDataVariant);
+      }
+    }
+    aggregationTimer.stop();
+  }
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::aggregateBlockWithPartitionedHashMap(
+    std::vector<HashMapAggregationData<NUM_GROUP_COLUMNS>>& partitions,
+    const std::vector<HashMapAliasInformation>& aggregateAliases,
+    const IdTableView<0>& inputTable, LocalVocab& localVocab,
+    const std::vector<size_t>& columnIndices) const {
+  const size_t numPartitions = partitions.size();
+  const size_t numChunks =
+      std::clamp(inputTable.size() / GROUP_BY_HASH_MAP_MIN_ROWS_PER_THREAD,
+                 size_t{1}, numPartitions);
+  const size_t chunkSize = (inputTable.size() + numChunks - 1) / numChunks;
+
+  // Phase 1: Each thread pre-aggregates a contiguous chunk of the rows into its
+  // own hash map, and then splits the resulting groups into the partitions.
+  std::vector<HashMapAggregationData<NUM_GROUP_COLUMNS>> chunkAggregationData;
+  chunkAggregationData.reserve(numChunks);
+  for (size_t i = 0; i < numChunks; ++i) {
+    chunkAggregationData.emplace_back(getExecutionContext()->getAllocator(),
+                                      aggregateAliases, columnIndices.size());
+  }
+  std::vector<LocalVocab> chunkLocalVocabs(numChunks);
+  using Group = typename HashMapAggregationData<NUM_GROUP_COLUMNS>::Group;
+  std::vector<std::vector<std::vector<const Group*>>> chunkPartitions(
+      numChunks);
+  qlever::morselHelpers::Morsels{inputTable.size(), chunkSize, numChunks}
+      .forEach([&](size_t chunk, size_t beginRow, size_t endRow) {
+        auto evaluationContext = createEvaluationContextForHashMap(
+            chunkLocalVocabs.at(chunk), inputTable);
+        ad_utility::Timer lookupTimer{ad_utility::Timer::Stopped};
+        ad_utility::Timer aggregationTimer{ad_utility::Timer::Stopped};
+        aggregateRowsWithHashMap(chunkAggregationData.at(chunk),
+                                 aggregateAliases, evaluationContext,
+                                 columnIndices, beginRow, endRow, lookupTimer,
+                                 aggregationTimer);
+        chunkPartitions.at(chunk) =
+            chunkAggregationData.at(chunk).partitionGroups(numPartitions);
+      });
+  localVocab.mergeWith(chunkLocalVocabs);
+
+  // Phase 2: Each thread merges the groups of one partition from all the
+  // chunks. The chunks are merged in their order, s.t. the values of each
+  // group are aggregated in the order of the input.
+  qlever::morselHelpers::Morsels{numPartitions, 1, numPartitions}.forEach(
+      [&](size_t partition, size_t, size_t) {
+        checkCancellation();
+        auto evaluationContext =
+            createEvaluationContextForHashMap(localVocab, inputTable);
+        for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+          partitions.at(partition).mergeGroups(
+              chunkAggregationData.at(chunk),
+              chunkPartitions.at(chunk).at(partition), &evaluationContext);
+        }
+      });
+}
+
 // _____________________________________________________________________________
 template <size_t NUM_GROUP_COLUMNS, typename SubResults>
 Result GroupByImpl::computeGroupByForHashMapOptimization(
@@ -1780,11 +1968,46 @@ Result GroupByImpl::computeGroupByForHashMapOptimization(
   AD_CORRECTNESS_CHECK(columnIndices.size() == NUM_GROUP_COLUMNS ||
                        NUM_GROUP_COLUMNS == 0);
   LocalVocab localVocab;
+  auto makeAggregationData = [&]() {
+    return HashMapAggregationData<NUM_GROUP_COLUMNS>(
+        getExecutionContext()->getAllocator(), aggregateAliases,
+        columnIndices.size());
+  };
+  // Merge the given `groups` of `source` into `target`. Only the aggregation
+  // data is merged, so the evaluation context has an empty input.
+  auto mergeGroups = [this, &localVocab](auto& target, const auto& source,
+                                         const auto& groups) {
+    IdTable emptyInput{0, getExecutionContext()->getAllocator()};
+    auto evaluationContext = createEvaluationContextForHashMap(
+        localVocab, emptyInput.asStaticView<0>());
+    target.mergeGroups(source, groups, &evaluationContext);
+  };
 
   // Initialize the data for the aggregates of the GROUP BY operation.
-  HashMapAggregationData<NUM_GROUP_COLUMNS> aggregationData(
-      getExecutionContext()->getAllocator(), aggregateAliases,
-      columnIndices.size());
+  std::optional<HashMapAggregationData<NUM_GROUP_COLUMNS>> aggregationData;
+  aggregationData.emplace(makeAggregationData());
+
+  // The input blocks are aggregated serially into `aggregationData` until
+  // there is a block that is large enough to be split into chunks for several
+  // threads. From then on (if there is more than one thread), the groups are
+  // split into one partition per thread by their hash, and each partition has
+  // its own hash map. This avoids the overhead of the partitioning and the
+  // threads for small inputs.
+  const size_t numThreads = std::max(
+      getRuntimeParameter<&RuntimeParameters::groupByHashMapNumThreads_>(),
+      size_t{1});
+  std::vector<HashMapAggregationData<NUM_GROUP_COLUMNS>> partitions;
+  auto switchToPartitions = [&]() {
+    // The groups of the previous blocks are merged first, s.t. the values are
+    // still aggregated in the order of the input.
+    auto groups = aggregationData.value().partitionGroups(numThreads);
+    partitions.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+      mergeGroups(partitions.emplace_back(makeAggregationData()),
+                  aggregationData.value(), groups.at(i));
+    }
+    aggregationData.reset();
+  };
 
   // Process the input blocks (pairs of `IdTable` and `LocalVocab`) one after
   // the other.
@@ -1799,68 +2022,44 @@ Result GroupByImpl::computeGroupByForHashMapOptimization(
     // NOTE: If the input blocks have very similar or even identical non-empty
     // local vocabs, no deduplication is performed.
     localVocab.mergeWith(inputLocalVocab);
-    // Setup the `EvaluationContext` for this input block.
-    sparqlExpression::EvaluationContext evaluationContext(
-        *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
-        getExecutionContext()->getAllocator(), localVocab, cancellationHandle_,
-        deadline_);
-    evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
-        _groupByVariables.begin(), _groupByVariables.end()};
-    evaluationContext._isPartOfGroupBy = true;
-
-    // Iterate of the rows of this input block. Process (up to)
-    // `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows at a time.
-    for (size_t i = 0; i < inputTable.size();
-         i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
-      checkCancellation();
-
-      evaluationContext._beginIndex = i;
-      evaluationContext._endIndex =
-          std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, inputTable.size());
-
-      auto currentBlockSize = evaluationContext.size();
-
-      // Perform HashMap lookup once for all groups in current block
-      using U = typename HashMapAggregationData<
-          NUM_GROUP_COLUMNS>::template ArrayOrVector<ql::span<const Id>>;
-      U groupValues;
-      resizeIfVector(groupValues, columnIndices.size());
-
-      // TODO<C++23> use views::enumerate
-      size_t j = 0;
-      for (auto& idx : columnIndices) {
-        groupValues[j] = inputTable.getColumn(idx).subspan(
-            evaluationContext._beginIndex, currentBlockSize);
-        ++j;
-      }
-      lookupTimer.cont();
-      auto hashEntries = aggregationData.getHashEntries(groupValues);
-      lookupTimer.stop();
 
+    if (partitions.empty() && numThreads > 1 &&
+        inputTable.size() >= 2 * GROUP_BY_HASH_MAP_MIN_ROWS_PER_THREAD) {
+      switchToPartitions();
+    }
+    if (!partitions.empty()) {
       aggregationTimer.cont();
-      for (auto& aggregateAlias : aggregateAliases) {
-        for (auto& aggregate : aggregateAlias.aggregateInfo_) {
-          sparqlExpression::ExpressionResult expressionResult =
-              GroupByImpl::evaluateChildExpressionOfAggregateFunction(
-                  aggregate, evaluationContext);
-
-          auto& aggregationDataVariant =
-              aggregationData.getAggregationDataVariant(
-                  aggregate.aggregateDataIndex_);
-
-          std::visit(makeProcessGroupsVisitor(currentBlockSize,
-                                              &evaluationContext, hashEntries),
-                     std::move(expressionResult), aggregationDataVariant);
-        }
-      }
+      aggregateBlockWithPartitionedHashMap(partitions, aggregateAliases,
+                                           inputTable, localVocab,
+                                           columnIndices);
       aggregationTimer.stop();
+      continue;
     }
-  }
 
-  runtimeInfo().addDetail("timeMapLookup", lookupTimer.msecs());
+    // Setup the `EvaluationContext` for this input block.
+    auto evaluationContext =
+        createEvaluationContextForHashMap(localVocab, inputTable);
+    aggregateRowsWithHashMap(aggregationData.value(), aggregateAliases,
+                             evaluationContext, columnIndices, 0,
+                             inputTable.size(), lookupTimer, aggregationTimer);
+  }
+
+  if (!partitions.empty()) {
+    // The partitions are disjoint, so this only inserts the groups.
+    ad_utility::Timer mergeTimer{ad_utility::Timer::Started};
+    aggregationData.emplace(makeAggregationData());
+    for (const auto& partition : partitions) {
+      mergeGroups(aggregationData.value(), partition,
+                  partition.partitionGroups(1).at(0));
+    }
+    runtimeInfo().addDetail("numThreads", numThreads);
+    runtimeInfo().addDetail("timePartitionMerge", mergeTimer.msecs());
+  } else {
+    runtimeInfo().addDetail("timeMapLookup", lookupTimer.msecs());
+  }
   runtimeInfo().addDetail("timeAggregation", aggregationTimer.msecs());
-  IdTable resultTable =
-      createResultFromHashMap(aggregationData, aggregateAliases, &localVocab);
+  IdTable resultTable = createResultFromHashMap(aggregationData.value(),
+                                                aggregateAliases, &localVocab);
   return {std::move(resultTable), resultSortedOn(), std::move(localVocab)};
 }
 
@@ -27,6 +27,9 @@
 
 // Block size for when using the hash map optimization
 static constexpr size_t GROUP_BY_HASH_MAP_BLOCK_SIZE = 262144;
+// The minimal number of rows of an input block that each thread processes in
+// the parallel hash map optimization of GROUP BY.
+static constexpr size_t GROUP_BY_HASH_MAP_MIN_ROWS_PER_THREAD = 65536;
 
 namespace groupBy::detail {
 template <size_t IN_WIDTH, size_t OUT_WIDTH>
@@ -329,7 +332,10 @@ class GroupByImpl : public Operation {
   };
 
   // Create result IdTable by using a HashMap mapping groups to aggregation data
-  // and subsequently calling `createResultFromHashMap`.
+  // and subsequently calling `createResultFromHashMap`. If the runtime
+  // parameter `group-by-hash-map-num-threads` is larger than one, the
+  // aggregation is done in parallel (see
+  // `aggregateBlockWithPartitionedHashMap`).
   template <size_t NUM_GROUP_COLUMNS, typename SubResults>
   Result computeGroupByForHashMapOptimization(
       std::vector<HashMapAliasInformation>& aggregateAliases,
@@ -420,11 +426,32 @@ class GroupByImpl : public Operation {
     // Returns the number of groups.
     [[nodiscard]] size_t getNumberOfGroups() const { return map_.size(); }
 
+    // A group, consisting of the values of the grouped columns and the offset
+    // of its aggregation data.
+    using Group = std::pair<const ArrayOrVector<Id>, size_t>;
+
+    // Split the groups into `numPartitions` partitions by the hash of their
+    // values. The pointers stay valid as long as this object is alive.
+    [[nodiscard]] std::vector<std::vector<const Group*>> partitionGroups(
+        size_t numPartitions) const;
+
+    // Merge the aggregation data of the `groups` of `other` into the groups
+    // of this with the same values, inserting them if necessary. The data of
+    // `other` is added after the data that is already contained in this, which
+    // matters for `GROUP_CONCAT` and `SAMPLE`.
+    void mergeGroups(const HashMapAggregationData& other,
+                     const std::vector<const Group*>& groups,
+                     const sparqlExpression::EvaluationContext* ctx);
+
     // How many columns we are grouping by, important in case
     // `NUM_GROUP_COLUMNS` == 0.
     size_t numOfGroupedColumns_;
 
    private:
+    // Resize the vectors of the aggregation data to the current number of
+    // groups.
+    void resizeAggregationData();
+
     // Allocator used for creating new vectors.
     const ad_utility::AllocatorWithLimit<Id>& alloc_;
     // Maps `Id` to vector offsets.
@@ -488,6 +515,35 @@ class GroupByImpl : public Operation {
       const HashMapAggregateInformation& aggregate,
       sparqlExpression::EvaluationContext& evaluationContext);
 
+  // Create the `EvaluationContext` for the child expressions of the aggregates
+  // in the hash map optimization.
+  sparqlExpression::EvaluationContext createEvaluationContextForHashMap(
+      LocalVocab& localVocab, const IdTableView<0>& inputTable) const;
+
+  // Aggregate the rows `[beginRow, endRow)` of the input table of the
+  // `evaluationContext` into the `aggregationData`.
+  template <size_t NUM_GROUP_COLUMNS>
+  void aggregateRowsWithHashMap(
+      HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+      const std::vector<HashMapAliasInformation>& aggregateAliases,
+      sparqlExpression::EvaluationContext& evaluationContext,
+      const std::vector<size_t>& columnIndices, size_t beginRow, size_t endRow,
+      ad_utility::Timer& lookupTimer,
+      ad_utility::Timer& aggregationTimer) const;
+
+  // Aggregate the `inputTable` in parallel into the `partitions`, which
+  // contain disjoint sets of groups (split by the hash of the group values).
+  // First, one thread per contiguous chunk of the input pre-aggregates the
+  // chunk into its own hash map. Then one thread per partition merges the
+  // groups of this partition from all chunks, in the order of the chunks.
+  // Entries that are added to the local vocab are added to `localVocab`.
+  template <size_t NUM_GROUP_COLUMNS>
+  void aggregateBlockWithPartitionedHashMap(
+      std::vector<HashMapAggregationData<NUM_GROUP_COLUMNS>>& partitions,
+      const std::vector<HashMapAliasInformation>& aggregateAliases,
+      const IdTableView<0>& inputTable, LocalVocab& localVocab,
+      const std::vector<size_t>& columnIndices) const;
+
   // Sort the HashMap by key and create result table.
   template <size_t NUM_GROUP_COLUMNS>
   IdTable createResultFromHashMap(
@@ -0,0 +1,293 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/HashJoin.h"
+
+#include <sstream>
+
+#include "engine/Join.h"
+#include "engine/JoinHelpers.h"
+#include "util/InputRangeUtils.h"
+#include "util/Timer.h"
+#include "util/Views.h"
+
+// _____________________________________________________________________________
+HashJoin::BuildSide::BuildSide(
+    const IdTable& table, ColumnIndex joinCol,
+    const ad_utility::AllocatorWithLimit<Id>& allocator)
+    : table_{table},
+      joinCol_{joinCol},
+      ranges_{allocator},
+      rowIndices_{allocator},
+      undefRows_{allocator} {
+  auto col = table.getColumn(joinCol);
+  // First count the rows per value, then assign a contiguous range in
+  // `rowIndices_` to each value, and finally fill these ranges. The `second`
+  // of each range is used as the insertion position and therefore ends up at
+  // the end of the range.
+  for (Id id : col) {
+    if (!id.isUndefined()) {
+      ++ranges_[id].second;
+    }
+  }
+  size_t offset = 0;
+  for (auto& [id, range] : ranges_) {
+    size_t count = range.second;
+    range = {offset, offset};
+    offset += count;
+  }
+  rowIndices_.resize(offset);
+  for (size_t i = 0; i < col.size(); ++i) {
+    if (col[i].isUndefined()) {
+      undefRows_.push_back(i);
+    } else {
+      rowIndices_[ranges_.find(col[i])->second.second++] = i;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+HashJoin::HashJoin(QueryExecutionContext* qec,
+                   std::shared_ptr<QueryExecutionTree> t1,
+                   std::shared_ptr<QueryExecutionTree> t2,
+                   ColumnIndex t1JoinCol, ColumnIndex t2JoinCol,
+                   bool allowSwappingChildrenOnlyForTesting)
+    : Operation(qec) {
+  AD_CONTRACT_CHECK(t1 && t2);
+  // Make the order of the two subtrees deterministic, see `Join` for details.
+  if (allowSwappingChildrenOnlyForTesting &&
+      t1->getCacheKey() > t2->getCacheKey()) {
+    std::swap(t1, t2);
+    std::swap(t1JoinCol, t2JoinCol);
+  }
+  left_ = std::move(t1);
+  leftJoinCol_ = t1JoinCol;
+  right_ = std::move(t2);
+  rightJoinCol_ = t2JoinCol;
+  joinVar_ = left_->getVariableAndInfoByColumnIndex(leftJoinCol_).first;
+  AD_CONTRACT_CHECK(
+      joinVar_ ==
+      right_->getVariableAndInfoByColumnIndex(rightJoinCol_).first);
+  // The smaller input is materialized and stored in the hash map.
+  leftIsBuildSide_ = left_->getSizeEstimate() <= right_->getSizeEstimate();
+}
+
+// _____________________________________________________________________________
+std::string HashJoin::getCacheKeyImpl() const {
+  std::ostringstream os;
+  os << "HASH JOIN\n"
+     << left_->getCacheKey() << " join-column: [" << leftJoinCol_ << "]\n";
+  os << "|X|\n"
+     << right_->getCacheKey() << " join-column: [" << rightJoinCol_ << "]";
+  return std::move(os).str();
+}
+
+// _____________________________________________________________________________
+std::string HashJoin::getDescriptor() const {
+  return "HashJoin on " + joinVar_.name();
+}
+
+// _____________________________________________________________________________
+size_t HashJoin::getResultWidth() const {
+  return left_->getResultWidth() + right_->getResultWidth() - 1;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap HashJoin::computeVariableToColumnMap() const {
+  return makeVarToColMapForJoinOperation(
+      left_->getVariableColumns(), right_->getVariableColumns(),
+      {{leftJoinCol_, rightJoinCol_}}, BinOpType::Join,
+      left_->getResultWidth());
+}
+
+// _____________________________________________________________________________
+const std::pair<size_t, std::vector<float>>&
+HashJoin::getSizeEstimateAndMultiplicities() {
+  if (!sizeEstimateAndMultiplicities_.has_value()) {
+    sizeEstimateAndMultiplicities_ = Join::computeSizeEstimateAndMultiplicities(
+        _executionContext, *left_, leftJoinCol_, *right_, rightJoinCol_, true);
+  }
+  return sizeEstimateAndMultiplicities_.value();
+}
+
+// _____________________________________________________________________________
+uint64_t HashJoin::getSizeEstimateBeforeLimit() {
+  return getSizeEstimateAndMultiplicities().first;
+}
+
+// _____________________________________________________________________________
+float HashJoin::getMultiplicity(size_t col) {
+  return getSizeEstimateAndMultiplicities().second.at(col);
+}
+
+// _____________________________________________________________________________
+size_t HashJoin::getCostEstimate() {
+  auto& buildSide = leftIsBuildSide_ ? left_ : right_;
+  auto& probeSide = leftIsBuildSide_ ? right_ : left_;
+  double buildCostFactor =
+      _executionContext
+          ? _executionContext->getCostFactor("HASH_JOIN_BUILD_COST")
+          : 1.0;
+  auto buildCost =
+      static_cast<size_t>(buildCostFactor * buildSide->getSizeEstimate());
+  return getSizeEstimateBeforeLimit() + buildCost +
+         probeSide->getSizeEstimate() + left_->getCostEstimate() +
+         right_->getCostEstimate();
+}
+
+// _____________________________________________________________________________
+bool HashJoin::columnOriginatesFromGraphOrUndef(
+    const Variable& variable) const {
+  AD_CONTRACT_CHECK(getExternallyVisibleVariableColumns().contains(variable));
+  if (variable == joinVar_) {
+    return qlever::joinHelpers::doesJoinProduceGuaranteedGraphValuesOrUndef(
+        left_, right_, variable);
+  }
+  return Operation::columnOriginatesFromGraphOrUndef(variable);
+}
+
+// _____________________________________________________________________________
+IdTable HashJoin::joinBlock(const BuildSide& buildSide, const IdTable& probe,
+                            ColumnIndex probeJoinCol) const {
+  return joinWithBuildSide(buildSide, leftIsBuildSide_, probe, probeJoinCol,
+                           allocator(), [this]() { checkCancellation(); });
+}
+
+// _____________________________________________________________________________
+IdTable HashJoin::joinWithBuildSide(
+    const BuildSide& buildSide, bool buildSideIsLeft, const IdTable& probe,
+    ColumnIndex probeJoinCol, ad_utility::AllocatorWithLimit<Id> allocator,
+    const std::function<void()>& checkCancellation) {
+  // First collect the indices of all pairs of matching rows, then write the
+  // result column by column.
+  RowIndices buildRows{allocator};
+  RowIndices probeRows{allocator};
+  auto probeCol = probe.getColumn(probeJoinCol);
+  for (size_t i = 0; i < probeCol.size(); ++i) {
+    buildSide.forEachMatch(probeCol[i], [&](size_t buildRow) {
+      buildRows.push_back(buildRow);
+      probeRows.push_back(i);
+    });
+    if (i % qlever::joinHelpers::CHUNK_SIZE == 0) {
+      checkCancellation();
+    }
+  }
+
+  const IdTable& leftTable = buildSideIsLeft ? buildSide.table() : probe;
+  const IdTable& rightTable = buildSideIsLeft ? probe : buildSide.table();
+  const auto& leftRows = buildSideIsLeft ? buildRows : probeRows;
+  const auto& rightRows = buildSideIsLeft ? probeRows : buildRows;
+  ColumnIndex leftJoinCol =
+      buildSideIsLeft ? buildSide.joinCol() : probeJoinCol;
+  ColumnIndex rightJoinCol =
+      buildSideIsLeft ? probeJoinCol : buildSide.joinCol();
+
+  IdTable result{leftTable.numColumns() + rightTable.numColumns() - 1,
+                 std::move(allocator)};
+  result.resize(buildRows.size());
+  size_t outCol = 0;
+  for (size_t col = 0; col < leftTable.numColumns(); ++col) {
+    auto target = result.getColumn(outCol++);
+    auto source = leftTable.getColumn(col);
+    if (col == leftJoinCol) {
+      // If the value of one side is UNDEF, the result contains the value of
+      // the other side.
+      auto otherSource = rightTable.getColumn(rightJoinCol);
+      for (size_t i = 0; i < target.size(); ++i) {
+        Id value = source[leftRows[i]];
+        target[i] = value.isUndefined() ? otherSource[rightRows[i]] : value;
+      }
+    } else {
+      for (size_t i = 0; i < target.size(); ++i) {
+        target[i] = source[leftRows[i]];
+      }
+    }
+  }
+  for (size_t col = 0; col < rightTable.numColumns(); ++col) {
+    if (col == rightJoinCol) {
+      continue;
+    }
+    auto target = result.getColumn(outCol++);
+    auto source = rightTable.getColumn(col);
+    for (size_t i = 0; i < target.size(); ++i) {
+      target[i] = source[rightRows[i]];
+    }
+  }
+  checkCancellation();
+  return result;
+}
+
+// _____________________________________________________________________________
+Result HashJoin::computeResult(bool requestLaziness) {
+  auto makeEmptyResult = [this]() {
+    return Result{IdTable{getResultWidth(), allocator()}, resultSortedOn(),
+                  LocalVocab{}};
+  };
+  if (knownEmptyResult()) {
+    left_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    right_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    return makeEmptyResult();
+  }
+
+  const auto& buildTree = leftIsBuildSide_ ? left_ : right_;
+  const auto& probeTree = leftIsBuildSide_ ? right_ : left_;
+  ColumnIndex buildJoinCol = leftIsBuildSide_ ? leftJoinCol_ : rightJoinCol_;
+  ColumnIndex probeJoinCol = leftIsBuildSide_ ? rightJoinCol_ : leftJoinCol_;
+
+  std::shared_ptr<const Result> buildResult = buildTree->getResult();
+  checkCancellation();
+  if (buildResult->idTable().empty()) {
+    probeTree->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    return makeEmptyResult();
+  }
+  ad_utility::Timer timer{ad_utility::timer::Timer::InitialStatus::Started};
+  auto buildSide = std::make_shared<const BuildSide>(
+      buildResult->idTable(), buildJoinCol, allocator());
+  runtimeInfo().addDetail("build-side", leftIsBuildSide_ ? "left" : "right");
+  runtimeInfo().addDetail("time-for-building-hash-table", timer.msecs());
+  checkCancellation();
+
+  std::shared_ptr<const Result> probeResult = probeTree->getResult(true);
+  checkCancellation();
+  if (probeResult->isFullyMaterialized()) {
+    return {joinBlock(*buildSide, probeResult->idTable(), probeJoinCol),
+            resultSortedOn(),
+            Result::getMergedLocalVocab(*buildResult, *probeResult)};
+  }
+
+  // The probe side is lazy, so we join it block by block.
+  auto joinLazyBlock = [this, buildResult, buildSide, probeResult,
+                        probeJoinCol](Result::IdTableVocabPair& pair) {
+    IdTable result = joinBlock(*buildSide, pair.idTable_, probeJoinCol);
+    LocalVocab localVocab = buildResult->getCopyOfLocalVocab();
+    localVocab.mergeWith(pair.localVocab_);
+    return Result::IdTableVocabPair{std::move(result), std::move(localVocab)};
+  };
+  if (requestLaziness) {
+    return {Result::LazyResult{
+                ad_utility::OwningView{ad_utility::CachingTransformInputRange{
+                    probeResult->idTables(), std::move(joinLazyBlock)}} |
+                ql::views::filter(
+                    [](const auto& pair) { return !pair.idTable_.empty(); })},
+            resultSortedOn()};
+  }
+
+  IdTable result{getResultWidth(), allocator()};
+  LocalVocab localVocab = buildResult->getCopyOfLocalVocab();
+  for (Result::IdTableVocabPair& pair : probeResult->idTables()) {
+    auto [block, blockVocab] = joinLazyBlock(pair);
+    result.insertAtEnd(block);
+    localVocab.mergeWith(blockVocab);
+  }
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> HashJoin::cloneImpl() const {
+  auto copy = std::make_unique<HashJoin>(*this);
+  copy->left_ = left_->clone();
+  copy->right_ = right_->clone();
+  return copy;
+}
@@ -0,0 +1,165 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_HASHJOIN_H
+#define QLEVER_SRC_ENGINE_HASHJOIN_H
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/HashMap.h"
+
+// A join on a single column that, unlike the `Join`, doesn't require its
+// inputs to be sorted. The smaller of the two inputs (according to the size
+// estimates) is the "build side", which is fully materialized and stored in a
+// hash map from the join column to the rows. The other input is the "probe
+// side", which is consumed block by block (without materializing it if it is
+// computed lazily), and for each block the matching rows are looked up in the
+// hash map. The result has the same columns as the result of a `Join` of the
+// same inputs, but it is not sorted.
+//
+// This is used by the `QueryPlanner` as an alternative to a `Join` when at
+// least one of the inputs is not sorted on the join column and would have to
+// be sorted first.
+//
+// All the memory for the hash table and for the matching rows is allocated
+// with the `AllocatorWithLimit` of the operation, so that it counts against
+// the memory limit of the query.
+class HashJoin : public Operation {
+ private:
+  std::shared_ptr<QueryExecutionTree> left_;
+  std::shared_ptr<QueryExecutionTree> right_;
+
+  ColumnIndex leftJoinCol_;
+  ColumnIndex rightJoinCol_;
+
+  Variable joinVar_{"?notSet"};
+
+  // If true, the left input is the build side, else the right one.
+  bool leftIsBuildSide_;
+
+  std::optional<std::pair<size_t, std::vector<float>>>
+      sizeEstimateAndMultiplicities_;
+
+ public:
+  // A vector of row indices that counts against the memory limit.
+  using RowIndices =
+      std::vector<size_t, ad_utility::AllocatorWithLimit<size_t>>;
+
+  // The hash table for the build side, see above. It is public for testing.
+  class BuildSide {
+   private:
+    const IdTable& table_;
+    ColumnIndex joinCol_;
+    // For each distinct value of the join column, the range of the indices of
+    // the rows with this value in `rowIndices_`.
+    ad_utility::HashMapWithMemoryLimit<Id, std::pair<size_t, size_t>> ranges_;
+    RowIndices rowIndices_;
+    // The indices of the rows with an UNDEF value in the join column. They
+    // match every row of the probe side.
+    RowIndices undefRows_;
+
+   public:
+    // Build the hash table for the `table`. The `table` must outlive the
+    // `BuildSide`.
+    BuildSide(const IdTable& table, ColumnIndex joinCol,
+              const ad_utility::AllocatorWithLimit<Id>& allocator);
+
+    // Call `callback(buildRowIndex)` for each row of the build side that
+    // matches the `value` of the join column of a row of the probe side.
+    template <typename F>
+    void forEachMatch(Id value, const F& callback) const {
+      if (value.isUndefined()) {
+        for (size_t i = 0; i < table_.numRows(); ++i) {
+          callback(i);
+        }
+        return;
+      }
+      if (auto it = ranges_.find(value); it != ranges_.end()) {
+        auto [begin, end] = it->second;
+        for (size_t i = begin; i < end; ++i) {
+          callback(rowIndices_[i]);
+        }
+      }
+      for (size_t i : undefRows_) {
+        callback(i);
+      }
+    }
+
+    const IdTable& table() const { return table_; }
+    ColumnIndex joinCol() const { return joinCol_; }
+  };
+
+  // `allowSwappingChildrenOnlyForTesting` should only ever be changed by tests.
+  HashJoin(QueryExecutionContext* qec, std::shared_ptr<QueryExecutionTree> t1,
+           std::shared_ptr<QueryExecutionTree> t2, ColumnIndex t1JoinCol,
+           ColumnIndex t2JoinCol,
+           bool allowSwappingChildrenOnlyForTesting = true);
+
+  std::string getDescriptor() const override;
+
+  size_t getResultWidth() const override;
+
+  // The result of a hash join is not sorted.
+  std::vector<ColumnIndex> resultSortedOn() const override { return {}; }
+
+  // Building the hash table costs more per row than probing it, which is
+  // reflected by the `HASH_JOIN_BUILD_COST` factor.
+  size_t getCostEstimate() override;
+
+  bool knownEmptyResult() override {
+    return left_->knownEmptyResult() || right_->knownEmptyResult();
+  }
+
+  float getMultiplicity(size_t col) override;
+
+  std::vector<QueryExecutionTree*> getChildren() override {
+    return {left_.get(), right_.get()};
+  }
+
+  bool columnOriginatesFromGraphOrUndef(
+      const Variable& variable) const override;
+
+  // Return true iff the left child is the build side.
+  bool leftIsBuildSide() const { return leftIsBuildSide_; }
+
+  // Join the `probe` block (the join column of which is `probeJoinCol`) with
+  // the `buildSide` and return the result. The columns of the result are
+  // ordered as described above.
+  IdTable joinBlock(const BuildSide& buildSide, const IdTable& probe,
+                    ColumnIndex probeJoinCol) const;
+
+  // The implementation of `joinBlock`, which is also used by `Join::hashJoin`.
+  // The result has the columns of the left input, followed by the columns of
+  // the right input without its join column, where `buildSideIsLeft` tells
+  // which of the two inputs is the `buildSide`. The rows are in the order of
+  // the `probe` table.
+  static IdTable joinWithBuildSide(
+      const BuildSide& buildSide, bool buildSideIsLeft, const IdTable& probe,
+      ColumnIndex probeJoinCol, ad_utility::AllocatorWithLimit<Id> allocator,
+      const std::function<void()>& checkCancellation);
+
+ private:
+  uint64_t getSizeEstimateBeforeLimit() override;
+
+  std::string getCacheKeyImpl() const override;
+
+  std::unique_ptr<Operation> cloneImpl() const override;
+
+  Result computeResult(bool requestLaziness) override;
+
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  // Compute and cache the size estimate and the multiplicities.
+  const std::pair<size_t, std::vector<float>>&
+  getSizeEstimateAndMultiplicities();
+};
+
+#endif  // QLEVER_SRC_ENGINE_HASHJOIN_H
@@ -595,6 +595,12 @@ void IndexScan::updateRuntimeInfoForLazyScan(
   updateIfPositive(metadata.numBlocksPostprocessed_,
                    "num-blocks-postprocessed");
   updateIfPositive(metadata.numBlocksWithUpdate_, "num-blocks-with-update");
+  updateIfPositive(metadata.numIoBatches_, "num-io-batches");
+  updateIfPositive(metadata.maxIoQueueDepth_, "io-queue-depth-max");
+  if (metadata.numIoBatches_ > 0) {
+    rti.addDetail("io-bytes-per-batch",
+                  metadata.numIoBytesRead_ / metadata.numIoBatches_);
+  }
   signalQueryUpdate(sendPriority);
 }
 
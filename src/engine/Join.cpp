@@ -15,7 +15,7 @@
 #include "backports/functional.h"
 #include "backports/type_traits.h"
 #include "engine/AddCombinedRowToTable.h"
-#include "engine/CallFixedSize.h"
+#include "engine/HashJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/JoinHelpers.h"
 #include "engine/OperationBindPushDownImpl.h"
@@ -26,7 +26,6 @@
 #include "util/Algorithm.h"
 #include "util/Exception.h"
 #include "util/Generators.h"
-#include "util/HashMap.h"
 #include "util/Iterators.h"
 #include "util/JoinAlgorithms/JoinAlgorithms.h"
 
@@ -227,73 +226,88 @@ size_t Join::getCostEstimate() {
 
 // _____________________________________________________________________________
 void Join::computeSizeEstimateAndMultiplicities() {
-  _multiplicities.clear();
-  if (_left->getSizeEstimate() == 0 || _right->getSizeEstimate() == 0) {
-    for (size_t i = 0; i < getResultWidth(); ++i) {
-      _multiplicities.emplace_back(1);
+  std::tie(_sizeEstimate, _multiplicities) =
+      computeSizeEstimateAndMultiplicities(_executionContext, *_left,
+                                           _leftJoinCol, *_right, _rightJoinCol,
+                                           keepJoinColumn_);
+}
+
+// _____________________________________________________________________________
+std::pair<size_t, std::vector<float>>
+Join::computeSizeEstimateAndMultiplicities(const QueryExecutionContext* qec,
+                                           QueryExecutionTree& left,
+                                           ColumnIndex leftJoinCol,
+                                           QueryExecutionTree& right,
+                                           ColumnIndex rightJoinCol,
+                                           bool keepJoinColumn) {
+  std::vector<float> multiplicities;
+  size_t resultWidth = left.getResultWidth() + right.getResultWidth() - 1 -
+                       static_cast<size_t>(!keepJoinColumn);
+  if (left.getSizeEstimate() == 0 || right.getSizeEstimate() == 0) {
+    for (size_t i = 0; i < resultWidth; ++i) {
+      multiplicities.emplace_back(1);
     }
-    return;
+    return {0, std::move(multiplicities)};
   }
 
   size_t nofDistinctLeft = std::max(
-      size_t(1), static_cast<size_t>(_left->getSizeEstimate() /
-                                     _left->getMultiplicity(_leftJoinCol)));
+      size_t(1), static_cast<size_t>(left.getSizeEstimate() /
+                                     left.getMultiplicity(leftJoinCol)));
   size_t nofDistinctRight = std::max(
-      size_t(1), static_cast<size_t>(_right->getSizeEstimate() /
-                                     _right->getMultiplicity(_rightJoinCol)));
+      size_t(1), static_cast<size_t>(right.getSizeEstimate() /
+                                     right.getMultiplicity(rightJoinCol)));
 
   size_t nofDistinctInResult = std::min(nofDistinctLeft, nofDistinctRight);
 
   double adaptSizeLeft =
-      _left->getSizeEstimate() *
+      left.getSizeEstimate() *
       (static_cast<double>(nofDistinctInResult) / nofDistinctLeft);
   double adaptSizeRight =
-      _right->getSizeEstimate() *
+      right.getSizeEstimate() *
       (static_cast<double>(nofDistinctInResult) / nofDistinctRight);
 
-  double corrFactor = _executionContext
-                          ? _executionContext->getCostFactor(
-                                "JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR")
-                          : 1.0;
+  double corrFactor =
+      qec ? qec->getCostFactor("JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR") : 1.0;
 
-  double jcMultiplicityInResult = _left->getMultiplicity(_leftJoinCol) *
-                                  _right->getMultiplicity(_rightJoinCol);
-  _sizeEstimate = std::max(
+  double jcMultiplicityInResult =
+      left.getMultiplicity(leftJoinCol) * right.getMultiplicity(rightJoinCol);
+  size_t sizeEstimate = std::max(
       size_t(1), static_cast<size_t>(corrFactor * jcMultiplicityInResult *
                                      nofDistinctInResult));
 
-  AD_LOG_TRACE << "Estimated size as: " << _sizeEstimate << " := " << corrFactor
+  AD_LOG_TRACE << "Estimated size as: " << sizeEstimate << " := " << corrFactor
                << " * " << jcMultiplicityInResult << " * "
                << nofDistinctInResult << std::endl;
 
-  for (auto i = ColumnIndex{0}; i < _left->getResultWidth(); ++i) {
-    double oldMult = _left->getMultiplicity(i);
+  for (auto i = ColumnIndex{0}; i < left.getResultWidth(); ++i) {
+    double oldMult = left.getMultiplicity(i);
     double m = std::max(
-        1.0, oldMult * _right->getMultiplicity(_rightJoinCol) * corrFactor);
-    if (i != _leftJoinCol && nofDistinctLeft != nofDistinctInResult) {
-      double oldDist = _left->getSizeEstimate() / oldMult;
+        1.0, oldMult * right.getMultiplicity(rightJoinCol) * corrFactor);
+    if (i != leftJoinCol && nofDistinctLeft != nofDistinctInResult) {
+      double oldDist = left.getSizeEstimate() / oldMult;
       double newDist = std::min(oldDist, adaptSizeLeft);
-      m = (_sizeEstimate / corrFactor) / newDist;
+      m = (sizeEstimate / corrFactor) / newDist;
     }
-    if (i != _leftJoinCol || keepJoinColumn_) {
-      _multiplicities.emplace_back(m);
+    if (i != leftJoinCol || keepJoinColumn) {
+      multiplicities.emplace_back(m);
     }
   }
-  for (auto i = ColumnIndex{0}; i < _right->getResultWidth(); ++i) {
-    if (i == _rightJoinCol) {
+  for (auto i = ColumnIndex{0}; i < right.getResultWidth(); ++i) {
+    if (i == rightJoinCol) {
       continue;
     }
-    double oldMult = _right->getMultiplicity(i);
+    double oldMult = right.getMultiplicity(i);
     double m = std::max(
-        1.0, oldMult * _left->getMultiplicity(_leftJoinCol) * corrFactor);
-    if (i != _rightJoinCol && nofDistinctRight != nofDistinctInResult) {
-      double oldDist = _right->getSizeEstimate() / oldMult;
+        1.0, oldMult * left.getMultiplicity(leftJoinCol) * corrFactor);
+    if (i != rightJoinCol && nofDistinctRight != nofDistinctInResult) {
+      double oldDist = right.getSizeEstimate() / oldMult;
       double newDist = std::min(oldDist, adaptSizeRight);
-      m = (_sizeEstimate / corrFactor) / newDist;
+      m = (sizeEstimate / corrFactor) / newDist;
     }
-    _multiplicities.emplace_back(m);
+    multiplicities.emplace_back(m);
   }
-  assert(_multiplicities.size() == getResultWidth());
+  assert(multiplicities.size() == resultWidth);
+  return {sizeEstimate, std::move(multiplicities)};
 }
 
 // ______________________________________________________________________________
@@ -419,135 +433,20 @@ Result Join::lazyJoin(std::shared_ptr<const Result> a,
       resultSortedOn(), std::move(resultPermutation));
 }
 
-// ______________________________________________________________________________
-template <int L_WIDTH, int R_WIDTH, int OUT_WIDTH>
-void Join::hashJoinImpl(const IdTable& dynA, ColumnIndex jc1,
-                        const IdTable& dynB, ColumnIndex jc2, IdTable* dynRes) {
-  const IdTableView<L_WIDTH> a = dynA.asStaticView<L_WIDTH>();
-  const IdTableView<R_WIDTH> b = dynB.asStaticView<R_WIDTH>();
-
-  AD_LOG_DEBUG << "Performing hashJoin between two tables.\n";
-  AD_LOG_DEBUG << "A: width = " << a.numColumns() << ", size = " << a.size()
-               << "\n";
-  AD_LOG_DEBUG << "B: width = " << b.numColumns() << ", size = " << b.size()
-               << "\n";
-
-  // Check trivial case.
-  if (a.empty() || b.empty()) {
-    return;
-  }
-
-  IdTableStatic<OUT_WIDTH> result = std::move(*dynRes).toStatic<OUT_WIDTH>();
-
-  // Puts the rows of the given table into a hash map, with the value of
-  // the join column of a row as the key, and returns the hash map.
-  auto idTableToHashMap = [](const auto& table, const ColumnIndex jc) {
-    // This declaration works, because generic lambdas are just syntactic sugar
-    // for templates.
-    using Table = std::decay_t<decltype(table)>;
-    ad_utility::HashMap<Id, std::vector<typename Table::row_type>> map;
-    for (const auto& row : table) {
-      map[row[jc]].push_back(row);
-    }
-    return map;
-  };
-
-  /*
-   * @brief Joins the two tables, putting the result in result. Creates a cross
-   *  product for matching rows by putting the smaller IdTable in a hash map and
-   *  using that, to faster find the matching rows.
-   *
-   * @tparam leftIsLarger If the left table in the join operation has more
-   *  rows, or the right. True, if he has. False, if he hasn't.
-   * @tparam LargerTableType, SmallerTableType The types of the tables given.
-   *  Can be easily done with type interference, so no need to write them out.
-   *
-   * @param largerTable, smallerTable The two tables of the join operation.
-   * @param largerTableJoinColumn, smallerTableJoinColumn The join columns
-   *  of the tables
-   */
-  auto performHashJoin = ad_utility::ApplyAsValueIdentity{
-      [&idTableToHashMap, &result](auto leftIsLarger, const auto& largerTable,
-                                   const ColumnIndex largerTableJoinColumn,
-                                   const auto& smallerTable,
-                                   const ColumnIndex smallerTableJoinColumn) {
-        // Put the smaller table into the hash table.
-        auto map = idTableToHashMap(smallerTable, smallerTableJoinColumn);
-
-        // Create cross product by going through the larger table.
-        for (size_t i = 0; i < largerTable.size(); i++) {
-          // Skip, if there is no matching entry for the join column.
-          auto entry = map.find(largerTable(i, largerTableJoinColumn));
-          if (entry == map.end()) {
-            continue;
-          }
-
-          for (const auto& row : entry->second) {
-            // Based on which table was larger, the arguments of
-            // addCombinedRowToIdTable are different.
-            // However this information is known at compile time, so the other
-            // branch gets discarded at compile time, which makes this
-            // condition have constant runtime.
-            if constexpr (leftIsLarger) {
-              addCombinedRowToIdTable(largerTable[i], row,
-                                      smallerTableJoinColumn, &result);
-            } else {
-              addCombinedRowToIdTable(row, largerTable[i],
-                                      largerTableJoinColumn, &result);
-            }
-          }
-        }
-      }};
-
-  // Cannot just switch a and b around because the order of
-  // items in the result tuples is important.
-  // Procceding with the actual hash join depended on which IdTableView
-  // is bigger.
-  if (a.size() >= b.size()) {
-    performHashJoin.template operator()<true>(a, jc1, b, jc2);
-  } else {
-    performHashJoin.template operator()<false>(b, jc2, a, jc1);
-  }
-  *dynRes = std::move(result).toDynamic();
-
-  AD_LOG_DEBUG << "HashJoin done.\n";
-  AD_LOG_DEBUG << "Result: width = " << dynRes->numColumns()
-               << ", size = " << dynRes->size() << "\n";
-}
-
 // ______________________________________________________________________________
 void Join::hashJoin(const IdTable& dynA, ColumnIndex jc1, const IdTable& dynB,
                     ColumnIndex jc2, IdTable* dynRes) {
-  ad_utility::callFixedSizeVi(
-      (std::array{dynA.numColumns(), dynB.numColumns(), dynRes->numColumns()}),
-      [&](auto l, auto r, auto o) {
-        return Join::hashJoinImpl<l, r, o>(dynA, jc1, dynB, jc2, dynRes);
-      });
-}
-
-// ___________________________________________________________________________
-template <typename ROW_A, typename ROW_B, int TABLE_WIDTH>
-void Join::addCombinedRowToIdTable(const ROW_A& rowA, const ROW_B& rowB,
-                                   ColumnIndex jcRowB,
-                                   IdTableStatic<TABLE_WIDTH>* table) {
-  // Add a new, empty row.
-  const size_t backIndex = table->size();
-  table->emplace_back();
-
-  // Copy the entire rowA in the table.
-  for (auto h = ColumnIndex{0}; h < rowA.numColumns(); h++) {
-    (*table)(backIndex, h) = rowA[h];
-  }
-
-  // Copy rowB columns before the join column.
-  for (auto h = ColumnIndex{0}; h < jcRowB; h++) {
-    (*table)(backIndex, h + rowA.numColumns()) = rowB[h];
-  }
-
-  // Copy rowB columns after the join column.
-  for (auto h = jcRowB + 1; h < rowB.numColumns(); h++) {
-    (*table)(backIndex, h + rowA.numColumns() - 1) = rowB[h];
-  }
+  AD_CONTRACT_CHECK(dynRes->numColumns() ==
+                    dynA.numColumns() + dynB.numColumns() - 1);
+  // The smaller table is put into the hash table, and the larger table is
+  // probed in its order, see `HashJoin`.
+  const bool aIsBuildSide = dynA.size() < dynB.size();
+  HashJoin::BuildSide buildSide{aIsBuildSide ? dynA : dynB,
+                                aIsBuildSide ? jc1 : jc2,
+                                dynRes->getAllocator()};
+  *dynRes = HashJoin::joinWithBuildSide(
+      buildSide, aIsBuildSide, aIsBuildSide ? dynB : dynA,
+      aIsBuildSide ? jc2 : jc1, dynRes->getAllocator(), []() {});
 }
 
 // ______________________________________________________________________________________________________
@@ -66,6 +66,18 @@ class Join : public Operation {
 
   void computeSizeEstimateAndMultiplicities();
 
+  // The implementation of `computeSizeEstimateAndMultiplicities`. Return the
+  // size estimate and the multiplicities of all result columns for the join of
+  // `left` and `right` on the given join columns. This is also used by the
+  // `HashJoin`, the result of which has the same columns as that of a `Join`.
+  static std::pair<size_t, std::vector<float>>
+  computeSizeEstimateAndMultiplicities(const QueryExecutionContext* qec,
+                                       QueryExecutionTree& left,
+                                       ColumnIndex leftJoinCol,
+                                       QueryExecutionTree& right,
+                                       ColumnIndex rightJoinCol,
+                                       bool keepJoinColumn);
+
   float getMultiplicity(size_t col) override;
 
   std::vector<QueryExecutionTree*> getChildren() override {
@@ -84,7 +96,7 @@ class Join : public Operation {
    * The possible algorithms should be:
    * - The normal merge join.
    * - The doGallopInnerJoin.
-   * - The hashJoinImpl.
+   * - The hash join of `hashJoin`.
    * Currently it only decides between doGallopInnerJoin and the standard merge
    * join, with the merge join code directly written in the function.
    * TODO Move the merge join into it's own function and make this function
@@ -104,14 +116,14 @@ class Join : public Operation {
    * @brief Joins IdTables dynA and dynB on join column jc2, returning
    * the result in dynRes. Creates a cross product for matching rows by putting
    * the smaller IdTable in a hash map and using that, to faster find the
-   * matching rows.
-   * Needed to be a separate function from the actual implementation, because
-   * compiler optimization kept inlining it, which make testing impossible,
-   * because you couldn't call the function after linking and just got
-   * 'undefined reference' errors.
+   * matching rows. This uses the same implementation as the `HashJoin`
+   * operation (see `HashJoin::joinWithBuildSide`). Like in `join`, an UNDEF
+   * value in the join column matches every value, and the result contains
+   * the defined value (if any). The memory for the hash table is allocated
+   * with the allocator of `dynRes`.
    *
-   * @return The result is only sorted, if the bigger table is sorted.
-   * Otherwise it is not sorted.
+   * @return The result is only sorted, if the bigger table is sorted and has
+   * no UNDEF values in the join column. Otherwise it is not sorted.
    **/
   static void hashJoin(const IdTable& dynA, ColumnIndex jc1,
                        const IdTable& dynB, ColumnIndex jc2, IdTable* dynRes);
@@ -161,31 +173,6 @@ class Join : public Operation {
       std::shared_ptr<const Result> leftRes,
       std::shared_ptr<const Result> rightRes) const;
 
-  /*
-   * @brief Combines 2 rows like in a join and inserts the result in the
-   * given table.
-   *
-   *@tparam The amount of columns in the rows and the table.
-   *
-   * @param[in] The left row of the join.
-   * @param[in] The right row of the join.
-   * @param[in] The numerical position of the join column of row b.
-   * @param[in] The table, in which the new combined row should be inserted.
-   * Must be static.
-   */
-  template <typename ROW_A, typename ROW_B, int TABLE_WIDTH>
-  static void addCombinedRowToIdTable(const ROW_A& rowA, const ROW_B& rowB,
-                                      ColumnIndex jcRowB,
-                                      IdTableStatic<TABLE_WIDTH>* table);
-
-  /*
-   * @brief The implementation of hashJoin.
-   */
-  template <int L_WIDTH, int R_WIDTH, int OUT_WIDTH>
-  static void hashJoinImpl(const IdTable& dynA, ColumnIndex jc1,
-                           const IdTable& dynB, ColumnIndex jc2,
-                           IdTable* dynRes);
-
   // Commonly used code for the various known-to-be-empty cases.
   Result createEmptyResult() const;
 
@@ -17,12 +17,13 @@ LazyGroupBy::LazyGroupBy(
       aggregationData_{allocator, aggregateAliases_, numGroupColumns} {
   for (const auto& aggregateInfo : allAggregateInfoView()) {
     visitAggregate(
-        [&aggregateInfo](auto& arg) {
+        [this, &aggregateInfo](auto& arg) {
           using T = std::decay_t<decltype(arg)>;
           static_assert(VectorOfAggregationData<T>);
           if constexpr (ql::concepts::same_as<typename T::value_type,
                                               GroupConcatAggregationData>) {
-            arg.emplace_back(aggregateInfo.aggregateType_.separator_.value());
+            arg.emplace_back(aggregateInfo.aggregateType_.separator_.value(),
+                             allocator_);
           } else {
             arg.emplace_back();
           }
@@ -657,7 +657,8 @@ MaterializedView::makeEmptyLocatedTriplesState() const {
 
   return std::make_shared<LocatedTriplesState>(
       LocatedTriplesState{emptyLocatedTriples, emptyInternalLocatedTriples,
-                          emptyVocab.getLifetimeExtender(), 0});
+                          emptyVocab.getLifetimeExtender(), 0,
+                          PredicateStatisticsDelta{}});
 }
 
 // _____________________________________________________________________________
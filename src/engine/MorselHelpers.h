@@ -0,0 +1,89 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_MORSELHELPERS_H
+#define QLEVER_SRC_ENGINE_MORSELHELPERS_H
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include "global/RuntimeParameters.h"
+#include "util/ParallelExecutor.h"
+
+// Helpers for the morsel-driven parallel evaluation of expressions (in `Filter`
+// and `Bind`): The input is split into fixed-size row ranges ("morsels"), which
+// are then dynamically distributed to a fixed number of worker threads.
+namespace qlever::morselHelpers {
+
+// The split of the rows `[0, numRows)` of an input into morsels.
+class Morsels {
+ private:
+  size_t numRows_;
+  size_t morselSize_;
+  size_t numThreads_;
+
+ public:
+  // Use the values of the runtime parameters `expression-evaluation-num-threads`
+  // and `expression-evaluation-morsel-size`.
+  explicit Morsels(size_t numRows)
+      : Morsels{numRows,
+                getRuntimeParameter<
+                    &RuntimeParameters::expressionEvaluationMorselSize_>(),
+                getRuntimeParameter<
+                    &RuntimeParameters::expressionEvaluationNumThreads_>()} {}
+
+  Morsels(size_t numRows, size_t morselSize, size_t numThreads)
+      : numRows_{numRows},
+        morselSize_{std::max(morselSize, size_t{1})},
+        numThreads_{std::max(numThreads, size_t{1})} {}
+
+  // The number of morsels.
+  size_t size() const { return (numRows_ + morselSize_ - 1) / morselSize_; }
+
+  // Return true iff there is more than one morsel and more than one thread,
+  // so that a parallel evaluation is possible.
+  bool isParallel() const { return size() > 1 && numThreads_ > 1; }
+
+  // Call `function(morselIndex, beginRow, endRow)` for each morsel. The calls
+  // happen concurrently on up to `numThreads` threads, each of which
+  // repeatedly takes the next unprocessed morsel, s.t. expensive morsels don't
+  // stall the other threads. If one of the calls throws, the remaining morsels
+  // are skipped and the exception is rethrown after all threads have finished.
+  template <typename F>
+  void forEach(const F& function) const {
+    const size_t numMorsels = size();
+    std::atomic<size_t> nextMorsel = 0;
+    std::atomic<bool> hasFailed = false;
+    auto worker = [&]() {
+      try {
+        for (size_t morsel = nextMorsel++; morsel < numMorsels && !hasFailed;
+             morsel = nextMorsel++) {
+          size_t begin = morsel * morselSize_;
+          size_t end = std::min(begin + morselSize_, numRows_);
+          function(morsel, begin, end);
+        }
+      } catch (...) {
+        hasFailed = true;
+        throw;
+      }
+    };
+    const size_t numThreads = std::min(numThreads_, numMorsels);
+    if (numThreads <= 1) {
+      worker();
+      return;
+    }
+    std::vector<std::packaged_task<void()>> tasks;
+    for (size_t i = 0; i < numThreads; ++i) {
+      tasks.emplace_back(worker);
+    }
+    ad_utility::runTasksInParallel(std::move(tasks));
+  }
+};
+
+}  // namespace qlever::morselHelpers
+
+#endif  // QLEVER_SRC_ENGINE_MORSELHELPERS_H
@@ -0,0 +1,442 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/MultiwayJoin.h"
+
+#include <absl/strings/str_join.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <sstream>
+
+#include "engine/JoinHelpers.h"
+#include "util/Algorithm.h"
+#include "util/HashMap.h"
+#include "util/HashSet.h"
+
+namespace {
+// Return the first index `i` in `[begin, end)` for which `isBefore(column[i])`
+// is false, or `end` if there is no such index. `isBefore` must be true for a
+// (possibly empty) prefix of the range and false for the rest. The search
+// starts at `begin` with exponentially growing steps, s.t. its cost is
+// logarithmic in the distance of the result from `begin` and not in the size
+// of the range. This makes the repeated seeks of the leapfrog join cheap when
+// the inputs are of very different size.
+template <typename F>
+size_t gallopingSearch(ql::span<const Id> column, size_t begin, size_t end,
+                       const F& isBefore) {
+  if (begin == end || !isBefore(column[begin])) {
+    return begin;
+  }
+  // Invariant: `isBefore(column[low])` is true.
+  size_t low = begin;
+  size_t step = 1;
+  while (step < end - low && isBefore(column[low + step])) {
+    low += step;
+    step *= 2;
+  }
+  size_t high = step < end - low ? low + step : end;
+  return std::partition_point(column.begin() + low + 1, column.begin() + high,
+                              isBefore) -
+         column.begin();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+MultiwayJoin::MultiwayJoin(QueryExecutionContext* qec, Children children,
+                           std::vector<Variable> variableOrder)
+    : Operation{qec},
+      children_{std::move(children)},
+      variableOrder_{std::move(variableOrder)} {
+  AD_CONTRACT_CHECK(children_.size() >= 2);
+  AD_CONTRACT_CHECK(ql::ranges::all_of(
+      children_, [](const auto& child) { return child != nullptr; }));
+
+  std::vector<std::vector<Variable>> variablesPerChild;
+  for (const auto& child : children_) {
+    auto& variables = variablesPerChild.emplace_back();
+    for (const auto& [variable, info] : child->getVariableColumns()) {
+      AD_CONTRACT_CHECK(
+          info.mightContainUndef_ == ColumnIndexAndTypeInfo::AlwaysDefined,
+          "The inputs of a `MultiwayJoin` must not contain UNDEF values");
+      variables.push_back(variable);
+    }
+  }
+  if (variableOrder_.empty()) {
+    variableOrder_ = computeVariableOrder(variablesPerChild);
+  }
+  ad_utility::HashMap<Variable, size_t> levelOfVariable;
+  for (size_t i = 0; i < variableOrder_.size(); ++i) {
+    AD_CONTRACT_CHECK(levelOfVariable.emplace(variableOrder_[i], i).second);
+  }
+
+  // Determine the order in which the columns of each child are bound, and
+  // sort the child accordingly (which is a no-op if it is already sorted).
+  ad_utility::HashSet<size_t> usedLevels;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    std::vector<std::pair<size_t, ColumnIndex>> levelsAndColumns;
+    for (const auto& variable : variablesPerChild[i]) {
+      auto it = levelOfVariable.find(variable);
+      AD_CONTRACT_CHECK(it != levelOfVariable.end());
+      levelsAndColumns.emplace_back(it->second,
+                                    children_[i]->getVariableColumn(variable));
+      usedLevels.insert(it->second);
+    }
+    ql::ranges::sort(levelsAndColumns);
+    auto& columns = columns_.emplace_back();
+    auto& levels = levels_.emplace_back();
+    for (const auto& [level, column] : levelsAndColumns) {
+      levels.push_back(level);
+      columns.push_back(column);
+    }
+    children_[i] =
+        QueryExecutionTree::createSortedTree(std::move(children_[i]), columns);
+  }
+  AD_CONTRACT_CHECK(usedLevels.size() == variableOrder_.size(),
+                    "Each variable of a `MultiwayJoin` must be contained in "
+                    "at least one of the inputs");
+}
+
+// _____________________________________________________________________________
+std::vector<Variable> MultiwayJoin::computeVariableOrder(
+    const std::vector<std::vector<Variable>>& variablesPerInput) {
+  std::vector<Variable> remaining;
+  for (const auto& variables : variablesPerInput) {
+    for (const auto& variable : variables) {
+      if (!ad_utility::contains(remaining, variable)) {
+        remaining.push_back(variable);
+      }
+    }
+  }
+  ql::ranges::sort(remaining, {}, &Variable::name);
+
+  std::vector<Variable> order;
+  ad_utility::HashSet<Variable> chosen;
+  // The number of inputs that contain the `variable` and one of the variables
+  // that were already chosen, and the total number of inputs that contain the
+  // `variable`. Larger is better.
+  auto score = [&](const Variable& variable) {
+    size_t numConnected = 0;
+    size_t numInputs = 0;
+    for (const auto& variables : variablesPerInput) {
+      if (!ad_utility::contains(variables, variable)) {
+        continue;
+      }
+      ++numInputs;
+      if (ql::ranges::any_of(variables, [&chosen](const Variable& other) {
+            return chosen.contains(other);
+          })) {
+        ++numConnected;
+      }
+    }
+    return std::pair{numConnected, numInputs};
+  };
+  while (!remaining.empty()) {
+    auto best = remaining.begin();
+    auto bestScore = score(*best);
+    for (auto it = std::next(best); it != remaining.end(); ++it) {
+      if (auto itScore = score(*it); itScore > bestScore) {
+        best = it;
+        bestScore = itScore;
+      }
+    }
+    chosen.insert(*best);
+    order.push_back(std::move(*best));
+    remaining.erase(best);
+  }
+  return order;
+}
+
+// _____________________________________________________________________________
+std::vector<QueryExecutionTree*> MultiwayJoin::getChildren() {
+  std::vector<QueryExecutionTree*> result;
+  ql::ranges::copy(
+      children_ | ql::views::transform([](auto& ptr) { return ptr.get(); }),
+      std::back_inserter(result));
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string MultiwayJoin::getDescriptor() const {
+  return "MultiwayJoin on " +
+         absl::StrJoin(variableOrder_, " ", Variable::AbslFormatter);
+}
+
+// _____________________________________________________________________________
+std::string MultiwayJoin::getCacheKeyImpl() const {
+  std::ostringstream os;
+  os << "MULTIWAY JOIN\n";
+  for (size_t i = 0; i < children_.size(); ++i) {
+    os << children_[i]->getCacheKey() << " columns: [";
+    for (size_t j = 0; j < columns_[i].size(); ++j) {
+      os << columns_[i][j] << "->" << levels_[i][j] << " ";
+    }
+    os << "]\n";
+  }
+  return std::move(os).str();
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> MultiwayJoin::resultSortedOn() const {
+  std::vector<ColumnIndex> sortedOn(getResultWidth());
+  std::iota(sortedOn.begin(), sortedOn.end(), 0);
+  return sortedOn;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap MultiwayJoin::computeVariableToColumnMap() const {
+  VariableToColumnMap result;
+  for (size_t i = 0; i < variableOrder_.size(); ++i) {
+    result.emplace(variableOrder_[i], makeAlwaysDefinedColumn(i));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+uint64_t MultiwayJoin::getSizeEstimateBeforeLimit() {
+  if (sizeEstimate_.has_value()) {
+    return sizeEstimate_.value();
+  }
+  // The AGM bound for a fractional edge cover of the variables: An input with
+  // a variable that no other input contains gets the weight 1, all the other
+  // inputs get the weight 1/2 (each of their variables is contained in at
+  // least two inputs). Then `prod(size ^ weight)` is an upper bound for the
+  // size of the result. For the cyclic patterns for which this operation is
+  // used, the actual result is typically much smaller, so the estimate is
+  // additionally capped at the size of the largest input.
+  std::vector<size_t> numInputsPerLevel(variableOrder_.size(), 0);
+  for (const auto& levels : levels_) {
+    for (size_t level : levels) {
+      ++numInputsPerLevel[level];
+    }
+  }
+  double logBound = 0;
+  uint64_t maxInputSize = 0;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    uint64_t size = children_[i]->getSizeEstimate();
+    if (size == 0) {
+      sizeEstimate_ = 0;
+      return 0;
+    }
+    bool hasPrivateVariable = ql::ranges::any_of(
+        levels_[i],
+        [&numInputsPerLevel](size_t level) {
+          return numInputsPerLevel[level] == 1;
+        });
+    logBound += (hasPrivateVariable ? 1.0 : 0.5) * std::log(size);
+    maxInputSize = std::max(maxInputSize, size);
+  }
+  sizeEstimate_ = static_cast<uint64_t>(
+      std::min(static_cast<double>(maxInputSize), std::exp(logBound)));
+  return sizeEstimate_.value();
+}
+
+// _____________________________________________________________________________
+float MultiwayJoin::getMultiplicity(size_t col) {
+  AD_CONTRACT_CHECK(col < getResultWidth());
+  // The number of distinct values of a variable is at most the number of
+  // distinct values in each of the inputs that contain it.
+  double numDistinct = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < children_.size(); ++i) {
+    for (size_t j = 0; j < levels_[i].size(); ++j) {
+      if (levels_[i][j] != col) {
+        continue;
+      }
+      auto& child = children_[i];
+      numDistinct = std::min(
+          numDistinct, static_cast<double>(child->getSizeEstimate()) /
+                           child->getMultiplicity(columns_[i][j]));
+    }
+  }
+  auto size = static_cast<double>(getSizeEstimateBeforeLimit());
+  return static_cast<float>(std::max(1.0, size / std::max(1.0, numDistinct)));
+}
+
+// _____________________________________________________________________________
+size_t MultiwayJoin::getCostEstimate() {
+  // Each input is read once, and each result row is written once.
+  size_t cost = getSizeEstimateBeforeLimit();
+  for (const auto& child : children_) {
+    cost += child->getCostEstimate() + child->getSizeEstimate();
+  }
+  return cost;
+}
+
+// _____________________________________________________________________________
+bool MultiwayJoin::knownEmptyResult() {
+  return ql::ranges::any_of(
+      children_, [](const auto& child) { return child->knownEmptyResult(); });
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> MultiwayJoin::cloneImpl() const {
+  auto copy = std::make_unique<MultiwayJoin>(*this);
+  for (auto& child : copy->children_) {
+    child = child->clone();
+  }
+  return copy;
+}
+
+// _____________________________________________________________________________
+Result MultiwayJoin::computeResult([[maybe_unused]] bool requestLaziness) {
+  std::vector<std::shared_ptr<const Result>> childResults;
+  std::vector<const IdTable*> inputs;
+  IdTable result{getResultWidth(), allocator()};
+  for (const auto& child : children_) {
+    const auto& childResult = childResults.emplace_back(child->getResult());
+    inputs.push_back(&childResult->idTable());
+    checkCancellation();
+    // If one of the inputs is empty, so is the result, and the remaining
+    // inputs don't have to be computed.
+    if (inputs.back()->empty()) {
+      break;
+    }
+  }
+  if (inputs.size() == children_.size()) {
+    computeJoin(inputs, result);
+  }
+  auto localVocab = Result::getMergedLocalVocab(
+      childResults | ql::views::transform([](const auto& childResult)
+                                              -> const Result& {
+        return *childResult;
+      }));
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+void MultiwayJoin::computeJoin(const std::vector<const IdTable*>& inputs,
+                               IdTable& result) const {
+  AD_CONTRACT_CHECK(inputs.size() == children_.size());
+  AD_CONTRACT_CHECK(result.numColumns() == getResultWidth());
+  const size_t numLevels = variableOrder_.size();
+
+  // The state of a single input: Its columns in the order in which they are
+  // bound, and a stack of row ranges. The range at index `d` contains the rows
+  // that match the values of the first `d` bound columns, so the last range
+  // is the current one, and the size of the stack minus one is the number of
+  // bound columns.
+  struct Input {
+    std::vector<ql::span<const Id>> columns_;
+    std::vector<std::pair<size_t, size_t>> ranges_;
+  };
+  std::vector<Input> state(inputs.size());
+  // For each level, the indices of the inputs that contain its variable.
+  std::vector<std::vector<size_t>> inputsPerLevel(numLevels);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    for (size_t j = 0; j < columns_[i].size(); ++j) {
+      state[i].columns_.push_back(inputs[i]->getColumn(columns_[i][j]));
+      inputsPerLevel[levels_[i][j]].push_back(i);
+    }
+    state[i].ranges_.reserve(columns_[i].size() + 1);
+    state[i].ranges_.emplace_back(0, inputs[i]->numRows());
+  }
+
+  // Scratch space for the leapfrog join of each level, see `bindLevel`.
+  struct Cursor {
+    ql::span<const Id> column_;
+    size_t position_;
+    size_t end_;
+  };
+  std::vector<std::vector<Cursor>> cursorsPerLevel(numLevels);
+  std::vector<Id> boundValues(numLevels);
+  size_t numMatches = 0;
+
+  // All the variables are bound, so each input is restricted to rows which
+  // are equal in all of their (visible) columns. The number of these rows is
+  // the multiplicity of the input, and the result contains the bound values
+  // as often as the product of these multiplicities.
+  auto addResultRows = [&]() {
+    size_t multiplicity = 1;
+    for (const auto& input : state) {
+      auto [begin, end] = input.ranges_.back();
+      multiplicity *= end - begin;
+    }
+    for (size_t k = 0; k < multiplicity; ++k) {
+      result.push_back(boundValues);
+    }
+  };
+
+  // Bind the variable of the `level` to each of the values that all the
+  // inputs which contain it have in common (within their current ranges), and
+  // recursively bind the next level for each of these values.
+  auto bindLevel = [&](size_t level, const auto& self) -> void {
+    if (level == numLevels) {
+      addResultRows();
+      return;
+    }
+    const auto& participating = inputsPerLevel[level];
+    auto& cursors = cursorsPerLevel[level];
+    cursors.clear();
+    for (size_t i : participating) {
+      const auto& input = state[i];
+      auto [begin, end] = input.ranges_.back();
+      if (begin == end) {
+        return;
+      }
+      cursors.push_back(
+          Cursor{input.columns_[input.ranges_.size() - 1], begin, end});
+    }
+    auto currentValue = [](const Cursor& cursor) {
+      return cursor.column_[cursor.position_];
+    };
+    auto maxCurrentValue = [&]() {
+      return currentValue(ql::ranges::max(cursors, {}, currentValue));
+    };
+
+    // The leapfrog join: Seek the cursors (in round-robin order) to the
+    // `candidate`, which is the largest current value. A match is found when
+    // all the cursors in a row agree on the `candidate`.
+    const size_t numCursors = cursors.size();
+    Id candidate = maxCurrentValue();
+    size_t numAgreeing = 0;
+    for (size_t c = 0;; c = (c + 1) % numCursors) {
+      auto& cursor = cursors[c];
+      cursor.position_ =
+          gallopingSearch(cursor.column_, cursor.position_, cursor.end_,
+                          [candidate](Id id) { return id < candidate; });
+      if (cursor.position_ == cursor.end_) {
+        return;
+      }
+      if (Id value = currentValue(cursor); value != candidate) {
+        candidate = value;
+        numAgreeing = 1;
+        continue;
+      }
+      if (++numAgreeing < numCursors) {
+        continue;
+      }
+
+      // All the participating inputs contain the `candidate`, so narrow their
+      // ranges to the rows with this value and bind the next level.
+      boundValues[level] = candidate;
+      for (size_t k = 0; k < numCursors; ++k) {
+        auto& other = cursors[k];
+        size_t upper =
+            gallopingSearch(other.column_, other.position_, other.end_,
+                            [candidate](Id id) { return !(candidate < id); });
+        state[participating[k]].ranges_.emplace_back(other.position_, upper);
+        other.position_ = upper;
+      }
+      self(level + 1, self);
+      for (size_t i : participating) {
+        state[i].ranges_.pop_back();
+      }
+      if (++numMatches % qlever::joinHelpers::CHUNK_SIZE == 0) {
+        checkCancellation();
+      }
+      if (ql::ranges::any_of(cursors, [](const Cursor& other) {
+            return other.position_ == other.end_;
+          })) {
+        return;
+      }
+      candidate = maxCurrentValue();
+      numAgreeing = 0;
+    }
+  };
+  bindLevel(0, bindLevel);
+  checkCancellation();
+}
@@ -0,0 +1,104 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_MULTIWAYJOIN_H
+#define QLEVER_SRC_ENGINE_MULTIWAYJOIN_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+
+// A worst-case optimal join of an arbitrary number of inputs, using the
+// Leapfrog Triejoin algorithm (Veldhuizen, ICDT 2014). The variables are bound
+// one at a time in a fixed global order (the `variableOrder_`). Each input is
+// sorted by its variables in this order, s.t. it can be viewed as a trie: For
+// each variable, the sorted values of all the inputs that contain it are
+// intersected by alternately seeking (with a galloping search) to the largest
+// of the current values, and for each common value the row ranges of these
+// inputs are narrowed before the next variable is bound.
+//
+// Unlike a tree of binary joins, this never materializes intermediate results,
+// and the running time is bounded by the worst-case size of the result (the
+// AGM bound). This matters for cyclic patterns like triangles, for which the
+// intermediate results of binary joins can be orders of magnitude larger than
+// the final result. The `QueryPlanner` uses this operation for the cyclic parts
+// of a basic graph pattern, with an `IndexScan` on the suitable permutation
+// for each triple, s.t. none of the inputs has to be sorted.
+//
+// The result has one column per variable (in the `variableOrder_`) and is
+// sorted by all of them. The join columns of the inputs must not contain UNDEF
+// values.
+class MultiwayJoin : public Operation {
+ public:
+  using Children = std::vector<std::shared_ptr<QueryExecutionTree>>;
+
+ private:
+  Children children_;
+  std::vector<Variable> variableOrder_;
+
+  // For each child, its columns in the order in which they are bound, and for
+  // each of these columns the index of its variable in the `variableOrder_`.
+  std::vector<std::vector<ColumnIndex>> columns_;
+  std::vector<std::vector<size_t>> levels_;
+
+  std::optional<uint64_t> sizeEstimate_;
+
+ public:
+  // Join the `children` (at least two) on all their common variables. The
+  // `variableOrder` must contain each variable of the children exactly once.
+  // If it is empty, the order is determined by `computeVariableOrder`. Each
+  // child that is not sorted by its variables in this order is sorted first.
+  MultiwayJoin(QueryExecutionContext* qec, Children children,
+               std::vector<Variable> variableOrder = {});
+
+  // Heuristically determine a good order of the variables, given the
+  // variables of each input: First the variable that is contained in the
+  // largest number of inputs, and then repeatedly the variable that shares the
+  // most inputs with the variables chosen so far. Ties are broken by the name
+  // of the variables, s.t. the order is deterministic.
+  static std::vector<Variable> computeVariableOrder(
+      const std::vector<std::vector<Variable>>& variablesPerInput);
+
+  std::vector<QueryExecutionTree*> getChildren() override;
+
+  std::string getDescriptor() const override;
+
+  size_t getResultWidth() const override { return variableOrder_.size(); }
+
+  const std::vector<Variable>& variableOrder() const { return variableOrder_; }
+
+  // The cost is linear in the size of the inputs and the result.
+  size_t getCostEstimate() override;
+
+  float getMultiplicity(size_t col) override;
+
+  bool knownEmptyResult() override;
+
+  // Compute the join of the `inputs` (the results of the `children_`, in the
+  // same order) and append it to the `result`. Public for testing.
+  void computeJoin(const std::vector<const IdTable*>& inputs,
+                   IdTable& result) const;
+
+ protected:
+  std::vector<ColumnIndex> resultSortedOn() const override;
+
+ private:
+  // The AGM bound, capped at the size of the largest input (see the
+  // definition for details).
+  uint64_t getSizeEstimateBeforeLimit() override;
+
+  std::string getCacheKeyImpl() const override;
+
+  std::unique_ptr<Operation> cloneImpl() const override;
+
+  Result computeResult([[maybe_unused]] bool requestLaziness) override;
+
+  VariableToColumnMap computeVariableToColumnMap() const override;
+};
+
+#endif  // QLEVER_SRC_ENGINE_MULTIWAYJOIN_H
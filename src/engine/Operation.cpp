@@ -12,6 +12,7 @@
 #include <absl/cleanup/cleanup.h>
 #include <absl/container/inlined_vector.h>
 
+#include "engine/DiskResultCache.h"
 #include "engine/NamedResultCache.h"
 #include "engine/OperationBindPushDownImpl.h"
 #include "engine/QueryExecutionTree.h"
@@ -143,6 +144,24 @@ void Operation::updateRuntimeStats(bool applyToLimit, uint64_t numRows,
   }
 }
 
+namespace {
+// The status of an operation whose lazy result has finished with the given
+// `state`.
+RuntimeInformation::Status statusOfFinishedLazyResult(
+    Result::GeneratorState state) {
+  using enum Result::GeneratorState;
+  switch (state) {
+    case FINISHED:
+      return RuntimeInformation::lazilyMaterializedCompleted;
+    case CANCELLED:
+      return RuntimeInformation::cancelled;
+    default:
+      AD_CORRECTNESS_CHECK(state == FAILED);
+      return RuntimeInformation::failed;
+  }
+}
+}  // namespace
+
 // _____________________________________________________________________________
 Result Operation::runComputation(const ad_utility::Timer& timer,
                                  ComputationMode computationMode) {
@@ -217,18 +236,7 @@ Result Operation::runComputation(const ad_utility::Timer& timer,
           signalQueryUpdate(RuntimeInformation::SendPriority::IfDue);
         },
         [this](Result::GeneratorState state) {
-          runtimeInfo().status_ = [state]() {
-            using enum Result::GeneratorState;
-            switch (state) {
-              case FINISHED:
-                return RuntimeInformation::lazilyMaterializedCompleted;
-              case CANCELLED:
-                return RuntimeInformation::cancelled;
-              default:
-                AD_CORRECTNESS_CHECK(state == FAILED);
-                return RuntimeInformation::failed;
-            }
-          }();
+          runtimeInfo().status_ = statusOfFinishedLazyResult(state);
           signalQueryUpdate(RuntimeInformation::SendPriority::Always);
         });
   }
@@ -263,7 +271,11 @@ CacheValue Operation::runComputationAndPrepareForCache(
     const ad_utility::Timer& timer, ComputationMode computationMode,
     const QueryCacheKey& cacheKey, bool pinned, bool isRoot) {
   auto& cache = _executionContext->getQueryTreeCache();
-  auto result = runComputation(timer, computationMode);
+  auto resultFromDisk =
+      readFromDiskResultCache(timer, computationMode, cacheKey);
+  const bool isResultFromDisk = resultFromDisk.has_value();
+  auto result = isResultFromDisk ? std::move(resultFromDisk).value()
+                                 : runComputation(timer, computationMode);
   auto maxSize =
       isRoot ? cache.getMaxSizeSingleEntry()
              : std::min(getRuntimeParameter<
@@ -300,7 +312,74 @@ CacheValue Operation::runComputationAndPrepareForCache(
                  << resultNumCols << std::endl;
   }
 
-  return CacheValue{std::move(result), runtimeInfo()};
+  CacheValue cacheValue{std::move(result), runtimeInfo()};
+  if (cacheValue.resultTable().isFullyMaterialized() && !isResultFromDisk) {
+    writeToDiskResultCache(cacheValue.resultTablePtr(), cacheKey, timer);
+  }
+  return cacheValue;
+}
+
+// _____________________________________________________________________________
+std::optional<Result> Operation::readFromDiskResultCache(
+    const ad_utility::Timer& timer, ComputationMode computationMode,
+    const QueryCacheKey& cacheKey) {
+  auto* diskResultCache = _executionContext->diskResultCache();
+  const auto& indexFingerprint = getIndex().getIndexFingerprint();
+  if (diskResultCache == nullptr || indexFingerprint.empty() ||
+      !canResultBeCached() ||
+      !DiskResultCache::isApplicable(
+          _executionContext->locatedTriplesState())) {
+    return std::nullopt;
+  }
+  auto result = diskResultCache->read(
+      cacheKey.key_, indexFingerprint,
+      computationMode == ComputationMode::LAZY_IF_SUPPORTED,
+      _executionContext->getAllocator());
+  if (!result.has_value()) {
+    return std::nullopt;
+  }
+
+  // The children of this operation are not evaluated.
+  auto& rti = runtimeInfo();
+  rti.addDetail("read-from-disk-cache", true);
+  if (result->isFullyMaterialized()) {
+    updateRuntimeInformationOnSuccess(result->idTable().numRows(),
+                                      ad_utility::CacheStatus::computed,
+                                      timer.msecs(), RuntimeInformation{});
+  } else {
+    rti.status_ = RuntimeInformation::lazilyMaterializedInProgress;
+    rti.children_.clear();
+    result->runOnNewChunkComputed(
+        [this](const Result::IdTableVocabPair& pair,
+               std::chrono::microseconds duration) {
+          updateRuntimeStats(false, pair.idTable_.numRows(),
+                             pair.idTable_.numColumns(), duration);
+          signalQueryUpdate(RuntimeInformation::SendPriority::IfDue);
+        },
+        [this](Result::GeneratorState state) {
+          runtimeInfo().status_ = statusOfFinishedLazyResult(state);
+          signalQueryUpdate(RuntimeInformation::SendPriority::Always);
+        });
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void Operation::writeToDiskResultCache(std::shared_ptr<const Result> result,
+                                       const QueryCacheKey& cacheKey,
+                                       const ad_utility::Timer& timer) {
+  auto* diskResultCache = _executionContext->diskResultCache();
+  const auto& indexFingerprint = getIndex().getIndexFingerprint();
+  std::chrono::milliseconds minComputationTime =
+      getRuntimeParameter<&RuntimeParameters::diskCacheMinComputationTime_>();
+  if (diskResultCache == nullptr || indexFingerprint.empty() ||
+      !canResultBeCached() || timer.msecs() < minComputationTime ||
+      !DiskResultCache::isApplicable(
+          _executionContext->locatedTriplesState())) {
+    return;
+  }
+  diskResultCache->writeInBackground(cacheKey.key_, indexFingerprint,
+                                     std::move(result));
 }
 
 // ________________________________________________________________________
@@ -312,6 +391,11 @@ std::shared_ptr<const Result> Operation::getResult(
     precomputedResultBecauseSiblingOfService_.reset();
     return result;
   }
+  if (precomputedResultFromAdaptivePlanning_.has_value()) {
+    auto result = std::move(precomputedResultFromAdaptivePlanning_).value();
+    precomputedResultFromAdaptivePlanning_.reset();
+    return result;
+  }
 
   ad_utility::Timer timer{ad_utility::Timer::Started};
 
@@ -61,6 +61,12 @@ class Operation {
   std::optional<std::shared_ptr<const Result>>
       precomputedResultBecauseSiblingOfService_;
 
+  // Holds a precomputed Result of this operation if it was computed during
+  // adaptive query planning but could not be cached (see
+  // `AdaptiveQueryPlanning.h`).
+  std::optional<std::shared_ptr<const Result>>
+      precomputedResultFromAdaptivePlanning_;
+
   std::shared_ptr<RuntimeInformation> _runtimeInfo =
       std::make_shared<RuntimeInformation>();
 
@@ -253,6 +259,12 @@ class Operation {
     return precomputedResultBecauseSiblingOfService_;
   }
 
+  // See the member variable with the same name below for documentation.
+  std::optional<std::shared_ptr<const Result>>&
+  precomputedResultFromAdaptivePlanning() {
+    return precomputedResultFromAdaptivePlanning_;
+  }
+
   RuntimeInformation& runtimeInfo() const { return *_runtimeInfo; }
 
   std::shared_ptr<RuntimeInformation> getRuntimeInfoPointer() {
@@ -347,6 +359,14 @@ class Operation {
     return _executionContext;
   }
 
+  // Replace the execution context. This is only safe if the new context refers
+  // to the same index and located triples as the old one, see
+  // `QueryExecutionTree::recursivelyRebind`.
+  void setExecutionContext(QueryExecutionContext* executionContext) {
+    AD_CONTRACT_CHECK(executionContext != nullptr);
+    _executionContext = executionContext;
+  }
+
   const ad_utility::AllocatorWithLimit<Id>& allocator() const {
     return getExecutionContext()->getAllocator();
   }
@@ -518,6 +538,21 @@ class Operation {
                                               const QueryCacheKey& cacheKey,
                                               bool pinned, bool isRoot);
 
+  // Read the result for the `cacheKey` from the disk tier of the cache (see
+  // `DiskResultCache.h`) and set the runtime information accordingly. Return
+  // `std::nullopt` if there is no disk tier, or it doesn't contain the result.
+  std::optional<Result> readFromDiskResultCache(
+      const ad_utility::Timer& timer, ComputationMode computationMode,
+      const QueryCacheKey& cacheKey);
+
+  // Write the fully materialized `result` for the `cacheKey` to the disk tier
+  // of the cache if there is one and the computation of the result (as measured
+  // by the `timer`) took at least `disk-cache-min-computation-time`. The result
+  // is written in the background, so this doesn't delay the query.
+  void writeToDiskResultCache(std::shared_ptr<const Result> result,
+                              const QueryCacheKey& cacheKey,
+                              const ad_utility::Timer& timer);
+
   // Create and store the complete runtime information for this operation after
   // it has either been successfully computed or read from the cache.
   virtual void updateRuntimeInformationOnSuccess(
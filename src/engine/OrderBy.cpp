@@ -9,6 +9,7 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/TopKHelpers.h"
 #include "global/RuntimeParameters.h"
 #include "global/ValueIdComparators.h"
 #include "index/IdTableUtils.h"
@@ -65,6 +66,36 @@ std::string OrderBy::getDescriptor() const {
 // _____________________________________________________________________________
 Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
   using std::endl;
+  // Return true iff `rowA` comes before `rowB` in the sort order specified by
+  // `sortIndices_`.
+  auto comparison = [this](const auto& row1, const auto& row2) -> bool {
+    for (auto& [column, isDescending] : sortIndices_) {
+      if (row1[column] == row2[column]) {
+        continue;
+      }
+      bool isLessThan =
+          toBoolNotUndef(valueIdComparators::compareIds<
+                         valueIdComparators::ComparisonForIncompatibleTypes::
+                             CompareByType>(
+              row1[column], row2[column], valueIdComparators::Comparison::LT));
+      return isLessThan != isDescending;
+    }
+    return false;
+  };
+
+  // With a small `LIMIT`, we only compute the first rows without
+  // materializing the complete input. The `LIMIT` and `OFFSET` are then
+  // applied to these rows by the calling `Operation::getResult`.
+  if (auto k = qlever::topKHelpers::getTopK(getLimitOffset())) {
+    AD_LOG_DEBUG << "Getting sub-result for OrderBy with top-k..." << endl;
+    std::shared_ptr<const Result> subRes = subtree_->getResult(true);
+    runtimeInfo().addDetail("top-k", k.value());
+    return {qlever::topKHelpers::computeTopK(
+                *subRes, k.value(), getResultWidth(), comparison, allocator(),
+                [this]() { checkCancellation(); }),
+            resultSortedOn()};
+  }
+
   AD_LOG_DEBUG << "Getting sub-result for OrderBy result computation..."
                << endl;
   std::shared_ptr<const Result> subRes = subtree_->getResult();
@@ -100,23 +131,6 @@ Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
   // only contains a single datatype, then we can use more efficient
   // implementations here.
 
-  // Return true iff `rowA` comes before `rowB` in the sort order specified by
-  // `sortIndices_`.
-  auto comparison = [this](const auto& row1, const auto& row2) -> bool {
-    for (auto& [column, isDescending] : sortIndices_) {
-      if (row1[column] == row2[column]) {
-        continue;
-      }
-      bool isLessThan =
-          toBoolNotUndef(valueIdComparators::compareIds<
-                         valueIdComparators::ComparisonForIncompatibleTypes::
-                             CompareByType>(
-              row1[column], row2[column], valueIdComparators::Comparison::LT));
-      return isLessThan != isDescending;
-    }
-    return false;
-  };
-
   // We cannot use the `CALL_FIXED_SIZE` macro here because the `sort` function
   // is templated not only on the integer `I` (which the `callFixedSize`
   // function deals with) but also on the `comparison`.
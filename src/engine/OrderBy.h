@@ -73,6 +73,13 @@ class OrderBy : public Operation {
 
   bool knownEmptyResult() override { return subtree_->knownEmptyResult(); }
 
+  // The `LIMIT` can't be propagated to the subtree, but if it is small, only
+  // the first `LIMIT + OFFSET` rows are computed (see `computeResult`). The
+  // `LIMIT` and `OFFSET` are then applied externally to these rows.
+  LimitOffsetHandling handlesLimitOffset() const override {
+    return LimitOffsetHandling::PARTIAL;
+  }
+
   size_t getResultWidth() const override;
 
   std::vector<QueryExecutionTree*> getChildren() override {
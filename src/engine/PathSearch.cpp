@@ -4,7 +4,10 @@
 
 #include "engine/PathSearch.h"
 
+#include <atomic>
+#include <future>
 #include <optional>
+#include <thread>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -13,10 +16,13 @@
 #include "backports/functional.h"
 #include "backports/iterator.h"
 #include "engine/CallFixedSize.h"
+#include "engine/QueryExecutionContext.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/VariableToColumnMap.h"
+#include "global/RuntimeParameters.h"
 #include "util/Algorithm.h"
 #include "util/AllocatorWithLimit.h"
+#include "util/ParallelExecutor.h"
 
 using namespace pathSearch;
 
@@ -246,6 +252,10 @@ Result PathSearch::computeResult([[maybe_unused]] bool requestLaziness) {
     }
     BinSearchWrapper binSearch{dynSub, subStartColumn, subEndColumn,
                                std::move(edgeColumns)};
+    std::shared_ptr<const CsrGraph> graph;
+    if (config_.algorithm_ != PathSearchAlgorithm::ALL_PATHS) {
+      graph = getGraph(*subRes);
+    }
 
     timer.stop();
     auto buildingTime = timer.msecs();
@@ -263,8 +273,12 @@ Result PathSearch::computeResult([[maybe_unused]] bool requestLaziness) {
       allSources = binSearch.getSources();
       sources = allSources;
     }
-    paths = allPaths(sources, targets, binSearch, config_.cartesian_,
-                     config_.numPathsPerTarget_);
+    if (graph) {
+      paths = shortestPaths(sources, targets, *graph, config_.cartesian_);
+    } else {
+      paths = allPaths(sources, targets, binSearch, config_.cartesian_,
+                       config_.numPathsPerTarget_);
+    }
 
     timer.stop();
     auto searchTime = timer.msecs();
@@ -416,6 +430,174 @@ PathsLimited PathSearch::allPaths(
   return paths;
 }
 
+// _____________________________________________________________________________
+std::shared_ptr<const CsrGraph> PathSearch::getGraph(const Result& edges) {
+  const auto& table = edges.idTable();
+  // The `Id`s of a `LocalVocab` differ between two computations of the same
+  // edges, so such a graph can't be reused.
+  bool isCacheable = edges.localVocab().empty();
+  auto* qec = getExecutionContext();
+  QueryCacheKey key{subtree_->getCacheKey(),
+                    qec->locatedTriplesState().index_};
+  auto& cache = CsrGraphCache::global();
+  auto graph = isCacheable ? cache.get(key) : nullptr;
+  // The edges are sorted by their start and end node, so the same edges
+  // always yield the same graph.
+  AD_CORRECTNESS_CHECK(!graph || graph->numEdges() == table.numRows());
+  runtimeInfo().addDetail("Graph read from cache", graph != nullptr);
+  if (graph) {
+    return graph;
+  }
+  auto newGraph = std::make_shared<CsrGraph>(
+      table.getColumn(subtree_->getVariableColumn(config_.start_)),
+      table.getColumn(subtree_->getVariableColumn(config_.end_)), allocator());
+  runtimeInfo().addDetail("Graph size in bytes", newGraph->getSizeInBytes());
+  if (isCacheable) {
+    cache.insert(key, newGraph);
+  }
+  return newGraph;
+}
+
+// _____________________________________________________________________________
+size_t PathSearch::getNumThreads() {
+  size_t maxHwConcurrency = std::max(1u, std::thread::hardware_concurrency());
+  size_t userPreference =
+      getRuntimeParameter<&RuntimeParameters::pathSearchMaxNumThreads_>();
+  if (userPreference == 0 || maxHwConcurrency < userPreference) {
+    return maxHwConcurrency;
+  }
+  return userPreference;
+}
+
+// _____________________________________________________________________________
+PathsLimited PathSearch::shortestPaths(ql::span<const Id> sources,
+                                       ql::span<const Id> targets,
+                                       const CsrGraph& graph,
+                                       bool cartesian) const {
+  using NodeIndex = CsrGraph::NodeIndex;
+  using EdgePath = CsrGraph::EdgePath;
+  auto checkCancellation = [this]() { this->checkCancellation(); };
+
+  // The targets of a single search as local node indices, without
+  // duplicates. An empty list means that all nodes are targets.
+  struct Targets {
+    std::vector<NodeIndex> nodes_;
+    ad_utility::HashSet<NodeIndex> set_;
+  };
+  struct Search {
+    NodeIndex source_;
+    size_t targets_;
+  };
+  std::vector<Targets> targetLists;
+  std::vector<Search> searches;
+  auto addTargets = [&graph, &targetLists](ql::span<const Id> ids) {
+    Targets& result = targetLists.emplace_back();
+    for (Id id : ids) {
+      auto node = graph.getNodeIndex(id);
+      if (node.has_value() && result.set_.insert(node.value()).second) {
+        result.nodes_.push_back(node.value());
+      }
+    }
+    // If none of the `ids` is a node of the graph, there are no paths. This
+    // must not be confused with an empty list of targets.
+    return ids.empty() || !result.nodes_.empty();
+  };
+  if (cartesian || sources.size() != targets.size()) {
+    if (!addTargets(targets)) {
+      return PathsLimited{allocator()};
+    }
+    for (Id source : sources) {
+      if (auto node = graph.getNodeIndex(source); node.has_value()) {
+        searches.push_back({node.value(), 0});
+      }
+    }
+  } else {
+    for (size_t i = 0; i < sources.size(); i++) {
+      auto node = graph.getNodeIndex(sources[i]);
+      if (node.has_value() && addTargets(targets.subspan(i, 1))) {
+        searches.push_back({node.value(), targetLists.size() - 1});
+      }
+    }
+  }
+
+  auto findPaths = [&](const Search& search) {
+    const auto& targets = targetLists[search.targets_];
+    if (config_.algorithm_ == PathSearchAlgorithm::SHORTEST_PATH) {
+      // For a single target, the bidirectional search is much faster.
+      if (targets.nodes_.size() != 1) {
+        return graph.shortestPathsToAll(search.source_, targets.set_,
+                                        checkCancellation);
+      }
+      std::vector<EdgePath> paths;
+      auto path = graph.shortestPath(search.source_, targets.nodes_.front(),
+                                     checkCancellation);
+      if (path.has_value()) {
+        paths.push_back(std::move(path.value()));
+      }
+      return paths;
+    }
+    AD_CORRECTNESS_CHECK(config_.algorithm_ ==
+                         PathSearchAlgorithm::K_SHORTEST_PATHS);
+    // Without targets, the targets are all the reachable nodes.
+    std::vector<NodeIndex> reachableNodes;
+    const auto* targetNodes = &targets.nodes_;
+    if (targetNodes->empty()) {
+      for (const auto& path :
+           graph.shortestPathsToAll(search.source_, {}, checkCancellation)) {
+        reachableNodes.push_back(graph.edgeEnd(path.back()));
+      }
+      targetNodes = &reachableNodes;
+    }
+    std::vector<EdgePath> paths;
+    for (NodeIndex target : *targetNodes) {
+      for (auto& path :
+           graph.kShortestPaths(search.source_, target,
+                                config_.numPathsPerTarget_.value_or(1),
+                                checkCancellation)) {
+        paths.push_back(std::move(path));
+      }
+    }
+    return paths;
+  };
+
+  // Each thread repeatedly takes the next search that has not been started
+  // yet. The paths are stored per search, s.t. the result does not depend on
+  // the number of threads.
+  std::vector<std::vector<EdgePath>> pathsPerSearch(searches.size());
+  std::atomic<size_t> nextSearch = 0;
+  auto processSearches = [&]() {
+    for (size_t i = nextSearch++; i < searches.size(); i = nextSearch++) {
+      pathsPerSearch[i] = findPaths(searches[i]);
+    }
+  };
+  size_t numThreads = std::min(getNumThreads(), searches.size());
+  if (numThreads <= 1) {
+    processSearches();
+  } else {
+    std::vector<std::packaged_task<void()>> tasks;
+    for (size_t i = 0; i < numThreads; ++i) {
+      tasks.emplace_back(processSearches);
+    }
+    ad_utility::runTasksInParallel(std::move(tasks));
+  }
+
+  PathsLimited paths{allocator()};
+  for (size_t i = 0; i < searches.size(); ++i) {
+    for (const auto& edgePath : pathsPerSearch[i]) {
+      Path path{EdgesLimited(allocator())};
+      Id start = graph.getId(searches[i].source_);
+      for (auto edge : edgePath) {
+        Id end = graph.getId(graph.edgeEnd(edge));
+        path.push_back(Edge{start, end, edge});
+        start = end;
+      }
+      paths.push_back(std::move(path));
+    }
+    pathsPerSearch[i].clear();
+  }
+  return paths;
+}
+
 // _____________________________________________________________________________
 template <size_t WIDTH>
 void PathSearch::pathsToResultTable(IdTable& tableDyn, PathsLimited& paths,
@@ -12,10 +12,15 @@
 
 #include "backports/span.h"
 #include "engine/Operation.h"
+#include "engine/PathSearchGraph.h"
 #include "global/Id.h"
 #include "util/AllocatorWithLimit.h"
 
-enum class PathSearchAlgorithm { ALL_PATHS };
+// `ALL_PATHS` enumerates all simple paths with a depth-first search.
+// `SHORTEST_PATH` finds one path with the smallest number of edges for each
+// pair of a source and a target, and `K_SHORTEST_PATHS` finds the
+// `numPathsPerTarget_` shortest simple paths for each such pair.
+enum class PathSearchAlgorithm { ALL_PATHS, SHORTEST_PATH, K_SHORTEST_PATHS };
 
 /**
  * @brief Represents the source or target side of a PathSearch.
@@ -123,6 +128,10 @@ struct PathSearchConfiguration {
     std::ostringstream os;
     if (algorithm_ == PathSearchAlgorithm::ALL_PATHS) {
       os << "Algorithm: All paths" << '\n';
+    } else if (algorithm_ == PathSearchAlgorithm::SHORTEST_PATH) {
+      os << "Algorithm: Shortest path" << '\n';
+    } else if (algorithm_ == PathSearchAlgorithm::K_SHORTEST_PATHS) {
+      os << "Algorithm: K shortest paths" << '\n';
     }
 
     os << "Source: " << searchSideToString(sources_) << '\n';
@@ -138,6 +147,11 @@ struct PathSearchConfiguration {
       os << "  " << edgeProperty.toSparql() << '\n';
     }
 
+    os << "Cartesian: " << cartesian_ << '\n';
+    if (numPathsPerTarget_.has_value()) {
+      os << "NumPathsPerTarget: " << numPathsPerTarget_.value() << '\n';
+    }
+
     return std::move(os).str();
   }
 };
@@ -276,6 +290,27 @@ class PathSearch : public Operation {
       const pathSearch::BinSearchWrapper& binSearch, bool cartesian,
       std::optional<uint64_t> numPathsPerTarget) const;
 
+  /**
+   * @brief Get the `CsrGraph` of the `edges`, either from the `CsrGraphCache`
+   * or by building (and caching) it.
+   */
+  std::shared_ptr<const pathSearch::CsrGraph> getGraph(const Result& edges);
+
+  /**
+   * @brief Finds the paths for the `SHORTEST_PATH` and `K_SHORTEST_PATHS`
+   * algorithms. The sources (or, if the search is not cartesian, the pairs of
+   * a source and a target) are processed in parallel.
+   * @return A vector of paths, grouped by their source (or pair).
+   */
+  pathSearch::PathsLimited shortestPaths(ql::span<const Id> sources,
+                                         ql::span<const Id> targets,
+                                         const pathSearch::CsrGraph& graph,
+                                         bool cartesian) const;
+
+  // The number of threads for `shortestPaths`, see the runtime parameter
+  // `path-search-max-num-threads`.
+  static size_t getNumThreads();
+
   /**
    * @brief Converts paths to a result table with a specified width.
    * @tparam WIDTH The width of the result table.
@@ -0,0 +1,337 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/PathSearchGraph.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <set>
+
+#include "backports/algorithm.h"
+#include "global/RuntimeParameters.h"
+#include "util/Exception.h"
+#include "util/HashMap.h"
+
+using namespace pathSearch;
+
+namespace {
+using NodeIndex = CsrGraph::NodeIndex;
+using EdgeIndex = CsrGraph::EdgeIndex;
+using EdgePath = CsrGraph::EdgePath;
+
+// The way in which a breadth-first search has reached a node: via the `edge_`
+// from (or, for a backward search, to) the node `neighbor_`, with `distance_`
+// edges from the start of the search.
+struct Visit {
+  EdgeIndex edge_;
+  NodeIndex neighbor_;
+  size_t distance_;
+};
+using Visits = ad_utility::HashMap<NodeIndex, Visit>;
+
+// Append the edges on the way from the `node` to the start of the search that
+// created the `visits` (which has the distance 0) to the `path`.
+void appendEdgesToStart(const Visits& visits, NodeIndex node, EdgePath& path) {
+  for (auto visit = visits.at(node); visit.distance_ > 0;
+       visit = visits.at(visit.neighbor_)) {
+    path.push_back(visit.edge_);
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+CsrGraph::CsrGraph(ql::span<const Id> startIds, ql::span<const Id> endIds,
+                   const ad_utility::AllocatorWithLimit<Id>& allocator)
+    : nodes_(allocator),
+      outOffsets_(allocator),
+      edgeEnds_(allocator),
+      inOffsets_(allocator),
+      inEdges_(allocator),
+      inStarts_(allocator) {
+  AD_CONTRACT_CHECK(startIds.size() == endIds.size());
+  AD_EXPENSIVE_CHECK(ql::ranges::is_sorted(startIds));
+
+  // The start nodes are already sorted, so only the end nodes have to be
+  // sorted before the two are merged.
+  {
+    Vector<Id> sortedEndIds(endIds.begin(), endIds.end(), allocator);
+    ql::ranges::sort(sortedEndIds);
+    nodes_.reserve(startIds.size() + sortedEndIds.size());
+    std::merge(startIds.begin(), startIds.end(), sortedEndIds.begin(),
+               sortedEndIds.end(), std::back_inserter(nodes_));
+  }
+  nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+  nodes_.shrink_to_fit();
+  AD_CONTRACT_CHECK(nodes_.size() < std::numeric_limits<NodeIndex>::max(),
+                    "The graph of a path search has too many nodes");
+
+  // Count the outgoing and incoming edges of each node.
+  const size_t numEdges = startIds.size();
+  outOffsets_.assign(nodes_.size() + 1, 0);
+  inOffsets_.assign(nodes_.size() + 1, 0);
+  edgeEnds_.resize(numEdges);
+  NodeIndex start = 0;
+  for (size_t edge = 0; edge < numEdges; ++edge) {
+    while (nodes_[start] < startIds[edge]) {
+      ++start;
+    }
+    ++outOffsets_[start + 1];
+    edgeEnds_[edge] = getNodeIndex(endIds[edge]).value();
+    ++inOffsets_[edgeEnds_[edge] + 1];
+  }
+  std::partial_sum(outOffsets_.begin(), outOffsets_.end(),
+                   outOffsets_.begin());
+  std::partial_sum(inOffsets_.begin(), inOffsets_.end(), inOffsets_.begin());
+
+  // Sort the edges by their end node (a counting sort, which keeps the order
+  // of the edges with the same end node).
+  inEdges_.resize(numEdges);
+  inStarts_.resize(numEdges);
+  Vector<EdgeIndex> nextPosition(inOffsets_.begin(), inOffsets_.end() - 1,
+                                 allocator);
+  start = 0;
+  for (size_t edge = 0; edge < numEdges; ++edge) {
+    while (outOffsets_[start + 1] <= edge) {
+      ++start;
+    }
+    auto position = nextPosition[edgeEnds_[edge]]++;
+    inEdges_[position] = edge;
+    inStarts_[position] = start;
+  }
+}
+
+// _____________________________________________________________________________
+std::optional<NodeIndex> CsrGraph::getNodeIndex(Id id) const {
+  auto it = ql::ranges::lower_bound(nodes_, id);
+  if (it == nodes_.end() || *it != id) {
+    return std::nullopt;
+  }
+  return static_cast<NodeIndex>(it - nodes_.begin());
+}
+
+// _____________________________________________________________________________
+size_t CsrGraph::getSizeInBytes() const {
+  return nodes_.size() * sizeof(Id) +
+         (outOffsets_.size() + inOffsets_.size() + inEdges_.size()) *
+             sizeof(EdgeIndex) +
+         (edgeEnds_.size() + inStarts_.size()) * sizeof(NodeIndex);
+}
+
+// _____________________________________________________________________________
+std::optional<EdgePath> CsrGraph::shortestPath(
+    NodeIndex source, NodeIndex target,
+    const CancellationCheck& checkCancellation, const Blocked& blocked) const {
+  if (source == target || blocked.nodes_.contains(source) ||
+      blocked.nodes_.contains(target)) {
+    return std::nullopt;
+  }
+  Visits forward;
+  Visits backward;
+  forward.emplace(source, Visit{0, source, 0});
+  backward.emplace(target, Visit{0, target, 0});
+  std::vector<NodeIndex> forwardFrontier{source};
+  std::vector<NodeIndex> backwardFrontier{target};
+  std::vector<NodeIndex> nextFrontier;
+
+  while (!forwardFrontier.empty() && !backwardFrontier.empty()) {
+    checkCancellation();
+    const bool expandForward =
+        forwardFrontier.size() <= backwardFrontier.size();
+    auto& frontier = expandForward ? forwardFrontier : backwardFrontier;
+    auto& visits = expandForward ? forward : backward;
+    const auto& otherVisits = expandForward ? backward : forward;
+
+    // The node where the two searches meet on the shortest path so far, and
+    // the length of this path. All the meetings of the current level have to
+    // be considered, because the nodes that the other search has visited
+    // have different distances.
+    std::optional<NodeIndex> meeting;
+    size_t shortestLength = std::numeric_limits<size_t>::max();
+    nextFrontier.clear();
+    for (NodeIndex node : frontier) {
+      const size_t distance = visits.at(node).distance_ + 1;
+      auto visit = [&](EdgeIndex edge, NodeIndex neighbor) {
+        if (blocked.edges_.contains(edge) ||
+            blocked.nodes_.contains(neighbor) || visits.contains(neighbor)) {
+          return;
+        }
+        visits.emplace(neighbor, Visit{edge, node, distance});
+        nextFrontier.push_back(neighbor);
+        if (auto it = otherVisits.find(neighbor); it != otherVisits.end()) {
+          auto length = distance + it->second.distance_;
+          if (length < shortestLength) {
+            shortestLength = length;
+            meeting = neighbor;
+          }
+        }
+      };
+      if (expandForward) {
+        for (auto edge = outOffsets_[node]; edge < outOffsets_[node + 1];
+             ++edge) {
+          visit(edge, edgeEnds_[edge]);
+        }
+      } else {
+        for (auto i = inOffsets_[node]; i < inOffsets_[node + 1]; ++i) {
+          visit(inEdges_[i], inStarts_[i]);
+        }
+      }
+    }
+
+    if (meeting.has_value()) {
+      EdgePath path;
+      appendEdgesToStart(forward, meeting.value(), path);
+      ql::ranges::reverse(path);
+      appendEdgesToStart(backward, meeting.value(), path);
+      AD_CORRECTNESS_CHECK(path.size() == shortestLength);
+      return path;
+    }
+    frontier.swap(nextFrontier);
+  }
+  return std::nullopt;
+}
+
+// _____________________________________________________________________________
+std::vector<EdgePath> CsrGraph::shortestPathsToAll(
+    NodeIndex source, const ad_utility::HashSet<NodeIndex>& targets,
+    const CancellationCheck& checkCancellation) const {
+  Visits visits;
+  visits.emplace(source, Visit{0, source, 0});
+  std::vector<NodeIndex> frontier{source};
+  std::vector<NodeIndex> nextFrontier;
+  // There is no path of length zero from the `source` to itself, so the
+  // `source` counts as found right away.
+  std::vector<NodeIndex> foundTargets;
+  size_t numFoundTargets = targets.contains(source) ? 1 : 0;
+
+  auto allTargetsFound = [&]() {
+    return !targets.empty() && numFoundTargets == targets.size();
+  };
+  while (!frontier.empty() && !allTargetsFound()) {
+    checkCancellation();
+    nextFrontier.clear();
+    for (NodeIndex node : frontier) {
+      const size_t distance = visits.at(node).distance_ + 1;
+      for (auto edge = outOffsets_[node]; edge < outOffsets_[node + 1];
+           ++edge) {
+        NodeIndex neighbor = edgeEnds_[edge];
+        if (!visits.emplace(neighbor, Visit{edge, node, distance}).second) {
+          continue;
+        }
+        nextFrontier.push_back(neighbor);
+        if (targets.empty() || targets.contains(neighbor)) {
+          foundTargets.push_back(neighbor);
+          ++numFoundTargets;
+        }
+      }
+    }
+    frontier.swap(nextFrontier);
+  }
+
+  std::vector<EdgePath> paths;
+  paths.reserve(foundTargets.size());
+  for (NodeIndex target : foundTargets) {
+    EdgePath& path = paths.emplace_back();
+    appendEdgesToStart(visits, target, path);
+    ql::ranges::reverse(path);
+  }
+  return paths;
+}
+
+// _____________________________________________________________________________
+std::vector<EdgePath> CsrGraph::kShortestPaths(
+    NodeIndex source, NodeIndex target, size_t k,
+    const CancellationCheck& checkCancellation) const {
+  std::vector<EdgePath> result;
+  if (k == 0) {
+    return result;
+  }
+  auto first = shortestPath(source, target, checkCancellation);
+  if (!first.has_value()) {
+    return result;
+  }
+  result.push_back(std::move(first.value()));
+
+  // The candidates for the next path, ordered by their length and then by
+  // their edges. Using a set also removes the duplicates.
+  auto isBefore = [](const EdgePath& a, const EdgePath& b) {
+    return a.size() != b.size() ? a.size() < b.size() : a < b;
+  };
+  std::set<EdgePath, decltype(isBefore)> candidates{isBefore};
+
+  while (result.size() < k) {
+    const EdgePath& previous = result.back();
+    // Each candidate consists of the first `i` edges of the `previous` path
+    // (the root path) and a shortest path from the end of the root path (the
+    // spur node) to the `target` that neither uses the next edge of any of
+    // the paths found so far with the same root path, nor the nodes of the
+    // root path. This guarantees that each candidate is simple and different
+    // from all the paths found so far.
+    for (size_t i = 0; i < previous.size(); ++i) {
+      checkCancellation();
+      Blocked blocked;
+      for (const auto& path : result) {
+        if (path.size() > i &&
+            std::equal(path.begin(), path.begin() + i, previous.begin())) {
+          blocked.edges_.insert(path[i]);
+        }
+      }
+      for (size_t j = 0; j < i; ++j) {
+        blocked.nodes_.insert(nodeAfter(source, previous, j));
+      }
+      auto spurPath = shortestPath(nodeAfter(source, previous, i), target,
+                                   checkCancellation, blocked);
+      if (!spurPath.has_value()) {
+        continue;
+      }
+      EdgePath candidate(previous.begin(), previous.begin() + i);
+      candidate.insert(candidate.end(), spurPath.value().begin(),
+                       spurPath.value().end());
+      candidates.insert(std::move(candidate));
+    }
+    if (candidates.empty()) {
+      break;
+    }
+    result.push_back(std::move(candidates.extract(candidates.begin()).value()));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+CsrGraphCache& CsrGraphCache::global() {
+  static CsrGraphCache cache;
+  return cache;
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const CsrGraph> CsrGraphCache::get(const QueryCacheKey& key) {
+  // `operator[]` updates the LRU order, so we need a write lock.
+  return (*cache_.wlock())[key];
+}
+
+// _____________________________________________________________________________
+void CsrGraphCache::insert(const QueryCacheKey& key,
+                           std::shared_ptr<CsrGraph> graph) {
+  auto lock = cache_.wlock();
+  // The maximal size can be changed at runtime, `setMaxSize` also evicts
+  // entries if the cache has become too large.
+  lock->setMaxSize(
+      getRuntimeParameter<&RuntimeParameters::pathSearchGraphCacheMaxSize_>());
+  // Another query might have built the same graph in the meantime, the
+  // underlying cache throws when a key is inserted twice.
+  if (lock->contains(key)) {
+    return;
+  }
+  lock->insert(key, std::move(graph));
+}
+
+// _____________________________________________________________________________
+size_t CsrGraphCache::numEntries() const {
+  return cache_.rlock()->numNonPinnedEntries();
+}
+
+// _____________________________________________________________________________
+void CsrGraphCache::clear() { cache_.wlock()->clearAll(); }
@@ -0,0 +1,161 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_PATHSEARCHGRAPH_H
+#define QLEVER_SRC_ENGINE_PATHSEARCHGRAPH_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "backports/span.h"
+#include "engine/QueryExecutionContext.h"
+#include "global/Id.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/Cache.h"
+#include "util/HashSet.h"
+#include "util/Synchronized.h"
+
+namespace pathSearch {
+
+// A directed graph in the compressed sparse row (CSR) format, built from the
+// edges of a `PathSearch`, i.e. from the start and end column of an `IdTable`
+// that is sorted by these two columns. The nodes get the dense local indices
+// `0, ..., numNodes() - 1` in the order of their `Id`s, and the edge with the
+// index `i` is the edge from row `i` of the table, s.t. its properties can
+// still be read from the table. In contrast to the `BinSearchWrapper`, which
+// searches the table for each expansion, finding the outgoing (and incoming)
+// edges of a node is a single lookup. The memory of the graph is allocated
+// with the `AllocatorWithLimit` of the `PathSearch`.
+//
+// The search algorithms find paths with the smallest number of edges. They
+// never visit a node twice, so all paths are simple (in particular, there are
+// no paths of length zero).
+class CsrGraph {
+ public:
+  using NodeIndex = uint32_t;
+  using EdgeIndex = uint64_t;
+  // A path as the sequence of the indices of its edges.
+  using EdgePath = std::vector<EdgeIndex>;
+  using CancellationCheck = std::function<void()>;
+  template <typename T>
+  using Vector = std::vector<T, ad_utility::AllocatorWithLimit<T>>;
+
+  // Nodes and edges that a search must not use, see `kShortestPaths`.
+  struct Blocked {
+    ad_utility::HashSet<NodeIndex> nodes_;
+    ad_utility::HashSet<EdgeIndex> edges_;
+  };
+
+ private:
+  // The `Id` of each node, sorted.
+  Vector<Id> nodes_;
+  // The outgoing edges of the node `v` are the edges with the indices
+  // `outOffsets_[v], ..., outOffsets_[v + 1] - 1`, `edgeEnds_[e]` is the end
+  // node of the edge `e`.
+  Vector<EdgeIndex> outOffsets_;
+  Vector<NodeIndex> edgeEnds_;
+  // The incoming edges of the node `v` are `inEdges_[i]` for `i` in
+  // `inOffsets_[v], ..., inOffsets_[v + 1] - 1`, and `inStarts_[i]` is the
+  // start node of the edge `inEdges_[i]`.
+  Vector<EdgeIndex> inOffsets_;
+  Vector<EdgeIndex> inEdges_;
+  Vector<NodeIndex> inStarts_;
+
+ public:
+  // Build the graph from the start and end nodes of the edges. The edges must
+  // be sorted by their start node.
+  CsrGraph(ql::span<const Id> startIds, ql::span<const Id> endIds,
+           const ad_utility::AllocatorWithLimit<Id>& allocator);
+
+  size_t numNodes() const { return nodes_.size(); }
+  size_t numEdges() const { return edgeEnds_.size(); }
+
+  // The local index of the node with the given `id`, or `std::nullopt` if the
+  // `id` is not the start or end of any edge.
+  std::optional<NodeIndex> getNodeIndex(Id id) const;
+  Id getId(NodeIndex node) const { return nodes_.at(node); }
+  NodeIndex edgeEnd(EdgeIndex edge) const { return edgeEnds_.at(edge); }
+
+  // The approximate memory usage of the graph in bytes.
+  size_t getSizeInBytes() const;
+
+  // A shortest path from the `source` to the `target` that avoids the
+  // `blocked` nodes and edges, or `std::nullopt` if there is none. This is a
+  // bidirectional breadth-first search, which alternately expands a full
+  // level of the smaller of the two frontiers. On graphs with a large
+  // branching factor this visits far fewer nodes than a search from the
+  // `source` only.
+  std::optional<EdgePath> shortestPath(
+      NodeIndex source, NodeIndex target,
+      const CancellationCheck& checkCancellation,
+      const Blocked& blocked = {}) const;
+
+  // A shortest path from the `source` to each of the `targets`, or to each
+  // node that is reachable from the `source` if the `targets` are empty. The
+  // paths are in the order in which a breadth-first search from the `source`
+  // finds their targets. The search stops as soon as all the `targets` have
+  // been found.
+  std::vector<EdgePath> shortestPathsToAll(
+      NodeIndex source, const ad_utility::HashSet<NodeIndex>& targets,
+      const CancellationCheck& checkCancellation) const;
+
+  // The (at most) `k` shortest simple paths from the `source` to the
+  // `target`, ordered by their length, computed with Yen's algorithm (Yen,
+  // Management Science 1971). Paths of the same length are ordered by the
+  // indices of their edges, s.t. the result is deterministic.
+  std::vector<EdgePath> kShortestPaths(
+      NodeIndex source, NodeIndex target, size_t k,
+      const CancellationCheck& checkCancellation) const;
+
+ private:
+  // The node at the start of the `path` after `numEdges` edges.
+  NodeIndex nodeAfter(NodeIndex source, const EdgePath& path,
+                      size_t numEdges) const {
+    return numEdges == 0 ? source : edgeEnds_[path[numEdges - 1]];
+  }
+};
+
+// A cache for the `CsrGraph`s of `PathSearch`es, which is shared by all
+// queries. A graph is stored under the `QueryCacheKey` of the subtree that
+// computes its edges, so another `PathSearch` on the same edges (in the same
+// or a later query) doesn't build it again. Entries are evicted in LRU order
+// s.t. the total size of the graphs stays below the runtime parameter
+// `path-search-graph-cache-max-size`. A graph is allocated with the
+// `AllocatorWithLimit` of the query that built it, so while it is cached, its
+// memory still counts against the memory limit of that allocator.
+class CsrGraphCache {
+ public:
+  struct SizeGetter {
+    ad_utility::MemorySize operator()(const CsrGraph& graph) const {
+      return ad_utility::MemorySize::bytes(graph.getSizeInBytes());
+    }
+  };
+  using Cache = ad_utility::LRUCache<QueryCacheKey, CsrGraph, SizeGetter>;
+
+ private:
+  ad_utility::Synchronized<Cache> cache_;
+
+ public:
+  // The cache that is shared by all `PathSearch`es.
+  static CsrGraphCache& global();
+
+  // Return the graph for the `key`, or `nullptr` if there is none.
+  std::shared_ptr<const CsrGraph> get(const QueryCacheKey& key);
+
+  // Store the `graph` for the `key`, unless the cache already contains a graph
+  // for the `key` or the `graph` is larger than the maximal size of the cache.
+  void insert(const QueryCacheKey& key, std::shared_ptr<CsrGraph> graph);
+
+  size_t numEntries() const;
+
+  void clear();
+};
+
+}  // namespace pathSearch
+
+#endif  // QLEVER_SRC_ENGINE_PATHSEARCHGRAPH_H
@@ -0,0 +1,155 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/PreparedQuery.h"
+
+#include <stdexcept>
+
+#include "absl/strings/str_cat.h"
+#include "engine/ExternalValues.h"
+#include "engine/QueryExecutionContext.h"
+#include "engine/QueryExecutionTree.h"
+#include "parser/RdfParser.h"
+#include "parser/TokenizerCtre.h"
+#include "util/Algorithm.h"
+#include "util/HashMap.h"
+#include "util/HashSet.h"
+
+// _____________________________________________________________________________
+PreparedQuery::PreparedQuery(ParsedQuery parsedQuery,
+                             std::vector<Variable> parameters)
+    : parsedQuery_{std::move(parsedQuery)}, parameters_{std::move(parameters)} {
+  if (parsedQuery_.hasUpdateClause()) {
+    throw std::runtime_error("SPARQL updates cannot be prepared");
+  }
+  ad_utility::HashSet<Variable> uniqueParameters;
+  for (const auto& parameter : parameters_) {
+    if (!uniqueParameters.insert(parameter).second) {
+      throw std::runtime_error(
+          absl::StrCat("The parameter ", parameter.name(),
+                       " of a prepared query was specified more than once"));
+    }
+  }
+  if (parameters_.empty()) {
+    return;
+  }
+  // Bind the parameters at the beginning of the query body, see the comment
+  // at the class.
+  parsedQuery::ExternalValuesQuery parametersQuery;
+  parametersQuery.name_ = std::string{parametersName};
+  parametersQuery.variables_ = parameters_;
+  parametersQuery.valuesInCacheKey_ = true;
+  auto& children = parsedQuery_.children();
+  children.insert(children.begin(), std::move(parametersQuery));
+}
+
+// _____________________________________________________________________________
+std::vector<Variable> PreparedQuery::parseParameterNames(
+    const std::vector<std::string>& names) {
+  std::vector<Variable> result;
+  result.reserve(names.size());
+  for (const auto& name : names) {
+    bool hasPrefix = name.starts_with('?') || name.starts_with('$');
+    result.emplace_back(hasPrefix ? name : absl::StrCat("?", name));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::vector<TripleComponent> PreparedQuery::parseValues(
+    const ParameterValues& values) const {
+  ad_utility::HashMap<Variable, std::string_view> valuePerParameter;
+  for (const auto& [name, value] : values) {
+    auto parameter = std::move(parseParameterNames({name}).front());
+    if (!ad_utility::contains(parameters_, parameter)) {
+      throw std::runtime_error(absl::StrCat(
+          "The prepared query has no parameter ", parameter.name()));
+    }
+    if (!valuePerParameter.emplace(parameter, value).second) {
+      throw std::runtime_error(
+          absl::StrCat("More than one value was specified for the parameter ",
+                       parameter.name(), " of the prepared query"));
+    }
+  }
+  std::vector<TripleComponent> result;
+  result.reserve(parameters_.size());
+  for (const auto& parameter : parameters_) {
+    auto it = valuePerParameter.find(parameter);
+    if (it == valuePerParameter.end()) {
+      throw std::runtime_error(
+          absl::StrCat("No value was specified for the parameter ",
+                       parameter.name(), " of the prepared query"));
+    }
+    result.push_back(
+        RdfStringParser<TurtleParser<TokenizerCtre>>::parseTripleObject(
+            it->second));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+auto PreparedQuery::getOrCreatePlan(const QueryExecutionContext& qec,
+                                    const CreateContextFunction& createContext,
+                                    const PlanningFunction& planQuery)
+    -> std::shared_ptr<const Plan> {
+  auto isValidFor = [&qec](const std::shared_ptr<const Plan>& plan) {
+    return plan != nullptr && &plan->qec_->getIndex() == &qec.getIndex() &&
+           plan->qec_->locatedTriplesState().index_ ==
+               qec.locatedTriplesState().index_;
+  };
+  if (auto plan = *plan_.rlock(); isValidFor(plan)) {
+    return plan;
+  }
+  // Plan without holding the lock. If two threads plan concurrently, both
+  // plans are valid and the one that finishes last is kept.
+  auto plan = std::make_shared<Plan>();
+  plan->qec_ = createContext();
+  AD_CORRECTNESS_CHECK(plan->qec_ != nullptr &&
+                       &plan->qec_->getIndex() == &qec.getIndex());
+  // The located triples might have changed since `qec` was created.
+  plan->qec_->setLocatedTriplesForEvaluation(qec.locatedTriplesSharedState());
+  plan->parsedQuery_ = parsedQuery_;
+  plan->qet_ = std::make_shared<QueryExecutionTree>(
+      planQuery(plan->parsedQuery_, *plan->qec_));
+  ++numPlans_;
+  *plan_.wlock() = plan;
+  return plan;
+}
+
+// _____________________________________________________________________________
+PreparedQuery::BoundQuery PreparedQuery::bind(
+    std::vector<TripleComponent> values, QueryExecutionContext& qec,
+    const CreateContextFunction& createContext,
+    const PlanningFunction& planQuery) {
+  if (values.size() != parameters_.size()) {
+    throw std::runtime_error(absl::StrCat(
+        "The prepared query has ", parameters_.size(), " parameters, but ",
+        values.size(), " values were specified"));
+  }
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (values[i].isVariable() || values[i].isUndef()) {
+      throw std::runtime_error(
+          absl::StrCat("The value of the parameter ", parameters_[i].name(),
+                       " of a prepared query must be an IRI or a literal"));
+    }
+  }
+
+  auto plan = getOrCreatePlan(qec, createContext, planQuery);
+  auto qet = plan->qet_->clone();
+  if (!parameters_.empty()) {
+    std::vector<ExternalValues*> externalValues;
+    qet->getRootOperation()->getExternalValues(externalValues);
+    auto it = ql::ranges::find(externalValues, parametersName,
+                               &ExternalValues::getName);
+    AD_CORRECTNESS_CHECK(it != externalValues.end());
+    parsedQuery::SparqlValues sparqlValues;
+    sparqlValues._variables = parameters_;
+    sparqlValues._values.push_back(std::move(values));
+    (*it)->updateValues(std::move(sparqlValues));
+  }
+  qet->recursivelyRebind(&qec);
+  qet->isRoot() = true;
+  return {std::move(qet), plan->parsedQuery_};
+}
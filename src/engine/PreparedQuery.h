@@ -0,0 +1,132 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_PREPAREDQUERY_H
+#define QLEVER_SRC_ENGINE_PREPAREDQUERY_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "parser/ParsedQuery.h"
+#include "parser/TripleComponent.h"
+#include "util/Synchronized.h"
+
+class QueryExecutionContext;
+class QueryExecutionTree;
+
+// A SPARQL query with parameters that is parsed once and planned once per
+// snapshot of the index (see below), and then executed repeatedly with
+// different values for the parameters. The parameters are variables of the
+// query. Binding them to values is equivalent to a `VALUES` clause with a
+// single row at the beginning of the query body. This is also how it is
+// implemented: An `ExternalValues` operation (see `ExternalValues.h`) for the
+// parameters is added to the query, and each execution clones the plan and
+// sets the values of the `ExternalValues` in the clone. The values are part of
+// the cache keys of the clone, so the results of the executions are cached as
+// usual.
+//
+// NOTE: The plan is a "generic" plan, computed without knowing the values. A
+// parameter is estimated as a single row, which is exactly its size once it is
+// bound, but the sizes of the triples that contain a parameter can differ
+// widely for different values (just like for a query with a `VALUES` clause).
+//
+// The plan refers to the index and the located triples for which it was
+// computed. When an execution uses a different index or located triples (e.g.
+// after a SPARQL UPDATE), the query is planned again.
+class PreparedQuery {
+ public:
+  // The name of the `ExternalValues` operation that holds the values of the
+  // parameters.
+  static constexpr std::string_view parametersName =
+      "prepared-query-parameters";
+
+  // Plan the given query (with the `ExternalValues` for the parameters) using
+  // the given context.
+  using PlanningFunction =
+      std::function<QueryExecutionTree(ParsedQuery&, QueryExecutionContext&)>;
+
+  // Create the context for a (new) plan. The context must refer to the same
+  // index as the context of the execution (see `bind` below), its located
+  // triples are set by `bind`.
+  using CreateContextFunction =
+      std::function<std::shared_ptr<QueryExecutionContext>()>;
+
+  // The values of the parameters, as pairs of the name of a parameter (with or
+  // without the leading `?` or `$`) and a value in SPARQL syntax, for example
+  // `<http://example.org/x>`, `"text"@en`, or `42`.
+  using ParameterValues = std::vector<std::pair<std::string, std::string>>;
+
+  // The query plan for one execution.
+  struct BoundQuery {
+    std::shared_ptr<QueryExecutionTree> qet_;
+    ParsedQuery parsedQuery_;
+  };
+
+ private:
+  // The query with the additional `ExternalValuesQuery` for the parameters.
+  ParsedQuery parsedQuery_;
+  std::vector<Variable> parameters_;
+
+  // The plan for the most recently used index and located triples, together
+  // with the context and the `ParsedQuery` (the planner may modify the latter)
+  // it was created with.
+  struct Plan {
+    std::shared_ptr<QueryExecutionContext> qec_;
+    std::shared_ptr<const QueryExecutionTree> qet_;
+    ParsedQuery parsedQuery_;
+  };
+  ad_utility::Synchronized<std::shared_ptr<const Plan>> plan_;
+  std::atomic<size_t> numPlans_ = 0;
+
+ public:
+  // Create from the given `parsedQuery` (which must not be an update) and its
+  // `parameters`. Throw if a parameter is specified more than once.
+  PreparedQuery(ParsedQuery parsedQuery, std::vector<Variable> parameters);
+
+  // Convert the names of parameters (with or without the leading `?` or `$`)
+  // to variables.
+  static std::vector<Variable> parseParameterNames(
+      const std::vector<std::string>& names);
+
+  const std::vector<Variable>& parameters() const { return parameters_; }
+  // The query including the `ExternalValuesQuery` for the parameters.
+  const ParsedQuery& parsedQuery() const { return parsedQuery_; }
+  const std::string& originalString() const {
+    return parsedQuery_._originalString;
+  }
+
+  // The number of times this query has been planned so far.
+  size_t numPlans() const { return numPlans_; }
+
+  // Convert the given `values` (see `ParameterValues` above) to one value per
+  // parameter, in the order of `parameters()`. Throw if the value of a
+  // parameter is missing or cannot be parsed, or if there is a value for an
+  // unknown parameter.
+  std::vector<TripleComponent> parseValues(const ParameterValues& values) const;
+
+  // Return a plan for executing the query with the given `values` (one for each
+  // parameter, in the order of `parameters()`) as part of the query with the
+  // context `qec`. If there is no plan for the index and located triples of
+  // `qec` yet, the query is planned using `createContext` and `planQuery`.
+  BoundQuery bind(std::vector<TripleComponent> values,
+                  QueryExecutionContext& qec,
+                  const CreateContextFunction& createContext,
+                  const PlanningFunction& planQuery);
+
+ private:
+  // Return the current plan if it is valid for `qec`, otherwise create a new
+  // one.
+  std::shared_ptr<const Plan> getOrCreatePlan(
+      const QueryExecutionContext& qec,
+      const CreateContextFunction& createContext,
+      const PlanningFunction& planQuery);
+};
+
+#endif  // QLEVER_SRC_ENGINE_PREPAREDQUERY_H
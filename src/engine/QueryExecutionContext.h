@@ -22,6 +22,7 @@
 #include "index/Index.h"
 #include "util/Cache.h"
 #include "util/ConcurrentCache.h"
+#include "util/ShardedConcurrentCache.h"
 
 // The value of the `QueryResultCache` below. It consists of a `Result` together
 // with its `RuntimeInfo`.
@@ -90,13 +91,15 @@ struct QueryCacheKey {
 
 // Threadsafe LRU cache for (partial) query results, that
 // checks on insertion, if the result is currently being computed
-// by another query.
-using QueryResultCache = ad_utility::ConcurrentCache<
+// by another query. The cache is sharded, so that the many concurrent lookups
+// (one for each operation of each query) do not wait for a single lock.
+using QueryResultCache = ad_utility::ShardedConcurrentCache<
     ad_utility::LRUCache<QueryCacheKey, CacheValue, CacheValue::SizeGetter>>;
 
 // Forward declaration because of cyclic dependency
 class NamedResultCache;
 class MaterializedViewsManager;
+class DiskResultCache;
 
 // Execution context for queries. Holds a `std::shared_ptr` to the `Index`
 // and `MaterializedViewsManager` to ensure that they stay alive as long as
@@ -187,6 +190,13 @@ class QueryExecutionContext
   // Access the cache for explicitly named query.
   NamedResultCache& namedResultCache() { return *namedResultCache_; }
 
+  // The disk tier of the cache for query results, or `nullptr` if there is
+  // none (the default).
+  DiskResultCache* diskResultCache() const { return diskResultCache_; }
+  void setDiskResultCache(DiskResultCache* diskResultCache) {
+    diskResultCache_ = diskResultCache;
+  }
+
   // Get a reference to the `MaterializedViewsManager`.
   const MaterializedViewsManager& materializedViewsManager() const {
     return *materializedViewsManager_;
@@ -252,6 +262,9 @@ class QueryExecutionContext
   // The cache for named results.
   NamedResultCache* namedResultCache_;
 
+  // See the documentation for the getter with the same name above.
+  DiskResultCache* diskResultCache_ = nullptr;
+
   // Name (and optional variable for geometry index) under which the result of
   // the query that is executed using this context should be cached. When
   // `std::nullopt`, the result is not cached.
@@ -13,6 +13,7 @@
 
 #include "backports/StartsWithAndEndsWith.h"
 #include "backports/algorithm.h"
+#include "engine/AdaptiveQueryPlanning.h"
 #include "engine/Sort.h"
 #include "engine/StripColumns.h"
 #include "global/RuntimeParameters.h"
@@ -88,6 +89,11 @@ size_t QueryExecutionTree::getCostEstimate() {
           &RuntimeParameters::zeroCostEstimateForCachedSubtree_>()) {
     return 0;
   }
+  // The same holds for misestimated results that were computed during adaptive
+  // query planning, so that the new plan reuses them.
+  if (hasMisestimatedCachedResult()) {
+    return 0;
+  }
 
   // Otherwise, we return the cost estimate of the root operation. For index
   // scans, we assume one unit of work per result row.
@@ -106,10 +112,28 @@ size_t QueryExecutionTree::getSizeEstimate() {
     // planning, because the query planner compared exact sizes with estimates,
     // which lead to worse plans than just conistently choosing the estimate.
     sizeEstimate_ = rootOperation_->getSizeEstimate();
+    // Exceptions are results that are off by more than the
+    // `adaptive-reoptimization-factor`. Adaptive query planning computes these
+    // exactly to correct the estimate (see `AdaptiveQueryPlanning.h`).
+    if (hasMisestimatedCachedResult()) {
+      sizeEstimate_ = cachedResult_->idTable().numRows();
+    }
   }
   return sizeEstimate_.value();
 }
 
+// _____________________________________________________________________________
+bool QueryExecutionTree::hasMisestimatedCachedResult() const {
+  if (!cachedResult_) {
+    return false;
+  }
+  AD_CORRECTNESS_CHECK(cachedResult_->isFullyMaterialized());
+  return qlever::adaptiveQueryPlanning::isMisestimated(
+      rootOperation_->getSizeEstimate(), cachedResult_->idTable().numRows(),
+      getRuntimeParameter<
+          &RuntimeParameters::adaptiveReoptimizationFactor_>());
+}
+
 //_____________________________________________________________________________
 std::optional<std::shared_ptr<QueryExecutionTree>>
 QueryExecutionTree::getUpdatedQueryExecutionTreeWithPrefilterApplied(
@@ -161,6 +185,23 @@ void QueryExecutionTree::readFromCache() {
   }
 }
 
+// _____________________________________________________________________________
+void QueryExecutionTree::recursivelyRebind(QueryExecutionContext* qec) {
+  AD_CONTRACT_CHECK(rootOperation_);
+  AD_CONTRACT_CHECK(qec != nullptr);
+  for (auto* child : rootOperation_->getChildren()) {
+    if (child) {
+      child->recursivelyRebind(qec);
+    }
+  }
+  qec_ = qec;
+  rootOperation_->setExecutionContext(qec);
+  cacheKey_ = rootOperation_->getCacheKey();
+  sizeEstimate_ = std::nullopt;
+  cachedResult_ = nullptr;
+  readFromCache();
+}
+
 // ________________________________________________________________________________________________________________
 std::shared_ptr<QueryExecutionTree>
 QueryExecutionTree::createSortedTreeAnyPermutation(
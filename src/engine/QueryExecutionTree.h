@@ -124,12 +124,25 @@ class QueryExecutionTree {
 
   bool knownEmptyResult();
 
+  // Return true iff the result of this tree was found in the cache when the
+  // tree was created (see `readFromCache`).
+  bool isCached() const { return cachedResult_ != nullptr; }
+
   // Try to find the result for this tree in the LRU cache
   // of our qec. If found, we store a shared ptr to pin it
   // and set the size estimate correctly and the cost estimate
   // to zero. Currently multiplicities are not affected
   void readFromCache();
 
+  // Set the execution context of this tree and all its descendants to `qec`,
+  // recompute the cache keys bottom-up, and look them up in the cache again.
+  // This is required when a (cloned) tree is executed as part of a different
+  // query than the one it was planned for, or after an operation in the tree
+  // was modified in a way that changes its cache key (for example, the values
+  // of an `ExternalValues` in a `PreparedQuery`). The `qec` must refer to the
+  // same index and located triples as the original execution context.
+  void recursivelyRebind(QueryExecutionContext* qec);
+
   // recursively get all warnings from descendant operations
   std::vector<std::string> collectWarnings() const {
     return rootOperation_->collectWarnings();
@@ -267,6 +280,11 @@ class QueryExecutionTree {
     updateCacheKeyAndSizeEstimate();
   }
 
+  // Return true iff the result of this tree is cached and its size differs
+  // from the estimate of the root operation by more than the
+  // `adaptive-reoptimization-factor`.
+  bool hasMisestimatedCachedResult() const;
+
   // After any change to the limit/offset of the root operation, the cached
   // `cacheKey_` and `sizeEstimate_` must be refreshed.
   void updateCacheKeyAndSizeEstimate() {
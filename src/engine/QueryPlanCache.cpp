@@ -0,0 +1,388 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/QueryPlanCache.h"
+
+#include <charconv>
+#include <functional>
+
+#include "absl/strings/str_cat.h"
+#include "global/Constants.h"
+#include "parser/MagicServiceIriConstants.h"
+#include "parser/SparqlParser.h"
+#include "parser/sparqlParser/generated/SparqlAutomaticLexer.h"
+#include "util/Algorithm.h"
+#include "util/ParseException.h"
+#include "util/antlr/ANTLRErrorHandling.h"
+
+namespace {
+using Lexer = SparqlAutomaticLexer;
+
+// The token types of IRIs, literals, and numbers.
+bool isConstantToken(size_t type) {
+  static constexpr std::array types{Lexer::IRI_REF,
+                                    Lexer::PNAME_LN,
+                                    Lexer::STRING_LITERAL1,
+                                    Lexer::STRING_LITERAL2,
+                                    Lexer::STRING_LITERAL_LONG1,
+                                    Lexer::STRING_LITERAL_LONG2,
+                                    Lexer::INTEGER,
+                                    Lexer::DECIMAL,
+                                    Lexer::DOUBLE,
+                                    Lexer::INTEGER_POSITIVE,
+                                    Lexer::DECIMAL_POSITIVE,
+                                    Lexer::DOUBLE_POSITIVE,
+                                    Lexer::INTEGER_NEGATIVE,
+                                    Lexer::DECIMAL_NEGATIVE,
+                                    Lexer::DOUBLE_NEGATIVE};
+  return ad_utility::contains(types, type);
+}
+
+// Return true iff a constant token after a token of the given `type` and
+// `text` must not be replaced by a variable (e.g. the IRI of a `PREFIX`
+// declaration, or the argument of `LIMIT`).
+bool forbidsVariableAfter(size_t type, std::string_view text) {
+  static constexpr std::array types{
+      Lexer::PNAME_NS, Lexer::BASE,    Lexer::FROM,      Lexer::NAMED,
+      Lexer::LIMIT,    Lexer::OFFSET,  Lexer::TEXTLIMIT, Lexer::SERVICE,
+      Lexer::SILENT,   Lexer::SEPARATOR};
+  static constexpr std::array<std::string_view, 6> texts{"/", "|", "^",
+                                                         "^^", "!", "="};
+  return ad_utility::contains(types, type) || ad_utility::contains(texts, text);
+}
+
+// Return true iff a constant token before a token of the given `type` and
+// `text` must not be replaced by a variable (e.g. the IRI of a property path
+// or of a function call, or a literal with a datatype or language tag).
+bool forbidsVariableBefore(size_t type, std::string_view text) {
+  static constexpr std::array<std::string_view, 7> texts{"/", "|", "*", "+",
+                                                         "?", "(", "^^"};
+  return type == Lexer::LANGTAG || ad_utility::contains(texts, text);
+}
+
+// Return true iff the subject and object of triples with the given
+// `predicate` can be parameters. This excludes QLever's special predicates
+// (e.g. `ql:contains-word`) and the language-filtered predicates that the
+// parser creates for `FILTER(LANG(?x) = "en")`.
+bool isRegularPredicate(std::string_view predicate) {
+  return !predicate.starts_with('@') &&
+         !predicate.starts_with(
+             QLEVER_INTERNAL_PREFIX_IRI_WITHOUT_CLOSING_BRACKET) &&
+         !predicate.starts_with(MATERIALIZED_VIEW_IRI_WITHOUT_CLOSING_BRACKET) &&
+         !predicate.starts_with(MAX_DIST_IN_METERS) &&
+         !predicate.starts_with(NEAREST_NEIGHBORS);
+}
+
+// The triples of all the basic graph patterns at the top level of the
+// `query`, in the order in which they appear.
+std::vector<const SparqlTriple*> topLevelTriples(const ParsedQuery& query) {
+  std::vector<const SparqlTriple*> result;
+  for (const auto& operation : query.children()) {
+    if (const auto* basic =
+            std::get_if<parsedQuery::BasicGraphPattern>(&operation)) {
+      for (const auto& triple : basic->_triples) {
+        result.push_back(&triple);
+      }
+    }
+  }
+  return result;
+}
+
+// If `component` is a variable created by `QueryPlanCache::parameterVariable`,
+// return its index.
+std::optional<size_t> getParameterIndex(const TripleComponent& component) {
+  if (!component.isVariable()) {
+    return std::nullopt;
+  }
+  std::string_view name = component.getVariable().name();
+  if (!name.starts_with(QLEVER_INTERNAL_VARIABLE_QUERY_PLAN_CACHE_PREFIX)) {
+    return std::nullopt;
+  }
+  name.remove_prefix(QLEVER_INTERNAL_VARIABLE_QUERY_PLAN_CACHE_PREFIX.size());
+  size_t index = 0;
+  auto [ptr, ec] =
+      std::from_chars(name.data(), name.data() + name.size(), index);
+  if (ec != std::errc{} || ptr != name.data() + name.size()) {
+    return std::nullopt;
+  }
+  return index;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::string QueryPlanCache::AbstractedQuery::skeleton() const {
+  return joinTokens([](size_t, std::string_view) { return "$"; });
+}
+
+// _____________________________________________________________________________
+std::string QueryPlanCache::AbstractedQuery::instantiate(
+    const std::vector<bool>& isParameter) const {
+  AD_CONTRACT_CHECK(isParameter.size() == candidatePositions_.size());
+  return joinTokens([&isParameter](size_t i, std::string_view token) {
+    return isParameter[i] ? parameterVariable(i).name() : std::string{token};
+  });
+}
+
+// _____________________________________________________________________________
+std::string QueryPlanCache::AbstractedQuery::joinTokens(
+    const std::function<std::string(size_t, std::string_view)>&
+        replaceCandidate) const {
+  std::string result;
+  size_t nextCandidate = 0;
+  for (size_t i = 0; i < tokens_.size(); ++i) {
+    if (i > 0) {
+      result.push_back(' ');
+    }
+    if (nextCandidate < candidatePositions_.size() &&
+        candidatePositions_[nextCandidate] == i) {
+      result.append(replaceCandidate(nextCandidate, tokens_[i]));
+      ++nextCandidate;
+    } else {
+      result.append(tokens_[i]);
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<QueryPlanCache::AbstractedQuery>
+QueryPlanCache::abstractConstants(std::string_view query) {
+  antlr4::ANTLRInputStream stream{std::string{query}};
+  Lexer lexer{&stream};
+  ad_utility::antlr_utility::ThrowingErrorListener<InvalidSparqlQueryException>
+      errorListener;
+  lexer.removeErrorListeners();
+  lexer.addErrorListener(&errorListener);
+  std::vector<std::unique_ptr<antlr4::Token>> tokens;
+  try {
+    tokens = lexer.getAllTokens();
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+
+  AbstractedQuery result;
+  result.tokens_.reserve(tokens.size());
+  bool insideValues = false;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    const auto& token = *tokens[i];
+    result.tokens_.push_back(token.getText());
+    const auto& text = result.tokens_.back();
+    size_t type = token.getType();
+    // The values of a `VALUES` clause have to stay constant.
+    if (type == Lexer::VALUES) {
+      insideValues = true;
+    } else if (insideValues && text == "}") {
+      insideValues = false;
+    }
+    if (insideValues || !isConstantToken(type)) {
+      continue;
+    }
+    if (i > 0 &&
+        forbidsVariableAfter(tokens[i - 1]->getType(), result.tokens_[i - 1])) {
+      continue;
+    }
+    if (i + 1 < tokens.size() && forbidsVariableBefore(tokens[i + 1]->getType(),
+                                                       tokens[i + 1]->getText())) {
+      continue;
+    }
+    result.candidatePositions_.push_back(i);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+Variable QueryPlanCache::parameterVariable(size_t i) {
+  return Variable{
+      absl::StrCat(QLEVER_INTERNAL_VARIABLE_QUERY_PLAN_CACHE_PREFIX, i), false};
+}
+
+// _____________________________________________________________________________
+QueryPlanCache::QueryPlanCache(size_t maxNumEntries) {
+  setMaxNumEntries(maxNumEntries);
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::setMaxNumEntries(size_t maxNumEntries) {
+  auto caches = caches_.wlock();
+  caches->reset();
+  if (maxNumEntries > 0) {
+    caches->emplace(maxNumEntries);
+  }
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::clear() {
+  auto caches = caches_.wlock();
+  if (caches->has_value()) {
+    caches->emplace(caches->value().preparedQueries_.capacity());
+  }
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const std::vector<bool>> QueryPlanCache::computeParameters(
+    const ParsedQuery& query, const AbstractedQuery& abstractedQuery,
+    const EncodedIriManager* encodedIriManager) {
+  const auto& candidates = abstractedQuery.candidatePositions_;
+  ParsedQuery allVariablesQuery;
+  try {
+    allVariablesQuery = SparqlParser::parseQuery(
+        encodedIriManager,
+        abstractedQuery.instantiate(std::vector<bool>(candidates.size(), true)));
+  } catch (const std::exception&) {
+    return nullptr;
+  }
+  // The structure of both queries is the same, except for the variables.
+  auto originalTriples = topLevelTriples(query);
+  auto variableTriples = topLevelTriples(allVariablesQuery);
+  if (originalTriples.size() != variableTriples.size()) {
+    return nullptr;
+  }
+  auto isParameter = std::make_shared<std::vector<bool>>(candidates.size());
+  for (size_t i = 0; i < originalTriples.size(); ++i) {
+    const auto& original = *originalTriples[i];
+    const auto& withVariables = *variableTriples[i];
+    auto predicate = original.getSimplePredicate();
+    if (!predicate.has_value() || !isRegularPredicate(predicate.value())) {
+      continue;
+    }
+    auto mark = [&isParameter](const TripleComponent& originalComponent,
+                               const TripleComponent& variableComponent) {
+      auto index = getParameterIndex(variableComponent);
+      if (index.has_value() && !originalComponent.isVariable() &&
+          index.value() < isParameter->size()) {
+        (*isParameter)[index.value()] = true;
+      }
+    };
+    mark(original.s_, withVariables.s_);
+    mark(original.o_, withVariables.o_);
+  }
+  if (ql::ranges::none_of(*isParameter, ql::identity{})) {
+    return nullptr;
+  }
+  return isParameter;
+}
+
+// _____________________________________________________________________________
+auto QueryPlanCache::createEntry(std::string templateString,
+                                 const EncodedIriManager* encodedIriManager)
+    -> std::shared_ptr<const Entry> {
+  ParsedQuery templateQuery;
+  try {
+    templateQuery =
+        SparqlParser::parseQuery(encodedIriManager, std::move(templateString));
+  } catch (const std::exception&) {
+    return nullptr;
+  }
+  auto triples = topLevelTriples(templateQuery);
+  std::vector<Variable> parameters;
+  std::vector<std::pair<size_t, bool>> positions;
+  for (size_t i = 0; i < triples.size(); ++i) {
+    for (bool isObject : {false, true}) {
+      const auto& component = isObject ? triples[i]->o_ : triples[i]->s_;
+      if (getParameterIndex(component).has_value()) {
+        parameters.push_back(component.getVariable());
+        positions.emplace_back(i, isObject);
+      }
+    }
+  }
+  auto entry = std::make_shared<Entry>();
+  entry->numTopLevelTriples_ = triples.size();
+  entry->parameterPositions_ = std::move(positions);
+  try {
+    entry->preparedQuery_ = std::make_shared<PreparedQuery>(
+        std::move(templateQuery), std::move(parameters));
+  } catch (const std::exception&) {
+    return nullptr;
+  }
+  return entry;
+}
+
+// _____________________________________________________________________________
+auto QueryPlanCache::getPreparedQuery(
+    const ParsedQuery& query, const EncodedIriManager* encodedIriManager)
+    -> std::optional<PreparedQueryAndValues> {
+  if (!caches_.rlock()->has_value() || query.hasUpdateClause()) {
+    return std::nullopt;
+  }
+  auto abstractedQuery = abstractConstants(query._originalString);
+  if (!abstractedQuery.has_value() ||
+      abstractedQuery->candidatePositions_.empty()) {
+    ++numUncacheable_;
+    return std::nullopt;
+  }
+
+  // Find out which of the candidates are parameters. The (expensive)
+  // computations are done without holding the lock.
+  auto skeleton = abstractedQuery->skeleton();
+  std::optional<std::shared_ptr<const std::vector<bool>>> isParameter;
+  {
+    auto caches = caches_.wlock();
+    if (caches->has_value()) {
+      auto cached = caches->value().parametersPerSkeleton_.tryGet(skeleton);
+      if (cached.has_value()) {
+        isParameter = cached.value();
+      }
+    }
+  }
+  if (!isParameter.has_value()) {
+    isParameter =
+        computeParameters(query, abstractedQuery.value(), encodedIriManager);
+    auto caches = caches_.wlock();
+    if (caches->has_value()) {
+      caches->value().parametersPerSkeleton_.insert(skeleton,
+                                                    isParameter.value());
+    }
+  }
+  if (isParameter.value() == nullptr) {
+    ++numUncacheable_;
+    return std::nullopt;
+  }
+
+  // Get or create the `PreparedQuery`.
+  auto templateString = abstractedQuery->instantiate(*isParameter.value());
+  std::shared_ptr<const Entry> entry;
+  {
+    auto caches = caches_.wlock();
+    if (caches->has_value()) {
+      auto cached = caches->value().preparedQueries_.tryGet(templateString);
+      if (cached.has_value()) {
+        entry = cached.value();
+      }
+    }
+  }
+  if (entry != nullptr) {
+    ++numHits_;
+  } else {
+    ++numMisses_;
+    entry = createEntry(templateString, encodedIriManager);
+    if (entry == nullptr) {
+      ++numUncacheable_;
+      return std::nullopt;
+    }
+    auto caches = caches_.wlock();
+    if (caches->has_value()) {
+      caches->value().preparedQueries_.insert(std::move(templateString), entry);
+    }
+  }
+
+  // Extract the values of the parameters from the `query`.
+  auto triples = topLevelTriples(query);
+  if (triples.size() != entry->numTopLevelTriples_) {
+    ++numUncacheable_;
+    return std::nullopt;
+  }
+  std::vector<TripleComponent> values;
+  values.reserve(entry->parameterPositions_.size());
+  for (const auto& [tripleIndex, isObject] : entry->parameterPositions_) {
+    const auto& triple = *triples.at(tripleIndex);
+    const auto& value = isObject ? triple.o_ : triple.s_;
+    if (value.isVariable() || value.isUndef()) {
+      ++numUncacheable_;
+      return std::nullopt;
+    }
+    values.push_back(value);
+  }
+  return PreparedQueryAndValues{entry->preparedQuery_, std::move(values)};
+}
@@ -0,0 +1,150 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
+#define QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/PreparedQuery.h"
+#include "index/EncodedIriManager.h"
+#include "util/LruCache.h"
+#include "util/Synchronized.h"
+
+// A cache for the plans of queries that only differ in the constants (IRIs and
+// literals) in the subject and object positions of the triples in the query
+// body. Typical examples are queries generated by applications from a fixed
+// template, e.g. "all properties of entity <x>" for varying `<x>`.
+//
+// The constants of a query are found lexically: every IRI or literal token in
+// a position where a variable would be syntactically valid as well is a
+// candidate. When a query with a new sequence of tokens modulo the candidates
+// (the "skeleton") is seen, it is parsed once with all candidates replaced by
+// variables. The candidates that end up in the subject or object of a triple
+// of the top-level basic graph pattern (with a simple, non-magic predicate)
+// become the parameters of a `PreparedQuery`. All other candidates (e.g. in
+// `FILTER`s, `BIND`s, or subqueries) keep their original value, so queries
+// that differ in those get different `PreparedQuery`s. Queries for which this
+// does not work (e.g. because the query with the variables cannot be parsed)
+// are simply not cached.
+//
+// NOTE: The cached plans are generic plans, see the note in `PreparedQuery.h`.
+class QueryPlanCache {
+ public:
+  // The tokens of a query and the positions of the candidates (see above).
+  struct AbstractedQuery {
+    std::vector<std::string> tokens_;
+    std::vector<size_t> candidatePositions_;
+
+    // The tokens separated by spaces, with all candidates replaced by `$`
+    // (which can never be a token on its own).
+    std::string skeleton() const;
+
+    // The tokens separated by spaces, where the `i`-th candidate is replaced by
+    // `parameterVariable(i)` iff `isParameter[i]` is true.
+    std::string instantiate(const std::vector<bool>& isParameter) const;
+
+   private:
+    // The tokens separated by spaces, where the `i`-th candidate `token` is
+    // replaced by `replaceCandidate(i, token)`.
+    std::string joinTokens(
+        const std::function<std::string(size_t, std::string_view)>&
+            replaceCandidate) const;
+  };
+
+  // Return the `AbstractedQuery` for the given `query` or `std::nullopt` if the
+  // query cannot be tokenized.
+  static std::optional<AbstractedQuery> abstractConstants(
+      std::string_view query);
+
+  // The variable that replaces the `i`-th candidate of a query.
+  static Variable parameterVariable(size_t i);
+
+  // A `PreparedQuery` together with the values of its parameters for a
+  // particular query.
+  struct PreparedQueryAndValues {
+    std::shared_ptr<PreparedQuery> preparedQuery_;
+    std::vector<TripleComponent> values_;
+  };
+
+  // Statistics for the `cache-stats` command.
+  struct Stats {
+    size_t numHits_ = 0;
+    size_t numMisses_ = 0;
+    size_t numUncacheable_ = 0;
+  };
+
+ private:
+  // For each skeleton, the `isParameter` argument for
+  // `AbstractedQuery::instantiate`, or `nullptr` if queries with this skeleton
+  // cannot be cached.
+  using ParametersPerSkeleton =
+      ad_utility::util::LRUCache<std::string,
+                                 std::shared_ptr<const std::vector<bool>>>;
+  // A `PreparedQuery` together with the position of each of its parameters in
+  // the triples of the top-level basic graph patterns (the index of the
+  // triple, and whether it is the object or the subject).
+  struct Entry {
+    std::shared_ptr<PreparedQuery> preparedQuery_;
+    std::vector<std::pair<size_t, bool>> parameterPositions_;
+    size_t numTopLevelTriples_;
+  };
+  // The entries by the string the `PreparedQuery` was parsed from.
+  using PreparedQueries =
+      ad_utility::util::LRUCache<std::string, std::shared_ptr<const Entry>>;
+  struct Caches {
+    ParametersPerSkeleton parametersPerSkeleton_;
+    PreparedQueries preparedQueries_;
+    explicit Caches(size_t maxNumEntries)
+        : parametersPerSkeleton_{maxNumEntries},
+          preparedQueries_{maxNumEntries} {}
+  };
+  // `std::nullopt` if the cache is disabled (maximal number of entries 0).
+  ad_utility::Synchronized<std::optional<Caches>> caches_;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+  std::atomic<size_t> numUncacheable_ = 0;
+
+  // Compute the value for `ParametersPerSkeleton` for the given `query`.
+  static std::shared_ptr<const std::vector<bool>> computeParameters(
+      const ParsedQuery& query, const AbstractedQuery& abstractedQuery,
+      const EncodedIriManager* encodedIriManager);
+
+  // Create the entry for the given `templateString`, which is the result of
+  // `AbstractedQuery::instantiate`.
+  static std::shared_ptr<const Entry> createEntry(
+      std::string templateString, const EncodedIriManager* encodedIriManager);
+
+ public:
+  // Create a cache with the given maximal number of entries (per kind of
+  // entry). A value of zero disables the cache.
+  explicit QueryPlanCache(size_t maxNumEntries);
+
+  // Change the maximal number of entries. This clears the cache.
+  void setMaxNumEntries(size_t maxNumEntries);
+
+  // Remove all entries.
+  void clear();
+
+  // If the plan of the given `query` can be cached as described above, return
+  // the corresponding `PreparedQuery` (which is created and cached on a miss)
+  // and the values of its parameters for `query`. Otherwise, or if the cache
+  // is disabled, return `std::nullopt`. The `query` must have been parsed
+  // without datasets from the SPARQL protocol.
+  std::optional<PreparedQueryAndValues> getPreparedQuery(
+      const ParsedQuery& query, const EncodedIriManager* encodedIriManager);
+
+  Stats stats() const {
+    return {numHits_.load(), numMisses_.load(), numUncacheable_.load()};
+  }
+};
+
+#endif  // QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
@@ -30,12 +30,14 @@
 #include "engine/Filter.h"
 #include "engine/GroupBy.h"
 #include "engine/HasPredicateScan.h"
+#include "engine/HashJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/Load.h"
 #include "engine/MaterializedViews.h"
 #include "engine/Minus.h"
 #include "engine/MultiColumnJoin.h"
+#include "engine/MultiwayJoin.h"
 #include "engine/NamedResultCache.h"
 #include "engine/NeutralElementOperation.h"
 #include "engine/NeutralOptional.h"
@@ -2337,6 +2339,12 @@ std::vector<SubtreePlan> QueryPlanner::createJoinCandidates(
   mergeSubtreePlanIds(plan, a, b);
   candidates.push_back(std::move(plan));
 
+  // If at least one of the inputs would have to be sorted for the `Join`, a
+  // `HashJoin` might be cheaper. The cost estimates decide which one is used.
+  if (auto opt = createHashJoin(a, b, jcs)) {
+    candidates.push_back(std::move(opt.value()));
+  }
+
   return candidates;
 }
 
@@ -2645,6 +2653,128 @@ auto QueryPlanner::createMaterializedViewJoinReplacements(
   return plans;
 }
 
+// _____________________________________________________________________________
+void QueryPlanner::addMultiwayJoinReplacements(
+    const TripleGraph& tg, ReplacementPlans& replacementPlans) const {
+  if (!getRuntimeParameter<&RuntimeParameters::multiwayJoinEnabled_>() ||
+      _qec == nullptr || activeGraphVariable_.has_value()) {
+    return;
+  }
+
+  // The triples with an ordinary IRI as the predicate and two distinct
+  // variables as the subject and the object. These are the edges of a graph,
+  // the vertices of which are the variables.
+  struct Edge {
+    size_t nodeId_;
+    SparqlTripleSimple triple_;
+  };
+  std::vector<Edge> edges;
+  for (size_t i = 0; i < tg._nodeMap.size(); ++i) {
+    const TripleGraph::Node& node = *tg._nodeMap.find(i)->second;
+    auto predicate = node.triple_.getSimplePredicate();
+    if (node.isTextNode() || !predicate.has_value() ||
+        predicate.value() == HAS_PREDICATE_PREDICATE ||
+        ql::starts_with(predicate.value(), MAX_DIST_IN_METERS) ||
+        ql::starts_with(predicate.value(), NEAREST_NEIGHBORS) ||
+        ql::starts_with(predicate.value(),
+                        MATERIALIZED_VIEW_IRI_WITHOUT_CLOSING_BRACKET)) {
+      continue;
+    }
+    auto triple = node.triple_.getSimple();
+    if (triple.s_.isVariable() && triple.o_.isVariable() &&
+        triple.s_ != triple.o_) {
+      edges.push_back({i, std::move(triple)});
+    }
+  }
+
+  // Repeatedly remove the edges with a variable that is not contained in any
+  // other edge. The remaining edges lie on a cycle (or on a path between two
+  // cycles), for these the intermediate results of binary joins can be much
+  // larger than the final result.
+  ad_utility::HashMap<Variable, size_t> degree;
+  for (const auto& edge : edges) {
+    ++degree[edge.triple_.s_.getVariable()];
+    ++degree[edge.triple_.o_.getVariable()];
+  }
+  std::vector<bool> isRemoved(edges.size(), false);
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (size_t i = 0; i < edges.size(); ++i) {
+      auto& s = degree[edges[i].triple_.s_.getVariable()];
+      auto& o = degree[edges[i].triple_.o_.getVariable()];
+      if (!isRemoved[i] && (s == 1 || o == 1)) {
+        isRemoved[i] = true;
+        --s;
+        --o;
+        changed = true;
+      }
+    }
+  }
+
+  // Create one `MultiwayJoin` for each connected component of the remaining
+  // edges that has at least three variables (cycles of length two, i.e. two
+  // triples with the same variables, are handled well by a
+  // `MultiColumnJoin`).
+  for (size_t start = 0; start < edges.size(); ++start) {
+    if (isRemoved[start]) {
+      continue;
+    }
+    std::vector<size_t> component{start};
+    isRemoved[start] = true;
+    ad_utility::HashSet<Variable> variables;
+    for (size_t k = 0; k < component.size(); ++k) {
+      const auto& triple = edges[component[k]].triple_;
+      variables.insert(triple.s_.getVariable());
+      variables.insert(triple.o_.getVariable());
+      for (size_t i = 0; i < edges.size(); ++i) {
+        const auto& other = edges[i].triple_;
+        if (!isRemoved[i] && (variables.contains(other.s_.getVariable()) ||
+                              variables.contains(other.o_.getVariable()))) {
+          isRemoved[i] = true;
+          component.push_back(i);
+        }
+      }
+    }
+    if (variables.size() < 3) {
+      continue;
+    }
+
+    // Scan each triple from the permutation that is sorted by its variables
+    // in the order in which the `MultiwayJoin` binds them.
+    std::vector<std::vector<Variable>> variablesPerTriple;
+    for (size_t i : component) {
+      const auto& triple = edges[i].triple_;
+      variablesPerTriple.push_back(
+          {triple.s_.getVariable(), triple.o_.getVariable()});
+    }
+    auto order = MultiwayJoin::computeVariableOrder(variablesPerTriple);
+    auto position = [&order](const TripleComponent& variable) {
+      return ql::ranges::find(order, variable.getVariable()) - order.begin();
+    };
+    MultiwayJoin::Children children;
+    uint64_t idsOfIncludedNodes = 0;
+    for (size_t i : component) {
+      const auto& triple = edges[i].triple_;
+      auto permutation = position(triple.s_) < position(triple.o_)
+                             ? Permutation::Enum::PSO
+                             : Permutation::Enum::POS;
+      children.push_back(makeExecutionTree<IndexScan>(
+          _qec,
+          qlever::getPermutationForTriple(permutation, _qec->getIndex(),
+                                          triple),
+          _qec->locatedTriplesSharedState(), triple, getActiveGraphs()));
+      idsOfIncludedNodes |= uint64_t(1) << edges[i].nodeId_;
+    }
+    auto plan = makeSubtreePlan<MultiwayJoin>(_qec, std::move(children),
+                                              std::move(order));
+    plan._idsOfIncludedNodes = idsOfIncludedNodes;
+    for (size_t i = replacementPlans.size(); i < component.size(); ++i) {
+      replacementPlans.emplace_back();
+    }
+    replacementPlans.at(component.size() - 1).push_back(std::move(plan));
+  }
+}
+
 // ______________________________________________________________________________________
 auto QueryPlanner::createJoinWithHasPredicateScan(
     const SubtreePlan& a, const SubtreePlan& b,
@@ -2683,6 +2813,29 @@ auto QueryPlanner::createJoinWithHasPredicateScan(
   return plan;
 }
 
+// _____________________________________________________________________________
+auto QueryPlanner::createHashJoin(const SubtreePlan& a, const SubtreePlan& b,
+                                  const JoinColumns& jcs)
+    -> std::optional<SubtreePlan> {
+  AD_CORRECTNESS_CHECK(jcs.size() == 1);
+  if (!getRuntimeParameter<&RuntimeParameters::hashJoinEnabled_>()) {
+    return std::nullopt;
+  }
+  auto isSortedOnJoinColumn = [](const SubtreePlan& plan, ColumnIndex col) {
+    return plan._qet->getRootOperation()->isSortedBy({col});
+  };
+  if (isSortedOnJoinColumn(a, jcs[0][0]) &&
+      isSortedOnJoinColumn(b, jcs[0][1])) {
+    // The `Join` doesn't need any sorting, so it is always at least as cheap.
+    return std::nullopt;
+  }
+  auto qec = a._qet->getRootOperation()->getExecutionContext();
+  auto plan =
+      makeSubtreePlan<HashJoin>(qec, a._qet, b._qet, jcs[0][0], jcs[0][1]);
+  mergeSubtreePlanIds(plan, a, b);
+  return plan;
+}
+
 // _____________________________________________________________________
 auto QueryPlanner::createJoinWithPathSearch(
     const SubtreePlan& a, const SubtreePlan& b,
@@ -3443,6 +3596,7 @@ void QueryPlanner::GraphPatternPlanner::optimizeCommutatively() {
   auto replacementPlans =
       planner_.createMaterializedViewJoinReplacements(candidateTriples_);
   auto tg = planner_.createTripleGraph(&candidateTriples_);
+  planner_.addMultiwayJoinReplacements(tg, replacementPlans);
   auto lastRow =
       planner_
           .fillDpTab(tg, rootPattern_->_filters, rootPattern_->textLimits_,
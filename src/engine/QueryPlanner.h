@@ -428,6 +428,14 @@ class QueryPlanner {
   static std::optional<SubtreePlan> createJoinWithHasPredicateScan(
       const SubtreePlan& a, const SubtreePlan& b, const JoinColumns& jcs);
 
+  // Used internally by `createJoinCandidates`. Return a `HashJoin` of `a` and
+  // `b` on the single join column in `jcs` if the hash join is enabled via the
+  // runtime parameter `hash-join-enabled` and at least one of the inputs is
+  // not sorted on the join column. Else return `std::nullopt`.
+  static std::optional<SubtreePlan> createHashJoin(const SubtreePlan& a,
+                                                   const SubtreePlan& b,
+                                                   const JoinColumns& jcs);
+
   static std::optional<SubtreePlan> createJoinWithPathSearch(
       const SubtreePlan& a, const SubtreePlan& b, const JoinColumns& jcs);
 
@@ -457,6 +465,15 @@ class QueryPlanner {
   ReplacementPlans createMaterializedViewJoinReplacements(
       const parsedQuery::BasicGraphPattern& triples) const;
 
+  // Helper that generates `MultiwayJoin` query plans for the cyclic parts of
+  // the triple graph `tg` (e.g. the triples of a triangle) if the runtime
+  // parameter `multiway-join-enabled` is set. The plans are added to the
+  // `replacementPlans` (see above) in the round that corresponds to the number
+  // of triples they cover, s.t. the planner can choose between them and the
+  // usual trees of binary joins based on the cost estimates.
+  void addMultiwayJoinReplacements(const TripleGraph& tg,
+                                   ReplacementPlans& replacementPlans) const;
+
   vector<SubtreePlan> getOrderByRow(
       const ParsedQuery& pq,
       const std::vector<std::vector<SubtreePlan>>& dpTab) const;
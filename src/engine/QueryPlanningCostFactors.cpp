@@ -22,6 +22,9 @@ QueryPlanningCostFactors::QueryPlanningCostFactors() : _factors() {
   _factors["HASH_MAP_OPERATION_COST"] = 50.0;
   _factors["JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"] = 0.7;
   _factors["DUMMY_JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"] = 0.7;
+  // Inserting a row into the hash table of a `HashJoin` is more expensive than
+  // looking it up.
+  _factors["HASH_JOIN_BUILD_COST"] = 3.0;
 
   // Assume that a random disk seek is 100 times more expensive than an
   // average `O(1)` access to a single ID.
@@ -223,6 +223,13 @@ void to_json(nlohmann::ordered_json& j,
              const RuntimeInformationWholeQuery& rti) {
   j = nlohmann::ordered_json{
       {"time_query_planning", rti.timeQueryPlanning.count()}};
+  if (rti.memoryBudget != nullptr) {
+    j["memory_peak"] = rti.memoryBudget->peakMemoryUsage().asString();
+    if (auto limit = rti.memoryBudget->limit();
+        limit != ad_utility::MemorySize::max()) {
+      j["memory_limit"] = limit.asString();
+    }
+  }
 }
 
 // __________________________________________________________________________
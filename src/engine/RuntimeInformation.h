@@ -7,11 +7,13 @@
 #ifndef QLEVER_SRC_ENGINE_RUNTIMEINFORMATION_H
 #define QLEVER_SRC_ENGINE_RUNTIMEINFORMATION_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "engine/VariableToColumnMap.h"
 #include "parser/data/LimitOffsetClause.h"
+#include "util/AllocatorWithLimit.h"
 #include "util/ConcurrentCache.h"
 #include "util/json.h"
 
@@ -154,6 +156,9 @@ struct RuntimeInformationWholeQuery {
   // The time spent during query planning (this does not include the time spent
   // on `IndexScan`s that were executed during the query planning).
   std::chrono::milliseconds timeQueryPlanning = RuntimeInformation::ZERO;
+  // The memory budget of the query (see `Qlever::createQueryExecutionContext`).
+  // Its peak usage and limit are read when the JSON is created.
+  std::shared_ptr<const ad_utility::detail::AllocationMemoryLeft> memoryBudget;
   /// Output as json. The signature of this function is mandated by the json
   /// library to allow for implicit conversion.
   friend void to_json(nlohmann::ordered_json& j,
@@ -9,15 +9,18 @@
 
 #include "engine/Server.h"
 
+#include <absl/cleanup/cleanup.h>
 #include <absl/functional/bind_front.h>
 #include <absl/strings/str_cat.h>
 #include <absl/strings/str_join.h>
 
+#include <boost/core/demangle.hpp>
 #include <string>
 #include <variant>
 #include <vector>
 
 #include "CompilationInfo.h"
+#include "engine/AdaptiveQueryPlanning.h"
 #include "engine/ExecuteUpdate.h"
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/GraphStoreProtocol.h"
@@ -36,6 +39,7 @@
 #include "util/Exception.h"
 #include "util/FilesystemHelpers.h"
 #include "util/MemorySize/MemorySize.h"
+#include "util/Metrics.h"
 #include "util/ParseableDuration.h"
 #include "util/QueryEventLog.h"
 #include "util/TimeTracer.h"
@@ -287,12 +291,17 @@ auto Server::prepareOperation(
   auto sharedMessageSender =
       std::make_shared<ad_utility::websocket::MessageSender>(
           std::move(messageSender));
+  auto queryId = sharedMessageSender->getQueryId();
   auto qec = qlever().createQueryExecutionContext(
       std::move(indexAndViews),
       [sharedMessageSender = std::move(sharedMessageSender)](std::string json) {
         (*sharedMessageSender)(std::move(json));
       },
-      pinSubtrees, pinResult);
+      pinSubtrees, pinResult,
+      QueryExecutionContext::DisableCaching::FromRuntimeParameter,
+      determineQueryMemoryLimit(params, accessTokenOk));
+  queryRegistry_.setMemoryBudget(queryId,
+                                 qec->getAllocator().getMemoryLeft().ptr());
   configurePinnedResultWithName(pinResultWithName, pinNamedGeoIndex,
                                 accessTokenOk, *qec);
   return std::make_tuple(std::move(qec), std::move(cancellationHandle),
@@ -400,6 +409,9 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     requireValidAccessToken("clear-cache-complete");
     logCommand(cmd, "clear cache completely (including unpinned elements)");
     cache().clearAll();
+    if (auto* diskResultCache = qlever().diskResultCache()) {
+      diskResultCache->clear();
+    }
     response = createJsonResponse(composeCacheStatsJson(), request);
   } else if (auto cmd = checkParameter("cmd", "clear-named-cache")) {
     requireValidAccessToken("clear-named-cache");
@@ -459,6 +471,33 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         handle);
     auto vacuumStats = co_await std::move(coroutine);
     response = createJsonResponse(vacuumStats, request);
+  } else if (auto cmd = checkParameter("cmd", "prepare-query")) {
+    requireValidAccessToken("prepare-query");
+    logCommand(cmd, "prepare a query");
+    auto name = checkParameter("prepared-query-name", std::nullopt);
+    auto queryString = checkParameter("prepared-query", std::nullopt);
+    if (!name.has_value() || !queryString.has_value()) {
+      throw std::runtime_error(
+          "The command \"prepare-query\" requires the parameters "
+          "\"prepared-query-name\" and \"prepared-query\"");
+    }
+    std::vector<std::string> parameterNames;
+    if (auto it = parameters.find("parameter"); it != parameters.end()) {
+      parameterNames = it->second;
+    }
+    auto preparedQuery = std::make_shared<PreparedQuery>(
+        SparqlParser::parseQuery(&index.encodedIriManager(),
+                                 std::string{queryString.value()}),
+        PreparedQuery::parseParameterNames(parameterNames));
+    json result;
+    result["name"] = name.value();
+    result["parameters"] = json::array();
+    for (const auto& parameter : preparedQuery->parameters()) {
+      result["parameters"].push_back(parameter.name());
+    }
+    (*preparedQueries_.wlock())[std::string{name.value()}] =
+        std::move(preparedQuery);
+    response = createJsonResponse(result, request);
   } else if (auto cmd = checkParameter("cmd", "get-settings")) {
     logCommand(cmd, "get server settings");
     response = createJsonResponse(
@@ -558,6 +597,46 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     // Construct simple response JSON.
     nlohmann::json json{{"materialized-view-loaded", name.value()}};
     response = createJsonResponse(json, request);
+  } else if (auto cmd = checkParameter("cmd", "build-reachability-index")) {
+    requireValidAccessToken("build-reachability-index");
+    logCommand(cmd, "build reachability index");
+
+    // Extract the predicate, which must be a full IRI in angle brackets.
+    auto predicate = ad_utility::url_parser::getParameterCheckAtMostOnce(
+        parameters, "predicate");
+    if (!predicate.has_value()) {
+      throw std::runtime_error(
+          "Building a reachability index requires the IRI of a predicate via "
+          "the 'predicate' parameter");
+    }
+
+    // Building the index reads all the triples of the predicate, so it is
+    // done in a thread of the query thread pool. The index is immediately used
+    // by all subsequent queries.
+    auto cancellationHandle =
+        std::make_shared<ad_utility::CancellationHandle<>>();
+    auto coroutine = computeInNewThread(
+        queryThreadPool_,
+        [predicate, indexAndViews] {
+          return indexAndViews->index_.getImpl().buildReachabilityIndex(
+              predicate.value());
+        },
+        cancellationHandle);
+    auto reachabilityIndex = co_await std::move(coroutine);
+
+    // Construct simple response JSON.
+    nlohmann::json json{
+        {"reachability-index-built", predicate.value()},
+        {"num-nodes", reachabilityIndex->numNodes()},
+        {"num-edges", reachabilityIndex->numEdges()},
+        {"num-intervals", reachabilityIndex->numIntervals()}};
+    response = createJsonResponse(json, request);
+  }
+
+  // Metrics for monitoring (e.g. by Prometheus).
+  if (parsedHttpRequest.path_ == "/metrics") {
+    response =
+        createOkResponse(composeMetrics(), request, MediaType::textPlain);
   }
 
   // Ping with or without message.
@@ -603,13 +682,46 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     }
   }
 
+  // Execute a prepared query (see `cmd=prepare-query` above) with the values
+  // for its parameters given as `bind-<parameter>=<value>`.
+  std::optional<QueryPlanCache::PreparedQueryAndValues> preparedExecution;
+  if (auto name = checkParameter("execute-prepared-query", std::nullopt)) {
+    if (!std::holds_alternative<None>(parsedHttpRequest.operation_)) {
+      throw std::runtime_error(
+          "\"execute-prepared-query\" cannot be combined with a SPARQL "
+          "operation in the same request");
+    }
+    auto preparedQuery = [this, &name]() {
+      auto preparedQueries = preparedQueries_.rlock();
+      auto it = preparedQueries->find(name.value());
+      if (it == preparedQueries->end()) {
+        throw std::runtime_error(absl::StrCat(
+            "There is no prepared query with name \"", name.value(), "\""));
+      }
+      return it->second;
+    }();
+    PreparedQuery::ParameterValues values;
+    static constexpr std::string_view bindPrefix = "bind-";
+    for (const auto& [key, valuesForKey] : parameters) {
+      if (key.starts_with(bindPrefix)) {
+        for (const auto& value : valuesForKey) {
+          values.emplace_back(key.substr(bindPrefix.size()), value);
+        }
+      }
+    }
+    auto parsedValues = preparedQuery->parseValues(values);
+    parsedHttpRequest.operation_ = Query{preparedQuery->originalString(), {}};
+    preparedExecution = QueryPlanCache::PreparedQueryAndValues{
+        std::move(preparedQuery), std::move(parsedValues)};
+  }
+
   // Store the QueryExecutionTree outside the lambda, s.t. we have access in
   // case of errors to create an informative error message that includes the
   // runtime information.
   std::optional<PlannedQuery> plannedQuery;
   auto visitOperation =
       [&checkParameter, &accessTokenOk, &request, &send, &parameters,
-       &requestTimer, &plannedQuery, &indexAndViews, this](
+       &requestTimer, &plannedQuery, &indexAndViews, &preparedExecution, this](
           std::vector<ParsedQuery> operations, std::string operationName,
           const std::string operationString,
           std::function<bool(const ParsedQuery&)> expectedOperation,
@@ -640,7 +752,10 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         throw std::runtime_error(absl::StrCat(
             msg, ad_utility::truncateOperationString(operationString)));
       }
+      // The type of the operation for the `/metrics` endpoint.
+      std::string_view operationType = "select";
       if (ql::ranges::all_of(operations, &ParsedQuery::hasUpdateClause)) {
+        operationType = "update";
         co_await processUpdate(indexAndViews, std::move(operations),
                                requestTimer, tracer, cancellationHandle, qec,
                                std::move(request), send, timeLimit.value(),
@@ -650,11 +765,23 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         ParsedQuery query = std::move(operations[0]);
         AD_CORRECTNESS_CHECK(query.hasSelectClause() || query.hasAskClause() ||
                              query.hasConstructClause());
+        if (query.hasAskClause()) {
+          operationType = "ask";
+        } else if (query.hasConstructClause()) {
+          operationType = "construct";
+        }
         co_await processQuery(parameters, std::move(query), requestTimer,
                               cancellationHandle, qec, std::move(request), send,
-                              timeLimit.value(), plannedQuery);
+                              timeLimit.value(), plannedQuery, indexAndViews,
+                              std::move(preparedExecution));
       }
       queryStatus->store(OK);
+      ad_utility::metrics::globalMetrics()
+          .queryDuration_.get(operationType)
+          .observe(requestTimer.value());
+      if (plannedQuery.has_value()) {
+        recordOperationMetrics(plannedQuery->queryExecutionTree());
+      }
       co_return;
     } catch (const ad_utility::CancellationException& e) {
       queryStatus->store(e.state() == ad_utility::CancellationState::TIMEOUT
@@ -663,11 +790,15 @@ CPP_template_def(typename RequestT, typename ResponseT)(
       throw;
     }
   };
-  auto visitQuery = [&index, &visitOperation](Query query) -> Awaitable<void> {
+  auto visitQuery = [&index, &visitOperation,
+                     &preparedExecution](Query query) -> Awaitable<void> {
     // We need to copy the query string because `visitOperation` below also
-    // needs it.
-    auto parsedQuery = SparqlParser::parseQuery(
-        &index.encodedIriManager(), query.query_, query.datasetClauses_);
+    // needs it. A prepared query has already been parsed.
+    auto parsedQuery =
+        preparedExecution.has_value()
+            ? preparedExecution->preparedQuery_->parsedQuery()
+            : SparqlParser::parseQuery(&index.encodedIriManager(),
+                                       query.query_, query.datasetClauses_);
     auto dummy = std::make_shared<ad_utility::timer::TimeTracer>("dummy");
     return visitOperation(
         {std::move(parsedQuery)}, "SPARQL query", std::move(query.query_),
@@ -758,33 +889,132 @@ std::pair<bool, bool> Server::determineResultPinning(
   return {pinSubresults, pinResult};
 }
 
+// ____________________________________________________________________________
+std::optional<ad_utility::MemorySize> Server::determineQueryMemoryLimit(
+    const ad_utility::url_parser::ParamValueMap& params, bool accessTokenOk) {
+  auto userLimit =
+      ad_utility::url_parser::checkParameter(params, "memory-limit", {});
+  if (!userLimit.has_value()) {
+    return std::nullopt;
+  }
+  auto limit = ad_utility::MemorySize::parse(userLimit.value());
+  auto defaultLimit =
+      getRuntimeParameter<&RuntimeParameters::queryMemoryLimit_>();
+  bool exceedsDefault =
+      defaultLimit != ad_utility::MemorySize::bytes(0) &&
+      (limit == ad_utility::MemorySize::bytes(0) || limit > defaultLimit);
+  if (exceedsDefault && !accessTokenOk) {
+    throw std::runtime_error(absl::StrCat(
+        "User submitted memory limit was higher than what is currently "
+        "allowed by this instance (",
+        defaultLimit.asString(),
+        "). Please use a valid access token to override this server "
+        "configuration."));
+  }
+  return limit;
+}
+
+// ____________________________________________________________________________
+void Server::recordOperationMetrics(const QueryExecutionTree& tree) {
+  const Operation& operation = *tree.getRootOperation();
+  const auto& runtimeInfo = operation.runtimeInfo();
+  // The runtime information of a cached result (and of its children) is that
+  // of the query that computed it, which was already recorded.
+  using enum RuntimeInformation::Status;
+  if (runtimeInfo.cacheStatus_ != ad_utility::CacheStatus::computed ||
+      (runtimeInfo.status_ != fullyMaterializedCompleted &&
+       runtimeInfo.status_ != lazilyMaterializedCompleted)) {
+    return;
+  }
+  auto& statistics = ad_utility::metrics::globalMetrics().operations_.get(
+      boost::core::demangle(typeid(operation).name()));
+  statistics.numComputations_.add();
+  statistics.timeInMicroseconds_.add(static_cast<uint64_t>(
+      std::max(runtimeInfo.getOperationTime().count(), int64_t{0})));
+  statistics.numRows_.add(runtimeInfo.numRows_);
+  for (const QueryExecutionTree* child : operation.getChildren()) {
+    recordOperationMetrics(*child);
+  }
+}
+
 // ____________________________________________________________________________
 Server::PlannedQuery Server::planQuery(
     ParsedQuery&& operation, const ad_utility::Timer& requestTimer,
     TimeLimit timeLimit, QueryExecutionContext& qec,
     ad_utility::SharedCancellationHandle handle) const {
-  QueryPlanner qp(&qec, handle);
-  auto executionTree = qp.createExecutionTree(operation);
+  // With adaptive query planning, parts of the query are already computed
+  // during planning, for which the time limit starts right away.
+  std::optional<std::chrono::steady_clock::time_point> deadline;
+  auto prepareForExecution = [&handle, &timeLimit,
+                              &deadline](QueryExecutionTree& subtree) {
+    if (!deadline.has_value()) {
+      deadline = std::chrono::steady_clock::now() + timeLimit;
+    }
+    subtree.getRootOperation()->recursivelySetCancellationHandle(handle);
+    subtree.getRootOperation()->recursivelySetTimeConstraint(deadline.value());
+  };
+  const double adaptiveReoptimizationFactor =
+      getRuntimeParameter<&RuntimeParameters::adaptiveReoptimizationFactor_>();
+  // The planner may modify the query, so each new plan starts from a copy of
+  // the original query.
+  std::optional<ParsedQuery> originalOperation;
+  if (adaptiveReoptimizationFactor > 0) {
+    originalOperation = operation;
+  }
+  auto executionTree = qlever::adaptiveQueryPlanning::planAdaptively(
+      [&qec, &handle, &operation, &originalOperation]() {
+        if (originalOperation.has_value()) {
+          operation = originalOperation.value();
+        }
+        QueryPlanner qp(&qec, handle);
+        return qp.createExecutionTree(operation);
+      },
+      prepareForExecution, adaptiveReoptimizationFactor);
   PlannedQuery plannedQuery{std::move(operation), std::move(executionTree),
                             qec};
   handle->throwIfCancelled();
-  // Set some additional attributes on the `PlannedQuery`.
-  plannedQuery.queryExecutionTree()
-      .getRootOperation()
-      ->recursivelySetCancellationHandle(std::move(handle));
-  plannedQuery.queryExecutionTree()
-      .getRootOperation()
-      ->recursivelySetTimeConstraint(timeLimit);
-  auto& qet = plannedQuery.queryExecutionTree();
+  finishQueryPlanning(
+      plannedQuery.queryExecutionTree(), std::move(handle),
+      deadline.value_or(std::chrono::steady_clock::now() + timeLimit),
+      requestTimer);
+  return plannedQuery;
+}
+
+// ____________________________________________________________________________
+Server::PlannedQuery Server::planPreparedQuery(
+    QueryPlanCache::PreparedQueryAndValues preparedQuery,
+    std::string originalString, SharedIndexAndView indexAndViews,
+    const ad_utility::Timer& requestTimer, TimeLimit timeLimit,
+    QueryExecutionContext& qec, SharedCancellationHandle handle) const {
+  auto [qet, qecPtr, parsedQuery] = qlever().bindPreparedQuery(
+      *preparedQuery.preparedQuery_, std::move(preparedQuery.values_),
+      std::move(indexAndViews), qec.shared_from_this());
+  parsedQuery._originalString = std::move(originalString);
+  PlannedQuery plannedQuery{std::move(parsedQuery), std::move(*qet), qec};
+  handle->throwIfCancelled();
+  finishQueryPlanning(plannedQuery.queryExecutionTree(), std::move(handle),
+                      std::chrono::steady_clock::now() + timeLimit,
+                      requestTimer);
+  return plannedQuery;
+}
+
+// ____________________________________________________________________________
+void Server::finishQueryPlanning(QueryExecutionTree& qet,
+                                 SharedCancellationHandle handle,
+                                 std::chrono::steady_clock::time_point deadline,
+                                 const ad_utility::Timer& requestTimer) {
+  qet.getRootOperation()->recursivelySetCancellationHandle(std::move(handle));
+  qet.getRootOperation()->recursivelySetTimeConstraint(deadline);
   qet.isRoot() = true;  // allow pinning of the final result
   auto timeForQueryPlanning = requestTimer.msecs();
   auto& runtimeInfoWholeQuery =
       qet.getRootOperation()->getRuntimeInfoWholeQuery();
   runtimeInfoWholeQuery.timeQueryPlanning = timeForQueryPlanning;
+  runtimeInfoWholeQuery.memoryBudget =
+      qet.getQec()->getAllocator().getMemoryLeft().ptr();
   AD_LOG_INFO << "Query planning done in " << timeForQueryPlanning.count()
               << " ms" << std::endl;
   AD_LOG_TRACE << qet.getCacheKey() << std::endl;
-  return plannedQuery;
 }
 
 // _____________________________________________________________________________
@@ -852,9 +1082,66 @@ nlohmann::json Server::composeCacheStatsJson() const {
   // converter.
   result["cache-size-unpinned"] = cache().nonPinnedSize().getBytes();
   result["cache-size-pinned"] = cache().pinnedSize().getBytes();
+
+  auto planCacheStats = qlever().queryPlanCache().stats();
+  result["num-query-plan-cache-hits"] = planCacheStats.numHits_;
+  result["num-query-plan-cache-misses"] = planCacheStats.numMisses_;
+  result["num-query-plan-cache-uncacheable"] = planCacheStats.numUncacheable_;
+  result["num-prepared-queries"] = preparedQueries_.rlock()->size();
+
+  if (const auto* diskResultCache = qlever().diskResultCache()) {
+    auto diskCacheStats = diskResultCache->stats();
+    result["num-results-on-disk"] = diskCacheStats.numEntries_;
+    result["disk-cache-size"] = diskCacheStats.totalSize_.getBytes();
+    result["num-disk-cache-hits"] = diskCacheStats.numHits_;
+    result["num-disk-cache-misses"] = diskCacheStats.numMisses_;
+    result["num-disk-cache-writes"] = diskCacheStats.numWrites_;
+  }
   return result;
 }
 
+// _____________________________________________________________________________
+std::string Server::composeMetrics() const {
+  ad_utility::metrics::PrometheusWriter writer;
+  const auto& cache = this->cache();
+  writer.addCounter("qlever_cache_hits_total",
+                    "Lookups that found the result in the query cache.",
+                    cache.numHits());
+  writer.addCounter("qlever_cache_misses_total",
+                    "Lookups that did not find the result in the query cache.",
+                    cache.numMisses());
+  writer.addCounter("qlever_cache_evictions_total",
+                    "Results that were evicted from the query cache.",
+                    cache.numEvictions());
+  writer.addGauge("qlever_cache_entries", "Number of results in the cache.",
+                  cache.numNonPinnedEntries(), {{"pinned", "false"}});
+  writer.addGauge("qlever_cache_entries", "Number of results in the cache.",
+                  cache.numPinnedEntries(), {{"pinned", "true"}});
+  writer.addGauge("qlever_cache_size_bytes", "Total size of the cache.",
+                  cache.nonPinnedSize().getBytes(), {{"pinned", "false"}});
+  writer.addGauge("qlever_cache_size_bytes", "Total size of the cache.",
+                  cache.pinnedSize().getBytes(), {{"pinned", "true"}});
+
+  const auto& memory = *allocator().getMemoryLeft().ptr();
+  writer.addGauge("qlever_memory_used_bytes",
+                  "Memory used by all queries and the cache.",
+                  memory.amountMemoryUsed().getBytes());
+  writer.addGauge("qlever_memory_limit_bytes",
+                  "Memory limit for all queries and the cache.",
+                  memory.limit().getBytes());
+
+  auto deltaCounts = indexAndViewsSnapshot()
+                         ->index_.deltaTriplesManager()
+                         .getCurrentCounts();
+  writer.addGauge("qlever_delta_triples", "Number of delta triples.",
+                  deltaCounts.triplesInserted_, {{"type", "inserted"}});
+  writer.addGauge("qlever_delta_triples", "Number of delta triples.",
+                  deltaCounts.triplesDeleted_, {{"type", "deleted"}});
+
+  ad_utility::metrics::globalMetrics().writeTo(writer);
+  return writer.output();
+}
+
 // _____________________________________________
 CPP_template_def(typename RequestT)(
     requires ad_utility::httpUtils::HttpRequest<RequestT>)
@@ -1022,7 +1309,9 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         ParsedQuery&& query, const ad_utility::Timer& requestTimer,
         ad_utility::SharedCancellationHandle cancellationHandle,
         QueryExecutionContext& qec, const RequestT& request, ResponseT&& send,
-        TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery) {
+        TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery,
+        SharedIndexAndView indexAndViews,
+        std::optional<QueryPlanCache::PreparedQueryAndValues> preparedQuery) {
   AD_CORRECTNESS_CHECK(!query.hasUpdateClause());
 
   auto mediaTypes = determineMediaTypes(params, request);
@@ -1044,8 +1333,23 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   // an explicit variable instead of directly `co_await`-ing it.
   auto coroutine = computeInNewThread(
       queryThreadPool_,
-      [this, &query, &requestTimer, &timeLimit, &qec,
-       &cancellationHandle]() -> std::optional<PlannedQuery> {
+      [this, &query, &requestTimer, &timeLimit, &qec, &cancellationHandle,
+       &params, &indexAndViews,
+       &preparedQuery]() -> std::optional<PlannedQuery> {
+        // Use the `QueryPlanCache` unless the datasets are specified via the
+        // SPARQL protocol (they are not part of the query string).
+        if (!preparedQuery.has_value() &&
+            !params.contains("default-graph-uri") &&
+            !params.contains("named-graph-uri")) {
+          preparedQuery = qlever().queryPlanCache().getPreparedQuery(
+              query, &qec.getIndex().encodedIriManager());
+        }
+        if (preparedQuery.has_value()) {
+          return this->planPreparedQuery(
+              std::move(preparedQuery.value()),
+              std::move(query._originalString), std::move(indexAndViews),
+              requestTimer, timeLimit, qec, cancellationHandle);
+        }
         return this->planQuery(std::move(query), requestTimer, timeLimit, qec,
                                cancellationHandle);
       },
@@ -1200,64 +1504,85 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   // atomically. This is ensured, because the updates below are run on the
   // `updateThreadPool_`, which only has a single thread.
   static_assert(UPDATE_THREAD_POOL_SIZE == 1);
+  // With group commit, the updates of concurrent requests are executed as one
+  // batch, so each request has to refresh the augmented metadata before its
+  // first update with a graph pattern (the previous request of the batch
+  // might have changed the delta triples).
+  const auto groupCommitWindow =
+      getRuntimeParameter<&RuntimeParameters::updateGroupCommitWindow_>();
+  const bool useGroupCommit = groupCommitWindow.count() > 0;
+  std::function<json(DeltaTriples&)> runUpdates =
+      [this, &index, &cancellationHandle, &plannedUpdate, &updates,
+       &requestTimer, &timeLimit, &qec, &metadatas,
+       useGroupCommit](DeltaTriples& deltaTriples) {
+        qec.setLocatedTriplesForEvaluation(
+            deltaTriples.getLocatedTriplesSharedStateReference());
+        json results = json::array();
+        for (auto&& [i, update] : ranges::views::enumerate(updates)) {
+          auto tracer = ad_utility::timer::TimeTracer("update");
+          // The augmented metadata is invalidated by any update. It is
+          // only updated automatically at the end of modify. Updates with
+          // non-empty graph patterns need the augmented metadata. Update
+          // the augmented metadata before executing those updates.
+          tracer.beginTrace("updateMetadata");
+          if ((i != 0 || useGroupCommit) &&
+              !update._rootGraphPattern._graphPatterns.empty()) {
+            deltaTriples.updateAugmentedMetadata();
+          }
+          tracer.endTrace("updateMetadata");
+          tracer.beginTrace("planning");
+          plannedUpdate = planQuery(std::move(update), requestTimer, timeLimit,
+                                    qec, cancellationHandle);
+          tracer.endTrace("planning");
+          tracer.beginTrace("execution");
+          // Update the delta triples.
+          // Use `this` explicitly to silence false-positive
+          // errors on captured `this` being unused.
+          auto updateMetadata =
+              this->processUpdateImpl(index, plannedUpdate.value(),
+                                      cancellationHandle, deltaTriples, tracer);
+          tracer.endTrace("execution");
+
+          tracer.endTrace("update");
+          results.push_back(createResponseMetadataForUpdate(
+              index, *deltaTriples.getLocatedTriplesSharedStateReference(),
+              *plannedUpdate, plannedUpdate->queryExecutionTree(),
+              updateMetadata, tracer));
+          metadatas.push_back(std::move(updateMetadata));
+
+          AD_LOG_INFO << "Done processing update, total time was "
+                      << requestTimer.msecs().count() << " ms" << std::endl;
+          AD_LOG_DEBUG << "Runtime Info:\n"
+                       << plannedUpdate->queryExecutionTree()
+                              .getRootOperation()
+                              ->runtimeInfo()
+                              .toString()
+                       << std::endl;
+        }
+        return results;
+      };
+
+  // With group commit, the updates are enqueued right away, so that they can
+  // join the batch of a request that is already waiting on the
+  // `updateThreadPool_`. The batch is then executed by whichever request
+  // reaches the thread first, the others only collect their result.
+  std::optional<std::future<json>> groupCommitResult;
+  if (useGroupCommit) {
+    groupCommitResult =
+        index.deltaTriplesManager().enqueueForGroupCommit(runUpdates);
+  }
   auto coroutine = computeInNewThread(
       updateThreadPool_,
-      [this, &index, &requestTimer, &cancellationHandle, &updates, &qec,
-       &timeLimit, &plannedUpdate, outerTracer, &metadatas]() {
+      [&index, &runUpdates, &groupCommitResult, groupCommitWindow,
+       outerTracer]() {
         outerTracer->endTrace("waitingForUpdateThread");
-        return index.deltaTriplesManager().modify<json>(
-            [this, &index, &cancellationHandle, &plannedUpdate, &updates,
-             &requestTimer, &timeLimit, &qec,
-             &metadatas](DeltaTriples& deltaTriples) {
-              qec.setLocatedTriplesForEvaluation(
-                  deltaTriples.getLocatedTriplesSharedStateReference());
-              json results = json::array();
-              for (auto&& [i, update] : ranges::views::enumerate(updates)) {
-                auto tracer = ad_utility::timer::TimeTracer("update");
-                // The augmented metadata is invalidated by any update. It is
-                // only updated automatically at the end of modify. Updates with
-                // non-empty graph patterns need the augmented metadata. Update
-                // the augmented metadata before executing those updates.
-                tracer.beginTrace("updateMetadata");
-                if (i != 0 &&
-                    !update._rootGraphPattern._graphPatterns.empty()) {
-                  deltaTriples.updateAugmentedMetadata();
-                }
-                tracer.endTrace("updateMetadata");
-                tracer.beginTrace("planning");
-                plannedUpdate = planQuery(std::move(update), requestTimer,
-                                          timeLimit, qec, cancellationHandle);
-                tracer.endTrace("planning");
-                tracer.beginTrace("execution");
-                // Update the delta triples.
-                // Use `this` explicitly to silence false-positive
-                // errors on captured `this` being unused.
-                auto updateMetadata = this->processUpdateImpl(
-                    index, plannedUpdate.value(), cancellationHandle,
-                    deltaTriples, tracer);
-                tracer.endTrace("execution");
-
-                tracer.endTrace("update");
-                results.push_back(createResponseMetadataForUpdate(
-                    index,
-                    *deltaTriples.getLocatedTriplesSharedStateReference(),
-                    *plannedUpdate, plannedUpdate->queryExecutionTree(),
-                    updateMetadata, tracer));
-                metadatas.push_back(std::move(updateMetadata));
-
-                AD_LOG_INFO << "Done processing update, total time was "
-                            << requestTimer.msecs().count() << " ms"
-                            << std::endl;
-                AD_LOG_DEBUG << "Runtime Info:\n"
-                             << plannedUpdate->queryExecutionTree()
-                                    .getRootOperation()
-                                    ->runtimeInfo()
-                                    .toString()
-                             << std::endl;
-              }
-              return results;
-            },
-            true, true, *outerTracer);
+        auto& deltaTriplesManager = index.deltaTriplesManager();
+        if (groupCommitResult.has_value()) {
+          deltaTriplesManager.commitGroup(groupCommitWindow, *outerTracer);
+          return groupCommitResult->get();
+        }
+        return deltaTriplesManager.modify<json>(runUpdates, true, true,
+                                                *outerTracer);
       },
       cancellationHandle);
   auto operations = co_await std::move(coroutine);
@@ -1389,9 +1714,23 @@ CPP_template_def(typename Function,
   std::promise<std::function<void()>> cancelTimerPromise{};
   auto cancelTimerFuture = cancelTimerPromise.get_future();
 
+  // Track the number of queued and running tasks of the pool for the
+  // `/metrics` endpoint. The task stops being queued when it starts running
+  // or when it is destroyed without running (e.g. because it was cancelled).
+  auto& poolMetrics = ad_utility::metrics::globalMetrics().threadPools_.get(
+      &threadPool == &updateThreadPool_ ? "update" : "query");
+  poolMetrics.numQueuedTasks_.increment();
+  absl::Cleanup stopQueued{
+      [&poolMetrics]() { poolMetrics.numQueuedTasks_.decrement(); }};
+
   auto inner = [function = std::move(function),
-                cancelTimerFuture =
-                    std::move(cancelTimerFuture)]() mutable -> T {
+                cancelTimerFuture = std::move(cancelTimerFuture),
+                stopQueued = std::move(stopQueued),
+                &poolMetrics]() mutable -> T {
+    std::move(stopQueued).Invoke();
+    poolMetrics.numRunningTasks_.increment();
+    absl::Cleanup stopRunning{
+        [&poolMetrics]() { poolMetrics.numRunningTasks_.decrement(); }};
     // Ensure future is ready by the time this is called.
     AD_CORRECTNESS_CHECK(cancelTimerFuture.wait_for(std::chrono::milliseconds{
                              0}) == std::future_status::ready);
@@ -18,15 +18,19 @@
 #include "engine/ExecuteUpdate.h"
 #include "engine/MaterializedViews.h"
 #include "engine/NamedResultCache.h"
+#include "engine/PreparedQuery.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/QueryPlanCache.h"
 #include "engine/SortPerformanceEstimator.h"
 #include "index/IdTableUtils.h"
 #include "index/Index.h"
 #include "libqlever/Qlever.h"
 #include "util/AllocatorWithLimit.h"
+#include "util/HashMap.h"
 #include "util/MemorySize/MemorySize.h"
 #include "util/ParseException.h"
+#include "util/Synchronized.h"
 #include "util/TypeTraits.h"
 #include "util/http/HttpUtils.h"
 #include "util/http/streamable_body.h"
@@ -76,6 +80,11 @@ class Server {
   static json composeStatsJson(const Index& index);
   json composeCacheStatsJson() const;
 
+  // Get the metrics of the server (cache, memory, delta triples, thread pools,
+  // and those of `ad_utility::metrics::globalMetrics()`) in the text format of
+  // Prometheus, for the `/metrics` endpoint.
+  std::string composeMetrics() const;
+
   // Helper struct bundling a parsed query with a query execution tree.
   // As the `QueryExecutionTree` stores a raw pointer to the
   // `QueryExecutionContext`, We additionally store the context as a
@@ -118,6 +127,11 @@ class Server {
   bool noAccessCheck_;
   ad_utility::websocket::QueryRegistry queryRegistry_{};
 
+  // The prepared queries by name, see `cmd=prepare-query`.
+  ad_utility::Synchronized<
+      ad_utility::HashMap<std::string, std::shared_ptr<PreparedQuery>>>
+      preparedQueries_;
+
   /// Non-owning reference to the `QueryHub` instance living inside
   /// the `WebSocketHandler` created for `HttpServer`.
   std::weak_ptr<ad_utility::websocket::QueryHub> queryHub_;
@@ -206,7 +220,9 @@ class Server {
           ParsedQuery&& query, const ad_utility::Timer& requestTimer,
           ad_utility::SharedCancellationHandle cancellationHandle,
           QueryExecutionContext& qec, const RequestT& request, ResponseT&& send,
-          TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery);
+          TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery,
+          SharedIndexAndView indexAndViews,
+          std::optional<QueryPlanCache::PreparedQueryAndValues> preparedQuery);
   // For an executed update create a JSON with some stats on the update (timing,
   // number of changed triples, etc.).
   static nlohmann::ordered_json createResponseMetadataForUpdate(
@@ -239,6 +255,19 @@ class Server {
   static std::pair<bool, bool> determineResultPinning(
       const ad_utility::url_parser::ParamValueMap& params);
   FRIEND_TEST(ServerTest, determineResultPinning);
+  // Determine the memory limit for a single query from the `memory-limit`
+  // parameter. Return `std::nullopt` if there is no such parameter (then the
+  // `query-memory-limit` runtime parameter applies). Throw if the requested
+  // limit exceeds the runtime parameter (if that is non-zero) and there is no
+  // valid access token.
+  static std::optional<ad_utility::MemorySize> determineQueryMemoryLimit(
+      const ad_utility::url_parser::ParamValueMap& params, bool accessTokenOk);
+  FRIEND_TEST(ServerTest, determineQueryMemoryLimit);
+  // Add the computation time and the result size of each operation of the
+  // `tree` that was computed (and not read from the cache) to the global
+  // metrics, grouped by the type of the operation.
+  static void recordOperationMetrics(const QueryExecutionTree& tree);
+  FRIEND_TEST(ServerTest, recordOperationMetrics);
   //  Prepare the execution of an operation.
   auto prepareOperation(SharedIndexAndView indexAndViews,
                         std::string_view operationName,
@@ -268,6 +297,22 @@ class Server {
                          const ad_utility::Timer& requestTimer,
                          TimeLimit timeLimit, QueryExecutionContext& qec,
                          SharedCancellationHandle handle) const;
+  // Plan a query that is executed via a `PreparedQuery` (see
+  // `PreparedQuery.h`), either explicitly or via the `QueryPlanCache`. The
+  // `originalString` is the query as sent by the client (for the logs and the
+  // response metadata).
+  PlannedQuery planPreparedQuery(
+      QueryPlanCache::PreparedQueryAndValues preparedQuery,
+      std::string originalString, SharedIndexAndView indexAndViews,
+      const ad_utility::Timer& requestTimer,
+      TimeLimit timeLimit, QueryExecutionContext& qec,
+      SharedCancellationHandle handle) const;
+  // Set the cancellation `handle` and the `deadline` on the final plan `qet`,
+  // mark it as the root of the query, and record the time for the planning.
+  static void finishQueryPlanning(
+      QueryExecutionTree& qet, SharedCancellationHandle handle,
+      std::chrono::steady_clock::time_point deadline,
+      const ad_utility::Timer& requestTimer);
   // Creates a `MessageSender` for the given operation.
   CPP_template(typename RequestT)(
       requires ad_utility::httpUtils::HttpRequest<RequestT>)
@@ -22,6 +22,7 @@
 #include "util/HashMap.h"
 #include "util/HashSet.h"
 #include "util/StringUtils.h"
+#include "util/ThreadSafeQueue.h"
 #include "util/http/HttpUtils.h"
 
 namespace {
@@ -111,15 +112,36 @@ std::string Service::pushDownValues(std::string_view pattern,
 }
 
 // _____________________________________________________________________________
-std::string Service::getGraphPattern() const {
+std::string Service::getGraphPattern(
+    const std::optional<std::string>& valuesClause) const {
   // Try to simplify the Service Query using it's sibling Operation.
   const auto& graphPattern = parsedServiceClause_.graphPatternAsString_;
-  if (auto valuesClause = getSiblingValuesClause(); valuesClause.has_value()) {
+  if (valuesClause.has_value()) {
     return pushDownValues(graphPattern, valuesClause.value());
   }
   return graphPattern;
 }
 
+// _____________________________________________________________________________
+std::string Service::getServiceQuery(std::string_view graphPattern) const {
+  const auto& variables = parsedServiceClause_.visibleVariables_;
+  std::string variablesForSelectClause =
+      variables.empty()
+          ? "*"
+          : absl::StrJoin(variables, " ", Variable::AbslFormatter);
+  return absl::StrCat(parsedServiceClause_.prologue_, "\nSELECT ",
+                      variablesForSelectClause, " ", graphPattern);
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> Service::getVariableKeysForJson() const {
+  std::vector<std::string> keys;
+  ql::ranges::transform(parsedServiceClause_.visibleVariables_,
+                        std::back_inserter(keys),
+                        [](const Variable& v) { return v.name().substr(1); });
+  return keys;
+}
+
 // _____________________________________________________________________________
 Result Service::computeResult(bool requestLaziness) {
   try {
@@ -171,18 +193,29 @@ Result Service::computeResultImpl(bool requestLaziness) {
 
   throwIfIriNotWhitelisted();
 
-  ad_utility::httpUtils::Url serviceUrl{
-      asStringViewUnsafe(parsedServiceClause_.serviceIri_.getContent())};
+  // If there are too many values of the sibling for a single request, send
+  // them in batches.
+  auto siblingValues = getSiblingValues();
+  const size_t batchSize = std::max(
+      size_t{1},
+      getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>());
+  const size_t parallelism =
+      getRuntimeParameter<&RuntimeParameters::serviceBindJoinParallelism_>();
+  if (siblingValues.has_value() && parallelism > 0 &&
+      siblingValues->rows_.size() > batchSize) {
+    return computeResultAsBindJoin(std::move(siblingValues.value()), batchSize,
+                                   parallelism, requestLaziness);
+  }
 
   // Construct the query to be sent to the SPARQL endpoint.
-  const auto& variables = parsedServiceClause_.visibleVariables_;
-  std::string variablesForSelectClause =
-      variables.empty()
-          ? "*"
-          : absl::StrJoin(variables, " ", Variable::AbslFormatter);
-  std::string serviceQuery =
-      absl::StrCat(parsedServiceClause_.prologue_, "\nSELECT ",
-                   variablesForSelectClause, " ", getGraphPattern());
+  std::optional<std::string> valuesClause;
+  if (siblingValues.has_value()) {
+    valuesClause =
+        makeValuesClause(siblingValues->variables_, siblingValues->rows_);
+  }
+  std::string serviceQuery = getServiceQuery(getGraphPattern(valuesClause));
+  ad_utility::httpUtils::Url serviceUrl{
+      asStringViewUnsafe(parsedServiceClause_.serviceIri_.getContent())};
   AD_LOG_INFO << "Sending SERVICE query to remote endpoint "
               << "(protocol: " << serviceUrl.protocolAsString()
               << ", host: " << serviceUrl.host()
@@ -190,6 +223,25 @@ Result Service::computeResultImpl(bool requestLaziness) {
               << ", target: " << serviceUrl.target() << ")" << std::endl
               << serviceQuery << std::endl;
 
+  auto body = sendServiceQuery(serviceQuery);
+
+  // Note: The `body`-generator also keeps the complete response connection
+  // alive, so we have no lifetime issue here(see `HttpRequest::send` for
+  // details).
+  auto generator = computeResultLazily(getVariableKeysForJson(),
+                                       std::move(body), !requestLaziness);
+  return requestLaziness
+             ? Result{std::move(generator), resultSortedOn()}
+             : Result{ad_utility::getSingleElement(std::move(generator)),
+                      resultSortedOn()};
+}
+
+// ____________________________________________________________________________
+ad_utility::LazyJsonParser::Generator Service::sendServiceQuery(
+    const std::string& serviceQuery) {
+  ad_utility::httpUtils::Url serviceUrl{
+      asStringViewUnsafe(parsedServiceClause_.serviceIri_.getContent())};
+
   // Send the query to the remote endpoint. Redirects are handled automatically
   // by the HTTP client up to the limit specified by the runtime parameter
   // `service-max-redirects`.
@@ -219,26 +271,71 @@ Result Service::computeResultImpl(bool requestLaziness) {
         response.contentType_, "'"));
   }
 
-  // Prepare the expected Variables as keys for the JSON-bindings. We can't wait
-  // for the variables sent in the response as they're maybe not read before
-  // the bindings.
-  std::vector<std::string> expVariableKeys;
-  ql::ranges::transform(parsedServiceClause_.visibleVariables_,
-                        std::back_inserter(expVariableKeys),
-                        [](const Variable& v) { return v.name().substr(1); });
+  return ad_utility::LazyJsonParser::parse(std::move(response.body_),
+                                           {"results", "bindings"});
+}
 
-  auto body = ad_utility::LazyJsonParser::parse(std::move(response.body_),
-                                                {"results", "bindings"});
+// ____________________________________________________________________________
+Result Service::computeResultAsBindJoin(SiblingValues siblingValues,
+                                        size_t batchSize, size_t parallelism,
+                                        bool requestLaziness) {
+  const size_t numRows = siblingValues.rows_.size();
+  const size_t numBatches = (numRows + batchSize - 1) / batchSize;
+  parallelism = std::min(parallelism, numBatches);
+  runtimeInfo().addDetail("bind-join-num-batches", numBatches);
+  runtimeInfo().addDetail("bind-join-parallelism", parallelism);
+  AD_LOG_INFO << "Sending SERVICE query to remote endpoint <"
+              << asStringViewUnsafe(
+                     parsedServiceClause_.serviceIri_.getContent())
+              << "> as a bind join with " << numRows << " values in "
+              << numBatches << " batches" << std::endl;
+
+  // The state that is shared by the producer threads below, each of which
+  // repeatedly takes the next batch.
+  struct BatchState {
+    SiblingValues values_;
+    std::vector<std::string> variableKeys_;
+    std::atomic<size_t> nextBatch_ = 0;
+  };
+  auto state = std::make_shared<BatchState>();
+  state->values_ = std::move(siblingValues);
+  state->variableKeys_ = getVariableKeysForJson();
+
+  // Send the request for the next batch, and convert the response (which is
+  // parsed while it is received) to a single `IdTable`. The results of the
+  // batches are disjoint, because the values are distinct.
+  auto computeNextBatch =
+      [this, state, batchSize]() -> std::optional<Result::IdTableVocabPair> {
+    const auto& rows = state->values_.rows_;
+    size_t begin = state->nextBatch_.fetch_add(1) * batchSize;
+    if (begin >= rows.size()) {
+      return std::nullopt;
+    }
+    checkCancellation();
+    size_t end = std::min(begin + batchSize, rows.size());
+    std::string serviceQuery = getServiceQuery(
+        getGraphPattern(makeValuesClause(state->values_.variables_,
+                                         ql::span{rows}.subspan(
+                                             begin, end - begin))));
+    return ad_utility::getSingleElement(computeResultLazily(
+        state->variableKeys_, sendServiceQuery(serviceQuery), true));
+  };
+  using Queue =
+      ad_utility::data_structures::ThreadSafeQueue<Result::IdTableVocabPair>;
+  auto batches = ad_utility::data_structures::queueManager<Queue>(
+      parallelism, parallelism, std::move(computeNextBatch));
+  if (requestLaziness) {
+    return Result{std::move(batches), resultSortedOn()};
+  }
 
-  // Note: The `body`-generator also keeps the complete response connection
-  // alive, so we have no lifetime issue here(see `HttpRequest::send` for
-  // details).
-  auto generator =
-      computeResultLazily(expVariableKeys, std::move(body), !requestLaziness);
-  return requestLaziness
-             ? Result{std::move(generator), resultSortedOn()}
-             : Result{ad_utility::getSingleElement(std::move(generator)),
-                      resultSortedOn()};
+  IdTable idTable{getResultWidth(), getExecutionContext()->getAllocator()};
+  LocalVocab localVocab;
+  for (auto& [batch, batchLocalVocab] : batches) {
+    idTable.insertAtEnd(batch);
+    localVocab.mergeWith(batchLocalVocab);
+    checkCancellation();
+  }
+  return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
 }
 
 template <size_t I>
@@ -370,7 +467,7 @@ Result::LazyResult Service::computeResultLazily(
 }
 
 // ____________________________________________________________________________
-std::optional<std::string> Service::getSiblingValuesClause() const {
+std::optional<Service::SiblingValues> Service::getSiblingValues() const {
   if (!siblingInfo_.has_value()) {
     return std::nullopt;
   }
@@ -380,7 +477,9 @@ std::optional<std::string> Service::getSiblingValuesClause() const {
   checkCancellation();
 
   std::vector<ColumnIndex> commonColumnIndices;
-  std::string vars = "(";
+  SiblingValues result;
+  std::string& vars = result.variables_;
+  vars = "(";
   for (const auto& localVar : parsedServiceClause_.visibleVariables_) {
     auto it = siblingVars.find(localVar);
     if (it == siblingVars.end()) {
@@ -411,7 +510,6 @@ std::optional<std::string> Service::getSiblingValuesClause() const {
   };
 
   ad_utility::HashSet<std::string> rowSet;
-  std::string values = " { ";
   for (size_t rowIndex = 0; rowIndex < siblingResult->idTableView().size();
        ++rowIndex) {
     std::string row = createValueRow(rowIndex);
@@ -419,12 +517,21 @@ std::optional<std::string> Service::getSiblingValuesClause() const {
       continue;
     }
     rowSet.insert(row);
-
-    absl::StrAppend(&values, row, " ");
+    result.rows_.push_back(std::move(row));
     checkCancellation();
   }
+  return result;
+}
 
-  return "VALUES " + vars + values + "} . ";
+// ____________________________________________________________________________
+std::string Service::makeValuesClause(std::string_view variables,
+                                      ql::span<const std::string> rows) {
+  std::string values = absl::StrCat("VALUES ", variables, " { ");
+  for (const auto& row : rows) {
+    absl::StrAppend(&values, row, " ");
+  }
+  absl::StrAppend(&values, "} . ");
+  return values;
 }
 
 // ____________________________________________________________________________
@@ -631,18 +738,24 @@ void Service::precomputeSiblingResult(std::shared_ptr<Operation> left,
       false, requestLaziness ? ComputationMode::LAZY_IF_SUPPORTED
                              : ComputationMode::FULLY_MATERIALIZED);
 
+  // With a bind join, the sibling's result can be used regardless of its
+  // size, see `computeResultAsBindJoin`.
+  const bool bindJoinEnabled =
+      getRuntimeParameter<&RuntimeParameters::serviceBindJoinParallelism_>() >
+      0;
   if (siblingResult->isFullyMaterialized()) {
-    bool resultIsSmall =
+    bool useSiblingResult =
+        bindJoinEnabled ||
         siblingResult->idTableView().size() <=
-        getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>();
-    if (resultIsSmall) {
+            getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>();
+    if (useSiblingResult) {
       service->siblingInfo_.emplace(
           siblingResult, sibling->getExternallyVisibleVariableColumns(),
           sibling->getCacheKey());
     }
     sibling->precomputedResultBecauseSiblingOfService() =
         std::move(siblingResult);
-    addRuntimeInfo(resultIsSmall);
+    addRuntimeInfo(useSiblingResult);
     return;
   }
 
@@ -662,7 +775,7 @@ void Service::precomputeSiblingResult(std::shared_ptr<Operation> left,
     rows += pair.idTable_.size();
     resultPairs.push_back(std::move(pair));
 
-    if (rows > maxValueRows) {
+    if (rows > maxValueRows && !bindJoinEnabled) {
       // Stop precomputation as the size of `siblingResult` exceeds the
       // threshold it is not useful for the service operation. Pass the
       // partially materialized result to the sibling.
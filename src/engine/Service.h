@@ -31,6 +31,14 @@
 // estimates of the result size, cost, and multiplicities are therefore dummy
 // values.
 //
+// If the result of a sibling operation (the other child of a join) is known,
+// its values are sent along with the query as a VALUES clause. When there
+// are more distinct values than `service-max-value-rows` and the runtime
+// parameter `service-bind-join-parallelism` is non-zero, the SERVICE is
+// computed as a bind join: the values are split into batches, one request is
+// sent per batch (several of them concurrently), and the result consists of
+// the results of all the requests.
+//
 class Service : public Operation {
  public:
   // Information on a Sibling operation.
@@ -40,6 +48,13 @@ class Service : public Operation {
     std::string cacheKey_;
   };
 
+  // The distinct rows of the VALUES clause that is derived from the sibling's
+  // result, and the variables of the clause (in parentheses).
+  struct SiblingValues {
+    std::string variables_;
+    std::vector<std::string> rows_;
+  };
+
  private:
   // The parsed SERVICE clause.
   parsedQuery::Service parsedServiceClause_;
@@ -116,9 +131,18 @@ class Service : public Operation {
   static std::string pushDownValues(std::string_view pattern,
                                     std::string_view values);
 
-  // Return the optimized graph pattern derived from `parsedServiceClause_` and
-  // an optional derived sibling.
-  std::string getGraphPattern() const;
+  // Return the graph pattern of `parsedServiceClause_`, into which the
+  // `valuesClause` (if any) is pushed down.
+  std::string getGraphPattern(
+      const std::optional<std::string>& valuesClause) const;
+
+  // Return the complete SPARQL query for the remote endpoint with the given
+  // `graphPattern`.
+  std::string getServiceQuery(std::string_view graphPattern) const;
+
+  // The names of the visible variables without the leading `?`, which are the
+  // keys of the bindings in the JSON result.
+  std::vector<std::string> getVariableKeysForJson() const;
 
   // Compute the result using `getResultFunction_` and `siblingInfo_`.
   Result computeResult(bool requestLaziness) override;
@@ -126,8 +150,24 @@ class Service : public Operation {
   // Actually compute the result for the function above.
   Result computeResultImpl(bool requestLaziness);
 
-  // Get a VALUES clause that contains the values of the siblingTree's result.
-  std::optional<std::string> getSiblingValuesClause() const;
+  // Compute the result as a bind join (see the class comment), where each
+  // request contains `batchSize` of the `siblingValues` and up to
+  // `parallelism` requests are sent at the same time.
+  Result computeResultAsBindJoin(SiblingValues siblingValues, size_t batchSize,
+                                 size_t parallelism, bool requestLaziness);
+
+  // Send the `serviceQuery` to the remote endpoint, check the status and the
+  // content type of the response, and return the parser for its body.
+  ad_utility::LazyJsonParser::Generator sendServiceQuery(
+      const std::string& serviceQuery);
+
+  // Get the values of the sibling's result for a VALUES clause, or
+  // `std::nullopt` if there is no sibling.
+  std::optional<SiblingValues> getSiblingValues() const;
+
+  // Create a VALUES clause with the `variables` and the given `rows`.
+  static std::string makeValuesClause(std::string_view variables,
+                                      ql::span<const std::string> rows);
 
   // Create result for silent fail.
   Result makeNeutralElementResultForSilentFail() const;
@@ -167,6 +207,7 @@ class Service : public Operation {
   FRIEND_TEST(ServiceTest, precomputeSiblingResultDoesNotWorkWithCaching);
   FRIEND_TEST(ServiceTest, precomputeSiblingResultDoesNotWorkWithLimit);
   FRIEND_TEST(ServiceTest, precomputeSiblingResult);
+  FRIEND_TEST(ServiceTest, bindJoin);
 };
 #else
 // In the C++17 mode, where the If we disable the `Service` operation isled,
@@ -13,6 +13,7 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/TopKHelpers.h"
 #include "engine/idTable/CompressedExternalIdTable.h"
 #include "global/RuntimeParameters.h"
 #include "index/ExternalSortFunctors.h"
@@ -91,6 +92,14 @@ Result Sort::computeResult(bool requestLaziness) {
   // Always request lazy input to avoid premature materialization.
   std::shared_ptr<const Result> input = subtree_->getResult(true);
 
+  // The `LIMIT` of an explicit sort is not propagated to the subtree, see
+  // `handlesLimitOffset()`. If it is small, only compute the first rows.
+  if (explicitSort_) {
+    if (auto k = qlever::topKHelpers::getTopK(getLimitOffset())) {
+      return computeResultTopK(*input, k.value());
+    }
+  }
+
   // For fully materialized input, we know the size upfront.
   if (input->isFullyMaterialized()) {
     if (input->idTableView().numRows() <= maxNumRowsToBeSortedInMemory) {
@@ -141,6 +150,23 @@ Result Sort::computeResult(bool requestLaziness) {
                                std::move(mergedLocalVocab));
 }
 
+// _____________________________________________________________________________
+Result Sort::computeResultTopK(const Result& input, size_t k) const {
+  runtimeInfo().addDetail("top-k", k);
+  auto comparison = [this](const auto& row1, const auto& row2) -> bool {
+    for (ColumnIndex col : sortColumnIndices_) {
+      if (row1[col] != row2[col]) {
+        return row1[col] < row2[col];
+      }
+    }
+    return false;
+  };
+  return {qlever::topKHelpers::computeTopK(
+              input, k, subtree_->getResultWidth(), comparison, allocator(),
+              [this]() { checkCancellation(); }),
+          resultSortedOn()};
+}
+
 // _____________________________________________________________________________
 Result Sort::computeResultInMemory(IdTable idTable,
                                    LocalVocab localVocab) const {
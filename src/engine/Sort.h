@@ -31,8 +31,8 @@ class Sort : public Operation {
   std::vector<ColumnIndex> sortColumnIndices_;
   // If `true`, this `Sort` was created from an explicit `INTERNAL SORT BY`
   // clause. In that case we deliberately do not propagate a `LIMIT`/`OFFSET`
-  // to the subtree, because the user explicitly asked for the complete sorted
-  // result (see `handlesLimitOffset()`).
+  // to the subtree, because the user explicitly asked for the first rows of
+  // the complete sorted result (see `handlesLimitOffset()`).
   bool explicitSort_;
 
  public:
@@ -79,11 +79,12 @@ class Sort : public Operation {
   // (user-facing `ORDER BY` goes through `OrderBy`, not `Sort`). So we can
   // let the subtree compute only N rows and sort those. The exception is an
   // explicit `INTERNAL SORT BY`: there the user explicitly requested the
-  // complete sorted result, so we do not handle (and hence do not propagate)
-  // the `LIMIT`/`OFFSET` here, but let it be applied externally on the full
-  // sorted output.
+  // first rows of the complete sorted result, so we do not propagate the
+  // `LIMIT`/`OFFSET`. Instead, we only compute the first `LIMIT + OFFSET` rows
+  // of the sorted result (if this is small enough, see `computeResultTopK`)
+  // and let the `LIMIT`/`OFFSET` be applied externally to these rows.
   LimitOffsetHandling handlesLimitOffset() const override {
-    return explicitSort_ ? LimitOffsetHandling::NONE
+    return explicitSort_ ? LimitOffsetHandling::PARTIAL
                          : LimitOffsetHandling::FULL;
   }
 
@@ -105,6 +106,10 @@ class Sort : public Operation {
 
   virtual Result computeResult(bool requestLaziness) override;
 
+  // Compute only the first `k` rows of the sorted result of the `input`, see
+  // `qlever::topKHelpers::computeTopK`.
+  Result computeResultTopK(const Result& input, size_t k) const;
+
   // Sort in memory, using `IdTableUtils::sort`.
   Result computeResultInMemory(IdTable idTable, LocalVocab localVocab) const;
 
@@ -0,0 +1,102 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_TOPKHELPERS_H
+#define QLEVER_SRC_ENGINE_TOPKHELPERS_H
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+#include "engine/CallFixedSize.h"
+#include "engine/Result.h"
+#include "engine/idTable/IdTable.h"
+#include "global/RuntimeParameters.h"
+#include "index/IdTableUtils.h"
+#include "index/LocalVocab.h"
+#include "parser/data/LimitOffsetClause.h"
+
+// Helpers for the sorting operations (`OrderBy` and `Sort`) to compute only the
+// first `k` rows of the sorted result if there is a `LIMIT`.
+namespace qlever::topKHelpers {
+
+// The minimal number of rows by which the buffer in `computeTopK` grows before
+// it is truncated again. This avoids truncating the buffer very often for
+// small values of `k`.
+static constexpr size_t MIN_BUFFER_INCREMENT = 10'000;
+
+// Return the number of rows that have to be computed by a sorting operation
+// with the given `limitOffset` (the offset is applied afterwards), if it is
+// small enough for `computeTopK`, see the runtime parameter
+// `sort-top-k-max-num-rows`. Else return `std::nullopt`.
+inline std::optional<size_t> getTopK(const LimitOffsetClause& limitOffset) {
+  if (!limitOffset._limit.has_value()) {
+    return std::nullopt;
+  }
+  size_t k = limitOffset.upperBound(std::numeric_limits<uint64_t>::max());
+  if (k > getRuntimeParameter<&RuntimeParameters::sortTopKMaxNumRows_>()) {
+    return std::nullopt;
+  }
+  return k;
+}
+
+// Return the first `k` rows of the `input` when sorted according to the
+// `comparator` (which has to be callable with two rows of an `IdTableStatic`),
+// together with the merged local vocab of the input. The `input` is consumed
+// block by block if it is lazy, and fully materialized inputs are also
+// processed in chunks, s.t. at most `max(2 * k, k + MIN_BUFFER_INCREMENT)`
+// rows are held in memory at any time: whenever the buffer is full, the `k`
+// smallest rows are selected in linear time and the rest is discarded.
+template <typename Comparator, typename CheckCancellation>
+Result::IdTableVocabPair computeTopK(
+    const Result& input, size_t k, size_t numColumns,
+    const Comparator& comparator,
+    const ad_utility::AllocatorWithLimit<Id>& allocator,
+    const CheckCancellation& checkCancellation) {
+  IdTable buffer{numColumns, allocator};
+  const size_t maxBufferSize = std::max(2 * k, k + MIN_BUFFER_INCREMENT);
+  buffer.reserve(maxBufferSize);
+
+  auto selectFirstK = [&]() {
+    ad_utility::callFixedSizeVi(numColumns, [&](auto I) {
+      IdTableUtils::selectFirstK<I>(&buffer, k, comparator);
+    });
+    checkCancellation();
+  };
+  auto addBlock = [&](const IdTable& block) {
+    size_t begin = 0;
+    while (begin < block.numRows()) {
+      size_t end = std::min(block.numRows(),
+                            begin + (maxBufferSize - buffer.numRows()));
+      buffer.insertAtEnd(block, begin, end);
+      begin = end;
+      if (buffer.numRows() >= maxBufferSize) {
+        selectFirstK();
+      }
+    }
+  };
+
+  LocalVocab localVocab;
+  if (input.isFullyMaterialized()) {
+    addBlock(input.idTable());
+    localVocab = input.getCopyOfLocalVocab();
+  } else {
+    for (const Result::IdTableVocabPair& pair : input.idTables()) {
+      addBlock(pair.idTable_);
+      localVocab.mergeWith(pair.localVocab_);
+      checkCancellation();
+    }
+  }
+  selectFirstK();
+  ad_utility::callFixedSizeVi(numColumns, [&](auto I) {
+    IdTableUtils::sort<I>(&buffer, comparator);
+  });
+  checkCancellation();
+  return {std::move(buffer), std::move(localVocab)};
+}
+
+}  // namespace qlever::topKHelpers
+
+#endif  // QLEVER_SRC_ENGINE_TOPKHELPERS_H
@@ -9,11 +9,20 @@
 #ifndef QLEVER_SRC_ENGINE_TRANSITIVEPATHIMPL_H
 #define QLEVER_SRC_ENGINE_TRANSITIVEPATHIMPL_H
 
+#include <functional>
+#include <future>
+#include <limits>
+#include <thread>
 #include <utility>
 
+#include "engine/IndexScan.h"
 #include "engine/TransitivePathBase.h"
 #include "engine/TransitivePathGraphSearch.h"
+#include "engine/TransitivePathMultiSourceBfs.h"
+#include "global/RuntimeParameters.h"
+#include "index/IndexImpl.h"
 #include "util/Iterators.h"
+#include "util/ParallelExecutor.h"
 #include "util/Timer.h"
 
 using IdWithGraphs = absl::InlinedVector<std::pair<Id, Id>, 1>;
@@ -76,6 +85,12 @@ class TransitivePathImpl : public TransitivePathBase {
       ::ranges::zip_view<ql::span<const Id>, ::ranges::repeat_view<Id>>>;
   using TableColumnWithVocab = detail::TableColumnWithVocab<
       ad_utility::InputRangeTypeErased<ZippedType>>;
+  using CondensedGraph = qlever::graphSearch::CondensedGraph;
+  using MultiSourceBfs = qlever::graphSearch::MultiSourceBfs;
+  // Builds the `CondensedGraph` of the edges when it is first needed (see
+  // `makeCondensedGraphFactory`).
+  using CondensedGraphFactory =
+      std::function<std::shared_ptr<const CondensedGraph>()>;
 
  public:
   using TransitivePathBase::TransitivePathBase;
@@ -100,6 +115,8 @@ class TransitivePathImpl : public TransitivePathBase {
     ad_utility::Timer timer{ad_utility::Timer::Started};
 
     auto edges = setupEdgesMap(sub->idTableView(), startSide, targetSide);
+    auto makeCondensedGraph =
+        makeCondensedGraphFactory(sub, startSide, targetSide);
     auto nodes = setupNodes(startSide, std::move(startSideResult));
     // Setup nodes returns a generator, so this time measurement won't include
     // the time for each iteration, but every iteration step should have
@@ -108,7 +125,8 @@ class TransitivePathImpl : public TransitivePathBase {
 
     NodeGenerator hull = transitiveHull(
         std::move(edges), sub->getCopyOfLocalVocab(), std::move(nodes),
-        startSide.value_, targetSide.value_, yieldOnce);
+        startSide.value_, targetSide.value_, yieldOnce,
+        std::move(makeCondensedGraph));
 
     const auto& [tree, joinColumn] = startSide.treeAndCol_.value();
     size_t numberOfPayloadColumns =
@@ -123,6 +141,40 @@ class TransitivePathImpl : public TransitivePathBase {
     }
   };
 
+  // Compute the transitive hull with a bound side via lookups in the
+  // `reachabilityIndex` of the predicate of the `subtree_` (see
+  // `getReachabilityIndex`), without computing the `subtree_`. The arguments
+  // are the same as for `computeTransitivePathBound`.
+  Result::Generator computeTransitivePathWithReachabilityIndex(
+      std::shared_ptr<const ReachabilityIndex> reachabilityIndex,
+      const TransitivePathSide& startSide,
+      const TransitivePathSide& targetSide,
+      std::shared_ptr<const Result> startSideResult, bool yieldOnce) const {
+    ad_utility::Timer timer{ad_utility::Timer::Started};
+    // The edges of the `subtree_` go from the left to the right side.
+    const bool forward = startSide.subCol_ == lhs_.subCol_;
+    auto nodes = setupNodes(startSide, std::move(startSideResult));
+    runtimeInfo().addDetail("Reachability index",
+                            forward ? "forward" : "backward");
+    runtimeInfo().addDetail("Initialization time", timer.msecs());
+
+    NodeGenerator hull =
+        reachabilityIndexHull(*reachabilityIndex, forward, std::move(nodes),
+                              targetSide.value_, yieldOnce);
+
+    const auto& [tree, joinColumn] = startSide.treeAndCol_.value();
+    size_t numberOfPayloadColumns =
+        tree->getResultWidth() - numJoinColumnsWith(tree, joinColumn);
+    auto result = fillTableWithHull(std::move(hull), startSide.outputCol_,
+                                    targetSide.outputCol_, yieldOnce,
+                                    numberOfPayloadColumns);
+
+    // Iterate over generator to prevent lifetime issues
+    for (auto& pair : result) {
+      co_yield pair;
+    }
+  }
+
   /**
    * @brief Compute the transitive hull.
    * This function is called when no side is bound (or an id).
@@ -141,6 +193,8 @@ class TransitivePathImpl : public TransitivePathBase {
     ad_utility::Timer timer{ad_utility::Timer::Started};
 
     auto edges = setupEdgesMap(sub->idTableView(), startSide, targetSide);
+    auto makeCondensedGraph =
+        makeCondensedGraphFactory(sub, startSide, targetSide);
     auto nodes = setupNodes(sub->idTableView(), startSide, edges);
 
     runtimeInfo().addDetail("Initialization time", timer.msecs());
@@ -152,7 +206,8 @@ class TransitivePathImpl : public TransitivePathBase {
 
     NodeGenerator hull = transitiveHull(
         std::move(edges), sub->getCopyOfLocalVocab(), ql::span{&tableInfo, 1},
-        startSide.value_, targetSide.value_, yieldOnce);
+        startSide.value_, targetSide.value_, yieldOnce,
+        std::move(makeCondensedGraph));
 
     // We don't pass a payload table, so our `inputWidth` is 0.
     auto result = fillTableWithHull(std::move(hull), startSide.outputCol_,
@@ -176,6 +231,17 @@ class TransitivePathImpl : public TransitivePathBase {
    */
   Result computeResult(bool requestLaziness) override {
     auto [startSide, targetSide] = decideDirection();
+    if (auto reachabilityIndex = getReachabilityIndex(startSide, targetSide);
+        reachabilityIndex != nullptr) {
+      std::shared_ptr<const Result> sideRes =
+          startSide.treeAndCol_.value().first->getResult(true);
+      auto gen = computeTransitivePathWithReachabilityIndex(
+          std::move(reachabilityIndex), startSide, targetSide,
+          std::move(sideRes), !requestLaziness);
+      return requestLaziness ? Result{std::move(gen), resultSortedOn()}
+                             : Result{cppcoro::getSingleElement(std::move(gen)),
+                                      resultSortedOn()};
+    }
     // In order to traverse the graph represented by this result, we need random
     // access across the whole table, so it doesn't make sense to lazily compute
     // the result.
@@ -218,12 +284,18 @@ class TransitivePathImpl : public TransitivePathBase {
    * code. When set to true, this will prevent yielding the same LocalVocab over
    * and over again to make merging faster (because merging with an empty
    * LocalVocab is a no-op).
+   * @param makeCondensedGraph If not empty, the hulls of the start nodes of a
+   * table with at least as many start nodes as the batch size of the
+   * multi-source BFS are computed with a multi-source BFS on the graph that
+   * it returns instead of a graph search on the `edges` per start node (see
+   * `makeCondensedGraphFactory`).
    * @return Map Maps each Id to its connected Ids in the transitive hull
    */
   CPP_template(typename Node)(requires ql::ranges::range<Node>) NodeGenerator
       transitiveHull(T edges, LocalVocab edgesVocab, Node startNodes,
                      TripleComponent start, TripleComponent target,
-                     bool yieldOnce) const {
+                     bool yieldOnce,
+                     CondensedGraphFactory makeCondensedGraph = {}) const {
     using namespace qlever::graphSearch;
     ad_utility::Timer timer{ad_utility::Timer::Stopped};
     // `targetId` is only ever used for comparisons, and never stored in the
@@ -240,10 +312,73 @@ class TransitivePathImpl : public TransitivePathBase {
         !targetId.has_value() && graphVariable_ == target.getVariable();
     bool startsWithGraphVariable =
         start.isVariable() && graphVariable_ == start.getVariable();
+    // The graph of the multi-source BFS and its searches (one per thread).
+    // They are only created when they are needed, because building the graph
+    // touches all the edges, and each search allocates its bitsets for all the
+    // components of the graph. For a few start nodes, the graph search per
+    // start node, which only visits the reachable nodes, is much cheaper.
+    std::shared_ptr<const CondensedGraph> condensedGraph;
+    std::vector<MultiSourceBfs> multiSourceSearches;
+    const size_t batchSize = getMultiSourceBfsBatchSize();
+    const size_t numThreads = getMultiSourceBfsNumThreads();
+    if (batchSize == 0) {
+      makeCondensedGraph = nullptr;
+    }
     for (auto&& tableColumn : startNodes) {
       timer.cont();
       LocalVocab mergedVocab = std::move(tableColumn.vocab_);
       mergedVocab.mergeWith(edgesVocab);
+      if (makeCondensedGraph) {
+        // Collect all the start nodes of this table, s.t. they can be
+        // processed in batches.
+        std::vector<Id> startIds;
+        std::vector<size_t> rows;
+        for (const auto& [currentRow, pair] :
+             ::ranges::views::enumerate(tableColumn.startNodes_)) {
+          for (const auto& [startNode, graphId] :
+               tableColumn.expandUndef(pair, edges, false)) {
+            startIds.push_back(startNode);
+            rows.push_back(static_cast<size_t>(currentRow));
+          }
+        }
+        const bool useMultiSourceBfs = startIds.size() >= batchSize;
+        if (useMultiSourceBfs && condensedGraph == nullptr) {
+          condensedGraph = makeCondensedGraph();
+        }
+        const size_t maxNumStartNodes = batchSize * numThreads;
+        for (size_t begin = 0; begin < startIds.size();
+             begin += maxNumStartNodes) {
+          const size_t end =
+              std::min(begin + maxNumStartNodes, startIds.size());
+          auto chunk = ql::span<const Id>{startIds}.subspan(begin, end - begin);
+          std::vector<Set> hulls =
+              useMultiSourceBfs
+                  ? computeHullsWithMultiSourceBfs(*condensedGraph,
+                                                   multiSourceSearches, chunk,
+                                                   batchSize, numThreads)
+                  : computeHullsWithGraphSearch(edges, chunk, targetId);
+          for (size_t i = begin; i < end; ++i) {
+            Set& connectedNodes = hulls[i - begin];
+            if (connectedNodes.empty()) {
+              continue;
+            }
+            runtimeInfo().addDetail("Hull time", timer.msecs());
+            timer.stop();
+            co_yield NodeWithTargets{startIds[i],
+                                     Id::makeUndefined(),
+                                     std::move(connectedNodes),
+                                     mergedVocab.clone(),
+                                     tableColumn.payload_,
+                                     rows[i]};
+            timer.cont();
+            if (yieldOnce) {
+              mergedVocab = LocalVocab{};
+            }
+          }
+        }
+        timer.stop();
+        continue;
+      }
       for (const auto& [currentRow, pair] :
            ::ranges::views::enumerate(tableColumn.startNodes_)) {
         for (const auto& [startNode, graphId] :
@@ -395,6 +530,235 @@ class TransitivePathImpl : public TransitivePathBase {
                           const TransitivePathSide& startSide,
                           const TransitivePathSide& targetSide) const = 0;
 
+  // Return a function that builds the graph of the strongly connected
+  // components of the edges in the `sub` result for the multi-source BFS, or
+  // an empty function if the multi-source BFS is disabled or can't be used.
+  // It computes all the nodes that are reachable from a start node via a path
+  // of any length (at least 0 or 1), so it is only used if the maximal
+  // distance is unbounded, the target side is a variable that is different
+  // from the start side, and there is no graph variable (for which the
+  // reachable nodes depend on the graph). The graph is only built when a
+  // table with enough start nodes is encountered (see `transitiveHull`).
+  CondensedGraphFactory makeCondensedGraphFactory(
+      std::shared_ptr<const Result> sub, const TransitivePathSide& startSide,
+      const TransitivePathSide& targetSide) const {
+    bool useMultiSourceBfs =
+        getMultiSourceBfsBatchSize() != 0 && !graphVariable_.has_value() &&
+        startSide.isVariable() && targetSide.isVariable() &&
+        !(lhs_.value_ == rhs_.value_) && minDist_ <= 1 &&
+        maxDist_ == std::numeric_limits<size_t>::max();
+    if (!useMultiSourceBfs) {
+      return {};
+    }
+    return [this, sub = std::move(sub), startCol = startSide.subCol_,
+            targetCol = targetSide.subCol_]() {
+      const auto& table = sub->idTable();
+      auto graph = std::make_shared<const CondensedGraph>(
+          table.getColumn(startCol), table.getColumn(targetCol), allocator(),
+          [this]() { checkCancellation(); });
+      runtimeInfo().addDetail("Multi-source BFS batch size",
+                              getMultiSourceBfsBatchSize());
+      runtimeInfo().addDetail("Number of strongly connected components",
+                              graph->numComponents());
+      return graph;
+    };
+  }
+
+  // Return the `ReachabilityIndex` with which this transitive path can be
+  // computed, or `nullptr` if there is none. This is the case if the
+  // `subtree_` is a scan of a single predicate with a reachability index, the
+  // `startSide` is bound and always defined, the target side is a fixed value
+  // or another variable, the maximal distance is unbounded, and all graphs
+  // are active. The index is built from the triples without the delta
+  // triples, so it can only be used if there are no delta triples.
+  std::shared_ptr<const ReachabilityIndex> getReachabilityIndex(
+      const TransitivePathSide& startSide,
+      const TransitivePathSide& targetSide) const {
+    if (!getRuntimeParameter<
+            &RuntimeParameters::transitivePathUseReachabilityIndex_>() ||
+        !startSide.isBoundVariable() || graphVariable_.has_value() ||
+        !activeGraphs_.areAllGraphsAllowed() || minDist_ > 1 ||
+        maxDist_ != std::numeric_limits<size_t>::max() ||
+        (targetSide.isVariable() && lhs_.value_ == rhs_.value_)) {
+      return nullptr;
+    }
+    auto scan = std::dynamic_pointer_cast<const IndexScan>(
+        subtree_->getRootOperation());
+    if (!scan || scan->numVariables() != 2 || scan->getResultWidth() != 2 ||
+        !scan->subject().isVariable() || !scan->object().isVariable() ||
+        !scan->graphsToFilter().areAllGraphsAllowed() ||
+        subtree_->getVariableColumn(scan->subject().getVariable()) !=
+            lhs_.subCol_ ||
+        subtree_->getVariableColumn(scan->object().getVariable()) !=
+            rhs_.subCol_) {
+      return nullptr;
+    }
+    // The scan must read the permutation of the index (and not that of a
+    // materialized view).
+    const auto& index = getIndex().getImpl();
+    if (&scan->permutation() !=
+        &index.getPermutation(scan->permutation().permutation())) {
+      return nullptr;
+    }
+    const auto& [tree, joinColumn] = startSide.treeAndCol_.value();
+    auto isJoinColumn = [joinColumn = joinColumn](const auto& variableAndInfo) {
+      return variableAndInfo.second.columnIndex_ == joinColumn;
+    };
+    const auto& variableColumns = tree->getVariableColumns();
+    auto it = ql::ranges::find_if(variableColumns, isJoinColumn);
+    using enum ColumnIndexAndTypeInfo::UndefStatus;
+    if (it != variableColumns.end() &&
+        it->second.mightContainUndef_ != AlwaysDefined) {
+      return nullptr;
+    }
+    if (locatedTriplesState()
+            .getLocatedTriplesForPermutation<false>(Permutation::PSO)
+            .numTriples() != 0) {
+      return nullptr;
+    }
+    auto predicate = scan->predicate().toValueId(index);
+    if (!predicate.has_value()) {
+      return nullptr;
+    }
+    return index.getReachabilityIndexes().get(predicate.value());
+  }
+
+  // Yield the hull of each of the `startNodes` via lookups in the
+  // `reachabilityIndex` (in the given direction). If the `target` is not a
+  // variable, the hull is either empty or only contains the `target`.
+  NodeGenerator reachabilityIndexHull(
+      const ReachabilityIndex& reachabilityIndex, bool forward,
+      ad_utility::InputRangeTypeErased<TableColumnWithVocab> startNodes,
+      TripleComponent target, bool yieldOnce) const {
+    ad_utility::Timer timer{ad_utility::Timer::Stopped};
+    LocalVocab targetHelper;
+    std::optional<Id> targetId =
+        target.isVariable()
+            ? std::nullopt
+            : std::optional{std::move(target).toValueId(getIndex(),
+                                                        targetHelper)};
+    for (auto&& tableColumn : startNodes) {
+      timer.cont();
+      LocalVocab mergedVocab = std::move(tableColumn.vocab_);
+      for (const auto& [currentRow, pair] :
+           ::ranges::views::enumerate(tableColumn.startNodes_)) {
+        checkCancellation();
+        const auto& [startNode, graphId] = pair;
+        // A path of length zero exists for every node, also if it is not part
+        // of the graph of the predicate.
+        Set connectedNodes{allocator()};
+        if (targetId.has_value()) {
+          if ((minDist_ == 0 && startNode == targetId.value()) ||
+              reachabilityIndex.reaches(startNode, targetId.value(), forward,
+                                        minDist_)) {
+            connectedNodes.insert(targetId.value());
+          }
+        } else {
+          for (auto nodes : reachabilityIndex.getReachableNodes(
+                   startNode, forward, minDist_)) {
+            connectedNodes.insert(nodes.begin(), nodes.end());
+          }
+          if (minDist_ == 0) {
+            connectedNodes.insert(startNode);
+          }
+        }
+        if (connectedNodes.empty()) {
+          continue;
+        }
+        runtimeInfo().addDetail("Hull time", timer.msecs());
+        timer.stop();
+        co_yield NodeWithTargets{startNode,
+                                 Id::makeUndefined(),
+                                 std::move(connectedNodes),
+                                 mergedVocab.clone(),
+                                 tableColumn.payload_,
+                                 static_cast<size_t>(currentRow)};
+        timer.cont();
+        if (yieldOnce) {
+          mergedVocab = LocalVocab{};
+        }
+      }
+      timer.stop();
+    }
+  }
+
+  // Compute the hulls of the `startNodes` with a multi-source BFS on the
+  // `graph`. The `startNodes` are split into batches of the `batchSize`, which
+  // are processed in parallel by the `searches` (one per thread, new ones are
+  // added as needed, up to `numThreads`).
+  std::vector<Set> computeHullsWithMultiSourceBfs(
+      const CondensedGraph& graph, std::vector<MultiSourceBfs>& searches,
+      ql::span<const Id> startNodes, size_t batchSize,
+      size_t numThreads) const {
+    const size_t numBatches = (startNodes.size() + batchSize - 1) / batchSize;
+    while (searches.size() < std::min(numThreads, numBatches)) {
+      searches.emplace_back(graph, batchSize, allocator());
+    }
+    std::vector<std::vector<Set>> hullsPerBatch(numBatches);
+    auto runBatches = [&](size_t searchIndex) {
+      for (size_t batch = searchIndex; batch < numBatches;
+           batch += searches.size()) {
+        auto batchStartNodes = startNodes.subspan(
+            batch * batchSize,
+            std::min(batchSize, startNodes.size() - batch * batchSize));
+        hullsPerBatch[batch] = searches[searchIndex].computeReachableNodes(
+            batchStartNodes, minDist_, [this]() { checkCancellation(); });
+      }
+    };
+    if (searches.size() <= 1) {
+      runBatches(0);
+    } else {
+      std::vector<std::packaged_task<void()>> tasks;
+      for (size_t i = 0; i < searches.size(); ++i) {
+        tasks.emplace_back([&runBatches, i]() { runBatches(i); });
+      }
+      ad_utility::runTasksInParallel(std::move(tasks));
+    }
+
+    std::vector<Set> hulls;
+    hulls.reserve(startNodes.size());
+    for (auto& batchHulls : hullsPerBatch) {
+      for (auto& hull : batchHulls) {
+        hulls.push_back(std::move(hull));
+      }
+    }
+    return hulls;
+  }
+
+  // Compute the hulls of the `startNodes` with a graph search on the `edges`
+  // per start node. This is used instead of the multi-source BFS if there are
+  // only a few start nodes.
+  std::vector<Set> computeHullsWithGraphSearch(
+      T& edges, ql::span<const Id> startNodes,
+      const std::optional<Id>& targetId) const {
+    std::vector<Set> hulls;
+    hulls.reserve(startNodes.size());
+    edges.setGraphId(Id::makeUndefined());
+    for (Id startNode : startNodes) {
+      GraphSearchProblem<T> gsp(edges, startNode, targetId, minDist_,
+                                maxDist_);
+      GraphSearchExecutionParams ep(cancellationHandle_, allocator());
+      hulls.push_back(runOptimalGraphSearch(gsp, ep));
+    }
+    return hulls;
+  }
+
+  static size_t getMultiSourceBfsBatchSize() {
+    return getRuntimeParameter<
+        &RuntimeParameters::transitivePathMultiSourceBfsBatchSize_>();
+  }
+
+  // The number of threads for the multi-source BFS (0 means one per core).
+  static size_t getMultiSourceBfsNumThreads() {
+    size_t maxHwConcurrency = std::max(1u, std::thread::hardware_concurrency());
+    size_t userPreference = getRuntimeParameter<
+        &RuntimeParameters::transitivePathMultiSourceBfsNumThreads_>();
+    if (userPreference == 0 || maxHwConcurrency < userPreference) {
+      return maxHwConcurrency;
+    }
+    return userPreference;
+  }
+
  private:
   // Helper function to filter the join column to not add it twice to the
   // result.
@@ -0,0 +1,159 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
+
+#include "engine/TransitivePathMultiSourceBfs.h"
+
+#include <absl/numeric/bits.h>
+
+#include <algorithm>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+
+using namespace qlever::graphSearch;
+
+namespace {
+using Component = CondensedGraph::Component;
+
+// Return true iff none of the `numWords` words of the bitset are set.
+bool isEmpty(const uint64_t* bitset, size_t numWords) {
+  return std::all_of(bitset, bitset + numWords,
+                     [](uint64_t word) { return word == 0; });
+}
+}  // namespace
+
+// _____________________________________________________________________________
+MultiSourceBfs::MultiSourceBfs(
+    const CondensedGraph& graph, size_t batchSize,
+    const ad_utility::AllocatorWithLimit<Id>& allocator)
+    : graph_{graph},
+      numWords_{batchSize / 64},
+      allocator_{allocator},
+      seen_{allocator.as<uint64_t>()},
+      visit_{allocator.as<uint64_t>()},
+      visitNext_{allocator.as<uint64_t>()} {
+  AD_CONTRACT_CHECK(batchSize > 0 && batchSize % 64 == 0,
+                    "The batch size of a multi-source BFS must be a positive "
+                    "multiple of 64");
+  seen_.resize(graph_.numComponents() * numWords_, 0);
+  visit_.resize(graph_.numComponents() * numWords_, 0);
+  visitNext_.resize(graph_.numComponents() * numWords_, 0);
+}
+
+// _____________________________________________________________________________
+std::vector<Set> MultiSourceBfs::computeReachableNodes(
+    ql::span<const Id> startNodes, size_t minDist,
+    const CondensedGraph::CancellationCheck& checkCancellation) {
+  AD_CONTRACT_CHECK(startNodes.size() <= batchSize());
+  AD_CONTRACT_CHECK(minDist <= 1);
+  AD_CORRECTNESS_CHECK(touched_.empty() && frontier_.empty());
+
+  // Start the search for the `i`-th start node (the `i`-th bit of the bitsets)
+  // at its component.
+  std::vector<std::optional<Component>> startComponents;
+  startComponents.reserve(startNodes.size());
+  for (size_t i = 0; i < startNodes.size(); ++i) {
+    auto component = graph_.getComponent(startNodes[i]);
+    startComponents.push_back(component);
+    if (!component.has_value()) {
+      continue;
+    }
+    uint64_t* seen = bits(seen_, component.value());
+    uint64_t* visit = bits(visit_, component.value());
+    if (isEmpty(seen, numWords_)) {
+      touched_.push_back(component.value());
+      frontier_.push_back(component.value());
+    }
+    seen[i / 64] |= uint64_t{1} << (i % 64);
+    visit[i / 64] |= uint64_t{1} << (i % 64);
+  }
+
+  // Expand one level of all the searches at a time. A search only continues
+  // to a successor that it has not seen yet.
+  while (!frontier_.empty()) {
+    checkCancellation();
+    for (Component component : frontier_) {
+      const uint64_t* visit = bits(visit_, component);
+      for (Component successor : graph_.successorsOfComponent(component)) {
+        uint64_t* seen = bits(seen_, successor);
+        uint64_t* next = bits(visitNext_, successor);
+        uint64_t wasSeen = 0;
+        uint64_t wasOnNextFrontier = 0;
+        uint64_t newBits = 0;
+        for (size_t w = 0; w < numWords_; ++w) {
+          wasSeen |= seen[w];
+          wasOnNextFrontier |= next[w];
+          uint64_t reached = visit[w] & ~seen[w];
+          seen[w] |= reached;
+          next[w] |= reached;
+          newBits |= reached;
+        }
+        if (newBits == 0) {
+          continue;
+        }
+        if (wasSeen == 0) {
+          touched_.push_back(successor);
+        }
+        if (wasOnNextFrontier == 0) {
+          nextFrontier_.push_back(successor);
+        }
+      }
+    }
+    for (Component component : frontier_) {
+      std::fill_n(bits(visit_, component), numWords_, 0);
+    }
+    visit_.swap(visitNext_);
+    frontier_.swap(nextFrontier_);
+    nextFrontier_.clear();
+  }
+
+  // Collect the components that each search has reached, and reset the
+  // `seen_` bits for the next batch.
+  std::vector<std::vector<Component>> reached(startNodes.size());
+  for (Component component : touched_) {
+    uint64_t* seen = bits(seen_, component);
+    for (size_t w = 0; w < numWords_; ++w) {
+      for (uint64_t word = seen[w]; word != 0; word &= word - 1) {
+        reached[w * 64 + absl::countr_zero(word)].push_back(component);
+      }
+      seen[w] = 0;
+    }
+  }
+  touched_.clear();
+
+  std::vector<Set> result;
+  result.reserve(startNodes.size());
+  for (size_t i = 0; i < startNodes.size(); ++i) {
+    Set& nodes = result.emplace_back(allocator_);
+    if (!startComponents[i].has_value()) {
+      // A start node without edges only reaches itself (via the empty path).
+      if (minDist == 0) {
+        nodes.insert(startNodes[i]);
+      }
+      continue;
+    }
+    // The search has seen its own component from the start, but the nodes of
+    // this component are only reachable via a path of length at least one if
+    // the component is cyclic.
+    const Component own = startComponents[i].value();
+    const bool includeOwn = minDist == 0 || graph_.isCyclic(own);
+    size_t numNodes = 0;
+    for (Component component : reached[i]) {
+      numNodes += graph_.nodesOfComponent(component).size();
+    }
+    nodes.reserve(numNodes);
+    for (Component component : reached[i]) {
+      if (component != own || includeOwn) {
+        auto componentNodes = graph_.nodesOfComponent(component);
+        nodes.insert(componentNodes.begin(), componentNodes.end());
+      }
+    }
+  }
+  return result;
+}
+
+#endif
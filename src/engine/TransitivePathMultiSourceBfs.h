@@ -0,0 +1,83 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
+
+#ifndef QLEVER_SRC_ENGINE_TRANSITIVEPATHMULTISOURCEBFS_H
+#define QLEVER_SRC_ENGINE_TRANSITIVEPATHMULTISOURCEBFS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "backports/span.h"
+#include "engine/TransitivePathGraphSearch.h"
+#include "global/Id.h"
+#include "index/CondensedGraph.h"
+#include "util/AllocatorWithLimit.h"
+
+namespace qlever::graphSearch {
+
+// A multi-source breadth-first search (MS-BFS, Then et al., VLDB 2014) on a
+// `CondensedGraph`, which computes the reachable nodes of a batch of up to
+// `batchSize` start nodes at once. Each component stores one bit per start
+// node of the batch (in `batchSize / 64` words) for whether it has been seen
+// by the search from that start node, and whether it is on the current or
+// next frontier of that search. Each level of the BFS is a single pass over
+// the components on the frontier of any of the searches, and the searches
+// that reach a component at the same time share the work of expanding it.
+// When the reachable sets of the start nodes overlap (e.g. for the classes of
+// many entities in a class hierarchy), this is much faster than a separate
+// search per start node.
+//
+// The bitsets are allocated once for all components, and only the entries of
+// the components that were reached by a batch are reset afterwards. An object
+// of this class can therefore be reused for many batches, but not by several
+// threads at the same time.
+class MultiSourceBfs {
+ public:
+  using Component = CondensedGraph::Component;
+
+ private:
+  const CondensedGraph& graph_;
+  size_t numWords_;
+  ad_utility::AllocatorWithLimit<Id> allocator_;
+  // The bitsets of the component `c` are the words `c * numWords_, ...,
+  // (c + 1) * numWords_ - 1` of these vectors.
+  CondensedGraph::Vector<uint64_t> seen_;
+  CondensedGraph::Vector<uint64_t> visit_;
+  CondensedGraph::Vector<uint64_t> visitNext_;
+  // The components whose bits in `seen_` are set, and the components on the
+  // current and the next frontier.
+  std::vector<Component> touched_;
+  std::vector<Component> frontier_;
+  std::vector<Component> nextFrontier_;
+
+ public:
+  // The `batchSize` is the maximal number of start nodes per batch and must
+  // be a positive multiple of 64.
+  MultiSourceBfs(const CondensedGraph& graph, size_t batchSize,
+                 const ad_utility::AllocatorWithLimit<Id>& allocator);
+
+  size_t batchSize() const { return numWords_ * 64; }
+
+  // For each of the `startNodes` (at most `batchSize()`), the set of nodes that
+  // can be reached from it via a path of length at least `minDist`, which
+  // must be 0 or 1. In particular, a start node is contained in its own set
+  // iff `minDist` is 0 or it lies on a cycle.
+  std::vector<Set> computeReachableNodes(
+      ql::span<const Id> startNodes, size_t minDist,
+      const CondensedGraph::CancellationCheck& checkCancellation);
+
+ private:
+  uint64_t* bits(CondensedGraph::Vector<uint64_t>& bitsets,
+                 Component component) {
+    return bitsets.data() + component * numWords_;
+  }
+};
+}  // namespace qlever::graphSearch
+
+#endif  // QLEVER_SRC_ENGINE_TRANSITIVEPATHMULTISOURCEBFS_H
+
+#endif
@@ -15,6 +15,7 @@
 #include "backports/algorithm.h"
 #include "engine/CallFixedSize.h"
 #include "engine/idTable/IdTable.h"
+#include "index/IdTableRadixSort.h"
 #include "util/AsyncStream.h"
 #include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/File.h"
@@ -590,17 +591,42 @@ class CompressedExternalIdTableSorterTypeErased {
 inline std::atomic<bool>
     EXTERNAL_ID_TABLE_SORTER_IGNORE_MEMORY_LIMIT_FOR_TESTING = false;
 
+// Comparators that sort by the bits of the `Id`s in certain columns expose
+// these columns via a member function `radixSortColumns(numColumns)`, s.t. the
+// blocks can be sorted using the (much faster) radix sort.
+namespace detail {
+template <typename Comparator>
+CPP_requires(HasRadixSortColumnsR,
+             requires(const Comparator& comparator)(
+                 comparator.radixSortColumns(size_t{0})));
+template <typename Comparator>
+CPP_concept HasRadixSortColumns =
+    CPP_requires_ref(HasRadixSortColumnsR, Comparator);
+}  // namespace detail
+
+// Sort a single `block` according to the `comparator`.
+template <typename Comparator, typename T>
+void sortBlock(T& block, const Comparator& comparator) {
+  if constexpr (detail::HasRadixSortColumns<Comparator>) {
+    const auto& sortColumns = comparator.radixSortColumns(block.numColumns());
+    if (ad_utility::radixSort::sortByBits(block, sortColumns)) {
+      return;
+    }
+  }
+#ifdef _PARALLEL_SORT
+  ad_utility::parallel_sort(std::begin(block), std::end(block), comparator);
+#else
+  ql::ranges::sort(block, comparator);
+#endif
+}
+
 // The implementation of sorting a single block
 template <typename Comparator>
 struct BlockSorter {
   [[no_unique_address]] Comparator comparator_{};
   template <typename T>
   void operator()(T& block) {
-#ifdef _PARALLEL_SORT
-    ad_utility::parallel_sort(std::begin(block), std::end(block), comparator_);
-#else
-    ql::ranges::sort(block, comparator_);
-#endif
+    sortBlock(block, comparator_);
   }
 };
 // Deduction guide for the implicit aggregate initialization (its "constructor")
@@ -865,11 +891,7 @@ class CompressedExternalIdTableSorter
 
   // _____________________________________________________________
   void sortBlockInPlace(IdTableStatic<NumStaticCols>& block) const {
-#ifdef _PARALLEL_SORT
-    ad_utility::parallel_sort(block.begin(), block.end(), comparator_);
-#else
-    ql::ranges::sort(block, comparator_);
-#endif
+    sortBlock(block, comparator_);
   }
 
   // A function with this name is needed by the mixin base class.
@@ -604,6 +604,21 @@ class IdTable {
         std::move(viewSpans), numColumns_, numRows_, allocator_};
   }
 
+  // Obtain a const view to the rows `[beginRow, endRow)` of this IdTable. Like
+  // for `asStaticView` above, this is cheap, but the view is only valid as long
+  // as the original table is valid and unchanged.
+  IdTable<T, NumColumns, ColumnStorage, IsView::True> asRowRangeView(
+      size_t beginRow, size_t endRow) const {
+    AD_CONTRACT_CHECK(beginRow <= endRow && endRow <= numRows());
+    ViewSpans viewSpans;
+    viewSpans.reserve(numColumns());
+    for (size_t i = 0; i < numColumns(); ++i) {
+      viewSpans.push_back(getColumn(i).subspan(beginRow, endRow - beginRow));
+    }
+    return IdTable<T, NumColumns, ColumnStorage, IsView::True>{
+        std::move(viewSpans), numColumns_, endRow - beginRow, allocator_};
+  }
+
   // Obtain a dynamic and const view to this IdTable that contains a subset of
   // the columns that may be permuted. The subset of the columns is specified by
   // the argument `columnIndices`.
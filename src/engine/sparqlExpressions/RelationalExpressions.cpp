@@ -485,6 +485,49 @@ RelationalExpression<comp>::getPrefilterExpressionForMetadata(
   return tryGetPrefilterExprVariablePairVec(child1, child0, true);
 }
 
+// _____________________________________________________________________________
+template <Comparison comp>
+std::optional<SparqlExpression::ComparisonWithConstant>
+RelationalExpression<comp>::getComparisonWithConstant(
+    const LocalVocabContext& context) const {
+  using enum Comparison;
+  using Result = std::optional<ComparisonWithConstant>;
+  const auto tryGetComparison = [&context](
+                                    const SparqlExpression* variableChild,
+                                    const SparqlExpression* constantChild,
+                                    Comparison comparison) -> Result {
+    auto variable = variableChild->getVariableOrNullopt();
+    auto value = detail::getIdOrLocalVocabEntryFromLiteralExpression(
+        constantChild, context);
+    if (!variable.has_value() || !value.has_value()) {
+      return std::nullopt;
+    }
+    return ComparisonWithConstant{std::move(variable.value()), comparison,
+                                  std::move(value.value())};
+  };
+  // For `constant < ?var` we return `?var > constant`, etc.
+  constexpr Comparison mirrored = [] {
+    switch (comp) {
+      case LT:
+        return GT;
+      case LE:
+        return GE;
+      case GE:
+        return LE;
+      case GT:
+        return LT;
+      default:
+        return comp;
+    }
+  }();
+  const SparqlExpression* child0 = children_.at(0).get();
+  const SparqlExpression* child1 = children_.at(1).get();
+  if (auto result = tryGetComparison(child0, child1, comp)) {
+    return result;
+  }
+  return tryGetComparison(child1, child0, mirrored);
+}
+
 // _____________________________________________________________________________
 ql::span<SparqlExpression::Ptr> InExpression::childrenImpl() {
   return children_;
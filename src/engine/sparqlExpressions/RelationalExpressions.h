@@ -41,6 +41,12 @@ class RelationalExpression : public SparqlExpression {
   // the appropriate data.
   std::optional<LangFilterData> getLanguageFilterExpression() const override;
 
+  // Check if this expression has the form `?var < constant` or
+  // `constant < ?var` (or one of the other comparisons) and return the
+  // appropriate data.
+  std::optional<ComparisonWithConstant> getComparisonWithConstant(
+      const LocalVocabContext& context) const override;
+
   // If this `RelationalExpression` is binary evaluable, return the
   // corresponding `PrefilterExpression` for the pre-filtering procedure on
   // `CompressedBlockMetadata`. In addition we return the `Variable` that
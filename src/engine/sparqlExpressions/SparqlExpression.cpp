@@ -94,6 +94,14 @@ std::optional<LangFilterData> SparqlExpression::getLanguageFilterExpression()
   return std::nullopt;
 }
 
+// _____________________________________________________________________________
+using ComparisonWithConstant = SparqlExpressionPimpl::ComparisonWithConstant;
+std::optional<ComparisonWithConstant>
+SparqlExpression::getComparisonWithConstant(
+    [[maybe_unused]] const LocalVocabContext& context) const {
+  return std::nullopt;
+}
+
 // _____________________________________________________________________________
 using Estimates = SparqlExpressionPimpl::Estimates;
 Estimates SparqlExpression::getEstimatesForFilterExpression(
@@ -95,6 +95,11 @@ class SparqlExpression {
   using LangFilterData = SparqlExpressionPimpl::LangFilterData;
   virtual std::optional<LangFilterData> getLanguageFilterExpression() const;
 
+  // ___________________________________________________________________________
+  using ComparisonWithConstant = SparqlExpressionPimpl::ComparisonWithConstant;
+  virtual std::optional<ComparisonWithConstant> getComparisonWithConstant(
+      const LocalVocabContext& context) const;
+
   // ___________________________________________________________________________
   using Estimates = SparqlExpressionPimpl::Estimates;
   virtual Estimates getEstimatesForFilterExpression(
@@ -100,6 +100,13 @@ auto SparqlExpressionPimpl::getEstimatesForFilterExpression(
                                                  primarySortKeyVariable);
 }
 
+// _____________________________________________________________________________
+auto SparqlExpressionPimpl::getComparisonWithConstant(
+    const LocalVocabContext& context) const
+    -> std::optional<ComparisonWithConstant> {
+  return _pimpl->getComparisonWithConstant(context);
+}
+
 //_____________________________________________________________________________
 std::vector<PrefilterExprVariablePair>
 SparqlExpressionPimpl::getPrefilterExpressionForMetadata(
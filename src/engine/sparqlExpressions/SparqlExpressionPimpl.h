@@ -109,6 +109,20 @@ class SparqlExpressionPimpl {
   // return the variable and the language. Else return `std::nullopt`.
   std::optional<LangFilterData> getLanguageFilterExpression() const;
 
+  // Struct to store the comparison of a variable with a constant, e.g.
+  // `?x < 42`.
+  struct ComparisonWithConstant {
+    Variable variable_;
+    valueIdComparators::Comparison comparison_;
+    prefilterExpressions::IdOrLocalVocabEntry value_;
+  };
+  // If `this` is an expression of the form `?variable < constant` (or one of
+  // the other comparisons, or with the constant on the left side), return the
+  // variable, the comparison (with the variable on the left side), and the
+  // constant. Else return `std::nullopt`.
+  std::optional<ComparisonWithConstant> getComparisonWithConstant(
+      const LocalVocabContext& context) const;
+
   // Return the size and cost estimate for this expression if it is used as the
   // expression of a `FILTER` clause given that the input has `inputSize` many
   // elements and the input is sorted by the variable `firstSortedVariable`.
@@ -148,6 +148,10 @@ constexpr inline std::string_view
     QLEVER_INTERNAL_VARIABLE_QUERY_PLANNER_PREFIX =
         "?_QLever_internal_variable_qp_";
 
+constexpr inline std::string_view
+    QLEVER_INTERNAL_VARIABLE_QUERY_PLAN_CACHE_PREFIX =
+        "?_QLever_internal_variable_qpc_";
+
 constexpr inline std::string_view SCORE_VARIABLE_PREFIX = "?ql_score_";
 constexpr inline std::string_view MATCHINGWORD_VARIABLE_PREFIX =
     "?ql_matchingword_";
@@ -27,24 +27,40 @@ RuntimeParameters::RuntimeParameters() {
   add(cacheMaxSizeSingleEntry_);
   add(lazyIndexScanQueueSize_);
   add(lazyIndexScanNumThreads_);
+  add(lazyIndexScanIoBatchSize_);
   add(lazyIndexScanMaxSizeMaterialization_);
   add(useBinsearchTransitivePath_);
+  add(transitivePathMultiSourceBfsBatchSize_);
+  add(transitivePathMultiSourceBfsNumThreads_);
+  add(transitivePathUseReachabilityIndex_);
   add(groupByHashMapEnabled_);
+  add(groupByHashMapNumThreads_);
+  add(hashJoinEnabled_);
+  add(multiwayJoinEnabled_);
   add(groupByDisableIndexScanOptimizations_);
   add(serviceMaxValueRows_);
+  add(serviceBindJoinParallelism_);
   add(serviceMaxRedirects_);
   add(queryPlanningBudget_);
   add(throwOnUnboundVariables_);
   add(cacheMaxSizeLazyResult_);
+  add(diskCacheMaxSize_);
+  add(diskCacheMinComputationTime_);
+  add(queryMemoryLimit_);
   add(websocketUpdatesEnabled_);
   add(smallIndexScanSizeEstimateDivisor_);
   add(zeroCostEstimateForCachedSubtree_);
+  add(adaptiveReoptimizationFactor_);
   add(requestBodyLimit_);
   add(cacheServiceResults_);
   add(syntaxTestMode_);
   add(divisionByZeroIsUndef_);
   add(enablePrefilterOnIndexScans_);
+  add(expressionEvaluationNumThreads_);
+  add(expressionEvaluationMorselSize_);
   add(spatialJoinMaxNumThreads_);
+  add(pathSearchMaxNumThreads_);
+  add(pathSearchGraphCacheMaxSize_);
   add(spatialJoinPrefilterMaxSize_);
   add(enableDistributiveUnion_);
   add(treatDefaultGraphAsNamedGraph_);
@@ -52,11 +68,16 @@ RuntimeParameters::RuntimeParameters() {
   add(materializedViewWriterMemory_);
   add(defaultQueryTimeout_);
   add(sortInMemoryThreshold_);
+  add(sortTopKMaxNumRows_);
   add(prefilteredOptionalJoin_);
   add(enableMaterializedViewQueryRewrite_);
   add(serviceAllowedIriPrefixes_);
   add(permutationWriterNumThreads_);
   add(vacuumMinimumBlockSize_);
+  add(updateWalCompactionThreshold_);
+  add(updateLocateNumThreads_);
+  add(updateGroupCommitWindow_);
+  add(queryPlanCacheMaxNumEntries_);
   add(disableCaching_);
   add(logLevel_);
   add(constructDeduplication_);
@@ -67,6 +88,23 @@ RuntimeParameters::RuntimeParameters() {
   logLevel_.setOnUpdateAction(
       [](LogLevel level) { ad_utility::setRuntimeLogLevel(level); });
 
+  expressionEvaluationMorselSize_.setParameterConstraint(
+      [](size_t value, std::string_view parameterName) {
+        if (value == 0) {
+          throw std::runtime_error{absl::StrCat(
+              "Parameter ", parameterName, " must be strictly positive")};
+        }
+      });
+
+  transitivePathMultiSourceBfsBatchSize_.setParameterConstraint(
+      [](size_t value, std::string_view parameterName) {
+        if (value % 64 != 0) {
+          throw std::runtime_error{absl::StrCat(
+              "Parameter ", parameterName, " must be a multiple of 64, was ",
+              value)};
+        }
+      });
+
   defaultQueryTimeout_.setParameterConstraint(
       [](std::chrono::seconds value, std::string_view parameterName) {
         if (value <= std::chrono::seconds{0}) {
@@ -56,15 +56,56 @@ struct RuntimeParameters {
       ad_utility::MemorySize::gigabytes(5), "cache-max-size-single-entry"};
   SizeT lazyIndexScanQueueSize_{20, "lazy-index-scan-queue-size"};
   SizeT lazyIndexScanNumThreads_{10, "lazy-index-scan-num-threads"};
+  // The number of consecutive blocks of a lazy index scan whose columns are
+  // read from disk with a single batch of reads (via io_uring if available).
+  // A value of 0 disables the batching, then each column of each block is read
+  // separately with a blocking `pread`.
+  SizeT lazyIndexScanIoBatchSize_{16, "lazy-index-scan-io-batch-size"};
   Duration<std::chrono::seconds> defaultQueryTimeout_{std::chrono::seconds(30),
                                                       "default-query-timeout"};
   SizeT lazyIndexScanMaxSizeMaterialization_{
       1'000'000, "lazy-index-scan-max-size-materialization"};
   Bool useBinsearchTransitivePath_{true, "use-binsearch-transitive-path"};
-  Bool groupByHashMapEnabled_{false, "group-by-hash-map-enabled"};
+  // The number of start nodes for which a `TransitivePath` computes the
+  // reachable nodes at once with a multi-source BFS on the graph of its
+  // strongly connected components (see `TransitivePathMultiSourceBfs.h`). Must
+  // be a multiple of 64, 0 disables the multi-source BFS. The multi-source BFS
+  // is only used for a table with at least this many start nodes, because
+  // building the graph touches all the edges. The batches are processed by up
+  // to the given number of threads (0 means one thread per core).
+  SizeT transitivePathMultiSourceBfsBatchSize_{
+      64, "transitive-path-multi-source-bfs-batch-size"};
+  SizeT transitivePathMultiSourceBfsNumThreads_{
+      1, "transitive-path-multi-source-bfs-num-threads"};
+  // If true, a `TransitivePath` over a single predicate with a bound side is
+  // answered with the `ReachabilityIndex` of the predicate (if one was built).
+  Bool transitivePathUseReachabilityIndex_{
+      true, "transitive-path-use-reachability-index"};
+  // If true, a GROUP BY with only supported aggregates on top of a `Sort`
+  // skips the sort and aggregates the unsorted input using a hash map (unless
+  // the sorted input is already cached).
+  Bool groupByHashMapEnabled_{true, "group-by-hash-map-enabled"};
+  // The number of threads for the hash map aggregation of GROUP BY. With more
+  // than one thread, input blocks with at least two chunks of
+  // `GROUP_BY_HASH_MAP_MIN_ROWS_PER_THREAD` rows are pre-aggregated in parallel
+  // and the groups are merged in partitions (split by the hash of the group
+  // values). Smaller inputs are always aggregated by a single thread.
+  SizeT groupByHashMapNumThreads_{8, "group-by-hash-map-num-threads"};
+  // If true, the query planner also considers a `HashJoin` for joins on a
+  // single column where at least one of the inputs is not sorted.
+  Bool hashJoinEnabled_{false, "hash-join-enabled"};
+  // If true, the query planner also considers a `MultiwayJoin` (a worst-case
+  // optimal join) for the cyclic parts of a basic graph pattern, e.g. the
+  // triples of a triangle.
+  Bool multiwayJoinEnabled_{false, "multiway-join-enabled"};
   Bool groupByDisableIndexScanOptimizations_{
       false, "group-by-disable-index-scan-optimizations"};
   SizeT serviceMaxValueRows_{10'000, "service-max-value-rows"};
+  // If non-zero, a SERVICE whose sibling result has more distinct values than
+  // `service-max-value-rows` is computed as a bind join: the values are sent
+  // in batches of `service-max-value-rows` rows (one request per batch), with
+  // up to this many requests at the same time.
+  SizeT serviceBindJoinParallelism_{0, "service-bind-join-parallelism"};
   SizeT serviceMaxRedirects_{1, "service-max-redirects"};
   SizeT queryPlanningBudget_{1500, "query-planning-budget"};
   Bool throwOnUnboundVariables_{false, "throw-on-unbound-variables"};
@@ -74,6 +115,22 @@ struct RuntimeParameters {
   MemorySizeParameter cacheMaxSizeLazyResult_{
       ad_utility::MemorySize::megabytes(5), "cache-max-size-lazy-result"};
 
+  // The maximal total size of the results in the disk tier of the cache (see
+  // `DiskResultCache.h`), and the minimal time that computing a result must
+  // have taken for it to be written to the disk tier. The disk tier is only
+  // used if a directory for it is configured.
+  MemorySizeParameter diskCacheMaxSize_{ad_utility::MemorySize::gigabytes(100),
+                                        "disk-cache-max-size"};
+  Duration<std::chrono::milliseconds> diskCacheMinComputationTime_{
+      std::chrono::milliseconds(1000), "disk-cache-min-computation-time"};
+
+  // If non-zero, the maximal amount of memory that a single query may
+  // allocate (in addition to the global memory limit for all queries). It can
+  // be changed for a single query with the `memory-limit` request parameter
+  // (values above this one require a valid access token).
+  MemorySizeParameter queryMemoryLimit_{ad_utility::MemorySize::bytes(0),
+                                        "query-memory-limit"};
+
   // Control if websockets are enable to post live query updates, and if they
   // are control the throttle of how many request can be sent at once.
   Bool websocketUpdatesEnabled_{true, "websocket-updates-enabled"};
@@ -88,6 +145,11 @@ struct RuntimeParameters {
   // set to zero in query planning.
   Bool zeroCostEstimateForCachedSubtree_{
       false, "zero-cost-estimate-for-cached-subtree"};
+  // If non-zero, queries are planned adaptively: The joins and filters of the
+  // plan are executed bottom-up, and when the size of one of these results
+  // differs from its estimate by more than this factor, the rest of the query
+  // is planned again with the exact size (see `AdaptiveQueryPlanning.h`).
+  Double adaptiveReoptimizationFactor_{0.0, "adaptive-reoptimization-factor"};
   // Maximum size for the body of requests that the server will process.
   MemorySizeParameter requestBodyLimit_{ad_utility::MemorySize::gigabytes(1),
                                         "request-body-limit"};
@@ -119,8 +181,23 @@ struct RuntimeParameters {
   // prefilter-free baseline, or for debugging, as wrong results may be
   // related to the `PrefilterExpression`s.
   Bool enablePrefilterOnIndexScans_{true, "enable-prefilter-on-index-scans"};
+  // The number of threads that evaluate the expressions of `FILTER`s and
+  // `BIND`s in parallel. The input is split into morsels of the given number of
+  // rows, which are processed independently. With a value of 1, the
+  // expressions are evaluated on a single thread.
+  SizeT expressionEvaluationNumThreads_{1, "expression-evaluation-num-threads"};
+  SizeT expressionEvaluationMorselSize_{100'000,
+                                        "expression-evaluation-morsel-size"};
   // The maximum number of threads to be used in `SpatialJoinAlgorithms`.
   SizeT spatialJoinMaxNumThreads_{8, "spatial-join-max-num-threads"};
+  // The maximum number of threads to be used by the `SHORTEST_PATH` and
+  // `K_SHORTEST_PATHS` algorithms of the `PathSearch` (0 means one thread per
+  // core).
+  SizeT pathSearchMaxNumThreads_{8, "path-search-max-num-threads"};
+  // The maximal total size of the graphs in the `CsrGraphCache` of the
+  // `PathSearch`.
+  MemorySizeParameter pathSearchGraphCacheMaxSize_{
+      ad_utility::MemorySize::gigabytes(1), "path-search-graph-cache-max-size"};
   // The maximum size of the `prefilterBox` for
   // `SpatialJoinAlgorithms::libspatialjoinParse()`.
   SizeT spatialJoinPrefilterMaxSize_{2'500, "spatial-join-prefilter-max-size"};
@@ -147,6 +224,11 @@ struct RuntimeParameters {
   MemorySizeParameter sortInMemoryThreshold_{
       ad_utility::MemorySize::gigabytes(5), "sort-in-memory-threshold"};
 
+  // If an `ORDER BY` (or an `INTERNAL SORT BY`) has a `LIMIT` and the limit
+  // plus the offset is at most this value, then only the first rows are
+  // computed (Top-K), without materializing and sorting the complete input.
+  SizeT sortTopKMaxNumRows_{100'000, "sort-top-k-max-num-rows"};
+
   Bool prefilteredOptionalJoin_{true, "prefiltered-optional-join"};
 
   // If set, the query planner checks if suitable materialized views are loaded
@@ -176,6 +258,31 @@ struct RuntimeParameters {
   // Only blocks of this size or larger will be considered for vacuuming.
   SizeT vacuumMinimumBlockSize_{100, "vacuum-minimum-block-size"};
 
+  // Persisted updates are appended to a write-ahead log. When the log is
+  // larger than this threshold and than the last complete snapshot of the
+  // updates, a new snapshot is written in the background and the log is
+  // started anew.
+  MemorySizeParameter updateWalCompactionThreshold_{
+      ad_utility::MemorySize::megabytes(64), "update-wal-compaction-threshold"};
+
+  // The number of threads that are used to locate the triples of an update in
+  // the permutations and to add them to the located triples. The permutations
+  // are processed concurrently, and large updates are additionally split into
+  // chunks per permutation. Updates with fewer than
+  // `LocatedTriple::minNumTriplesPerThread` triples always use one thread.
+  SizeT updateLocateNumThreads_{8, "update-locate-num-threads"};
+
+  // If non-zero, SPARQL updates that arrive within this window are committed
+  // as one batch with a single update of the metadata, a single write to disk,
+  // and a single update of the snapshot for queries (group commit).
+  Duration<std::chrono::milliseconds> updateGroupCommitWindow_{
+      std::chrono::milliseconds(0), "update-group-commit-window"};
+
+  // The maximal number of query templates (queries modulo the constants in
+  // the triples of the query body) for which the query plan is cached, see
+  // `QueryPlanCache.h`. A value of 0 disables the plan cache.
+  SizeT queryPlanCacheMaxNumEntries_{0, "query-plan-cache-max-num-entries"};
+
   // The runtime log level. Messages with a higher level are suppressed. The
   // compile-time level (CMake LOGLEVEL) still applies as an upper bound.
   LogLevelParameter logLevel_{LogLevel{ad_utility::detail::defaultLogLevel},
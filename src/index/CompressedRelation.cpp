@@ -6,6 +6,7 @@
 
 #include "index/CompressedRelation.h"
 
+#include <numeric>
 #include <thread>
 
 #include "engine/idTable/CompressedExternalIdTable.h"
@@ -17,8 +18,9 @@
 #include "index/GraphComputation.h"
 #include "index/IdTableUtils.h"
 #include "index/LocatedTriples.h"
-#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/IoUringManager.h"
 #include "util/Iterators.h"
+#include "util/Metrics.h"
 #include "util/ThreadSafeQueue.h"
 #include "util/Timer.h"
 #include "util/TypeTraits.h"
@@ -136,6 +138,150 @@ static void pruneBlock(T& block, LimitOffsetClause& limitOffset) {
   }
 }
 
+namespace {
+// Read the compressed columns of the blocks in the range `[begin, end)` from
+// the permutation file in batches of `numBlocksPerBatch` consecutive blocks.
+// All the column reads of a batch are submitted at once via a
+// `ad_utility::BatchIoManagerWithFallback` (io_uring if QLever was built with
+// liburing and the kernel allows it, blocking `pread`s otherwise). The reads
+// of the next batch are always submitted before the blocks of the current
+// batch are handed out, so the decompression of the current batch (which is
+// done by the caller) overlaps with the reads of the next batch that are still
+// in flight.
+//
+// NOTE: This class is not threadsafe, the caller has to make sure that `next()`
+// is never called concurrently.
+template <typename It>
+class BatchedCompressedBlockReader {
+ public:
+  // A single block of the range, `block_` is `nullopt` if the block was
+  // skipped because of the graph filter and thus was never read.
+  struct Entry {
+    size_t indexInRange_;
+    CompressedBlockMetadata metadata_;
+    std::optional<CompressedBlock> block_;
+  };
+
+  // Statistics about the submitted batches, see the corresponding members of
+  // `CompressedRelationReader::LazyScanMetadata`. They are atomic because they
+  // are read by the consumer of the scan while the producers are working.
+  struct Statistics {
+    std::atomic<size_t> numBatches_ = 0;
+    std::atomic<size_t> numBytesRead_ = 0;
+    std::atomic<size_t> maxQueueDepth_ = 0;
+  };
+
+ private:
+  struct Batch {
+    std::vector<Entry> entries_;
+    size_t nextEntry_ = 0;
+    uint64_t handle_ = 0;
+  };
+
+  It begin_;
+  It current_;
+  It end_;
+  int fd_;
+  const CompressedRelationReader::ScanImplConfig& scanConfig_;
+  size_t numBlocksPerBatch_;
+  Statistics statistics_;
+
+  // Note: The buffers of the batches must outlive the `ioManager_`, as it
+  // drains the reads that are still in flight on destruction. The members are
+  // destroyed in the reverse order of their declaration.
+  std::optional<Batch> currentBatch_;
+  std::optional<Batch> inFlightBatch_;
+  bool started_ = false;
+  ad_utility::BatchIoManagerWithFallback ioManager_;
+
+ public:
+  BatchedCompressedBlockReader(
+      It begin, It end, int fd,
+      const CompressedRelationReader::ScanImplConfig& scanConfig,
+      size_t numBlocksPerBatch)
+      : begin_{begin},
+        current_{begin},
+        end_{end},
+        fd_{fd},
+        scanConfig_{scanConfig},
+        numBlocksPerBatch_{numBlocksPerBatch} {
+    AD_CONTRACT_CHECK(numBlocksPerBatch_ > 0);
+  }
+
+  // Return the next block of the range, or `nullopt` if all the blocks have
+  // already been returned.
+  std::optional<Entry> next() {
+    if (!std::exchange(started_, true)) {
+      inFlightBatch_ = submitNextBatch();
+    }
+    if (!currentBatch_.has_value() ||
+        currentBatch_->nextEntry_ == currentBatch_->entries_.size()) {
+      if (!inFlightBatch_.has_value()) {
+        return std::nullopt;
+      }
+      ioManager_.wait(inFlightBatch_->handle_);
+      currentBatch_ = std::move(inFlightBatch_);
+      // Start reading the next batch before the blocks of the current batch
+      // are decompressed.
+      inFlightBatch_ = submitNextBatch();
+    }
+    return std::move(currentBatch_->entries_[currentBatch_->nextEntry_++]);
+  }
+
+  const Statistics& statistics() const { return statistics_; }
+
+ private:
+  // Submit the reads for the next (up to) `numBlocksPerBatch_` blocks. Return
+  // `nullopt` if there are no more blocks.
+  std::optional<Batch> submitNextBatch() {
+    if (current_ == end_) {
+      return std::nullopt;
+    }
+    Batch batch;
+    // Reserve the space up front, so that the entries (and therefore the
+    // target buffers of the reads) never move.
+    batch.entries_.reserve(std::min<size_t>(
+        numBlocksPerBatch_, static_cast<size_t>(end_ - current_)));
+    std::vector<size_t> numBytes;
+    std::vector<uint64_t> offsets;
+    std::vector<char*> buffers;
+    const auto& columns = scanConfig_.scanColumns_;
+    for (size_t i = 0; i < numBlocksPerBatch_ && current_ != end_;
+         ++i, ++current_) {
+      auto& entry = batch.entries_.emplace_back(Entry{
+          static_cast<size_t>(current_ - begin_), *current_, std::nullopt});
+      if (scanConfig_.graphFilter_.canBlockBeSkipped(entry.metadata_)) {
+        continue;
+      }
+      auto& block = entry.block_.emplace(columns.size());
+      for (size_t j = 0; j < columns.size(); ++j) {
+        auto [offsetInFile, compressedSize, codec] =
+            entry.metadata_.getOffsetAndCompressedSizeForColumn(columns[j]);
+        block[j].resize(compressedSize);
+        if (compressedSize == 0) {
+          continue;
+        }
+        numBytes.push_back(compressedSize);
+        offsets.push_back(static_cast<uint64_t>(offsetInFile));
+        buffers.push_back(block[j].data());
+      }
+    }
+    batch.handle_ = ioManager_.addBatch(fd_, numBytes, offsets, buffers);
+    if (!numBytes.empty()) {
+      auto numBytesInBatch =
+          std::accumulate(numBytes.begin(), numBytes.end(), size_t{0});
+      statistics_.numBatches_ += 1;
+      statistics_.numBytesRead_ += numBytesInBatch;
+      ad_utility::metrics::globalMetrics().bytesReadFromPermutations_.add(
+          numBytesInBatch);
+      statistics_.maxQueueDepth_ =
+          std::max(statistics_.maxQueueDepth_.load(), numBytes.size());
+    }
+    return batch;
+  }
+};
+}  // namespace
+
 // ____________________________________________________________________________
 template <typename T>
 CompressedRelationReader::IdTableGeneratorInputRange
@@ -160,6 +306,18 @@ CompressedRelationReader::asyncParallelBlockGenerator(
     ad_utility::Timer popTimer_{
         ad_utility::timer::Timer::InitialStatus::Stopped};
     std::mutex blockIteratorMutex_;
+    // Only set if the reads are batched (see `lazy-index-scan-io-batch-size`).
+    // Guarded by the `blockIteratorMutex_`.
+    std::optional<BatchedCompressedBlockReader<T>> batchedReader_;
+    // The values of the `batchedReader_`'s statistics that have already been
+    // added to the `details()`.
+    size_t numIoBatchesReported_ = 0;
+    size_t numIoBytesReadReported_ = 0;
+    // NOTE: The `queue_` must be declared after all the members that are used
+    // by its producer threads (in particular the `batchedReader_`), because
+    // these threads are only joined when the `queue_` is destroyed, which
+    // might happen before all the blocks have been consumed (e.g. because of
+    // a LIMIT).
     ad_utility::InputRangeTypeErased<
         std::optional<DecompressedBlockAndMetadata>>
         queue_;
@@ -182,6 +340,12 @@ CompressedRelationReader::asyncParallelBlockGenerator(
           getRuntimeParameter<&RuntimeParameters::lazyIndexScanNumThreads_>()};
       auto queueSize{
           getRuntimeParameter<&RuntimeParameters::lazyIndexScanQueueSize_>()};
+      auto ioBatchSize{
+          getRuntimeParameter<&RuntimeParameters::lazyIndexScanIoBatchSize_>()};
+      if (ioBatchSize > 0) {
+        batchedReader_.emplace(beginBlock_, endBlock_, reader_->file_.fd(),
+                               scanConfig_, ioBatchSize);
+      }
       auto producer{std::bind(&Generator::readAndDecompressBlock, this)};
 
       // Prepare queue for reading and decompressing blocks concurrently using
@@ -197,6 +361,20 @@ CompressedRelationReader::asyncParallelBlockGenerator(
     readAndDecompressBlock() {
       cancellationHandle_->throwIfCancelled();
       std::unique_lock lock{blockIteratorMutex_};
+      if (batchedReader_.has_value()) {
+        auto entry = batchedReader_->next();
+        lock.unlock();
+        if (!entry.has_value()) {
+          return std::nullopt;
+        }
+        if (!entry->block_.has_value()) {
+          return std::pair{entry->indexInRange_, std::nullopt};
+        }
+        return std::pair{entry->indexInRange_,
+                         std::optional{reader_->decompressAndPostprocessBlock(
+                             entry->block_.value(), scanConfig_,
+                             entry->metadata_)}};
+      }
       if (blockMetadataIterator_ == endBlock_) {
         return std::nullopt;
       }
@@ -223,9 +401,8 @@ CompressedRelationReader::asyncParallelBlockGenerator(
 
       lock.unlock();
       auto decompressedBlockAndMetadata =
-          reader_->decompressAndPostprocessBlock(compressedBlock,
-                                                 blockMetadata.numRows_,
-                                                 scanConfig_, blockMetadata);
+          reader_->decompressAndPostprocessBlock(compressedBlock, scanConfig_,
+                                                 blockMetadata);
       return std::pair{myIndex,
                        std::optional{std::move(decompressedBlockAndMetadata)}};
     };
@@ -244,6 +421,7 @@ CompressedRelationReader::asyncParallelBlockGenerator(
         popTimer_.stop();
 
         details().blockingTime_ = popTimer_.msecs();
+        updateIoStatistics();
 
         if (item == std::nullopt) {
           break;
@@ -274,6 +452,24 @@ CompressedRelationReader::asyncParallelBlockGenerator(
 
       return std::nullopt;
     }
+
+    // Add the statistics of the `batchedReader_` that have been gathered since
+    // the last call to the `details()`.
+    void updateIoStatistics() {
+      if (!batchedReader_.has_value()) {
+        return;
+      }
+      const auto& statistics = batchedReader_->statistics();
+      auto numBatches = statistics.numBatches_.load();
+      auto numBytesRead = statistics.numBytesRead_.load();
+      auto& d = details();
+      d.numIoBatches_ += numBatches - numIoBatchesReported_;
+      d.numIoBytesRead_ += numBytesRead - numIoBytesReadReported_;
+      d.maxIoQueueDepth_ =
+          std::max(d.maxIoQueueDepth_, statistics.maxQueueDepth_.load());
+      numIoBatchesReported_ = numBatches;
+      numIoBytesReadReported_ = numBytesRead;
+    }
   };
 
   // There is a std::mutex in the generator, so we cannot copy or move it,
@@ -549,7 +745,8 @@ IdTable CompressedRelationReader::readBlockWithoutLocatedTriples(
                               std::move(additionalColumns), {});
   CompressedBlock compressedColumns =
       readCompressedBlockFromFile(block, config.scanColumns_);
-  auto decompressedBlock = decompressBlock(compressedColumns, block.numRows_);
+  auto decompressedBlock =
+      decompressBlock(compressedColumns, block, config.scanColumns_);
   return decompressedBlock;
 }
 
@@ -1145,18 +1342,27 @@ CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
     auto& currentCol = compressedBuffer[i];
     currentCol.resize(offset.compressedSize_);
     file_.read(currentCol.data(), offset.compressedSize_, offset.offsetInFile_);
+    ad_utility::metrics::globalMetrics().bytesReadFromPermutations_.add(
+        offset.compressedSize_);
   }
   return compressedBuffer;
 }
 
 // ____________________________________________________________________________
 DecompressedBlock CompressedRelationReader::decompressBlock(
-    const CompressedBlock& compressedBlock, size_t numRowsToRead) const {
+    const CompressedBlock& compressedBlock,
+    const CompressedBlockMetadata& blockMetadata,
+    ColumnIndicesRef columnIndices) const {
+  AD_CORRECTNESS_CHECK(compressedBlock.size() == columnIndices.size());
   DecompressedBlock decompressedBlock{compressedBlock.size(), allocator_};
-  decompressedBlock.resize(numRowsToRead);
+  decompressedBlock.resize(blockMetadata.numRows_);
+  // TODO<C++23> Use `ql::views::zip`
   for (size_t i = 0; i < compressedBlock.size(); ++i) {
-    auto col = decompressedBlock.getColumn(i);
-    decompressColumn(compressedBlock[i], numRowsToRead, col.data());
+    auto codec =
+        blockMetadata.getOffsetAndCompressedSizeForColumn(columnIndices[i])
+            .codec_;
+    decompressColumn(compressedBlock[i], codec,
+                     decompressedBlock.getColumn(i));
   }
   return decompressedBlock;
 }
@@ -1164,10 +1370,11 @@ DecompressedBlock CompressedRelationReader::decompressBlock(
 // ____________________________________________________________________________
 DecompressedBlockAndMetadata
 CompressedRelationReader::decompressAndPostprocessBlock(
-    const CompressedBlock& compressedBlock, size_t numRowsToRead,
+    const CompressedBlock& compressedBlock,
     const CompressedRelationReader::ScanImplConfig& scanConfig,
     const CompressedBlockMetadata& metadata) const {
-  auto decompressedBlock = decompressBlock(compressedBlock, numRowsToRead);
+  auto decompressedBlock =
+      decompressBlock(compressedBlock, metadata, scanConfig.scanColumns_);
   auto [numIndexColumns, includeGraphColumn] =
       prepareLocatedTriples(scanConfig.scanColumns_);
   bool hasUpdates = false;
@@ -1190,15 +1397,10 @@ CompressedRelationReader::decompressAndPostprocessBlock(
 }
 
 // ____________________________________________________________________________
-template <typename Iterator>
 void CompressedRelationReader::decompressColumn(
-    const std::vector<char>& compressedBlock, size_t numRowsToRead,
-    Iterator iterator) {
-  auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
-      compressedBlock.data(), compressedBlock.size(), iterator,
-      numRowsToRead * sizeof(*iterator));
-  static_assert(sizeof(Id) == sizeof(*iterator));
-  AD_CORRECTNESS_CHECK(numRowsToRead * sizeof(Id) == numBytesActuallyRead);
+    const std::vector<char>& compressedColumn, ColumnCodec codec,
+    ql::span<Id> target) {
+  columnCodecs::decompress(compressedColumn, codec, target);
 }
 
 // ____________________________________________________________________________
@@ -1211,21 +1413,20 @@ CompressedRelationReader::readAndDecompressBlock(
   }
   CompressedBlock compressedColumns =
       readCompressedBlockFromFile(blockMetaData, scanConfig.scanColumns_);
-  const auto numRowsToRead = blockMetaData.numRows_;
-  return decompressAndPostprocessBlock(compressedColumns, numRowsToRead,
-                                       scanConfig, blockMetaData);
+  return decompressAndPostprocessBlock(compressedColumns, scanConfig,
+                                       blockMetaData);
 }
 
 // ____________________________________________________________________________
 CompressedBlockMetadata::OffsetAndCompressedSize
 CompressedRelationWriter::compressAndWriteColumn(ql::span<const Id> column) {
-  std::vector<char> compressedBlock = ZstdWrapper::compress(
-      (void*)(column.data()), column.size() * sizeof(column[0]));
+  auto [compressedBlock, codec] =
+      columnCodecs::compressWithSmallestCodec(column);
   auto compressedSize = compressedBlock.size();
   auto file = outfile_.wlock();
   auto offsetInFile = file->tell();
   file->write(compressedBlock.data(), compressedBlock.size());
-  return {offsetInFile, compressedSize};
+  return {offsetInFile, compressedSize, codec};
 }
 
 // _____________________________________________________________________________
@@ -1884,4 +2085,7 @@ void CompressedRelationReader::LazyScanMetadata::aggregate(
   numBlocksSkippedBecauseOfGraph_ += newValue.numBlocksSkippedBecauseOfGraph_;
   numBlocksPostprocessed_ += newValue.numBlocksPostprocessed_;
   numBlocksWithUpdate_ += newValue.numBlocksWithUpdate_;
+  numIoBatches_ += newValue.numIoBatches_;
+  numIoBytesRead_ += newValue.numIoBytesRead_;
+  maxIoQueueDepth_ = std::max(maxIoQueueDepth_, newValue.maxIoQueueDepth_);
 }
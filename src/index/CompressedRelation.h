@@ -14,6 +14,7 @@
 #include "backports/type_traits.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
+#include "index/IdColumnCodecs.h"
 #include "index/KeyOrder.h"
 #include "index/ScanSpecification.h"
 #include "parser/data/LimitOffsetClause.h"
@@ -57,12 +58,15 @@ using CompressedBlock = std::vector<std::vector<char>>;
 // The metadata of a compressed block of ID triples in an index permutation.
 struct CompressedBlockMetadataNoBlockIndex {
   // Since we have column-based indices, the two columns of each block are
-  // stored separately (but adjacently).
+  // stored separately (but adjacently). Each column is compressed with its own
+  // `codec_`, see `IdColumnCodecs.h`.
   struct OffsetAndCompressedSize {
     off_t offsetInFile_;
     size_t compressedSize_;
+    ColumnCodec codec_ = ColumnCodec::Zstd;
     QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(OffsetAndCompressedSize,
-                                                offsetInFile_, compressedSize_)
+                                                offsetInFile_, compressedSize_,
+                                                codec_)
   };
 
   using GraphInfo = std::optional<std::vector<Id>>;
@@ -199,10 +203,32 @@ struct CompressedBlockMetadata : CompressedBlockMetadataNoBlockIndex {
   }
 };
 
-// Serialization of the `OffsetAndcompressedSize` subclass.
+// Serialization of the `OffsetAndcompressedSize` subclass. The `codec_` is
+// stored in the (otherwise unused) highest byte of the compressed size. That
+// way, the metadata of indices that were built before the codecs were
+// introduced can still be read, as their highest byte is always zero, which
+// corresponds to `ColumnCodec::Zstd`.
 AD_SERIALIZE_FUNCTION(CompressedBlockMetadata::OffsetAndCompressedSize) {
+  static constexpr size_t codecShift = 56;
+  static constexpr size_t sizeMask = (size_t{1} << codecShift) - 1;
   serializer | arg.offsetInFile_;
-  serializer | arg.compressedSize_;
+  if constexpr (ad_utility::serialization::WriteSerializer<S>) {
+    AD_CORRECTNESS_CHECK(arg.compressedSize_ <= sizeMask);
+    size_t sizeAndCodec =
+        arg.compressedSize_ | (static_cast<size_t>(arg.codec_) << codecShift);
+    serializer | sizeAndCodec;
+  } else {
+    static_assert(ad_utility::serialization::ReadSerializer<S>);
+    size_t sizeAndCodec;
+    serializer | sizeAndCodec;
+    arg.compressedSize_ = sizeAndCodec & sizeMask;
+    auto codec = sizeAndCodec >> codecShift;
+    AD_CORRECTNESS_CHECK(
+        codec <= static_cast<size_t>(columnCodecs::maxColumnCodec),
+        "Unknown column codec in the block metadata, the index was probably "
+        "built with a newer version of QLever");
+    arg.codec_ = static_cast<ColumnCodec>(codec);
+  }
 }
 
 // Serialization of the block metadata.
@@ -468,8 +494,10 @@ class CompressedRelationWriter {
   // data of the written block. Then clear `smallRelationsBuffer_`.
   void writeBufferedRelationsToSingleBlock();
 
-  // Compress the `column` and write it to the `outfile_`. Return the offset and
-  // size of the compressed column in the `outfile_`.
+  // Compress the `column` with the codec that yields the smallest result (see
+  // `columnCodecs::compressWithSmallestCodec`) and write it to the `outfile_`.
+  // Return the offset and size of the compressed column in the `outfile_`
+  // together with the chosen codec.
   CompressedBlockMetadata::OffsetAndCompressedSize compressAndWriteColumn(
       ql::span<const Id> column);
 
@@ -685,6 +713,13 @@ class CompressedRelationReader {
     size_t numElementsRead_ = 0;
     size_t numElementsYielded_ = 0;
     std::chrono::milliseconds blockingTime_ = std::chrono::milliseconds::zero();
+    // Statistics of the batched reads (see `lazy-index-scan-io-batch-size`):
+    // The number of batches that were submitted, the total number of bytes
+    // that were read by them, and the maximal number of reads in a single
+    // batch (which is the queue depth that the disk sees).
+    size_t numIoBatches_ = 0;
+    size_t numIoBytesRead_ = 0;
+    size_t maxIoQueueDepth_ = 0;
 
     // Update this metadata, given the metadata from `blockAndMetadata`.
     // Currently updates: `numBlocksPostprocessed_`, `numBlocksWithUpdate_`,
@@ -886,20 +921,21 @@ class CompressedRelationReader {
       const CompressedBlockMetadata& blockMetaData,
       ColumnIndicesRef columnIndices) const;
 
-  // Decompress the `compressedBlock`. The number of rows that the block will
-  // have after decompression must be passed in via the `numRowsToRead`
-  // argument. It is typically obtained from the corresponding
-  // `CompressedBlockMetaData`.
-  DecompressedBlock decompressBlock(const CompressedBlock& compressedBlock,
-                                    size_t numRowsToRead) const;
-
-  // Helper function used by `decompressBlock` and
-  // `decompressBlockToExistingIdTable`. Decompress the `compressedColumn` and
-  // store the result at the `iterator`. For the `numRowsToRead` argument, see
-  // the documentation of `decompressBlock`.
-  template <typename Iterator>
+  // Decompress the `compressedBlock`, which consists of the columns with the
+  // given `columnIndices` of the block described by the `blockMetadata`. The
+  // metadata determines the number of rows as well as the codec of each of
+  // the columns.
+  DecompressedBlock decompressBlock(
+      const CompressedBlock& compressedBlock,
+      const CompressedBlockMetadata& blockMetadata,
+      ColumnIndicesRef columnIndices) const;
+
+  // Helper function used by `decompressBlock`. Decompress the
+  // `compressedColumn`, which was compressed using the `codec`, and store the
+  // result in the `target`, the size of which must be the number of rows of
+  // the block.
   static void decompressColumn(const std::vector<char>& compressedColumn,
-                               size_t numRowsToRead, Iterator iterator);
+                               ColumnCodec codec, ql::span<Id> target);
 
   // Read and decompress the parts of the block given by `blockMetaData` (which
   // identifies the block) and `scanConfig` (which specifies the part of that
@@ -912,7 +948,7 @@ class CompressedRelationReader {
   // triples (if any) and applying the graph filters (if any), both specified
   // as part of the `scanConfig`.
   DecompressedBlockAndMetadata decompressAndPostprocessBlock(
-      const CompressedBlock& compressedBlock, size_t numRowsToRead,
+      const CompressedBlock& compressedBlock,
       const CompressedRelationReader::ScanImplConfig& scanConfig,
       const CompressedBlockMetadata& metadata) const;
 
@@ -0,0 +1,187 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/CondensedGraph.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+
+using namespace qlever::graphSearch;
+
+namespace {
+using Component = CondensedGraph::Component;
+constexpr Component noComponent = std::numeric_limits<Component>::max();
+}  // namespace
+
+// _____________________________________________________________________________
+CondensedGraph::CondensedGraph(
+    ql::span<const Id> startIds, ql::span<const Id> targetIds,
+    const ad_utility::AllocatorWithLimit<Id>& allocator,
+    const CancellationCheck& checkCancellation)
+    : nodes_{allocator},
+      componentOfNode_{allocator.as<Component>()},
+      componentOffsets_{allocator.as<uint64_t>()},
+      componentNodes_{allocator},
+      successorOffsets_{allocator.as<uint64_t>()},
+      successors_{allocator.as<Component>()},
+      isCyclic_{allocator.as<char>()} {
+  AD_CONTRACT_CHECK(startIds.size() == targetIds.size());
+  const size_t numEdges = startIds.size();
+
+  nodes_.reserve(2 * numEdges);
+  nodes_.insert(nodes_.end(), startIds.begin(), startIds.end());
+  nodes_.insert(nodes_.end(), targetIds.begin(), targetIds.end());
+  ql::ranges::sort(nodes_);
+  nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+  nodes_.shrink_to_fit();
+  AD_CONTRACT_CHECK(nodes_.size() < noComponent,
+                    "The graph to be condensed has too many nodes");
+  const size_t numNodes = nodes_.size();
+  checkCancellation();
+
+  // The graph in the compressed sparse row format with the dense node indices
+  // `0, ..., numNodes - 1`: the successors of the node `v` are
+  // `edgeTargets[i]` for `i` in `offsets[v], ..., offsets[v + 1] - 1`.
+  auto indexOf = [this](Id id) {
+    return static_cast<Component>(ql::ranges::lower_bound(nodes_, id) -
+                                  nodes_.begin());
+  };
+  Vector<uint64_t> offsets(numNodes + 1, 0, allocator.as<uint64_t>());
+  Vector<Component> edgeStarts(numEdges, allocator.as<Component>());
+  Vector<Component> edgeTargets(numEdges, allocator.as<Component>());
+  Vector<char> hasSelfLoop(numNodes, 0, allocator.as<char>());
+  for (size_t edge = 0; edge < numEdges; ++edge) {
+    edgeStarts[edge] = indexOf(startIds[edge]);
+    ++offsets[edgeStarts[edge] + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  {
+    Vector<uint64_t> nextPosition(offsets.begin(), offsets.end() - 1,
+                                  allocator.as<uint64_t>());
+    for (size_t edge = 0; edge < numEdges; ++edge) {
+      Component start = edgeStarts[edge];
+      Component target = indexOf(targetIds[edge]);
+      edgeTargets[nextPosition[start]++] = target;
+      if (start == target) {
+        hasSelfLoop[start] = 1;
+      }
+    }
+  }
+  edgeStarts = Vector<Component>(allocator.as<Component>());
+  checkCancellation();
+
+  // Tarjan's algorithm, with an explicit call stack instead of recursion,
+  // because the paths in the graph can be very long. The members of each
+  // component are appended to `members` in the order in which the components
+  // are found.
+  Vector<Component> index(numNodes, noComponent, allocator.as<Component>());
+  Vector<Component> lowLink(numNodes, noComponent, allocator.as<Component>());
+  Vector<char> onStack(numNodes, 0, allocator.as<char>());
+  Vector<Component> members(allocator.as<Component>());
+  members.reserve(numNodes);
+  std::vector<Component> stack;
+  struct Frame {
+    Component node_;
+    uint64_t nextEdge_;
+  };
+  std::vector<Frame> callStack;
+  componentOfNode_.resize(numNodes);
+  componentOffsets_.push_back(0);
+  Component nextIndex = 0;
+
+  auto visit = [&](Component node) {
+    index[node] = nextIndex;
+    lowLink[node] = nextIndex;
+    ++nextIndex;
+    stack.push_back(node);
+    onStack[node] = 1;
+    callStack.push_back(Frame{node, offsets[node]});
+  };
+
+  for (Component root = 0; root < numNodes; ++root) {
+    if (index[root] != noComponent) {
+      continue;
+    }
+    checkCancellation();
+    visit(root);
+    while (!callStack.empty()) {
+      Frame& frame = callStack.back();
+      const Component node = frame.node_;
+      if (frame.nextEdge_ < offsets[node + 1]) {
+        // Note: `visit` invalidates the reference `frame`.
+        Component successor = edgeTargets[frame.nextEdge_++];
+        if (index[successor] == noComponent) {
+          visit(successor);
+        } else if (onStack[successor]) {
+          lowLink[node] = std::min(lowLink[node], index[successor]);
+        }
+        continue;
+      }
+      callStack.pop_back();
+      if (!callStack.empty()) {
+        Component parent = callStack.back().node_;
+        lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+      }
+      if (lowLink[node] != index[node]) {
+        continue;
+      }
+      // The `node` is the root of a component, which consists of the nodes
+      // on the stack above (and including) it.
+      const auto component = static_cast<Component>(isCyclic_.size());
+      Component member;
+      do {
+        member = stack.back();
+        stack.pop_back();
+        onStack[member] = 0;
+        componentOfNode_[member] = component;
+        members.push_back(member);
+      } while (member != node);
+      const size_t size = members.size() - componentOffsets_.back();
+      isCyclic_.push_back(size > 1 || hasSelfLoop[node]);
+      componentOffsets_.push_back(members.size());
+    }
+  }
+  checkCancellation();
+
+  // The edges of the DAG. The `lastSource` of a component is the last
+  // component for which it was added as a successor, which removes the
+  // duplicate edges.
+  Vector<Component> lastSource(numComponents(), noComponent,
+                               allocator.as<Component>());
+  successorOffsets_.reserve(numComponents() + 1);
+  successorOffsets_.push_back(0);
+  for (Component component = 0; component < numComponents(); ++component) {
+    for (auto i = componentOffsets_[component];
+         i < componentOffsets_[component + 1]; ++i) {
+      Component node = members[i];
+      for (auto edge = offsets[node]; edge < offsets[node + 1]; ++edge) {
+        Component successor = componentOfNode_[edgeTargets[edge]];
+        if (successor != component && lastSource[successor] != component) {
+          lastSource[successor] = component;
+          successors_.push_back(successor);
+        }
+      }
+    }
+    successorOffsets_.push_back(successors_.size());
+  }
+
+  componentNodes_.reserve(numNodes);
+  for (Component member : members) {
+    componentNodes_.push_back(nodes_[member]);
+  }
+}
+
+// _____________________________________________________________________________
+std::optional<Component> CondensedGraph::getComponent(Id id) const {
+  auto it = ql::ranges::lower_bound(nodes_, id);
+  if (it == nodes_.end() || *it != id) {
+    return std::nullopt;
+  }
+  return componentOfNode_[it - nodes_.begin()];
+}
@@ -0,0 +1,86 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_CONDENSEDGRAPH_H
+#define QLEVER_SRC_INDEX_CONDENSEDGRAPH_H
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "backports/span.h"
+#include "global/Id.h"
+#include "util/AllocatorWithLimit.h"
+
+namespace qlever::graphSearch {
+
+// The condensation of a directed graph (e.g. the edges of a `TransitivePath`
+// or of a predicate in the `ReachabilityIndex`): each strongly connected
+// component (SCC) of the graph is contracted to a single node, which yields a
+// directed acyclic graph (DAG). All the nodes of an SCC reach exactly the same
+// nodes, so reachability only has to be computed on the (often much smaller)
+// DAG. The SCCs are computed with (an iterative version of) Tarjan's
+// algorithm.
+//
+// The components get the dense indices `0, ..., numComponents() - 1` in the
+// order in which Tarjan's algorithm finds them, so all edges of the DAG go
+// from a component with a larger index to one with a smaller index.
+class CondensedGraph {
+ public:
+  using Component = uint32_t;
+  using CancellationCheck = std::function<void()>;
+  template <typename T>
+  using Vector = std::vector<T, ad_utility::AllocatorWithLimit<T>>;
+
+ private:
+  // The `Id` of each node, sorted, and the component of each node.
+  Vector<Id> nodes_;
+  Vector<Component> componentOfNode_;
+  // The nodes of the component `c` are `componentNodes_[i]` for `i` in
+  // `componentOffsets_[c], ..., componentOffsets_[c + 1] - 1`.
+  Vector<uint64_t> componentOffsets_;
+  Vector<Id> componentNodes_;
+  // The (distinct) successors of the component `c` in the DAG are
+  // `successors_[i]` for `i` in `successorOffsets_[c], ...,
+  // successorOffsets_[c + 1] - 1`.
+  Vector<uint64_t> successorOffsets_;
+  Vector<Component> successors_;
+  // True iff the component contains a cycle, i.e. it has more than one node
+  // or its single node has an edge to itself. Only then a node is reachable
+  // from itself via a path of length at least one.
+  Vector<char> isCyclic_;
+
+ public:
+  // Build the condensation of the graph with the edges from `startIds[i]` to
+  // `targetIds[i]`. The edges don't have to be sorted.
+  CondensedGraph(ql::span<const Id> startIds, ql::span<const Id> targetIds,
+                 const ad_utility::AllocatorWithLimit<Id>& allocator,
+                 const CancellationCheck& checkCancellation);
+
+  size_t numNodes() const { return nodes_.size(); }
+  size_t numComponents() const { return componentOffsets_.size() - 1; }
+
+  // The component of the node with the given `id`, or `std::nullopt` if the
+  // `id` is not the start or target of any edge.
+  std::optional<Component> getComponent(Id id) const;
+
+  ql::span<const Id> nodesOfComponent(Component component) const {
+    return {componentNodes_.data() + componentOffsets_[component],
+            componentNodes_.data() + componentOffsets_[component + 1]};
+  }
+
+  ql::span<const Component> successorsOfComponent(Component component) const {
+    return {successors_.data() + successorOffsets_[component],
+            successors_.data() + successorOffsets_[component + 1]};
+  }
+
+  bool isCyclic(Component component) const {
+    return static_cast<bool>(isCyclic_[component]);
+  }
+};
+}  // namespace qlever::graphSearch
+
+#endif  // QLEVER_SRC_INDEX_CONDENSEDGRAPH_H
@@ -73,6 +73,10 @@ constexpr inline size_t NUM_PARALLEL_ITEM_MAPS = 10;
 // parser is used.
 constexpr inline size_t NUM_PARALLEL_PARSER_THREADS = 8;
 
+// The default number of threads that decompress the frames of a zstd
+// compressed input file in parallel.
+constexpr inline size_t DEFAULT_NUM_DECOMPRESSION_THREADS = 4;
+
 // Increasing the following two constants increases the RAM usage without much
 // benefit to the performance.
 
@@ -12,17 +12,23 @@
 
 #include "index/DeltaTriples.h"
 
+#include <absl/cleanup/cleanup.h>
 #include <absl/strings/str_cat.h>
 
+#include <thread>
+#include <variant>
+
 #include "backports/algorithm.h"
 #include "engine/ExecuteUpdate.h"
 #include "engine/ExportQueryExecutionTrees.h"
+#include "global/RuntimeParameters.h"
 #include "index/ExportIds.h"
 #include "index/Index.h"
 #include "index/IndexImpl.h"
 #include "index/IndexRebuilder.h"
 #include "index/LocatedTriples.h"
-#include "util/ChunkedForLoop.h"
+#include "util/Algorithm.h"
+#include "util/ParallelExecutor.h"
 #include "util/Serializer/TripleSerializer.h"
 
 // ____________________________________________________________________________
@@ -81,13 +87,14 @@ LocatedTriplesState::getLocatedTriples() const {
 
 // ____________________________________________________________________________
 template <bool isInternal>
-LocatedTriples::iterator& DeltaTriples::TriplesToHandles<isInternal>::
-    LocatedTripleHandles::forPermutation(Permutation::Enum permutation) {
-  return handles_[static_cast<size_t>(permutation)];
+size_t& DeltaTriples::TriplesToHandles<isInternal>::LocatedTripleHandles::
+    forPermutation(Permutation::Enum permutation) {
+  return blockIndices_[static_cast<size_t>(permutation)];
 }
 
 // ____________________________________________________________________________
 void DeltaTriples::clear() {
+  AD_CONTRACT_CHECK(!groupUndoLog_.has_value());
   auto clearImpl = [](auto& state, auto& locatedTriples) {
     state.triplesInserted_.clear();
     state.triplesDeleted_.clear();
@@ -97,6 +104,10 @@ void DeltaTriples::clear() {
             locatedTriples_->getLocatedTriples<false>());
   clearImpl(triplesToHandlesInternal_,
             locatedTriples_->getLocatedTriples<true>());
+  locatedTriples_->predicateStatisticsDelta_.clear();
+  // The pending changes are obsolete, the next write has to be a snapshot.
+  pendingChanges_.clear();
+  requiresSnapshot_ = true;
 }
 
 // ____________________________________________________________________________
@@ -104,6 +115,10 @@ nlohmann::json DeltaTriples::vacuum(
     ad_utility::SharedCancellationHandle cancellationHandle) {
   // When the cancellation handle stops the execution this results in the state
   // that only a part of the triples have been vacuumed, which is valid.
+  // The removed triples are not recorded in the `pendingChanges_`, so the next
+  // write has to be a snapshot.
+  AD_CONTRACT_CHECK(!groupUndoLog_.has_value());
+  requiresSnapshot_ = true;
   using namespace ad_utility::use_value_identity;
   auto identifyTriplesToVacuum = [this, &cancellationHandle](auto isInternal) {
     auto perm = Permutation::PSO;
@@ -120,19 +135,16 @@ nlohmann::json DeltaTriples::vacuum(
           const std::vector<IdTriple<0>>& insertionsToRemove) {
         auto& state = getState<isInternal>();
         auto removeTriples = [this, &cancellationHandle, &isInternal](
-                                 const std::vector<IdTriple<0>>& triples,
+                                 ql::span<const IdTriple<0>> triples,
                                  auto& triplesToHandlesMap) {
-          ad_utility::chunkedForLoop<10'000>(
-              0, triples.size(),
-              [&triples, &triplesToHandlesMap, this, &isInternal](size_t i) {
-                auto it = triplesToHandlesMap.find(triples[i]);
-                AD_CORRECTNESS_CHECK(it != triplesToHandlesMap.end());
-                this->eraseTripleInAllPermutations<isInternal>(it->second);
-                triplesToHandlesMap.erase(it);
-              },
-              [&cancellationHandle]() {
-                cancellationHandle->throwIfCancelled();
-              });
+          // Erase the triples in chunks to regularly check for cancellation.
+          constexpr size_t chunkSize = 10'000;
+          for (size_t i = 0; i < triples.size(); i += chunkSize) {
+            this->eraseTriplesInAllPermutations<isInternal>(
+                triples.subspan(i, std::min(chunkSize, triples.size() - i)),
+                triplesToHandlesMap);
+            cancellationHandle->throwIfCancelled();
+          }
         };
 
         removeTriples(deletionsToRemove, state.triplesDeleted_);
@@ -173,48 +185,100 @@ DeltaTriples::locateAndAddTriples(CancellationHandle cancellationHandle,
                                   ad_utility::timer::TimeTracer& tracer) {
   constexpr const auto& allPermutations = Permutation::all<isInternal>();
   auto& lt = locatedTriples_->getLocatedTriples<isInternal>();
-  std::array<std::vector<LocatedTriples::iterator>, allPermutations.size()>
-      intermediateHandles;
-  for (auto permutation : allPermutations) {
-    tracer.beginTrace(std::string{Permutation::toString(permutation)});
-    tracer.beginTrace("locateTriples");
+  std::vector<typename TriplesToHandles<isInternal>::LocatedTripleHandles>
+      handles{triples.size()};
+  // The permutations are independent of each other, so they are processed
+  // concurrently. Each permutation writes only to its own
+  // `LocatedTriplesPerBlock` and to its own entry of the `handles`. The
+  // remaining threads are used to locate the triples in chunks. Small updates
+  // (the common case) are processed sequentially, because for them starting
+  // the threads costs more than it saves.
+  const size_t numThreads =
+      triples.size() < LocatedTriple::minNumTriplesPerThread
+          ? 1
+          : std::max(getRuntimeParameter<
+                         &RuntimeParameters::updateLocateNumThreads_>(),
+                     size_t{1});
+  const size_t numThreadsPerPermutation =
+      std::max(numThreads / allPermutations.size(), size_t{1});
+  auto locateAndAdd = [&](Permutation::Enum permutation,
+                          ad_utility::timer::TimeTracer& permutationTracer) {
+    permutationTracer.beginTrace("locateTriples");
     auto& basePerm = index_.getPermutation(permutation);
     auto& perm = isInternal ? basePerm.internalPermutation() : basePerm;
     auto locatedTriples = LocatedTriple::locateTriplesInPermutation(
         triples, perm.metaData().blockData(), perm.keyOrder(), insertOrDelete,
-        cancellationHandle);
+        cancellationHandle, numThreadsPerPermutation);
     cancellationHandle->throwIfCancelled();
-    tracer.endTrace("locateTriples");
-    tracer.beginTrace("addToLocatedTriples");
-    intermediateHandles[static_cast<size_t>(permutation)] =
-        lt[static_cast<size_t>(permutation)].add(locatedTriples, tracer);
+    permutationTracer.endTrace("locateTriples");
+    permutationTracer.beginTrace("addToLocatedTriples");
+    lt[static_cast<size_t>(permutation)].add(locatedTriples,
+                                             permutationTracer);
+    for (size_t i = 0; i < triples.size(); i++) {
+      handles[i].forPermutation(permutation) = locatedTriples[i].blockIndex_;
+    }
     cancellationHandle->throwIfCancelled();
-    tracer.endTrace("addToLocatedTriples");
-    tracer.endTrace(Permutation::toString(permutation));
-  }
-  tracer.beginTrace("transformHandles");
-  std::vector<typename TriplesToHandles<isInternal>::LocatedTripleHandles>
-      handles{triples.size()};
+    permutationTracer.endTrace("addToLocatedTriples");
+    permutationTracer.endTrace(Permutation::toString(permutation));
+  };
+  // Each permutation records its traces in its own tracer, because the
+  // `TimeTracer` is not thread-safe.
+  std::vector<std::unique_ptr<ad_utility::timer::TimeTracer>> tracers;
+  std::vector<std::packaged_task<void()>> tasks;
   for (auto permutation : allPermutations) {
-    for (size_t i = 0; i < triples.size(); i++) {
-      handles[i].forPermutation(permutation) =
-          intermediateHandles[static_cast<size_t>(permutation)][i];
+    auto& permutationTracer =
+        *tracers.emplace_back(std::make_unique<ad_utility::timer::TimeTracer>(
+            std::string{Permutation::toString(permutation)}, tracer));
+    auto task = [&locateAndAdd, permutation, &permutationTracer]() {
+      locateAndAdd(permutation, permutationTracer);
+    };
+    if (numThreads == 1) {
+      task();
+    } else {
+      tasks.emplace_back(std::move(task));
     }
   }
-  tracer.endTrace("transformHandles");
+  ad_utility::runTasksInParallel(std::move(tasks));
+  for (const auto& permutationTracer : tracers) {
+    tracer.addFinishedTrace(*permutationTracer);
+  }
   return handles;
 }
 
 // ____________________________________________________________________________
 template <bool isInternal>
-void DeltaTriples::eraseTripleInAllPermutations(
-    typename TriplesToHandles<isInternal>::LocatedTripleHandles& handles) {
+void DeltaTriples::eraseTriplesInAllPermutations(
+    ql::span<const IdTriple<0>> triples,
+    typename TriplesToHandles<isInternal>::TriplesToHandlesMap&
+        triplesToHandlesMap) {
+  if (triples.empty()) {
+    return;
+  }
+  auto entries = ad_utility::transform(
+      triples, [&triplesToHandlesMap](const IdTriple<0>& triple) {
+        auto it = triplesToHandlesMap.find(triple);
+        AD_CORRECTNESS_CHECK(it != triplesToHandlesMap.end());
+        return it;
+      });
   auto& lt = locatedTriples_->getLocatedTriples<isInternal>();
   // Erase for all permutations.
+  std::vector<LocatedTriple> locatedTriples;
+  locatedTriples.reserve(entries.size());
   for (auto permutation : Permutation::all<isInternal>()) {
-    auto ltIter = handles.forPermutation(permutation);
-    lt[static_cast<int>(permutation)].erase(ltIter->blockIndex_, ltIter);
+    auto& basePerm = index_.getPermutation(permutation);
+    const auto& keyOrder = isInternal
+                               ? basePerm.internalPermutation().keyOrder()
+                               : basePerm.keyOrder();
+    locatedTriples.clear();
+    for (const auto& it : entries) {
+      locatedTriples.push_back({it->second.forPermutation(permutation),
+                                it->first.permute(keyOrder), true});
+    }
+    lt[static_cast<int>(permutation)].erase(locatedTriples);
   }
+  ql::ranges::for_each(entries, [&triplesToHandlesMap](const auto& it) {
+    triplesToHandlesMap.erase(it);
+  });
 }
 
 // ____________________________________________________________________________
@@ -331,6 +395,74 @@ void DeltaTriples::deleteTriples(CancellationHandle cancellationHandle,
   locatedTriples_->index_++;
 }
 
+// ____________________________________________________________________________
+void DeltaTriples::beginGroup() {
+  AD_CONTRACT_CHECK(!groupUndoLog_.has_value());
+  groupUndoLog_.emplace();
+  groupUndoLog_->numPendingChanges_ = pendingChanges_.size();
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::commitOperationOfGroup() {
+  AD_CONTRACT_CHECK(groupUndoLog_.has_value());
+  groupUndoLog_.emplace();
+  groupUndoLog_->numPendingChanges_ = pendingChanges_.size();
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::rollBackOperationOfGroup() {
+  AD_CONTRACT_CHECK(groupUndoLog_.has_value());
+  auto log = std::exchange(groupUndoLog_.value(), GroupUndoLog{});
+  if (log.entries_.empty()) {
+    groupUndoLog_->numPendingChanges_ = log.numPendingChanges_;
+    return;
+  }
+  auto cancellationHandle =
+      std::make_shared<CancellationHandle::element_type>();
+  // Undo the effect of a single call to `modifyTriplesImpl`: Remove the added
+  // triples and add the erased triples again. The erased triples are located
+  // anew, which yields the same blocks as before, because the blocks of the
+  // index don't change.
+  auto undo = [this, &cancellationHandle](auto isInternal,
+                                          const GroupUndoLog::Entry& entry) {
+    auto& state = getState<isInternal>();
+    auto& targetMap = entry.insertOrDelete_ ? state.triplesInserted_
+                                            : state.triplesDeleted_;
+    auto& inverseMap = entry.insertOrDelete_ ? state.triplesDeleted_
+                                             : state.triplesInserted_;
+    this->eraseTriplesInAllPermutations<isInternal>(entry.addedTriples_,
+                                                    targetMap);
+    auto handles = this->locateAndAddTriples<isInternal>(
+        cancellationHandle, entry.erasedTriples_, !entry.insertOrDelete_,
+        ad_utility::timer::DEFAULT_TIME_TRACER);
+    for (size_t i = 0; i < entry.erasedTriples_.size(); ++i) {
+      inverseMap.insert({entry.erasedTriples_[i], handles[i]});
+    }
+  };
+  using namespace ad_utility::use_value_identity;
+  for (const auto& entry : log.entries_ | ql::views::reverse) {
+    if (entry.isInternal_) {
+      undo(vi<true>, entry);
+    } else {
+      undo(vi<false>, entry);
+    }
+  }
+  locatedTriples_->predicateStatisticsDelta_.restoreEntries(
+      log.predicateStatistics_);
+  pendingChanges_.erase(
+      pendingChanges_.begin() +
+          static_cast<std::ptrdiff_t>(log.numPendingChanges_),
+      pendingChanges_.end());
+  groupUndoLog_->numPendingChanges_ = log.numPendingChanges_;
+  // Note: The `index_` is increased (and not reset to its previous value),
+  // because the rolled back state might have been used (and cached) by the
+  // queries of the operation.
+  locatedTriples_->index_++;
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::endGroup() { groupUndoLog_.reset(); }
+
 // ____________________________________________________________________________
 void DeltaTriples::insertInternalTriplesForTesting(
     CancellationHandle cancellationHandle, Triples triples,
@@ -353,6 +485,13 @@ void DeltaTriples::rewriteLocalVocabEntriesAndBlankNodes(Triples& triples) {
   // operation) is mapped to which blank node managed by the `localVocab_` of
   // this class.
   ad_utility::HashMap<Id, Id> blankNodeMap;
+  rewriteLocalVocabEntriesAndBlankNodes(triples, blankNodeMap, false);
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::rewriteLocalVocabEntriesAndBlankNodes(
+    Triples& triples, ad_utility::HashMap<Id, Id>& blankNodeMap,
+    bool mapAllLocalBlankNodes) {
   // For the given original blank node `id`, check if it has already been
   // mapped. If not, map it to a new blank node managed by the `localVocab_`
   // of this class. Either way, return the (already existing or newly created)
@@ -381,14 +520,16 @@ void DeltaTriples::rewriteLocalVocabEntriesAndBlankNodes(Triples& triples) {
   // Helper lambda that converts a single local vocab or blank node `id` as
   // described in the comment for this function. All other types are left
   // unchanged.
-  auto convertId = [this, isGlobalBlankNode, &getLocalBlankNode](Id& id) {
+  auto convertId = [this, isGlobalBlankNode, &getLocalBlankNode,
+                    mapAllLocalBlankNodes](Id& id) {
     if (id.getDatatype() == Datatype::LocalVocabIndex) {
       id = Id::makeFromLocalVocabIndex(
           localVocab_.getIndexAndAddIfNotContained(*id.getLocalVocabIndex()));
     } else if (id.getDatatype() == Datatype::BlankNodeIndex) {
       auto idx = id.getBlankNodeIndex();
       if (isGlobalBlankNode(idx) ||
-          localVocab_.isBlankNodeIndexContained(idx)) {
+          (!mapAllLocalBlankNodes &&
+           localVocab_.isBlankNodeIndexContained(idx))) {
         return;
       }
       id = getLocalBlankNode(id);
@@ -430,13 +571,12 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
   });
   tracer.endTrace("removeExistingTriples");
   tracer.beginTrace("removeInverseTriples");
-  ql::ranges::for_each(triples, [this, &inverseMap](const IdTriple<0>& triple) {
-    auto handle = inverseMap.find(triple);
-    if (handle != inverseMap.end()) {
-      eraseTripleInAllPermutations<isInternal>(handle->second);
-      inverseMap.erase(triple);
-    }
-  });
+  Triples inverseTriples;
+  ql::ranges::copy_if(triples, std::back_inserter(inverseTriples),
+                      [&inverseMap](const IdTriple<0>& triple) {
+                        return inverseMap.contains(triple);
+                      });
+  eraseTriplesInAllPermutations<isInternal>(inverseTriples, inverseMap);
   tracer.endTrace("removeInverseTriples");
   tracer.beginTrace("locatedAndAdd");
 
@@ -451,6 +591,26 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
     targetMap.insert({triples[i], handles[i]});
   }
   tracer.endTrace("markTriples");
+  // Record the effective change for the rollback of a group commit.
+  if (groupUndoLog_.has_value() && !triples.empty()) {
+    if constexpr (!isInternal) {
+      locatedTriples_->predicateStatisticsDelta_.saveEntries(
+          triples, groupUndoLog_->predicateStatistics_);
+    }
+    groupUndoLog_->entries_.push_back(
+        {isInternal, insertOrDelete, triples, std::move(inverseTriples)});
+  }
+  // Update the predicate statistics and record the effective change for the
+  // write-ahead log. The internal triples are not recorded, they are
+  // recomputed when the change is replayed.
+  if constexpr (!isInternal) {
+    locatedTriples_->predicateStatisticsDelta_.addTriples(triples,
+                                                          insertOrDelete);
+    if (writeAheadLog_.has_value() && !isReadingFromDisk_ &&
+        !triples.empty()) {
+      pendingChanges_.push_back({insertOrDelete, std::move(triples)});
+    }
+  }
 }
 
 // ____________________________________________________________________________
@@ -462,7 +622,8 @@ LocatedTriplesSharedState DeltaTriples::getLocatedTriplesSharedStateCopy()
       std::make_shared<LocatedTriplesState>(LocatedTriplesState{
           locatedTriples_->locatedTriplesPerBlock_,
           locatedTriples_->internalLocatedTriplesPerBlock_,
-          localVocab_.getLifetimeExtender(), locatedTriples_->index_})};
+          localVocab_.getLifetimeExtender(), locatedTriples_->index_,
+          locatedTriples_->predicateStatisticsDelta_})};
 }
 
 // ____________________________________________________________________________
@@ -506,12 +667,14 @@ ReturnType DeltaTriplesManager::modify(
           [&newSnapshot](auto& currentSnapshot) {
             currentSnapshot = std::move(newSnapshot);
           });
+      numInsertedInSnapshot_ = deltaTriples.numInserted();
+      numDeletedInSnapshot_ = deltaTriples.numDeleted();
     };
     auto writeAndUpdateSnapshot = [&updateSnapshot, &deltaTriples, &tracer,
                                    writeToDiskAfterRequest]() {
       if (writeToDiskAfterRequest) {
         tracer.beginTrace("diskWriteback");
-        deltaTriples.writeToDisk();
+        deltaTriples.writeChangesToDisk();
         tracer.endTrace("diskWriteback");
       }
       tracer.beginTrace("snapshotCreation");
@@ -544,11 +707,110 @@ ReturnType DeltaTriplesManager::modify(
     }
   });
 }
+
+// _____________________________________________________________________________
+template <typename ReturnType>
+std::future<ReturnType> DeltaTriplesManager::enqueueForGroupCommit(
+    std::function<ReturnType(DeltaTriples&)> function) {
+  using Result = std::conditional_t<std::is_void_v<ReturnType>, std::monostate,
+                                    ReturnType>;
+  struct State {
+    std::promise<ReturnType> promise_;
+    std::optional<Result> result_;
+    std::exception_ptr error_;
+  };
+  auto state = std::make_shared<State>();
+  auto future = state->promise_.get_future();
+  auto execute = [state, function = std::move(function)](
+                     DeltaTriples& deltaTriples) {
+    try {
+      if constexpr (std::is_void_v<ReturnType>) {
+        function(deltaTriples);
+        state->result_.emplace();
+      } else {
+        state->result_.emplace(function(deltaTriples));
+      }
+      return true;
+    } catch (...) {
+      state->error_ = std::current_exception();
+      return false;
+    }
+  };
+  auto complete = [state](std::exception_ptr commitError) {
+    if (state->error_) {
+      state->promise_.set_exception(state->error_);
+    } else if (commitError) {
+      state->promise_.set_exception(commitError);
+    } else if constexpr (std::is_void_v<ReturnType>) {
+      state->promise_.set_value();
+    } else {
+      AD_CORRECTNESS_CHECK(state->result_.has_value());
+      state->promise_.set_value(std::move(state->result_.value()));
+    }
+  };
+  pendingGroupCommitOperations_.wlock()->push_back(
+      {std::chrono::steady_clock::now(), std::move(execute),
+       std::move(complete)});
+  return future;
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesManager::commitGroup(std::chrono::milliseconds window,
+                                      ad_utility::timer::TimeTracer& tracer) {
+  auto oldestEnqueueTime = pendingGroupCommitOperations_.withWriteLock(
+      [](const auto& operations)
+          -> std::optional<std::chrono::steady_clock::time_point> {
+        if (operations.empty()) {
+          return std::nullopt;
+        }
+        return operations.front().enqueueTime_;
+      });
+  if (!oldestEnqueueTime.has_value()) {
+    return;
+  }
+  tracer.beginTrace("groupCommitWindow");
+  std::this_thread::sleep_until(oldestEnqueueTime.value() + window);
+  tracer.endTrace("groupCommitWindow");
+  auto operations = std::exchange(*pendingGroupCommitOperations_.wlock(), {});
+  // The operations were already committed by a concurrent call.
+  if (operations.empty()) {
+    return;
+  }
+  std::exception_ptr commitError;
+  try {
+    modify<void>(
+        [&operations](DeltaTriples& deltaTriples) {
+          // The changes of an operation that throws are rolled back, so that
+          // they are neither persisted nor published. If the rollback itself
+          // fails, the whole group fails.
+          deltaTriples.beginGroup();
+          absl::Cleanup endGroup{
+              [&deltaTriples]() { deltaTriples.endGroup(); }};
+          for (auto& operation : operations) {
+            if (operation.execute_(deltaTriples)) {
+              deltaTriples.commitOperationOfGroup();
+            } else {
+              deltaTriples.rollBackOperationOfGroup();
+            }
+          }
+        },
+        true, true, tracer);
+  } catch (...) {
+    commitError = std::current_exception();
+  }
+  for (auto& operation : operations) {
+    operation.complete_(commitError);
+  }
+}
+
 // Explicit instantiations
 #define INSTANTIATE_MODIFY(T)                             \
   template T DeltaTriplesManager::modify<T>(              \
       const std::function<T(DeltaTriples&)>&, bool, bool, \
-      ad_utility::timer::TimeTracer&)
+      ad_utility::timer::TimeTracer&);                    \
+  template std::future<T>                                 \
+  DeltaTriplesManager::enqueueForGroupCommit<T>(          \
+      std::function<T(DeltaTriples&)>)
 INSTANTIATE_MODIFY(void);
 INSTANTIATE_MODIFY(UpdateMetadata);
 INSTANTIATE_MODIFY(DeltaTriplesCount);
@@ -564,6 +826,11 @@ DeltaTriplesManager::getCurrentLocatedTriplesSharedState() const {
   return *currentLocatedTriplesSharedState_.rlock();
 }
 
+// _____________________________________________________________________________
+DeltaTriplesCount DeltaTriplesManager::getCurrentCounts() const {
+  return {numInsertedInSnapshot_.load(), numDeletedInSnapshot_.load()};
+}
+
 // _____________________________________________________________________________
 std::tuple<
     LocatedTriplesSharedState, std::vector<LocalVocabIndex>,
@@ -600,10 +867,13 @@ void DeltaTriples::updateAugmentedMetadata() {
 }
 
 // _____________________________________________________________________________
-void DeltaTriples::writeToDisk() const {
+void DeltaTriples::writeToDisk() {
   if (!filenameForPersisting_.has_value()) {
     return;
   }
+  // A compaction that is still running would otherwise overwrite the new
+  // snapshot with an older state.
+  waitForCompaction();
   // TODO<RobinTF> Currently this only writes non-internal delta triples to
   // disk. The internal triples will be regenerated when importing the rest
   // again. In the future we might to also want to explicitly store the
@@ -623,20 +893,156 @@ void DeltaTriples::writeToDisk() const {
       std::array{toRange(triplesToHandlesNormal_.triplesDeleted_),
                  toRange(triplesToHandlesNormal_.triplesInserted_)});
   std::filesystem::rename(tempPath, filenameForPersisting_.value());
+  snapshotSizeInBytes_ =
+      std::filesystem::file_size(filenameForPersisting_.value());
+
+  // The snapshot contains all the changes, so the write-ahead logs are
+  // obsolete.
+  writeAheadLog_.value().remove();
+  std::filesystem::remove(compactingWriteAheadLogPath());
+  pendingChanges_.clear();
+  requiresSnapshot_ = false;
 }
 
+// _____________________________________________________________________________
+void DeltaTriples::writeChangesToDisk() {
+  if (!writeAheadLog_.has_value()) {
+    return;
+  }
+  if (requiresSnapshot_) {
+    writeToDisk();
+    return;
+  }
+  if (pendingChanges_.empty()) {
+    return;
+  }
+  try {
+    writeAheadLog_.value().append(pendingChanges_);
+  } catch (...) {
+    // The log might still end with an incomplete record (if it couldn't be
+    // truncated), so the next call replaces it with a complete snapshot.
+    requiresSnapshot_ = true;
+    throw;
+  }
+  pendingChanges_.clear();
+
+  // Compact the log when replaying it would take longer than reading the
+  // snapshot, unless it is still small.
+  size_t threshold =
+      getRuntimeParameter<&RuntimeParameters::updateWalCompactionThreshold_>()
+          .getBytes();
+  if (writeAheadLog_.value().sizeInBytes() >=
+      std::max(threshold, snapshotSizeInBytes_.load())) {
+    startCompaction();
+  }
+}
+
+// _____________________________________________________________________________
+std::filesystem::path DeltaTriples::compactingWriteAheadLogPath() const {
+  std::filesystem::path path = writeAheadLog_.value().path();
+  path += ".compacting";
+  return path;
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::startCompaction() {
+  waitForCompaction();
+  auto compactingPath = compactingWriteAheadLogPath();
+  // The previous compaction has failed, so the changes of the log that it
+  // should have compacted are only contained in that log. Write a complete
+  // snapshot synchronously instead.
+  if (std::filesystem::exists(compactingPath)) {
+    writeToDisk();
+    return;
+  }
+  std::filesystem::rename(writeAheadLog_.value().path(), compactingPath);
+
+  // Copy the current state, such that the snapshot can be written without
+  // holding the lock. The entries of the `localVocab_` are never removed, and
+  // the destructor waits for the compaction, so the copied `LocalVocabIndex`es
+  // stay valid.
+  auto [words, blankNodeBlocks] = copyLocalVocab();
+  auto toIds = [](const TriplesToHandles<false>::TriplesToHandlesMap& map) {
+    std::vector<Id> ids;
+    ids.reserve(map.size() * Triples::value_type::NumCols);
+    for (const auto& triple : map | ql::views::keys) {
+      ql::ranges::copy(triple.ids(), std::back_inserter(ids));
+    }
+    return ids;
+  };
+  std::array idRanges{toIds(triplesToHandlesNormal_.triplesDeleted_),
+                      toIds(triplesToHandlesNormal_.triplesInserted_)};
+
+  compaction_ = std::async(
+      std::launch::async,
+      [path = std::filesystem::path{filenameForPersisting_.value()},
+       compactingPath, words = std::move(words),
+       blankNodeBlocks = std::move(blankNodeBlocks),
+       idRanges = std::move(idRanges),
+       &snapshotSizeInBytes = snapshotSizeInBytes_]() {
+        // Errors are only logged, the changes are still contained in the log
+        // that is being compacted, and the next compaction writes a snapshot
+        // synchronously (see above).
+        try {
+          auto tempPath = path;
+          tempPath += ".tmp";
+          ad_utility::serializeIds(tempPath, blankNodeBlocks, words, idRanges);
+          std::filesystem::rename(tempPath, path);
+          snapshotSizeInBytes = std::filesystem::file_size(path);
+          std::filesystem::remove(compactingPath);
+        } catch (const std::exception& e) {
+          AD_LOG_ERROR << "Compacting the write-ahead log of the updates "
+                       << compactingPath << " failed: " << e.what()
+                       << std::endl;
+        }
+      });
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::waitForCompaction() {
+  if (compaction_.valid()) {
+    compaction_.get();
+  }
+}
+
+// _____________________________________________________________________________
+DeltaTriples::~DeltaTriples() { waitForCompaction(); }
+
 // _____________________________________________________________________________
 void DeltaTriples::readFromDisk() {
   if (!filenameForPersisting_.has_value()) {
     return;
   }
   AD_CONTRACT_CHECK(localVocab_.empty());
+  isReadingFromDisk_ = true;
+  absl::Cleanup resetIsReadingFromDisk{
+      [this]() { isReadingFromDisk_ = false; }};
+  auto cancellationHandle =
+      std::make_shared<CancellationHandle::element_type>();
+  // The local blank nodes of the snapshot and the write-ahead log are from a
+  // previous run and are mapped to new blank nodes, consistently across all
+  // the triples.
+  ad_utility::HashMap<Id, Id> blankNodeMap;
+  auto apply = [this, &cancellationHandle, &blankNodeMap](Triples triples,
+                                                          bool isInsertion) {
+    rewriteLocalVocabEntriesAndBlankNodes(triples, blankNodeMap, true);
+    // `insertTriples` and `deleteTriples` require the triples to be sorted.
+    // The triples are serialized in the order returned by the HashMap, which
+    // is not necessarily sorted.
+    ql::ranges::sort(triples);
+    if (isInsertion) {
+      insertTriples(cancellationHandle, std::move(triples));
+    } else {
+      deleteTriples(cancellationHandle, std::move(triples));
+    }
+  };
+
   auto [vocab, idRanges] =
       ad_utility::deserializeIds(filenameForPersisting_.value(), index_);
-  if (idRanges.empty()) {
-    return;
-  }
-  AD_CORRECTNESS_CHECK(idRanges.size() == 2);
+  std::error_code errorCode;
+  auto snapshotSize =
+      std::filesystem::file_size(filenameForPersisting_.value(), errorCode);
+  snapshotSizeInBytes_ = errorCode ? 0 : static_cast<size_t>(snapshotSize);
   auto toTriples = [](const std::vector<Id>& ids) {
     Triples triples;
     static_assert(Triples::value_type::PayloadSize == 0);
@@ -647,24 +1053,58 @@ void DeltaTriples::readFromDisk() {
       triples.emplace_back(
           std::array{ids[i], ids[i + 1], ids[i + 2], ids[i + 3]});
     }
-    // `insertTriples` and `deleteTriples` require the triples to be sorted.
-    // `writeToDisk` serializes the triples in the order returned by the
-    // HashMap, which is not necessarily sorted. Sort the triples when reading
-    // them from disk.
-    ql::ranges::sort(triples);
     return triples;
   };
-  auto cancellationHandle =
-      std::make_shared<CancellationHandle::element_type>();
-  insertTriples(cancellationHandle, toTriples(idRanges.at(1)));
-  deleteTriples(cancellationHandle, toTriples(idRanges.at(0)));
-  AD_LOG_INFO << "Done, #inserted triples = " << idRanges.at(1).size()
-              << ", #deleted triples = " << idRanges.at(0).size() << std::endl;
+  if (!idRanges.empty()) {
+    AD_CORRECTNESS_CHECK(idRanges.size() == 2);
+    apply(toTriples(idRanges.at(1)), true);
+    apply(toTriples(idRanges.at(0)), false);
+    AD_LOG_INFO << "Done, #inserted triples = " << idRanges.at(1).size()
+                << ", #deleted triples = " << idRanges.at(0).size()
+                << std::endl;
+  }
+
+  // Replay the changes since the snapshot, first those of an interrupted
+  // compaction, which are older.
+  LocalVocab writeAheadLogVocab;
+  size_t numBatches = 0;
+  for (const auto& writeAheadLog :
+       {DeltaTriplesWriteAheadLog{compactingWriteAheadLogPath()},
+        writeAheadLog_.value()}) {
+    for (auto& batch : writeAheadLog.read(writeAheadLogVocab, index_)) {
+      for (auto& operation : batch) {
+        apply(std::move(operation.triples_), operation.isInsertion_);
+      }
+      ++numBatches;
+    }
+  }
+  if (numBatches > 0) {
+    AD_LOG_INFO << "Replayed " << numBatches
+                << " batches of updates from the write-ahead log, "
+                   "#inserted triples = "
+                << numInserted() << ", #deleted triples = " << numDeleted()
+                << std::endl;
+  }
+
+  // The blank nodes have new indices now, which the records that are appended
+  // to the log from now on refer to. Write a new snapshot, such that the log
+  // only ever refers to a single assignment of the blank nodes.
+  if (numBatches > 0 || !blankNodeMap.empty()) {
+    writeToDisk();
+  }
 }
 
 // _____________________________________________________________________________
 void DeltaTriples::setPersists(std::optional<std::string> filename) {
+  waitForCompaction();
   filenameForPersisting_ = std::move(filename);
+  if (filenameForPersisting_.has_value()) {
+    writeAheadLog_.emplace(filenameForPersisting_.value() + ".wal");
+  } else {
+    writeAheadLog_.reset();
+  }
+  pendingChanges_.clear();
+  requiresSnapshot_ = false;
 }
 
 // _____________________________________________________________________________
@@ -12,14 +12,19 @@
 #ifndef QLEVER_SRC_INDEX_DELTATRIPLES_H
 #define QLEVER_SRC_INDEX_DELTATRIPLES_H
 
+#include <atomic>
+#include <future>
+
 #include "backports/three_way_comparison.h"
 #include "engine/UpdateMetadata.h"
 #include "global/IdTriple.h"
+#include "index/DeltaTriplesWriteAheadLog.h"
 #include "index/Index.h"
 #include "index/IndexBuilderTypes.h"
 #include "index/IndexRebuilderTypes.h"
 #include "index/LocalVocab.h"
 #include "index/LocatedTriples.h"
+#include "index/PredicateStatistics.h"
 #include "index/Permutation.h"
 #include "util/LruCache.h"
 #include "util/Synchronized.h"
@@ -49,6 +54,9 @@ struct LocatedTriplesState {
   // than another, then the version that has been modified last has a higher
   // index. The index is used in the query cache.
   size_t index_;
+  // The approximate changes of the `PredicateStatistics` of the index by the
+  // delta triples (only for the normal triples).
+  PredicateStatisticsDelta predicateStatisticsDelta_;
   // Get `LocatedTriplesPerBlock` objects for the given permutation.
   template <bool isInternal>
   const LocatedTriplesPerBlock& getLocatedTriplesForPermutation(
@@ -91,6 +99,9 @@ class DeltaTriples {
   FRIEND_TEST(DeltaTriplesTest, clear);
   FRIEND_TEST(DeltaTriplesTest, addTriplesToLocalVocab);
   FRIEND_TEST(DeltaTriplesTest, storeAndRestoreData);
+  FRIEND_TEST(DeltaTriplesTest, storeAndRestoreWithWriteAheadLog);
+  FRIEND_TEST(DeltaTriplesTest, predicateStatisticsDelta);
+  FRIEND_TEST(DeltaTriplesTest, insertTriplesWithMultipleThreads);
 
  public:
   using Triples = std::vector<IdTriple<0>>;
@@ -106,7 +117,8 @@ class DeltaTriples {
   std::shared_ptr<LocatedTriplesState> locatedTriples_ =
       std::make_shared<LocatedTriplesState>(LocatedTriplesState{
           LocatedTriplesPerBlockAllPermutations<false>{},
-          LocatedTriplesPerBlockAllPermutations<true>{}, std::nullopt, 0});
+          LocatedTriplesPerBlockAllPermutations<true>{}, std::nullopt, 0,
+          PredicateStatisticsDelta{}});
 
   // The local vocabulary of the delta triples (they may have components,
   // which are not contained in the vocabulary of the original index).
@@ -115,6 +127,29 @@ class DeltaTriples {
   // See the documentation of `setPersist()` below.
   std::optional<std::string> filenameForPersisting_;
 
+  // The log of the changes since the last snapshot was written, see
+  // `writeChangesToDisk()`. Set iff `filenameForPersisting_` is set.
+  std::optional<DeltaTriplesWriteAheadLog> writeAheadLog_;
+
+  // The changes since the last call to `writeChangesToDisk()`.
+  DeltaTriplesWriteAheadLog::Batch pendingChanges_;
+
+  // True if the delta triples were changed in a way that is not recorded in
+  // `pendingChanges_` (by `clear()` or `vacuum()`), so that the next call to
+  // `writeChangesToDisk()` has to write a complete snapshot.
+  bool requiresSnapshot_ = false;
+
+  // True while the changes are replayed in `readFromDisk()`, they must not be
+  // recorded again.
+  bool isReadingFromDisk_ = false;
+
+  // The size of the last snapshot, the write-ahead log is only compacted once
+  // it is larger than that. Atomic because it is set by the compaction.
+  std::atomic<size_t> snapshotSizeInBytes_ = 0;
+
+  // The compaction of the write-ahead log that runs in the background.
+  std::future<void> compaction_;
+
   // Store the id of the `ql:langtag` predicate to avoid repeated disk lookups.
   // This is initialized on first use.
   Id languagePredicate_ = Id::makeUndefined();
@@ -148,12 +183,12 @@ class DeltaTriples {
   template <bool isInternal>
   struct TriplesToHandles {
     // Each delta triple needs to know where it is stored in each of the six
-    // `LocatedTriplesPerBlock` above.
+    // `LocatedTriplesPerBlock` above, that is, the index of its block in each
+    // permutation.
     struct LocatedTripleHandles {
-      using It = LocatedTriples::iterator;
-      std::array<It, Permutation::all<isInternal>().size()> handles_;
+      std::array<size_t, Permutation::all<isInternal>().size()> blockIndices_;
 
-      LocatedTriples::iterator& forPermutation(Permutation::Enum permutation);
+      size_t& forPermutation(Permutation::Enum permutation);
     };
     using TriplesToHandlesMap =
         ad_utility::HashMap<IdTriple<0>, LocatedTripleHandles>;
@@ -168,6 +203,30 @@ class DeltaTriples {
   TriplesToHandles<false> triplesToHandlesNormal_;
   TriplesToHandles<true> triplesToHandlesInternal_;
 
+  // The changes of the current operation of a group commit, which are needed
+  // to roll back this operation (see `beginGroup()`). The size of the log is
+  // proportional to the number of triples changed by the operation, not to
+  // the total number of delta triples.
+  struct GroupUndoLog {
+    // The effective changes of a single call to `modifyTriplesImpl`.
+    struct Entry {
+      bool isInternal_;
+      bool insertOrDelete_;
+      // The triples that were added to the `triplesInserted_` (if
+      // `insertOrDelete_` is true) or to the `triplesDeleted_`.
+      Triples addedTriples_;
+      // The triples that were removed from the respective other set.
+      Triples erasedTriples_;
+    };
+    std::vector<Entry> entries_;
+    // The entries of the `predicateStatisticsDelta_` before they were changed
+    // by the operation.
+    PredicateStatisticsDelta::SavedEntries predicateStatistics_;
+    // The size of the `pendingChanges_` before the operation.
+    size_t numPendingChanges_ = 0;
+  };
+  std::optional<GroupUndoLog> groupUndoLog_;
+
  public:
   // Construct for given index.
   explicit DeltaTriples(const Index& index);
@@ -177,6 +236,9 @@ class DeltaTriples {
   DeltaTriples(const DeltaTriples&) = delete;
   DeltaTriples& operator=(const DeltaTriples&) = delete;
 
+  // Wait for a running compaction of the write-ahead log.
+  ~DeltaTriples();
+
   // Get the common `LocalVocab` of the delta triples.
  private:
   LocalVocab& localVocab() { return localVocab_; }
@@ -240,6 +302,19 @@ class DeltaTriples {
                      ad_utility::timer::TimeTracer& tracer =
                          ad_utility::timer::DEFAULT_TIME_TRACER);
 
+  // Support for rolling back the changes of a single operation of a group
+  // commit (see `DeltaTriplesManager::commitGroup`). Between `beginGroup()`
+  // and `endGroup()`, the effective changes of the current operation are
+  // recorded in an undo log. After each operation of the group,
+  // `commitOperationOfGroup()` keeps its changes and clears the log, while
+  // `rollBackOperationOfGroup()` undoes the changes in the log in reverse
+  // order. Within a group, only `insertTriples` and `deleteTriples` may be
+  // called.
+  void beginGroup();
+  void commitOperationOfGroup();
+  void rollBackOperationOfGroup();
+  void endGroup();
+
   // Insert internal delta triples for test code. In practice these are inferred
   // from regular triples, so `insertTriples` and `deleteTriples` will insert
   // them on their own.
@@ -257,14 +332,30 @@ class DeltaTriples {
           ad_utility::timer::DEFAULT_TIME_TRACER);
 
   // If the `filename` is set, then `writeToDisk()` will write these
-  // `DeltaTriples` to `filename.value()`. If `filename` is `nullopt`, then
-  // `writeToDisk` will be a nullop.
+  // `DeltaTriples` to `filename.value()` and `writeChangesToDisk()` will
+  // append the changes to the write-ahead log `filename.value() + ".wal"`. If
+  // `filename` is `nullopt`, then both will be a nullop.
   void setPersists(std::optional<std::string> filename);
 
-  // Write the delta triples to disk to persist them between restarts.
-  void writeToDisk() const;
-
-  // Read the delta triples from disk to restore them after a restart.
+  // Write a complete snapshot of the delta triples to disk to persist them
+  // between restarts. The write-ahead log is then no longer needed and
+  // deleted.
+  void writeToDisk();
+
+  // Persist the changes since the last call: Append them as one batch to the
+  // write-ahead log, or write a complete snapshot if the changes can't be
+  // expressed as a batch (see `requiresSnapshot_`). When the log has become
+  // larger than the snapshot and the runtime parameter
+  // `update-wal-compaction-threshold`, a new snapshot is written in the
+  // background.
+  void writeChangesToDisk();
+
+  // Wait until a compaction of the write-ahead log that runs in the background
+  // has finished.
+  void waitForCompaction();
+
+  // Read the delta triples from disk to restore them after a restart: First
+  // the snapshot, then the batches of the write-ahead log.
   void readFromDisk();
 
   // Return a deep copy of the `LocatedTriples` and the corresponding
@@ -353,18 +444,35 @@ class DeltaTriples {
   // avoids storing local vocab entries or blank nodes that were created only
   // temporarily when evaluating the WHERE clause of an update query.
   void rewriteLocalVocabEntriesAndBlankNodes(Triples& triples);
+
+  // Same as above, but with an explicit mapping from the original blank nodes
+  // to the blank nodes managed by the `localVocab_`, which is used to map the
+  // blank nodes consistently across multiple calls. If
+  // `mapAllLocalBlankNodes` is true, the local blank nodes are mapped even if
+  // they happen to be managed by the `localVocab_` (used for the blank nodes
+  // of a previous run that are read from disk).
+  void rewriteLocalVocabEntriesAndBlankNodes(
+      Triples& triples, ad_utility::HashMap<Id, Id>& blankNodeMap,
+      bool mapAllLocalBlankNodes);
   FRIEND_TEST(DeltaTriplesTest, rewriteLocalVocabEntriesAndBlankNodes);
 
-  // Erase `LocatedTriple` object from each `LocatedTriplesPerBlock` list. The
-  // argument are iterators for each list, as returned by the method
-  // `locateTripleInAllPermutations` above.
-  //
-  // NOTE: The iterators are invalid afterward. That is OK, as long as we also
-  // delete the respective entry in `triplesInserted_` or `triplesDeleted_`,
-  // which stores these iterators.
+  // The path of the write-ahead log while it is being compacted.
+  std::filesystem::path compactingWriteAheadLogPath() const;
+
+  // Start writing a new snapshot in the background. The current write-ahead
+  // log is renamed to `compactingWriteAheadLogPath()` and deleted once the
+  // snapshot has been written, new changes go to a new write-ahead log.
+  void startCompaction();
+
+  // Erase the `triples` from each `LocatedTriplesPerBlock` list and from the
+  // `triplesToHandlesMap` (one of `triplesInserted_` or `triplesDeleted_`),
+  // which must contain all the `triples`. Each block of each permutation is
+  // only modified once.
   template <bool isInternal>
-  void eraseTripleInAllPermutations(
-      typename TriplesToHandles<isInternal>::LocatedTripleHandles& handles);
+  void eraseTriplesInAllPermutations(
+      ql::span<const IdTriple<0>> triples,
+      typename TriplesToHandles<isInternal>::TriplesToHandlesMap&
+          triplesToHandlesMap);
 
   // The difference between two `LocatedTriplesState` snapshots, split into
   // inserted/deleted and internal/external triples.
@@ -399,6 +507,24 @@ class DeltaTriplesManager {
   ad_utility::Synchronized<DeltaTriples> deltaTriples_;
   ad_utility::Synchronized<LocatedTriplesSharedState, std::shared_mutex>
       currentLocatedTriplesSharedState_;
+  // The number of inserted and deleted triples of the current snapshot. They
+  // are updated together with the snapshot, but can be read without a lock.
+  std::atomic<int64_t> numInsertedInSnapshot_ = 0;
+  std::atomic<int64_t> numDeletedInSnapshot_ = 0;
+
+  // An operation that was enqueued by `enqueueForGroupCommit` and is waiting
+  // for the next call to `commitGroup`.
+  struct GroupCommitOperation {
+    std::chrono::steady_clock::time_point enqueueTime_;
+    // Apply the operation to the `DeltaTriples` and store its result (or the
+    // exception that it threw). Return false iff the operation threw.
+    std::function<bool(DeltaTriples&)> execute_;
+    // Make the stored result available to the caller. The `commitError` is set
+    // if the commit of the batch as a whole failed.
+    std::function<void(std::exception_ptr commitError)> complete_;
+  };
+  ad_utility::Synchronized<std::vector<GroupCommitOperation>>
+      pendingGroupCommitOperations_;
 
  public:
   using CancellationHandle = DeltaTriples::CancellationHandle;
@@ -419,6 +545,27 @@ class DeltaTriplesManager {
                     ad_utility::timer::TimeTracer& tracer =
                         ad_utility::timer::DEFAULT_TIME_TRACER);
 
+  // Enqueue the `function` for a group commit and return a future for its
+  // result. The function is executed by the next call to `commitGroup` (from
+  // any thread) together with all other enqueued operations: They run one
+  // after the other under a single write lock, followed by a single update of
+  // the metadata, a single write to disk, and a single update of the snapshot.
+  // The result (or the exception thrown by `function`, which doesn't affect
+  // the other operations) is only available after this commit. Each call has to
+  // be followed by a call to `commitGroup`.
+  template <typename ReturnType>
+  std::future<ReturnType> enqueueForGroupCommit(
+      std::function<ReturnType(DeltaTriples&)> function);
+
+  // Execute and commit all operations that were enqueued by
+  // `enqueueForGroupCommit` as a single batch (see above). If the oldest of
+  // these operations was enqueued less than `window` ago, first wait for the
+  // rest of the window, so that operations that arrive in the meantime are
+  // part of the same batch. Do nothing if there are no enqueued operations.
+  void commitGroup(std::chrono::milliseconds window,
+                   ad_utility::timer::TimeTracer& tracer =
+                       ad_utility::timer::DEFAULT_TIME_TRACER);
+
   void setFilenameForPersistentUpdatesAndReadFromDisk(std::string filename);
 
   // Reset the updates represented by the underlying `DeltaTriples` and then
@@ -430,6 +577,11 @@ class DeltaTriplesManager {
   // updates.
   LocatedTriplesSharedState getCurrentLocatedTriplesSharedState() const;
 
+  // The number of inserted and deleted triples of the current snapshot. Unlike
+  // `DeltaTriples::getCounts`, this doesn't wait for running updates, so it can
+  // be used for monitoring.
+  DeltaTriplesCount getCurrentCounts() const;
+
   // In addition to the located triples shared state, also acquire a copy of the
   // local vocab indices and the local blank node blocks owned by the local
   // vocab. As long as the returned `LocatedTriplesSharedState` is alive, the
@@ -0,0 +1,236 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/DeltaTriplesWriteAheadLog.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "util/Exception.h"
+#include "util/HashSet.h"
+#include "util/Log.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/TripleSerializer.h"
+
+namespace {
+// The size of the header (the magic bytes and the format version) and of the
+// prefix of each record (the size of the payload and its checksum).
+constexpr size_t headerSize =
+    DeltaTriplesWriteAheadLog::magicBytes.size() + sizeof(uint16_t);
+constexpr size_t recordPrefixSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+// The lookup table for the CRC-32 with the reversed polynomial `0xEDB88320`.
+constexpr std::array<uint32_t, 256> crcTable = []() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < table.size(); ++i) {
+    uint32_t crc = i;
+    for (size_t bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+    }
+    table[i] = crc;
+  }
+  return table;
+}();
+
+// Serialize the `batch` (see the format in the header).
+std::vector<char> serializeBatch(
+    const DeltaTriplesWriteAheadLog::Batch& batch) {
+  // Collect the local vocab entries that are used by the batch.
+  std::vector<LocalVocabIndex> words;
+  ad_utility::HashSet<LocalVocabIndex> seenWords;
+  for (const auto& operation : batch) {
+    for (const auto& triple : operation.triples_) {
+      for (Id id : triple.ids()) {
+        if (id.getDatatype() == Datatype::LocalVocabIndex &&
+            seenWords.insert(id.getLocalVocabIndex()).second) {
+          words.push_back(id.getLocalVocabIndex());
+        }
+      }
+    }
+  }
+
+  ad_utility::serialization::ByteBufferWriteSerializer serializer;
+  serializer << uint64_t{words.size()};
+  for (LocalVocabIndex word : words) {
+    serializer << Id::makeFromLocalVocabIndex(word).getBits();
+    serializer << word->toStringRepresentation();
+  }
+  serializer << uint64_t{batch.size()};
+  for (const auto& operation : batch) {
+    serializer << operation.isInsertion_;
+    std::vector<Id> ids;
+    ids.reserve(operation.triples_.size() * 4);
+    for (const auto& triple : operation.triples_) {
+      ql::ranges::copy(triple.ids(), std::back_inserter(ids));
+    }
+    serializer << ids;
+  }
+  return std::move(serializer).data();
+}
+
+// Deserialize a batch that was serialized with `serializeBatch`.
+DeltaTriplesWriteAheadLog::Batch deserializeBatch(
+    std::vector<char> payload, LocalVocab& localVocab,
+    const LocalVocabContext& context) {
+  using ad_utility::detail::readValue;
+  ad_utility::serialization::ByteBufferReadSerializer serializer{
+      std::move(payload)};
+  auto numWords = readValue<uint64_t>(serializer);
+  absl::flat_hash_map<Id::T, Id> mapping;
+  mapping.reserve(numWords);
+  for (uint64_t i = 0; i < numWords; ++i) {
+    auto bits = readValue<Id::T>(serializer);
+    auto word = readValue<std::string>(serializer);
+    auto index = localVocab.getIndexAndAddIfNotContained(
+        LocalVocabEntry::fromStringRepresentation(std::move(word), context));
+    mapping.emplace(bits, Id::makeFromLocalVocabIndex(index));
+  }
+
+  DeltaTriplesWriteAheadLog::Batch batch;
+  auto numOperations = readValue<uint64_t>(serializer);
+  batch.reserve(numOperations);
+  for (uint64_t i = 0; i < numOperations; ++i) {
+    auto& operation = batch.emplace_back();
+    operation.isInsertion_ = readValue<bool>(serializer);
+    auto ids = readValue<std::vector<Id>>(serializer);
+    ad_utility::detail::remapLocalVocab(ids, mapping);
+    AD_CORRECTNESS_CHECK(ids.size() % 4 == 0);
+    operation.triples_.reserve(ids.size() / 4);
+    for (size_t j = 0; j < ids.size(); j += 4) {
+      operation.triples_.emplace_back(
+          std::array{ids[j], ids[j + 1], ids[j + 2], ids[j + 3]});
+    }
+  }
+  return batch;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+DeltaTriplesWriteAheadLog::DeltaTriplesWriteAheadLog(
+    std::filesystem::path path)
+    : path_{std::move(path)} {}
+
+// _____________________________________________________________________________
+uint32_t DeltaTriplesWriteAheadLog::crc32(std::string_view bytes) {
+  uint32_t crc = 0xFFFFFFFFu;
+  for (char c : bytes) {
+    crc = crcTable[(crc ^ static_cast<uint8_t>(c)) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::append(const Batch& batch) const {
+  std::vector<char> payload = serializeBatch(batch);
+  uint64_t payloadSize = payload.size();
+  uint32_t checksum = crc32({payload.data(), payload.size()});
+
+  size_t sizeBefore = sizeInBytes();
+  bool success = false;
+  {
+    std::ofstream out{path_, std::ios::binary | std::ios::app};
+    if (sizeBefore == 0) {
+      out.write(magicBytes.data(), magicBytes.size());
+      out.write(reinterpret_cast<const char*>(&formatVersion),
+                sizeof(formatVersion));
+    }
+    out.write(reinterpret_cast<const char*>(&payloadSize), sizeof(payloadSize));
+    out.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+    out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    out.flush();
+    success = static_cast<bool>(out);
+  }
+  if (success) {
+    return;
+  }
+  // Remove the part of the record that was written, so that later records
+  // are not appended after a torn one (which would make them unreadable).
+  std::error_code errorCode;
+  if (sizeBefore == 0) {
+    std::filesystem::remove(path_, errorCode);
+  } else {
+    std::filesystem::resize_file(path_, sizeBefore, errorCode);
+  }
+  AD_THROW(absl::StrCat(
+      "Could not append the update to the write-ahead log ", path_.string(),
+      errorCode ? absl::StrCat(", and could not remove the incomplete record: ",
+                               errorCode.message())
+                : ""));
+}
+
+// _____________________________________________________________________________
+auto DeltaTriplesWriteAheadLog::read(LocalVocab& localVocab,
+                                     const LocalVocabContext& context) const
+    -> std::vector<Batch> {
+  if (!std::filesystem::exists(path_)) {
+    return {};
+  }
+  std::ifstream in{path_, std::ios::binary};
+  std::string content{std::istreambuf_iterator<char>{in},
+                      std::istreambuf_iterator<char>{}};
+  // The header itself is incomplete, so no record was ever written.
+  if (content.size() < headerSize) {
+    remove();
+    return {};
+  }
+  AD_CORRECTNESS_CHECK(
+      std::string_view(content).substr(0, magicBytes.size()) == magicBytes,
+      "The file ", path_.string(), " is not a write-ahead log of QLever");
+  uint16_t version;
+  std::memcpy(&version, content.data() + magicBytes.size(), sizeof(version));
+  AD_CORRECTNESS_CHECK(version == formatVersion,
+                       "The format version of the write-ahead log ",
+                       path_.string(), " is ", version, ", but expected ",
+                       formatVersion);
+
+  std::vector<Batch> batches;
+  size_t position = headerSize;
+  while (content.size() - position >= recordPrefixSize) {
+    uint64_t payloadSize;
+    uint32_t checksum;
+    std::memcpy(&payloadSize, content.data() + position, sizeof(payloadSize));
+    std::memcpy(&checksum, content.data() + position + sizeof(payloadSize),
+                sizeof(checksum));
+    size_t payloadBegin = position + recordPrefixSize;
+    if (content.size() - payloadBegin < payloadSize) {
+      break;
+    }
+    std::string_view payload{content.data() + payloadBegin, payloadSize};
+    if (crc32(payload) != checksum) {
+      break;
+    }
+    batches.push_back(deserializeBatch({payload.begin(), payload.end()},
+                                       localVocab, context));
+    position = payloadBegin + payloadSize;
+  }
+
+  if (position != content.size()) {
+    AD_LOG_WARN << "The write-ahead log " << path_ << " ends with "
+                << content.size() - position
+                << " bytes that don't form a valid record (probably from an "
+                   "interrupted write), these are discarded"
+                << std::endl;
+    std::filesystem::resize_file(path_, position);
+  }
+  return batches;
+}
+
+// _____________________________________________________________________________
+size_t DeltaTriplesWriteAheadLog::sizeInBytes() const {
+  std::error_code errorCode;
+  auto size = std::filesystem::file_size(path_, errorCode);
+  return errorCode ? 0 : static_cast<size_t>(size);
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::remove() const {
+  std::filesystem::remove(path_);
+}
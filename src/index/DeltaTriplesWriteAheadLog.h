@@ -0,0 +1,75 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
+#define QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
+
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "global/IdTriple.h"
+#include "index/LocalVocab.h"
+
+// An append-only log of the changes of the `DeltaTriples`, which is written
+// in addition to the complete snapshot of the `DeltaTriples` (see
+// `DeltaTriples::writeToDisk`). Each update request appends one batch of
+// insertions and deletions, so the cost of persisting an update only depends
+// on the size of the update and not on the total number of delta triples.
+//
+// The file consists of a header followed by the records of the batches. Each
+// record consists of the size of its payload, a CRC-32 checksum of the
+// payload, and the payload itself. The payload contains the string
+// representations of the local vocab entries that are used in the batch,
+// followed by the operations of the batch. A record that is incomplete or
+// whose checksum doesn't match (e.g. because the server crashed while writing
+// it) and everything after it is discarded when reading the log.
+class DeltaTriplesWriteAheadLog {
+ public:
+  using Triples = std::vector<IdTriple<0>>;
+
+  // One operation of a batch: The `triples_` were either inserted or deleted.
+  struct Operation {
+    bool isInsertion_;
+    Triples triples_;
+  };
+  // The operations of one update request in the order in which they were
+  // applied.
+  using Batch = std::vector<Operation>;
+
+  static constexpr std::string_view magicBytes = "QLEVER.UPDATE.WAL";
+  // Has to be increased when the format of the records is changed.
+  static constexpr uint16_t formatVersion = 1;
+
+ private:
+  std::filesystem::path path_;
+
+ public:
+  explicit DeltaTriplesWriteAheadLog(std::filesystem::path path);
+
+  const std::filesystem::path& path() const { return path_; }
+
+  // Append the `batch` to the log, the header is written if the log doesn't
+  // exist yet. If the batch can't be written completely, the log is truncated
+  // to its previous size and an exception is thrown.
+  void append(const Batch& batch) const;
+
+  // Read all the valid batches from the log. The entries of the local vocab
+  // that are used by the triples are added to `localVocab`. If the log ends
+  // with an invalid record, the file is truncated to the valid records.
+  std::vector<Batch> read(LocalVocab& localVocab,
+                          const LocalVocabContext& context) const;
+
+  // The size of the log in bytes (0 if the log doesn't exist).
+  size_t sizeInBytes() const;
+
+  // Delete the log.
+  void remove() const;
+
+  // The CRC-32 checksum (as used by zlib or PNG) of the `bytes`.
+  static uint32_t crc32(std::string_view bytes);
+};
+
+#endif  // QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
@@ -108,6 +108,33 @@ idToStringAndTypeForEncodedValue(Id id);
 // IRI via the `EncodedIriManager` in the index.
 LiteralOrIri encodedIdToLiteralOrIri(Id id, const IndexImpl& index);
 
+// Helper for `idToStringAndType` and `idsToStringAndType`: Convert a
+// `LiteralOrIri` (from one of the vocabularies) to the (string, type) format
+// that is documented below. Return `std::nullopt` if `returnOnlyLiterals` is
+// true and the `word` is not a literal.
+template <bool removeQuotesAndAngleBrackets, bool returnOnlyLiterals,
+          typename EscapeFunction>
+std::optional<std::pair<std::string, const char*>> literalOrIriToStringAndType(
+    const LiteralOrIri& word, EscapeFunction& escapeFunction) {
+  if constexpr (returnOnlyLiterals) {
+    if (!word.isLiteral()) {
+      return std::nullopt;
+    }
+  }
+  if (word.isIri()) {
+    if (auto blankNodeString = blankNodeIriToString(word.getIri())) {
+      return std::pair{std::move(blankNodeString.value()), nullptr};
+    }
+  }
+  if constexpr (removeQuotesAndAngleBrackets) {
+    // TODO<joka921> Can we get rid of the string copying here?
+    return std::pair{
+        escapeFunction(std::string{asStringViewUnsafe(word.getContent())}),
+        nullptr};
+  }
+  return std::pair{escapeFunction(word.toStringRepresentation()), nullptr};
+}
+
 // Convert the `id` to a human-readable string. The `index` is used to resolve
 // `Id`s with datatype `VocabIndex` or `TextRecordIndex`. The `localVocab` is
 // used to resolve `Id`s with datatype `LocalVocabIndex`. The `escapeFunction`
@@ -134,25 +161,10 @@ std::optional<std::pair<std::string, const char*>> idToStringAndType(
     }
   }
 
-  auto handleIriOrLiteral = [&escapeFunction](const LiteralOrIri& word)
-      -> std::optional<std::pair<std::string, const char*>> {
-    if constexpr (returnOnlyLiterals) {
-      if (!word.isLiteral()) {
-        return std::nullopt;
-      }
-    }
-    if (word.isIri()) {
-      if (auto blankNodeString = blankNodeIriToString(word.getIri())) {
-        return std::pair{std::move(blankNodeString.value()), nullptr};
-      }
-    }
-    if constexpr (removeQuotesAndAngleBrackets) {
-      // TODO<joka921> Can we get rid of the string copying here?
-      return std::pair{
-          escapeFunction(std::string{asStringViewUnsafe(word.getContent())}),
-          nullptr};
-    }
-    return std::pair{escapeFunction(word.toStringRepresentation()), nullptr};
+  auto handleIriOrLiteral = [&escapeFunction](const LiteralOrIri& word) {
+    return literalOrIriToStringAndType<removeQuotesAndAngleBrackets,
+                                       returnOnlyLiterals>(word,
+                                                           escapeFunction);
   };
 
   switch (id.getDatatype()) {
@@ -175,14 +187,13 @@ std::optional<std::pair<std::string, const char*>> idToStringAndType(
   }
 }
 
-// Batch variant of idToStringAndType.
-// Precondition: `ids` is sorted by `ValueId` (as `ConstructBatchEvaluator`
-// does before calling vocabulary lookups). Under this precondition, all
-// `VocabIndex` IDs form a single contiguous block that is already sorted by
-// vocabulary position, so they can be resolved last and in sequential order
-// for I/O-local access to the on-disk vocabulary. All other IDs are resolved
-// immediately since their values are either encoded in the id bits or stored
-// in the in-memory `LocalVocab`.
+// Batch variant of idToStringAndType. All the `VocabIndex` IDs are resolved
+// via a single `lookupBatch` on the vocabulary, which reads all the words that
+// are stored on disk in one batch of I/O requests (see
+// `VocabularyOnDisk::lookupBatch`). All other IDs are resolved individually
+// since their values are either encoded in the id bits or stored in the
+// in-memory `LocalVocab`. The `ids` may be in any order and may contain
+// duplicates.
 template <bool removeQuotesAndAngleBrackets = false,
           bool returnOnlyLiterals = false,
           typename EscapeFunction = ql::identity>
@@ -193,31 +204,31 @@ idsToStringAndType(const Index& index, ql::span<const Id> ids,
   std::vector<std::optional<std::pair<std::string, const char*>>> results(
       ids.size());
 
-  // `ids` is sorted by `ValueId`. Because the datatype tag occupies the 4 most
-  // significant bits of a `ValueId`, all `VocabIndex` IDs form a single
-  // contiguous block and are already sorted by vocabulary position within that
-  // block. We resolve all other datatypes immediately (in-memory lookups) and
-  // record where the `VocabIndex` block begins.
-  size_t vocabBegin = ids.size();
+  std::vector<::VocabIndex> vocabIndices;
+  std::vector<size_t> vocabPositions;
   for (size_t i = 0; i < ids.size(); ++i) {
-    if (ids[i].getDatatype() != Datatype::VocabIndex) {
+    if (ids[i].getDatatype() == Datatype::VocabIndex) {
+      vocabIndices.push_back(ids[i].getVocabIndex());
+      vocabPositions.push_back(i);
+    } else {
       results[i] =
           idToStringAndType<removeQuotesAndAngleBrackets, returnOnlyLiterals>(
               index, ids[i], localVocab, escapeFunction);
-    } else if (vocabBegin == ids.size()) {
-      vocabBegin = i;
     }
   }
 
-  // Resolve the contiguous `VocabIndex` block in sorted (vocabulary-position)
-  // order, giving sequential I/O access to the on-disk vocabulary file.
-  for (size_t i = vocabBegin;
-       i < ids.size() && ids[i].getDatatype() == Datatype::VocabIndex; ++i) {
-    results[i] =
-        idToStringAndType<removeQuotesAndAngleBrackets, returnOnlyLiterals>(
-            index, ids[i], localVocab, escapeFunction);
+  if (vocabIndices.empty()) {
+    return results;
+  }
+  auto words = index.getVocab().lookupBatch(vocabIndices);
+  AD_CORRECTNESS_CHECK(words->size() == vocabIndices.size());
+  for (size_t i = 0; i < vocabPositions.size(); ++i) {
+    results[vocabPositions[i]] =
+        literalOrIriToStringAndType<removeQuotesAndAngleBrackets,
+                                    returnOnlyLiterals>(
+            LiteralOrIri::fromStringRepresentation(std::string{(*words)[i]}),
+            escapeFunction);
   }
-
   return results;
 }
 
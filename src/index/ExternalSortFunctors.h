@@ -13,6 +13,7 @@
 #define QLEVER_SRC_INDEX_EXTERNALSORTFUNCTORS_H
 
 #include <array>
+#include <numeric>
 #include <tuple>
 #include <vector>
 
@@ -61,6 +62,17 @@ struct SortTriple {
       return cGraph < 0;
     }
   }
+
+  // The columns by which this comparator sorts, s.t. blocks can also be sorted
+  // with the radix sort from `IdTableRadixSort.h`, which yields the same order
+  // because `compareWithoutLocalVocab` compares the bits of the `Id`s.
+  std::vector<ColumnIndex> radixSortColumns(size_t) const {
+    if constexpr (hasGraphColumn) {
+      return {i0, i1, i2, ADDITIONAL_COLUMN_GRAPH_ID};
+    } else {
+      return {i0, i1, i2};
+    }
+  }
 };
 
 using SortByPSO = SortTriple<1, 0, 2>;
@@ -76,6 +88,13 @@ struct SortText {
           return x.compareWithoutLocalVocab(y) < 0;
         });
   }
+
+  // All columns are sort columns, see `SortTriple::radixSortColumns`.
+  std::vector<ColumnIndex> radixSortColumns(size_t numColumns) const {
+    std::vector<ColumnIndex> columns(numColumns);
+    std::iota(columns.begin(), columns.end(), ColumnIndex{0});
+    return columns;
+  }
 };
 
 // A comparator that sorts rows by a runtime-specified list of column indices.
@@ -101,6 +120,11 @@ struct SortByColumns {
     }
     return false;
   }
+
+  // See `SortTriple::radixSortColumns`.
+  const std::vector<ColumnIndex>& radixSortColumns(size_t) const {
+    return sortColumns_;
+  }
 };
 
 #ifdef QLEVER_CHEAPER_COMPILATION
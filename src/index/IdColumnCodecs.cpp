@@ -0,0 +1,282 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/IdColumnCodecs.h"
+
+#include <absl/numeric/bits.h>
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "backports/algorithm.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/ConstexprUtils.h"
+#include "util/Exception.h"
+
+namespace columnCodecs {
+namespace {
+
+// The layout of a column that is compressed with one of the lightweight codecs
+// is `[header][packed words]`. The header consists of three 64-bit words: The
+// first value of the column (only used by `Delta`), the reference value that
+// is added to each unpacked value, and the number of values in the column
+// together with the bit width of the packed values (in the lowest byte). The
+// values are packed in groups of 64, s.t. a group with bit width `w` occupies
+// exactly `w` 64-bit words. The last group is padded with zeros.
+constexpr size_t groupSize = 64;
+constexpr size_t wordSize = sizeof(uint64_t);
+constexpr size_t headerSize = 3 * wordSize;
+
+struct Header {
+  uint64_t first_ = 0;
+  uint64_t reference_ = 0;
+  uint8_t bitWidth_ = 0;
+  uint64_t numValues_ = 0;
+};
+
+// Read or write the `index`-th 64-bit word at `data`. We use `memcpy`, because
+// the data is stored in a `char` buffer without any alignment guarantees. The
+// compiler turns this into a single (unaligned) load or store.
+uint64_t loadWord(const char* data, size_t index) {
+  uint64_t word;
+  std::memcpy(&word, data + index * wordSize, wordSize);
+  return word;
+}
+void storeWord(char* data, size_t index, uint64_t word) {
+  std::memcpy(data + index * wordSize, &word, wordSize);
+}
+
+// Return the number of packed 64-bit words for `numValues` values with the
+// given `bitWidth`.
+size_t numPackedWords(size_t numValues, size_t bitWidth) {
+  return (numValues + groupSize - 1) / groupSize * bitWidth;
+}
+
+// Pack one group of 64 `values`, each of which must fit into `Width` bits,
+// into `Width` words at `target`.
+template <size_t Width>
+void packGroup(const uint64_t* values, char* target) {
+  std::array<uint64_t, Width> words{};
+  ad_utility::ConstexprForLoopVi(
+      std::make_index_sequence<groupSize>{}, [&](auto i) {
+        constexpr size_t bit = decltype(i)::value * Width;
+        constexpr size_t word = bit / 64;
+        constexpr size_t shift = bit % 64;
+        words[word] |= values[decltype(i)::value] << shift;
+        if constexpr (shift + Width > 64) {
+          words[word + 1] |= values[decltype(i)::value] >> (64 - shift);
+        }
+      });
+  for (size_t j = 0; j < Width; ++j) {
+    storeWord(target, j, words[j]);
+  }
+}
+
+// Unpack one group of 64 values with bit width `Width` from `packed`, add the
+// `reference` to each of them, and store the result at `target`. All the
+// shifts and masks are compile-time constants and the loop is fully unrolled,
+// which allows the compiler to vectorize the unpacking.
+template <size_t Width>
+void unpackGroup(const char* packed, uint64_t reference, Id* target) {
+  if constexpr (Width == 0) {
+    std::fill(target, target + groupSize, Id::fromBits(reference));
+  } else {
+    constexpr uint64_t mask =
+        Width == 64 ? ~uint64_t{0} : (uint64_t{1} << Width) - 1;
+    ad_utility::ConstexprForLoopVi(
+        std::make_index_sequence<groupSize>{}, [&](auto i) {
+          constexpr size_t bit = decltype(i)::value * Width;
+          constexpr size_t word = bit / 64;
+          constexpr size_t shift = bit % 64;
+          uint64_t value = loadWord(packed, word) >> shift;
+          if constexpr (shift + Width > 64) {
+            value |= loadWord(packed, word + 1) << (64 - shift);
+          }
+          target[decltype(i)::value] = Id::fromBits((value & mask) + reference);
+        });
+  }
+}
+
+// Bit-pack the `values` (which have already been reduced by the `reference`)
+// and prepend the `header`.
+std::vector<char> pack(const std::vector<uint64_t>& values, Header header) {
+  const size_t numWords = numPackedWords(values.size(), header.bitWidth_);
+  std::vector<char> result(headerSize + numWords * wordSize, 0);
+  storeWord(result.data(), 0, header.first_);
+  storeWord(result.data(), 1, header.reference_);
+  storeWord(result.data(), 2, header.bitWidth_ | (header.numValues_ << 8));
+  char* target = result.data() + headerSize;
+  ad_utility::RuntimeValueToCompileTimeValueVi<64>(
+      header.bitWidth_, [&](auto width) {
+        constexpr size_t Width = decltype(width)::value;
+        if constexpr (Width > 0) {
+          std::array<uint64_t, groupSize> group{};
+          for (size_t i = 0; i < values.size(); i += groupSize) {
+            size_t n = std::min(groupSize, values.size() - i);
+            std::copy(values.begin() + i, values.begin() + i + n,
+                      group.begin());
+            std::fill(group.begin() + n, group.end(), 0);
+            packGroup<Width>(group.data(), target);
+            target += Width * wordSize;
+          }
+        }
+      });
+  return result;
+}
+
+// Unpack `target.size()` values that were packed using `pack`.
+void unpack(const char* packed, const Header& header, ql::span<Id> target) {
+  ad_utility::RuntimeValueToCompileTimeValueVi<64>(
+      header.bitWidth_, [&](auto width) {
+        constexpr size_t Width = decltype(width)::value;
+        const size_t numFullGroups = target.size() / groupSize;
+        Id* out = target.data();
+        for (size_t i = 0; i < numFullGroups; ++i) {
+          unpackGroup<Width>(packed, header.reference_, out);
+          packed += Width * wordSize;
+          out += groupSize;
+        }
+        if (size_t rest = target.size() % groupSize; rest > 0) {
+          std::array<Id, groupSize> lastGroup;
+          unpackGroup<Width>(packed, header.reference_, lastGroup.data());
+          std::copy(lastGroup.begin(), lastGroup.begin() + rest, out);
+        }
+      });
+}
+
+// Reduce the `values` by their minimum and return the minimum as the reference
+// value, together with the number of bits required for the reduced values.
+std::pair<uint64_t, uint8_t> reduceByMinimum(std::vector<uint64_t>& values) {
+  if (values.empty()) {
+    return {0, 0};
+  }
+  auto [min, max] = ql::ranges::minmax(values);
+  for (auto& value : values) {
+    value -= min;
+  }
+  return {min, static_cast<uint8_t>(absl::bit_width(max - min))};
+}
+
+// _____________________________________________________________________________
+std::vector<char> compressFrameOfReference(ql::span<const Id> column) {
+  std::vector<uint64_t> values;
+  values.reserve(column.size());
+  for (Id id : column) {
+    values.push_back(id.getBits());
+  }
+  auto [reference, bitWidth] = reduceByMinimum(values);
+  return pack(values, Header{0, reference, bitWidth, column.size()});
+}
+
+// _____________________________________________________________________________
+std::vector<char> compressDelta(ql::span<const Id> column) {
+  if (column.empty()) {
+    return pack({}, Header{});
+  }
+  // The deltas are computed with the usual wraparound of unsigned integers,
+  // so this also works (but is less effective) for unsorted columns.
+  std::vector<uint64_t> deltas;
+  deltas.reserve(column.size() - 1);
+  for (size_t i = 1; i < column.size(); ++i) {
+    deltas.push_back(column[i].getBits() - column[i - 1].getBits());
+  }
+  auto [reference, bitWidth] = reduceByMinimum(deltas);
+  return pack(deltas, Header{column[0].getBits(), reference, bitWidth,
+                             column.size()});
+}
+
+// Read the header of a column that was compressed with one of the lightweight
+// codecs. Check that the column has `numValues` values, and that the size of
+// the `compressedColumn` matches the `numPackedValues`.
+Header readHeader(ql::span<const char> compressedColumn, size_t numValues,
+                  size_t numPackedValues) {
+  AD_CORRECTNESS_CHECK(compressedColumn.size() >= headerSize);
+  uint64_t sizeAndBitWidth = loadWord(compressedColumn.data(), 2);
+  Header header{loadWord(compressedColumn.data(), 0),
+                loadWord(compressedColumn.data(), 1),
+                static_cast<uint8_t>(sizeAndBitWidth & 0xFF),
+                sizeAndBitWidth >> 8};
+  AD_CORRECTNESS_CHECK(header.numValues_ == numValues);
+  AD_CORRECTNESS_CHECK(header.bitWidth_ <= 64);
+  AD_CORRECTNESS_CHECK(compressedColumn.size() ==
+                       headerSize +
+                           numPackedWords(numPackedValues, header.bitWidth_) *
+                               wordSize);
+  return header;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::vector<char> compress(ql::span<const Id> column, ColumnCodec codec) {
+  switch (codec) {
+    case ColumnCodec::Zstd:
+      return ZstdWrapper::compress(column.data(), column.size() * sizeof(Id));
+    case ColumnCodec::FrameOfReference:
+      return compressFrameOfReference(column);
+    case ColumnCodec::Delta:
+      return compressDelta(column);
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+std::pair<std::vector<char>, ColumnCodec> compressWithSmallestCodec(
+    ql::span<const Id> column) {
+  // The order matters for ties, see the documentation in the header.
+  std::pair result{compress(column, ColumnCodec::FrameOfReference),
+                   ColumnCodec::FrameOfReference};
+  for (auto codec : {ColumnCodec::Delta, ColumnCodec::Zstd}) {
+    auto compressed = compress(column, codec);
+    if (compressed.size() < result.first.size()) {
+      result = {std::move(compressed), codec};
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void decompress(ql::span<const char> compressedColumn, ColumnCodec codec,
+                ql::span<Id> target) {
+  switch (codec) {
+    case ColumnCodec::Zstd: {
+      auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
+          compressedColumn.data(), compressedColumn.size(), target.data(),
+          target.size() * sizeof(Id));
+      AD_CORRECTNESS_CHECK(target.size() * sizeof(Id) == numBytesActuallyRead);
+      return;
+    }
+    case ColumnCodec::FrameOfReference: {
+      auto header =
+          readHeader(compressedColumn, target.size(), target.size());
+      unpack(compressedColumn.data() + headerSize, header, target);
+      return;
+    }
+    case ColumnCodec::Delta: {
+      if (target.empty()) {
+        readHeader(compressedColumn, 0, 0);
+        return;
+      }
+      auto header =
+          readHeader(compressedColumn, target.size(), target.size() - 1);
+      unpack(compressedColumn.data() + headerSize, header, target.subspan(1));
+      // Compute the prefix sums of the deltas.
+      uint64_t current = header.first_;
+      target[0] = Id::fromBits(current);
+      for (size_t i = 1; i < target.size(); ++i) {
+        current += target[i].getBits();
+        target[i] = Id::fromBits(current);
+      }
+      return;
+    }
+  }
+  throw std::runtime_error{absl::StrCat(
+      "Unknown codec ", static_cast<int>(codec),
+      " for a compressed column. The index might be corrupted or was built "
+      "with a newer version of QLever")};
+}
+
+}  // namespace columnCodecs
@@ -0,0 +1,61 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_IDCOLUMNCODECS_H
+#define QLEVER_SRC_INDEX_IDCOLUMNCODECS_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "backports/span.h"
+#include "global/Id.h"
+
+// The codec with which a single column of a block of a permutation is
+// compressed. The numeric values are stored in the index, so they must never
+// change. `Zstd` has to be `0`, because the blocks of indices that were built
+// before the other codecs existed are all compressed with zstd.
+enum class ColumnCodec : uint8_t {
+  // Generic compression of the raw 64-bit `Id`s using zstd.
+  Zstd = 0,
+  // Frame of reference: Store the minimum of the column and then the
+  // difference of each value to that minimum, bit-packed with the smallest
+  // possible bit width. This is very effective for columns that are (almost)
+  // constant within a block, like the first column of a permutation.
+  FrameOfReference = 1,
+  // Delta encoding: Store the first value and then the difference between
+  // each pair of consecutive values, again with frame of reference and
+  // bit-packing. This is very effective for sorted columns, like the second
+  // column of a permutation.
+  Delta = 2,
+};
+
+// Lightweight integer codecs for columns of `Id`s. The `Id`s are treated as
+// plain 64-bit integers (via `getBits()`), so the codecs work for all
+// datatypes.
+namespace columnCodecs {
+
+// The largest value of `ColumnCodec`, used to validate values read from disk.
+static constexpr ColumnCodec maxColumnCodec = ColumnCodec::Delta;
+
+// Compress the `column` using the given `codec`.
+std::vector<char> compress(ql::span<const Id> column, ColumnCodec codec);
+
+// Compress the `column` with each of the codecs and return the smallest result
+// together with the codec that was used. If several codecs lead to the same
+// size, the lightweight codecs are preferred, because they are much cheaper to
+// decompress.
+std::pair<std::vector<char>, ColumnCodec> compressWithSmallestCodec(
+    ql::span<const Id> column);
+
+// Decompress the `compressedColumn` (which must have been compressed with the
+// `codec`) into the `target`. The size of the `target` must be exactly the
+// number of `Id`s in the original column, else an exception is thrown.
+void decompress(ql::span<const char> compressedColumn, ColumnCodec codec,
+                ql::span<Id> target);
+
+}  // namespace columnCodecs
+
+#endif  // QLEVER_SRC_INDEX_IDCOLUMNCODECS_H
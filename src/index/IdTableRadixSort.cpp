@@ -0,0 +1,196 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/IdTableRadixSort.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <numeric>
+
+#include "util/Exception.h"
+#include "util/ParallelExecutor.h"
+
+namespace ad_utility::radixSort {
+namespace {
+
+// The keys are sorted by digits of 8 bits, starting with the least significant
+// digit. Digits in which all keys are equal are skipped, which is very common
+// for the most significant bits (the datatype of the `Id`s).
+constexpr size_t bitsPerDigit = 8;
+constexpr size_t numBuckets = size_t{1} << bitsPerDigit;
+constexpr size_t numDigits = 64 / bitsPerDigit;
+constexpr uint64_t digitMask = numBuckets - 1;
+
+// Each thread should process at least this many rows, else the overhead of
+// spawning the threads dominates.
+constexpr size_t minNumRowsPerThread = 1 << 16;
+
+// Split the range `[0, numRows)` into `numChunks` contiguous chunks and call
+// `function(chunkIndex, begin, end)` for each of them in parallel.
+template <typename F>
+void forEachChunk(size_t numRows, size_t numChunks, const F& function) {
+  if (numChunks == 1) {
+    function(0, 0, numRows);
+    return;
+  }
+  std::vector<std::packaged_task<void()>> tasks;
+  for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+    size_t begin = numRows * chunk / numChunks;
+    size_t end = numRows * (chunk + 1) / numChunks;
+    tasks.emplace_back(
+        [&function, chunk, begin, end]() { function(chunk, begin, end); });
+  }
+  ad_utility::runTasksInParallel(std::move(tasks));
+}
+
+// Return true iff one of the `sortColumns` contains a `LocalVocabIndex`. These
+// are compared by their string value, not by their bits.
+bool containsLocalVocabIndex(const std::vector<ql::span<Id>>& columns,
+                             const std::vector<ColumnIndex>& sortColumns) {
+  return ql::ranges::any_of(sortColumns, [&columns](ColumnIndex col) {
+    return ql::ranges::any_of(columns.at(col), [](Id id) {
+      return id.getDatatype() == Datatype::LocalVocabIndex;
+    });
+  });
+}
+
+// The actual implementation of `sortColumnsByBits`. The `Index` is the type of
+// the row indices in the permutation, using 32-bit indices where possible
+// reduces the memory and the memory bandwidth.
+template <typename Index>
+void sortColumnsByBitsImpl(const std::vector<ql::span<Id>>& columns,
+                           const std::vector<ColumnIndex>& sortColumns,
+                           const ad_utility::AllocatorWithLimit<Id>& allocator,
+                           size_t numThreads) {
+  const size_t numRows = columns.at(0).size();
+  AD_CORRECTNESS_CHECK(numRows <= std::numeric_limits<Index>::max());
+  const size_t numChunks =
+      std::clamp(numRows / minNumRowsPerThread, size_t{1}, numThreads);
+
+  using Indices = std::vector<Index, ad_utility::AllocatorWithLimit<Index>>;
+  Indices permutation(numRows, allocator);
+  std::iota(permutation.begin(), permutation.end(), Index{0});
+  {
+    using Keys =
+        std::vector<uint64_t, ad_utility::AllocatorWithLimit<uint64_t>>;
+    Keys keys(numRows, allocator);
+    Keys keysBuffer(numRows, allocator);
+    Indices permutationBuffer(numRows, allocator);
+    // `histograms[chunk][bucket]` first holds the number of keys with the
+    // current digit `bucket` in the `chunk` and then the position where the
+    // next such key from this chunk is written.
+    std::vector<std::array<size_t, numBuckets>> histograms(numChunks);
+    std::vector<uint64_t> differentBitsPerChunk(numChunks);
+
+    // LSD radix sort: The least significant sort column is sorted first, and
+    // because each pass is stable, the order of the previous passes is kept for
+    // equal keys.
+    for (auto col = sortColumns.rbegin(); col != sortColumns.rend(); ++col) {
+      ql::span<const Id> column = columns.at(*col);
+      // Gather the keys in the current order and determine the bits in which
+      // they differ from the very first key.
+      const uint64_t firstKey = column[permutation[0]].getBits();
+      forEachChunk(numRows, numChunks,
+                   [&](size_t chunk, size_t begin, size_t end) {
+                     uint64_t differentBits = 0;
+                     for (size_t i = begin; i < end; ++i) {
+                       keys[i] = column[permutation[i]].getBits();
+                       differentBits |= keys[i] ^ firstKey;
+                     }
+                     differentBitsPerChunk[chunk] = differentBits;
+                   });
+      uint64_t differentBits = 0;
+      for (uint64_t bits : differentBitsPerChunk) {
+        differentBits |= bits;
+      }
+
+      for (size_t digit = 0; digit < numDigits; ++digit) {
+        const size_t shift = digit * bitsPerDigit;
+        if (((differentBits >> shift) & digitMask) == 0) {
+          continue;
+        }
+        forEachChunk(numRows, numChunks,
+                     [&](size_t chunk, size_t begin, size_t end) {
+                       auto& histogram = histograms[chunk];
+                       histogram.fill(0);
+                       for (size_t i = begin; i < end; ++i) {
+                         ++histogram[(keys[i] >> shift) & digitMask];
+                       }
+                     });
+        // Compute the exclusive prefix sums in the order (bucket, chunk), s.t.
+        // the keys from an earlier chunk come first within each bucket, which
+        // makes the sort stable.
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < numBuckets; ++bucket) {
+          for (auto& histogram : histograms) {
+            size_t count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += count;
+          }
+        }
+        forEachChunk(numRows, numChunks,
+                     [&](size_t chunk, size_t begin, size_t end) {
+                       auto& histogram = histograms[chunk];
+                       for (size_t i = begin; i < end; ++i) {
+                         size_t& target =
+                             histogram[(keys[i] >> shift) & digitMask];
+                         keysBuffer[target] = keys[i];
+                         permutationBuffer[target] = permutation[i];
+                         ++target;
+                       }
+                     });
+        std::swap(keys, keysBuffer);
+        std::swap(permutation, permutationBuffer);
+      }
+    }
+  }
+
+  // Apply the permutation to one column after the other.
+  std::vector<Id, ad_utility::AllocatorWithLimit<Id>> buffer(numRows,
+                                                             allocator);
+  for (ql::span<Id> column : columns) {
+    forEachChunk(numRows, numChunks, [&](size_t, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        buffer[i] = column[permutation[i]];
+      }
+    });
+    forEachChunk(numRows, numChunks, [&](size_t, size_t begin, size_t end) {
+      std::copy(buffer.begin() + begin, buffer.begin() + end,
+                column.begin() + begin);
+    });
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+bool sortColumnsByBits(std::vector<ql::span<Id>> columns,
+                       const std::vector<ColumnIndex>& sortColumns,
+                       const ad_utility::AllocatorWithLimit<Id>& allocator,
+                       size_t numThreads) {
+  if (columns.empty() || sortColumns.empty() ||
+      columns.at(0).size() < MIN_NUM_ROWS_FOR_RADIX_SORT) {
+    return false;
+  }
+  AD_CONTRACT_CHECK(ql::ranges::all_of(columns, [&columns](const auto& col) {
+    return col.size() == columns.at(0).size();
+  }));
+  if (containsLocalVocabIndex(columns, sortColumns)) {
+    return false;
+  }
+  numThreads = std::max(numThreads, size_t{1});
+  if (columns.at(0).size() <= std::numeric_limits<uint32_t>::max()) {
+    sortColumnsByBitsImpl<uint32_t>(columns, sortColumns, allocator,
+                                    numThreads);
+  } else {
+    sortColumnsByBitsImpl<uint64_t>(columns, sortColumns, allocator,
+                                    numThreads);
+  }
+  return true;
+}
+
+}  // namespace ad_utility::radixSort
@@ -0,0 +1,55 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_IDTABLERADIXSORT_H
+#define QLEVER_SRC_INDEX_IDTABLERADIXSORT_H
+
+#include <vector>
+
+#include "backports/span.h"
+#include "global/Constants.h"
+#include "global/Id.h"
+#include "util/AllocatorWithLimit.h"
+
+// A parallel LSD radix sort for the column-based `IdTable`. The `Id`s of the
+// sort columns are treated as unsigned 64-bit integers (via `getBits()`), which
+// is the same as the order of `Id::operator<` unless `LocalVocabIndex` ids are
+// involved. The sort first computes the sorting permutation from the sort
+// columns only (which is much more cache-friendly than swapping whole rows),
+// and then applies this permutation to one column after the other.
+namespace ad_utility::radixSort {
+
+// For smaller inputs, the overhead of the radix sort (in particular the
+// additional memory and the spawning of threads) doesn't pay off, and the
+// comparison-based sort is used instead.
+static constexpr size_t MIN_NUM_ROWS_FOR_RADIX_SORT = 1 << 14;
+
+// Sort the rows of the `columns` (which all must have the same size) in place,
+// lexicographically by the `sortColumns`. The sort is stable. Return `false`
+// without changing the `columns` if the radix sort can't or shouldn't be used,
+// because one of the sort columns contains a `LocalVocabIndex` or because
+// there are fewer than `MIN_NUM_ROWS_FOR_RADIX_SORT` rows. The `allocator` is
+// used for the temporary memory, which is about 32 bytes per row.
+bool sortColumnsByBits(std::vector<ql::span<Id>> columns,
+                       const std::vector<ColumnIndex>& sortColumns,
+                       const ad_utility::AllocatorWithLimit<Id>& allocator,
+                       size_t numThreads = NUM_SORT_THREADS);
+
+// Same as above, but for an `IdTable` or `IdTableStatic`.
+template <typename Table>
+bool sortByBits(Table& table, const std::vector<ColumnIndex>& sortColumns,
+                size_t numThreads = NUM_SORT_THREADS) {
+  std::vector<ql::span<Id>> columns;
+  columns.reserve(table.numColumns());
+  for (size_t i = 0; i < table.numColumns(); ++i) {
+    columns.push_back(table.getColumn(i));
+  }
+  return sortColumnsByBits(std::move(columns), sortColumns,
+                           table.getAllocator(), numThreads);
+}
+
+}  // namespace ad_utility::radixSort
+
+#endif  // QLEVER_SRC_INDEX_IDTABLERADIXSORT_H
@@ -5,6 +5,7 @@
 #include "index/IdTableUtils.h"
 
 #include "engine/CallFixedSize.h"
+#include "index/IdTableRadixSort.h"
 #include "util/ChunkedForLoop.h"
 #include "util/Exception.h"
 
@@ -14,14 +15,19 @@ void IdTableUtils::sort(IdTable& idTable,
                         const std::vector<ColumnIndex>& sortCols) {
   size_t width = idTable.numColumns();
 
+  // Large tables are sorted with a parallel radix sort on the bits of the
+  // `Id`s, which only falls back to the comparison-based sort below if one of
+  // the sort columns contains a `LocalVocabIndex`.
+  if (ad_utility::radixSort::sortByBits(idTable, sortCols)) {
+    return;
+  }
+
   // Instantiate specialized comparison lambdas for one and two sort columns
   // and use a generic comparison for a higher number of sort columns.
   // TODO<joka921> As soon as we have merged the benchmark, measure whether
   // this is in fact beneficial and whether it should also be applied for a
   // higher number of columns, maybe even using `CALL_FIXED_SIZE` for the
   // number of sort columns.
-  // TODO<joka921> Also experiment with sorting algorithms that take the
-  // column-based structure of the `IdTable` into account.
   if (sortCols.size() == 1) {
     ad_utility::callFixedSizeVi(width, [&idTable, col = sortCols[0]](auto I) {
       IdTableUtils::sort<I>(&idTable, col);
@@ -5,6 +5,7 @@
 #ifndef QLEVER_SRC_INDEX_IDTABLEUTILS_H
 #define QLEVER_SRC_INDEX_IDTABLEUTILS_H
 
+#include <algorithm>
 #include <vector>
 
 #include "backports/type_traits.h"
@@ -58,6 +59,24 @@ class IdTableUtils {
 
   static void sort(IdTable& idTable, const std::vector<ColumnIndex>& sortCols);
 
+  // Reorder the rows of `tab` s.t. its first `k` rows are the `k` smallest rows
+  // according to `comp`, and remove all the other rows. The remaining rows are
+  // not sorted. This takes linear time in the size of `tab`.
+  template <
+      int WIDTH, typename C,
+      typename = std::enable_if_t<std::is_same_v<
+          bool, std::invoke_result_t<C, typename IdTableStatic<WIDTH>::row_type,
+                                     typename IdTableStatic<WIDTH>::row_type>>>>
+  static void selectFirstK(IdTable* tab, size_t k, C comp) {
+    if (tab->size() <= k) {
+      return;
+    }
+    IdTableStatic<WIDTH> stab = std::move(*tab).toStatic<WIDTH>();
+    std::nth_element(stab.begin(), stab.begin() + k, stab.end(), comp);
+    stab.resize(k);
+    *tab = std::move(stab).toDynamic();
+  }
+
   // Return the number of distinct rows in the `input`. The input must have all
   // duplicates adjacent to each other (e.g. by being sorted), otherwise the
   // behavior is undefined. `checkCancellation()` is invoked regularly and can
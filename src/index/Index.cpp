@@ -202,6 +202,11 @@ const std::string& Index::getOnDiskBase() const {
 // ____________________________________________________________________________
 const std::string& Index::getIndexId() const { return pimpl_->getIndexId(); }
 
+// ____________________________________________________________________________
+const std::string& Index::getIndexFingerprint() const {
+  return pimpl_->getIndexFingerprint();
+}
+
 // ____________________________________________________________________________
 const std::string& Index::getGitShortHash() const {
   return pimpl_->getGitShortHash();
@@ -207,6 +207,9 @@ class Index {
   const std::string& getKbName() const;
   const std::string& getOnDiskBase() const;
   const std::string& getIndexId() const;
+  // A random identifier that is created whenever the index is (re)built, see
+  // `IndexImpl::getIndexFingerprint`.
+  const std::string& getIndexFingerprint() const;
   const std::string& getGitShortHash() const;
 
   NumNormalAndInternal numTriples() const;
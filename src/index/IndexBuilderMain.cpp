@@ -19,6 +19,7 @@
 #include "global/RuntimeParameters.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "libqlever/Qlever.h"
+#include "parser/ParallelBuffer.h"
 #include "util/ProgramOptionsHelpers.h"
 #include "util/ReadableNumberFacet.h"
 #include "util/json.h"
@@ -51,7 +52,8 @@ static constexpr auto checkNumParameterValues =
 
 // Convert the `filetype` string, which must be "ttl", "nt", or "nq" to the
 // corresponding `qlever::Filetype` value. If no filetyp is given, try to deduce
-// the type from the filename.
+// the type from the filename, ignoring the suffix of a compressed file (e.g.
+// `.ttl.zst` is a Turtle file).
 qlever::Filetype getFiletype(std::optional<std::string_view> filetype,
                              std::string_view filename) {
   auto impl = [](std::string_view s) -> std::optional<qlever::Filetype> {
@@ -75,17 +77,22 @@ qlever::Filetype getFiletype(std::optional<std::string_view> filetype,
     }
   }
 
-  auto posOfDot = filename.rfind('.');
+  std::string_view uncompressedFilename = filename;
+  if (getCompressionFormatFromSuffix(filename) != CompressionFormat::None) {
+    uncompressedFilename.remove_suffix(filename.size() - filename.rfind('.'));
+  }
+  auto posOfDot = uncompressedFilename.rfind('.');
   auto throwNotDeducable = [&filename]() {
     throw std::runtime_error{absl::StrCat(
         "Could not deduce the file format from the filename \"", filename,
-        "\". Either use files with names that end on `.ttl`, `.nt`, or `.nq`, "
-        "or explicitly set the format of the file via --file-format or -F")};
+        "\". Either use files with names that end on `.ttl`, `.nt`, or `.nq` "
+        "(optionally followed by `.gz`, `.bz2`, or `.zst`), or explicitly set "
+        "the format of the file via --file-format or -F")};
   };
   if (posOfDot == std::string::npos) {
     throwNotDeducable();
   }
-  auto deducedType = impl(filename.substr(posOfDot + 1));
+  auto deducedType = impl(uncompressedFilename.substr(posOfDot + 1));
   if (deducedType.has_value()) {
     return deducedType.value();
   } else {
@@ -114,7 +121,8 @@ T getParameterValue(size_t idx, const TsList& values, const T& defaultValue) {
 // into a `vector<InputFileSpecification>`.
 auto getFileSpecifications = [](const auto& filetype, auto& inputFile,
                                 const auto& defaultGraphs,
-                                const auto& parseParallel) {
+                                const auto& parseParallel,
+                                size_t numDecompressionThreads) {
   auto check = absl::bind_front(checkNumParameterValues, inputFile.size());
   check(filetype, "--file-format, -F");
   check(defaultGraphs, "--default-graph, -g");
@@ -140,6 +148,7 @@ auto getFileSpecifications = [](const auto& filetype, auto& inputFile,
     fileSpecs.emplace_back(filename, getFiletype(type, filename),
                            std::move(defaultGraph), parseInParallel,
                            parseInParallelSetExplicitly);
+    fileSpecs.back().numDecompressionThreads_ = numDecompressionThreads;
   }
   return fileSpecs;
 };
@@ -191,6 +200,7 @@ int main(int argc, char** argv) {
   std::vector<string> inputFile;
   std::vector<string> defaultGraphs;
   std::vector<bool> parseParallel;
+  size_t numDecompressionThreads = DEFAULT_NUM_DECOMPRESSION_THREADS;
   std::string materializedViewsJson;
 
   boost::program_options::options_description boostOptions(
@@ -204,7 +214,8 @@ int main(int argc, char** argv) {
       "The basename of the output files (required).");
   add("kg-input-file,f", po::value(&inputFile),
       "The file with the knowledge graph data to be parsed from. If omitted, "
-      "will read from stdin.");
+      "will read from stdin. Files that are compressed with gzip, bzip2, or "
+      "zstd are decompressed on the fly.");
   add("file-format,F", po::value(&filetype),
       "The format of the input file with the knowledge graph data. Must be one "
       "of [nt|ttl|nq]. Can be specified once (then all files use that format), "
@@ -220,6 +231,10 @@ int main(int argc, char** argv) {
       "using the N-Triples or N-Quads format, as well as for well-behaved "
       "Turtle files, where all the prefix declarations come in one block at "
       "the beginning and there are no multiline literals");
+  add("decompression-threads", po::value(&numDecompressionThreads),
+      "The number of threads that decompress an input file that is compressed "
+      "with zstd and consists of several frames (e.g. written by `pzstd`). "
+      "Default: 4.");
   add("kg-index-name,K", po::value(&config.kbIndexName_),
       "The name of the knowledge graph index (default: basename of "
       "`kg-input-file`).");
@@ -291,6 +306,13 @@ int main(int argc, char** argv) {
       "create materialized views after index building. Takes a JSON object "
       "mapping view names to SELECT queries for writing the view, for example: "
       R"({"view1": "SELECT ...", "view2": "SELECT ..."})");
+  add("reachability-index-predicates",
+      po::value(&config.reachabilityIndexPredicates_)
+          ->composing()
+          ->multitoken(),
+      "Build a reachability index for each of the given predicates (full IRIs "
+      "in angle brackets). It is used to answer transitive paths like "
+      "`?x <p>* ?y` where one side is bound without computing the paths.");
 
   // Process command line arguments.
   po::variables_map optionsMap;
@@ -319,8 +341,9 @@ int main(int argc, char** argv) {
               << qlever::version::GitShortHash << EMPH_OFF << std::endl;
 
   try {
-    config.inputFiles_ = getFileSpecifications(filetype, inputFile,
-                                               defaultGraphs, parseParallel);
+    config.inputFiles_ =
+        getFileSpecifications(filetype, inputFile, defaultGraphs,
+                              parseParallel, numDecompressionThreads);
     config.writeMaterializedViews_ =
         parseMaterializedViewsJson(materializedViewsJson);
     config.validate();
@@ -5,6 +5,7 @@
 #ifndef QLEVER_SRC_INDEX_INDEXFORMATVERSION_H
 #define QLEVER_SRC_INDEX_INDEXFORMATVERSION_H
 
+#include <array>
 #include <cstdint>
 
 #include "backports/three_way_comparison.h"
@@ -40,7 +41,19 @@ struct IndexFormatVersion {
 // The actual index version. Change it once the binary format of the index
 // changes.
 inline const IndexFormatVersion& indexFormatVersion{
-    1572, DateYearOrDuration{Date{2024, 10, 22}}};
+    2653, DateYearOrDuration{Date{2026, 10, 16}}};
+
+// Older index versions that can still be read by the current version of
+// QLever, because the changes of the index format since then were backwards
+// compatible. When the index format changes in a way that is not backwards
+// compatible, this list has to be cleared.
+//
+// 1572: Before the lightweight codecs for the columns of the permutations (see
+// `IdColumnCodecs.h`). All the columns of such indices are compressed using
+// zstd, which is encoded in the block metadata in a compatible way.
+inline const std::array<IndexFormatVersion, 1>
+    readableOlderIndexFormatVersions{
+        IndexFormatVersion{1572, DateYearOrDuration{Date{2024, 10, 22}}}};
 }  // namespace qlever
 
 #endif  // QLEVER_SRC_INDEX_INDEXFORMATVERSION_H
@@ -8,7 +8,10 @@
 #include <absl/strings/str_join.h>
 
 #include <atomic>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
 #include <cstdio>
+#include <filesystem>
 #include <future>
 #include <numeric>
 #include <optional>
@@ -22,6 +25,7 @@
 #include "index/VocabularyMerger.h"
 #include "parser/ParallelParseBuffer.h"
 #include "parser/WordsAndDocsFileParser.h"
+#include "util/Algorithm.h"
 #include "util/BatchedPipeline.h"
 #include "util/CachingMemoryResource.h"
 #include "util/CancellationHandle.h"
@@ -383,6 +387,12 @@ void IndexImpl::createFromFiles(
 
   configurationJson_["encoded-iri-prefixes"] = encodedIriManager();
 
+  // The reachability indexes of a previous build of the index don't match the
+  // new index (see `buildReachabilityIndex`).
+  if (std::filesystem::exists(getReachabilityIndexFilename())) {
+    ad_utility::deleteFile(getReachabilityIndexFilename());
+  }
+
   vocab_.resetToType(vocabularyTypeForIndexBuilding_);
 
   readIndexBuilderSettingsFromFile();
@@ -1068,6 +1078,27 @@ void IndexImpl::createFromOnDiskIndex(const std::string& onDiskBase,
       usePatterns_ = false;
     }
   }
+  // Indices that were built before the predicate statistics were introduced
+  // don't have them, the query planner then uses its default estimates.
+  if (std::filesystem::exists(getPredicateStatisticsFilename())) {
+    predicateStatistics_ =
+        PredicateStatistics::readFromFile(getPredicateStatisticsFilename());
+  }
+  // The reachability indexes are optional (see `buildReachabilityIndex`).
+  if (std::filesystem::exists(getReachabilityIndexFilename())) {
+    if (reachabilityIndexes_.readFromFile(getReachabilityIndexFilename(),
+                                          indexFingerprint_)) {
+      AD_LOG_INFO << "Loaded the reachability indexes for "
+                  << reachabilityIndexes_.numPredicates() << " predicates"
+                  << std::endl;
+    } else {
+      AD_LOG_WARN << "Ignoring the reachability indexes in "
+                  << getReachabilityIndexFilename()
+                  << ", they were built for a different build of the index "
+                     "and have to be rebuilt"
+                  << std::endl;
+    }
+  }
   if (persistUpdatesOnDisk) {
     deltaTriples_.value().setFilenameForPersistentUpdatesAndReadFromDisk(
         onDiskBase + ".update-triples");
@@ -1171,11 +1202,14 @@ void IndexImpl::setSettingsFile(const std::string& filename) {
 
 // ____________________________________________________________________________
 void IndexImpl::writeConfiguration() const {
-  // Copy the configuration and add the current commit hash.
+  // Copy the configuration and add the current commit hash and a new
+  // fingerprint (see `getIndexFingerprint`).
   auto configuration = configurationJson_;
   configuration["git-hash"] =
       *qlever::version::gitShortHashWithoutLinking.wlock();
   configuration["index-format-version"] = qlever::indexFormatVersion;
+  configuration["index-fingerprint"] =
+      boost::uuids::to_string(boost::uuids::random_generator{}());
   auto f = ad_utility::makeOfstream(onDiskBase_ + CONFIGURATION_FILE);
   f << configuration;
 }
@@ -1199,7 +1233,14 @@ void IndexImpl::readConfiguration() {
     auto indexFormatVersion = static_cast<qlever::IndexFormatVersion>(
         configurationJson_["index-format-version"]);
     const auto& currentVersion = qlever::indexFormatVersion;
-    if (indexFormatVersion != currentVersion) {
+    if (ad_utility::contains(qlever::readableOlderIndexFormatVersions,
+                             indexFormatVersion)) {
+      AD_LOG_INFO << "The index was built with an older, but compatible "
+                     "version of QLever (PR = "
+                  << indexFormatVersion.prNumber_ << ", Date = "
+                  << indexFormatVersion.date_.toStringAndType().first << ")."
+                  << std::endl;
+    } else if (indexFormatVersion != currentVersion) {
       if (indexFormatVersion.date_.toBits() > currentVersion.date_.toBits()) {
         AD_LOG_ERROR
             << "The version of QLever you are using is too old for this "
@@ -1286,6 +1327,7 @@ void IndexImpl::readConfiguration() {
   };
 
   loadDataMember("git-hash", gitShortHash_);
+  loadDataMember("index-fingerprint", indexFingerprint_, std::string{});
   loadDataMember("has-all-permutations", loadAllPermutations_, true);
   loadDataMember("num-predicates", numPredicates_);
   // These might be missing if there are only two permutations.
@@ -1712,8 +1754,31 @@ std::vector<float> IndexImpl::getMultiplicities(
   if (auto keyId = key.toValueId(*this)) {
     auto meta = permutation.getMetadata(keyId.value(), locatedTriplesState);
     if (meta.has_value()) {
-      return {meta.value().getCol1Multiplicity(),
-              meta.value().getCol2Multiplicity()};
+      std::vector<float> multiplicities{meta.value().getCol1Multiplicity(),
+                                        meta.value().getCol2Multiplicity()};
+      // The multiplicities in the metadata are exact, but don't reflect the
+      // delta triples. If the predicate was changed by an update, use the
+      // approximately maintained number of distinct objects instead.
+      const auto& delta = locatedTriplesState.predicateStatisticsDelta_;
+      const auto* deltaEntry = delta.getEntry(keyId.value());
+      bool isPredicateScan = permutation.permutation() == Permutation::PSO ||
+                             permutation.permutation() == Permutation::POS;
+      auto numDistinctObjects =
+          isPredicateScan && deltaEntry != nullptr
+              ? predicateStatistics_.estimateNumDistinctObjects(keyId.value(),
+                                                                delta)
+              : std::nullopt;
+      if (numDistinctObjects.has_value()) {
+        double numTriples = std::max(
+            static_cast<double>(meta.value().numRows_) +
+                static_cast<double>(deltaEntry->numTriples_),
+            1.0);
+        size_t objectColumn =
+            permutation.permutation() == Permutation::PSO ? 1 : 0;
+        multiplicities.at(objectColumn) = static_cast<float>(
+            std::max(numTriples / numDistinctObjects.value(), 1.0));
+      }
+      return multiplicities;
     }
   }
   return {1.0f, 1.0f};
@@ -1753,6 +1818,67 @@ std::string IndexImpl::getPatternFilename() const {
   return onDiskBase_ + ".index.patterns";
 }
 
+// _____________________________________________________________________________
+std::string IndexImpl::getPredicateStatisticsFilename() const {
+  return onDiskBase_ + ".predicate-statistics";
+}
+
+// _____________________________________________________________________________
+std::string IndexImpl::getReachabilityIndexFilename() const {
+  return onDiskBase_ + ".reachability-index";
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const ReachabilityIndex> IndexImpl::buildReachabilityIndex(
+    const std::string& predicate) {
+  if (predicate.size() < 2 || predicate.front() != '<' ||
+      predicate.back() != '>') {
+    throw std::runtime_error(absl::StrCat(
+        "The predicate of a reachability index must be an IRI in angle "
+        "brackets, but was ",
+        predicate));
+  }
+  auto predicateId =
+      TripleComponent{TripleComponent::Iri::fromIriref(predicate)}.toValueId(
+          *this);
+  if (!predicateId.has_value()) {
+    throw std::runtime_error(
+        absl::StrCat("Cannot build a reachability index for the predicate ",
+                     predicate, ", which is not contained in the index"));
+  }
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+
+  // Read all the triples of the predicate from the PSO permutation. The delta
+  // triples are ignored (using an empty `LocatedTriplesState`), the index is
+  // only used for queries if there are no delta triples.
+  const auto& permutation = getPermutation(Permutation::PSO);
+  LocatedTriplesPerBlockAllPermutations<false> emptyLocatedTriples;
+  emptyLocatedTriples.at(static_cast<size_t>(Permutation::PSO))
+      .setOriginalMetadata(permutation.metaData().blockDataShared());
+  LocatedTriplesPerBlockAllPermutations<true> emptyInternalLocatedTriples;
+  LocalVocab emptyVocab;
+  LocatedTriplesState locatedTriplesState{
+      emptyLocatedTriples, emptyInternalLocatedTriples,
+      emptyVocab.getLifetimeExtender(), 0, PredicateStatisticsDelta{}};
+  auto cancellationHandle =
+      std::make_shared<ad_utility::SharedCancellationHandle::element_type>();
+  ScanSpecification scanSpec{predicateId.value(), std::nullopt, std::nullopt};
+  IdTable triples = permutation.scan(
+      permutation.getScanSpecAndBlocks(scanSpec, locatedTriplesState), {},
+      cancellationHandle, locatedTriplesState);
+
+  auto index = std::make_shared<const ReachabilityIndex>(
+      triples.getColumn(0), triples.getColumn(1));
+  reachabilityIndexes_.add(predicateId.value(), index);
+  reachabilityIndexes_.writeToFile(getReachabilityIndexFilename(),
+                                   indexFingerprint_);
+  AD_LOG_INFO << "Built the reachability index for " << predicate << " with "
+              << index->numNodes() << " nodes, " << index->numEdges()
+              << " edges, and " << index->numIntervals() << " intervals in "
+              << timer.msecs().count() << " ms" << std::endl;
+  return index;
+}
+
 // _____________________________________________________________________________
 CPP_template_def(typename... NextSorter)(requires(
     sizeof...(NextSorter) <=
@@ -1781,10 +1907,26 @@ CPP_template_def(typename... NextSorter)(requires(
         }
         nextAvailableIndex = std::max(nextAvailableIndex, payload + 1);
       };
-  size_t numPredicates =
-      createPermutationPair(numColumns, AD_FWD(sortedTriples), *pso_, *pos_,
-                            nextSorter.makePushCallback()..., countTriples,
-                            determineNextAvailableInternalGraph);
+  // The statistics of the objects of the predicates are only needed for the
+  // normal triples, the internal triples are never filtered by value.
+  PredicateStatistics::Builder predicateStatisticsBuilder;
+  auto addToPredicateStatistics = [&predicateStatisticsBuilder,
+                                   doWriteConfiguration](const auto& triple) {
+    if (doWriteConfiguration) {
+      predicateStatisticsBuilder.addTriple(triple[1], triple[2]);
+    }
+  };
+  size_t numPredicates = createPermutationPair(
+      numColumns, AD_FWD(sortedTriples), *pso_, *pos_,
+      nextSorter.makePushCallback()..., countTriples,
+      determineNextAvailableInternalGraph, addToPredicateStatistics);
+  if (doWriteConfiguration) {
+    predicateStatistics_ = std::move(predicateStatisticsBuilder).finish();
+    predicateStatistics_.writeToFile(getPredicateStatisticsFilename());
+    AD_LOG_INFO << "Computed the value statistics for "
+                << predicateStatistics_.numPredicates() << " predicates"
+                << std::endl;
+  }
   configurationJson_["num-predicates"] =
       NumNormalAndInternal::fromNormal(numPredicates);
   configurationJson_["num-triples"] =
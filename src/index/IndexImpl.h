@@ -30,7 +30,9 @@
 #include "index/IndexBuilderTypes.h"
 #include "index/IndexMetaData.h"
 #include "index/PatternCreator.h"
+#include "index/PredicateStatistics.h"
 #include "index/Permutation.h"
+#include "index/ReachabilityIndex.h"
 #include "index/TextMetaData.h"
 #include "index/TextScoring.h"
 #include "index/Vocabulary.h"
@@ -148,6 +150,8 @@ class IndexImpl {
   NumNormalAndInternal numObjects_;
   NumNormalAndInternal numTriples_;
   std::string indexId_;
+  // See `getIndexFingerprint`.
+  std::string indexFingerprint_;
   std::string gitShortHash_ = "git short hash not set";
 
   // Keeps track of the number of nonLiteral contexts in the index this is used
@@ -162,6 +166,13 @@ class IndexImpl {
    * @brief Maps pattern ids to sets of predicate ids.
    */
   CompactVectorOfStrings<Id> patterns_;
+
+  // Statistics about the objects of the predicates for the estimates of the
+  // query planner (empty for indices that were built without them).
+  PredicateStatistics predicateStatistics_;
+  // The reachability indexes of the predicates for which they were built (see
+  // `buildReachabilityIndex`).
+  ReachabilityIndexes reachabilityIndexes_;
   ad_utility::AllocatorWithLimit<Id> allocator_;
 
   // TODO: make those private and allow only const access
@@ -303,6 +314,22 @@ class IndexImpl {
 
   CompactVectorOfStrings<Id>& getPatterns();
 
+  const PredicateStatistics& getPredicateStatistics() const {
+    return predicateStatistics_;
+  }
+
+  const ReachabilityIndexes& getReachabilityIndexes() const {
+    return reachabilityIndexes_;
+  }
+
+  // Build the `ReachabilityIndex` for the `predicate` (an IRI like
+  // `<http://www.w3.org/2000/01/rdf-schema#subClassOf>`) from the triples of
+  // the index without the delta triples, add it to the
+  // `reachabilityIndexes_` and write all of them to disk. Return the new
+  // index. Throw if the `predicate` is not contained in the vocabulary.
+  std::shared_ptr<const ReachabilityIndex> buildReachabilityIndex(
+      const std::string& predicate);
+
   /**
    * @return The multiplicity of the Entities column (0) of the full
    * has-relation relation after unrolling the patterns.
@@ -459,6 +486,13 @@ class IndexImpl {
   const std::string& getKbName() const { return PSO().getKbName(); }
   const std::string& getOnDiskBase() const { return onDiskBase_; }
   const std::string& getIndexId() const { return indexId_; }
+  // A random UUID that is stored in the configuration whenever it is written
+  // while (re)building the index, so two builds of an index never have the
+  // same fingerprint, even if they have the same name and statistics (unlike
+  // the `indexId_`). It is used to tell whether files that are derived from
+  // the index (e.g. the `DiskResultCache`) still belong to it. Empty for
+  // indices that were built before the fingerprint was introduced.
+  const std::string& getIndexFingerprint() const { return indexFingerprint_; }
   const std::string& getGitShortHash() const { return gitShortHash_; }
 
   size_t getNofTextRecords() const { return textMeta_.getNofTextRecords(); }
@@ -739,6 +773,12 @@ class IndexImpl {
   // Return the filename where the patterns are stored.
   std::string getPatternFilename() const;
 
+  // Return the filename where the `PredicateStatistics` are stored.
+  std::string getPredicateStatisticsFilename() const;
+
+  // Return the filename where the `ReachabilityIndexes` are stored.
+  std::string getReachabilityIndexFilename() const;
+
  public:
   // Count the number of "QLever-internal" triples (predicate ql:langtag or
   // predicate starts with @) and all other triples (that were actually part of
@@ -57,6 +57,10 @@ struct InputFileSpecification {
   // command line).
   bool parseInParallelSetExplicitly_ = false;
 
+  // The number of threads that decompress a zstd compressed input file (see
+  // `ParallelDecompressingFileBuffer`).
+  size_t numDecompressionThreads_ = DEFAULT_NUM_DECOMPRESSION_THREADS;
+
   // Return the filename/description for the `source_`.
   const std::string& filename() const {
     return std::visit(
@@ -71,12 +75,15 @@ struct InputFileSpecification {
   }
 
   // Create and return a `ParallelBuffer` for this spec. For filename-based
-  // specs, a `ParallelFileBuffer` with the given `blocksize` is returned. For
-  // factory-based specs, the factory is called.
+  // specs, a `ParallelFileBuffer` with the given `blocksize` is returned, or a
+  // `ParallelDecompressingFileBuffer` if the file is compressed with gzip,
+  // bzip2, or zstd (see `makeParallelFileBuffer`), which uses the
+  // `numDecompressionThreads_` for zstd. For factory-based specs,
+  // the factory is called.
   std::unique_ptr<ParallelBuffer> getParallelBuffer(size_t blocksize) const {
     if (std::holds_alternative<std::string>(source_)) {
-      return std::make_unique<ParallelFileBuffer>(
-          blocksize, std::get<std::string>(source_));
+      return makeParallelFileBuffer(blocksize, std::get<std::string>(source_),
+                                    numDecompressionThreads_);
     }
     auto& [factory, description] =
         std::get<BufferFactoryAndDescription>(source_);
@@ -18,6 +18,7 @@
 #include "index/Permutation.h"
 #include "util/ChunkedForLoop.h"
 #include "util/Log.h"
+#include "util/ParallelExecutor.h"
 #include "util/ValueIdentity.h"
 
 // ____________________________________________________________________________
@@ -25,36 +26,162 @@ std::vector<LocatedTriple> LocatedTriple::locateTriplesInPermutation(
     ql::span<const IdTriple<0>> triples,
     ql::span<const CompressedBlockMetadata> blockMetadata,
     const qlever::KeyOrder& keyOrder, bool insertOrDelete,
-    ad_utility::SharedCancellationHandle cancellationHandle) {
+    ad_utility::SharedCancellationHandle cancellationHandle,
+    size_t numThreads) {
+  auto locateChunk = [&blockMetadata, &keyOrder, &insertOrDelete,
+                      &cancellationHandle](
+                         ql::span<const IdTriple<0>> chunk) {
+    std::vector<LocatedTriple> out;
+    out.reserve(chunk.size());
+    ad_utility::chunkedForLoop<10'000>(
+        0, chunk.size(),
+        [&chunk, &out, &blockMetadata, &keyOrder, &insertOrDelete](size_t i) {
+          auto triple = chunk[i].permute(keyOrder);
+          // A triple belongs to the first block that contains at least one
+          // triple that larger than or equal to the triple. See
+          // `LocatedTriples.h` for a discussion of the corner cases.
+          size_t blockIndex =
+              ql::ranges::lower_bound(
+                  blockMetadata, triple.toPermutedTriple(),
+                  [](const auto& a, const auto& b) {
+                    // All identical triples with different graphs are
+                    // currently stored in the same block, so we don't need to
+                    // check the graph. In particular, if this triple is equal
+                    // (without graphs) to the first or last triple of a
+                    // block, then this call to `lower_bound` will correctly
+                    // identify this block.
+                    return a.tieWithoutGraph() < b.tieWithoutGraph();
+                  },
+                  &CompressedBlockMetadata::lastTriple_) -
+              blockMetadata.begin();
+          out.push_back({blockIndex, triple, insertOrDelete});
+        },
+        [&cancellationHandle]() { cancellationHandle->throwIfCancelled(); });
+    return out;
+  };
+
+  numThreads = std::clamp(triples.size() / minNumTriplesPerThread, size_t{1},
+                          numThreads);
+  if (numThreads <= 1) {
+    return locateChunk(triples);
+  }
+  const size_t chunkSize = (triples.size() + numThreads - 1) / numThreads;
+  std::vector<std::vector<LocatedTriple>> chunkResults(numThreads);
+  std::vector<std::packaged_task<void()>> tasks;
+  for (size_t i = 0; i < numThreads; ++i) {
+    auto chunk = triples.subspan(std::min(i * chunkSize, triples.size()));
+    chunk = chunk.subspan(0, std::min(chunkSize, chunk.size()));
+    tasks.emplace_back([&locateChunk, &result = chunkResults[i], chunk]() {
+      result = locateChunk(chunk);
+    });
+  }
+  ad_utility::runTasksInParallel(std::move(tasks));
+
   std::vector<LocatedTriple> out;
   out.reserve(triples.size());
-  ad_utility::chunkedForLoop<10'000>(
-      0, triples.size(),
-      [&triples, &out, &blockMetadata, &keyOrder, &insertOrDelete](size_t i) {
-        auto triple = triples[i].permute(keyOrder);
-        // A triple belongs to the first block that contains at least one triple
-        // that larger than or equal to the triple. See `LocatedTriples.h` for a
-        // discussion of the corner cases.
-        size_t blockIndex =
-            ql::ranges::lower_bound(
-                blockMetadata, triple.toPermutedTriple(),
-                [](const auto& a, const auto& b) {
-                  // All identical triples with different graphs are currently
-                  // stored in the same block, so we don't need to check the
-                  // graph. In particular, if this triple is equal (without
-                  // graphs) to the first or last triple of a block, then this
-                  // call to `lower_bound` will correctly identify this block.
-                  return a.tieWithoutGraph() < b.tieWithoutGraph();
-                },
-                &CompressedBlockMetadata::lastTriple_) -
-            blockMetadata.begin();
-        out.push_back({blockIndex, triple, insertOrDelete});
-      },
-      [&cancellationHandle]() { cancellationHandle->throwIfCancelled(); });
-
+  for (auto& chunkResult : chunkResults) {
+    ql::ranges::move(chunkResult, std::back_inserter(out));
+  }
   return out;
 }
 
+// ____________________________________________________________________________
+LocatedTriples::LocatedTriples(std::initializer_list<LocatedTriple> triples)
+    : triples_{std::make_shared<Vector>(triples)} {
+  ql::ranges::sort(*triples_, LocatedTripleCompare{});
+}
+
+// ____________________________________________________________________________
+LocatedTriples::Vector& LocatedTriples::mutableTriples() {
+  if (!triples_) {
+    triples_ = std::make_shared<Vector>();
+  } else if (triples_.use_count() > 1) {
+    // The vector is shared with another copy (typically a snapshot of the
+    // delta triples that is used by a query), which must not observe the
+    // change.
+    triples_ = std::make_shared<Vector>(*triples_);
+  }
+  return *triples_;
+}
+
+// ____________________________________________________________________________
+auto LocatedTriples::find(const LocatedTriple& locatedTriple) const
+    -> iterator {
+  auto it = ql::ranges::lower_bound(triples(), locatedTriple,
+                                    LocatedTripleCompare{});
+  if (it == end() || it->triple_ != locatedTriple.triple_) {
+    return end();
+  }
+  return it;
+}
+
+// ____________________________________________________________________________
+auto LocatedTriples::insert(const LocatedTriple& locatedTriple)
+    -> std::pair<iterator, bool> {
+  auto position = find(locatedTriple) - begin();
+  if (position != static_cast<std::ptrdiff_t>(size())) {
+    return {begin() + position, false};
+  }
+  auto& triples = mutableTriples();
+  auto it = triples.insert(ql::ranges::lower_bound(triples, locatedTriple,
+                                                   LocatedTripleCompare{}),
+                           locatedTriple);
+  return {it, true};
+}
+
+// ____________________________________________________________________________
+void LocatedTriples::insertSorted(
+    ql::span<const LocatedTriple> locatedTriples) {
+  AD_EXPENSIVE_CHECK(
+      ql::ranges::is_sorted(locatedTriples, LocatedTripleCompare{}));
+  if (locatedTriples.empty()) {
+    return;
+  }
+  auto& triples = mutableTriples();
+  auto oldSize = static_cast<std::ptrdiff_t>(triples.size());
+  // Typically, many triples are appended at the end of a block (e.g. when new
+  // subjects are inserted), so don't merge in that case.
+  bool needsMerge = !triples.empty() &&
+                    !(triples.back().triple_ < locatedTriples.front().triple_);
+  triples.insert(triples.end(), locatedTriples.begin(), locatedTriples.end());
+  if (needsMerge) {
+    std::inplace_merge(triples.begin(), triples.begin() + oldSize,
+                       triples.end(), LocatedTripleCompare{});
+  }
+  auto sameTriple = [](const LocatedTriple& a, const LocatedTriple& b) {
+    return a.triple_ == b.triple_;
+  };
+  AD_CORRECTNESS_CHECK(
+      std::adjacent_find(needsMerge ? triples.begin()
+                                    : triples.begin() + oldSize,
+                         triples.end(), sameTriple) == triples.end(),
+      "A located triple was added that was already contained");
+}
+
+// ____________________________________________________________________________
+void LocatedTriples::eraseSorted(ql::span<const LocatedTriple> locatedTriples) {
+  AD_EXPENSIVE_CHECK(
+      ql::ranges::is_sorted(locatedTriples, LocatedTripleCompare{}));
+  if (locatedTriples.empty()) {
+    return;
+  }
+  auto& triples = mutableTriples();
+  // Compact the vector in a single pass, starting from the first triple to be
+  // erased.
+  auto toErase = locatedTriples.begin();
+  auto out = ql::ranges::lower_bound(triples, *toErase, LocatedTripleCompare{});
+  for (auto in = out; in != triples.end(); ++in) {
+    if (toErase != locatedTriples.end() && in->triple_ == toErase->triple_) {
+      ++toErase;
+    } else {
+      *out++ = *in;
+    }
+  }
+  AD_CORRECTNESS_CHECK(toErase == locatedTriples.end(),
+                       "A located triple was erased that is not contained");
+  triples.erase(out, triples.end());
+}
+
 // ____________________________________________________________________________
 boost::optional<const LocatedTriples&>
 LocatedTriplesPerBlock::getUpdatesIfPresent(size_t blockIndex) const {
@@ -358,38 +485,68 @@ TriplesToVacuum LocatedTriplesPerBlock::identifyTriplesToVacuum(
           totalStats};
 }
 
-// ____________________________________________________________________________
-std::vector<LocatedTriples::iterator> LocatedTriplesPerBlock::add(
-    ql::span<const LocatedTriple> locatedTriples,
-    ad_utility::timer::TimeTracer& tracer) {
-  tracer.beginTrace("adding");
-  std::vector<LocatedTriples::iterator> handles;
-  handles.reserve(locatedTriples.size());
-  for (auto triple : locatedTriples) {
-    LocatedTriples& locatedTriplesInBlock = map_[triple.blockIndex_];
-    auto [handle, wasInserted] = locatedTriplesInBlock.emplace(triple);
-    AD_CORRECTNESS_CHECK(wasInserted == true);
-    AD_CORRECTNESS_CHECK(handle != locatedTriplesInBlock.end());
-    ++numTriples_;
-    handles.emplace_back(handle);
+namespace {
+// Sort the `locatedTriples` by block and then by triple, and call
+// `function(blockIndex, triplesOfBlock)` for each block.
+template <typename F>
+void forEachBlockSorted(ql::span<const LocatedTriple> locatedTriples,
+                        const F& function) {
+  std::vector<LocatedTriple> sorted(locatedTriples.begin(),
+                                    locatedTriples.end());
+  ql::ranges::sort(sorted, [](const LocatedTriple& a, const LocatedTriple& b) {
+    return a.blockIndex_ != b.blockIndex_ ? a.blockIndex_ < b.blockIndex_
+                                          : a.triple_ < b.triple_;
+  });
+  ql::span<const LocatedTriple> remaining{sorted};
+  while (!remaining.empty()) {
+    size_t blockIndex = remaining.front().blockIndex_;
+    auto blockEnd = ql::ranges::find_if(
+        remaining, [blockIndex](const LocatedTriple& locatedTriple) {
+          return locatedTriple.blockIndex_ != blockIndex;
+        });
+    size_t numInBlock = blockEnd - remaining.begin();
+    function(blockIndex, remaining.subspan(0, numInBlock));
+    remaining = remaining.subspan(numInBlock);
   }
+}
+}  // namespace
 
+// ____________________________________________________________________________
+void LocatedTriplesPerBlock::add(ql::span<const LocatedTriple> locatedTriples,
+                                 ad_utility::timer::TimeTracer& tracer) {
+  tracer.beginTrace("adding");
+  forEachBlockSorted(locatedTriples,
+                     [this](size_t blockIndex,
+                            ql::span<const LocatedTriple> triplesInBlock) {
+                       map_[blockIndex].insertSorted(triplesInBlock);
+                       numTriples_ += triplesInBlock.size();
+                     });
   tracer.endTrace("adding");
-  return handles;
+}
+
+// ____________________________________________________________________________
+void LocatedTriplesPerBlock::erase(
+    ql::span<const LocatedTriple> locatedTriples) {
+  forEachBlockSorted(
+      locatedTriples, [this](size_t blockIndex,
+                             ql::span<const LocatedTriple> triplesInBlock) {
+        auto blockIter = map_.find(blockIndex);
+        AD_CONTRACT_CHECK(blockIter != map_.end(), "Block ", blockIndex,
+                          " is not contained");
+        auto& block = blockIter->second;
+        block.eraseSorted(triplesInBlock);
+        numTriples_ -= triplesInBlock.size();
+        if (block.empty()) {
+          map_.erase(blockIter);
+        }
+      });
 }
 
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::erase(size_t blockIndex,
-                                   LocatedTriples::iterator iter) {
-  auto blockIter = map_.find(blockIndex);
-  AD_CONTRACT_CHECK(blockIter != map_.end(), "Block ", blockIndex,
-                    " is not contained");
-  auto& block = blockIter->second;
-  block.erase(iter);
-  numTriples_--;
-  if (block.empty()) {
-    map_.erase(blockIndex);
-  }
+                                   const IdTriple<0>& triple) {
+  std::array locatedTriples{LocatedTriple{blockIndex, triple, true}};
+  erase(locatedTriples);
 }
 
 // ____________________________________________________________________________
@@ -12,6 +12,7 @@
 #define QLEVER_SRC_INDEX_LOCATEDTRIPLES_H
 
 #include <boost/optional.hpp>
+#include <memory>
 
 #include "backports/three_way_comparison.h"
 #include "engine/idTable/IdTable.h"
@@ -84,12 +85,22 @@ struct LocatedTriple {
   // If `true`, the triple is inserted, otherwise it is deleted.
   bool insertOrDelete_;
 
-  // Locate the given triples in the given permutation.
+  // Locating fewer triples than this is not worth a separate thread, neither
+  // for a chunk of the triples (see below) nor for a whole permutation (see
+  // `DeltaTriples::locateAndAddTriples`).
+  static constexpr size_t minNumTriplesPerThread = 10'000;
+
+  // Locate the given triples in the given permutation. The triples are split
+  // into up to `numThreads` contiguous chunks of at least
+  // `minNumTriplesPerThread` triples, which are located concurrently. Fewer
+  // triples are located sequentially. The result is in the order of the
+  // `triples`.
   static std::vector<LocatedTriple> locateTriplesInPermutation(
       ql::span<const IdTriple<0>> triples,
       ql::span<const CompressedBlockMetadata> blockMetadata,
       const qlever::KeyOrder& keyOrder, bool insertOrDelete,
-      ad_utility::SharedCancellationHandle cancellationHandle);
+      ad_utility::SharedCancellationHandle cancellationHandle,
+      size_t numThreads = 1);
 
   QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(LocatedTriple, blockIndex_,
                                               triple_, insertOrDelete_)
@@ -103,8 +114,7 @@ struct LocatedTriple {
   }
 };
 
-// A sorted set of located triples. In `LocatedTriplesPerBlock` below, we use
-// this to store all located triples with the same `blockIndex_`.
+// The order of the located triples within a block.
 //
 // NOTE: We could also overload `std::less` here, but the explicit specification
 // of the order makes it clearer.
@@ -113,7 +123,77 @@ struct LocatedTripleCompare {
     return x.triple_ < y.triple_;
   }
 };
-using LocatedTriples = std::set<LocatedTriple, LocatedTripleCompare>;
+
+// A sorted set of located triples (no two of which have the same `triple_`).
+// In `LocatedTriplesPerBlock` below, we use this to store all located triples
+// with the same `blockIndex_`.
+//
+// The triples are stored in a contiguous sorted vector (which is much faster to
+// iterate in `mergeTriples` than a node-based set). Insertions and deletions
+// are done in batches, each of which costs linear time in the size of the
+// block. The vector is shared between copies of the same `LocatedTriples` and
+// only copied when a shared vector is modified (copy-on-write), so that copying
+// a `LocatedTriplesPerBlock` for a snapshot of the delta triples only copies
+// the blocks that are modified afterward.
+class LocatedTriples {
+ public:
+  using Vector = std::vector<LocatedTriple>;
+  using value_type = LocatedTriple;
+  using iterator = Vector::const_iterator;
+  using const_iterator = iterator;
+  using reverse_iterator = Vector::const_reverse_iterator;
+  using const_reverse_iterator = reverse_iterator;
+
+ private:
+  // When the vector is shared with another `LocatedTriples`, it must not be
+  // modified. `nullptr` means that there are no triples.
+  std::shared_ptr<Vector> triples_;
+
+  // Return the vector for modification, copy it first if it is shared.
+  Vector& mutableTriples();
+
+ public:
+  LocatedTriples() = default;
+  // The `triples` don't have to be sorted.
+  LocatedTriples(std::initializer_list<LocatedTriple> triples);
+
+  const Vector& triples() const {
+    static const Vector noTriples;
+    return triples_ ? *triples_ : noTriples;
+  }
+  iterator begin() const { return triples().begin(); }
+  iterator end() const { return triples().end(); }
+  reverse_iterator rbegin() const { return triples().rbegin(); }
+  reverse_iterator rend() const { return triples().rend(); }
+  size_t size() const { return triples().size(); }
+  bool empty() const { return triples().empty(); }
+
+  // Return the located triple with the same `triple_` as `locatedTriple` (the
+  // `blockIndex_` and `insertOrDelete_` are ignored), or `end()` if there is
+  // none.
+  iterator find(const LocatedTriple& locatedTriple) const;
+  bool contains(const LocatedTriple& locatedTriple) const {
+    return find(locatedTriple) != end();
+  }
+
+  // Insert a single located triple. Return the position of the triple with the
+  // same `triple_` and whether it was inserted (like `std::set::insert`).
+  std::pair<iterator, bool> insert(const LocatedTriple& locatedTriple);
+
+  // Insert the `locatedTriples`, which must be sorted by
+  // `LocatedTripleCompare`. It is an error if one of the triples is already
+  // contained.
+  void insertSorted(ql::span<const LocatedTriple> locatedTriples);
+
+  // Erase the located triples with the same `triple_` as the
+  // `locatedTriples`, which must be sorted by `LocatedTripleCompare`. It is an
+  // error if one of the triples is not contained.
+  void eraseSorted(ql::span<const LocatedTriple> locatedTriples);
+
+  friend bool operator==(const LocatedTriples& a, const LocatedTriples& b) {
+    return a.triples() == b.triples();
+  }
+};
 
 // This operator is only for debugging and testing. It returns a
 // human-readable representation.
@@ -152,9 +232,7 @@ class LocatedTriplesPerBlock {
   //
   // NOTE: This currently returns the total number of triples in the block
   // twice, in order to avoid counting the triples with `insertOrDelete_ ==
-  // true` and `insertOrDelete_ == false` separately, which turned out to
-  // be very expensive for a `std::set`, which is the underlying data
-  // structure.
+  // true` and `insertOrDelete_ == false` separately.
   //
   // TODO: Since the average number of located triples per block is usually
   // small, this estimate is usually fine. We could get better estimates in
@@ -198,23 +276,26 @@ class LocatedTriplesPerBlock {
     return map_.contains(blockIndex);
   }
 
-  // Add `locatedTriples` to the `LocatedTriplesPerBlock` and return handles to
-  // where they were added (`LocatedTriples` is a sorted set, see above). Using
-  // these handles, we can easily remove the `locatedTriples` from the set again
-  // when we need to.
+  // Add `locatedTriples` (in any order) to the `LocatedTriplesPerBlock`. The
+  // triples are grouped by block, and each block is updated only once. To
+  // remove a triple again, its `blockIndex_` and `triple_` are needed.
   //
   // PRECONDITION: The `locatedTriples` must not already exist in
   // `LocatedTriplesPerBlock`.
-  std::vector<LocatedTriples::iterator> add(
-      ql::span<const LocatedTriple> locatedTriples,
-      ad_utility::timer::TimeTracer& tracer =
-          ad_utility::timer::DEFAULT_TIME_TRACER);
+  void add(ql::span<const LocatedTriple> locatedTriples,
+           ad_utility::timer::TimeTracer& tracer =
+               ad_utility::timer::DEFAULT_TIME_TRACER);
 
-  // Removes the given `LocatedTriple` from the `LocatedTriplesPerBlock`.
+  // Remove the `locatedTriples` (in any order, identified by their
+  // `blockIndex_` and `triple_`) from the `LocatedTriplesPerBlock`. Like for
+  // `add`, each block is updated only once.
   //
   // NOTE: `updateAugmentedMetadata()` must be called to update the block
   // metadata.
-  void erase(size_t blockIndex, LocatedTriples::iterator iter);
+  void erase(ql::span<const LocatedTriple> locatedTriples);
+
+  // Remove the located `triple` from the block with the given index.
+  void erase(size_t blockIndex, const IdTriple<0>& triple);
 
   // Get the total number of `LocatedTriple`s (for all blocks).
   size_t numTriples() const { return numTriples_; }
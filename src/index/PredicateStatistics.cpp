@@ -0,0 +1,173 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/PredicateStatistics.h"
+
+#include "backports/algorithm.h"
+#include "util/Serializer/FileSerializer.h"
+
+// _____________________________________________________________________________
+auto PredicateStatistics::getEntry(Id predicate) const -> const Entry* {
+  auto it = entries_.find(predicate);
+  return it == entries_.end() ? nullptr : &it->second;
+}
+
+// _____________________________________________________________________________
+std::optional<double> PredicateStatistics::estimateFraction(
+    Id predicate, valueIdComparators::Comparison comparison, Id value) const {
+  const Entry* entry = getEntry(predicate);
+  if (entry == nullptr || entry->sample_.empty()) {
+    return std::nullopt;
+  }
+  using enum valueIdComparators::Comparison;
+  // Equality and inequality are computed via the fraction of values that are
+  // equal to the `value`.
+  auto actualComparison = comparison == NE ? EQ : comparison;
+  auto numMatching = ql::ranges::count_if(entry->sample_, [&](Id id) {
+    return valueIdComparators::compareIds(id, value, actualComparison) ==
+           valueIdComparators::ComparisonResult::True;
+  });
+  auto sampleSize = static_cast<double>(entry->sample_.size());
+  double fraction = static_cast<double>(numMatching) / sampleSize;
+  if (actualComparison == EQ) {
+    // A value that is not contained in the sample is assumed to be as frequent
+    // as the average value.
+    double numDistinct = std::max(entry->distinctObjects_.estimate(), 1.0);
+    fraction = std::max(fraction, 1.0 / numDistinct);
+    if (comparison == NE) {
+      return std::max(1.0 - fraction, 0.5 / sampleSize);
+    }
+    return fraction;
+  }
+  // A range that contains no sample value might still contain some values in
+  // between two of the sample values.
+  return std::max(fraction, 0.5 / sampleSize);
+}
+
+// _____________________________________________________________________________
+std::optional<double> PredicateStatistics::estimateNumDistinctObjects(
+    Id predicate, const PredicateStatisticsDelta& delta) const {
+  const Entry* entry = getEntry(predicate);
+  if (entry == nullptr) {
+    return std::nullopt;
+  }
+  const auto* deltaEntry = delta.getEntry(predicate);
+  if (deltaEntry == nullptr) {
+    return entry->distinctObjects_.estimate();
+  }
+  auto merged = entry->distinctObjects_;
+  merged.merge(deltaEntry->insertedObjects_);
+  return merged.estimate();
+}
+
+// _____________________________________________________________________________
+void PredicateStatistics::writeToFile(const std::string& filename) const {
+  ad_utility::serialization::FileWriteSerializer serializer{filename};
+  serializer << *this;
+}
+
+// _____________________________________________________________________________
+PredicateStatistics PredicateStatistics::readFromFile(
+    const std::string& filename) {
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  PredicateStatistics result;
+  serializer >> result;
+  return result;
+}
+
+// _____________________________________________________________________________
+PredicateStatistics::Builder::Builder(size_t minNumTriples)
+    : minNumTriples_{minNumTriples} {
+  sample_.reserve(2 * numSamplesPerPredicate);
+}
+
+// _____________________________________________________________________________
+void PredicateStatistics::Builder::addTriple(Id predicate, Id object) {
+  if (currentPredicate_ != predicate) {
+    finishCurrentPredicate();
+    currentPredicate_ = predicate;
+  }
+  distinctObjects_.add(object.getBits());
+  if (numTriples_ % stride_ == 0) {
+    sample_.push_back(object);
+    if (sample_.size() == 2 * numSamplesPerPredicate) {
+      // Keep the values at the positions that are a multiple of the new
+      // stride.
+      for (size_t i = 0; i < numSamplesPerPredicate; ++i) {
+        sample_[i] = sample_[2 * i];
+      }
+      sample_.resize(numSamplesPerPredicate);
+      stride_ *= 2;
+    }
+  }
+  ++numTriples_;
+}
+
+// _____________________________________________________________________________
+void PredicateStatistics::Builder::finishCurrentPredicate() {
+  if (currentPredicate_.has_value() && numTriples_ >= minNumTriples_) {
+    ql::ranges::sort(sample_);
+    result_.entries_.emplace(currentPredicate_.value(),
+                             Entry{numTriples_, sample_, distinctObjects_});
+  }
+  currentPredicate_.reset();
+  numTriples_ = 0;
+  stride_ = 1;
+  sample_.clear();
+  distinctObjects_ = {};
+}
+
+// _____________________________________________________________________________
+PredicateStatistics PredicateStatistics::Builder::finish() && {
+  finishCurrentPredicate();
+  return std::move(result_);
+}
+
+// _____________________________________________________________________________
+void PredicateStatisticsDelta::addTriples(ql::span<const IdTriple<0>> triples,
+                                          bool insertOrDelete) {
+  for (const auto& triple : triples) {
+    Id predicate = triple.ids()[1];
+    Id object = triple.ids()[2];
+    auto& entry = entries_[predicate];
+    if (insertOrDelete) {
+      ++entry.numTriples_;
+      entry.insertedObjects_.add(object.getBits());
+    } else {
+      --entry.numTriples_;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+auto PredicateStatisticsDelta::getEntry(Id predicate) const -> const Entry* {
+  auto it = entries_.find(predicate);
+  return it == entries_.end() ? nullptr : &it->second;
+}
+
+// _____________________________________________________________________________
+void PredicateStatisticsDelta::saveEntries(ql::span<const IdTriple<0>> triples,
+                                           SavedEntries& saved) const {
+  for (const auto& triple : triples) {
+    Id predicate = triple.ids()[1];
+    if (saved.contains(predicate)) {
+      continue;
+    }
+    const Entry* entry = getEntry(predicate);
+    saved.emplace(predicate, entry == nullptr ? std::nullopt
+                                              : std::optional<Entry>{*entry});
+  }
+}
+
+// _____________________________________________________________________________
+void PredicateStatisticsDelta::restoreEntries(const SavedEntries& saved) {
+  for (const auto& [predicate, entry] : saved) {
+    if (entry.has_value()) {
+      entries_[predicate] = entry.value();
+    } else {
+      entries_.erase(predicate);
+    }
+  }
+}
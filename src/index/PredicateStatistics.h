@@ -0,0 +1,180 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_PREDICATESTATISTICS_H
+#define QLEVER_SRC_INDEX_PREDICATESTATISTICS_H
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "backports/span.h"
+#include "backports/three_way_comparison.h"
+#include "global/Id.h"
+#include "global/IdTriple.h"
+#include "global/ValueIdComparators.h"
+#include "util/HashMap.h"
+#include "util/HyperLogLog.h"
+#include "util/Serializer/SerializeHashMap.h"
+#include "util/Serializer/SerializeVector.h"
+
+class PredicateStatisticsDelta;
+
+// Statistics about the objects of each predicate, which are computed when
+// building the index and used for estimating the selectivity of filters like
+// `FILTER(?date < "2000-01-01"^^xsd:date)` and the number of distinct values of
+// the object column in joins. For each predicate, we store
+//
+// 1. An equi-depth histogram of the objects. It is represented by a sorted
+// sample of the objects, where the sampled triples are evenly spaced within
+// the triples of the predicate. Each sample value thus stands for the same
+// number of triples. The fraction of the sample values that fulfill a
+// comparison is an estimate for the fraction of the triples that fulfill it.
+// Values with incompatible datatypes (e.g. a string and a number) never
+// fulfill a comparison, which is consistent with the semantics of `FILTER`.
+//
+// 2. A HyperLogLog sketch of the distinct objects, which (unlike the exact
+// multiplicities in the metadata of the permutations) can be approximately
+// maintained when triples are inserted (see `PredicateStatisticsDelta`).
+//
+// Only predicates with at least `minNumTriples` triples get statistics, for the
+// other predicates the default estimates are good enough.
+class PredicateStatistics {
+ public:
+  // The number of sample values per predicate is between this number and twice
+  // this number (if the predicate has enough triples).
+  static constexpr size_t numSamplesPerPredicate = 128;
+  static constexpr size_t defaultMinNumTriples = 1'000;
+
+  struct Entry {
+    uint64_t numTriples_ = 0;
+    // The sorted sample of the objects.
+    std::vector<Id> sample_;
+    ad_utility::HyperLogLog distinctObjects_;
+
+    QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(Entry, numTriples_, sample_,
+                                                distinctObjects_)
+
+    AD_SERIALIZE_FRIEND_FUNCTION(Entry) {
+      serializer | arg.numTriples_;
+      serializer | arg.sample_;
+      serializer | arg.distinctObjects_;
+    }
+  };
+
+  class Builder;
+
+ private:
+  ad_utility::HashMap<Id, Entry> entries_;
+
+ public:
+  // Return the statistics for the `predicate` or `nullptr` if there are none.
+  const Entry* getEntry(Id predicate) const;
+
+  // The number of predicates that have statistics.
+  size_t numPredicates() const { return entries_.size(); }
+
+  // Estimate the fraction of the triples with the `predicate` for which
+  // `object comparison value` holds. Return `std::nullopt` if there are no
+  // statistics for the `predicate`. The estimate is never zero, because the
+  // values that are not contained in the sample might still match a few
+  // triples.
+  std::optional<double> estimateFraction(
+      Id predicate, valueIdComparators::Comparison comparison, Id value) const;
+
+  // Estimate the number of distinct objects of the `predicate` including the
+  // changes by the `delta`. Return `std::nullopt` if there are no statistics
+  // for the `predicate`.
+  std::optional<double> estimateNumDistinctObjects(
+      Id predicate, const PredicateStatisticsDelta& delta) const;
+
+  // Write the statistics to the file with the given name, or read them from
+  // that file.
+  void writeToFile(const std::string& filename) const;
+  static PredicateStatistics readFromFile(const std::string& filename);
+
+  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(PredicateStatistics, entries_)
+
+  AD_SERIALIZE_FRIEND_FUNCTION(PredicateStatistics) {
+    serializer | arg.entries_;
+  }
+};
+
+// Compute the `PredicateStatistics` in a single pass over the triples, which
+// have to be grouped by the predicate (e.g. sorted by PSO). The sample of the
+// objects is maintained as follows: Every `stride`-th triple of the current
+// predicate is added to the sample, and when the sample has become twice as
+// large as `numSamplesPerPredicate`, every second value is removed and the
+// stride is doubled. This keeps the sample evenly spaced without knowing the
+// number of triples of the predicate in advance.
+class PredicateStatistics::Builder {
+  size_t minNumTriples_;
+  PredicateStatistics result_;
+
+  // The state for the current predicate.
+  std::optional<Id> currentPredicate_;
+  uint64_t numTriples_ = 0;
+  uint64_t stride_ = 1;
+  std::vector<Id> sample_;
+  ad_utility::HyperLogLog distinctObjects_;
+
+ public:
+  explicit Builder(size_t minNumTriples = defaultMinNumTriples);
+
+  // Add the triple with the given `predicate` and `object`. All the triples of
+  // a predicate have to be added consecutively.
+  void addTriple(Id predicate, Id object);
+
+  // Return the statistics for all the added triples.
+  PredicateStatistics finish() &&;
+
+ private:
+  // Add the statistics for the current predicate to the `result_` (if it has
+  // enough triples) and reset the state.
+  void finishCurrentPredicate();
+};
+
+// The approximate changes of the `PredicateStatistics` by the delta triples
+// (from SPARQL UPDATE requests). Inserted and deleted triples change the number
+// of triples of their predicate, and the objects of inserted triples are added
+// to a HyperLogLog sketch. Values can't be removed from a sketch, so the number
+// of distinct objects may be overestimated after deletions. The histograms are
+// not changed, i.e. we assume that updates don't change the distribution of the
+// values of a predicate much.
+class PredicateStatisticsDelta {
+ public:
+  struct Entry {
+    int64_t numTriples_ = 0;
+    ad_utility::HyperLogLog insertedObjects_;
+  };
+
+ private:
+  ad_utility::HashMap<Id, Entry> entries_;
+
+ public:
+  // Record that the `triples` were inserted (`insertOrDelete == true`) or
+  // deleted.
+  void addTriples(ql::span<const IdTriple<0>> triples, bool insertOrDelete);
+
+  // Return the changes for the `predicate` or `nullptr` if there are none.
+  const Entry* getEntry(Id predicate) const;
+
+  // The entries of some predicates (`std::nullopt` if a predicate had no
+  // entry), which can be restored later (see
+  // `DeltaTriples::rollBackOperationOfGroup`).
+  using SavedEntries = ad_utility::HashMap<Id, std::optional<Entry>>;
+
+  // Add the current entries of the predicates of the `triples` to `saved`,
+  // unless `saved` already contains an entry for the predicate.
+  void saveEntries(ql::span<const IdTriple<0>> triples,
+                   SavedEntries& saved) const;
+
+  // Reset the entries of the predicates in `saved` to the saved values.
+  void restoreEntries(const SavedEntries& saved);
+
+  void clear() { entries_.clear(); }
+};
+
+#endif  // QLEVER_SRC_INDEX_PREDICATESTATISTICS_H
@@ -0,0 +1,308 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/ReachabilityIndex.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+
+#include "backports/algorithm.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/Exception.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
+
+using qlever::graphSearch::CondensedGraph;
+using Rank = ReachabilityIndex::Rank;
+using Interval = ReachabilityIndex::Interval;
+
+namespace {
+using Component = CondensedGraph::Component;
+constexpr Rank noRank = std::numeric_limits<Rank>::max();
+}  // namespace
+
+// _____________________________________________________________________________
+ReachabilityIndex::Labeling::Labeling(
+    const CondensedGraph& graph, ql::span<const Id> nodes,
+    const CancellationCheck& checkCancellation) {
+  const size_t numComponents = graph.numComponents();
+  AD_CORRECTNESS_CHECK(graph.numNodes() == nodes.size());
+
+  // The roots of the spanning forest are the components without predecessors.
+  std::vector<char> hasPredecessor(numComponents, 0);
+  for (Component component = 0; component < numComponents; ++component) {
+    for (Component successor : graph.successorsOfComponent(component)) {
+      hasPredecessor[successor] = 1;
+    }
+  }
+  checkCancellation();
+
+  // Assign the ranks in post-order via a depth-first search (with an explicit
+  // stack, because the paths can be very long). A component that has already
+  // been visited from another component is not visited again, so the tree
+  // edges form a spanning forest, and the subtree of a component has the
+  // ranks `firstRankOfSubtree[c], ..., rankOfComponent[c]`. The roots are
+  // visited in the topological order of the DAG (see `CondensedGraph`).
+  std::vector<Rank> rankOfComponent(numComponents, noRank);
+  std::vector<Rank> firstRankOfSubtree(numComponents, noRank);
+  struct Frame {
+    Component component_;
+    size_t nextSuccessor_;
+  };
+  std::vector<Frame> stack;
+  Rank nextRank = 0;
+  auto visit = [&](Component component) {
+    firstRankOfSubtree[component] = nextRank;
+    stack.push_back(Frame{component, 0});
+  };
+  for (size_t i = numComponents; i > 0; --i) {
+    const auto root = static_cast<Component>(i - 1);
+    if (hasPredecessor[root]) {
+      continue;
+    }
+    checkCancellation();
+    visit(root);
+    while (!stack.empty()) {
+      Frame& frame = stack.back();
+      auto successors = graph.successorsOfComponent(frame.component_);
+      if (frame.nextSuccessor_ < successors.size()) {
+        // Note: `visit` invalidates the reference `frame`.
+        Component successor = successors[frame.nextSuccessor_++];
+        if (firstRankOfSubtree[successor] == noRank) {
+          visit(successor);
+        }
+        continue;
+      }
+      rankOfComponent[frame.component_] = nextRank++;
+      stack.pop_back();
+    }
+  }
+  // Each component of a DAG is reachable from one without predecessors.
+  AD_CORRECTNESS_CHECK(nextRank == numComponents);
+
+  // Compute the intervals of each component as the union of the interval of
+  // its subtree and the intervals of its successors. All the successors have a
+  // smaller index, so their intervals have already been computed.
+  std::vector<uint64_t> offsetsOfComponent{0};
+  offsetsOfComponent.reserve(numComponents + 1);
+  std::vector<Interval> intervalsOfComponents;
+  std::vector<Interval> buffer;
+  for (Component component = 0; component < numComponents; ++component) {
+    if (component % 10'000 == 0) {
+      checkCancellation();
+    }
+    buffer.clear();
+    buffer.push_back(Interval{firstRankOfSubtree[component],
+                              rankOfComponent[component]});
+    for (Component successor : graph.successorsOfComponent(component)) {
+      buffer.insert(
+          buffer.end(),
+          intervalsOfComponents.begin() + offsetsOfComponent[successor],
+          intervalsOfComponents.begin() + offsetsOfComponent[successor + 1]);
+    }
+    ql::ranges::sort(buffer);
+    // Merge the overlapping and adjacent intervals.
+    const size_t begin = intervalsOfComponents.size();
+    for (const auto& [first, last] : buffer) {
+      if (intervalsOfComponents.size() > begin &&
+          first <= intervalsOfComponents.back()[1] + 1) {
+        auto& previousLast = intervalsOfComponents.back()[1];
+        previousLast = std::max(previousLast, last);
+      } else {
+        intervalsOfComponents.push_back(Interval{first, last});
+      }
+    }
+    offsetsOfComponent.push_back(intervalsOfComponents.size());
+  }
+  checkCancellation();
+
+  // Store everything by rank instead of by component.
+  std::vector<Component> componentOfRank(numComponents);
+  for (Component component = 0; component < numComponents; ++component) {
+    componentOfRank[rankOfComponent[component]] = component;
+  }
+  rankOffsets_.reserve(numComponents + 1);
+  rankOffsets_.push_back(0);
+  nodesByRank_.reserve(nodes.size());
+  intervalOffsets_.reserve(numComponents + 1);
+  intervalOffsets_.push_back(0);
+  intervals_.reserve(intervalsOfComponents.size());
+  isCyclic_.reserve(numComponents);
+  for (Component component : componentOfRank) {
+    auto componentNodes = graph.nodesOfComponent(component);
+    nodesByRank_.insert(nodesByRank_.end(), componentNodes.begin(),
+                        componentNodes.end());
+    rankOffsets_.push_back(nodesByRank_.size());
+    intervals_.insert(
+        intervals_.end(),
+        intervalsOfComponents.begin() + offsetsOfComponent[component],
+        intervalsOfComponents.begin() + offsetsOfComponent[component + 1]);
+    intervalOffsets_.push_back(intervals_.size());
+    isCyclic_.push_back(graph.isCyclic(component));
+  }
+  rankOfNode_.reserve(nodes.size());
+  for (Id node : nodes) {
+    rankOfNode_.push_back(rankOfComponent[graph.getComponent(node).value()]);
+  }
+}
+
+// _____________________________________________________________________________
+std::vector<ql::span<const Id>> ReachabilityIndex::Labeling::getReachableNodes(
+    size_t node, size_t minDist) const {
+  AD_CONTRACT_CHECK(minDist <= 1);
+  const Rank rank = rankOfNode_.at(node);
+  // The own component is only reachable via a non-empty path if it is cyclic.
+  const bool excludeOwn = minDist == 1 && !isCyclic_[rank];
+  std::vector<ql::span<const Id>> result;
+  for (auto i = intervalOffsets_[rank]; i < intervalOffsets_[rank + 1]; ++i) {
+    const auto& [first, last] = intervals_[i];
+    if (!excludeOwn || rank < first || rank > last) {
+      result.push_back(nodesWithRanks(first, last));
+      continue;
+    }
+    if (first < rank) {
+      result.push_back(nodesWithRanks(first, rank - 1));
+    }
+    if (rank < last) {
+      result.push_back(nodesWithRanks(rank + 1, last));
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+bool ReachabilityIndex::Labeling::reaches(size_t start, size_t target,
+                                          size_t minDist) const {
+  AD_CONTRACT_CHECK(minDist <= 1);
+  const Rank startRank = rankOfNode_.at(start);
+  const Rank targetRank = rankOfNode_.at(target);
+  if (startRank == targetRank) {
+    return minDist == 0 || isCyclic_[startRank];
+  }
+  // Find the last interval that starts at or before the `targetRank`.
+  auto begin = intervals_.begin() + intervalOffsets_[startRank];
+  auto end = intervals_.begin() + intervalOffsets_[startRank + 1];
+  auto it = std::upper_bound(
+      begin, end, targetRank,
+      [](Rank rank, const Interval& interval) { return rank < interval[0]; });
+  return it != begin && targetRank <= (it - 1)->at(1);
+}
+
+// _____________________________________________________________________________
+ReachabilityIndex::ReachabilityIndex(ql::span<const Id> subjects,
+                                     ql::span<const Id> objects,
+                                     const CancellationCheck& checkCancellation)
+    : numEdges_{subjects.size()} {
+  AD_CONTRACT_CHECK(subjects.size() == objects.size());
+  nodes_.reserve(subjects.size() + objects.size());
+  nodes_.insert(nodes_.end(), subjects.begin(), subjects.end());
+  nodes_.insert(nodes_.end(), objects.begin(), objects.end());
+  ql::ranges::sort(nodes_);
+  nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+  nodes_.shrink_to_fit();
+
+  // The two directions have the same components, but different DAGs. Only
+  // one of the two graphs is kept in memory at a time.
+  auto allocator = ad_utility::makeUnlimitedAllocator<Id>();
+  forward_ = Labeling{CondensedGraph{subjects, objects, allocator,
+                                     checkCancellation},
+                      nodes_, checkCancellation};
+  backward_ = Labeling{CondensedGraph{objects, subjects, allocator,
+                                      checkCancellation},
+                       nodes_, checkCancellation};
+}
+
+// _____________________________________________________________________________
+std::optional<size_t> ReachabilityIndex::getNodeIndex(Id id) const {
+  auto it = ql::ranges::lower_bound(nodes_, id);
+  if (it == nodes_.end() || *it != id) {
+    return std::nullopt;
+  }
+  return static_cast<size_t>(it - nodes_.begin());
+}
+
+// _____________________________________________________________________________
+std::vector<ql::span<const Id>> ReachabilityIndex::getReachableNodes(
+    Id start, bool forward, size_t minDist) const {
+  auto node = getNodeIndex(start);
+  if (!node.has_value()) {
+    return {};
+  }
+  return (forward ? forward_ : backward_)
+      .getReachableNodes(node.value(), minDist);
+}
+
+// _____________________________________________________________________________
+bool ReachabilityIndex::reaches(Id start, Id target, bool forward,
+                                size_t minDist) const {
+  auto startNode = getNodeIndex(start);
+  auto targetNode = getNodeIndex(target);
+  if (!startNode.has_value() || !targetNode.has_value()) {
+    return false;
+  }
+  return (forward ? forward_ : backward_)
+      .reaches(startNode.value(), targetNode.value(), minDist);
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const ReachabilityIndex> ReachabilityIndexes::get(
+    Id predicate) const {
+  auto indexes = indexes_.rlock();
+  auto it = indexes->find(predicate);
+  return it == indexes->end() ? nullptr : it->second;
+}
+
+// _____________________________________________________________________________
+void ReachabilityIndexes::add(Id predicate,
+                              std::shared_ptr<const ReachabilityIndex> index) {
+  AD_CONTRACT_CHECK(index != nullptr);
+  indexes_.wlock()->insert_or_assign(predicate, std::move(index));
+}
+
+// _____________________________________________________________________________
+void ReachabilityIndexes::writeToFile(
+    const std::string& filename, std::string_view indexFingerprint) const {
+  // The exclusive lock prevents that two threads write the file at the same
+  // time.
+  auto indexes = indexes_.wlock();
+  auto temporaryFilename = absl::StrCat(filename, ".tmp");
+  {
+    ad_utility::serialization::FileWriteSerializer serializer{
+        temporaryFilename};
+    serializer << std::string{indexFingerprint};
+    serializer << static_cast<uint64_t>(indexes->size());
+    for (const auto& [predicate, index] : *indexes) {
+      serializer << predicate;
+      serializer << *index;
+    }
+  }
+  std::filesystem::rename(temporaryFilename, filename);
+}
+
+// _____________________________________________________________________________
+bool ReachabilityIndexes::readFromFile(const std::string& filename,
+                                       std::string_view indexFingerprint) {
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  std::string fingerprintOfFile;
+  serializer >> fingerprintOfFile;
+  if (fingerprintOfFile != indexFingerprint) {
+    return false;
+  }
+  uint64_t numIndexes = 0;
+  serializer >> numIndexes;
+  Map indexes;
+  for (uint64_t i = 0; i < numIndexes; ++i) {
+    Id predicate = Id::makeUndefined();
+    auto index = std::make_shared<ReachabilityIndex>();
+    serializer >> predicate;
+    serializer >> *index;
+    indexes.emplace(predicate, std::move(index));
+  }
+  *indexes_.wlock() = std::move(indexes);
+  return true;
+}
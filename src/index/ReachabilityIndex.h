@@ -0,0 +1,198 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_REACHABILITYINDEX_H
+#define QLEVER_SRC_INDEX_REACHABILITYINDEX_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "backports/span.h"
+#include "backports/three_way_comparison.h"
+#include "global/Id.h"
+#include "index/CondensedGraph.h"
+#include "util/HashMap.h"
+#include "util/Serializer/SerializeArrayOrTuple.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Synchronized.h"
+
+// A precomputed index that answers reachability queries for the graph that is
+// formed by the triples of a single predicate, e.g. `rdfs:subClassOf` or the
+// Wikidata predicate `P279`. It is used to evaluate transitive paths like
+// `?x wdt:P279* ?y` with a bound side without scanning the predicate and
+// searching the graph for each start node.
+//
+// The index is an interval labeling (Agrawal et al., SIGMOD 1989) of the DAG
+// of the strongly connected components of the graph (see `CondensedGraph`):
+// The components get ranks via a post-order traversal of a spanning forest of
+// the DAG, s.t. the components below a component in this forest have
+// consecutive ranks. Each component is then labeled with the (merged) rank
+// intervals of all the components that it reaches, which are the interval of
+// its own subtree plus the intervals of its successors. For graphs that are
+// close to a tree (like most class hierarchies) this is only a few intervals
+// per component. The nodes are stored sorted by the rank of their component,
+// so each interval of ranks corresponds to a contiguous range of nodes.
+//
+// There is a separate labeling for each direction of the edges, s.t. both the
+// nodes that are reachable from a node (for `<x> <p>* ?y`) and the nodes from
+// which a node is reachable (for `?x <p>* <y>`) can be looked up.
+class ReachabilityIndex {
+ public:
+  using Rank = uint32_t;
+  // The ranks `first, ..., last` as `{first, last}`.
+  using Interval = std::array<Rank, 2>;
+  using CancellationCheck = std::function<void()>;
+
+  // The labeling for one direction of the edges.
+  class Labeling {
+    // The rank of (the component of) each node of the `ReachabilityIndex`.
+    std::vector<Rank> rankOfNode_;
+    // The nodes with the rank `r` are `nodesByRank_[i]` for `i` in
+    // `rankOffsets_[r], ..., rankOffsets_[r + 1] - 1`.
+    std::vector<uint64_t> rankOffsets_;
+    std::vector<Id> nodesByRank_;
+    // The sorted and disjoint intervals of the ranks that are reachable from
+    // the rank `r` are `intervals_[i]` for `i` in `intervalOffsets_[r], ...,
+    // intervalOffsets_[r + 1] - 1`. They always contain `r` itself.
+    std::vector<uint64_t> intervalOffsets_;
+    std::vector<Interval> intervals_;
+    // True iff the component with the given rank contains a cycle.
+    std::vector<char> isCyclic_;
+
+   public:
+    Labeling() = default;
+    // Compute the labeling of the `graph`. The nodes of the `graph` have to be
+    // exactly the `nodes` (which are sorted).
+    Labeling(const qlever::graphSearch::CondensedGraph& graph,
+             ql::span<const Id> nodes,
+             const CancellationCheck& checkCancellation);
+
+    size_t numRanks() const { return isCyclic_.size(); }
+    size_t numIntervals() const { return intervals_.size(); }
+
+    // The nodes that are reachable from the node with the index `node` via a
+    // path of length at least `minDist`, which must be 0 or 1. The result is
+    // a list of disjoint ranges of nodes.
+    std::vector<ql::span<const Id>> getReachableNodes(size_t node,
+                                                      size_t minDist) const;
+
+    // Return true iff the node with the index `target` is reachable from the
+    // node with the index `start` via a path of length at least `minDist`.
+    bool reaches(size_t start, size_t target, size_t minDist) const;
+
+    QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(Labeling, rankOfNode_,
+                                                rankOffsets_, nodesByRank_,
+                                                intervalOffsets_, intervals_,
+                                                isCyclic_)
+
+    AD_SERIALIZE_FRIEND_FUNCTION(Labeling) {
+      serializer | arg.rankOfNode_;
+      serializer | arg.rankOffsets_;
+      serializer | arg.nodesByRank_;
+      serializer | arg.intervalOffsets_;
+      serializer | arg.intervals_;
+      serializer | arg.isCyclic_;
+    }
+
+   private:
+    // The nodes with the ranks `first, ..., last`.
+    ql::span<const Id> nodesWithRanks(Rank first, Rank last) const {
+      return {nodesByRank_.data() + rankOffsets_[first],
+              nodesByRank_.data() + rankOffsets_[last + 1]};
+    }
+  };
+
+ private:
+  // The `Id` of each node, sorted.
+  std::vector<Id> nodes_;
+  uint64_t numEdges_ = 0;
+  // The labeling for the edges from the subject to the object, and for the
+  // reversed edges.
+  Labeling forward_;
+  Labeling backward_;
+
+ public:
+  ReachabilityIndex() = default;
+
+  // Build the index for the graph with the edges from `subjects[i]` to
+  // `objects[i]`. The edges don't have to be sorted.
+  ReachabilityIndex(ql::span<const Id> subjects, ql::span<const Id> objects,
+                    const CancellationCheck& checkCancellation = []() {});
+
+  size_t numNodes() const { return nodes_.size(); }
+  size_t numEdges() const { return numEdges_; }
+  size_t numIntervals() const {
+    return forward_.numIntervals() + backward_.numIntervals();
+  }
+
+  // The nodes that are reachable from the `start` via a path of length at
+  // least `minDist` (0 or 1), following the edges from the subject to the
+  // object if `forward` is true, and in the opposite direction otherwise. A
+  // `start` that is not a node of the graph (i.e. neither the subject nor the
+  // object of any edge) yields an empty result, also for a `minDist` of 0.
+  std::vector<ql::span<const Id>> getReachableNodes(Id start, bool forward,
+                                                    size_t minDist) const;
+
+  // Return true iff the `target` is reachable from the `start` via a path of
+  // length at least `minDist` (0 or 1) following the edges in the given
+  // direction. As above, the nodes that are not part of the graph are never
+  // reachable.
+  bool reaches(Id start, Id target, bool forward, size_t minDist) const;
+
+  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(ReachabilityIndex, nodes_,
+                                              numEdges_, forward_, backward_)
+
+  AD_SERIALIZE_FRIEND_FUNCTION(ReachabilityIndex) {
+    serializer | arg.nodes_;
+    serializer | arg.numEdges_;
+    serializer | arg.forward_;
+    serializer | arg.backward_;
+  }
+
+ private:
+  // The index of the `id` in `nodes_`, or `std::nullopt` if it is not a node.
+  std::optional<size_t> getNodeIndex(Id id) const;
+};
+
+// The `ReachabilityIndex`es of an index, one for each predicate for which an
+// index was built. Indexes can be added while queries are running (via the
+// `build-reachability-index` command of the server), which is why they are
+// stored as `shared_ptr`s and the map is synchronized.
+class ReachabilityIndexes {
+  using Map =
+      ad_utility::HashMap<Id, std::shared_ptr<const ReachabilityIndex>>;
+  ad_utility::Synchronized<Map> indexes_;
+
+ public:
+  // Return the index for the `predicate` or `nullptr` if there is none.
+  std::shared_ptr<const ReachabilityIndex> get(Id predicate) const;
+
+  // Add the `index` for the `predicate`, replacing a previous index for the
+  // same predicate.
+  void add(Id predicate, std::shared_ptr<const ReachabilityIndex> index);
+
+  size_t numPredicates() const { return indexes_.rlock()->size(); }
+
+  // Write all the indexes to the file with the given name, together with the
+  // fingerprint of the index that they were built for (see
+  // `IndexImpl::getIndexFingerprint`). The file is first written under a
+  // temporary name and then renamed, so a crash never leaves a truncated file.
+  void writeToFile(const std::string& filename,
+                   std::string_view indexFingerprint) const;
+
+  // Replace the indexes with the ones from the file with the given name.
+  // Return false (and leave the indexes unchanged) if the file was written for
+  // an index with a different fingerprint, e.g. for a previous build.
+  bool readFromFile(const std::string& filename,
+                    std::string_view indexFingerprint);
+};
+
+#endif  // QLEVER_SRC_INDEX_REACHABILITYINDEX_H
@@ -298,6 +298,18 @@ auto Vocabulary<UnderlyingVocabulary, C, I>::operator[](IndexType idx) const
   return vocabulary_[idx.get()];
 }
 
+// _____________________________________________________________________________
+template <typename UnderlyingVocabulary, typename C, typename I>
+VocabBatchLookupResult Vocabulary<UnderlyingVocabulary, C, I>::lookupBatch(
+    ql::span<const IndexType> indices) const {
+  std::vector<uint64_t> rawIndices;
+  rawIndices.reserve(indices.size());
+  for (IndexType idx : indices) {
+    rawIndices.push_back(idx.get());
+  }
+  return vocabulary_.lookupBatch(rawIndices);
+}
+
 // Explicit template instantiations
 template class Vocabulary<detail::UnderlyingVocabRdfsVocabulary,
                           TripleComponentComparator, VocabIndex>;
@@ -119,6 +119,13 @@ class Vocabulary {
   // in the vocabulary.
   AccessReturnType operator[](IndexType idx) const;
 
+  // Get the words for all the `indices` (in the same order, duplicates are
+  // allowed). This is much faster than calling `operator[]` for each of the
+  // indices when the words have to be read from disk, because all the reads
+  // are issued as a single batch. Throw if any of the indices is not contained
+  // in the vocabulary.
+  VocabBatchLookupResult lookupBatch(ql::span<const IndexType> indices) const;
+
   //! Get the number of words in the vocabulary.
   [[nodiscard]] size_t size() const { return vocabulary_.size(); }
 
@@ -58,6 +58,28 @@ CPP_template(typename UnderlyingVocabulary,
         toStringView(underlyingVocabulary_[idx]), getDecoderIdx(idx));
   }
 
+  // Get the uncompressed words at the given `indices` (in the same order). The
+  // compressed words are retrieved from the underlying vocabulary in a single
+  // batch and then decompressed one by one.
+  VocabBatchLookupResult lookupBatch(ql::span<const uint64_t> indices) const {
+    auto compressedWords = underlyingVocabulary_.lookupBatch(indices);
+    AD_CORRECTNESS_CHECK(compressedWords->size() == indices.size());
+    auto data = std::make_shared<PmrVocabBatchLookupData>();
+    auto& resource = data->buffer();
+    resource = std::make_unique<ql::pmr::monotonic_buffer_resource>();
+    auto& views = data->views();
+    views.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      auto word = compressionWrapper_.decompress((*compressedWords)[i],
+                                                 getDecoderIdx(indices[i]));
+      auto* target =
+          static_cast<char*>(resource->allocate(word.size(), alignof(char)));
+      ql::ranges::copy(word, target);
+      views.emplace_back(target, word.size());
+    }
+    return PmrVocabBatchLookupData::asResult(std::move(data));
+  }
+
   [[nodiscard]] uint64_t size() const { return underlyingVocabulary_.size(); }
 
   // From a `comparator` that can compare two strings, make a new comparator,
@@ -70,6 +70,11 @@ class GeoVocabulary {
   // ___________________________________________________________________________
   decltype(auto) operator[](uint64_t id) const { return literals_[id]; }
 
+  // ___________________________________________________________________________
+  VocabBatchLookupResult lookupBatch(ql::span<const uint64_t> indices) const {
+    return literals_.lookupBatch(indices);
+  }
+
   // ___________________________________________________________________________
   [[nodiscard]] uint64_t size() const { return literals_.size(); }
 
@@ -33,6 +33,13 @@ std::string PolymorphicVocabulary::operator[](uint64_t i) const {
   return std::visit([i](auto& vocab) { return std::string{vocab[i]}; }, vocab_);
 }
 
+// _____________________________________________________________________________
+VocabBatchLookupResult PolymorphicVocabulary::lookupBatch(
+    ql::span<const uint64_t> indices) const {
+  return std::visit(
+      [indices](auto& vocab) { return vocab.lookupBatch(indices); }, vocab_);
+}
+
 // _____________________________________________________________________________
 auto PolymorphicVocabulary::makeDiskWriterPtr(const std::string& filename) const
     -> std::unique_ptr<WordWriterBase> {
@@ -73,6 +73,10 @@ class PolymorphicVocabulary {
   // Return the `i`-th word, throw if `i` is out of bounds.
   std::string operator[](uint64_t i) const;
 
+  // Return the words for all the `indices` (in the same order) using a single
+  // batch lookup on the underlying vocabulary.
+  VocabBatchLookupResult lookupBatch(ql::span<const uint64_t> indices) const;
+
   // Return a reference to currently underlying vocabulary, as a variant of the
   // possible types.
   Variant& getUnderlyingVocabulary() { return vocab_; }
@@ -11,6 +11,7 @@
 #include <variant>
 
 #include "backports/StartsWithAndEndsWith.h"
+#include "backports/algorithm.h"
 #include "backports/functional.h"
 #include "global/ValueId.h"
 #include "index/vocabulary/GeoVocabulary.h"
@@ -166,6 +167,41 @@ class SplitVocabulary {
         underlying_[marker]);
   }
 
+  // Retrieve the words for all the `indices` (in the same order). Each index is
+  // expected to have the marker bits set. The indices are grouped by their
+  // marker, and each underlying vocabulary is queried with a single batch.
+  VocabBatchLookupResult lookupBatch(ql::span<const uint64_t> indices) const {
+    std::array<std::vector<uint64_t>, numberOfVocabs> unmarkedIndices;
+    std::array<std::vector<size_t>, numberOfVocabs> positions;
+    for (size_t i = 0; i < indices.size(); ++i) {
+      auto marker = getMarker(indices[i]);
+      unmarkedIndices[marker].push_back(getVocabIndex(indices[i]));
+      positions[marker].push_back(i);
+    }
+
+    auto data = std::make_shared<CompositeVocabBatchLookupData>();
+    auto& views = data->views();
+    views.resize(indices.size());
+    for (uint8_t marker = 0; marker < numberOfVocabs; ++marker) {
+      if (unmarkedIndices[marker].empty()) {
+        continue;
+      }
+      auto subResult = std::visit(
+          [&](auto& vocab) {
+            AD_CORRECTNESS_CHECK(ql::ranges::all_of(
+                unmarkedIndices[marker],
+                [&vocab](uint64_t idx) { return idx < vocab.size(); }));
+            return vocab.lookupBatch(unmarkedIndices[marker]);
+          },
+          underlying_[marker]);
+      for (size_t i = 0; i < positions[marker].size(); ++i) {
+        views[positions[marker][i]] = (*subResult)[i];
+      }
+      data->buffer().push_back(std::move(subResult));
+    }
+    return CompositeVocabBatchLookupData::asResult(std::move(data));
+  }
+
   // The size of a SplitVocabulary is the sum of the sizes of the underlying
   // vocabularies.
   [[nodiscard]] uint64_t size() const {
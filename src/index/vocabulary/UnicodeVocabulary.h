@@ -31,6 +31,11 @@ class UnicodeVocabulary {
 
   auto operator[](uint64_t id) const { return _underlyingVocabulary[id]; }
 
+  // Batch version of `operator[]`, see the underlying vocabulary for details.
+  VocabBatchLookupResult lookupBatch(ql::span<const uint64_t> indices) const {
+    return _underlyingVocabulary.lookupBatch(indices);
+  }
+
   [[nodiscard]] uint64_t size() const { return _underlyingVocabulary.size(); }
 
   /// Return a `WordAndIndex` that points to the first entry that is equal or
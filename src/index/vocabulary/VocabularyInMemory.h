@@ -54,6 +54,18 @@ class VocabularyInMemory
   /// Return the `i-th` word. The behavior is undefined if `i >= size()`
   auto operator[](uint64_t i) const { return _words[i]; }
 
+  // Return the words for all the `indices` (in the same order). The result
+  // points directly into this vocabulary, which thus must outlive it.
+  VocabBatchLookupResult lookupBatch(ql::span<const uint64_t> indices) const {
+    auto data = std::make_shared<CompositeVocabBatchLookupData>();
+    auto& views = data->views();
+    views.reserve(indices.size());
+    for (uint64_t idx : indices) {
+      views.push_back(_words[idx]);
+    }
+    return CompositeVocabBatchLookupData::asResult(std::move(data));
+  }
+
   // Conversion function that is used by the Mixin base class.
   template <typename It>
   WordAndIndex iteratorToWordAndIndex(It it) const {
@@ -13,6 +13,34 @@ std::string VocabularyInternalExternal::operator[](uint64_t i) const {
   return externalVocab_[i];
 }
 
+// _____________________________________________________________________________
+VocabBatchLookupResult VocabularyInternalExternal::lookupBatch(
+    ql::span<const uint64_t> indices) const {
+  auto data = std::make_shared<CompositeVocabBatchLookupData>();
+  auto& views = data->views();
+  views.resize(indices.size());
+  std::vector<uint64_t> externalIndices;
+  std::vector<size_t> externalPositions;
+  for (size_t i = 0; i < indices.size(); ++i) {
+    auto fromInternal = internalVocab_[indices[i]];
+    if (fromInternal.has_value()) {
+      views[i] = fromInternal.value();
+    } else {
+      externalIndices.push_back(indices[i]);
+      externalPositions.push_back(i);
+    }
+  }
+  if (!externalIndices.empty()) {
+    auto externalWords = externalVocab_.lookupBatch(externalIndices);
+    for (size_t i = 0; i < externalPositions.size(); ++i) {
+      views[externalPositions[i]] = (*externalWords)[i];
+    }
+    // Keep the words that were read from disk alive.
+    data->buffer().push_back(std::move(externalWords));
+  }
+  return CompositeVocabBatchLookupData::asResult(std::move(data));
+}
+
 // _____________________________________________________________________________
 VocabularyInternalExternal::WordWriter::WordWriter(const std::string& filename,
                                                    size_t milestoneDistance)
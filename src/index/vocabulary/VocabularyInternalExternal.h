@@ -49,6 +49,11 @@ class VocabularyInternalExternal {
   /// Return the `i-th` word. The behavior is undefined if `i >= size()`
   std::string operator[](uint64_t i) const;
 
+  // Return the words for all the `indices` (in the same order). The words that
+  // are cached in RAM are taken from the internal vocabulary, all others are
+  // read from disk in a single batch, see `VocabularyOnDisk::lookupBatch`.
+  VocabBatchLookupResult lookupBatch(ql::span<const uint64_t> indices) const;
+
   /// Return a `WordAndIndex` that points to the first entry that is equal or
   /// greater than `word` wrt. to the `comparator`. Only works correctly if the
   /// `words_` are sorted according to the comparator (exactly like in
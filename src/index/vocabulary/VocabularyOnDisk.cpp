@@ -4,8 +4,12 @@
 
 #include "index/vocabulary/VocabularyOnDisk.h"
 
+#include <algorithm>
 #include <array>
+#include <numeric>
 
+#include "util/IoUringManager.h"
+#include "util/Metrics.h"
 #include "util/MmapVector.h"
 #include "util/StringUtils.h"
 
@@ -21,6 +25,8 @@ OffsetAndSize VocabularyOnDisk::getOffsetAndSize(uint64_t i) const {
   static_assert(sizeof(offsets) == sizeof(Offset) * 2);
   offsetsFile_.read(offsets.data(), sizeof(offsets),
                     static_cast<off_t>(i * sizeof(Offset)));
+  ad_utility::metrics::globalMetrics().bytesReadFromVocabulary_.add(
+      sizeof(offsets));
   return {offsets[0], offsets[1] - offsets[0]};
 }
 
@@ -31,9 +37,87 @@ std::string VocabularyOnDisk::operator[](uint64_t idx) const {
   std::string result(offsetAndSize.size_, '\0');
   file_.read(result.data(), offsetAndSize.size_,
              static_cast<off_t>(offsetAndSize.offset_));
+  ad_utility::metrics::globalMetrics().bytesReadFromVocabulary_.add(
+      offsetAndSize.size_);
   return result;
 }
 
+// _____________________________________________________________________________
+VocabBatchLookupResult VocabularyOnDisk::lookupBatch(
+    ql::span<const uint64_t> indices) const {
+  // Sort and deduplicate the indices, s.t. each word is read only once and the
+  // reads are issued in the order in which the words are stored in the file.
+  std::vector<uint64_t> uniqueIndices(indices.begin(), indices.end());
+  ql::ranges::sort(uniqueIndices);
+  uniqueIndices.erase(std::unique(uniqueIndices.begin(), uniqueIndices.end()),
+                      uniqueIndices.end());
+  if (uniqueIndices.empty()) {
+    return VocabBatchLookupData::asResult(
+        std::make_shared<VocabBatchLookupData>());
+  }
+  AD_CONTRACT_CHECK(uniqueIndices.back() < size());
+  const size_t numWords = uniqueIndices.size();
+
+  ad_utility::BatchIoManagerWithFallback ioManager{
+      static_cast<unsigned>(std::clamp<size_t>(numWords, 1, 256))};
+  std::vector<size_t> numBytes;
+  std::vector<uint64_t> fileOffsets;
+  std::vector<char*> buffers;
+  auto readBatch = [&](const ad_utility::File& file) {
+    ioManager.wait(ioManager.addBatch(file.fd(), numBytes, fileOffsets,
+                                      buffers));
+    ad_utility::metrics::globalMetrics().bytesReadFromVocabulary_.add(
+        std::accumulate(numBytes.begin(), numBytes.end(), size_t{0}));
+    numBytes.clear();
+    fileOffsets.clear();
+    buffers.clear();
+  };
+
+  // First read the offset of each word and the offset of the next word (which
+  // marks the end of the word), see `getOffsetAndSize`. We need those before
+  // we can read the words themselves, so the lookup consists of two batches.
+  std::vector<std::array<Offset, 2>> offsets(numWords);
+  static_assert(sizeof(std::array<Offset, 2>) == sizeof(Offset) * 2);
+  for (size_t i = 0; i < numWords; ++i) {
+    numBytes.push_back(sizeof(std::array<Offset, 2>));
+    fileOffsets.push_back(uniqueIndices[i] * sizeof(Offset));
+    buffers.push_back(reinterpret_cast<char*>(offsets[i].data()));
+  }
+  readBatch(offsetsFile_);
+
+  // Then read all the words into a single contiguous buffer.
+  auto data = std::make_shared<VocabBatchLookupData>();
+  auto& buffer = data->buffer();
+  size_t totalSize = 0;
+  for (const auto& [begin, end] : offsets) {
+    totalSize += end - begin;
+  }
+  buffer.resize(totalSize);
+  std::vector<std::string_view> uniqueWords;
+  uniqueWords.reserve(numWords);
+  char* target = buffer.data();
+  for (const auto& [begin, end] : offsets) {
+    size_t wordSize = end - begin;
+    uniqueWords.emplace_back(target, wordSize);
+    if (wordSize > 0) {
+      numBytes.push_back(wordSize);
+      fileOffsets.push_back(begin);
+      buffers.push_back(target);
+    }
+    target += wordSize;
+  }
+  readBatch(file_);
+
+  // Restore the original order (and the duplicates) of the `indices`.
+  auto& views = data->views();
+  views.reserve(indices.size());
+  for (uint64_t idx : indices) {
+    auto it = ql::ranges::lower_bound(uniqueIndices, idx);
+    views.push_back(uniqueWords[it - uniqueIndices.begin()]);
+  }
+  return VocabBatchLookupData::asResult(std::move(data));
+}
+
 // _____________________________________________________________________________
 VocabularyOnDisk::WordWriter::WordWriter(const std::string& outFilename)
     : file_{outFilename, "w"},
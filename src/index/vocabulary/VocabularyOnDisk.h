@@ -73,6 +73,13 @@ class VocabularyOnDisk : public VocabularyBinarySearchMixin<VocabularyOnDisk> {
   // size`.
   std::string operator[](uint64_t idx) const;
 
+  // Return the words for all the `indices` (in the same order, duplicates are
+  // allowed). The indices are sorted and deduplicated, and all the reads are
+  // submitted as a single batch (via io_uring if available), which is much
+  // faster than calling `operator[]` for each index separately. Throw an
+  // exception if any of the indices is `>= size()`.
+  VocabBatchLookupResult lookupBatch(ql::span<const uint64_t> indices) const;
+
   // Get the number of words in the vocabulary.
   size_t size() const { return size_; }
 
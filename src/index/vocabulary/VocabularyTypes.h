@@ -104,6 +104,14 @@ struct VocabBatchLookupData : VocabLookupDataCommonBase<std::vector<char>> {};
 using BufferType = std::unique_ptr<ql::pmr::monotonic_buffer_resource>;
 struct PmrVocabBatchLookupData : VocabLookupDataCommonBase<BufferType> {};
 
+// A vocabulary batch-lookup result that doesn't own any string data itself.
+// Its `views()` point into the results of other batch lookups (e.g. of the
+// underlying vocabularies of a `SplitVocabulary`), which are kept alive by
+// `buffer()`, or directly into the memory of an in-memory vocabulary, which
+// must then outlive the result.
+struct CompositeVocabBatchLookupData
+    : VocabLookupDataCommonBase<std::vector<VocabBatchLookupResult>> {};
+
 // A word and its index in the vocabulary from which it was obtained. Also
 // contains a special state `end()` which can be queried by the `isEnd()`
 // function. This can be used to represent words that are larger than the
@@ -12,6 +12,7 @@
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/MaterializedViews.h"
 #include "engine/QueryExecutionContext.h"
+#include "global/RuntimeParameters.h"
 #include "index/IndexImpl.h"
 #include "index/TextIndexBuilder.h"
 #include "libqlever/QleverTypes.h"
@@ -43,6 +44,11 @@ Qlever::Qlever(const EngineConfig& config)
       [this](ad_utility::MemorySize newValue) {
         cache_.setMaxSizeSingleEntry(newValue);
       });
+  globalRuntimeParameters.wlock()
+      ->queryPlanCacheMaxNumEntries_.setOnUpdateAction(
+          [this](size_t newValue) {
+            queryPlanCache_.setMaxNumEntries(newValue);
+          });
 
   // Grab the freshly constructed `Index` and `MaterializedViewsManager` once.
   // No other thread can observe them yet, so reading the snapshot here is safe.
@@ -61,6 +67,17 @@ Qlever::Qlever(const EngineConfig& config)
 
   materializedViewsManager.setOnDiskBase(config.baseName_);
 
+  // Load the results of the disk tier of the cache from previous runs.
+  if (!config.diskCacheDirectory_.empty()) {
+    diskResultCache_ = std::make_unique<DiskResultCache>(
+        config.diskCacheDirectory_,
+        getRuntimeParameter<&RuntimeParameters::diskCacheMaxSize_>());
+    globalRuntimeParameters.wlock()->diskCacheMaxSize_.setOnUpdateAction(
+        [this](ad_utility::MemorySize newValue) {
+          diskResultCache_->setMaxSize(newValue);
+        });
+  }
+
   // Estimate the cost of sorting operations (needed for query planning).
   sortPerformanceEstimator_.computeEstimatesExpensively(
       allocator_, index.numTriples().normalAndInternal_() *
@@ -146,6 +163,17 @@ void Qlever::buildIndex(IndexBuilderConfig config) {
     }
     AD_LOG_INFO << "All materialized views written successfully" << std::endl;
   }
+
+  // Build reachability indexes if requested.
+  if (!config.reachabilityIndexPredicates_.empty()) {
+    std::cout << std::endl;
+    AD_LOG_INFO << "Loading the new index to build the reachability indexes ..."
+                << std::endl;
+    Qlever engine{EngineConfig{config}};
+    for (const auto& predicate : config.reachabilityIndexPredicates_) {
+      engine.buildReachabilityIndex(predicate);
+    }
+  }
 }
 
 // ___________________________________________________________________________
@@ -207,14 +235,26 @@ void Qlever::eraseResultWithName(std::string name) {
 
 // ___________________________________________________________________________
 Qlever::QueryPlan Qlever::parseAndPlanQuery(std::string query) const {
+  auto indexAndViews = indexAndViewsSnapshot();
   auto qecPtr = createQueryExecutionContext(
-      indexAndViewsSnapshot(),
+      indexAndViews,
       [](const std::
              string&) { /* No runtime updates for this interface yet. */ },
       false, false, disableCaching_);
   // TODO<joka921> support Dataset clauses.
-  auto parsedQuery = SparqlParser::parseQuery(
-      &qecPtr->getIndex().getImpl().encodedIriManager(), std::move(query), {});
+  const auto& encodedIriManager =
+      qecPtr->getIndex().getImpl().encodedIriManager();
+  auto parsedQuery =
+      SparqlParser::parseQuery(&encodedIriManager, std::move(query), {});
+  if (auto prepared =
+          queryPlanCache_.getPreparedQuery(parsedQuery, &encodedIriManager)) {
+    auto queryPlan = bindPreparedQuery(
+        *prepared->preparedQuery_, std::move(prepared->values_),
+        std::move(indexAndViews), std::move(qecPtr));
+    std::get<ParsedQuery>(queryPlan)._originalString =
+        std::move(parsedQuery._originalString);
+    return queryPlan;
+  }
   auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
   QueryPlanner qp{qecPtr.get(), handle};
   qp.setEnablePatternTrick(enablePatternTrick_);
@@ -225,6 +265,59 @@ Qlever::QueryPlan Qlever::parseAndPlanQuery(std::string query) const {
   return {qetPtr, std::move(qecPtr), std::move(parsedQuery)};
 }
 
+// ___________________________________________________________________________
+std::shared_ptr<PreparedQuery> Qlever::prepare(
+    std::string query, const std::vector<std::string>& parameters) const {
+  auto indexAndViews = indexAndViewsSnapshot();
+  auto parsedQuery = SparqlParser::parseQuery(
+      &indexAndViews->index_.encodedIriManager(), std::move(query), {});
+  return std::make_shared<PreparedQuery>(
+      std::move(parsedQuery), PreparedQuery::parseParameterNames(parameters));
+}
+
+// ___________________________________________________________________________
+Qlever::QueryPlan Qlever::planPreparedQuery(
+    PreparedQuery& preparedQuery,
+    const PreparedQuery::ParameterValues& values) const {
+  auto indexAndViews = indexAndViewsSnapshot();
+  auto qecPtr = createQueryExecutionContext(
+      indexAndViews,
+      [](const std::
+             string&) { /* No runtime updates for this interface yet. */ },
+      false, false, disableCaching_);
+  return bindPreparedQuery(preparedQuery, preparedQuery.parseValues(values),
+                           std::move(indexAndViews), std::move(qecPtr));
+}
+
+// ___________________________________________________________________________
+Qlever::QueryPlan Qlever::bindPreparedQuery(
+    PreparedQuery& preparedQuery, std::vector<TripleComponent> values,
+    std::shared_ptr<IndexAndViews> indexAndViews,
+    std::shared_ptr<QueryExecutionContext> qecPtr) const {
+  auto createContext = [this, &indexAndViews]() {
+    return createQueryExecutionContext(
+        indexAndViews, [](const std::string&) {}, false, false,
+        disableCaching_);
+  };
+  auto planQuery = [this](ParsedQuery& parsedQuery,
+                          QueryExecutionContext& qec) {
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    QueryPlanner qp{&qec, handle};
+    qp.setEnablePatternTrick(enablePatternTrick_);
+    return qp.createExecutionTree(parsedQuery);
+  };
+  auto [qet, parsedQuery] =
+      preparedQuery.bind(std::move(values), *qecPtr, createContext, planQuery);
+  return {std::move(qet), std::move(qecPtr), std::move(parsedQuery)};
+}
+
+// ___________________________________________________________________________
+std::string Qlever::execute(PreparedQuery& preparedQuery,
+                            const PreparedQuery::ParameterValues& values,
+                            ad_utility::MediaType mediaType) const {
+  return query(planPreparedQuery(preparedQuery, values), mediaType);
+}
+
 // ___________________________________________________________________________
 void IndexBuilderConfig::validate() const {
   if (kScoringParam_ < 0) {
@@ -243,6 +336,15 @@ void IndexBuilderConfig::validate() const {
         "text index. If none are given the option to add words from literals "
         "has to be true. For details see --help."));
   }
+  for (const auto& predicate : reachabilityIndexPredicates_) {
+    if (predicate.size() < 2 || predicate.front() != '<' ||
+        predicate.back() != '>') {
+      throw std::invalid_argument(absl::StrCat(
+          "The predicates for reachability indexes must be IRIs in angle "
+          "brackets, but got ",
+          predicate));
+    }
+  }
 }
 
 // ___________________________________________________________________________
@@ -261,16 +363,38 @@ void Qlever::loadMaterializedView(std::string name) const {
   materializedViewsManager()->loadView(name);
 }
 
+// ___________________________________________________________________________
+void Qlever::buildReachabilityIndex(const std::string& predicate) const {
+  indexAndViewsSnapshot()->index_.getImpl().buildReachabilityIndex(predicate);
+}
+
 // ___________________________________________________________________________
 std::shared_ptr<QueryExecutionContext> Qlever::createQueryExecutionContext(
     std::shared_ptr<IndexAndViews> indexAndViews,
     std::function<void(std::string)> updateCallback, bool pinSubtrees,
     bool pinResult,
-    QueryExecutionContext::DisableCaching disableCaching) const {
+    QueryExecutionContext::DisableCaching disableCaching,
+    std::optional<ad_utility::MemorySize> memoryLimit) const {
   auto [index, viewsManager] = getPointerPair(std::move(indexAndViews));
-  return std::make_shared<QueryExecutionContext>(
-      std::move(index), &cache_, allocator_, sortPerformanceEstimator_,
-      &namedResultCache_, std::move(viewsManager), std::move(updateCallback),
-      pinSubtrees, pinResult, disableCaching);
+  auto limit = memoryLimit.value_or(
+      getRuntimeParameter<&RuntimeParameters::queryMemoryLimit_>());
+  auto allocator = allocator_.makeChildAllocator(
+      limit == ad_utility::MemorySize::bytes(0)
+          ? ad_utility::MemorySize::max()
+          : limit);
+  auto removeLimit = [budget = allocator.getMemoryLeft().ptr()](
+                         QueryExecutionContext* qec) {
+    delete qec;
+    budget->removeLimit();
+  };
+  std::shared_ptr<QueryExecutionContext> qec{
+      new QueryExecutionContext{std::move(index), &cache_, std::move(allocator),
+                                sortPerformanceEstimator_, &namedResultCache_,
+                                std::move(viewsManager),
+                                std::move(updateCallback), pinSubtrees,
+                                pinResult, disableCaching},
+      std::move(removeLimit)};
+  qec->setDiskResultCache(diskResultCache_.get());
+  return qec;
 }
 }  // namespace qlever
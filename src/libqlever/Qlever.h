@@ -13,10 +13,13 @@
 #include <utility>
 #include <vector>
 
+#include "engine/DiskResultCache.h"
 #include "engine/MaterializedViews.h"
 #include "engine/NamedResultCache.h"
 #include "engine/NamedResultCacheSerializer.h"
+#include "engine/PreparedQuery.h"
 #include "engine/QueryExecutionContext.h"
+#include "engine/QueryPlanCache.h"
 #include "engine/QueryPlanner.h"
 #include "global/RuntimeParameters.h"
 #include "index/Index.h"
@@ -148,6 +151,10 @@ struct IndexBuilderConfig : CommonConfig {
       std::vector<std::pair<std::string, std::string>>;
   WriteMaterializedViews writeMaterializedViews_;
 
+  // Predicates (full IRIs in angle brackets) for which a `ReachabilityIndex`
+  // is built after the normal index build is complete.
+  std::vector<std::string> reachabilityIndexPredicates_;
+
   // Assert that the given configuration is valid.
   void validate() const;
 
@@ -192,6 +199,11 @@ struct EngineConfig : CommonConfig {
   QueryExecutionContext::DisableCaching disableCaching_ =
       QueryExecutionContext::DisableCaching::FromRuntimeParameter;
 
+  // If non-empty, the directory of the disk tier of the cache for query
+  // results (see `DiskResultCache.h`). The results in this directory survive
+  // restarts of the engine. If empty (the default), there is no disk tier.
+  std::string diskCacheDirectory_;
+
   // Names of materialized views to load from disk during initialization.
   // If a view doesn't exist, a warning is logged and startup continues.
   std::vector<std::string> preloadMaterializedViews_ = {};
@@ -242,6 +254,12 @@ class Qlever {
   ad_utility::Synchronized<std::shared_ptr<IndexAndViews>> indexAndViews_;
   bool enablePatternTrick_;
   QueryExecutionContext::DisableCaching disableCaching_;
+  // The size is set via the runtime parameter
+  // `query-plan-cache-max-num-entries` in the constructor.
+  mutable QueryPlanCache queryPlanCache_{0};
+  // The disk tier of the result cache, `nullptr` if there is none (see
+  // `EngineConfig::diskCacheDirectory_`).
+  std::unique_ptr<DiskResultCache> diskResultCache_;
 
  public:
   // Build an index, using an `IndexBuilderConfig` as explained above.
@@ -286,6 +304,27 @@ class Qlever {
                     ad_utility::MediaType mediaType =
                         ad_utility::MediaType::sparqlJson) const;
 
+  // Parse the given `query` with the given `parameters` (variables of the
+  // query, with or without the leading `?`), which are bound to values only
+  // when the query is executed. The query is planned only once (per version of
+  // the index and the updates), and not for each execution. See
+  // `PreparedQuery.h` for the details.
+  std::shared_ptr<PreparedQuery> prepare(
+      std::string query, const std::vector<std::string>& parameters) const;
+
+  // Create the plan for executing the `preparedQuery` with the given `values`
+  // of its parameters (see `PreparedQuery::ParameterValues`).
+  QueryPlan planPreparedQuery(
+      PreparedQuery& preparedQuery,
+      const PreparedQuery::ParameterValues& values) const;
+
+  // Execute the `preparedQuery` with the given `values` of its parameters. This
+  // is equivalent to calling `planPreparedQuery` followed by `query`.
+  std::string execute(PreparedQuery& preparedQuery,
+                      const PreparedQuery::ParameterValues& values,
+                      ad_utility::MediaType mediaType =
+                          ad_utility::MediaType::sparqlJson) const;
+
   // Plan, parse, and execute the given `query` and pin the result to the cache
   // with the given options (name and possibly request for building a geometry
   // index). This result can then be reused in a query as follows: `SERVICE
@@ -312,6 +351,10 @@ class Qlever {
   // Check if a materialized view with the given name is currently loaded.
   bool isMaterializedViewLoaded(const std::string& name) const;
 
+  // Build the `ReachabilityIndex` for the `predicate` (a full IRI in angle
+  // brackets) and write it to disk.
+  void buildReachabilityIndex(const std::string& predicate) const;
+
   // Write the contents of the `NamedResultCache` to disk.
   template <typename Serializer>
   void writeNamedResultCacheToSerializer(Serializer& serializer) const {
@@ -326,16 +369,29 @@ class Qlever {
                                          indexAndViews->index_);
   }
 
+  // Create the plan for executing the `preparedQuery` with the given `values`
+  // as part of the query with the context `qecPtr`. New plans use a context
+  // for the same `indexAndViews`.
+  QueryPlan bindPreparedQuery(
+      PreparedQuery& preparedQuery, std::vector<TripleComponent> values,
+      std::shared_ptr<IndexAndViews> indexAndViews,
+      std::shared_ptr<QueryExecutionContext> qecPtr) const;
+
   // Create a Query Execution Context needed for execution of single SPARQL
   // query. Use an explicitly snapshotted `IndexAndViews` to make sure we have a
-  // consistent state.
+  // consistent state. The context has its own memory budget, which is a child
+  // of the budget for all queries and limited to `memoryLimit` (default: the
+  // `query-memory-limit` runtime parameter, where zero means unlimited). The
+  // limit is lifted when the context is destroyed, because results of the
+  // query can outlive it (e.g. in the cache).
   std::shared_ptr<QueryExecutionContext> createQueryExecutionContext(
       std::shared_ptr<IndexAndViews> indexAndViews,
       std::function<void(std::string)> updateCallback =
           [](std::string) { /* the default is a noop*/ },
       bool pinSubtrees = false, bool pinResult = false,
       QueryExecutionContext::DisableCaching disableCaching =
-          QueryExecutionContext::DisableCaching::FromRuntimeParameter) const;
+          QueryExecutionContext::DisableCaching::FromRuntimeParameter,
+      std::optional<ad_utility::MemorySize> memoryLimit = std::nullopt) const;
 
   // Atomically snapshot both the `Index` and the `MaterializedViewsManager`
   // under a single read lock, so that all code paths handling a single request
@@ -367,6 +423,11 @@ class Qlever {
     return sortPerformanceEstimator_;
   }
 
+  QueryPlanCache& queryPlanCache() const { return queryPlanCache_; }
+
+  // The disk tier of the result cache, `nullptr` if there is none.
+  DiskResultCache* diskResultCache() const { return diskResultCache_.get(); }
+
   NamedResultCache& namedResultCache() { return namedResultCache_; }
   const NamedResultCache& namedResultCache() const { return namedResultCache_; }
 
@@ -38,6 +38,12 @@ struct ExternalValuesQuery : MagicServiceQuery {
   std::string name_;
   std::vector<Variable> variables_;
 
+  // If true, the values of the resulting `ExternalValues` operation are part
+  // of its cache key, so the operation can also be used with caching enabled.
+  // This cannot be set via SPARQL, it is only used by `PreparedQuery`, which
+  // refreshes all cache keys after each change of the values.
+  bool valuesInCacheKey_ = false;
+
   explicit ExternalValuesQuery(const TripleComponent::Iri& serviceIri)
       : name_(extractName(serviceIri.toStringRepresentation())) {}
 
@@ -9,7 +9,27 @@
 
 #include "parser/ParallelBuffer.h"
 
+#include <zstd.h>
+#include <zstd_errors.h>
+
+#include <array>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+
+#include "backports/StartsWithAndEndsWith.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/StringUtils.h"
+#include "util/TaskQueue.h"
+
+// For some include orders the EOF constant is not defined although `<cstdio>`
+// was included (see `CompressorStream.h`).
+#ifndef EOF
+#define EOF std::char_traits<char>::eof()
+#endif
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 
 // _________________________________________________________________________
 ParallelFileBuffer::ParallelFileBuffer(size_t blocksize,
@@ -47,6 +67,385 @@ std::optional<ParallelBuffer::BufferType> ParallelFileBuffer::getNextBlock() {
   return ret;
 }
 
+// _____________________________________________________________________________
+CompressionFormat getCompressionFormatFromSuffix(std::string_view filename) {
+  if (ql::ends_with(filename, ".gz")) {
+    return CompressionFormat::Gzip;
+  } else if (ql::ends_with(filename, ".bz2")) {
+    return CompressionFormat::Bzip2;
+  } else if (ql::ends_with(filename, ".zst")) {
+    return CompressionFormat::Zstd;
+  }
+  return CompressionFormat::None;
+}
+
+// _____________________________________________________________________________
+CompressionFormat detectCompressionFormat(const std::string& filename) {
+  auto format = getCompressionFormatFromSuffix(filename);
+  std::error_code ec;
+  if (format != CompressionFormat::None ||
+      !std::filesystem::is_regular_file(filename, ec)) {
+    return format;
+  }
+  std::array<unsigned char, 4> magic{};
+  {
+    auto file = ad_utility::makeIfstream(filename, std::ios::binary);
+    file.read(reinterpret_cast<char*>(magic.data()), magic.size());
+    if (file.gcount() < static_cast<std::streamsize>(magic.size())) {
+      return CompressionFormat::None;
+    }
+  }
+  if (magic[0] == 0x1f && magic[1] == 0x8b) {
+    return CompressionFormat::Gzip;
+  } else if (magic[0] == 'B' && magic[1] == 'Z' && magic[2] == 'h') {
+    return CompressionFormat::Bzip2;
+  } else if (magic == std::array<unsigned char, 4>{0x28, 0xb5, 0x2f, 0xfd}) {
+    return CompressionFormat::Zstd;
+  }
+  return CompressionFormat::None;
+}
+
+namespace detail {
+using BufferType = ParallelBuffer::BufferType;
+
+// The decompression of a single file, which returns the decompressed bytes
+// block by block. The calls to `decompressNextBlock` are made from one thread
+// at a time.
+class Decompressor {
+ public:
+  virtual ~Decompressor() = default;
+  // Return the next (approximately) `blocksize` decompressed bytes, or an
+  // empty block at the end of the file.
+  virtual BufferType decompressNextBlock() = 0;
+};
+
+namespace {
+namespace io = boost::iostreams;
+
+// Decompress a gzip or bzip2 file as a single stream via `boost::iostreams`.
+// Both filters also handle files that consist of several concatenated members.
+class StreamDecompressor : public Decompressor {
+  size_t blocksize_;
+  std::string filename_;
+  std::ifstream file_;
+  io::filtering_istream stream_;
+
+ public:
+  StreamDecompressor(size_t blocksize, const std::string& filename,
+                     CompressionFormat format)
+      : blocksize_{blocksize},
+        filename_{filename},
+        file_{ad_utility::makeIfstream(filename, std::ios::binary)} {
+    if (format == CompressionFormat::Gzip) {
+      stream_.push(io::gzip_decompressor{});
+    } else {
+      AD_CONTRACT_CHECK(format == CompressionFormat::Bzip2);
+      stream_.push(io::bzip2_decompressor{});
+    }
+    stream_.push(file_);
+  }
+
+  BufferType decompressNextBlock() override {
+    BufferType result;
+    result.resize(blocksize_);
+    stream_.read(result.data(), static_cast<std::streamsize>(blocksize_));
+    // The filters report corrupt or truncated input by throwing, which the
+    // stream turns into the `badbit`.
+    if (stream_.bad()) {
+      throw std::runtime_error{absl::StrCat(
+          "Error while decompressing the input file \"", filename_,
+          "\", which is corrupt or truncated")};
+    }
+    result.resize(static_cast<size_t>(stream_.gcount()));
+    return result;
+  }
+};
+
+// Decompress a zstd file. Consecutive frames with at most `blocksize`
+// decompressed bytes each (e.g. those written by `pzstd` or in the seekable
+// zstd format) are combined into groups of at most `blocksize` decompressed
+// bytes, and up to `numThreads` of these groups are decompressed in parallel
+// by a fixed pool of worker threads. A frame with more than `blocksize`
+// decompressed bytes, or whose header doesn't store this size (like the single
+// frame that plain `zstd` writes), is decompressed as a stream. The
+// decompressed bytes are returned in blocks of at least `blocksize` bytes
+// (except for the last block), so that a block also contains a statement end
+// if the frames are much smaller than a statement.
+class ZstdDecompressor : public Decompressor {
+  // A group of consecutive complete frames that are decompressed together.
+  struct FrameGroup {
+    BufferType frames_;
+    std::vector<size_t> frameSizes_;
+    size_t contentSize_ = 0;
+  };
+
+  size_t blocksize_;
+  size_t numThreads_;
+  ad_utility::File file_;
+  bool fileExhausted_ = false;
+  // The compressed bytes that have been read from the file, of which the
+  // first `inputPos_` have already been consumed.
+  BufferType input_;
+  size_t inputPos_ = 0;
+  // The groups of frames that are currently being decompressed, in the order
+  // of the file.
+  std::deque<std::future<BufferType>> groups_;
+  // The context for the streaming decompression of a single large frame.
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> stream_{
+      ZSTD_createDCtx(), ZSTD_freeDCtx};
+  // True iff the frame at `inputPos_` has to be decompressed as a stream once
+  // all the `groups_` have been consumed.
+  bool largeFrameIsNext_ = false;
+  // True iff the streaming decompression of a large frame has started, but
+  // not yet finished.
+  bool isStreaming_ = false;
+  // The worker threads for the decompression of the `groups_`. The tasks own
+  // all the data that they access.
+  ad_utility::TaskQueue<false> workers_;
+
+ public:
+  ZstdDecompressor(size_t blocksize, const std::string& filename,
+                   size_t numThreads)
+      : blocksize_{blocksize},
+        numThreads_{std::max(numThreads, size_t{1})},
+        file_{filename, "r"},
+        workers_{numThreads_, numThreads_, "zstd decompression"} {
+    AD_CORRECTNESS_CHECK(stream_ != nullptr);
+  }
+
+  BufferType decompressNextBlock() override {
+    BufferType block;
+    while (block.size() < blocksize_) {
+      auto piece = decompressNextPiece(blocksize_ - block.size());
+      if (!piece.has_value()) {
+        break;
+      }
+      if (block.empty()) {
+        block = std::move(piece.value());
+      } else {
+        block.insert(block.end(), piece->begin(), piece->end());
+      }
+    }
+    return block;
+  }
+
+ private:
+  // Return the next decompressed bytes in the order of the file, which are
+  // either a complete group of frames or at most `maxSize` bytes of a large
+  // frame. The result may be empty (e.g. for the seek table of the seekable
+  // format, which is a skippable frame). Return `nullopt` at the end of the
+  // file.
+  std::optional<BufferType> decompressNextPiece(size_t maxSize) {
+    scheduleGroups();
+    if (!groups_.empty()) {
+      auto piece = groups_.front().get();
+      groups_.pop_front();
+      scheduleGroups();
+      return piece;
+    }
+    if (largeFrameIsNext_) {
+      largeFrameIsNext_ = false;
+      isStreaming_ = true;
+      ZSTD_DCtx_reset(stream_.get(), ZSTD_reset_session_only);
+    }
+    if (isStreaming_) {
+      return decompressStreamPiece(maxSize);
+    }
+    return std::nullopt;
+  }
+
+  // Read up to `blocksize_` more compressed bytes from the file, and return
+  // the number of bytes read.
+  size_t readInput() {
+    input_.erase(input_.begin(), input_.begin() + inputPos_);
+    inputPos_ = 0;
+    if (fileExhausted_) {
+      return 0;
+    }
+    size_t oldSize = input_.size();
+    input_.resize(oldSize + blocksize_);
+    size_t numBytesRead = file_.read(input_.data() + oldSize, blocksize_);
+    input_.resize(oldSize + numBytesRead);
+    fileExhausted_ = numBytesRead == 0;
+    return numBytesRead;
+  }
+
+  // Start the decompression of groups of frames until `numThreads_` groups
+  // are being decompressed, the file is exhausted, or the next frame has to
+  // be decompressed as a stream.
+  void scheduleGroups() {
+    while (groups_.size() < numThreads_ && !largeFrameIsNext_ &&
+           !isStreaming_) {
+      auto group = collectFrameGroup();
+      if (group.frameSizes_.empty()) {
+        return;
+      }
+      std::packaged_task<BufferType()> task{
+          [group = std::move(group)]() { return decompressFrameGroup(group); }};
+      groups_.push_back(task.get_future());
+      workers_.push([task = std::move(task)]() mutable { task(); });
+    }
+  }
+
+  // Consume complete frames from the input as long as their total
+  // decompressed size doesn't exceed `blocksize_`. Set `largeFrameIsNext_` if
+  // a frame is found that has to be decompressed as a stream.
+  FrameGroup collectFrameGroup() {
+    FrameGroup group;
+    while (true) {
+      const char* begin = input_.data() + inputPos_;
+      size_t numBytes = input_.size() - inputPos_;
+      if (numBytes == 0 && fileExhausted_) {
+        return group;
+      }
+      if (numBytes > 0) {
+        size_t frameSize = ZSTD_findFrameCompressedSize(begin, numBytes);
+        if (!ZSTD_isError(frameSize)) {
+          // Note: This is 0 for skippable frames.
+          auto contentSize = ZSTD_getFrameContentSize(begin, frameSize);
+          if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN ||
+              contentSize == ZSTD_CONTENTSIZE_ERROR ||
+              contentSize > blocksize_) {
+            largeFrameIsNext_ = true;
+            return group;
+          }
+          if (group.contentSize_ + contentSize > blocksize_) {
+            return group;
+          }
+          group.frames_.insert(group.frames_.end(), begin, begin + frameSize);
+          group.frameSizes_.push_back(frameSize);
+          group.contentSize_ += contentSize;
+          inputPos_ += frameSize;
+          continue;
+        }
+        // Any other error than an incomplete frame means that the input is
+        // corrupt.
+        if (ZSTD_getErrorCode(frameSize) != ZSTD_error_srcSize_wrong) {
+          throwError(frameSize);
+        }
+      }
+      if (numBytes >= blocksize_) {
+        largeFrameIsNext_ = true;
+        return group;
+      }
+      if (readInput() == 0 && numBytes > 0) {
+        throw std::runtime_error{
+            "The zstd compressed input ends with an incomplete frame"};
+      }
+    }
+  }
+
+  // Decompress the frames of a group, the sizes of which are stored in their
+  // headers.
+  static BufferType decompressFrameGroup(const FrameGroup& group) {
+    BufferType result;
+    result.resize(group.contentSize_);
+    size_t inputPos = 0;
+    size_t outputPos = 0;
+    for (size_t frameSize : group.frameSizes_) {
+      outputPos += ZstdWrapper::decompressToBuffer(
+          group.frames_.data() + inputPos, frameSize,
+          result.data() + outputPos, result.size() - outputPos);
+      inputPos += frameSize;
+    }
+    AD_CORRECTNESS_CHECK(outputPos == result.size());
+    return result;
+  }
+
+  // Decompress up to `maxSize` bytes of the large frame at `inputPos_`, and
+  // reset `isStreaming_` when the end of this frame is reached.
+  BufferType decompressStreamPiece(size_t maxSize) {
+    BufferType result;
+    result.resize(maxSize);
+    ZSTD_outBuffer out{result.data(), result.size(), 0};
+    while (out.pos < out.size) {
+      if (inputPos_ == input_.size()) {
+        readInput();
+      }
+      ZSTD_inBuffer in{input_.data() + inputPos_, input_.size() - inputPos_,
+                       0};
+      size_t oldOutPos = out.pos;
+      size_t ret = ZSTD_decompressStream(stream_.get(), &out, &in);
+      if (ZSTD_isError(ret)) {
+        throwError(ret);
+      }
+      inputPos_ += in.pos;
+      if (ret == 0) {
+        isStreaming_ = false;
+        break;
+      }
+      if (in.pos == 0 && out.pos == oldOutPos) {
+        // No more input and no more buffered output.
+        throw std::runtime_error{
+            "The zstd compressed input ends with an incomplete frame"};
+      }
+    }
+    result.resize(out.pos);
+    return result;
+  }
+
+  [[noreturn]] static void throwError(size_t errorCode) {
+    throw std::runtime_error{absl::StrCat(
+        "Error while decompressing zstd compressed input: ",
+        ZSTD_getErrorName(errorCode))};
+  }
+};
+}  // namespace
+}  // namespace detail
+
+// _____________________________________________________________________________
+ParallelDecompressingFileBuffer::ParallelDecompressingFileBuffer(
+    size_t blocksize, const std::string& filename, CompressionFormat format,
+    size_t numThreads)
+    : ParallelBuffer{blocksize} {
+  AD_CONTRACT_CHECK(format != CompressionFormat::None);
+  if (format == CompressionFormat::Zstd) {
+    decompressor_ = std::make_unique<detail::ZstdDecompressor>(
+        blocksize, filename, numThreads);
+  } else {
+    decompressor_ = std::make_unique<detail::StreamDecompressor>(
+        blocksize, filename, format);
+  }
+  fut_ = std::async(std::launch::async, [this]() {
+    return decompressor_->decompressNextBlock();
+  });
+}
+
+// _____________________________________________________________________________
+// Note: The `fut_` is destroyed (which waits for the asynchronous task) before
+// the `decompressor_` that is accessed by this task.
+ParallelDecompressingFileBuffer::~ParallelDecompressingFileBuffer() = default;
+
+// _____________________________________________________________________________
+std::optional<ParallelBuffer::BufferType>
+ParallelDecompressingFileBuffer::getNextBlock() {
+  if (eof_) {
+    return std::nullopt;
+  }
+  AD_CORRECTNESS_CHECK(fut_.valid());
+  auto block = fut_.get();
+  if (block.empty()) {
+    eof_ = true;
+    return std::nullopt;
+  }
+  fut_ = std::async(std::launch::async, [this]() {
+    return decompressor_->decompressNextBlock();
+  });
+  return block;
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<ParallelBuffer> makeParallelFileBuffer(
+    size_t blocksize, const std::string& filename,
+    size_t numDecompressionThreads) {
+  auto format = detectCompressionFormat(filename);
+  if (format == CompressionFormat::None) {
+    return std::make_unique<ParallelFileBuffer>(blocksize, filename);
+  }
+  return std::make_unique<ParallelDecompressingFileBuffer>(
+      blocksize, filename, format, numDecompressionThreads);
+}
+
 // ____________________________________________________________________________
 std::optional<size_t> ParallelBufferWithEndRegex::findRegexNearEnd(
     const BufferType& vec, const re2::RE2& regex) {
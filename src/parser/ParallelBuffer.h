@@ -13,10 +13,13 @@
 #include <re2/re2.h>
 
 #include <future>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "index/ConstantsIndexBuilding.h"
 #include "util/File.h"
 #include "util/UninitializedAllocator.h"
 
@@ -78,6 +81,64 @@ class ParallelFileBuffer : public ParallelBuffer {
   std::future<size_t> fut_;
 };
 
+// The compression formats of input files that are decompressed on the fly.
+enum class CompressionFormat { None, Gzip, Bzip2, Zstd };
+
+// Return the compression format that is indicated by the suffix of the
+// `filename` (`.gz`, `.bz2`, or `.zst`), or `CompressionFormat::None` if the
+// filename has none of these suffixes.
+CompressionFormat getCompressionFormatFromSuffix(std::string_view filename);
+
+// Determine the compression format of the file with the given name from its
+// suffix, or (if it has no known suffix) from the magic bytes at its
+// beginning. The latter is only done for regular files, because reading the
+// first bytes of a pipe (e.g. `/dev/stdin`) would consume them.
+CompressionFormat detectCompressionFormat(const std::string& filename);
+
+namespace detail {
+class Decompressor;
+}
+
+// A `ParallelBuffer` that reads a gzip, bzip2, or zstd compressed file and
+// returns the decompressed bytes in blocks of (approximately) `blocksize`
+// bytes. Like in the `ParallelFileBuffer`, the next block is read and
+// decompressed asynchronously while the current block is being processed.
+//
+// A zstd file that consists of many independent frames (e.g. one written by
+// `pzstd` or in the seekable zstd format) is decompressed by `numThreads`
+// worker threads in parallel, where consecutive small frames are combined to
+// blocks of about `blocksize` bytes. Frames that decompress to more than
+// `blocksize` bytes (like the single frame that plain `zstd` writes) are
+// decompressed as a stream. Gzip and bzip2 files (also with several
+// concatenated members, e.g. from `bgzip` or `pbzip2`) are always decompressed
+// as a stream, because the boundaries of their members are only known after
+// decompressing them.
+class ParallelDecompressingFileBuffer : public ParallelBuffer {
+ public:
+  ParallelDecompressingFileBuffer(size_t blocksize,
+                                  const std::string& filename,
+                                  CompressionFormat format,
+                                  size_t numThreads =
+                                      DEFAULT_NUM_DECOMPRESSION_THREADS);
+  ~ParallelDecompressingFileBuffer() override;
+
+  // _____________________________________________________
+  std::optional<BufferType> getNextBlock() override;
+
+ private:
+  std::unique_ptr<detail::Decompressor> decompressor_;
+  bool eof_ = false;
+  std::future<BufferType> fut_;
+};
+
+// Return a `ParallelFileBuffer` for the file with the given name, or a
+// `ParallelDecompressingFileBuffer` if the file is compressed (see
+// `detectCompressionFormat`). The `numDecompressionThreads` are only used for
+// zstd compressed files.
+std::unique_ptr<ParallelBuffer> makeParallelFileBuffer(
+    size_t blocksize, const std::string& filename,
+    size_t numDecompressionThreads = DEFAULT_NUM_DECOMPRESSION_THREADS);
+
 // A parallel buffer that reads input in blocks, where each block, except
 // possibly the last, ends with `endRegex`. It wraps any `ParallelBuffer` as
 // the underlying byte source.
@@ -53,10 +53,15 @@ void PathQuery::addParameter(const SparqlTriple& triple) {
 
     if (objString == "allPaths") {
       algorithm_ = PathSearchAlgorithm::ALL_PATHS;
+    } else if (objString == "shortestPath") {
+      algorithm_ = PathSearchAlgorithm::SHORTEST_PATH;
+    } else if (objString == "kShortestPaths") {
+      algorithm_ = PathSearchAlgorithm::K_SHORTEST_PATHS;
     } else {
-      throw PathSearchException(
-          absl::StrCat("Unsupported algorithm in pathSearch: ", objString,
-                       ". Supported Algorithms: <allPaths>."));
+      throw PathSearchException(absl::StrCat(
+          "Unsupported algorithm in pathSearch: ", objString,
+          ". Supported Algorithms: <allPaths>, <shortestPath>, "
+          "<kShortestPaths>."));
     }
   } else {
     throw PathSearchException(absl::StrCat(
@@ -104,6 +109,11 @@ PathSearchConfiguration PathQuery::toPathSearchConfiguration(
     throw PathSearchException("Missing parameter <pathColumn> in path search.");
   } else if (!edgeColumn_.has_value()) {
     throw PathSearchException("Missing parameter <edgeColumn> in path search.");
+  } else if (algorithm_ == PathSearchAlgorithm::K_SHORTEST_PATHS &&
+             !numPathsPerTarget_.has_value()) {
+    throw PathSearchException(
+        "The algorithm <kShortestPaths> requires the parameter "
+        "<numPathsPerTarget>.");
   }
 
   return PathSearchConfiguration{
@@ -8,7 +8,10 @@
 
 #include <absl/strings/str_cat.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <optional>
 
 #include "backports/functional.h"
 #include "util/MemorySize/MemorySize.h"
@@ -19,14 +22,20 @@ namespace ad_utility {
 namespace detail {
 
 // This exception is supposed to be thrown when an allocation is requested that
-// exceeds the limit of the allocator.
+// exceeds the limit of the allocator. If the `limit` of a child budget (see
+// `AllocationMemoryLeft`) was reached, it is part of the message.
 class AllocationExceedsLimitException : public std::exception {
  public:
-  AllocationExceedsLimitException(MemorySize requestedMemory,
-                                  MemorySize freeMemory)
-      : _message{absl::StrCat("Tried to allocate ", requestedMemory.asString(),
-                              ", but only ", freeMemory.asString(),
-                              " were available")} {};
+  AllocationExceedsLimitException(
+      MemorySize requestedMemory, MemorySize freeMemory,
+      std::optional<MemorySize> limit = std::nullopt)
+      : _message{absl::StrCat(
+            "Tried to allocate ", requestedMemory.asString(), ", but only ",
+            freeMemory.asString(), " were available",
+            limit.has_value()
+                ? absl::StrCat(" (the limit of the memory budget is ",
+                               limit->asString(), ")")
+                : "")} {};
 
   const char* what() const noexcept override { return _message.c_str(); }
 
@@ -37,45 +46,198 @@ class AllocationExceedsLimitException : public std::exception {
 // Class to keep track of the amount of memory that is left for allocation. When
 // not enough memory is left, an AllocationExceedsLimitException is thrown. Note
 // that need a separate class for this because there can be many Allocation
-// objects at the same time (hence the wrapper class and the synchronization
-// below).
+// objects at the same time (hence the wrapper class below). All the counters
+// are atomic, so allocating and deallocating never takes a lock.
+//
+// Budgets can be nested, for example one budget for all queries with one child
+// budget per query: A child budget has its own limit, and the memory that is
+// allocated via the child also counts towards the limit of its parent. To keep
+// the (shared and therefore contended) parent off the hot path, a child
+// reserves memory from its parent in chunks of `reservationChunkSize`, from
+// which subsequent small allocations are served. A child keeps at most one
+// chunk of unused reserved memory, the rest is returned to the parent on
+// deallocation.
 class AllocationMemoryLeft {
-  // Remaining free memory.
-  MemorySize free_;
+ public:
+  static constexpr MemorySize reservationChunkSize = MemorySize::kilobytes(256);
+
+ private:
+  // The limit of this budget and the remaining free memory (in bytes).
+  std::atomic<size_t> limit_;
+  std::atomic<size_t> free_;
+  // The maximal amount of memory that was in use at the same time.
+  std::atomic<size_t> peakUsage_ = 0;
+  // For a child budget: the parent, and the memory that was reserved from the
+  // parent, but is not yet used by this budget.
+  std::shared_ptr<AllocationMemoryLeft> parent_;
+  std::atomic<size_t> reserved_ = 0;
+  // The size of the reservation that is kept after deallocating. It is zero
+  // once the limit was removed (see `removeLimit`).
+  std::atomic<size_t> maxReserved_ = reservationChunkSize.getBytes();
 
  public:
-  AllocationMemoryLeft(MemorySize n) : free_(n) {}
+  explicit AllocationMemoryLeft(
+      MemorySize n, std::shared_ptr<AllocationMemoryLeft> parent = nullptr)
+      : limit_{n.getBytes()}, free_{n.getBytes()}, parent_{std::move(parent)} {}
+
+  // Return the memory that is still reserved to the parent.
+  ~AllocationMemoryLeft() {
+    if (parent_ != nullptr) {
+      parent_->increase(MemorySize::bytes(reserved_.load()));
+    }
+  }
+
+  AllocationMemoryLeft(const AllocationMemoryLeft&) = delete;
+  AllocationMemoryLeft& operator=(const AllocationMemoryLeft&) = delete;
 
   // Called before memory is allocated.
   bool decrease_if_enough_left_or_return_false(MemorySize n) noexcept {
-    if (n <= free_) {
-      free_ -= n;
-      return true;
-    } else {
+    const size_t numBytes = n.getBytes();
+    if (!tryDecrease(free_, numBytes)) {
+      return false;
+    }
+    if (parent_ != nullptr && !reserveFromParent(numBytes)) {
+      free_.fetch_add(numBytes);
       return false;
     }
+    updatePeakUsage();
+    return true;
   }
 
   // Called before memory is allocated.
   void decrease_if_enough_left_or_throw(MemorySize n) {
     if (!decrease_if_enough_left_or_return_false(n)) {
-      throw AllocationExceedsLimitException{n, free_};
+      throw AllocationExceedsLimitException{
+          n, amountMemoryLeft(),
+          isOwnLimitOfChildReached(n) ? std::optional{limit()}
+                                      : std::nullopt};
     }
   }
 
   // Called after memory is deallocated.
-  void increase(MemorySize n) { free_ += n; }
-  [[nodiscard]] MemorySize amountMemoryLeft() const { return free_; }
+  void increase(MemorySize n) {
+    free_.fetch_add(n.getBytes());
+    if (parent_ != nullptr) {
+      returnToParent(n.getBytes());
+    }
+  }
+
+  // The memory that can still be allocated, which for a child budget is also
+  // bounded by the memory that is left in its ancestors.
+  [[nodiscard]] MemorySize amountMemoryLeft() const {
+    size_t left = free_.load();
+    if (parent_ != nullptr) {
+      // Note: The sum is saturated, because the parent might be unlimited.
+      size_t leftInParent = parent_->amountMemoryLeft().getBytes();
+      size_t reserved = reserved_.load();
+      size_t max = MemorySize::max().getBytes();
+      size_t available =
+          leftInParent > max - reserved ? max : leftInParent + reserved;
+      left = std::min(left, available);
+    }
+    return MemorySize::bytes(left);
+  }
+
+  // The memory that is currently allocated via this budget.
+  [[nodiscard]] MemorySize amountMemoryUsed() const {
+    // Note: The limit is read first, because `removeLimit` first increases the
+    // free memory and then the limit. That way, the new limit is never combined
+    // with the old free memory, which would be a huge usage. While the limit is
+    // removed, the usage is at most temporarily too small.
+    size_t limit = limit_.load();
+    return MemorySize::bytes(limit - std::min(limit, free_.load()));
+  }
+
+  [[nodiscard]] MemorySize peakMemoryUsage() const {
+    return MemorySize::bytes(peakUsage_.load());
+  }
+  [[nodiscard]] MemorySize limit() const {
+    return MemorySize::bytes(limit_.load());
+  }
+
+  // Return true iff this is a child budget and allocating `n` fails because of
+  // its own limit (and not because of the limit of one of its ancestors). In
+  // this case, freeing memory elsewhere (e.g. by shrinking a cache) doesn't
+  // help.
+  [[nodiscard]] bool isOwnLimitOfChildReached(MemorySize n) const {
+    return parent_ != nullptr && free_.load() < n.getBytes();
+  }
+
+  // Remove the limit of this budget, such that only the limits of its
+  // ancestors apply from now on. The memory that is allocated via this budget
+  // is still counted. The memory that is reserved from the parent is returned,
+  // and from now on no memory is reserved (a budget without a limit typically
+  // only holds the results that outlive a query).
+  void removeLimit() {
+    size_t oldLimit = limit_.load();
+    free_.fetch_add(MemorySize::max().getBytes() - oldLimit);
+    limit_.store(MemorySize::max().getBytes());
+    if (parent_ != nullptr) {
+      maxReserved_.store(0);
+      parent_->increase(MemorySize::bytes(reserved_.exchange(0)));
+    }
+  }
+
+ private:
+  // Subtract `n` from `value` if `value >= n`, return true iff this was the
+  // case.
+  static bool tryDecrease(std::atomic<size_t>& value, size_t n) noexcept {
+    size_t current = value.load(std::memory_order_relaxed);
+    do {
+      if (current < n) {
+        return false;
+      }
+    } while (!value.compare_exchange_weak(current, current - n));
+    return true;
+  }
+
+  // Take `numBytes` from the reservation. If the reservation is too small,
+  // take them directly from the parent, together with a new chunk for the
+  // reservation if the parent has enough memory left for it.
+  bool reserveFromParent(size_t numBytes) noexcept {
+    if (tryDecrease(reserved_, numBytes)) {
+      return true;
+    }
+    const size_t chunk = maxReserved_.load();
+    if (chunk > 0 && numBytes <= MemorySize::max().getBytes() - chunk &&
+        parent_->decrease_if_enough_left_or_return_false(
+            MemorySize::bytes(numBytes + chunk))) {
+      reserved_.fetch_add(chunk);
+      return true;
+    }
+    return parent_->decrease_if_enough_left_or_return_false(
+        MemorySize::bytes(numBytes));
+  }
+
+  // Add the deallocated `numBytes` to the reservation, and return everything
+  // but one chunk of the reservation to the parent.
+  void returnToParent(size_t numBytes) {
+    const size_t chunk = maxReserved_.load();
+    size_t current = reserved_.fetch_add(numBytes) + numBytes;
+    while (current > chunk) {
+      if (reserved_.compare_exchange_weak(current, chunk)) {
+        parent_->increase(MemorySize::bytes(current - chunk));
+        return;
+      }
+    }
+  }
+
+  // Update `peakUsage_` with the current usage.
+  void updatePeakUsage() noexcept {
+    size_t used = amountMemoryUsed().getBytes();
+    size_t peak = peakUsage_.load(std::memory_order_relaxed);
+    while (used > peak && !peakUsage_.compare_exchange_weak(peak, used)) {
+    }
+  }
 };
 
 // Threadsafe Wrapper around `AllocationMemoryLeft`.
 // Copies of objects of this class will refer to the same `AllocationMemoryLeft`
-// object. Concurrent access is handled via `ad_utility::Synchronized`.
+// object.
 class AllocationMemoryLeftThreadsafe {
  public:
   AllocationMemoryLeftThreadsafe() = delete;
-  using T =
-      std::shared_ptr<ad_utility::Synchronized<AllocationMemoryLeft, SpinLock>>;
+  using T = std::shared_ptr<AllocationMemoryLeft>;
   explicit AllocationMemoryLeftThreadsafe(T ptr) : ptr_{std::move(ptr)} {}
   T& ptr() { return ptr_; }
   const T& ptr() const { return ptr_; }
@@ -94,8 +256,17 @@ class AllocationMemoryLeftThreadsafe {
 // Limited Allocator class.
 inline detail::AllocationMemoryLeftThreadsafe
 makeAllocationMemoryLeftThreadsafeObject(MemorySize n) {
-  return detail::AllocationMemoryLeftThreadsafe{std::make_shared<
-      ad_utility::Synchronized<detail::AllocationMemoryLeft, SpinLock>>(n)};
+  return detail::AllocationMemoryLeftThreadsafe{
+      std::make_shared<detail::AllocationMemoryLeft>(n)};
+}
+
+// Set up a shared allocation state with limit `n` that is a child of the
+// `parent` (see `AllocationMemoryLeft` for details).
+inline detail::AllocationMemoryLeftThreadsafe
+makeAllocationMemoryLeftThreadsafeObject(
+    MemorySize n, const detail::AllocationMemoryLeftThreadsafe& parent) {
+  return detail::AllocationMemoryLeftThreadsafe{
+      std::make_shared<detail::AllocationMemoryLeft>(n, parent.ptr())};
 }
 
 /*
@@ -220,13 +391,13 @@ class AllocatorWithLimit {
     // Subtract the amount of memory we want to allocate from the amount of
     // memory left. This will throw an exception if not enough memory is left.
     const auto bytesNeeded = MemorySize::bytes(n * sizeof(T));
-    const bool wasEnoughLeft =
-        memoryLeft_.ptr()->wlock()->decrease_if_enough_left_or_return_false(
-            bytesNeeded);
-    if (!wasEnoughLeft) {
-      AD_CORRECTNESS_CHECK(clearOnAllocation_);
-      clearOnAllocation_(bytesNeeded);
-      memoryLeft_.ptr()->wlock()->decrease_if_enough_left_or_throw(bytesNeeded);
+    auto& memoryLeft = *memoryLeft_.ptr();
+    if (!memoryLeft.decrease_if_enough_left_or_return_false(bytesNeeded)) {
+      if (!memoryLeft.isOwnLimitOfChildReached(bytesNeeded)) {
+        AD_CORRECTNESS_CHECK(clearOnAllocation_);
+        clearOnAllocation_(bytesNeeded);
+      }
+      memoryLeft.decrease_if_enough_left_or_throw(bytesNeeded);
     }
     // the actual allocation
     return allocator_.allocate(n);
@@ -237,18 +408,23 @@ class AllocatorWithLimit {
     // free the memory
     allocator_.deallocate(p, n);
     // Update the amount of memory left.
-    memoryLeft_.ptr()->wlock()->increase(MemorySize::bytes(n * sizeof(T)));
+    memoryLeft_.ptr()->increase(MemorySize::bytes(n * sizeof(T)));
   }
 
   /// Return the number of bytes, that this allocator and all of its copies
   /// currently have available
   [[nodiscard]] MemorySize amountMemoryLeft() const {
-    // casting is ok, because the actual numFreeBytes call
-    // is const, and everything else is locking
-    return const_cast<AllocatorWithLimit*>(this)
-        ->memoryLeft_.ptr()
-        ->wlock()
-        ->amountMemoryLeft();
+    return memoryLeft_.ptr()->amountMemoryLeft();
+  }
+
+  // Return an allocator with a new memory budget with the given `limit`, which
+  // is a child of the budget of this allocator. The memory that is allocated
+  // via the returned allocator (and its copies) counts towards both limits,
+  // see `AllocationMemoryLeft` for details.
+  AllocatorWithLimit makeChildAllocator(MemorySize limit) const {
+    return AllocatorWithLimit{
+        makeAllocationMemoryLeftThreadsafeObject(limit, memoryLeft_),
+        clearOnAllocation_};
   }
 
   const auto& getMemoryLeft() const { return memoryLeft_; }
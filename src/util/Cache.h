@@ -10,6 +10,7 @@
 #include <cassert>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "backports/type_traits.h"
@@ -63,6 +64,8 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   // value_type .
   using key_type = Key;
   using value_type = Value;
+  using score_type = Score;
+  using score_comparator_type = ScoreComparator;
 
  private:
   template <typename K, typename V>
@@ -323,6 +326,20 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
         });
   }
 
+  // Return the total size of all entries (pinned and non-pinned). Unlike the
+  // two functions above, this is a constant-time operation.
+  [[nodiscard]] MemorySize totalSize() const {
+    return _totalSizeNonPinned + _totalSizePinned;
+  }
+
+  // The same as `pinnedSize`, but in constant time.
+  [[nodiscard]] MemorySize totalPinnedSize() const { return _totalSizePinned; }
+
+  // Return the size of the `value` as it is counted by this cache.
+  [[nodiscard]] MemorySize getSizeOfValue(const Value& value) const {
+    return _valueSizeGetter(value);
+  }
+
   /// Return the number of non-pinned cache entries
   [[nodiscard]] size_t numNonPinnedEntries() const { return _accessMap.size(); }
 
@@ -377,6 +394,21 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     return true;
   }
 
+  // Return the score of the non-pinned entry that would be removed next when
+  // making room in the cache, or `std::nullopt` if there are no non-pinned
+  // entries.
+  std::optional<Score> lowestScoreNonPinned() {
+    if (_entries.empty()) {
+      return std::nullopt;
+    }
+    return _entries.topScore();
+  }
+
+  // Remove the non-pinned entry that would be removed next when making room in
+  // the cache and return its size.
+  // Precondition: There must be at least one non-pinned entry.
+  MemorySize removeEntryWithLowestScore() { return removeOneEntry(); }
+
   // Get all the keys of entries that are currently stored (but not pinned) in
   // the cache.
   // NOTE: This function returns a lazy view, so the behavior is undefined if
@@ -384,14 +416,16 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   auto getAllNonpinnedKeys() const { return _accessMap | ql::views::keys; }
 
  private:
-  // Removes the entry with the smallest score from the cache.
+  // Removes the entry with the smallest score from the cache and returns its
+  // size.
   // Precondition: The cache must not be empty.
-  void removeOneEntry() {
+  MemorySize removeOneEntry() {
     AD_CONTRACT_CHECK(!_entries.empty());
     auto handle = _entries.pop();
-    _totalSizeNonPinned =
-        _totalSizeNonPinned - _valueSizeGetter(*handle.value().value());
+    auto size = _valueSizeGetter(*handle.value().value());
+    _totalSizeNonPinned = _totalSizeNonPinned - size;
     _accessMap.erase(handle.value().key());
+    return size;
   }
   size_t _maxNumEntries;
   MemorySize _maxSize;
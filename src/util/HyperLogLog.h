@@ -0,0 +1,98 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_HYPERLOGLOG_H
+#define QLEVER_SRC_UTIL_HYPERLOGLOG_H
+
+#include <absl/numeric/bits.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "backports/algorithm.h"
+#include "backports/three_way_comparison.h"
+#include "util/Serializer/SerializeArrayOrTuple.h"
+#include "util/Serializer/Serializer.h"
+
+namespace ad_utility {
+
+// A HyperLogLog sketch (Flajolet et al., 2007) that estimates the number of
+// distinct values that were added to it using a constant amount of memory. The
+// relative standard error of the estimate is about `1.04 / sqrt(2^precision)`,
+// which is about 6.5% for the precision of 8 that is used here. Two sketches
+// can be merged, the result is the sketch of the union of the added values.
+//
+// The hash function is deterministic (and not seeded per process like
+// `absl::Hash`), so sketches that were serialized by one process can be merged
+// with sketches of another process.
+class HyperLogLog {
+ public:
+  // The number of bits of the hash that determine the register.
+  static constexpr size_t precision = 8;
+  static constexpr size_t numRegisters = size_t{1} << precision;
+
+ private:
+  // The maximal number of leading zeros (plus one) of the bits of the hash that
+  // are not used for the register index.
+  std::array<uint8_t, numRegisters> registers_{};
+
+ public:
+  // Add a value (e.g. the bits of an `Id`) to the sketch.
+  void add(uint64_t value) {
+    uint64_t hash = mix(value);
+    size_t index = hash >> (64 - precision);
+    uint64_t remainder = hash << precision;
+    auto rank = static_cast<uint8_t>(
+        remainder == 0 ? 64 - precision + 1 : absl::countl_zero(remainder) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+  }
+
+  // Merge the `other` sketch into this sketch.
+  void merge(const HyperLogLog& other) {
+    for (size_t i = 0; i < numRegisters; ++i) {
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+  }
+
+  // Return the estimated number of distinct values that were added.
+  double estimate() const {
+    constexpr double m = numRegisters;
+    constexpr double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double sum = 0;
+    size_t numZeroRegisters = 0;
+    for (uint8_t r : registers_) {
+      sum += std::ldexp(1.0, -static_cast<int>(r));
+      numZeroRegisters += static_cast<size_t>(r == 0);
+    }
+    double estimate = alpha * m * m / sum;
+    // For small cardinalities, linear counting on the empty registers is more
+    // accurate than the raw estimate.
+    if (estimate <= 2.5 * m && numZeroRegisters > 0) {
+      return m * std::log(m / static_cast<double>(numZeroRegisters));
+    }
+    return estimate;
+  }
+
+  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(HyperLogLog, registers_)
+
+  AD_SERIALIZE_FRIEND_FUNCTION(HyperLogLog) { serializer | arg.registers_; }
+
+ private:
+  // The finalizer of `SplitMix64`, which spreads the (often very similar bit
+  // patterns of the) values over all the bits of the hash.
+  static constexpr uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+  }
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_HYPERLOGLOG_H
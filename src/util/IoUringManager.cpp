@@ -53,6 +53,48 @@ void SyncIoPolicy::addBatch(int fd,
   }
 }
 
+//______________________________________________________________________________
+BatchIoManagerWithFallback::BatchIoManagerWithFallback(unsigned ringSize) {
+  try {
+    ioManager_ = std::make_unique<BatchIoManager>(ringSize);
+  } catch (const std::exception& e) {
+    AD_LOG_DEBUG << "Could not set up asynchronous I/O, falling back to "
+                    "synchronous reads: "
+                 << e.what() << std::endl;
+    syncIoManager_ = std::make_unique<BatchManager<SyncIoPolicy>>(ringSize);
+  }
+}
+
+//______________________________________________________________________________
+auto BatchIoManagerWithFallback::addBatch(int fd,
+                                          ql::span<const size_t> numBytes,
+                                          ql::span<const uint64_t> offsets,
+                                          ql::span<char*> buffers)
+    -> BatchHandle {
+  if (ioManager_) {
+    return ioManager_->addBatch(fd, numBytes, offsets, buffers);
+  }
+  return syncIoManager_->addBatch(fd, numBytes, offsets, buffers);
+}
+
+//______________________________________________________________________________
+void BatchIoManagerWithFallback::wait(BatchHandle handle) {
+  if (ioManager_) {
+    ioManager_->wait(handle);
+  } else {
+    syncIoManager_->wait(handle);
+  }
+}
+
+//______________________________________________________________________________
+bool BatchIoManagerWithFallback::usesIoUring() const {
+#ifdef QLEVER_HAS_IO_URING
+  return ioManager_ != nullptr;
+#else
+  return false;
+#endif
+}
+
 #ifdef QLEVER_HAS_IO_URING
 
 //______________________________________________________________________________
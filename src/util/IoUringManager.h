@@ -14,6 +14,7 @@
 #include <gtest/gtest_prod.h>
 
 #include <cstdint>
+#include <memory>
 #include <unordered_map>
 
 #include "backports/algorithm.h"
@@ -216,6 +217,33 @@ using BatchIoManager = BatchManager<IoUringPolicy>;
 using BatchIoManager = BatchManager<SyncIoPolicy>;
 #endif
 
+// Same interface as `BatchIoManager`, but falls back to synchronous reads
+// (`SyncIoPolicy`) if the io_uring ring cannot be set up at runtime, e.g.
+// because io_uring is disabled by the kernel or by the seccomp profile of a
+// container. Single-threaded use only.
+class BatchIoManagerWithFallback {
+ public:
+  using BatchHandle = uint64_t;
+
+ private:
+  // Exactly one of the two is set.
+  std::unique_ptr<BatchIoManager> ioManager_;
+  std::unique_ptr<BatchManager<SyncIoPolicy>> syncIoManager_;
+
+ public:
+  explicit BatchIoManagerWithFallback(unsigned ringSize = 256);
+
+  // See `BatchManager::addBatch` and `BatchManager::wait`.
+  [[nodiscard]] BatchHandle addBatch(int fd, ql::span<const size_t> numBytes,
+                                     ql::span<const uint64_t> offsets,
+                                     ql::span<char*> buffers);
+  void wait(BatchHandle handle);
+
+  // Return true iff the reads are actually performed asynchronously via
+  // io_uring.
+  bool usesIoUring() const;
+};
+
 }  // namespace ad_utility
 
 #endif  // QLEVER_SRC_UTIL_IOURINGMANAGER_H
@@ -0,0 +1,156 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "util/Metrics.h"
+
+namespace ad_utility::metrics {
+
+// _____________________________________________________________________________
+void Histogram::observe(std::chrono::microseconds duration) {
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  auto it = ql::ranges::lower_bound(upperBoundsInSeconds, seconds);
+  if (it != upperBoundsInSeconds.end()) {
+    counts_[it - upperBoundsInSeconds.begin()].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sumInMicroseconds_.fetch_add(
+      static_cast<uint64_t>(std::max(duration.count(), int64_t{0})),
+      std::memory_order_relaxed);
+}
+
+// _____________________________________________________________________________
+uint64_t Histogram::cumulativeCount(size_t i) const {
+  uint64_t result = 0;
+  for (size_t j = 0; j <= i; ++j) {
+    result += counts_.at(j).load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void PrometheusWriter::writeHeader(std::string_view name, std::string_view help,
+                                   std::string_view type) {
+  if (name == lastName_) {
+    return;
+  }
+  lastName_ = name;
+  absl::StrAppend(&output_, "# HELP ", name, " ", help, "\n", "# TYPE ", name,
+                  " ", type, "\n");
+}
+
+// _____________________________________________________________________________
+std::string PrometheusWriter::formatLabels(const Labels& labels) {
+  if (labels.empty()) {
+    return "";
+  }
+  std::string result = "{";
+  for (const auto& [name, value] : labels) {
+    if (result.size() > 1) {
+      result.push_back(',');
+    }
+    absl::StrAppend(&result, name, "=\"");
+    // Backslashes, double quotes, and newlines have to be escaped in the
+    // values of labels.
+    for (char c : value) {
+      if (c == '\\' || c == '"') {
+        result.push_back('\\');
+        result.push_back(c);
+      } else if (c == '\n') {
+        result.append("\\n");
+      } else {
+        result.push_back(c);
+      }
+    }
+    result.push_back('"');
+  }
+  result.push_back('}');
+  return result;
+}
+
+// _____________________________________________________________________________
+void PrometheusWriter::addHistogram(std::string_view name,
+                                    std::string_view help,
+                                    const Histogram& histogram,
+                                    const Labels& labels) {
+  writeHeader(name, help, "histogram");
+  // Read the count first, such that the `+Inf` bucket is never smaller than
+  // the other (cumulative) buckets, even if durations are added concurrently.
+  auto count = histogram.count();
+  auto bucketName = absl::StrCat(name, "_bucket");
+  for (size_t i = 0; i < Histogram::upperBoundsInSeconds.size(); ++i) {
+    auto bucketLabels = labels;
+    auto upperBound = absl::StrCat(Histogram::upperBoundsInSeconds[i]);
+    bucketLabels.emplace_back("le", upperBound);
+    addSample(bucketName, bucketLabels,
+              std::min(histogram.cumulativeCount(i), count));
+  }
+  auto infLabels = labels;
+  infLabels.emplace_back("le", "+Inf");
+  addSample(bucketName, infLabels, count);
+  addSample(absl::StrCat(name, "_sum"), labels,
+            std::chrono::duration<double>{histogram.sum()}.count());
+  addSample(absl::StrCat(name, "_count"), labels, count);
+}
+
+// _____________________________________________________________________________
+void Metrics::writeTo(PrometheusWriter& writer) const {
+  queryDuration_.forEach([&writer](std::string_view type,
+                                   const Histogram& histogram) {
+    writer.addHistogram("qlever_query_duration_seconds",
+                        "Duration of queries and updates by type.", histogram,
+                        {{"type", type}});
+  });
+
+  using Op = OperationStatistics;
+  auto writeOperations = [&](std::string_view name, std::string_view help,
+                             auto getValue) {
+    operations_.forEach([&](std::string_view operation, const Op& stats) {
+      writer.addCounter(name, help, getValue(stats),
+                        {{"operation", operation}});
+    });
+  };
+  writeOperations("qlever_operation_computations_total",
+                  "Number of computed (not cached) operations by type.",
+                  [](const Op& s) { return s.numComputations_.value(); });
+  writeOperations("qlever_operation_time_seconds_total",
+                  "Total computation time of operations by type.",
+                  [](const Op& s) {
+                    return static_cast<double>(s.timeInMicroseconds_.value()) /
+                           1e6;
+                  });
+  writeOperations("qlever_operation_rows_total",
+                  "Total number of result rows of operations by type.",
+                  [](const Op& s) { return s.numRows_.value(); });
+
+  using Pool = ThreadPoolStatistics;
+  auto writeThreadPools = [&](std::string_view name, std::string_view help,
+                              auto getValue) {
+    threadPools_.forEach([&](std::string_view pool, const Pool& stats) {
+      writer.addGauge(name, help, getValue(stats), {{"pool", pool}});
+    });
+  };
+  writeThreadPools("qlever_thread_pool_queued_tasks",
+                   "Number of tasks waiting for a thread.",
+                   [](const Pool& s) { return s.numQueuedTasks_.value(); });
+  writeThreadPools("qlever_thread_pool_running_tasks",
+                   "Number of tasks that are currently running.",
+                   [](const Pool& s) { return s.numRunningTasks_.value(); });
+
+  writer.addCounter("qlever_permutation_bytes_read_total",
+                    "Bytes read from the permutations on disk.",
+                    bytesReadFromPermutations_.value());
+  writer.addCounter("qlever_vocabulary_bytes_read_total",
+                    "Bytes read from the vocabulary on disk.",
+                    bytesReadFromVocabulary_.value());
+}
+
+// _____________________________________________________________________________
+Metrics& globalMetrics() {
+  static Metrics metrics;
+  return metrics;
+}
+
+}  // namespace ad_utility::metrics
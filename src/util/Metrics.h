@@ -0,0 +1,220 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_METRICS_H
+#define QLEVER_SRC_UTIL_METRICS_H
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_format.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "backports/algorithm.h"
+#include "util/HashMap.h"
+#include "util/Synchronized.h"
+
+// Counters, gauges, and histograms for monitoring the server, which are
+// exported in the text format of Prometheus (see `PrometheusWriter`) by the
+// `/metrics` endpoint of the `Server`. Updating a metric is a single relaxed
+// atomic operation, so the metrics can be used on hot paths.
+namespace ad_utility::metrics {
+
+// A value that only increases, e.g. the number of bytes read from disk.
+class Counter {
+  std::atomic<uint64_t> value_ = 0;
+
+ public:
+  void add(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+};
+
+// A value that can increase and decrease, e.g. the length of a queue.
+class Gauge {
+  std::atomic<int64_t> value_ = 0;
+
+ public:
+  void increment() { value_.fetch_add(1, std::memory_order_relaxed); }
+  void decrement() { value_.fetch_sub(1, std::memory_order_relaxed); }
+  int64_t value() const { return value_.load(std::memory_order_relaxed); }
+};
+
+// A histogram of durations with fixed buckets.
+class Histogram {
+ public:
+  // The upper bounds of the buckets in seconds. Durations above the last bound
+  // are only counted in the implicit `+Inf` bucket.
+  static constexpr std::array upperBoundsInSeconds{
+      0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25,
+      0.5,   1.0,   2.5,  5.0,   10.0, 30.0, 60.0};
+
+ private:
+  // The number of durations per bucket (not cumulative).
+  std::array<std::atomic<uint64_t>, upperBoundsInSeconds.size()> counts_{};
+  std::atomic<uint64_t> count_ = 0;
+  std::atomic<uint64_t> sumInMicroseconds_ = 0;
+
+ public:
+  void observe(std::chrono::microseconds duration);
+
+  // The number of durations that are at most `upperBoundsInSeconds[i]`.
+  uint64_t cumulativeCount(size_t i) const;
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  std::chrono::microseconds sum() const {
+    return std::chrono::microseconds{
+        sumInMicroseconds_.load(std::memory_order_relaxed)};
+  }
+};
+
+// A set of metrics of type `T`, one for each value of a label (e.g. one
+// `Histogram` per type of query). Looking up the metric for a label takes a
+// shared lock (and an exclusive one for the first lookup of a label), so the
+// metric should be looked up once and then be updated via the reference.
+template <typename T>
+class LabeledFamily {
+  Synchronized<HashMap<std::string, std::unique_ptr<T>>, std::shared_mutex>
+      metrics_;
+
+ public:
+  // Return the metric for the `label`, which is created if it doesn't exist
+  // yet. The reference stays valid for the lifetime of this family.
+  T& get(std::string_view label) {
+    {
+      auto lock = metrics_.rlock();
+      if (auto it = lock->find(label); it != lock->end()) {
+        return *it->second;
+      }
+    }
+    auto lock = metrics_.wlock();
+    auto& metric = (*lock)[std::string{label}];
+    if (metric == nullptr) {
+      metric = std::make_unique<T>();
+    }
+    return *metric;
+  }
+
+  // Call `function(label, metric)` for each of the metrics, sorted by label.
+  template <typename Function>
+  void forEach(const Function& function) const {
+    auto lock = metrics_.rlock();
+    std::vector<std::pair<std::string_view, const T*>> sorted;
+    for (const auto& [label, metric] : *lock) {
+      sorted.emplace_back(label, metric.get());
+    }
+    ql::ranges::sort(sorted);
+    for (const auto& [label, metric] : sorted) {
+      function(label, *metric);
+    }
+  }
+};
+
+// Writes metrics in the text-based exposition format of Prometheus. All the
+// samples of a metric must be added consecutively, the `# HELP` and `# TYPE`
+// lines are only written for the first of them.
+class PrometheusWriter {
+ public:
+  using Labels = std::vector<std::pair<std::string_view, std::string_view>>;
+
+ private:
+  std::string output_;
+  std::string lastName_;
+
+ public:
+  template <typename T>
+  void addCounter(std::string_view name, std::string_view help, T value,
+                  const Labels& labels = {}) {
+    writeHeader(name, help, "counter");
+    addSample(name, labels, value);
+  }
+
+  template <typename T>
+  void addGauge(std::string_view name, std::string_view help, T value,
+                const Labels& labels = {}) {
+    writeHeader(name, help, "gauge");
+    addSample(name, labels, value);
+  }
+
+  // Add the buckets, the sum (in seconds), and the count of the `histogram`.
+  void addHistogram(std::string_view name, std::string_view help,
+                    const Histogram& histogram, const Labels& labels = {});
+
+  const std::string& output() const { return output_; }
+
+ private:
+  void writeHeader(std::string_view name, std::string_view help,
+                   std::string_view type);
+
+  template <typename T>
+  void addSample(std::string_view name, const Labels& labels, T value) {
+    absl::StrAppend(&output_, name, formatLabels(labels), " ",
+                    formatValue(value), "\n");
+  }
+
+  // Format the `value` of a sample. Floating-point values are written with 17
+  // significant digits, s.t. they are exact (`absl::StrCat` only writes 6).
+  template <typename T>
+  static std::string formatValue(T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return absl::StrFormat("%.17g", value);
+    } else {
+      return absl::StrCat(value);
+    }
+  }
+
+  // Format the `labels` as `{name="value",...}`, or as the empty string if
+  // there are no labels.
+  static std::string formatLabels(const Labels& labels);
+};
+
+// The metrics that are not owned by any particular object, but updated from
+// many places in the code (e.g. the bytes read from the index files), and the
+// metrics that are aggregated over all queries.
+struct Metrics {
+  // The duration of queries and updates by type (`select`, `ask`, `construct`,
+  // `update`), measured from the arrival of the request until the result was
+  // completely sent.
+  LabeledFamily<Histogram> queryDuration_;
+
+  // The total computation time and result size per type of operation,
+  // aggregated over the runtime information of all queries.
+  struct OperationStatistics {
+    Counter numComputations_;
+    Counter timeInMicroseconds_;
+    Counter numRows_;
+  };
+  LabeledFamily<OperationStatistics> operations_;
+
+  // The number of tasks that are waiting for a thread, and the number of tasks
+  // that are running, per thread pool of the server.
+  struct ThreadPoolStatistics {
+    Gauge numQueuedTasks_;
+    Gauge numRunningTasks_;
+  };
+  LabeledFamily<ThreadPoolStatistics> threadPools_;
+
+  // The number of (compressed) bytes that were read from the permutations and
+  // from the vocabulary on disk.
+  Counter bytesReadFromPermutations_;
+  Counter bytesReadFromVocabulary_;
+
+  // Write all the metrics above to the `writer`.
+  void writeTo(PrometheusWriter& writer) const;
+};
+
+// The single global instance of `Metrics`.
+Metrics& globalMetrics();
+
+}  // namespace ad_utility::metrics
+
+#endif  // QLEVER_SRC_UTIL_METRICS_H
@@ -126,6 +126,18 @@ class TreeBasedPQ {
     return handle;
   }
 
+  /**
+   * Return the score of the element that would be removed by the next call to
+   * `pop()`
+   * @throws EmptyPopException if this Priority Queue is empty
+   */
+  const Score& topScore() const {
+    if (!size()) {
+      throw EmptyPopException{};
+    }
+    return mMap.begin()->mScore;
+  }
+
   /**
    * @brief erase a single value from the priority queue
    *
@@ -364,6 +376,19 @@ class HeapBasedPQ {
     return handle;
   }
 
+  /**
+   * Return the score of the node that would be removed by the next call to
+   * `pop()`. Not const, because outdated nodes are removed first (see `pop()`)
+   * @throws EmptyPopException if this Priority Queue is empty
+   */
+  const Score& topScore() {
+    pruneChangedKeys();
+    if (_pq.empty()) {
+      throw EmptyPopException{};
+    }
+    return _pq.top().mScore;
+  }
+
   /**
    * @brief Update (not necessarily decrease) the score/key of the value
    * associated with the handle
@@ -93,6 +93,25 @@ CPP_template(typename Serializer)(
                        ad_utility::dereference);
 }
 
+// Same as above, but for a local vocabulary that is given by the `words` and
+// the `blankNodeBlocks` (see `LocalVocab::getOwnedLocalBlankNodeBlocks`). The
+// format is the same.
+CPP_template(typename Serializer)(
+    requires serialization::WriteSerializer<Serializer>) void
+    serializeLocalVocab(
+        Serializer& serializer,
+        const std::vector<
+            BlankNodeManager::LocalBlankNodeManager::OwnedBlocksEntry>&
+            blankNodeBlocks,
+        ql::span<const LocalVocabIndex> words) {
+  serializer << blankNodeBlocks;
+  serializer << uint64_t{words.size()};
+  for (LocalVocabIndex word : words) {
+    serializer << Id::makeFromLocalVocabIndex(word);
+    serializer << word->toStringRepresentation();
+  }
+}
+
 // Deserialize the local vocabulary from the input stream.
 CPP_template(typename Serializer)(
     requires serialization::ReadSerializer<Serializer>) std::
@@ -181,6 +200,25 @@ CPP_template(typename Range)(
   }
 }
 
+// Same as above, but for a local vocabulary that is given by the `words` and
+// the `blankNodeBlocks` (see `LocalVocab::getOwnedLocalBlankNodeBlocks`). This
+// can be used to serialize a copy of the state of a `LocalVocab` while the
+// `LocalVocab` itself is concurrently extended.
+CPP_template(typename Range)(requires ql::ranges::range<Range>) void
+    serializeIds(const std::filesystem::path& path,
+                 const std::vector<
+                     BlankNodeManager::LocalBlankNodeManager::OwnedBlocksEntry>&
+                     blankNodeBlocks,
+                 ql::span<const LocalVocabIndex> words, Range&& idRanges) {
+  serialization::FileWriteSerializer serializer{path.c_str()};
+  detail::writeHeader(serializer);
+  detail::serializeLocalVocab(serializer, blankNodeBlocks, words);
+  serializer << uint64_t{ql::ranges::size(idRanges)};
+  for (const auto& ids : idRanges) {
+    detail::serializeIds(serializer, ids);
+  }
+}
+
 inline std::tuple<LocalVocab, std::vector<std::vector<Id>>> deserializeIds(
     const std::filesystem::path& path, const LocalVocabContext& context) {
   // This is a minor TOCTOU issue, the file might be gone after this check and
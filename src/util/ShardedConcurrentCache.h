@@ -0,0 +1,556 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_SHARDEDCONCURRENTCACHE_H
+#define QLEVER_SRC_UTIL_SHARDEDCONCURRENTCACHE_H
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/hash/hash.h"
+#include "util/Cache.h"
+#include "util/ConcurrentCache.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+namespace ad_utility {
+
+// A replacement for `ConcurrentCache` with the same interface and semantics
+// (see there for the documentation of the individual functions), but without a
+// single global lock. The keys are distributed over a fixed number of shards,
+// each of which has its own mutex, its own cache, and its own map of the
+// results that are currently being computed. Lookups and insertions of keys
+// that belong to different shards therefore never wait for each other.
+//
+// The limits for the number of entries and the total size (see
+// `setMaxNumEntries` and `setMaxSize`) apply to the cache as a whole, not to
+// the individual shards. Each shard is configured with the global limits (so
+// a single entry can be as large as in an unsharded cache), and whenever the
+// sum over all shards exceeds a limit, the non-pinned entry with the lowest
+// score among all shards (for an LRU cache: the least recently used entry) is
+// removed until the limits are satisfied again. Without concurrent accesses,
+// the entries are thus evicted in the same order as in a single cache. The
+// `Cache` must be constructible from `(maxNumEntries, maxSize,
+// maxSizeSingleEntry)`, like `LRUCache`.
+//
+// Pinned entries can't be evicted, so an entry is only inserted (or an
+// existing entry pinned) if it fits into the cache together with the pinned
+// entries of all shards. Otherwise, it is not stored at all. That way, the
+// total size of the pinned entries never exceeds the maximal size of the cache
+// (unless the maximal size is reduced later).
+template <typename Cache>
+class ShardedConcurrentCache {
+ public:
+  using Value = typename Cache::value_type;
+  using Key = typename Cache::key_type;
+
+  // The default number of shards. Additional shards make the cache slightly
+  // more expensive when entries have to be evicted.
+  static constexpr size_t defaultNumShards = 32;
+
+  struct ResultAndCacheStatus {
+    std::shared_ptr<const Value> _resultPointer;
+    CacheStatus _cacheStatus;
+  };
+
+ private:
+  using ResultInProgress = ConcurrentCacheDetail::ResultInProgress<Value>;
+  using Score = typename Cache::score_type;
+  using ScoreComparator = typename Cache::score_comparator_type;
+
+  // The data of a single shard. The bool in the `inProgress_` map tells us
+  // whether the result will be pinned in the cache.
+  struct Shard {
+    Cache cache_;
+    HashMap<Key, std::pair<bool, std::shared_ptr<ResultInProgress>>>
+        inProgress_;
+  };
+
+  // A shard together with its number of entries and its total size, which can
+  // be read without locking the shard. They are updated whenever the shard is
+  // modified.
+  struct ShardWithStatistics {
+    Synchronized<Shard, std::mutex> shard_;
+    std::atomic<size_t> numEntries_ = 0;
+    std::atomic<size_t> sizeInBytes_ = 0;
+    std::atomic<size_t> pinnedSizeInBytes_ = 0;
+
+    explicit ShardWithStatistics(Cache cache)
+        : shard_{Shard{std::move(cache), {}}} {}
+
+    // Update the statistics. Must be called while holding the lock for the
+    // `shard`.
+    void updateStatistics(const Shard& shard) {
+      numEntries_ =
+          shard.cache_.numNonPinnedEntries() + shard.cache_.numPinnedEntries();
+      sizeInBytes_ = shard.cache_.totalSize().getBytes();
+      pinnedSizeInBytes_ = shard.cache_.totalPinnedSize().getBytes();
+    }
+  };
+
+  std::vector<std::unique_ptr<ShardWithStatistics>> shards_;
+  std::atomic<size_t> maxNumEntries_;
+  std::atomic<size_t> maxSizeInBytes_;
+  // Only one thread at a time evicts entries to satisfy the global limits, so
+  // that concurrent insertions do not evict more entries than necessary.
+  std::mutex evictionMutex_;
+  // Only one thread at a time adds pinned entries, so that the check whether an
+  // entry fits next to the pinned entries of all shards is not invalidated by
+  // a concurrent insertion into another shard. When locking both this mutex
+  // and a shard, this mutex has to be locked first.
+  std::mutex pinningMutex_;
+  // Statistics for monitoring, see the corresponding getters.
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+  std::atomic<size_t> numEvictions_ = 0;
+
+ public:
+  explicit ShardedConcurrentCache(
+      size_t numShards = defaultNumShards, size_t maxNumEntries = size_t_max,
+      MemorySize maxSize = MemorySize::max(),
+      MemorySize maxSizeSingleEntry = MemorySize::max())
+      : maxNumEntries_{maxNumEntries}, maxSizeInBytes_{maxSize.getBytes()} {
+    AD_CONTRACT_CHECK(numShards > 0);
+    shards_.reserve(numShards);
+    for (size_t i = 0; i < numShards; ++i) {
+      shards_.push_back(std::make_unique<ShardWithStatistics>(
+          Cache{maxNumEntries, maxSize, maxSizeSingleEntry}));
+    }
+  }
+
+  size_t numShards() const { return shards_.size(); }
+
+  // See `ConcurrentCache::computeOnce`.
+  CPP_template_2(typename ComputeFuncT, typename SuitabilityFuncT)(
+      requires InvocableWithConvertibleReturnType<ComputeFuncT, Value> CPP_and_2
+          InvocableWithConvertibleReturnType<SuitabilityFuncT, bool,
+                                             const Value&>) ResultAndCacheStatus
+      computeOnce(const Key& key, const ComputeFuncT& computeFunction,
+                  bool onlyReadFromCache,
+                  const SuitabilityFuncT& suitableForCache) {
+    return computeOnceImpl(false, key, computeFunction, onlyReadFromCache,
+                           suitableForCache);
+  }
+
+  // See `ConcurrentCache::computeOncePinned`.
+  CPP_template_2(typename ComputeFuncT, typename SuitabilityFuncT)(
+      requires InvocableWithConvertibleReturnType<ComputeFuncT, Value> CPP_and_2
+          InvocableWithConvertibleReturnType<SuitabilityFuncT, bool,
+                                             const Value&>) ResultAndCacheStatus
+      computeOncePinned(const Key& key, const ComputeFuncT& computeFunction,
+                        bool onlyReadFromCache,
+                        const SuitabilityFuncT& suitedForCache) {
+    return computeOnceImpl(true, key, computeFunction, onlyReadFromCache,
+                           suitedForCache);
+  }
+
+  // See `ConcurrentCache::computeButDontStore`.
+  CPP_template_2(typename ComputeFuncT, typename SuitabilityFuncT)(
+      requires InvocableWithConvertibleReturnType<ComputeFuncT, Value> CPP_and_2
+          InvocableWithConvertibleReturnType<SuitabilityFuncT, bool,
+                                             const Value&>) ResultAndCacheStatus
+      computeButDontStore(
+          const Key& key, const ComputeFuncT& computeFunction,
+          bool onlyReadFromCache,
+          [[maybe_unused]] const SuitabilityFuncT& suitedForCache) {
+    {
+      auto resultPtr = getShard(key).shard_.wlock()->cache_[key];
+      if (resultPtr != nullptr) {
+        countLookup(true);
+        return {std::move(resultPtr), CacheStatus::cachedNotPinned};
+      }
+    }
+    countLookup(false);
+    if (onlyReadFromCache) {
+      return {nullptr, CacheStatus::notInCacheAndNotComputed};
+    }
+    auto value = std::make_shared<Value>(computeFunction());
+    return {std::move(value), CacheStatus::computed};
+  }
+
+  // See `ConcurrentCache::tryInsertIfNotPresent`.
+  void tryInsertIfNotPresent(bool pinned, const Key& key,
+                             std::shared_ptr<Value> value) {
+    auto& shard = getShard(key);
+    {
+      auto pinningLock = lockForPinning(pinned);
+      auto lock = shard.shard_.wlock();
+      if (pinned) {
+        if (!pinIfContainedAndFits(*lock, key)) {
+          insertIfFits(*lock, true, key, std::move(value));
+        }
+      } else if (!lock->cache_.contains(key)) {
+        insertIfFits(*lock, false, key, std::move(value));
+      }
+      shard.updateStatistics(*lock);
+    }
+    enforceLimits();
+  }
+
+  // Clear the cache (but not the pinned entries).
+  void clearUnpinnedOnly() {
+    forEachShard([](Shard& shard) { shard.cache_.clearUnpinnedOnly(); });
+  }
+
+  // Clear the cache, including the pinned entries.
+  void clearAll() {
+    forEachShard([](Shard& shard) { shard.cache_.clearAll(); });
+  }
+
+  // Delete non-pinned entries with a total size of at least `size` in the
+  // order described above. If this is not possible, all non-pinned entries are
+  // deleted and false is returned.
+  bool makeRoomAsMuchAsPossible(MemorySize size) {
+    std::lock_guard evictionLock{evictionMutex_};
+    MemorySize removedSize;
+    while (removedSize < size) {
+      auto sizeOfRemovedEntry = removeEntryWithLowestScore();
+      if (!sizeOfRemovedEntry.has_value()) {
+        return false;
+      }
+      removedSize += sizeOfRemovedEntry.value();
+    }
+    return true;
+  }
+
+  // The number of non-pinned entries in the cache.
+  size_t numNonPinnedEntries() const {
+    return sumOverShards(
+        [](const Cache& cache) { return cache.numNonPinnedEntries(); });
+  }
+
+  // The number of pinned entries in the cache.
+  size_t numPinnedEntries() const {
+    return sumOverShards(
+        [](const Cache& cache) { return cache.numPinnedEntries(); });
+  }
+
+  // Total size of the non-pinned entries in the cache.
+  MemorySize nonPinnedSize() const {
+    return sumOverShards(
+        [](const Cache& cache) { return cache.nonPinnedSize(); });
+  }
+
+  // Total size of the pinned entries in the cache.
+  MemorySize pinnedSize() const {
+    return sumOverShards([](const Cache& cache) { return cache.pinnedSize(); });
+  }
+
+  // Is the key in the cache (not in progress), used for testing.
+  bool cacheContains(const Key& key) const {
+    return getShard(key).shard_.wlock()->cache_.contains(key);
+  }
+
+  // Only for testing: The number of results that are currently being computed.
+  size_t numResultsInProgress() const {
+    size_t result = 0;
+    for (const auto& shard : shards_) {
+      result += shard->shard_.wlock()->inProgress_.size();
+    }
+    return result;
+  }
+
+  // See `ConcurrentCache::getIfContained`.
+  std::optional<ResultAndCacheStatus> getIfContained(const Key& key) {
+    auto lock = getShard(key).shard_.wlock();
+    auto& cache = lock->cache_;
+    const auto cacheStatus = getCacheStatus(cache, key);
+    if (cacheStatus == CacheStatus::computed) {
+      return std::nullopt;
+    }
+    return ResultAndCacheStatus{cache[key], cacheStatus};
+  }
+
+  // These functions set the different capacity/size settings of the cache.
+  void setMaxSize(MemorySize maxSize) {
+    maxSizeInBytes_ = maxSize.getBytes();
+    forEachShard([maxSize](Shard& shard) { shard.cache_.setMaxSize(maxSize); });
+    enforceLimits();
+  }
+  void setMaxNumEntries(size_t maxNumEntries) {
+    maxNumEntries_ = maxNumEntries;
+    forEachShard([maxNumEntries](Shard& shard) {
+      shard.cache_.setMaxNumEntries(maxNumEntries);
+    });
+    enforceLimits();
+  }
+  void setMaxSizeSingleEntry(MemorySize maxSize) {
+    forEachShard([maxSize](Shard& shard) {
+      shard.cache_.setMaxSizeSingleEntry(maxSize);
+    });
+  }
+
+  MemorySize getMaxSizeSingleEntry() const {
+    return shards_.front()->shard_.wlock()->cache_.getMaxSizeSingleEntry();
+  }
+
+  // The number of lookups via `computeOnce`, `computeOncePinned`, and
+  // `computeButDontStore` that found the result in the cache (hits) or not
+  // (misses), and the number of entries that were removed to satisfy the
+  // limits of the cache.
+  size_t numHits() const { return numHits_.load(std::memory_order_relaxed); }
+  size_t numMisses() const {
+    return numMisses_.load(std::memory_order_relaxed);
+  }
+  size_t numEvictions() const {
+    return numEvictions_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Return the shard for the `key`. The hash maps inside the shards use the
+  // same hash function and mostly look at its lower bits, so we use the upper
+  // bits to choose the shard.
+  ShardWithStatistics& getShard(const Key& key) const {
+    size_t hash = std::rotr(absl::Hash<Key>{}(key), sizeof(size_t) * 4);
+    return *shards_[hash % shards_.size()];
+  }
+
+  // Apply `function` to each shard (while holding its lock) and update its
+  // statistics.
+  template <typename Function>
+  void forEachShard(const Function& function) {
+    for (auto& shard : shards_) {
+      auto lock = shard->shard_.wlock();
+      function(*lock);
+      shard->updateStatistics(*lock);
+    }
+  }
+
+  // Return the sum of `function(cache)` over the caches of all shards.
+  template <typename Function>
+  auto sumOverShards(const Function& function) const {
+    std::invoke_result_t<const Function&, const Cache&> result{};
+    for (const auto& shard : shards_) {
+      result += function(shard->shard_.wlock()->cache_);
+    }
+    return result;
+  }
+
+  // Remove the non-pinned entry with the lowest score among all shards and
+  // return its size, or `std::nullopt` if there are no non-pinned entries.
+  // Must only be called while holding the `evictionMutex_`.
+  std::optional<MemorySize> removeEntryWithLowestScore() {
+    std::optional<std::pair<Score, ShardWithStatistics*>> lowest;
+    ScoreComparator comparator{};
+    for (auto& shard : shards_) {
+      if (shard->numEntries_ == 0) {
+        continue;
+      }
+      auto score = shard->shard_.wlock()->cache_.lowestScoreNonPinned();
+      if (score.has_value() &&
+          (!lowest.has_value() || comparator(score.value(), lowest->first))) {
+        lowest.emplace(std::move(score.value()), shard.get());
+      }
+    }
+    if (!lowest.has_value()) {
+      return std::nullopt;
+    }
+    auto& shard = *lowest->second;
+    auto lock = shard.shard_.wlock();
+    // The lock was released in between, so the shard might have changed. In
+    // particular, its entries might have been pinned or removed.
+    if (!lock->cache_.lowestScoreNonPinned().has_value()) {
+      return MemorySize{};
+    }
+    auto size = lock->cache_.removeEntryWithLowestScore();
+    shard.updateStatistics(*lock);
+    numEvictions_.fetch_add(1, std::memory_order_relaxed);
+    return size;
+  }
+
+  // Remove entries as described above until the total number of entries and
+  // the total size of all shards are within the limits again (or there are no
+  // more non-pinned entries).
+  void enforceLimits() {
+    auto exceedsLimits = [this]() {
+      size_t numEntries = 0;
+      size_t sizeInBytes = 0;
+      for (const auto& shard : shards_) {
+        numEntries += shard->numEntries_;
+        sizeInBytes += shard->sizeInBytes_;
+      }
+      return numEntries > maxNumEntries_ || sizeInBytes > maxSizeInBytes_;
+    };
+    if (!exceedsLimits()) {
+      return;
+    }
+    std::lock_guard evictionLock{evictionMutex_};
+    while (exceedsLimits()) {
+      if (!removeEntryWithLowestScore().has_value()) {
+        return;
+      }
+    }
+  }
+
+  // Return a lock for the `pinningMutex_` if `pinned` is true, and an empty
+  // lock otherwise.
+  std::unique_lock<std::mutex> lockForPinning(bool pinned) {
+    return pinned ? std::unique_lock{pinningMutex_}
+                  : std::unique_lock<std::mutex>{};
+  }
+
+  // Return true iff an entry of the given `size` fits into the cache together
+  // with the pinned entries of all shards. Must only be called while holding
+  // the lock of the shard that is modified, and also the `pinningMutex_` if
+  // the entry is pinned.
+  bool fitsNextToPinnedEntries(MemorySize size) const {
+    size_t pinnedSizeInBytes = 0;
+    for (const auto& shard : shards_) {
+      pinnedSizeInBytes += shard->pinnedSizeInBytes_;
+    }
+    const size_t maxSizeInBytes = maxSizeInBytes_;
+    return size.getBytes() <= maxSizeInBytes &&
+           pinnedSizeInBytes <= maxSizeInBytes - size.getBytes();
+  }
+
+  // Insert the `value` for the `key` into the (locked) `shard` if it fits (see
+  // `fitsNextToPinnedEntries`). The caller has to update the statistics.
+  void insertIfFits(Shard& shard, bool pinned, const Key& key,
+                    std::shared_ptr<Value> value) {
+    if (!fitsNextToPinnedEntries(shard.cache_.getSizeOfValue(*value))) {
+      return;
+    }
+    if (pinned) {
+      shard.cache_.insertPinned(key, std::move(value));
+    } else {
+      shard.cache_.insert(key, std::move(value));
+    }
+  }
+
+  // If the (locked) `shard` contains a non-pinned entry for the `key`, pin it
+  // if it fits (see `fitsNextToPinnedEntries`). Return true iff the `shard`
+  // contains the `key`. The caller has to update the statistics and hold the
+  // `pinningMutex_`.
+  bool pinIfContainedAndFits(Shard& shard, const Key& key) {
+    auto& cache = shard.cache_;
+    if (!cache.containsNonPinned(key)) {
+      return cache.containsPinned(key);
+    }
+    if (fitsNextToPinnedEntries(cache.getSizeOfValue(*cache[key]))) {
+      cache.containsAndMakePinnedIfExists(key);
+    }
+    return true;
+  }
+
+  // Count a lookup as a hit or a miss.
+  void countLookup(bool hit) {
+    (hit ? numHits_ : numMisses_).fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Delete the entry with the `key` from the results that are in progress and
+  // add the `result` to the cache.
+  void moveFromInProgressToCache(ShardWithStatistics& shard, const Key& key,
+                                 std::shared_ptr<Value> result) {
+    {
+      std::unique_lock pinningLock{pinningMutex_, std::defer_lock};
+      while (true) {
+        if (!pinningLock.owns_lock() &&
+            shard.shard_.wlock()->inProgress_.at(key).first) {
+          pinningLock.lock();
+        }
+        auto lock = shard.shard_.wlock();
+        auto it = lock->inProgress_.find(key);
+        AD_CONTRACT_CHECK(it != lock->inProgress_.end());
+        bool pinned = it->second.first;
+        // The result might have been pinned since we checked above (see
+        // `computeOnceImpl`), then try again with the `pinningMutex_`.
+        if (pinned && !pinningLock.owns_lock()) {
+          continue;
+        }
+        lock->inProgress_.erase(it);
+        insertIfFits(*lock, pinned, key, std::move(result));
+        shard.updateStatistics(*lock);
+        break;
+      }
+    }
+    enforceLimits();
+  }
+
+  // Implementation of `computeOnce` and `computeOncePinned`, which is the same
+  // as for the `ConcurrentCache`, but only locks the shard of the `key`.
+  CPP_template_2(typename ComputeFuncT, typename SuitabilityFuncT)(
+      requires InvocableWithConvertibleReturnType<ComputeFuncT, Value> CPP_and_2
+          InvocableWithConvertibleReturnType<SuitabilityFuncT, bool,
+                                             const Value&>) ResultAndCacheStatus
+      computeOnceImpl(bool pinned, const Key& key,
+                      const ComputeFuncT& computeFunction,
+                      bool onlyReadFromCache,
+                      const SuitabilityFuncT& suitableForCache) {
+    auto& shard = getShard(key);
+    bool mustCompute;
+    std::shared_ptr<ResultInProgress> resultInProgress;
+    {
+      auto pinningLock = lockForPinning(pinned);
+      auto lock = shard.shard_.wlock();
+      auto& cache = lock->cache_;
+      const auto cacheStatus = getCacheStatus(cache, key);
+      if (pinned) {
+        pinIfContainedAndFits(*lock, key);
+        shard.updateStatistics(*lock);
+      }
+      countLookup(cacheStatus != CacheStatus::computed);
+      if (cacheStatus != CacheStatus::computed) {
+        return {cache[key], cacheStatus};
+      } else if (onlyReadFromCache) {
+        return {nullptr, CacheStatus::notInCacheAndNotComputed};
+      }
+      auto it = lock->inProgress_.find(key);
+      if (it != lock->inProgress_.end()) {
+        // Someone else is computing the result. If we want to pin the result,
+        // but the computing thread doesn't, inform them about this.
+        it->second.first |= pinned;
+        mustCompute = false;
+        resultInProgress = it->second.second;
+      } else {
+        mustCompute = true;
+        resultInProgress = std::make_shared<ResultInProgress>();
+        lock->inProgress_.emplace(key, std::pair(pinned, resultInProgress));
+      }
+    }
+    if (mustCompute) {
+      try {
+        auto result = std::make_shared<Value>(computeFunction());
+        if (suitableForCache(*result)) {
+          moveFromInProgressToCache(shard, key, result);
+          resultInProgress->finish(result);
+        } else {
+          AD_CONTRACT_CHECK(!pinned);
+          shard.shard_.wlock()->inProgress_.erase(key);
+          resultInProgress->finish(nullptr);
+        }
+        return {std::move(result), CacheStatus::computed};
+      } catch (...) {
+        // Other threads may try this computation again in the future.
+        shard.shard_.wlock()->inProgress_.erase(key);
+        resultInProgress->abort();
+        throw;
+      }
+    }
+    // Someone else is computing the result, wait until it is finished. This
+    // is not counted as "cached" as we had to wait.
+    auto resultPointer = resultInProgress->getResult();
+    if (!resultPointer) {
+      // The result was not suitable for the cache, compute it ourselves.
+      auto mutablePointer = std::make_shared<Value>(computeFunction());
+      if (suitableForCache(*mutablePointer)) {
+        tryInsertIfNotPresent(pinned, key, mutablePointer);
+      } else {
+        AD_CONTRACT_CHECK(!pinned);
+      }
+      resultPointer = std::move(mutablePointer);
+    }
+    return {std::move(resultPointer), CacheStatus::computed};
+  }
+};
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_SHARDEDCONCURRENTCACHE_H
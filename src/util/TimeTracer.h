@@ -64,6 +64,15 @@ class TimeTracer {
   explicit TimeTracer(const std::string& name)
       : rootTrace_{name, std::chrono::milliseconds::zero()},
         activeTraces_({rootTrace_}) {}
+
+  // Create a tracer for a task that runs concurrently to the `parent` (e.g. on
+  // another thread). The times are measured relative to the start of the
+  // `parent`, s.t. the finished trace can be added to the `parent` with
+  // `addFinishedTrace`.
+  TimeTracer(const std::string& name, const TimeTracer& parent)
+      : timer_{parent.timer_},
+        rootTrace_{name, parent.timer_.msecs()},
+        activeTraces_({rootTrace_}) {}
   virtual ~TimeTracer() = default;
 
   virtual void beginTrace(const std::string& name) {
@@ -89,6 +98,20 @@ class TimeTracer {
     activeTraces_.pop_back();
   }
 
+  // Add the root trace of the `tracer`, which must have ended, as a child of
+  // the currently active trace.
+  virtual void addFinishedTrace(const TimeTracer& tracer) {
+    if (activeTraces_.empty()) {
+      throw std::runtime_error("The trace has ended.");
+    }
+    if (!tracer.rootTrace_.end_.has_value()) {
+      throw std::runtime_error(absl::StrCat(
+          "Tried to add trace \"", tracer.rootTrace_.name_,
+          "\", which has not yet ended."));
+    }
+    activeTraces_.back().get().children_.push_back(tracer.rootTrace_);
+  }
+
   // Resets the tracer to its initial state and restarts the root trace.
   virtual void reset() {
     if (!activeTraces_.empty()) {
@@ -122,6 +145,9 @@ class DefaultTimeTracer : public TimeTracer {
   void endTrace(std::string_view) override {
     // `DefaultTimeTracer` does nothing.
   }
+  void addFinishedTrace(const TimeTracer&) override {
+    // `DefaultTimeTracer` does nothing.
+  }
   nlohmann::ordered_json getJSON() const override { return {}; }
   nlohmann::ordered_json getJSONShort() const override { return {}; }
 };
@@ -17,6 +17,7 @@
 
 #include "backports/three_way_comparison.h"
 #include "backports/type_traits.h"
+#include "util/AllocatorWithLimit.h"
 #include "util/CancellationHandle.h"
 #include "util/Exception.h"
 #include "util/HashMap.h"
@@ -125,6 +126,12 @@ static_assert(!std::is_copy_assignable_v<OwningQueryId>);
 
 // A factory class to create unique query ids within each individual instance.
 class QueryRegistry {
+ public:
+  // The memory budget of a query (see `Qlever::createQueryExecutionContext`).
+  using MemoryBudget =
+      std::shared_ptr<const ad_utility::detail::AllocationMemoryLeft>;
+
+ private:
   struct CancellationHandleWithQuery {
     SharedCancellationHandle cancellationHandle_ =
         std::make_shared<CancellationHandle<>>();
@@ -133,6 +140,8 @@ class QueryRegistry {
     // the registry owns the start time; the start-event log line reads it back.
     std::chrono::system_clock::time_point startedAt_ =
         std::chrono::system_clock::now();
+    // The memory budget of the query, set via `setMemoryBudget`.
+    MemoryBudget memoryBudget_;
     explicit CancellationHandleWithQuery(std::string_view query)
         : query_{query} {}
   };
@@ -152,12 +161,28 @@ class QueryRegistry {
     // Wall-clock instant when the query was registered. Serialized to
     // clients as a Unix-epoch timestamp in milliseconds.
     std::chrono::system_clock::time_point startedAt_;
+    // The memory that is currently used by the query, its peak usage, and its
+    // limit, if the memory budget of the query is known.
+    struct MemoryUsage {
+      MemorySize used_;
+      MemorySize peak_;
+      MemorySize limit_;
+    };
+    std::optional<MemoryUsage> memoryUsage_ = std::nullopt;
 
     friend void to_json(nlohmann::json& json, const ActiveQueryInfo& info) {
       json = {
           {"query", info.query_},
           {"started-at", epochMillis(info.startedAt_)},
       };
+      if (info.memoryUsage_.has_value()) {
+        const auto& [used, peak, limit] = info.memoryUsage_.value();
+        json["memory-used"] = used.asString();
+        json["memory-peak"] = peak.asString();
+        if (limit != MemorySize::max()) {
+          json["memory-limit"] = limit.asString();
+        }
+      }
     }
   };
 
@@ -282,14 +307,29 @@ class QueryRegistry {
     return registry_->withReadLock([](const auto& map) {
       ad_utility::HashMap<QueryId, ActiveQueryInfo> result;
       result.reserve(map.size());
-      for (const auto& entry : map) {
-        result.emplace(entry.first, ActiveQueryInfo{entry.second.query_,
-                                                    entry.second.startedAt_});
+      for (const auto& [queryId, value] : map) {
+        ActiveQueryInfo info{value.query_, value.startedAt_};
+        if (const auto& budget = value.memoryBudget_; budget != nullptr) {
+          info.memoryUsage_ = ActiveQueryInfo::MemoryUsage{
+              budget->amountMemoryUsed(), budget->peakMemoryUsage(),
+              budget->limit()};
+        }
+        result.emplace(queryId, std::move(info));
       }
       return result;
     });
   }
 
+  // Associate the memory budget of the query with the given `queryId`, such
+  // that its usage is reported by `getActiveQueries`. Does nothing if the
+  // query is not registered.
+  void setMemoryBudget(const QueryId& queryId, MemoryBudget memoryBudget) {
+    auto lockedMap = registry_->wlock();
+    if (auto it = lockedMap->find(queryId); it != lockedMap->end()) {
+      it->second.memoryBudget_ = std::move(memoryBudget);
+    }
+  }
+
   // Returns the cancellation handle from the registry if it exists, nullptr
   // otherwise.
   SharedCancellationHandle getCancellationHandle(const QueryId& queryId) const {
@@ -105,3 +105,80 @@ TEST(AllocatorWithLimit, unlikelyExceptionsDuringCopyingAndMoving) {
   ASSERT_DEATH_IF_SUPPORTED(
       moveAssign(), "The move assignment operator of `AllocatorWithLimit`");
 }
+
+// _____________________________________________________________________________
+TEST(AllocatorWithLimit, childBudget) {
+  using ad_utility::detail::AllocationExceedsLimitException;
+  using ad_utility::detail::AllocationMemoryLeft;
+  const auto chunk = AllocationMemoryLeft::reservationChunkSize;
+  AllocatorWithLimit<char> parent{
+      makeAllocationMemoryLeftThreadsafeObject(10_MB)};
+  auto child = parent.makeChildAllocator(2_MB);
+  const auto& budget = *child.getMemoryLeft().ptr();
+  EXPECT_NE(child, parent);
+  EXPECT_EQ(child.amountMemoryLeft(), 2_MB);
+
+  // A small allocation reserves a whole chunk from the parent, from which the
+  // next small allocation is served.
+  auto* small = child.allocate(1000);
+  EXPECT_EQ(budget.amountMemoryUsed(), 1000_B);
+  EXPECT_EQ(parent.amountMemoryLeft(), 10_MB - 1000_B - chunk);
+  auto* small2 = child.allocate(1000);
+  EXPECT_EQ(parent.amountMemoryLeft(), 10_MB - 1000_B - chunk);
+  EXPECT_EQ(child.amountMemoryLeft(), 2_MB - 2000_B);
+
+  // The limit of the child applies, and is part of the message.
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      child.allocate(3'000'000),
+      ::testing::HasSubstr("the limit of the memory budget is 2 MB"),
+      AllocationExceedsLimitException);
+
+  // The limit of the parent also applies to the child.
+  auto* large = parent.allocate(9'000'000);
+  EXPECT_THROW(child.allocate(1'500'000), AllocationExceedsLimitException);
+  parent.deallocate(large, 9'000'000);
+
+  // After deallocating, at most one chunk stays reserved.
+  auto* medium = child.allocate(1'500'000);
+  EXPECT_EQ(budget.peakMemoryUsage(), 1'502'000_B);
+  child.deallocate(medium, 1'500'000);
+  child.deallocate(small, 1000);
+  child.deallocate(small2, 1000);
+  EXPECT_EQ(budget.amountMemoryUsed(), 0_B);
+  EXPECT_EQ(budget.peakMemoryUsage(), 1'502'000_B);
+  EXPECT_EQ(parent.amountMemoryLeft(), 10_MB - chunk);
+
+  // Without the limit, only the limit of the parent applies, and the
+  // reservation is returned to the parent (also after later deallocations).
+  auto* beforeRemoval = child.allocate(1000);
+  child.getMemoryLeft().ptr()->removeLimit();
+  EXPECT_EQ(budget.limit(), ad_utility::MemorySize::max());
+  EXPECT_EQ(budget.amountMemoryUsed(), 1000_B);
+  EXPECT_EQ(parent.amountMemoryLeft(), 10_MB - 1000_B);
+  auto* afterRemoval = child.allocate(3'000'000);
+  EXPECT_EQ(parent.amountMemoryLeft(), 10_MB - 3'001'000_B);
+  child.deallocate(afterRemoval, 3'000'000);
+  child.deallocate(beforeRemoval, 1000);
+  EXPECT_EQ(budget.amountMemoryUsed(), 0_B);
+  EXPECT_EQ(parent.amountMemoryLeft(), 10_MB);
+
+  // When the child is destroyed, the reservation is returned to the parent.
+  child = parent;
+  EXPECT_EQ(parent.amountMemoryLeft(), 10_MB);
+}
+
+// _____________________________________________________________________________
+TEST(AllocatorWithLimit, childBudgetOnlyClearsOnParentLimit) {
+  size_t numClears = 0;
+  AllocatorWithLimit<char> parent{
+      makeAllocationMemoryLeftThreadsafeObject(1_MB),
+      [&numClears](ad_utility::MemorySize) { ++numClears; }};
+  auto child = parent.makeChildAllocator(100_kB);
+  // Freeing memory elsewhere can't help when the limit of the child itself is
+  // reached.
+  EXPECT_ANY_THROW(child.allocate(200'000));
+  EXPECT_EQ(numClears, 0u);
+  auto grandChild = child.makeChildAllocator(ad_utility::MemorySize::max());
+  EXPECT_ANY_THROW(grandChild.allocate(200'000));
+  EXPECT_EQ(numClears, 1u);
+}
@@ -1150,6 +1150,91 @@ TEST(CompressedRelationReader, ensureDummyBlockWith6ColumnsDoesntCauseIssues) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(CompressedRelationReader, lazyScanWithBatchedReads) {
+  std::vector<RelationInput> inputs{RelationInput{42, {}}};
+  for (int i = 0; i < 500; ++i) {
+    inputs.at(0).col1And2_.push_back({i, i + 1});
+  }
+  auto [filename, cleanup] = testFilenameWithCleanup();
+  auto [blocks, metaData, reader] =
+      writeAndOpenRelations(inputs, filename, 237_B);
+  ASSERT_GT(blocks.size(), 5);
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  ScanSpecification scanSpec{V(42), std::nullopt, std::nullopt};
+
+  // The result must be the same, no matter if and how the reads of
+  // consecutive blocks are batched.
+  for (size_t ioBatchSize : {0, 1, 3, 1000}) {
+    auto reset = setRuntimeParameterForTest<
+        &RuntimeParameters::lazyIndexScanIoBatchSize_>(ioBatchSize);
+    auto scan = reader->lazyScan(scanSpec, blocks, {}, cancellationHandle,
+                                 emptyLocatedTriples);
+    IdTable result{2, ad_utility::testing::makeAllocator()};
+    for (const auto& block : scan) {
+      result.insertAtEnd(block);
+    }
+    checkThatTablesAreEqual(inputs.at(0).col1And2_, result);
+
+    // The first and the last block are read separately, only the blocks in
+    // between are read in batches. Each block has three columns (two + the
+    // graph column).
+    const auto& details = scan.details();
+    if (ioBatchSize == 0) {
+      EXPECT_EQ(details.numIoBatches_, 0);
+      EXPECT_EQ(details.numIoBytesRead_, 0);
+      EXPECT_EQ(details.maxIoQueueDepth_, 0);
+    } else {
+      auto numMiddleBlocks = blocks.size() - 2;
+      EXPECT_EQ(details.numIoBatches_,
+                (numMiddleBlocks + ioBatchSize - 1) / ioBatchSize);
+      EXPECT_GT(details.numIoBytesRead_, 0);
+      EXPECT_EQ(details.maxIoQueueDepth_,
+                3 * std::min(ioBatchSize, numMiddleBlocks));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(CompressedRelationReader, abandonLazyScanWithBatchedReads) {
+  std::vector<RelationInput> inputs{RelationInput{42, {}}};
+  for (int i = 0; i < 2000; ++i) {
+    inputs.at(0).col1And2_.push_back({i, i + 1});
+  }
+  auto [filename, cleanup] = testFilenameWithCleanup();
+  auto [blocks, metaData, reader] =
+      writeAndOpenRelations(inputs, filename, 237_B);
+  ASSERT_GT(blocks.size(), 20);
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  ScanSpecification scanSpec{V(42), std::nullopt, std::nullopt};
+
+  // Stop consuming the scan after the first of the batched blocks (e.g.
+  // because of a LIMIT) while the producer threads are still reading. The
+  // destruction of the scan must not destroy the batched reader before these
+  // threads have been joined (this is checked by the sanitizers).
+  auto batchSize =
+      setRuntimeParameterForTest<&RuntimeParameters::lazyIndexScanIoBatchSize_>(
+          2);
+  auto numThreads =
+      setRuntimeParameterForTest<&RuntimeParameters::lazyIndexScanNumThreads_>(
+          4);
+  for (size_t numBlocksToConsume : {1, 2, 3}) {
+    // The scan is destroyed at the end of each iteration.
+    auto scan = reader->lazyScan(scanSpec, blocks, {}, cancellationHandle,
+                                 emptyLocatedTriples);
+    size_t numConsumed = 0;
+    for (const auto& block : scan) {
+      EXPECT_FALSE(block.empty());
+      if (++numConsumed == numBlocksToConsume) {
+        break;
+      }
+    }
+    EXPECT_EQ(numConsumed, numBlocksToConsume);
+  }
+}
+
 // _____________________________________________________________________________
 TEST(CompressedRelationReader, onlyRequestingObjectPatternsWorks) {
   // Regression test for an issue introduced in
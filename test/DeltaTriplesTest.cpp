@@ -511,7 +511,123 @@ TEST_F(DeltaTriplesTest, insertTriplesAndDeleteTriples) {
                   {iri("<other>"), iri("@es@<a>"), lit("\"def\"@es")}}));
 }
 
+// The changes of the delta triples are tracked for the `PredicateStatistics`.
+TEST_F(DeltaTriplesTest, predicateStatisticsDelta) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  DeltaTriples deltaTriples(testQec->getIndex());
+  auto& index = testQec->getIndex();
+  auto& localVocab = deltaTriples.localVocab();
+  auto getEntry = [&deltaTriples](Id predicate) {
+    return deltaTriples.getLocatedTriplesSharedStateReference()
+        ->predicateStatisticsDelta_.getEntry(predicate);
+  };
+  auto predicate = makeIdTriples(index, localVocab, {"<a> <UPP> <A>"})
+                       .at(0)
+                       .ids()
+                       .at(1);
+  EXPECT_EQ(getEntry(predicate), nullptr);
+
+  deltaTriples.insertTriples(
+      cancellationHandle,
+      makeIdTriples(index, localVocab,
+                    {"<a> <UPP> <A>", "<b> <UPP> <B>", "<c> <UPP> <A>"}));
+  ASSERT_NE(getEntry(predicate), nullptr);
+  EXPECT_EQ(getEntry(predicate)->numTriples_, 3);
+  EXPECT_NEAR(getEntry(predicate)->insertedObjects_.estimate(), 2.0, 0.1);
+
+  // Inserting the same triple again doesn't change anything.
+  deltaTriples.insertTriples(
+      cancellationHandle, makeIdTriples(index, localVocab, {"<a> <UPP> <A>"}));
+  EXPECT_EQ(getEntry(predicate)->numTriples_, 3);
+
+  deltaTriples.deleteTriples(
+      cancellationHandle, makeIdTriples(index, localVocab, {"<a> <UPP> <A>"}));
+  EXPECT_EQ(getEntry(predicate)->numTriples_, 2);
+
+  // The snapshots contain the state at the time of their creation.
+  auto snapshot = deltaTriples.getLocatedTriplesSharedStateCopy();
+  deltaTriples.clear();
+  EXPECT_EQ(getEntry(predicate), nullptr);
+  const auto* snapshotEntry =
+      snapshot->predicateStatisticsDelta_.getEntry(predicate);
+  ASSERT_NE(snapshotEntry, nullptr);
+  EXPECT_EQ(snapshotEntry->numTriples_, 2);
+}
+
 // Test the rewriting of local vocab entries and blank nodes.
+// The permutations are located and added concurrently, which gives the same
+// located triples as the sequential processing and keeps the traces of the
+// individual permutations.
+TEST_F(DeltaTriplesTest, insertTriplesWithMultipleThreads) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  // All the located triples of the permutation in the order of the blocks.
+  auto allLocatedTriples = [](const DeltaTriples& deltaTriples,
+                              Permutation::Enum permutation) {
+    const auto& locatedTriples =
+        deltaTriples.getLocatedTriplesForPermutation(permutation);
+    std::vector<LocatedTriple> result;
+    for (size_t block = 0; result.size() < locatedTriples.numTriples();
+         ++block) {
+      auto updates = locatedTriples.getUpdatesIfPresent(block);
+      if (updates.has_value()) {
+        ql::ranges::copy(updates.value(), std::back_inserter(result));
+      }
+      AD_CORRECTNESS_CHECK(block < 1000);
+    }
+    return result;
+  };
+  // Insert either four triples or `LocatedTriple::minNumTriplesPerThread`
+  // triples that differ only in the object. Updates with fewer triples are
+  // always processed sequentially.
+  auto insert = [&](DeltaTriples& deltaTriples, size_t numThreads,
+                    bool large, ad_utility::timer::TimeTracer& tracer) {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::updateLocateNumThreads_>(numThreads);
+    auto triples =
+        makeIdTriples(testQec->getIndex(), deltaTriples.localVocab(),
+                      {"<A> <B> <C>", "<A> <B> <D>", "<B> <C> <A>",
+                       "<D> <E> <F>"});
+    if (large) {
+      auto ids = triples.at(0).ids();
+      triples.clear();
+      for (size_t i = 0; i < LocatedTriple::minNumTriplesPerThread; ++i) {
+        ids[2] = Id::makeFromInt(static_cast<int64_t>(i));
+        triples.emplace_back(ids);
+      }
+    }
+    deltaTriples.insertTriples(cancellationHandle, std::move(triples), tracer);
+  };
+
+  for (bool large : {false, true}) {
+    size_t numTriples = large ? LocatedTriple::minNumTriplesPerThread : 4;
+    DeltaTriples sequential(testQec->getIndex());
+    insert(sequential, 1, large, ad_utility::timer::DEFAULT_TIME_TRACER);
+    for (size_t numThreads : {2, 6, 32}) {
+      DeltaTriples parallel(testQec->getIndex());
+      ad_utility::timer::TimeTracer tracer{"insert"};
+      insert(parallel, numThreads, large, tracer);
+      tracer.endTrace("insert");
+      EXPECT_THAT(parallel, NumTriples(numTriples, 0, numTriples));
+      for (auto permutation : Permutation::ALL) {
+        EXPECT_EQ(allLocatedTriples(parallel, permutation),
+                  allLocatedTriples(sequential, permutation));
+      }
+      auto permutationTraces =
+          testing::AllOf(HasKey("total"), HasKey("PSO"), HasKey("POS"),
+                         HasKey("SPO"), HasKey("SOP"), HasKey("OPS"),
+                         HasKey("OSP"));
+      EXPECT_THAT(tracer.getJSONShort(),
+                  HasKeyMatching(
+                      "insert",
+                      HasKeyMatching("externalPermutation",
+                                     HasKeyMatching("locatedAndAdd",
+                                                    permutationTraces))));
+    }
+  }
+}
+
 TEST_F(DeltaTriplesTest, rewriteLocalVocabEntriesAndBlankNodes) {
   // Create a triple with a new local vocab entry and a new blank node. Use the
   // same new blank node twice (as object ID and graph ID, not important) so
@@ -690,6 +806,177 @@ TEST_F(DeltaTriplesTest, DeltaTriplesManager) {
   auto deltaImpl = deltaTriplesManager.deltaTriples_.rlock();
   EXPECT_THAT(*deltaImpl, NumTriples(numThreads + 1, 2 * numThreads + 1,
                                      3 * numThreads + 2));
+
+  // The counts of the current snapshot are available without a lock.
+  auto counts = deltaTriplesManager.getCurrentCounts();
+  EXPECT_EQ(counts.triplesInserted_, deltaImpl->numInserted());
+  EXPECT_EQ(counts.triplesDeleted_, deltaImpl->numDeleted());
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, DeltaTriplesManagerGroupCommit) {
+  auto& index = testQec->getIndex();
+  DeltaTriplesManager deltaTriplesManager(index);
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  LocalVocab localVocab;
+  auto insert = [&](const std::string& triple)
+      -> std::function<DeltaTriplesCount(DeltaTriples&)> {
+    return [&cancellationHandle,
+            triples = makeIdTriples(index, localVocab, {triple})](
+               DeltaTriples& deltaTriples) {
+      deltaTriples.insertTriples(cancellationHandle, triples);
+      return deltaTriples.getCounts();
+    };
+  };
+  auto numTriplesInSnapshot = [&deltaTriplesManager]() {
+    return deltaTriplesManager.getCurrentLocatedTriplesSharedState()
+        ->getLocatedTriplesForPermutation<false>(Permutation::SPO)
+        .numTriples();
+  };
+
+  auto snapshotBefore =
+      deltaTriplesManager.getCurrentLocatedTriplesSharedState();
+  auto first = deltaTriplesManager.enqueueForGroupCommit(insert("<A> <B> <C>"));
+  // An operation that throws after it has changed the delta triples.
+  auto failing = deltaTriplesManager.enqueueForGroupCommit(
+      std::function<void(DeltaTriples&)>{
+          [&cancellationHandle,
+           inserted = makeIdTriples(index, localVocab, {"<A> <B> <X>"}),
+           deleted = makeIdTriples(index, localVocab, {"<A> <B> <C>"})](
+              DeltaTriples& deltaTriples) {
+            deltaTriples.insertTriples(cancellationHandle, inserted);
+            deltaTriples.deleteTriples(cancellationHandle, deleted);
+            throw std::runtime_error("This update failed");
+          }});
+  auto second =
+      deltaTriplesManager.enqueueForGroupCommit(insert("<A> <B> <D>"));
+  // Nothing is executed before the commit.
+  EXPECT_EQ(first.wait_for(std::chrono::milliseconds{0}),
+            std::future_status::timeout);
+  EXPECT_EQ(deltaTriplesManager.getCurrentLocatedTriplesSharedState(),
+            snapshotBefore);
+
+  // All operations are committed together, each gets its own result and the
+  // changes of the failing operation are rolled back.
+  ad_utility::timer::TimeTracer tracer{"commit"};
+  deltaTriplesManager.commitGroup(std::chrono::milliseconds{0}, tracer);
+  tracer.endTrace("commit");
+  EXPECT_EQ(first.get().triplesInserted_, 1);
+  AD_EXPECT_THROW_WITH_MESSAGE(failing.get(),
+                               testing::HasSubstr("This update failed"));
+  auto secondCounts = second.get();
+  EXPECT_EQ(secondCounts.triplesInserted_, 2);
+  EXPECT_EQ(secondCounts.triplesDeleted_, 0);
+  EXPECT_EQ(numTriplesInSnapshot(), 2);
+  EXPECT_THAT(tracer.getJSONShort(),
+              HasKeyMatching("commit", testing::AllOf(
+                                           HasKey("groupCommitWindow"),
+                                           HasKey("operations"),
+                                           HasKey("metadataUpdateForSnapshot"),
+                                           HasKey("snapshotCreation"))));
+
+  // Without enqueued operations, `commitGroup` returns immediately and doesn't
+  // create a new snapshot.
+  auto snapshotAfter =
+      deltaTriplesManager.getCurrentLocatedTriplesSharedState();
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  deltaTriplesManager.commitGroup(std::chrono::hours{1});
+  EXPECT_LT(timer.msecs(), std::chrono::minutes{1});
+  EXPECT_EQ(deltaTriplesManager.getCurrentLocatedTriplesSharedState(),
+            snapshotAfter);
+
+  // Concurrent operations within the window are committed by whichever thread
+  // commits first, the other threads only find their results.
+  static constexpr size_t numThreads = 8;
+  std::vector<std::future<DeltaTriplesCount>> results(numThreads);
+  {
+    std::vector<ad_utility::JThread> threads;
+    for (size_t i = 0; i < numThreads; ++i) {
+      results[i] = deltaTriplesManager.enqueueForGroupCommit(
+          insert(absl::StrCat("<A> <B> <E", i, ">")));
+      threads.emplace_back([&deltaTriplesManager]() {
+        deltaTriplesManager.commitGroup(std::chrono::milliseconds{20});
+      });
+    }
+  }
+  for (auto& result : results) {
+    EXPECT_GT(result.get().triplesInserted_, 2);
+  }
+  EXPECT_EQ(numTriplesInSnapshot(), 2 + numThreads);
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, rollBackOperationOfGroup) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto& index = testQec->getIndex();
+  DeltaTriples deltaTriples(index);
+  LocalVocab localVocab;
+  auto triples = [&](const std::vector<std::string>& turtles) {
+    return makeIdTriples(index, localVocab, turtles);
+  };
+  // All the located triples of all the permutations (normal and internal).
+  auto allLocatedTriples = [&deltaTriples]() {
+    auto state = deltaTriples.getLocatedTriplesSharedStateReference();
+    std::vector<std::vector<LocatedTriple>> result;
+    auto addPermutation = [&result](const LocatedTriplesPerBlock& ltpb) {
+      auto& triplesOfPermutation = result.emplace_back();
+      for (size_t block = 0; triplesOfPermutation.size() < ltpb.numTriples();
+           ++block) {
+        if (auto updates = ltpb.getUpdatesIfPresent(block)) {
+          ql::ranges::copy(updates.value(),
+                           std::back_inserter(triplesOfPermutation));
+        }
+        AD_CORRECTNESS_CHECK(block < 1000);
+      }
+    };
+    ql::ranges::for_each(state->locatedTriplesPerBlock_, addPermutation);
+    ql::ranges::for_each(state->internalLocatedTriplesPerBlock_,
+                         addPermutation);
+    return result;
+  };
+  auto predicateB = triples({"<A> <B> <C>"}).at(0).ids()[1];
+  auto numTriplesOfB = [&deltaTriples, predicateB]() {
+    auto entry = deltaTriples.getLocatedTriplesSharedStateReference()
+                     ->predicateStatisticsDelta_.getEntry(predicateB);
+    return entry == nullptr ? int64_t{0} : entry->numTriples_;
+  };
+
+  // A change before the group and a committed operation of the group.
+  deltaTriples.insertTriples(cancellationHandle,
+                             triples({"<A> <B> <C>", "<a> <b> \"x\"@en"}));
+  deltaTriples.beginGroup();
+  deltaTriples.insertTriples(cancellationHandle, triples({"<A> <B> <D>"}));
+  deltaTriples.commitOperationOfGroup();
+  EXPECT_THAT(deltaTriples, NumTriples(3, 0, 3, 2, 0));
+  auto locatedTriplesBefore = allLocatedTriples();
+  EXPECT_EQ(numTriplesOfB(), 2);
+
+  // An operation that inserts and deletes triples (some of them were inserted
+  // before, some of them only add internal triples) is rolled back.
+  deltaTriples.insertTriples(cancellationHandle,
+                             triples({"<A> <B> <X>", "<c> <d> \"y\"@de"}));
+  deltaTriples.deleteTriples(cancellationHandle,
+                             triples({"<A> <B> <C>", "<A> <B> <D>",
+                                      "<A> <B> <Z>", "<a> <b> \"x\"@en"}));
+  EXPECT_THAT(deltaTriples, NumTriples(2, 4, 6, 3, 1));
+  EXPECT_EQ(numTriplesOfB(), 0);
+  deltaTriples.rollBackOperationOfGroup();
+  EXPECT_THAT(deltaTriples, NumTriples(3, 0, 3, 2, 0));
+  EXPECT_EQ(allLocatedTriples(), locatedTriplesBefore);
+  EXPECT_EQ(numTriplesOfB(), 2);
+
+  // Rolling back an operation without changes changes nothing.
+  deltaTriples.rollBackOperationOfGroup();
+  EXPECT_EQ(allLocatedTriples(), locatedTriplesBefore);
+
+  // The operations after a rollback work as usual.
+  deltaTriples.deleteTriples(cancellationHandle, triples({"<A> <B> <C>"}));
+  deltaTriples.commitOperationOfGroup();
+  deltaTriples.endGroup();
+  EXPECT_THAT(deltaTriples, NumTriples(2, 1, 3, 2, 0));
+  EXPECT_EQ(numTriplesOfB(), 1);
 }
 
 // _____________________________________________________________________________
@@ -935,6 +1222,205 @@ TEST_F(DeltaTriplesTest, storeAndRestoreData) {
   }
 }
 
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, writeAheadLog) {
+  using Batch = DeltaTriplesWriteAheadLog::Batch;
+  // The check value of the CRC-32 (see e.g. the catalogue of CRC algorithms).
+  EXPECT_EQ(DeltaTriplesWriteAheadLog::crc32("123456789"), 0xCBF43926u);
+
+  auto tmpFile = std::filesystem::temp_directory_path() / "testWriteAheadLog";
+  std::filesystem::remove(tmpFile);
+  absl::Cleanup cleanup{[&tmpFile]() { std::filesystem::remove(tmpFile); }};
+  DeltaTriplesWriteAheadLog writeAheadLog{tmpFile};
+  LocalVocab localVocab;
+  EXPECT_EQ(writeAheadLog.sizeInBytes(), 0);
+  EXPECT_TRUE(writeAheadLog.read(localVocab, testQec->getIndex().getImpl())
+                  .empty());
+
+  auto& index = testQec->getIndex().getImpl();
+  auto triples1 = makeIdTriples(index, localVocab, {"<a> <b> <new>"});
+  auto triples2 =
+      makeIdTriples(index, localVocab, {"<a> <b> <c>", "<a> <other> 42"});
+  writeAheadLog.append(Batch{{true, triples1}});
+  writeAheadLog.append(Batch{{false, triples2}, {true, triples2}});
+  auto validSize = writeAheadLog.sizeInBytes();
+
+  // Read the batches, the local vocab entries are added to a new local vocab.
+  auto checkBatches = [&]() {
+    LocalVocab newVocab;
+    auto batches = writeAheadLog.read(newVocab, index);
+    ASSERT_EQ(batches.size(), 2);
+    ASSERT_EQ(batches.at(0).size(), 1);
+    EXPECT_TRUE(batches.at(0).at(0).isInsertion_);
+    ASSERT_EQ(batches.at(0).at(0).triples_.size(), 1);
+    auto object = batches.at(0).at(0).triples_.at(0).ids().at(2);
+    ASSERT_EQ(object.getDatatype(), Datatype::LocalVocabIndex);
+    EXPECT_EQ(object.getLocalVocabIndex()->toStringRepresentation(), "<new>");
+    EXPECT_TRUE(
+        newVocab.getIndexOrNullopt(*object.getLocalVocabIndex()).has_value());
+    ASSERT_EQ(batches.at(1).size(), 2);
+    EXPECT_FALSE(batches.at(1).at(0).isInsertion_);
+    EXPECT_EQ(batches.at(1).at(0).triples_, triples2);
+    EXPECT_TRUE(batches.at(1).at(1).isInsertion_);
+    EXPECT_EQ(batches.at(1).at(1).triples_, triples2);
+  };
+  checkBatches();
+
+  // An incomplete record at the end (from an interrupted write) is discarded
+  // and removed from the file.
+  {
+    std::ofstream out{tmpFile, std::ios::binary | std::ios::app};
+    out << "incomplete";
+  }
+  EXPECT_GT(writeAheadLog.sizeInBytes(), validSize);
+  checkBatches();
+  EXPECT_EQ(writeAheadLog.sizeInBytes(), validSize);
+
+  // A record with a wrong checksum is discarded, too.
+  writeAheadLog.append(Batch{{true, triples1}});
+  std::filesystem::resize_file(tmpFile, writeAheadLog.sizeInBytes() - 1);
+  {
+    std::ofstream out{tmpFile, std::ios::binary | std::ios::app};
+    out << 'x';
+  }
+  checkBatches();
+  EXPECT_EQ(writeAheadLog.sizeInBytes(), validSize);
+
+  writeAheadLog.remove();
+  EXPECT_FALSE(std::filesystem::exists(tmpFile));
+
+  // An append that fails throws and leaves no (partial) record behind.
+  DeltaTriplesWriteAheadLog unwritableLog{tmpFile / "notADirectory"};
+  std::ofstream{tmpFile} << "a file, not a directory";
+  AD_EXPECT_THROW_WITH_MESSAGE(unwritableLog.append(Batch{{true, triples1}}),
+                               ::testing::HasSubstr("Could not append"));
+  EXPECT_EQ(unwritableLog.sizeInBytes(), 0);
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, storeAndRestoreWithWriteAheadLog) {
+  auto tmpFile = std::filesystem::temp_directory_path() / "testDeltaTriplesWal";
+  auto walFile = tmpFile;
+  walFile += ".wal";
+  auto removeFiles = [&tmpFile, &walFile]() {
+    std::filesystem::remove(tmpFile);
+    std::filesystem::remove(walFile);
+  };
+  removeFiles();
+  absl::Cleanup cleanup{removeFiles};
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto& index = testQec->getIndex().getImpl();
+  {
+    DeltaTriples deltaTriples{testQec->getIndex()};
+    deltaTriples.setPersists(tmpFile);
+    deltaTriples.readFromDisk();
+    LocalVocab localVocab;
+    auto triples =
+        makeIdTriples(index, localVocab, {"<a> <b> <new>", "<x> <y> <z>"});
+    // The object of the second triple is a new blank node.
+    triples.at(1).ids().at(2) = Id::makeFromBlankNodeIndex(
+        localVocab.getBlankNodeIndex(index.getBlankNodeManager()));
+    deltaTriples.insertTriples(cancellationHandle, std::move(triples));
+    deltaTriples.writeChangesToDisk();
+    // Only the write-ahead log was written, no snapshot.
+    EXPECT_FALSE(std::filesystem::exists(tmpFile));
+    EXPECT_TRUE(std::filesystem::exists(walFile));
+    auto walSize = std::filesystem::file_size(walFile);
+
+    // Nothing has changed, so nothing is written.
+    deltaTriples.writeChangesToDisk();
+    EXPECT_EQ(std::filesystem::file_size(walFile), walSize);
+
+    deltaTriples.deleteTriples(
+        cancellationHandle,
+        makeIdTriples(index, localVocab, {"<a> <b> <c>", "<a> <b> <new>"}));
+    deltaTriples.writeChangesToDisk();
+    EXPECT_GT(std::filesystem::file_size(walFile), walSize);
+    EXPECT_THAT(deltaTriples, NumTriples(1, 2, 3));
+  }
+  {
+    DeltaTriples deltaTriples{testQec->getIndex()};
+    deltaTriples.setPersists(tmpFile);
+    deltaTriples.readFromDisk();
+    EXPECT_EQ(deltaTriples.numInserted(), 1);
+    EXPECT_EQ(deltaTriples.numDeleted(), 2);
+    // The blank node was mapped to a blank node of the restored local vocab.
+    auto object = deltaTriples.triplesToHandlesNormal_.triplesInserted_.begin()
+                      ->first.ids()
+                      .at(2);
+    ASSERT_EQ(object.getDatatype(), Datatype::BlankNodeIndex);
+    EXPECT_TRUE(deltaTriples.localVocab().isBlankNodeIndexContained(
+        object.getBlankNodeIndex()));
+    // The replayed log was compacted into a snapshot.
+    EXPECT_TRUE(std::filesystem::exists(tmpFile));
+    EXPECT_FALSE(std::filesystem::exists(walFile));
+
+    // After `clear`, a snapshot has to be written.
+    deltaTriples.clear();
+    deltaTriples.writeChangesToDisk();
+    EXPECT_FALSE(std::filesystem::exists(walFile));
+  }
+  {
+    DeltaTriples deltaTriples{testQec->getIndex()};
+    deltaTriples.setPersists(tmpFile);
+    deltaTriples.readFromDisk();
+    EXPECT_THAT(deltaTriples, NumTriples(0, 0, 0));
+  }
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, writeAheadLogCompaction) {
+  auto tmpFile =
+      std::filesystem::temp_directory_path() / "testDeltaTriplesCompaction";
+  auto walFile = tmpFile;
+  walFile += ".wal";
+  auto removeFiles = [&tmpFile, &walFile]() {
+    std::filesystem::remove(tmpFile);
+    std::filesystem::remove(walFile);
+  };
+  removeFiles();
+  absl::Cleanup cleanup{removeFiles};
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto& index = testQec->getIndex().getImpl();
+  auto thresholdCleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::updateWalCompactionThreshold_>(
+      ad_utility::MemorySize::bytes(0));
+  {
+    DeltaTriples deltaTriples{testQec->getIndex()};
+    deltaTriples.setPersists(tmpFile);
+    deltaTriples.readFromDisk();
+    // The empty snapshot is smaller than each record of the log, so each
+    // write starts a compaction.
+    deltaTriples.writeToDisk();
+    auto emptySnapshotSize = std::filesystem::file_size(tmpFile);
+    LocalVocab localVocab;
+    deltaTriples.insertTriples(
+        cancellationHandle,
+        makeIdTriples(index, localVocab, {"<a> <b> <new>", "<x> <y> <z>"}));
+    deltaTriples.writeChangesToDisk();
+    deltaTriples.waitForCompaction();
+    EXPECT_FALSE(std::filesystem::exists(walFile));
+    EXPECT_GT(std::filesystem::file_size(tmpFile), emptySnapshotSize);
+
+    // Now the snapshot is larger than the next record, which is only appended
+    // to the log.
+    deltaTriples.deleteTriples(
+        cancellationHandle, makeIdTriples(index, localVocab, {"<a> <b> <c>"}));
+    deltaTriples.writeChangesToDisk();
+    deltaTriples.waitForCompaction();
+    EXPECT_TRUE(std::filesystem::exists(walFile));
+  }
+  {
+    DeltaTriples deltaTriples{testQec->getIndex()};
+    deltaTriples.setPersists(tmpFile);
+    deltaTriples.readFromDisk();
+    EXPECT_EQ(deltaTriples.numInserted(), 2);
+    EXPECT_EQ(deltaTriples.numDeleted(), 1);
+  }
+}
+
 // _____________________________________________________________________________
 TEST_F(DeltaTriplesTest, copyLocalVocab) {
   using namespace ::testing;
@@ -270,18 +270,25 @@ TEST(ExportIds, idsToStringAndTypeBatchMatchesIndividualLookups) {
       Id::makeUndefined(),
   };
 
-  // `idsToStringAndType` requires the input to be sorted by `ValueId`.
-  ql::ranges::sort(ids);
-
-  auto batchResults = ql::exportIds::idsToStringAndType(
-      index, ql::span<const Id>{ids}, localVocab);
+  auto testWithIds = [&](const std::vector<Id>& ids) {
+    auto batchResults = ql::exportIds::idsToStringAndType(
+        index, ql::span<const Id>{ids}, localVocab);
+
+    ASSERT_EQ(batchResults.size(), ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+      EXPECT_EQ(batchResults[i],
+                ql::exportIds::idToStringAndType(index, ids[i], localVocab))
+          << "Mismatch at index " << i;
+    }
+  };
+  testWithIds(ids);
 
-  ASSERT_EQ(batchResults.size(), ids.size());
-  for (size_t i = 0; i < ids.size(); ++i) {
-    EXPECT_EQ(batchResults[i],
-              ql::exportIds::idToStringAndType(index, ids[i], localVocab))
-        << "Mismatch at index " << i;
-  }
+  // The input may be sorted, and it may also contain duplicates.
+  ids.push_back(getId("<p>"));
+  ids.push_back(getId("<s>"));
+  testWithIds(ids);
+  ql::ranges::sort(ids);
+  testWithIds(ids);
 }
 
 // _____________________________________________________________________________
@@ -1413,7 +1413,8 @@ TEST(ExportQueryExecutionTrees, LimitOffset) {
   <result>
     <binding name="s"><uri>g</uri></binding>
   </result>)" + xmlTrailer;
-  // The `OrderBy` operation does not handle the limit.
+  // The `OrderBy` operation only computes the first rows, the limit and
+  // offset are applied afterwards.
   std::string_view objectQuery0 =
       "SELECT ?s WHERE { ?s ?p ?o } ORDER BY ?s LIMIT 2 OFFSET 1";
   // The `IndexScan` operation handles the limit.
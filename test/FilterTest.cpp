@@ -2,6 +2,7 @@
 //   Chair of Algorithms and Data Structures.
 //   Author: Robin Textor-Falconi <textorr@informatik.uni-freiburg.de>
 
+#include <absl/strings/str_cat.h>
 #include <gmock/gmock.h>
 
 #include "./PrefilterExpressionTestHelpers.h"
@@ -266,3 +267,89 @@ TEST(Filter, clone) {
   EXPECT_THAT(filter, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), filter.getDescriptor());
 }
+
+// _____________________________________________________________________________
+TEST(Filter, morselParallelEvaluation) {
+  using namespace makeSparqlExpression;
+  auto cleanup1 = setRuntimeParameterForTest<
+      &RuntimeParameters::expressionEvaluationNumThreads_>(4);
+  auto cleanup2 = setRuntimeParameterForTest<
+      &RuntimeParameters::expressionEvaluationMorselSize_>(3);
+  QueryExecutionContext* qec = ad_utility::testing::getQec();
+  auto I = ad_utility::testing::IntId;
+  IdTable input{2, ad_utility::makeUnlimitedAllocator<Id>()};
+  IdTable expected{2, ad_utility::makeUnlimitedAllocator<Id>()};
+  for (int64_t i = 0; i < 20; ++i) {
+    input.push_back({I(i), asBool(i % 3 == 0)});
+    if (i >= 5 && i % 3 == 0) {
+      expected.push_back({I(i), asBool(true)});
+    }
+  }
+  auto varX = Variable{"?x"};
+  auto varB = Variable{"?b"};
+  std::vector<std::optional<Variable>> variables{varX, varB};
+
+  // Evaluate the filter for a fully materialized and for a lazy input. The
+  // input is sorted by `?x`, so `!(?x < 5)` is evaluated using binary search
+  // on each morsel.
+  for (bool lazyInput : {false, true}) {
+    qec->getQueryTreeCache().clearAll();
+    std::shared_ptr<Operation> values;
+    if (lazyInput) {
+      std::vector<IdTable> inputTables;
+      inputTables.push_back(input.clone());
+      values = std::make_shared<ValuesForTesting>(
+          qec, std::move(inputTables), variables, false,
+          std::vector<ColumnIndex>{0});
+    } else {
+      values = std::make_shared<ValuesForTesting>(
+          qec, input.clone(), variables, false, std::vector<ColumnIndex>{0});
+    }
+    auto expr = andSprqlExpr(
+        notSprqlExpr(ltSprql(varX, I(5))),
+        std::make_unique<sparqlExpression::VariableExpression>(varB));
+    Filter filter{qec, std::make_shared<QueryExecutionTree>(qec, values),
+                  {std::move(expr), "!(?x < 5) && ?b"}};
+    auto result = filter.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+    ASSERT_TRUE(result->isFullyMaterialized());
+    EXPECT_EQ(result->idTable(), expected);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(Filter, sizeEstimateFromPredicateStatistics) {
+  using namespace makeFilterExpression;
+  using namespace makeSparqlExpression;
+  using namespace ad_utility::testing;
+  // The predicate `<p>` has enough triples for the `PredicateStatistics`, the
+  // predicate `<q>` doesn't.
+  std::string kg;
+  for (size_t i = 0; i < 2'000; ++i) {
+    kg += absl::StrCat("<s", i, "> <p> ", i, " .\n");
+  }
+  for (size_t i = 0; i < 100; ++i) {
+    kg += absl::StrCat("<s", i, "> <q> ", i, " .\n");
+  }
+  QueryExecutionContext* qec = ad_utility::testing::getQec(kg);
+  auto z = Variable{"?z"};
+  auto estimate = [qec](const TripleComponent& predicate,
+                        std::unique_ptr<sparqlExpression::SparqlExpression>
+                            expression) {
+    auto subtree = ad_utility::makeExecutionTree<IndexScan>(
+        qec, Permutation::PSO, SparqlTripleSimple{Variable{"?x"}, predicate,
+                                                  Variable{"?z"}});
+    Filter filter{qec, subtree, {std::move(expression), "Expression ?z"}};
+    return filter.getSizeEstimate();
+  };
+  EXPECT_NEAR(estimate(iri("<p>"), ltSprql(z, IntId(500))), 500, 50);
+  // The constant can also be on the left side.
+  EXPECT_NEAR(estimate(iri("<p>"), ltSprql(IntId(1'500), z)), 500, 50);
+  EXPECT_NEAR(estimate(iri("<p>"), geSprql(z, DoubleId(100.5))), 1'900, 50);
+  EXPECT_LE(estimate(iri("<p>"), eqSprql(z, IntId(42))), 5);
+  // A comparison with values of another datatype has (almost) no results.
+  EXPECT_LE(estimate(iri("<p>"), ltSprql(z, VocabId(0))), 10);
+
+  // Without statistics, the default estimate (which assumes that a comparison
+  // keeps 1/50 of the input) is used.
+  EXPECT_EQ(estimate(iri("<q>"), ltSprql(z, IntId(500))), 2);
+}
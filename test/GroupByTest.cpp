@@ -553,6 +553,7 @@ TEST_F(GroupByOptimizations, checkIfHashMapOptimizationPossible) {
   auto cleanup =
       setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
           true);
+  qec->clearCacheUnpinnedOnly();
 
   // Top operation must be SORT
   testFailure(variablesOnlyX, aliasesAvgX, validJoinWhenGroupingByX,
@@ -574,6 +575,11 @@ TEST_F(GroupByOptimizations, checkIfHashMapOptimizationPossible) {
   testSuccess(variablesOnlyX, aliasesSumX, subtreeWithSort, sumAggregate);
   testSuccess(variablesOnlyX, aliasesSampleX, subtreeWithSort, sampleAggregate);
 
+  // If the sorted input is already cached, it is used instead.
+  subtreeWithSort->getResult();
+  testFailure(variablesOnlyX, aliasesMaxX, subtreeWithSort, maxAggregate);
+  qec->clearCacheUnpinnedOnly();
+
   // Check details of data structure are correct.
   GroupByImpl groupBy{qec, variablesOnlyX, aliasesAvgX, subtreeWithSort};
   auto optimizedAggregateData =
@@ -670,6 +676,85 @@ TEST_F(GroupByOptimizations, hashMapOptimizationLazyAndMaterializedInputs) {
   runTest(false);
 }
 
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, parallelHashMapOptimization) {
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
+          true);
+  // Unsorted input blocks with the given number of rows. The first column is
+  // the grouped `?x`, the second column `?y` is aggregated.
+  auto makeTables = [](const std::vector<size_t>& blockSizes) {
+    std::vector<IdTable> tables;
+    for (size_t numRows : blockSizes) {
+      IdTable table{2, makeAllocator()};
+      for (size_t i = 0; i < numRows; ++i) {
+        auto value = static_cast<int64_t>((i * 7919) % 100'003);
+        table.push_back(std::array{I(value % 1013), I(value)});
+      }
+      tables.push_back(std::move(table));
+    }
+    return tables;
+  };
+
+  // SELECT ?x (COUNT(?y) as ?count) (SUM(?y) as ?sum) (AVG(?y) as ?avg)
+  // (MIN(?y) as ?min) (MAX(?y) as ?max) (SAMPLE(?y) as ?sample)
+  // (GROUP_CONCAT(?y) as ?concat) WHERE { ... } GROUP BY ?x
+  // Return the result and whether the aggregation was done in parallel.
+  auto computeResult = [this, &makeTables](
+                           size_t numThreads, bool inputIsLazy,
+                           const std::vector<size_t>& blockSizes) {
+    auto cleanupThreads = setRuntimeParameterForTest<
+        &RuntimeParameters::groupByHashMapNumThreads_>(numThreads);
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeTables(blockSizes),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}});
+    auto& values =
+        dynamic_cast<ValuesForTesting&>(*subtree->getRootOperation());
+    values.forceFullyMaterialized() = !inputIsLazy;
+
+    std::vector<Alias> aliases{
+        Alias{makeCountPimpl(varY), Variable{"?count"}},
+        Alias{makeSumPimpl(varY), Variable{"?sum"}},
+        Alias{makeAvgPimpl(varY), Variable{"?avg"}},
+        Alias{makeMinPimpl(varY), Variable{"?min"}},
+        Alias{makeMaxPimpl(varY), Variable{"?max"}},
+        Alias{makeSamplePimpl(varY), Variable{"?sample"}},
+        Alias{makeGroupConcatPimpl(varY), Variable{"?concat"}}};
+    qec->getQueryTreeCache().clearAll();
+    GroupBy groupBy{qec, variablesOnlyX, aliases, std::move(subtree)};
+    auto result = groupBy.computeResultOnlyForTesting();
+    bool isParallel = groupBy.runtimeInfo().details_.contains("numThreads");
+    return std::pair{std::move(result), isParallel};
+  };
+
+  // The small first block is aggregated serially, its groups are moved to the
+  // partitions when the large second block arrives (which is large enough to
+  // be split into several chunks).
+  const std::vector<size_t> blockSizes{
+      1000, 3 * GROUP_BY_HASH_MAP_MIN_ROWS_PER_THREAD + 17, 1000};
+  for (bool inputIsLazy : {false, true}) {
+    auto [expected, expectedIsParallel] =
+        computeResult(1, inputIsLazy, blockSizes);
+    ASSERT_EQ(expected.idTable().numRows(), 1013);
+    EXPECT_FALSE(expectedIsParallel);
+    for (size_t numThreads : {2u, 4u, 7u}) {
+      auto [result, isParallel] =
+          computeResult(numThreads, inputIsLazy, blockSizes);
+      ASSERT_TRUE(result.isFullyMaterialized());
+      EXPECT_TRUE(isParallel);
+      // The values of each group are aggregated in the order of the input, so
+      // also the results of `SAMPLE` and `GROUP_CONCAT` are the same.
+      EXPECT_EQ(result.idTable(), expected.idTable());
+    }
+  }
+
+  // Small inputs are aggregated serially, even with several threads.
+  auto [result, isParallel] = computeResult(
+      4, true, {1000, 2 * GROUP_BY_HASH_MAP_MIN_ROWS_PER_THREAD - 1});
+  EXPECT_FALSE(isParallel);
+  EXPECT_EQ(result.idTable().numRows(), 1013);
+}
+
 // _____________________________________________________________________________
 TEST_F(GroupByOptimizations, correctResultForHashMapOptimizationForCountStar) {
   /* Setup query:
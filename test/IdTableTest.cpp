@@ -1053,6 +1053,29 @@ TEST(IdTable, setColumnSubset) {
   ASSERT_ANY_THROW(t.setColumnSubset(std::vector<ColumnIndex>{1, 2}));
 }
 
+TEST(IdTable, asRowRangeView) {
+  using IntTable = columnBasedIdTable::IdTable<int, 0>;
+  IntTable t{2};
+  for (int i = 0; i < 5; ++i) {
+    t.push_back({i, 10 + i});
+  }
+  auto view = t.asRowRangeView(1, 4);
+  ASSERT_EQ(2, view.numColumns());
+  ASSERT_EQ(3, view.numRows());
+  ASSERT_THAT(view.getColumn(0), ::testing::ElementsAre(1, 2, 3));
+  ASSERT_THAT(view.getColumn(1), ::testing::ElementsAre(11, 12, 13));
+
+  // Views of views are also possible.
+  auto subView = view.asRowRangeView(2, 3);
+  ASSERT_EQ(1, subView.numRows());
+  ASSERT_EQ(13, subView.at(0, 1));
+
+  // Empty ranges are allowed, invalid ones are not.
+  ASSERT_EQ(0, t.asRowRangeView(5, 5).numRows());
+  ASSERT_ANY_THROW(t.asRowRangeView(3, 2));
+  ASSERT_ANY_THROW(t.asRowRangeView(0, 6));
+}
+
 TEST(IdTableStatic, setColumnSubset) {
   using IntTable = columnBasedIdTable::IdTable<int, 3>;
   IntTable t;
@@ -1161,19 +1184,19 @@ TEST(IdTable, shrinkToFit) {
   auto memory = ad_utility::makeAllocationMemoryLeftThreadsafeObject(1_kB);
   IdTable table{2, ad_utility::AllocatorWithLimit<Id>{memory}};
   using namespace ad_utility::memory_literals;
-  ASSERT_EQ(memory.ptr().get()->wlock()->amountMemoryLeft(), 1_kB);
+  ASSERT_EQ(memory.ptr()->amountMemoryLeft(), 1_kB);
   table.reserve(20);
   ASSERT_TRUE(table.empty());
   // 20 rows * 2 columns * 8 bytes per ID were allocated.
-  ASSERT_EQ(memory.ptr().get()->wlock()->amountMemoryLeft(), 680_B);
+  ASSERT_EQ(memory.ptr()->amountMemoryLeft(), 680_B);
   table.emplace_back();
   table.emplace_back();
   ASSERT_EQ(table.numRows(), 2u);
-  ASSERT_EQ(memory.ptr().get()->wlock()->amountMemoryLeft(), 680_B);
+  ASSERT_EQ(memory.ptr()->amountMemoryLeft(), 680_B);
   table.shrinkToFit();
   ASSERT_EQ(table.numRows(), 2u);
   // Now only 2 rows * 2 columns * 8 bytes were allocated.
-  ASSERT_EQ(memory.ptr().get()->wlock()->amountMemoryLeft(), 968_B);
+  ASSERT_EQ(memory.ptr()->amountMemoryLeft(), 968_B);
 }
 
 TEST(IdTable, staticAsserts) {
@@ -331,6 +331,20 @@ TEST(IndexTest, indexIdAndGitHash) {
   ASSERT_EQ(index.getGitShortHash(), "git short hash not set");
 }
 
+// _____________________________________________________________________________
+TEST(IndexTest, indexFingerprintChangesWithEachBuild) {
+  std::string kb = "<a> <b> <c> .";
+  std::string fingerprint =
+      makeTestIndex("indexFingerprint", kb).getIndexFingerprint();
+  EXPECT_FALSE(fingerprint.empty());
+  // Rebuilding the same index yields the same `indexId`, but a different
+  // fingerprint.
+  auto rebuilt = makeTestIndex("indexFingerprint", kb);
+  EXPECT_NE(rebuilt.getIndexFingerprint(), fingerprint);
+  EXPECT_EQ(rebuilt.getIndexId(),
+            makeTestIndex("indexFingerprint", kb).getIndexId());
+}
+
 TEST(IndexTest, scanTest) {
   auto testWithAndWithoutPrefixCompression = [](bool useCompression) {
     using enum Permutation::Enum;
@@ -524,4 +524,27 @@ TYPED_TEST(IoUringManagerTest, fakeHandle) {
 
   EXPECT_THAT(batch.result(), ::testing::ElementsAre("CCCC", "AAAA", "DDDD"));
 }
+
+// The `BatchIoManagerWithFallback` reads correctly, no matter if io_uring is
+// available at runtime or not.
+TEST(BatchIoManagerWithFallback, SingleAndMultipleBatches) {
+  auto [tmp, fd] = makeTempFile("AAAABBBBCCCCDDDD");
+
+  ad_utility::BatchIoManagerWithFallback manager(2);
+#ifndef QLEVER_HAS_IO_URING
+  EXPECT_FALSE(manager.usesIoUring());
+#endif
+
+  ReadBatchForTesting batch1;
+  batch1.add({{8, 4}, {0, 4}, {12, 4}});
+  ReadBatchForTesting batch2;
+  batch2.add({{4, 8}});
+  auto handle1 = batch1.submitTo(manager, fd);
+  auto handle2 = batch2.submitTo(manager, fd);
+  manager.wait(handle2);
+  manager.wait(handle1);
+
+  EXPECT_THAT(batch1.result(), ::testing::ElementsAre("CCCC", "AAAA", "DDDD"));
+  EXPECT_THAT(batch2.result(), ::testing::ElementsAre("BBBBCCCC"));
+}
 }  // namespace
@@ -229,6 +229,34 @@ TEST(JoinTest, joinTest) {
   runTestCasesForAllJoinAlgorithms(createJoinTestSet());
 };
 
+// `Join::hashJoin` uses the implementation of the `HashJoin` operation, so an
+// UNDEF value in the join column matches every value (like in `Join::join`),
+// and not only other UNDEF values.
+TEST(JoinTest, hashJoinWithUndef) {
+  auto U = Id::makeUndefined();
+  auto a = makeIdTableFromVector({{U, 10}, {1, 11}, {2, 12}});
+  auto b = makeIdTableFromVector({{1, 20}, {U, 21}});
+  IdTable result{3, makeAllocator()};
+  Join::hashJoin(a, 0, b, 0, &result);
+  // The result contains the defined value of the join column if there is one.
+  auto expected = makeIdTableFromVector({{1, 10, 20},
+                                         {U, 10, 21},
+                                         {1, 11, 20},
+                                         {1, 11, 21},
+                                         {2, 12, 21}});
+  compareIdTableWithExpectedContent(result, expected);
+
+  // The same result if the other table is the larger one.
+  auto expectedSwapped = makeIdTableFromVector({{1, 20, 10},
+                                                {U, 21, 10},
+                                                {1, 20, 11},
+                                                {1, 21, 11},
+                                                {2, 21, 12}});
+  IdTable resultSwapped{3, makeAllocator()};
+  Join::hashJoin(b, 0, a, 0, &resultSwapped);
+  compareIdTableWithExpectedContent(resultSwapped, expectedSwapped);
+}
+
 // Several helpers for the test cases below.
 namespace {
 
@@ -157,7 +157,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
               locatedTriplesAre(
                   {{0, {LT1, LT2, LT3}}, {1, {LT4, LT5}}, {3, {LT6, LT7}}}));
 
-  auto handles = locatedTriplesPerBlock.add(std::vector{LT8, LT9});
+  locatedTriplesPerBlock.add(std::vector{LT8, LT9});
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(4));
   EXPECT_THAT(locatedTriplesPerBlock, numTriplesTotal(9));
@@ -170,7 +170,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
                                  {2, {LT8}},
                                  {3, {LT6, LT7, LT9}}}));
 
-  locatedTriplesPerBlock.erase(2, handles[0]);
+  locatedTriplesPerBlock.erase(2, LT8.triple_);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(3));
@@ -184,7 +184,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
           {{0, {LT1, LT2, LT3}}, {1, {LT4, LT5}}, {3, {LT6, LT7, LT9}}}));
 
   // Erasing in a block that does not exist, raises an exception.
-  EXPECT_THROW(locatedTriplesPerBlock.erase(100, handles[1]),
+  EXPECT_THROW(locatedTriplesPerBlock.erase(100, LT9.triple_),
                ad_utility::Exception);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
@@ -199,7 +199,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
       locatedTriplesAre(
           {{0, {LT1, LT2, LT3}}, {1, {LT4, LT5}}, {3, {LT6, LT7, LT9}}}));
 
-  locatedTriplesPerBlock.erase(3, handles[1]);
+  locatedTriplesPerBlock.erase(3, LT9.triple_);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(3));
@@ -221,6 +221,73 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
   EXPECT_THAT(locatedTriplesPerBlock, locatedTriplesAre({}));
 }
 
+// Test adding and erasing batches of located triples, and that copies of a
+// `LocatedTriplesPerBlock` are not affected by changes of the original.
+TEST_F(LocatedTriplesTest, addAndEraseBatchesAndCopyOnWrite) {
+  using LT = LocatedTriple;
+  auto blockIs = [](size_t blockIndex, const LocatedTriples& expected)
+      -> testing::Matcher<const LocatedTriplesPerBlock&> {
+    return testing::ResultOf(
+        absl::StrCat(".getUpdatesIfPresent(", blockIndex, ")"),
+        [blockIndex](const LocatedTriplesPerBlock& ltpb) {
+          auto updates = ltpb.getUpdatesIfPresent(blockIndex);
+          return updates.has_value() ? updates.value() : LocatedTriples{};
+        },
+        testing::Eq(expected));
+  };
+
+  // The initializer list doesn't have to be sorted.
+  LocatedTriples lts{LT{0, IT(3, 1, 1), true}, LT{0, IT(1, 1, 1), false}};
+  EXPECT_THAT(lts.triples(),
+              testing::ElementsAre(LT{0, IT(1, 1, 1), false},
+                                   LT{0, IT(3, 1, 1), true}));
+  EXPECT_TRUE(lts.contains(LT{7, IT(3, 1, 1), false}));
+  EXPECT_FALSE(lts.contains(LT{0, IT(2, 1, 1), false}));
+  EXPECT_FALSE(lts.insert(LT{0, IT(3, 1, 1), false}).second);
+  EXPECT_TRUE(lts.insert(LT{0, IT(2, 1, 1), false}).second);
+  EXPECT_EQ(lts.size(), 3);
+
+  auto LT1 = LT{0, IT(1, 1, 1), true};
+  auto LT2 = LT{0, IT(5, 1, 1), false};
+  auto LT3 = LT{1, IT(7, 1, 1), true};
+  auto LT4 = LT{0, IT(3, 1, 1), true};
+  auto LT5 = LT{1, IT(6, 1, 1), false};
+  auto LT6 = LT{0, IT(9, 1, 1), true};
+  LocatedTriplesPerBlock ltpb;
+  // The batches are unsorted and are merged into the existing triples.
+  ltpb.add(std::vector{LT3, LT2, LT1});
+  ltpb.add(std::vector{LT6, LT5, LT4});
+  EXPECT_THAT(ltpb, numTriplesTotal(6));
+  EXPECT_THAT(ltpb, blockIs(0, {LT1, LT4, LT2, LT6}));
+  EXPECT_THAT(ltpb, blockIs(1, {LT5, LT3}));
+
+  // Adding a triple that is already contained is an error.
+  EXPECT_ANY_THROW(ltpb.add(std::vector{LT{0, IT(5, 1, 1), true}}));
+  auto ltpb2 = LocatedTriplesPerBlock{};
+  ltpb2.add(std::vector{LT1, LT2, LT3, LT4, LT5, LT6});
+
+  // Erase a batch, the copy is not affected.
+  auto copy = ltpb2;
+  ltpb2.erase(std::vector{LT5, LT1, LT3, LT6});
+  EXPECT_THAT(ltpb2, numTriplesTotal(2));
+  EXPECT_THAT(ltpb2, numBlocks(1));
+  EXPECT_THAT(ltpb2, blockIs(0, {LT4, LT2}));
+  EXPECT_THAT(ltpb2, blockIs(1, {}));
+  EXPECT_THAT(copy, numTriplesTotal(6));
+  EXPECT_THAT(copy, blockIs(0, {LT1, LT4, LT2, LT6}));
+  EXPECT_THAT(copy, blockIs(1, {LT5, LT3}));
+
+  // Add to the copy, the original is not affected.
+  auto LT7 = LT{0, IT(4, 1, 1), true};
+  copy.add(std::vector{LT7});
+  EXPECT_THAT(copy, blockIs(0, {LT1, LT4, LT7, LT2, LT6}));
+  EXPECT_THAT(ltpb2, blockIs(0, {LT4, LT2}));
+
+  // Erasing a triple that is not contained is an error.
+  EXPECT_ANY_THROW(ltpb2.erase(0, LT1.triple_));
+  EXPECT_ANY_THROW(ltpb2.erase(1, LT3.triple_));
+}
+
 // Test the method that merges the matching `LocatedTriple`s from a block into
 // an `IdTable`.
 TEST_F(LocatedTriplesTest, mergeTriples) {
@@ -720,6 +787,37 @@ TEST_F(LocatedTriplesTest, locatedTriple) {
   }
 }
 
+// Locating many triples concurrently in chunks gives the same result as
+// locating them on a single thread.
+TEST_F(LocatedTriplesTest, locatedTripleInParallel) {
+  // 100 blocks with the subjects `[10 * i, 10 * i + 9]` each.
+  std::vector<CompressedBlockMetadata> blocks;
+  for (size_t i = 0; i < 100; ++i) {
+    blocks.push_back(CBM(PT(10 * i, 0, 0), PT(10 * i + 9, 0, 0)));
+  }
+  // More triples than a single chunk, in an order that is not sorted.
+  std::vector<IdTriple<0>> triples;
+  for (size_t i = 0; i < 35'000; ++i) {
+    triples.push_back(IT((i * 7919) % 1'100, i % 13, i));
+  }
+  ad_utility::SharedCancellationHandle handle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto expected = LocatedTriple::locateTriplesInPermutation(
+      triples, blocks, keyOrder, true, handle);
+  ASSERT_EQ(expected.size(), triples.size());
+  for (size_t numThreads : {2, 3, 8, 100}) {
+    EXPECT_EQ(LocatedTriple::locateTriplesInPermutation(
+                  triples, blocks, keyOrder, true, handle, numThreads),
+              expected);
+  }
+
+  // A cancellation is also propagated from the parallel chunks.
+  handle->cancel(ad_utility::CancellationState::MANUAL);
+  EXPECT_THROW(LocatedTriple::locateTriplesInPermutation(
+                   triples, blocks, keyOrder, true, handle, 4),
+               ad_utility::CancellationException);
+}
+
 TEST_F(LocatedTriplesTest, augmentedMetadata) {
   // Create a vector that is automatically converted to a span.
   using Span = std::vector<IdTriple<0>>;
@@ -791,9 +889,8 @@ TEST_F(LocatedTriplesTest, augmentedMetadata) {
                 testing::ElementsAreArray(expectedAugmentedMetadata));
 
     // T4 is before block 4. The beginning of block 4 changes.
-    auto handles =
-        locatedTriplesPerBlock.add(LocatedTriple::locateTriplesInPermutation(
-            Span{T4}, metadata, keyOrder, true, handle));
+    locatedTriplesPerBlock.add(LocatedTriple::locateTriplesInPermutation(
+        Span{T4}, metadata, keyOrder, true, handle));
     locatedTriplesPerBlock.updateAugmentedMetadata();
 
     expectedAugmentedMetadata[4] = CBM(T4.toPermutedTriple(), PT8);
@@ -802,7 +899,7 @@ TEST_F(LocatedTriplesTest, augmentedMetadata) {
                 testing::ElementsAreArray(expectedAugmentedMetadata));
 
     // Erasing the update of T4 restores the beginning of block 4.
-    locatedTriplesPerBlock.erase(4, handles[0]);
+    locatedTriplesPerBlock.erase(4, T4);
     locatedTriplesPerBlock.updateAugmentedMetadata();
 
     expectedAugmentedMetadata[4] = CBM(PT8, PT8);
@@ -0,0 +1,145 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util/Metrics.h"
+#include "util/jthread.h"
+
+using namespace ad_utility::metrics;
+using ::testing::HasSubstr;
+using ::testing::Not;
+using namespace std::chrono_literals;
+
+// _____________________________________________________________________________
+TEST(Metrics, counterAndGauge) {
+  Counter counter;
+  Gauge gauge;
+  {
+    std::vector<ad_utility::JThread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+      threads.emplace_back([&]() {
+        for (size_t j = 0; j < 1000; ++j) {
+          counter.add();
+          gauge.increment();
+          gauge.decrement();
+        }
+      });
+    }
+  }
+  counter.add(5);
+  gauge.decrement();
+  EXPECT_EQ(counter.value(), 4005u);
+  EXPECT_EQ(gauge.value(), -1);
+}
+
+// _____________________________________________________________________________
+TEST(Metrics, histogram) {
+  Histogram histogram;
+  histogram.observe(500us);
+  histogram.observe(1ms);
+  histogram.observe(20ms);
+  histogram.observe(2min);
+  EXPECT_EQ(histogram.count(), 4u);
+  EXPECT_EQ(histogram.sum(), 120'021'500us);
+  // The first bucket is `<= 0.001s`, the fourth is `<= 0.025s`, and the
+  // duration of two minutes is only in the implicit `+Inf` bucket.
+  EXPECT_EQ(histogram.cumulativeCount(0), 2u);
+  EXPECT_EQ(histogram.cumulativeCount(2), 2u);
+  EXPECT_EQ(histogram.cumulativeCount(3), 3u);
+  EXPECT_EQ(
+      histogram.cumulativeCount(Histogram::upperBoundsInSeconds.size() - 1),
+      3u);
+}
+
+// _____________________________________________________________________________
+TEST(Metrics, labeledFamily) {
+  LabeledFamily<Counter> family;
+  family.get("b").add(2);
+  family.get("a").add();
+  family.get("b").add();
+  EXPECT_EQ(&family.get("a"), &family.get("a"));
+  using P = std::pair<std::string, uint64_t>;
+  std::vector<P> values;
+  family.forEach([&values](std::string_view label, const Counter& counter) {
+    values.emplace_back(label, counter.value());
+  });
+  EXPECT_THAT(values, ::testing::ElementsAre(P{"a", 1}, P{"b", 3}));
+}
+
+// _____________________________________________________________________________
+TEST(Metrics, prometheusWriter) {
+  PrometheusWriter writer;
+  writer.addCounter("requests_total", "The requests.", 3, {{"type", "a"}});
+  writer.addCounter("requests_total", "The requests.", 4, {{"type", "b"}});
+  writer.addGauge("temperature", "A gauge.", 1.5);
+  // Floating-point values are written with all their significant digits.
+  writer.addGauge("exact", "Precision.", 123456789.125);
+  // Label values are escaped.
+  writer.addGauge("escaped", "Escaping.", 0, {{"l", "a\"b\\c\nd"}});
+  EXPECT_EQ(writer.output(),
+            "# HELP requests_total The requests.\n"
+            "# TYPE requests_total counter\n"
+            "requests_total{type=\"a\"} 3\n"
+            "requests_total{type=\"b\"} 4\n"
+            "# HELP temperature A gauge.\n"
+            "# TYPE temperature gauge\n"
+            "temperature 1.5\n"
+            "# HELP exact Precision.\n"
+            "# TYPE exact gauge\n"
+            "exact 123456789.125\n"
+            "# HELP escaped Escaping.\n"
+            "# TYPE escaped gauge\n"
+            "escaped{l=\"a\\\"b\\\\c\\nd\"} 0\n");
+
+  Histogram histogram;
+  histogram.observe(3ms);
+  histogram.observe(2min);
+  PrometheusWriter histogramWriter;
+  histogramWriter.addHistogram("duration_seconds", "Durations.", histogram,
+                               {{"type", "select"}});
+  const auto& output = histogramWriter.output();
+  EXPECT_THAT(output, HasSubstr("# TYPE duration_seconds histogram\n"));
+  EXPECT_THAT(output, HasSubstr("duration_seconds_bucket{type=\"select\","
+                                "le=\"0.001\"} 0\n"));
+  EXPECT_THAT(output, HasSubstr("duration_seconds_bucket{type=\"select\","
+                                "le=\"0.005\"} 1\n"));
+  EXPECT_THAT(output, HasSubstr("duration_seconds_bucket{type=\"select\","
+                                "le=\"60\"} 1\n"));
+  EXPECT_THAT(output, HasSubstr("duration_seconds_bucket{type=\"select\","
+                                "le=\"+Inf\"} 2\n"));
+  EXPECT_THAT(output, HasSubstr("duration_seconds_sum{type=\"select\"} "
+                                "120.003\n"));
+  EXPECT_THAT(output,
+              HasSubstr("duration_seconds_count{type=\"select\"} 2\n"));
+}
+
+// _____________________________________________________________________________
+TEST(Metrics, globalMetrics) {
+  auto& metrics = globalMetrics();
+  EXPECT_EQ(&metrics, &globalMetrics());
+  metrics.queryDuration_.get("select").observe(10ms);
+  metrics.operations_.get("IndexScan").numRows_.add(42);
+  metrics.threadPools_.get("query").numQueuedTasks_.increment();
+  metrics.bytesReadFromVocabulary_.add(7);
+
+  PrometheusWriter writer;
+  metrics.writeTo(writer);
+  const auto& output = writer.output();
+  EXPECT_THAT(output, HasSubstr("qlever_query_duration_seconds_count"
+                                "{type=\"select\"}"));
+  EXPECT_THAT(output, HasSubstr("qlever_operation_rows_total"
+                                "{operation=\"IndexScan\"}"));
+  EXPECT_THAT(output, HasSubstr("qlever_thread_pool_queued_tasks"
+                                "{pool=\"query\"}"));
+  EXPECT_THAT(output, HasSubstr("# TYPE qlever_vocabulary_bytes_read_total "
+                                "counter\n"));
+  EXPECT_THAT(output, Not(HasSubstr("type=\"ask\"")));
+  metrics.threadPools_.get("query").numQueuedTasks_.decrement();
+}
@@ -5,8 +5,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 #include "./util/IdTableHelpers.h"
 #include "./util/IdTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "engine/OrderBy.h"
 #include "engine/ValuesForTesting.h"
 #include "global/ValueIdComparators.h"
@@ -272,3 +275,55 @@ TEST(OrderBy, clone) {
   EXPECT_THAT(orderBy, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), orderBy.getDescriptor());
 }
+
+// _____________________________________________________________________________
+TEST(OrderBy, topK) {
+  auto* qec = ad_utility::testing::getQec();
+  // Enough rows in several blocks, s.t. the buffer of the top-k computation is
+  // truncated several times.
+  constexpr int64_t numRows = 50'000;
+  std::vector<int64_t> values(numRows);
+  std::iota(values.begin(), values.end(), 0);
+  randomShuffle(values.begin(), values.end());
+  std::vector<IdTable> blocks;
+  VectorTable allRows;
+  for (size_t i = 0; i < values.size(); i += 7'000) {
+    VectorTable block;
+    for (size_t j = i; j < std::min(values.size(), i + 7'000); ++j) {
+      block.push_back({values[j], -values[j]});
+      allRows.push_back({values[j], -values[j]});
+    }
+    blocks.push_back(makeIdTableFromVector(block, &Id::makeFromInt));
+  }
+  std::vector<std::optional<Variable>> vars{Variable{"?a"}, Variable{"?b"}};
+  VectorTable expected;
+  for (int64_t i = numRows - 6; i >= numRows - 15; --i) {
+    expected.push_back({i, -i});
+  }
+  auto expectedTable = makeIdTableFromVector(expected, &Id::makeFromInt);
+
+  auto lazyInput = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(blocks), vars);
+  auto materializedInput = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector(allRows, &Id::makeFromInt), vars);
+  for (const auto& input : {lazyInput, materializedInput}) {
+    OrderBy orderBy{qec, input, {{0, true}}};
+    EXPECT_EQ(orderBy.handlesLimitOffset(), LimitOffsetHandling::PARTIAL);
+    orderBy.applyLimitOffset({10, 5});
+    // Only the first `LIMIT + OFFSET` rows are computed.
+    EXPECT_EQ(orderBy.computeResultOnlyForTesting().idTable().numRows(), 15u);
+    // The `LIMIT` and `OFFSET` are applied afterwards.
+    auto result = orderBy.getResult();
+    EXPECT_EQ(result->idTable(), expectedTable);
+  }
+
+  // The same (sorted by the second column) with the top-k computation
+  // disabled.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::sortTopKMaxNumRows_>(0);
+  OrderBy orderBy{qec, materializedInput, {{1, false}}};
+  orderBy.applyLimitOffset({10, 5});
+  auto result = orderBy.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable().numRows(), static_cast<size_t>(numRows));
+  EXPECT_EQ(result.idTable()(5, 0), Id::makeFromInt(numRows - 6));
+}
@@ -13,6 +13,7 @@
 #include "util/IdTestHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using ad_utility::testing::getQec;
 namespace {
@@ -788,3 +789,286 @@ TEST(PathSearchTest, clone) {
   EXPECT_THAT(pathSearch, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), pathSearch.getDescriptor());
 }
+
+/**
+ * Graph:
+ *       0
+ *      / \
+ *     1   |
+ *    / \  |
+ *   2   3 |
+ *    \ /  |
+ *     4   |
+ *      \ /
+ *       5
+ */
+namespace {
+IdTable diamondWithShortcut() {
+  return makeIdTableFromVector(
+      {{0, 1}, {0, 5}, {1, 2}, {1, 3}, {2, 4}, {3, 4}, {4, 5}});
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(PathSearchTest, shortestPath) {
+  auto sub =
+      makeIdTableFromVector({{0, 1}, {1, 2}, {1, 3}, {2, 4}, {3, 4}, {4, 5}});
+  auto expected = makeIdTableFromVector({
+      {V(0), V(1), I(0), I(0)},
+      {V(1), V(2), I(0), I(1)},
+      {V(2), V(4), I(0), I(2)},
+      {V(4), V(5), I(0), I(3)},
+  });
+
+  std::vector<Id> sources{V(0)};
+  std::vector<Id> targets{V(5)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATH,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {}};
+
+  auto resultTable = performPathSearch(config, sub.clone(), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(expected));
+
+  // The shortcut is found, and there are no paths to unknown targets.
+  config.targets_ = std::vector<Id>{V(5), V(17)};
+  resultTable = performPathSearch(config, diamondWithShortcut(), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(
+                  makeIdTableFromVector({{V(0), V(5), I(0), I(0)}})));
+  config.targets_ = std::vector<Id>{V(17)};
+  resultTable = performPathSearch(config, std::move(sub), vars);
+  EXPECT_TRUE(resultTable.idTable().empty());
+}
+
+// _____________________________________________________________________________
+TEST(PathSearchTest, shortestPathAllTargets) {
+  auto sub =
+      makeIdTableFromVector({{0, 1}, {1, 2}, {1, 3}, {2, 4}, {3, 4}, {4, 5}});
+  // One shortest path to each reachable node, in the order of their distance.
+  auto expected = makeIdTableFromVector({
+      {V(0), V(1), I(0), I(0)},
+      {V(0), V(1), I(1), I(0)},
+      {V(1), V(2), I(1), I(1)},
+      {V(0), V(1), I(2), I(0)},
+      {V(1), V(3), I(2), I(1)},
+      {V(0), V(1), I(3), I(0)},
+      {V(1), V(2), I(3), I(1)},
+      {V(2), V(4), I(3), I(2)},
+      {V(0), V(1), I(4), I(0)},
+      {V(1), V(2), I(4), I(1)},
+      {V(2), V(4), I(4), I(2)},
+      {V(4), V(5), I(4), I(3)},
+  });
+
+  std::vector<Id> sources{V(0)};
+  std::vector<Id> targets{};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATH,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {}};
+
+  auto resultTable = performPathSearch(config, std::move(sub), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(expected));
+}
+
+// _____________________________________________________________________________
+TEST(PathSearchTest, kShortestPaths) {
+  // The paths are ordered by their length, and paths of the same length by
+  // the rows of their edges.
+  auto expected = makeIdTableFromVector({
+      {V(0), V(5), I(0), I(0)},
+      {V(0), V(1), I(1), I(0)},
+      {V(1), V(2), I(1), I(1)},
+      {V(2), V(4), I(1), I(2)},
+      {V(4), V(5), I(1), I(3)},
+      {V(0), V(1), I(2), I(0)},
+      {V(1), V(3), I(2), I(1)},
+      {V(3), V(4), I(2), I(2)},
+      {V(4), V(5), I(2), I(3)},
+  });
+
+  std::vector<Id> sources{V(0)};
+  std::vector<Id> targets{V(5)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::K_SHORTEST_PATHS,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {},
+                                 true,
+                                 3};
+
+  auto resultTable = performPathSearch(config, diamondWithShortcut(), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(expected));
+
+  // There are only three paths.
+  config.numPathsPerTarget_ = 5;
+  resultTable = performPathSearch(config, diamondWithShortcut(), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(expected));
+
+  config.numPathsPerTarget_ = 1;
+  resultTable = performPathSearch(config, diamondWithShortcut(), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(
+                  makeIdTableFromVector({{V(0), V(5), I(0), I(0)}})));
+}
+
+// _____________________________________________________________________________
+TEST(PathSearchTest, shortestPathsSourceAndTargetPairs) {
+  // The pairs are processed in parallel, but the order of the paths follows
+  // the order of the pairs.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::pathSearchMaxNumThreads_>(
+          4);
+  auto sub = makeIdTableFromVector({{0, 1}, {1, 2}, {2, 3}, {3, 0}});
+  VectorTable pairs;
+  VectorTable expectedRows;
+  for (int64_t i = 0; i < 20; ++i) {
+    int64_t source = i % 4;
+    int64_t target = (i + 1 + i % 3) % 4;
+    pairs.push_back({V(source), V(target)});
+    for (int64_t j = 0; j <= i % 3; ++j) {
+      expectedRows.push_back({V((source + j) % 4), V((source + j + 1) % 4),
+                              I(i), I(j), V(source), V(target)});
+    }
+  }
+  auto sideTable = makeIdTableFromVector(pairs);
+
+  Vars vars = {Variable{"?start"}, Variable{"?end"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATH,
+                                 Var{"?source"},
+                                 Var{"?target"},
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {},
+                                 false};
+
+  auto qec = getQec();
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(sub), vars);
+  auto pathSearch = PathSearch(qec, std::move(subtree), std::move(config));
+
+  Vars sideTreeVars = {Var{"?source"}, Var{"?target"}};
+  auto sideTree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(sideTable), sideTreeVars);
+  pathSearch.bindSourceAndTargetSide(sideTree, 0, 1);
+
+  auto resultTable = pathSearch.computeResult(false);
+  ASSERT_EQ(resultTable.idTable(), makeIdTableFromVector(expectedRows));
+}
+
+// _____________________________________________________________________________
+TEST(PathSearchTest, graphIsCached) {
+  auto qec = getQec();
+  auto& graphCache = pathSearch::CsrGraphCache::global();
+  graphCache.clear();
+  Vars vars = {Variable{"?start"}, Variable{"?end"}};
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, diamondWithShortcut(), vars);
+  auto makePathSearch = [&](Id target) {
+    return PathSearch{qec, subtree,
+                      PathSearchConfiguration{
+                          PathSearchAlgorithm::SHORTEST_PATH,
+                          std::vector<Id>{V(0)}, std::vector<Id>{target},
+                          Var{"?start"}, Var{"?end"}, Var{"?edgeIndex"},
+                          Var{"?pathIndex"}, std::vector<Variable>{}}};
+  };
+
+  // The second search uses the same edges, so the graph is only built once,
+  // also when the edges are computed again.
+  auto first = makePathSearch(V(4));
+  EXPECT_EQ(first.getResult()->idTable().size(), 3u);
+  EXPECT_EQ(first.runtimeInfo().details_["Graph read from cache"], false);
+  EXPECT_EQ(graphCache.numEntries(), 1u);
+  qec->clearCacheUnpinnedOnly();
+  auto second = makePathSearch(V(5));
+  EXPECT_EQ(second.getResult()->idTable().size(), 1u);
+  EXPECT_EQ(second.runtimeInfo().details_["Graph read from cache"], true);
+
+  // A graph that is larger than the maximal size of the cache is not stored.
+  {
+    using namespace ad_utility::memory_literals;
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::pathSearchGraphCacheMaxSize_>(1_B);
+    graphCache.clear();
+    auto third = makePathSearch(V(3));
+    EXPECT_EQ(third.getResult()->idTable().size(), 2u);
+    EXPECT_EQ(third.runtimeInfo().details_["Graph read from cache"], false);
+    EXPECT_EQ(graphCache.numEntries(), 0u);
+  }
+  graphCache.clear();
+}
+
+// _____________________________________________________________________________
+TEST(CsrGraph, searches) {
+  using namespace pathSearch;
+  auto edges = diamondWithShortcut();
+  CsrGraph graph{edges.getColumn(0), edges.getColumn(1),
+                 ad_utility::testing::makeAllocator()};
+  EXPECT_EQ(graph.numNodes(), 6u);
+  EXPECT_EQ(graph.numEdges(), 7u);
+  EXPECT_GT(graph.getSizeInBytes(), 0u);
+  EXPECT_FALSE(graph.getNodeIndex(V(17)).has_value());
+  auto node = [&graph](int64_t i) { return graph.getNodeIndex(V(i)).value(); };
+  EXPECT_EQ(graph.getId(node(3)), V(3));
+  auto noop = []() {};
+
+  using P = CsrGraph::EdgePath;
+  EXPECT_EQ(graph.shortestPath(node(0), node(5), noop), P{1});
+  EXPECT_FALSE(graph.shortestPath(node(0), node(0), noop).has_value());
+  EXPECT_FALSE(graph.shortestPath(node(5), node(0), noop).has_value());
+  CsrGraph::Blocked blocked;
+  blocked.edges_.insert(1);
+  blocked.nodes_.insert(node(2));
+  EXPECT_EQ(graph.shortestPath(node(0), node(5), noop, blocked),
+            (P{0, 3, 5, 6}));
+  blocked.nodes_.insert(node(3));
+  EXPECT_FALSE(
+      graph.shortestPath(node(0), node(5), noop, blocked).has_value());
+
+  EXPECT_THAT(graph.shortestPathsToAll(node(1), {}, noop),
+              ::testing::ElementsAre(P{2}, P{3}, (P{2, 4}), (P{2, 4, 6})));
+  EXPECT_THAT(graph.shortestPathsToAll(node(1), {node(4), node(1)}, noop),
+              ::testing::ElementsAre(P{2, 4}));
+
+  EXPECT_THAT(graph.kShortestPaths(node(0), node(4), 5, noop),
+              ::testing::ElementsAre((P{0, 2, 4}), (P{0, 3, 5})));
+  EXPECT_THAT(graph.kShortestPaths(node(0), node(4), 0, noop),
+              ::testing::IsEmpty());
+
+  // On a cycle, each path is simple.
+  auto cycle = makeIdTableFromVector({{0, 1}, {1, 0}, {1, 2}});
+  CsrGraph cycleGraph{cycle.getColumn(0), cycle.getColumn(1),
+                      ad_utility::testing::makeAllocator()};
+  EXPECT_THAT(cycleGraph.kShortestPaths(0, 2, 3, noop),
+              ::testing::ElementsAre((P{0, 2})));
+}
+
+// _____________________________________________________________________________
+TEST(CsrGraph, memoryIsLimited) {
+  using namespace ad_utility::memory_literals;
+  auto edges = diamondWithShortcut();
+  EXPECT_THROW((pathSearch::CsrGraph{edges.getColumn(0), edges.getColumn(1),
+                                     ad_utility::testing::makeAllocator(16_B)}),
+               ad_utility::detail::AllocationExceedsLimitException);
+}
@@ -203,6 +203,32 @@ TEST(QueryRegistry, verifyGetActiveQueriesReturnsAllActiveQueries) {
 
 // _____________________________________________________________________________
 
+TEST(QueryRegistry, getActiveQueriesReportsMemoryUsage) {
+  using namespace ad_utility::memory_literals;
+  QueryRegistry registry{};
+  auto queryId = registry.uniqueId("my-query");
+  EXPECT_FALSE(registry.getActiveQueries()
+                   .at(queryId.toQueryId())
+                   .memoryUsage_.has_value());
+
+  auto allocator =
+      ad_utility::makeAllocatorWithLimit<char>(2_MB).makeChildAllocator(1_MB);
+  registry.setMemoryBudget(queryId.toQueryId(),
+                           allocator.getMemoryLeft().ptr());
+  auto* memory = allocator.allocate(1000);
+  auto info = registry.getActiveQueries().at(queryId.toQueryId());
+  ASSERT_TRUE(info.memoryUsage_.has_value());
+  EXPECT_EQ(info.memoryUsage_->used_, 1000_B);
+  EXPECT_EQ(info.memoryUsage_->peak_, 1000_B);
+  EXPECT_EQ(info.memoryUsage_->limit_, 1_MB);
+  auto json = nlohmann::json(info);
+  EXPECT_EQ(json.at("memory-used").get<std::string>(), "1000 B");
+  EXPECT_EQ(json.at("memory-limit").get<std::string>(), "1 MB");
+  allocator.deallocate(memory, 1000);
+}
+
+// _____________________________________________________________________________
+
 TEST(QueryRegistry, statusDefaultsToFailed) {
   QueryRegistry registry{};
   auto owned = registry.uniqueId("my-query");
@@ -287,6 +287,33 @@ TEST(QueryPlanner, joinOfTwoScans) {
       h::Join(scan("?y", "<pre/r>", "?x"), scan("?z", "<pre/r>", "?x")));
 }
 
+// _____________________________________________________________________________
+TEST(QueryPlanner, hashJoinForUnsortedInputs) {
+  // Neither of the two `VALUES` clauses is sorted on `?x`, so the `Join` would
+  // have to sort both of them.
+  std::string query =
+      "SELECT * { VALUES (?x ?y) { (1 1) (2 2) (3 3) (4 4) } "
+      "VALUES (?x ?z) { (4 1) (3 2) (2 3) (1 4) } }";
+  auto values1 = h::ValuesClause("VALUES (?x\t?y) { (1 1) (2 2) (3 3) (4 4) }");
+  auto values2 = h::ValuesClause("VALUES (?x\t?z) { (4 1) (3 2) (2 3) (1 4) }");
+  {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::hashJoinEnabled_>(
+            false);
+    h::expect(query, h::Join(h::Sort(values1), h::Sort(values2)));
+  }
+  // With the `HashJoin` enabled, it is cheaper than sorting both inputs.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::hashJoinEnabled_>(true);
+  h::expect(query, h::HashJoin(values1, values2));
+
+  // If both inputs are already sorted on the join column, the `Join` is
+  // always used.
+  h::expect("SELECT * {?s <p> ?x. ?x <q> ?o .}",
+            h::Join(h::IndexScanFromStrings("?s", "<p>", "?x"),
+                    h::IndexScanFromStrings("?x", "<q>", "?o")));
+}
+
 // _____________________________________________________________________________
 TEST(QueryPlanner, joinOfFullScans) {
   auto scan = h::IndexScanFromStrings;
@@ -1538,7 +1565,7 @@ TEST(QueryPlanner, PathSearchUnsupportedAlgorithm) {
       "PREFIX pathSearch: <https://qlever.cs.uni-freiburg.de/pathSearch/>"
       "SELECT ?start ?end ?path ?edge WHERE {"
       "SERVICE pathSearch: {"
-      "_:path pathSearch:algorithm pathSearch:shortestPath ;"
+      "_:path pathSearch:algorithm pathSearch:dijkstra ;"
       "pathSearch:source ?source1 ;"
       "pathSearch:source ?source2 ;"
       "pathSearch:target <z> ;"
@@ -1555,6 +1582,56 @@ TEST(QueryPlanner, PathSearchUnsupportedAlgorithm) {
       InvalidSparqlQueryException);
 }
 
+// __________________________________________________________________________
+TEST(QueryPlanner, PathSearchShortestPathAlgorithms) {
+  auto scan = h::IndexScanFromStrings;
+  auto qec = ad_utility::testing::getQec("<x> <p> <y>. <y> <p> <z>");
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+
+  auto makeQuery = [](std::string_view algorithm,
+                      std::string_view numPathsPerTarget) {
+    return absl::StrCat(
+        "PREFIX pathSearch: <https://qlever.cs.uni-freiburg.de/pathSearch/>"
+        "SELECT ?start ?end ?path ?edge WHERE {"
+        "SERVICE pathSearch: {"
+        "_:path pathSearch:algorithm pathSearch:",
+        algorithm, " ;", numPathsPerTarget,
+        "pathSearch:source <x> ;"
+        "pathSearch:target <z> ;"
+        "pathSearch:pathColumn ?path ;"
+        "pathSearch:edgeColumn ?edge ;"
+        "pathSearch:start ?start;"
+        "pathSearch:end ?end;"
+        "{SELECT * WHERE {"
+        "?start <p> ?end."
+        "}}}}");
+  };
+  std::vector<Id> sources{getId("<x>")};
+  std::vector<Id> targets{getId("<z>")};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATH,
+                                 sources,
+                                 targets,
+                                 Variable("?start"),
+                                 Variable("?end"),
+                                 Variable("?path"),
+                                 Variable("?edge"),
+                                 {}};
+  h::expect(makeQuery("shortestPath", ""),
+            h::pathSearch(config, true, true, scan("?start", "<p>", "?end")),
+            qec);
+
+  config.algorithm_ = PathSearchAlgorithm::K_SHORTEST_PATHS;
+  h::expect(makeQuery("kShortestPaths", "pathSearch:numPathsPerTarget 3 ;"),
+            h::pathSearch(config, true, true, scan("?start", "<p>", "?end")),
+            qec);
+
+  // The number of paths is required for `kShortestPaths`.
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      h::parseAndPlan(makeQuery("kShortestPaths", ""), qec),
+      HasSubstr("requires the parameter <numPathsPerTarget>"),
+      parsedQuery::PathSearchException);
+}
+
 // __________________________________________________________________________
 TEST(QueryPlanner, PathSearchWrongArgumentCartesian) {
   auto qec = ad_utility::testing::getQec("<x> <p> <y>. <y> <p> <z>");
@@ -3977,3 +4054,35 @@ GROUP BY ?p
 )",
             h::_);
 }
+
+// _____________________________________________________________________________
+TEST(QueryPlanner, MultiwayJoinForCyclicPatterns) {
+  // The complete graph on five nodes, for which the binary joins of a triangle
+  // have a large intermediate result.
+  std::string kg;
+  for (size_t i = 0; i < 5; ++i) {
+    for (size_t j = 0; j < 5; ++j) {
+      if (i != j) {
+        kg += absl::StrCat("<n", i, "> <p> <n", j, "> .\n");
+      }
+    }
+  }
+  auto qec = ad_utility::testing::getQec(kg);
+  std::string query = "SELECT * { ?a <p> ?b . ?b <p> ?c . ?c <p> ?a }";
+  using enum Permutation::Enum;
+  // The variable order is `?a ?b ?c`, so the scans of the first two triples
+  // are sorted by the subject, and the scan of the last one by the object.
+  auto multiwayJoin =
+      h::MultiwayJoin(h::IndexScanFromStrings("?a", "<p>", "?b", {PSO}),
+                      h::IndexScanFromStrings("?b", "<p>", "?c", {PSO}),
+                      h::IndexScanFromStrings("?c", "<p>", "?a", {POS}));
+  {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::multiwayJoinEnabled_>(true);
+    qec->clearCacheUnpinnedOnly();
+    h::expect(query, multiwayJoin, qec);
+  }
+  // The multiway join is disabled by default.
+  qec->clearCacheUnpinnedOnly();
+  h::expect(query, ::testing::Not(multiwayJoin), qec);
+}
@@ -22,11 +22,13 @@
 #include "engine/ExplicitIdTableOperation.h"
 #include "engine/Filter.h"
 #include "engine/GroupBy.h"
+#include "engine/HashJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/MaterializedViews.h"
 #include "engine/Minus.h"
 #include "engine/MultiColumnJoin.h"
+#include "engine/MultiwayJoin.h"
 #include "engine/NeutralElementOperation.h"
 #include "engine/NeutralOptional.h"
 #include "engine/OptionalJoin.h"
@@ -312,7 +314,9 @@ inline auto IndexScanFromStrings =
 // For the following Join algorithms the order of the children is not
 // important.
 inline auto MultiColumnJoin = MatchTypeAndUnorderedChildren<::MultiColumnJoin>;
+inline auto MultiwayJoin = MatchTypeAndUnorderedChildren<::MultiwayJoin>;
 inline auto Join = MatchTypeAndUnorderedChildren<::Join>;
+inline auto HashJoin = MatchTypeAndUnorderedChildren<::HashJoin>;
 
 constexpr auto OptionalJoin = MatchTypeAndOrderedChildren<::OptionalJoin>;
 
@@ -18,6 +18,7 @@
 #include "util/GTestHelpers.h"
 #include "util/HttpRequestHelpers.h"
 #include "util/IndexTestHelpers.h"
+#include "util/Metrics.h"
 #include "util/RuntimeParametersTestHelpers.h"
 #include "util/http/HttpUtils.h"
 #include "util/http/UrlParser.h"
@@ -52,6 +53,31 @@ TEST(ServerTest, determineResultPinning) {
       testing::Pair(false, false));
 }
 
+// _____________________________________________________________________________
+TEST(ServerTest, determineQueryMemoryLimit) {
+  using namespace ad_utility::memory_literals;
+  EXPECT_FALSE(Server::determineQueryMemoryLimit({}, false).has_value());
+  EXPECT_EQ(Server::determineQueryMemoryLimit({{"memory-limit", {"5 GB"}}},
+                                              false),
+            5_GB);
+
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::queryMemoryLimit_>(1_GB);
+  EXPECT_EQ(Server::determineQueryMemoryLimit({{"memory-limit", {"500 MB"}}},
+                                              false),
+            500_MB);
+  // Higher limits (including no limit) require an access token.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      Server::determineQueryMemoryLimit({{"memory-limit", {"5 GB"}}}, false),
+      testing::HasSubstr("memory limit was higher than what is currently "
+                         "allowed by this instance (1 GB)"));
+  EXPECT_ANY_THROW(
+      Server::determineQueryMemoryLimit({{"memory-limit", {"0 B"}}}, false));
+  EXPECT_EQ(
+      Server::determineQueryMemoryLimit({{"memory-limit", {"5 GB"}}}, true),
+      5_GB);
+}
+
 // _____________________________________________________________________________
 TEST(ServerTest, determineMediaType) {
   auto MakeRequest = [](const std::optional<std::string>& accept,
@@ -348,6 +374,37 @@ TEST(ServerTest, adjustParsedQueryLimitOffset) {
   expectExportLimit(tsv, std::nullopt);
 }
 
+// _____________________________________________________________________________
+TEST(ServerTest, recordOperationMetrics) {
+  auto* qec = ad_utility::testing::getQec("<a> <b> <c> . <d> <e> <a>");
+  qec->clearCacheUnpinnedOnly();
+  auto makeTree = [qec]() {
+    QueryPlanner planner{qec,
+                         std::make_shared<ad_utility::CancellationHandle<>>()};
+    return planner.createExecutionTree(
+        parseQuery("SELECT * WHERE { ?x <b> ?y . ?z <e> ?x }"));
+  };
+  auto& joins = ad_utility::metrics::globalMetrics().operations_.get("Join");
+  auto numJoins = joins.numComputations_.value();
+  auto numJoinRows = joins.numRows_.value();
+
+  // Operations that were not computed are not recorded.
+  auto qet = makeTree();
+  Server::recordOperationMetrics(qet);
+  EXPECT_EQ(joins.numComputations_.value(), numJoins);
+
+  qet.getResult();
+  Server::recordOperationMetrics(qet);
+  EXPECT_EQ(joins.numComputations_.value(), numJoins + 1);
+  EXPECT_EQ(joins.numRows_.value(), numJoinRows + 1);
+
+  // Results from the cache were recorded when they were computed.
+  auto cachedQet = makeTree();
+  cachedQet.getResult();
+  Server::recordOperationMetrics(cachedQet);
+  EXPECT_EQ(joins.numComputations_.value(), numJoins + 1);
+}
+
 // _____________________________________________________________________________
 TEST(ServerTest, configurePinnedResultWithName) {
   auto qec = ad_utility::testing::getQec();
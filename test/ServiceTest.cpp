@@ -7,6 +7,7 @@
 
 #include <ctre-unicode.hpp>
 #include <exception>
+#include <mutex>
 #include <regex>
 
 #include "backports/StartsWithAndEndsWith.h"
@@ -943,6 +944,136 @@ TEST_F(ServiceTest, precomputeSiblingResult) {
   }
 }
 
+// ____________________________________________________________________________
+TEST_F(ServiceTest, bindJoin) {
+  auto cleanupBatchSize =
+      setRuntimeParameterForTest<&RuntimeParameters::serviceMaxValueRows_>(2);
+  auto cleanupParallelism = setRuntimeParameterForTest<
+      &RuntimeParameters::serviceBindJoinParallelism_>(2);
+
+  // A mock endpoint that answers each request with the rows `(x, 10 * x)` for
+  // all the values `x` of the VALUES clause, and records the number of values
+  // per request. The requests are sent concurrently.
+  std::mutex mutex;
+  std::vector<size_t> numValuesPerRequest;
+  int64_t failingValue = -1;
+  SendRequestType endpoint =
+      [&](const ad_utility::httpUtils::Url&,
+          ad_utility::SharedCancellationHandle,
+          const boost::beast::http::verb&, std::string_view postData,
+          std::string_view, std::string_view, size_t) {
+        auto literal = [](int64_t value) {
+          return nlohmann::json{
+              {"type", "literal"},
+              {"value", std::to_string(value)},
+              {"datatype", "http://www.w3.org/2001/XMLSchema#integer"}};
+        };
+        nlohmann::json result;
+        result["head"]["vars"] = {"x", "y"};
+        result["results"]["bindings"] = nlohmann::json::array();
+        std::string data{postData};
+        std::regex valueRegex{"\\(([0-9]+)\\)"};
+        size_t numValues = 0;
+        bool fail = false;
+        for (auto it = std::sregex_iterator(data.begin(), data.end(),
+                                            valueRegex);
+             it != std::sregex_iterator{}; ++it) {
+          int64_t x = std::stoll((*it)[1]);
+          fail |= x == failingValue;
+          result["results"]["bindings"].push_back(
+              {{"x", literal(x)}, {"y", literal(10 * x)}});
+          ++numValues;
+        }
+        std::lock_guard lock{mutex};
+        numValuesPerRequest.push_back(numValues);
+        auto body =
+            [](std::string result) -> cppcoro::generator<ql::span<std::byte>> {
+          co_yield ql::as_writable_bytes(ql::span{result});
+        };
+        return HttpOrHttpsResponse{
+            .status_ = fail ? boost::beast::http::status::internal_server_error
+                            : boost::beast::http::status::ok,
+            .contentType_ = "application/sparql-results+json",
+            .location_ = "",
+            .body_ = body(result.dump())};
+      };
+
+  // A sibling with five distinct values (and a duplicate).
+  std::vector<std::vector<TripleComponent>> siblingRows;
+  for (int64_t x : {1, 2, 3, 4, 5, 3}) {
+    siblingRows.push_back({TripleComponent{x}});
+  }
+  auto sibling = std::make_shared<Values>(
+      testQec, parsedQuery::SparqlValues{{Variable{"?x"}}, siblingRows});
+  parsedQuery::Service parsedServiceClause{
+      {Variable{"?x"}, Variable{"?y"}},
+      TripleComponent::Iri::fromIriref("<http://localhorst/api>"),
+      "",
+      "{ ?x <p> ?y }",
+      false};
+
+  using Row = std::pair<int64_t, int64_t>;
+  auto appendRows = [](std::vector<Row>& rows, const IdTable& idTable) {
+    for (const auto& row : idTable) {
+      rows.emplace_back(row[0].getInt(), row[1].getInt());
+    }
+  };
+  auto expectedRows = ::testing::UnorderedElementsAre(
+      Row{1, 10}, Row{2, 20}, Row{3, 30}, Row{4, 40}, Row{5, 50});
+
+  // The sibling result is used although it has more rows than
+  // `service-max-value-rows`.
+  auto service =
+      std::make_shared<Service>(testQec, parsedServiceClause, endpoint);
+  Service::precomputeSiblingResult(sibling, service, true, false);
+  ASSERT_TRUE(service->siblingInfo_.has_value());
+
+  // Fully materialized: Three requests with at most two values each.
+  {
+    auto result = service->computeResultOnlyForTesting();
+    std::vector<Row> rows;
+    appendRows(rows, result.idTable());
+    EXPECT_THAT(rows, expectedRows);
+    EXPECT_THAT(numValuesPerRequest, ::testing::UnorderedElementsAre(2, 2, 1));
+    EXPECT_EQ(service->runtimeInfo().details_["bind-join-num-batches"], 3);
+    EXPECT_EQ(service->runtimeInfo().details_["bind-join-parallelism"], 2);
+  }
+
+  // Lazy: One `IdTable` per request.
+  numValuesPerRequest.clear();
+  {
+    auto result = service->computeResultOnlyForTesting(true);
+    ASSERT_FALSE(result.isFullyMaterialized());
+    std::vector<Row> rows;
+    size_t numBatches = 0;
+    for (const auto& [idTable, localVocab] : result.idTables()) {
+      appendRows(rows, idTable);
+      ++numBatches;
+    }
+    EXPECT_THAT(rows, expectedRows);
+    EXPECT_EQ(numBatches, 3);
+  }
+
+  // Errors of a single request are propagated.
+  failingValue = 3;
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      service->computeResultOnlyForTesting(),
+      ::testing::HasSubstr("SERVICE responded with HTTP status code: 500"));
+  failingValue = -1;
+
+  // Without a bind join, all the values are sent in a single request.
+  numValuesPerRequest.clear();
+  {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::serviceBindJoinParallelism_>(0);
+    auto result = service->computeResultOnlyForTesting();
+    std::vector<Row> rows;
+    appendRows(rows, result.idTable());
+    EXPECT_THAT(rows, expectedRows);
+    EXPECT_THAT(numValuesPerRequest, ::testing::ElementsAre(5));
+  }
+}
+
 // ____________________________________________________________________________
 TEST_F(ServiceTest, clone) {
   Service service{
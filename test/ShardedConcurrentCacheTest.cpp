@@ -0,0 +1,225 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/Cache.h"
+#include "util/DefaultValueSizeGetter.h"
+#include "util/ShardedConcurrentCache.h"
+#include "util/jthread.h"
+
+using namespace std::string_literals;
+using namespace ad_utility::memory_literals;
+using ad_utility::CacheStatus;
+
+namespace {
+using ShardedLruCache = ad_utility::ShardedConcurrentCache<ad_utility::LRUCache<
+    int, std::string, ad_utility::StringSizeGetter<std::string>>>;
+
+auto returnTrue = [](const auto&) { return true; };
+
+// Compute and cache the value `std::to_string(key)` for each of the `keys`.
+void insertKeys(ShardedLruCache& cache, const std::vector<int>& keys) {
+  for (int key : keys) {
+    cache.computeOnce(
+        key, [key]() { return std::to_string(key); }, false, returnTrue);
+  }
+}
+
+// Return the keys from `[0, maxKey)` that are contained in the `cache`.
+std::vector<int> containedKeys(const ShardedLruCache& cache, int maxKey) {
+  std::vector<int> result;
+  for (int key = 0; key < maxKey; ++key) {
+    if (cache.cacheContains(key)) {
+      result.push_back(key);
+    }
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ShardedConcurrentCache, computeOnceAndCacheStatus) {
+  ShardedLruCache cache{4};
+  EXPECT_EQ(cache.numShards(), 4u);
+  auto result = cache.computeOnce(3, []() { return "3"s; }, false, returnTrue);
+  EXPECT_EQ(*result._resultPointer, "3");
+  EXPECT_EQ(result._cacheStatus, CacheStatus::computed);
+
+  result = cache.computeOnce(3, []() { return "x"s; }, false, returnTrue);
+  EXPECT_EQ(*result._resultPointer, "3");
+  EXPECT_EQ(result._cacheStatus, CacheStatus::cachedNotPinned);
+
+  // Pinning an existing entry reports the previous status.
+  result = cache.computeOncePinned(3, []() { return "x"s; }, false, returnTrue);
+  EXPECT_EQ(result._cacheStatus, CacheStatus::cachedNotPinned);
+  result = cache.computeOnce(3, []() { return "x"s; }, false, returnTrue);
+  EXPECT_EQ(result._cacheStatus, CacheStatus::cachedPinned);
+  EXPECT_EQ(cache.numPinnedEntries(), 1u);
+  EXPECT_EQ(cache.numNonPinnedEntries(), 0u);
+
+  result = cache.computeOnce(4, []() { return "4"s; }, true, returnTrue);
+  EXPECT_EQ(result._resultPointer, nullptr);
+  EXPECT_EQ(result._cacheStatus, CacheStatus::notInCacheAndNotComputed);
+
+  // Results that are not suitable for the cache are not stored.
+  auto neverSuitable = [](const auto&) { return false; };
+  result = cache.computeOnce(5, []() { return "5"s; }, false, neverSuitable);
+  EXPECT_EQ(*result._resultPointer, "5");
+  EXPECT_FALSE(cache.cacheContains(5));
+  EXPECT_ANY_THROW(
+      cache.computeOncePinned(5, []() { return "5"s; }, false, neverSuitable));
+
+  // Failed computations are not stored, and can be retried.
+  EXPECT_THROW(cache.computeOnce(
+                   6, []() -> std::string { throw std::runtime_error{"f"}; },
+                   false, returnTrue),
+               std::runtime_error);
+  EXPECT_EQ(cache.numResultsInProgress(), 0u);
+  result = cache.computeOnce(6, []() { return "6"s; }, false, returnTrue);
+  EXPECT_EQ(*result._resultPointer, "6");
+  EXPECT_EQ(cache.numHits(), 3u);
+  EXPECT_EQ(cache.numMisses(), 6u);
+  EXPECT_EQ(cache.numEvictions(), 0u);
+
+  cache.clearUnpinnedOnly();
+  EXPECT_THAT(containedKeys(cache, 10), ::testing::ElementsAre(3));
+  cache.clearAll();
+  EXPECT_THAT(containedKeys(cache, 10), ::testing::IsEmpty());
+}
+
+// _____________________________________________________________________________
+TEST(ShardedConcurrentCache, globalNumEntriesLimit) {
+  ShardedLruCache cache{4, 3};
+  insertKeys(cache, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+  // The limit applies to all shards together, and the least recently used
+  // entries are evicted first.
+  EXPECT_EQ(cache.numNonPinnedEntries(), 3u);
+  EXPECT_THAT(containedKeys(cache, 10), ::testing::ElementsAre(7, 8, 9));
+
+  // Accessing an entry makes it the most recently used one.
+  EXPECT_TRUE(cache.getIfContained(7).has_value());
+  insertKeys(cache, {10});
+  EXPECT_THAT(containedKeys(cache, 11), ::testing::ElementsAre(7, 9, 10));
+
+  // Pinned entries are never evicted, but count towards the limit.
+  cache.computeOncePinned(20, []() { return "20"s; }, false, returnTrue);
+  insertKeys(cache, {11});
+  EXPECT_EQ(cache.numPinnedEntries(), 1u);
+  EXPECT_THAT(containedKeys(cache, 21), ::testing::ElementsAre(10, 11, 20));
+
+  cache.setMaxNumEntries(2);
+  EXPECT_THAT(containedKeys(cache, 21), ::testing::ElementsAre(11, 20));
+  EXPECT_EQ(cache.numEvictions(), 11u);
+  EXPECT_EQ(cache.numMisses(), 13u);
+}
+
+// _____________________________________________________________________________
+TEST(ShardedConcurrentCache, globalSizeLimit) {
+  // Each value has a size of two bytes.
+  ShardedLruCache cache{8, 100, 7_B, 4_B};
+  insertKeys(cache, {10, 11, 12, 13, 14});
+  EXPECT_THAT(containedKeys(cache, 20), ::testing::ElementsAre(12, 13, 14));
+  EXPECT_EQ(cache.nonPinnedSize(), 6_B);
+  EXPECT_EQ(cache.getMaxSizeSingleEntry(), 4_B);
+
+  // Entries that are larger than the maximal size of a single entry are not
+  // stored.
+  cache.computeOnce(99, []() { return "toolarge"s; }, false, returnTrue);
+  EXPECT_FALSE(cache.cacheContains(99));
+
+  EXPECT_TRUE(cache.makeRoomAsMuchAsPossible(3_B));
+  EXPECT_THAT(containedKeys(cache, 20), ::testing::ElementsAre(14));
+  EXPECT_FALSE(cache.makeRoomAsMuchAsPossible(3_B));
+  EXPECT_EQ(cache.numNonPinnedEntries(), 0u);
+
+  insertKeys(cache, {10, 11, 12});
+  cache.setMaxSize(4_B);
+  EXPECT_THAT(containedKeys(cache, 20), ::testing::ElementsAre(11, 12));
+}
+
+// _____________________________________________________________________________
+TEST(ShardedConcurrentCache, pinnedEntriesStayWithinGlobalSizeLimit) {
+  // Each value has a size of two bytes, and each shard alone would accept
+  // pinned entries of up to 7 bytes.
+  ShardedLruCache cache{8, 100, 7_B};
+  for (int key : {10, 11, 12, 13}) {
+    cache.computeOncePinned(
+        key, [key]() { return std::to_string(key); }, false, returnTrue);
+  }
+  cache.tryInsertIfNotPresent(true, 14, std::make_shared<std::string>("14"));
+  EXPECT_EQ(cache.pinnedSize(), 6_B);
+  EXPECT_THAT(containedKeys(cache, 20), ::testing::ElementsAre(10, 11, 12));
+
+  // A non-pinned entry that doesn't fit next to the pinned entries is not
+  // stored, and doesn't evict the other non-pinned entries.
+  cache.clearAll();
+  insertKeys(cache, {10});
+  for (int key : {11, 12}) {
+    cache.computeOncePinned(
+        key, [key]() { return std::to_string(key); }, false, returnTrue);
+  }
+  insertKeys(cache, {1000});
+  EXPECT_FALSE(cache.cacheContains(1000));
+  EXPECT_THAT(containedKeys(cache, 20), ::testing::ElementsAre(10, 11, 12));
+  EXPECT_EQ(cache.numEvictions(), 0u);
+}
+
+// _____________________________________________________________________________
+TEST(ShardedConcurrentCache, tryInsertIfNotPresent) {
+  ShardedLruCache cache{};
+  cache.tryInsertIfNotPresent(false, 0, std::make_shared<std::string>("abc"));
+  cache.tryInsertIfNotPresent(false, 0, std::make_shared<std::string>("def"));
+  EXPECT_EQ(*cache.getIfContained(0).value()._resultPointer, "abc");
+  EXPECT_EQ(cache.pinnedSize(), 0_B);
+  cache.tryInsertIfNotPresent(true, 0, std::make_shared<std::string>("ghi"));
+  EXPECT_EQ(*cache.getIfContained(0).value()._resultPointer, "abc");
+  EXPECT_EQ(cache.pinnedSize(), 3_B);
+  EXPECT_EQ(cache.nonPinnedSize(), 0_B);
+
+  auto result = cache.computeButDontStore(
+      1, []() { return "1"s; }, false, returnTrue);
+  EXPECT_EQ(*result._resultPointer, "1");
+  EXPECT_FALSE(cache.cacheContains(1));
+}
+
+// _____________________________________________________________________________
+TEST(ShardedConcurrentCache, concurrentComputations) {
+  ShardedLruCache cache{4};
+  static constexpr int numKeys = 16;
+  std::array<std::atomic<int>, numKeys> numComputations{};
+  {
+    std::vector<ad_utility::JThread> threads;
+    for (size_t i = 0; i < 16; ++i) {
+      threads.emplace_back([&cache, &numComputations]() {
+        for (int key = 0; key < numKeys; ++key) {
+          auto result = cache.computeOnce(
+              key,
+              [&numComputations, key]() {
+                ++numComputations[key];
+                std::this_thread::sleep_for(std::chrono::milliseconds{2});
+                return std::to_string(key);
+              },
+              false, returnTrue);
+          EXPECT_EQ(*result._resultPointer, std::to_string(key));
+        }
+      });
+    }
+  }
+  // Each result was computed only once, all other threads either waited for
+  // the computation or read the result from the cache.
+  for (const auto& count : numComputations) {
+    EXPECT_EQ(count, 1);
+  }
+  EXPECT_EQ(cache.numNonPinnedEntries(), static_cast<size_t>(numKeys));
+  EXPECT_EQ(cache.numResultsInProgress(), 0u);
+}
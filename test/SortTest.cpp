@@ -456,7 +456,7 @@ TEST(Sort, limitOffsetIsNotPropagatedForExplicitSort) {
   auto tree = QueryExecutionTree::createSortedTree(subtree, {0}, true);
   auto sort = std::dynamic_pointer_cast<Sort>(tree->getRootOperation());
   ASSERT_NE(sort, nullptr);
-  EXPECT_EQ(sort->handlesLimitOffset(), LimitOffsetHandling::NONE);
+  EXPECT_EQ(sort->handlesLimitOffset(), LimitOffsetHandling::PARTIAL);
 
   sort->applyLimitOffset({2, 1});
 
@@ -468,3 +468,30 @@ TEST(Sort, limitOffsetIsNotPropagatedForExplicitSort) {
                   .isUnconstrained());
   EXPECT_TRUE(subtree->getRootOperation()->getLimitOffset().isUnconstrained());
 }
+
+// _____________________________________________________________________________
+TEST(Sort, topKForExplicitSort) {
+  auto qec = ad_utility::testing::getQec();
+  auto inputTable =
+      makeIdTableFromVector({{3, 30}, {1, 10}, {5, 50}, {2, 20}, {4, 40}});
+  std::vector<std::optional<Variable>> vars = {Variable{"?x"}, Variable{"?y"}};
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(inputTable), vars);
+  auto tree = QueryExecutionTree::createSortedTree(subtree, {0}, true);
+  auto sort = std::dynamic_pointer_cast<Sort>(tree->getRootOperation());
+  ASSERT_NE(sort, nullptr);
+  sort->applyLimitOffset({2, 1});
+
+  // Only the first `LIMIT + OFFSET` rows are computed ...
+  auto topK = sort->computeResultOnlyForTesting();
+  EXPECT_EQ(topK.idTable(), makeIdTableFromVector({{1, 10}, {2, 20}, {3, 30}}));
+
+  // ... and the `LIMIT` and `OFFSET` are applied afterwards.
+  auto result = sort->getResult();
+  EXPECT_EQ(result->idTable(), makeIdTableFromVector({{2, 20}, {3, 30}}));
+
+  // If the limit is too large, the complete input is sorted.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::sortTopKMaxNumRows_>(2);
+  EXPECT_EQ(sort->computeResultOnlyForTesting().idTable().numRows(), 5u);
+}
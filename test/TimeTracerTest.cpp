@@ -102,3 +102,35 @@ TEST(TimeTracerTest, reset) {
       tracer.getJSONShort(),
       HasKeyMatching("test", testing::AllOf(HasKey("total"), HasKey("f"))));
 }
+
+TEST(TimeTracerTest, addFinishedTrace) {
+  ad_utility::timer::TimeTracer tracer("test");
+  tracer.beginTrace("parallel");
+  ad_utility::timer::TimeTracer child1("child1", tracer);
+  ad_utility::timer::TimeTracer child2("child2", tracer);
+  child1.beginTrace("a");
+  child1.endTrace("a");
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      tracer.addFinishedTrace(child1),
+      testing::HasSubstr("Tried to add trace \"child1\", which has not yet"));
+  child1.endTrace("child1");
+  child2.endTrace("child2");
+  tracer.addFinishedTrace(child1);
+  tracer.addFinishedTrace(child2);
+  tracer.endTrace("parallel");
+  tracer.endTrace("test");
+  EXPECT_THAT(
+      tracer.getJSONShort(),
+      HasKeyMatching(
+          "test",
+          HasKeyMatching("parallel",
+                         testing::AllOf(HasKeyMatching("child1", HasKey("a")),
+                                        HasKey("child2")))));
+  AD_EXPECT_THROW_WITH_MESSAGE(tracer.addFinishedTrace(child1),
+                               testing::HasSubstr("The trace has ended."));
+
+  // The `DefaultTimeTracer` ignores the added traces.
+  ad_utility::timer::DefaultTimeTracer defaultTracer("default");
+  defaultTracer.addFinishedTrace(child1);
+  EXPECT_THAT(defaultTracer.getJSONShort(), testing::IsEmpty());
+}
@@ -7,18 +7,26 @@
 
 #include <limits>
 #include <memory>
+#include <random>
 
 #include "./util/IdTestHelpers.h"
 #include "./util/IndexTestHelpers.h"
+#include "engine/IndexScan.h"
+#include "engine/MaterializedViews.h"
+#include "engine/NamedResultCache.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/TransitivePathBase.h"
 #include "engine/TransitivePathBinSearch.h"
 #include "engine/TransitivePathHashMap.h"
+#include "engine/TransitivePathMultiSourceBfs.h"
 #include "engine/ValuesForTesting.h"
+#include "index/IndexImpl.h"
+#include "util/File.h"
 #include "util/GTestHelpers.h"
 #include "util/IdTableHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using ad_utility::testing::getQec;
 namespace {
@@ -1906,6 +1914,189 @@ TEST_P(TransitivePathTest, sortOrderGuaranteesWithBoundOperation) {
   }
 }
 
+// _____________________________________________________________________________
+TEST_P(TransitivePathTest, multiSourceBfsMatchesGraphSearch) {
+  // A random graph with many cycles, and many start nodes (some of which are
+  // not contained in the graph, and one of which is undefined).
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<uint64_t> node{0, 39};
+  IdTable sub{2, ad_utility::testing::makeAllocator()};
+  for (size_t i = 0; i < 60; ++i) {
+    sub.push_back(std::array{V(node(rng)), V(node(rng))});
+  }
+  IdTable sideTable{2, ad_utility::testing::makeAllocator()};
+  for (size_t i = 0; i < 150; ++i) {
+    sideTable.push_back(std::array{V(100 + i), V(node(rng) + 5)});
+  }
+  sideTable.push_back(std::array{V(1000), U});
+
+  TransitivePathSide left(std::nullopt, 0, Variable{"?start"}, 0);
+  TransitivePathSide right(std::nullopt, 1, Variable{"?target"}, 1);
+  Vars vars{Variable{"?start"}, Variable{"?target"}};
+  auto computeBound = [&](size_t minDist) {
+    auto T = makePathBound(true, sub.clone(), vars, sideTable.clone(), 1,
+                           {Variable{"?x"}, Variable{"?start"}}, left, right,
+                           minDist, std::numeric_limits<size_t>::max());
+    return T->computeResultOnlyForTesting(requestLaziness());
+  };
+  auto computeUnbound = [&]() {
+    auto T = makePathUnbound(sub.clone(), vars, left, right, 1,
+                             std::numeric_limits<size_t>::max());
+    return T->computeResultOnlyForTesting(requestLaziness());
+  };
+  auto toIdTable = [](const Result& result, size_t numColumns) {
+    return result.isFullyMaterialized()
+               ? result.idTable().clone()
+               : aggregateTables(result.idTables(), numColumns).first;
+  };
+
+  // The results of the graph search per start node.
+  IdTable expectedUnbound{2, ad_utility::testing::makeAllocator()};
+  std::vector<IdTable> expectedBound;
+  {
+    auto disable = setRuntimeParameterForTest<
+        &RuntimeParameters::transitivePathMultiSourceBfsBatchSize_>(0);
+    expectedUnbound = toIdTable(computeUnbound(), 2);
+    for (size_t minDist : {0, 1}) {
+      expectedBound.push_back(toIdTable(computeBound(minDist), 3));
+    }
+  }
+  EXPECT_FALSE(expectedUnbound.empty());
+
+  // The batch size and the number of threads.
+  using Config = std::pair<size_t, size_t>;
+  for (auto [batchSize, numThreads] :
+       std::vector<Config>{{64, 1}, {64, 3}, {128, 2}, {512, 0}}) {
+    auto setBatchSize = setRuntimeParameterForTest<
+        &RuntimeParameters::transitivePathMultiSourceBfsBatchSize_>(batchSize);
+    auto setNumThreads = setRuntimeParameterForTest<
+        &RuntimeParameters::transitivePathMultiSourceBfsNumThreads_>(
+        numThreads);
+    assertResultMatchesIdTable(computeUnbound(), expectedUnbound);
+    for (size_t minDist : {0, 1}) {
+      assertResultMatchesIdTable(computeBound(minDist),
+                                 expectedBound.at(minDist));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST_P(TransitivePathTest, multiSourceBfsOnlyForManyStartNodes) {
+  IdTable sub{2, ad_utility::testing::makeAllocator()};
+  for (size_t i = 0; i < 100; ++i) {
+    sub.push_back(std::array{V(i), V((i + 1) % 100)});
+  }
+  TransitivePathSide left(std::nullopt, 0, Variable{"?start"}, 0);
+  TransitivePathSide right(std::nullopt, 1, Variable{"?target"}, 1);
+  Vars vars{Variable{"?start"}, Variable{"?target"}};
+  // Bind the start side to `numStartNodes` nodes of the cycle, and return
+  // whether the graph for the multi-source BFS was built.
+  auto buildsCondensedGraph = [&](size_t numStartNodes) {
+    IdTable sideTable{2, ad_utility::testing::makeAllocator()};
+    for (size_t i = 0; i < numStartNodes; ++i) {
+      sideTable.push_back(std::array{V(1000 + i), V(i)});
+    }
+    auto T = makePathBound(true, sub.clone(), vars, std::move(sideTable), 1,
+                           {Variable{"?x"}, Variable{"?start"}}, left, right,
+                           1, std::numeric_limits<size_t>::max());
+    auto result = T->computeResultOnlyForTesting(requestLaziness());
+    size_t numRows =
+        result.isFullyMaterialized()
+            ? result.idTable().numRows()
+            : aggregateTables(result.idTables(), 3).first.numRows();
+    EXPECT_EQ(numRows, numStartNodes * 100);
+    return T->runtimeInfo().details_.contains(
+        "Number of strongly connected components");
+  };
+  auto setBatchSize = setRuntimeParameterForTest<
+      &RuntimeParameters::transitivePathMultiSourceBfsBatchSize_>(64);
+  EXPECT_FALSE(buildsCondensedGraph(1));
+  EXPECT_FALSE(buildsCondensedGraph(63));
+  EXPECT_TRUE(buildsCondensedGraph(64));
+}
+
+// _____________________________________________________________________________
+TEST_P(TransitivePathTest, reachabilityIndexMatchesGraphSearch) {
+  std::string basename = "TransitivePathReachabilityIndex";
+  auto index = std::make_shared<Index>(ad_utility::testing::makeTestIndex(
+      basename, "<a> <sub> <b> . <b> <sub> <c> . <c> <sub> <b> . "
+                "<d> <sub> <a> . <a> <other> <d> ."));
+  auto getId = ad_utility::testing::makeGetId(*index);
+  index->getImpl().buildReachabilityIndex("<sub>");
+  ad_utility::deleteFile(basename + ".reachability-index");
+
+  // Compute `?x <sub>+ ?y` (or `?x <sub>* ?y`) with `?x` bound to some nodes
+  // of the graph and to `<other>`, which is not part of the graph. A new
+  // context (and cache) is created for each computation, s.t. the delta
+  // triples are taken into account.
+  auto compute = [&](size_t minDist, bool expectIndex) {
+    QueryResultCache cache;
+    NamedResultCache namedCache;
+    auto materializedViewsManager =
+        std::make_shared<MaterializedViewsManager>();
+    QueryExecutionContext qec{
+        index,
+        &cache,
+        ad_utility::testing::makeAllocator(
+            ad_utility::MemorySize::megabytes(100)),
+        SortPerformanceEstimator{},
+        &namedCache,
+        materializedViewsManager};
+    SparqlTripleSimple scanTriple{Variable{"?_s"},
+                                  TripleComponent::Iri::fromIriref("<sub>"),
+                                  Variable{"?_o"}};
+    auto subtree = ad_utility::makeExecutionTree<IndexScan>(
+        &qec, Permutation::Enum::PSO, scanTriple);
+    TransitivePathSide left(std::nullopt, 0, Variable{"?x"}, 0);
+    TransitivePathSide right(std::nullopt, 1, Variable{"?y"}, 1);
+    auto path = TransitivePathBase::makeTransitivePath(
+        &qec, std::move(subtree), std::move(left), std::move(right), minDist,
+        std::numeric_limits<size_t>::max(), std::get<0>(GetParam()),
+        qlever::index::GraphFilter<TripleComponent>::All());
+    auto side = ad_utility::makeExecutionTree<ValuesForTesting>(
+        &qec,
+        makeIdTableFromVector(
+            {{getId("<a>")}, {getId("<d>")}, {getId("<other>")}}),
+        Vars{Variable{"?x"}});
+    auto boundPath = path->bindLeftSide(side, 0);
+    auto result = boundPath->computeResultOnlyForTesting(requestLaziness());
+    EXPECT_EQ(boundPath->runtimeInfo().details_.contains("Reachability index"),
+              expectIndex);
+    return requestLaziness() ? aggregateTables(result.idTables(), 2).first
+                             : result.idTable().clone();
+  };
+
+  for (size_t minDist : {0, 1}) {
+    IdTable expected{2, ad_utility::testing::makeAllocator()};
+    {
+      auto disable = setRuntimeParameterForTest<
+          &RuntimeParameters::transitivePathUseReachabilityIndex_>(false);
+      expected = compute(minDist, false);
+    }
+    EXPECT_THAT(compute(minDist, true), UnorderedElementsAreArray(expected));
+  }
+  auto expected = makeIdTableFromVector(
+      {{getId("<a>"), getId("<b>")},
+       {getId("<a>"), getId("<c>")},
+       {getId("<d>"), getId("<a>")},
+       {getId("<d>"), getId("<b>")},
+       {getId("<d>"), getId("<c>")}});
+  EXPECT_THAT(compute(1, true), UnorderedElementsAreArray(expected));
+
+  // With delta triples, the index no longer reflects the graph and is not used.
+  auto cancellationHandle =
+      std::make_shared<ad_utility::SharedCancellationHandle::element_type>();
+  auto g = qlever::specialIds().at(QLEVER_INTERNAL_GRAPH_IRI);
+  index->deltaTriplesManager().modify<void>([&](DeltaTriples& deltaTriples) {
+    deltaTriples.insertTriples(
+        cancellationHandle,
+        {IdTriple<0>{std::array{getId("<c>"), getId("<sub>"),
+                                getId("<other>"), g}}});
+  });
+  auto withDeltaTriples = compute(1, false);
+  EXPECT_EQ(withDeltaTriples.numRows(), 7u);
+}
+
 // _____________________________________________________________________________
 INSTANTIATE_TEST_SUITE_P(
     TransitivePathTestSuite, TransitivePathTest,
@@ -2136,3 +2327,111 @@ TEST(TransitivePathHashMap, getEquivalentIdAndMatchingGraphsWithGraphs) {
                 UnorderedElementsAre());
   }
 }
+
+// _____________________________________________________________________________
+TEST(TransitivePathMultiSourceBfs, condensedGraph) {
+  using namespace qlever::graphSearch;
+  auto toVector = [](auto span) {
+    return std::vector(span.begin(), span.end());
+  };
+  // The nodes 1, 2, 3 form a cycle, and 4 has an edge to itself.
+  auto edges = makeIdTableFromVector(
+      {{1, 2}, {2, 3}, {3, 1}, {3, 4}, {4, 4}, {4, 5}, {6, 5}, {1, 5}, {2, 4}});
+  CondensedGraph graph{edges.getColumn(0), edges.getColumn(1),
+                       ad_utility::testing::makeAllocator(), []() {}};
+  EXPECT_EQ(graph.numNodes(), 6u);
+  EXPECT_EQ(graph.numComponents(), 4u);
+  auto cycle = graph.getComponent(V(1)).value();
+  auto loop = graph.getComponent(V(4)).value();
+  auto sink = graph.getComponent(V(5)).value();
+  auto source = graph.getComponent(V(6)).value();
+  EXPECT_EQ(graph.getComponent(V(2)), cycle);
+  EXPECT_EQ(graph.getComponent(V(3)), cycle);
+  EXPECT_FALSE(graph.getComponent(V(7)).has_value());
+  EXPECT_THAT(toVector(graph.nodesOfComponent(cycle)),
+              UnorderedElementsAre(V(1), V(2), V(3)));
+  EXPECT_THAT(toVector(graph.nodesOfComponent(sink)), ElementsAre(V(5)));
+
+  EXPECT_TRUE(graph.isCyclic(cycle));
+  EXPECT_TRUE(graph.isCyclic(loop));
+  EXPECT_FALSE(graph.isCyclic(sink));
+  EXPECT_FALSE(graph.isCyclic(source));
+
+  // The edges of the DAG are deduplicated and go from larger to smaller
+  // component indices.
+  EXPECT_THAT(toVector(graph.successorsOfComponent(cycle)),
+              UnorderedElementsAre(loop, sink));
+  EXPECT_THAT(toVector(graph.successorsOfComponent(loop)), ElementsAre(sink));
+  EXPECT_TRUE(graph.successorsOfComponent(sink).empty());
+  EXPECT_THAT(toVector(graph.successorsOfComponent(source)),
+              ElementsAre(sink));
+  for (CondensedGraph::Component c = 0; c < graph.numComponents(); ++c) {
+    for (auto successor : graph.successorsOfComponent(c)) {
+      EXPECT_LT(successor, c);
+    }
+  }
+
+  // A long cycle, which would overflow the stack of a recursive
+  // implementation.
+  IdTable longCycle{2, ad_utility::testing::makeAllocator()};
+  const size_t numNodes = 100'000;
+  for (size_t i = 0; i < numNodes; ++i) {
+    longCycle.push_back(std::array{V(i), V((i + 1) % numNodes)});
+  }
+  CondensedGraph longGraph{longCycle.getColumn(0), longCycle.getColumn(1),
+                           ad_utility::testing::makeAllocator(), []() {}};
+  EXPECT_EQ(longGraph.numNodes(), numNodes);
+  EXPECT_EQ(longGraph.numComponents(), 1u);
+  EXPECT_TRUE(longGraph.isCyclic(0));
+}
+
+// _____________________________________________________________________________
+TEST(TransitivePathMultiSourceBfs, computeReachableNodes) {
+  using namespace qlever::graphSearch;
+  auto edges = makeIdTableFromVector(
+      {{1, 2}, {2, 3}, {3, 1}, {3, 4}, {4, 4}, {4, 5}, {6, 5}});
+  CondensedGraph graph{edges.getColumn(0), edges.getColumn(1),
+                       ad_utility::testing::makeAllocator(), []() {}};
+  EXPECT_ANY_THROW(
+      MultiSourceBfs(graph, 100, ad_utility::testing::makeAllocator()));
+  EXPECT_ANY_THROW(
+      MultiSourceBfs(graph, 0, ad_utility::testing::makeAllocator()));
+
+  MultiSourceBfs bfs{graph, 128, ad_utility::testing::makeAllocator()};
+  EXPECT_EQ(bfs.batchSize(), 128u);
+  // The start nodes 1, 4, 5, 6, 7 (which is not contained in the graph),
+  // repeated s.t. the batch uses more than one word per component.
+  std::vector<Id> startNodes;
+  for (size_t i = 0; i < 100; ++i) {
+    startNodes.push_back(std::array{V(1), V(4), V(5), V(6), V(7)}[i % 5]);
+  }
+  EXPECT_ANY_THROW(bfs.computeReachableNodes(startNodes, 2, []() {}));
+
+  // Run each search twice to check that the state is reset between batches.
+  for (size_t run = 0; run < 2; ++run) {
+    auto hulls = bfs.computeReachableNodes(startNodes, 1, []() {});
+    ASSERT_EQ(hulls.size(), startNodes.size());
+    for (size_t i = 0; i < hulls.size(); i += 5) {
+      EXPECT_THAT(hulls[i], UnorderedElementsAre(V(1), V(2), V(3), V(4), V(5)));
+      EXPECT_THAT(hulls[i + 1], UnorderedElementsAre(V(4), V(5)));
+      EXPECT_THAT(hulls[i + 2], UnorderedElementsAre());
+      EXPECT_THAT(hulls[i + 3], UnorderedElementsAre(V(5)));
+      EXPECT_THAT(hulls[i + 4], UnorderedElementsAre());
+    }
+
+    hulls = bfs.computeReachableNodes(startNodes, 0, []() {});
+    ASSERT_EQ(hulls.size(), startNodes.size());
+    for (size_t i = 0; i < hulls.size(); i += 5) {
+      EXPECT_THAT(hulls[i], UnorderedElementsAre(V(1), V(2), V(3), V(4), V(5)));
+      EXPECT_THAT(hulls[i + 1], UnorderedElementsAre(V(4), V(5)));
+      EXPECT_THAT(hulls[i + 2], UnorderedElementsAre(V(5)));
+      EXPECT_THAT(hulls[i + 3], UnorderedElementsAre(V(5), V(6)));
+      EXPECT_THAT(hulls[i + 4], UnorderedElementsAre(V(7)));
+    }
+  }
+
+  // Cancellation is checked once per level of the search.
+  EXPECT_THROW(bfs.computeReachableNodes(
+                   startNodes, 1, []() { throw std::runtime_error{"cancel"}; }),
+               std::runtime_error);
+}
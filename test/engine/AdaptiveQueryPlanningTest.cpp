@@ -0,0 +1,188 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/cleanup/cleanup.h>
+#include <gmock/gmock.h>
+
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "./ValuesForTesting.h"
+#include "engine/AdaptiveQueryPlanning.h"
+#include "engine/Join.h"
+#include "engine/QueryExecutionTree.h"
+
+using namespace ad_utility::testing;
+using namespace qlever::adaptiveQueryPlanning;
+
+namespace {
+using Vars = std::vector<std::optional<Variable>>;
+
+// The plan `(A JOIN B) JOIN C` on the variable `?x`. The inner join has two
+// rows, but its estimate is much larger, because the estimates of `A` and `B`
+// are. If `lazyInputs` is true, `A`, `B`, and `C` can be computed lazily (and
+// then so can the inner join).
+QueryExecutionTree makePlan(QueryExecutionContext* qec,
+                            bool lazyInputs = false) {
+  auto values = [qec, lazyInputs](IdTable table, size_t sizeEstimate) {
+    auto tree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(table), Vars{Variable{"?x"}}, false,
+        std::vector<ColumnIndex>{0}, LocalVocab{}, std::nullopt, !lazyInputs);
+    static_cast<ValuesForTesting&>(*tree->getRootOperation()).sizeEstimate() =
+        sizeEstimate;
+    return tree;
+  };
+  auto innerJoin = ad_utility::makeExecutionTree<Join>(
+      qec, values(makeIdTableFromVector({{1}, {2}, {3}}), 1'000'000),
+      values(makeIdTableFromVector({{2}, {3}, {4}}), 1'000'000), 0, 0);
+  return QueryExecutionTree{
+      qec, std::make_shared<Join>(
+               qec, innerJoin, values(makeIdTableFromVector({{2}}), 1), 0, 0)};
+}
+
+// Return the child of the root of the `tree` that is a `Join`.
+QueryExecutionTree& getInnerJoin(QueryExecutionTree& tree) {
+  for (auto* child : tree.getRootOperation()->getChildren()) {
+    if (dynamic_cast<const Join*>(child->getRootOperation().get())) {
+      return *child;
+    }
+  }
+  throw std::runtime_error("The plan has no inner join");
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(AdaptiveQueryPlanning, isMisestimated) {
+  EXPECT_FALSE(isMisestimated(100, 1000, 10.0));
+  EXPECT_TRUE(isMisestimated(100, 1001, 10.0));
+  EXPECT_TRUE(isMisestimated(1001, 100, 10.0));
+  // Sizes of zero count as one.
+  EXPECT_FALSE(isMisestimated(0, 10, 10.0));
+  EXPECT_TRUE(isMisestimated(0, 11, 10.0));
+  EXPECT_FALSE(isMisestimated(10, 0, 10.0));
+  // A factor of zero disables the check.
+  EXPECT_FALSE(isMisestimated(1, 1'000'000, 0.0));
+}
+
+// _____________________________________________________________________________
+TEST(AdaptiveQueryPlanning, findNextMaterializationPoint) {
+  auto* qec = getQec();
+  qec->clearCacheUnpinnedOnly();
+  auto plan = makePlan(qec);
+  ad_utility::HashSet<std::string> computedCacheKeys;
+  auto& innerJoin = getInnerJoin(plan);
+  EXPECT_EQ(findNextMaterializationPoint(plan, computedCacheKeys), &innerJoin);
+  // The root itself is never returned.
+  computedCacheKeys.insert(innerJoin.getCacheKey());
+  EXPECT_EQ(findNextMaterializationPoint(plan, computedCacheKeys), nullptr);
+}
+
+// _____________________________________________________________________________
+TEST(AdaptiveQueryPlanning, planAdaptively) {
+  auto* qec = getQec();
+  size_t numPlans = 0;
+  size_t numPrepared = 0;
+  auto plan = [&numPlans, qec]() {
+    ++numPlans;
+    return makePlan(qec);
+  };
+  auto prepare = [&numPrepared](QueryExecutionTree&) { ++numPrepared; };
+  auto reset = [&]() {
+    qec->clearCacheUnpinnedOnly();
+    numPlans = 0;
+    numPrepared = 0;
+  };
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::adaptiveReoptimizationFactor_>(10.0);
+
+  // Adaptive planning is disabled.
+  reset();
+  planAdaptively(plan, prepare, 0.0);
+  EXPECT_EQ(numPlans, 1);
+  EXPECT_EQ(numPrepared, 0);
+
+  // The inner join is computed and is misestimated, so the query is planned
+  // again. The new plan uses the cached result of the inner join with its exact
+  // size and zero cost.
+  reset();
+  auto tree = planAdaptively(plan, prepare, 10.0);
+  EXPECT_EQ(numPlans, 2);
+  EXPECT_EQ(numPrepared, 1);
+  auto& innerJoin = getInnerJoin(tree);
+  EXPECT_TRUE(innerJoin.isCached());
+  EXPECT_EQ(innerJoin.getSizeEstimate(), 2);
+  EXPECT_EQ(innerJoin.getCostEstimate(), 0);
+  EXPECT_EQ(tree.getResult()->idTable(), makeIdTableFromVector({{2}}));
+
+  // The inner join is computed, but its estimate is within the factor.
+  reset();
+  planAdaptively(plan, prepare, 1e9);
+  EXPECT_EQ(numPlans, 1);
+  EXPECT_EQ(numPrepared, 1);
+
+  // The inner join is misestimated, but its result is too large for the cache.
+  // The query is not planned again, and the plan gets the computed result.
+  reset();
+  {
+    auto& cache = qec->getQueryTreeCache();
+    absl::Cleanup restoreMaxSize{
+        [&cache, original = cache.getMaxSizeSingleEntry()]() {
+          cache.setMaxSizeSingleEntry(original);
+        }};
+    cache.setMaxSizeSingleEntry(ad_utility::MemorySize::bytes(0));
+    auto uncachedTree = planAdaptively(plan, prepare, 10.0);
+    EXPECT_EQ(numPlans, 1);
+    EXPECT_EQ(numPrepared, 1);
+    auto& uncachedInnerJoin = getInnerJoin(uncachedTree);
+    EXPECT_FALSE(uncachedInnerJoin.isCached());
+    EXPECT_TRUE(uncachedInnerJoin.getRootOperation()
+                    ->precomputedResultFromAdaptivePlanning()
+                    .has_value());
+    EXPECT_EQ(uncachedTree.getResult()->idTable(),
+              makeIdTableFromVector({{2}}));
+  }
+
+  // The inner join is misestimated, but its result is lazy, so it is not
+  // consumed during planning and the query is not planned again.
+  reset();
+  {
+    auto lazyTree = planAdaptively(
+        [&numPlans, qec]() {
+          ++numPlans;
+          return makePlan(qec, true);
+        },
+        prepare, 10.0);
+    EXPECT_EQ(numPlans, 1);
+    EXPECT_EQ(numPrepared, 1);
+    auto& lazyInnerJoin = getInnerJoin(lazyTree);
+    EXPECT_FALSE(lazyInnerJoin.isCached());
+    EXPECT_FALSE(lazyInnerJoin.getRootOperation()
+                     ->precomputedResultFromAdaptivePlanning()
+                     .has_value());
+    EXPECT_EQ(lazyTree.getResult()->idTable(), makeIdTableFromVector({{2}}));
+  }
+
+  // The inner join is misestimated, but has a `LIMIT`, so it is not computed
+  // in advance.
+  reset();
+  planAdaptively(
+      [&numPlans, qec]() {
+        ++numPlans;
+        auto tree = makePlan(qec);
+        getInnerJoin(tree).applyLimitOffset(LimitOffsetClause{1});
+        return tree;
+      },
+      prepare, 10.0);
+  EXPECT_EQ(numPlans, 1);
+  EXPECT_EQ(numPrepared, 0);
+
+  // Without a cache, the computed results can't be reused.
+  reset();
+  qec->setDisableCachingOnlyForTesting(true);
+  planAdaptively(plan, prepare, 10.0);
+  qec->setDisableCachingOnlyForTesting(false);
+  EXPECT_EQ(numPlans, 1);
+  EXPECT_EQ(numPrepared, 0);
+}
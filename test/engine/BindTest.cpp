@@ -2,11 +2,13 @@
 //   Chair of Algorithms and Data Structures.
 //   Author: Robin Textor-Falconi <textorr@informatik.uni-freiburg.de>
 
+#include <absl/strings/str_cat.h>
 #include <gtest/gtest.h>
 
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
 #include "../util/OperationTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "./ValuesForTesting.h"
 #include "engine/Bind.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
@@ -134,6 +136,42 @@ TEST(
   }
 }
 
+// _____________________________________________________________________________
+TEST(Bind, morselParallelEvaluation) {
+  auto cleanup1 = setRuntimeParameterForTest<
+      &RuntimeParameters::expressionEvaluationNumThreads_>(4);
+  auto cleanup2 = setRuntimeParameterForTest<
+      &RuntimeParameters::expressionEvaluationMorselSize_>(3);
+  auto* qec = ad_utility::testing::getQec();
+  IdTable input{1, ad_utility::makeUnlimitedAllocator<Id>()};
+  for (int64_t i = 0; i < 10; ++i) {
+    input.push_back({Id::makeFromInt(i)});
+  }
+  // `STR(?a)` creates a new word in the local vocab for each row, so the local
+  // vocabs of all the morsels have to be part of the result.
+  Bind bind{qec,
+            ad_utility::makeExecutionTree<ValuesForTesting>(
+                qec, std::move(input), Vars{Variable{"?a"}}),
+            {SparqlExpressionPimpl{
+                 makeStrExpression(
+                     std::make_unique<VariableExpression>(Variable{"?a"})),
+                 "STR(?a) as ?b"},
+             Variable{"?b"}}};
+  qec->getQueryTreeCache().clearAll();
+  auto result = bind.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+  ASSERT_TRUE(result->isFullyMaterialized());
+  const auto& table = result->idTable();
+  ASSERT_EQ(table.numRows(), 10u);
+  EXPECT_EQ(result->localVocab().size(), 10u);
+  for (int64_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(table(i, 0), Id::makeFromInt(i));
+    Id id = table(i, 1);
+    ASSERT_EQ(id.getDatatype(), Datatype::LocalVocabIndex);
+    EXPECT_EQ(id.getLocalVocabIndex()->toStringRepresentation(),
+              absl::StrCat("\"", i, "\""));
+  }
+}
+
 // _____________________________________________________________________________
 TEST(Bind, clone) {
   auto* qec = ad_utility::testing::getQec();
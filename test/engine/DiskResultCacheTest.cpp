@@ -0,0 +1,247 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "./ValuesForTesting.h"
+#include "absl/cleanup/cleanup.h"
+#include "engine/DiskResultCache.h"
+#include "engine/QueryExecutionTree.h"
+
+using namespace ad_utility::testing;
+using namespace ad_utility::memory_literals;
+using ad_utility::MemorySize;
+
+namespace {
+// A fresh (empty) directory for a `DiskResultCache`.
+std::filesystem::path makeEmptyDirectory(std::string_view name) {
+  auto directory = std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove_all(directory);
+  return directory;
+}
+
+// The result with the rows `0, 1, ..., numRows - 1` in the first column and
+// the same values times two in the second column, sorted by both columns.
+Result makeResult(int64_t numRows) {
+  IdTable idTable{2, makeAllocator()};
+  for (int64_t i = 0; i < numRows; ++i) {
+    idTable.push_back({IntId(i), IntId(2 * i)});
+  }
+  return Result{std::move(idTable), {0, 1}, LocalVocab{}};
+}
+
+// Read the `result` completely (lazily or not) into a single `IdTable`. For
+// a lazy result without any blocks, the `IdTable` has no columns.
+IdTable materialize(const Result& result) {
+  if (result.isFullyMaterialized()) {
+    return result.idTable().clone();
+  }
+  std::optional<IdTable> idTable;
+  for (auto& [block, localVocab] : result.idTables()) {
+    EXPECT_TRUE(localVocab.empty());
+    if (!idTable.has_value()) {
+      idTable = std::move(block);
+    } else {
+      idTable->insertAtEnd(block);
+    }
+  }
+  return std::move(idTable).value_or(IdTable{0, makeAllocator()});
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(DiskResultCache, writeAndRead) {
+  auto directory = makeEmptyDirectory("DiskResultCacheTest_writeAndRead");
+  DiskResultCache cache{directory, 1_GB};
+  auto result = makeResult(1000);
+  EXPECT_FALSE(cache.contains("key", "index"));
+  EXPECT_FALSE(cache.read("key", "index", false, makeAllocator()).has_value());
+  EXPECT_TRUE(cache.tryWrite("key", "index", result));
+  EXPECT_TRUE(cache.contains("key", "index"));
+  // An existing entry is not written again.
+  EXPECT_FALSE(cache.tryWrite("key", "index", result));
+  EXPECT_TRUE(std::filesystem::exists(
+      directory / DiskResultCache::fileName("key", "index")));
+
+  for (bool lazy : {false, true}) {
+    auto fromDisk = cache.read("key", "index", lazy, makeAllocator());
+    ASSERT_TRUE(fromDisk.has_value());
+    EXPECT_EQ(fromDisk->isFullyMaterialized(), !lazy);
+    EXPECT_THAT(fromDisk->sortedBy(), ::testing::ElementsAre(0, 1));
+    EXPECT_THAT(materialize(fromDisk.value()),
+                matchesIdTable(result.idTable()));
+  }
+
+  // The index fingerprint is part of the key.
+  EXPECT_FALSE(cache.contains("key", "otherIndex"));
+  EXPECT_FALSE(
+      cache.read("key", "otherIndex", false, makeAllocator()).has_value());
+
+  // Empty results and results without columns are also supported.
+  EXPECT_TRUE(cache.tryWrite("empty", "index", makeResult(0)));
+  auto empty = cache.read("empty", "index", true, makeAllocator());
+  ASSERT_TRUE(empty.has_value());
+  EXPECT_EQ(materialize(empty.value()).numRows(), 0u);
+  Result noColumns{IdTable{0, makeAllocator()}, {}, LocalVocab{}};
+  EXPECT_TRUE(cache.tryWrite("noColumns", "index", noColumns));
+
+  // Results with a local vocab are not written.
+  LocalVocab localVocab;
+  localVocab.getIndexAndAddIfNotContained(
+      LocalVocabEntry::literalWithoutQuotes("local"));
+  Result withLocalVocab{makeIdTableFromVector({{1}}), {},
+                        std::move(localVocab)};
+  EXPECT_FALSE(cache.tryWrite("localVocab", "index", withLocalVocab));
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries_, 3u);
+  EXPECT_EQ(stats.numWrites_, 3u);
+  EXPECT_EQ(stats.numHits_, 3u);
+  EXPECT_EQ(stats.numMisses_, 2u);
+  EXPECT_GT(stats.totalSize_, 0_B);
+
+  cache.clear();
+  EXPECT_FALSE(cache.contains("key", "index"));
+  EXPECT_EQ(cache.stats().totalSize_, 0_B);
+  EXPECT_TRUE(std::filesystem::is_empty(directory));
+  std::filesystem::remove_all(directory);
+}
+
+// _____________________________________________________________________________
+TEST(DiskResultCache, writeInBackground) {
+  auto directory = makeEmptyDirectory("DiskResultCacheTest_background");
+  {
+    DiskResultCache cache{directory, 1_GB};
+    auto result = std::make_shared<const Result>(makeResult(1000));
+    for (size_t i = 0; i < 3; ++i) {
+      cache.writeInBackground(absl::StrCat("key", i), "index", result);
+    }
+    // The same result is only written once.
+    cache.writeInBackground("key0", "index", result);
+    cache.waitForPendingWrites();
+    EXPECT_EQ(cache.stats().numWrites_, 3u);
+    for (size_t i = 0; i < 3; ++i) {
+      auto fromDisk = cache.read(absl::StrCat("key", i), "index", false,
+                                 makeAllocator());
+      ASSERT_TRUE(fromDisk.has_value());
+      EXPECT_THAT(fromDisk->idTable(), matchesIdTable(result->idTable()));
+    }
+    // The pending writes are finished when the cache is destroyed.
+    cache.writeInBackground("last", "index", result);
+  }
+  DiskResultCache cache{directory, 1_GB};
+  EXPECT_TRUE(cache.contains("last", "index"));
+  std::filesystem::remove_all(directory);
+}
+
+// _____________________________________________________________________________
+TEST(DiskResultCache, entriesSurviveRestart) {
+  auto directory = makeEmptyDirectory("DiskResultCacheTest_restart");
+  auto result = makeResult(100);
+  {
+    DiskResultCache cache{directory, 1_GB};
+    EXPECT_TRUE(cache.tryWrite("key", "index", result));
+  }
+  // Files that are not cache entries or have another format are ignored, and
+  // leftovers from interrupted writes are removed.
+  std::ofstream{directory / "unrelated.txt"} << "unrelated";
+  std::ofstream{directory /
+                absl::StrCat("wrong", DiskResultCache::fileExtension)}
+      << "not a cached result";
+  auto temporaryFile = directory / absl::StrCat(
+      "x", DiskResultCache::fileExtension, ".tmp-0");
+  std::ofstream{temporaryFile} << "incomplete";
+
+  DiskResultCache cache{directory, 1_GB};
+  EXPECT_EQ(cache.stats().numEntries_, 1u);
+  EXPECT_FALSE(std::filesystem::exists(temporaryFile));
+  auto fromDisk = cache.read("key", "index", false, makeAllocator());
+  ASSERT_TRUE(fromDisk.has_value());
+  EXPECT_THAT(fromDisk->idTable(), matchesIdTable(result.idTable()));
+  std::filesystem::remove_all(directory);
+}
+
+// _____________________________________________________________________________
+TEST(DiskResultCache, eviction) {
+  auto directory = makeEmptyDirectory("DiskResultCacheTest_eviction");
+  DiskResultCache cache{directory, 1_GB};
+  for (std::string key : {"a", "b", "c"}) {
+    EXPECT_TRUE(cache.tryWrite(key, "index", makeResult(1000)));
+  }
+  // All the entries have the same size.
+  auto sizeOfOneEntry = cache.stats().totalSize_.getBytes() / 3;
+
+  // Reading an entry makes it the most recently used one.
+  EXPECT_TRUE(cache.read("a", "index", false, makeAllocator()).has_value());
+  cache.setMaxSize(MemorySize::bytes(2 * sizeOfOneEntry));
+  EXPECT_TRUE(cache.contains("a", "index"));
+  EXPECT_FALSE(cache.contains("b", "index"));
+  EXPECT_TRUE(cache.contains("c", "index"));
+
+  // Writing an entry evicts the least recently used entries.
+  EXPECT_TRUE(cache.tryWrite("d", "index", makeResult(1000)));
+  EXPECT_TRUE(cache.contains("a", "index"));
+  EXPECT_FALSE(cache.contains("c", "index"));
+  EXPECT_TRUE(cache.contains("d", "index"));
+  EXPECT_FALSE(std::filesystem::exists(
+      directory / DiskResultCache::fileName("c", "index")));
+
+  // Results that are larger than the cache are not written.
+  EXPECT_FALSE(cache.tryWrite("e", "index", makeResult(100'000)));
+  cache.setMaxSize(0_B);
+  EXPECT_EQ(cache.stats().numEntries_, 0u);
+  std::filesystem::remove_all(directory);
+}
+
+// _____________________________________________________________________________
+TEST(DiskResultCache, operationUsesDiskCache) {
+  auto directory = makeEmptyDirectory("DiskResultCacheTest_operation");
+  DiskResultCache cache{directory, 1_GB};
+  auto* qec = getQec();
+  qec->clearCacheUnpinnedOnly();
+  qec->setDiskResultCache(&cache);
+  absl::Cleanup resetDiskCache{[qec]() { qec->setDiskResultCache(nullptr); }};
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::diskCacheMinComputationTime_>(
+      std::chrono::milliseconds{0});
+
+  auto table = makeIdTableFromVector({{1, 2}, {3, 4}});
+  auto makeTree = [&]() {
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, table.clone(),
+        std::vector<std::optional<Variable>>{Variable{"?a"}, Variable{"?b"}});
+  };
+
+  // The first computation writes the result to the disk cache (in the
+  // background).
+  auto qet = makeTree();
+  auto result = qet->getResult();
+  EXPECT_THAT(result->idTable(), matchesIdTable(table));
+  cache.waitForPendingWrites();
+  EXPECT_EQ(cache.stats().numWrites_, 1u);
+  EXPECT_FALSE(qet->getRootOperation()->runtimeInfo().details_.contains(
+      "read-from-disk-cache"));
+
+  // When the result was evicted from the in-memory cache, it is read from
+  // the disk cache, also lazily.
+  for (bool lazy : {false, true}) {
+    qec->clearCacheUnpinnedOnly();
+    qet = makeTree();
+    result = qet->getResult(lazy);
+    EXPECT_THAT(materialize(*result), matchesIdTable(table));
+    EXPECT_TRUE(qet->getRootOperation()->runtimeInfo().details_.contains(
+        "read-from-disk-cache"));
+  }
+  EXPECT_EQ(cache.stats().numHits_, 2u);
+  EXPECT_EQ(cache.stats().numWrites_, 1u);
+  qec->clearCacheUnpinnedOnly();
+  std::filesystem::remove_all(directory);
+}
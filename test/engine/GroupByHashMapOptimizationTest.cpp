@@ -193,7 +193,8 @@ TEST_F(GroupByHashMapOptimizationTest, SumAggregationDataAggregatesCorrectly) {
 // _____________________________________________________________________________
 TEST_F(GroupByHashMapOptimizationTest,
        GroupConcatAggregationDataAggregatesCorrectly) {
-  GroupConcatAggregationData data{";"};
+  GroupConcatAggregationData data{
+      ";", ad_utility::makeUnlimitedAllocator<char>()};
   auto [calc, addValue] = makeCalcAndAddValue(data);
 
   auto getResultString = [&](bool stripQuotes = true) {
@@ -260,6 +261,22 @@ TEST_F(GroupByHashMapOptimizationTest,
   EXPECT_EQ(getResultString(false), "\"a;b\"");
 }
 
+// _____________________________________________________________________________
+TEST_F(GroupByHashMapOptimizationTest,
+       GroupConcatAggregationDataRespectsMemoryLimit) {
+  using namespace ad_utility::memory_literals;
+  auto allocator = ad_utility::makeAllocatorWithLimit<char>(100_B);
+  GroupConcatAggregationData data{";", allocator};
+  auto [calc, addValue] = makeCalcAndAddValue(data);
+  // Nothing is reserved up front.
+  EXPECT_EQ(allocator.amountMemoryLeft(), 100_B);
+
+  addValue(idFromString(std::string(40, 'a')));
+  EXPECT_LT(allocator.amountMemoryLeft(), 100_B);
+  EXPECT_THROW(addValue(idFromString(std::string(80, 'b'))),
+               ad_utility::detail::AllocationExceedsLimitException);
+}
+
 // _____________________________________________________________________________
 TEST_F(GroupByHashMapOptimizationTest,
        SampleAggregationDataAggregatesCorrectly) {
@@ -0,0 +1,204 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "./ValuesForTesting.h"
+#include "engine/HashJoin.h"
+#include "engine/QueryExecutionTree.h"
+
+using namespace ad_utility::testing;
+
+namespace {
+constexpr auto U = Id::makeUndefined();
+
+// Return the rows of the `table`, s.t. they can be compared without taking
+// the order into account.
+std::vector<std::vector<Id>> toRows(const IdTable& table) {
+  std::vector<std::vector<Id>> rows;
+  for (const auto& row : table) {
+    rows.emplace_back(row.begin(), row.end());
+  }
+  return rows;
+}
+
+// Create a `ValuesForTesting` operation for the `table` with the `variables`.
+// If `sizeEstimate` is set, it overrides the size estimate of the operation,
+// which determines the build side of the `HashJoin`.
+std::shared_ptr<QueryExecutionTree> makeValues(
+    QueryExecutionContext* qec, IdTable table,
+    std::vector<std::optional<Variable>> variables,
+    std::optional<size_t> sizeEstimate = std::nullopt) {
+  auto tree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(table), std::move(variables));
+  if (sizeEstimate.has_value()) {
+    static_cast<ValuesForTesting*>(tree->getRootOperation().get())
+        ->sizeEstimate() = sizeEstimate.value();
+  }
+  return tree;
+}
+
+// Join `left` (variables `?x ?a`) and `right` (variables `?b ?x`) once with
+// each side as the build side, and check that the result (in any order)
+// consists of the `expected` rows (variables `?x ?a ?b`).
+void testHashJoin(const IdTable& left, const IdTable& right,
+                  const IdTable& expected,
+                  ad_utility::source_location l = AD_CURRENT_SOURCE_LOC()) {
+  auto trace = generateLocationTrace(l);
+  auto* qec = getQec();
+  for (bool leftIsBuildSide : {true, false}) {
+    auto leftTree =
+        makeValues(qec, left.clone(), {Variable{"?x"}, Variable{"?a"}},
+                   leftIsBuildSide ? 1 : 1000);
+    auto rightTree =
+        makeValues(qec, right.clone(), {Variable{"?b"}, Variable{"?x"}},
+                   leftIsBuildSide ? 1000 : 1);
+    HashJoin join{qec, leftTree, rightTree, 0, 1, false};
+    EXPECT_EQ(join.leftIsBuildSide(), leftIsBuildSide);
+    EXPECT_EQ(join.getResultWidth(), 3u);
+    EXPECT_TRUE(join.resultSortedOn().empty());
+    auto result = join.computeResultOnlyForTesting();
+    EXPECT_THAT(toRows(result.idTable()),
+                ::testing::UnorderedElementsAreArray(toRows(expected)));
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(HashJoin, unsortedInputs) {
+  auto left = makeIdTableFromVector({{3, 30}, {2, 20}, {1, 10}, {2, 21}});
+  auto right = makeIdTableFromVector({{100, 2}, {101, 3}, {102, 4}, {103, 2}});
+  auto expected = makeIdTableFromVector({{2, 20, 100},
+                                         {2, 20, 103},
+                                         {2, 21, 100},
+                                         {2, 21, 103},
+                                         {3, 30, 101}});
+  testHashJoin(left, right, expected);
+
+  // No matches at all.
+  auto right2 = makeIdTableFromVector({{100, 7}, {101, 8}});
+  testHashJoin(left, right2, makeIdTableFromVector({}));
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, undefValues) {
+  auto left = makeIdTableFromVector({{U, 10}, {1, 11}});
+  auto right = makeIdTableFromVector({{100, 1}, {101, U}, {102, 2}});
+  // An UNDEF value matches every value, and the result contains the defined
+  // value if there is one.
+  auto expected = makeIdTableFromVector({{1, 10, 100},
+                                         {U, 10, 101},
+                                         {2, 10, 102},
+                                         {1, 11, 100},
+                                         {1, 11, 101}});
+  testHashJoin(left, right, expected);
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, lazyProbeSide) {
+  auto* qec = getQec();
+  auto left = makeValues(qec, makeIdTableFromVector({{2, 20}, {1, 10}}),
+                         {Variable{"?x"}, Variable{"?a"}});
+  std::vector<IdTable> blocks;
+  blocks.push_back(makeIdTableFromVector({{100, 1}, {101, 3}}));
+  blocks.push_back(makeIdTableFromVector({{102, 4}}));
+  blocks.push_back(makeIdTableFromVector({{103, 2}, {104, 1}}));
+  auto right = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(blocks),
+      std::vector<std::optional<Variable>>{Variable{"?b"}, Variable{"?x"}});
+  static_cast<ValuesForTesting*>(right->getRootOperation().get())
+      ->sizeEstimate() = 1000;
+  HashJoin join{qec, left, right, 0, 1, false};
+  ASSERT_TRUE(join.leftIsBuildSide());
+  auto expected = toRows(makeIdTableFromVector(
+      {{1, 10, 100}, {2, 20, 103}, {1, 10, 104}}));
+
+  // Fully materialized.
+  {
+    auto result = join.computeResultOnlyForTesting(false);
+    ASSERT_TRUE(result.isFullyMaterialized());
+    EXPECT_THAT(toRows(result.idTable()),
+                ::testing::UnorderedElementsAreArray(expected));
+  }
+
+  // Lazy, the blocks without a match are skipped.
+  {
+    auto result = join.computeResultOnlyForTesting(true);
+    ASSERT_FALSE(result.isFullyMaterialized());
+    size_t numBlocks = 0;
+    IdTable aggregate{3, makeAllocator()};
+    for (const auto& [idTable, localVocab] : result.idTables()) {
+      EXPECT_FALSE(idTable.empty());
+      aggregate.insertAtEnd(idTable);
+      ++numBlocks;
+    }
+    EXPECT_EQ(numBlocks, 2u);
+    EXPECT_THAT(toRows(aggregate),
+                ::testing::UnorderedElementsAreArray(expected));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, emptyBuildSide) {
+  auto* qec = getQec();
+  auto left = makeValues(qec, IdTable{2, makeAllocator()},
+                         {Variable{"?x"}, Variable{"?a"}});
+  auto right = makeValues(qec, makeIdTableFromVector({{100, 1}}),
+                          {Variable{"?b"}, Variable{"?x"}});
+  HashJoin join{qec, left, right, 0, 1, false};
+  auto result = join.computeResultOnlyForTesting();
+  EXPECT_TRUE(result.idTable().empty());
+  EXPECT_EQ(result.idTable().numColumns(), 3u);
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, memoryLimit) {
+  using namespace ad_utility::memory_literals;
+  using ad_utility::detail::AllocationExceedsLimitException;
+  IdTable table{1, makeAllocator()};
+  table.resize(10'000);
+  for (size_t i = 0; i < table.numRows(); ++i) {
+    table(i, 0) = IntId(static_cast<int64_t>(i));
+  }
+  auto noCancellation = []() {};
+  // Both the hash table of the build side and the matching rows count against
+  // the memory limit.
+  EXPECT_THROW((HashJoin::BuildSide{table, 0, makeAllocator(1_kB)}),
+               AllocationExceedsLimitException);
+  HashJoin::BuildSide buildSide{table, 0, makeAllocator()};
+  EXPECT_THROW(HashJoin::joinWithBuildSide(buildSide, true, table, 0,
+                                           makeAllocator(1_kB), noCancellation),
+               AllocationExceedsLimitException);
+  auto result = HashJoin::joinWithBuildSide(buildSide, true, table, 0,
+                                            makeAllocator(), noCancellation);
+  EXPECT_EQ(result.numRows(), table.numRows());
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, variablesAndCacheKey) {
+  auto* qec = getQec();
+  auto left = makeValues(qec, makeIdTableFromVector({{1, 10}}),
+                         {Variable{"?x"}, Variable{"?a"}});
+  auto right = makeValues(qec, makeIdTableFromVector({{100, 1}}),
+                          {Variable{"?b"}, Variable{"?x"}});
+  HashJoin join{qec, left, right, 0, 1, false};
+  const auto& varToCol = join.getExternallyVisibleVariableColumns();
+  EXPECT_EQ(varToCol.at(Variable{"?x"}).columnIndex_, 0u);
+  EXPECT_EQ(varToCol.at(Variable{"?a"}).columnIndex_, 1u);
+  EXPECT_EQ(varToCol.at(Variable{"?b"}).columnIndex_, 2u);
+  EXPECT_EQ(join.getDescriptor(), "HashJoin on ?x");
+  EXPECT_THAT(join.getCacheKey(), ::testing::StartsWith("HASH JOIN"));
+
+  // The order of the children doesn't depend on the order of the arguments.
+  HashJoin join2{qec, right, left, 1, 0};
+  HashJoin join3{qec, left, right, 0, 1};
+  EXPECT_EQ(join2.getCacheKey(), join3.getCacheKey());
+
+  // Joining on columns with different variables is not allowed.
+  EXPECT_ANY_THROW((HashJoin{qec, left, right, 1, 1, false}));
+}
@@ -0,0 +1,251 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <random>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "./ValuesForTesting.h"
+#include "engine/MultiwayJoin.h"
+#include "engine/QueryExecutionTree.h"
+#include "engine/Sort.h"
+
+using namespace ad_utility::testing;
+using ::testing::ElementsAre;
+
+namespace {
+using Vars = std::vector<std::optional<Variable>>;
+const Variable a{"?a"};
+const Variable b{"?b"};
+const Variable c{"?c"};
+const Variable d{"?d"};
+
+// Create a `ValuesForTesting` operation for the `table` with the `variables`.
+std::shared_ptr<QueryExecutionTree> makeValues(QueryExecutionContext* qec,
+                                               IdTable table, Vars variables) {
+  return ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(table), std::move(variables));
+}
+
+// Return the rows of the `table`.
+std::vector<std::vector<Id>> toRows(const IdTable& table) {
+  std::vector<std::vector<Id>> rows;
+  for (const auto& row : table) {
+    rows.emplace_back(row.begin(), row.end());
+  }
+  return rows;
+}
+
+// The triangles `(a, b, c)` with the edges `ab`, `bc`, and `ca` (with
+// multiplicities), computed naively.
+IdTable naiveTriangles(const IdTable& ab, const IdTable& bc,
+                       const IdTable& ca) {
+  IdTable result{3, makeAllocator()};
+  for (const auto& x : ab) {
+    for (const auto& y : bc) {
+      if (x[1] != y[0]) {
+        continue;
+      }
+      for (const auto& z : ca) {
+        if (z[0] == y[1] && z[1] == x[0]) {
+          result.push_back(std::array{x[0], x[1], y[1]});
+        }
+      }
+    }
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, computeVariableOrder) {
+  // The variable that is contained in the most inputs comes first, ties are
+  // broken by name.
+  EXPECT_THAT(MultiwayJoin::computeVariableOrder({{c, b}, {b, a}, {a, c}}),
+              ElementsAre(a, b, c));
+  EXPECT_THAT(
+      MultiwayJoin::computeVariableOrder({{a, d}, {d, b}, {d, c}, {b, c}}),
+      ElementsAre(d, b, c, a));
+  // Variables that are connected to the already chosen ones are preferred.
+  EXPECT_THAT(MultiwayJoin::computeVariableOrder({{a, b}, {c, d}, {d, a}}),
+              ElementsAre(a, d, b, c));
+}
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, triangle) {
+  auto* qec = getQec();
+  auto ab = makeIdTableFromVector({{1, 2}, {1, 3}, {2, 3}, {3, 1}, {4, 5}});
+  auto bc = makeIdTableFromVector({{2, 3}, {3, 1}, {1, 2}, {3, 4}, {5, 4}});
+  auto ca = makeIdTableFromVector({{3, 1}, {1, 2}, {2, 3}, {4, 4}});
+  // The inputs are not sorted, and the columns of `?c ?a` are in the opposite
+  // order of the default variable order, so all the inputs are sorted first.
+  MultiwayJoin join{qec,
+                    {makeValues(qec, ab.clone(), {a, b}),
+                     makeValues(qec, bc.clone(), {b, c}),
+                     makeValues(qec, ca.clone(), {c, a})}};
+  EXPECT_THAT(join.variableOrder(), ElementsAre(a, b, c));
+  EXPECT_EQ(join.getResultWidth(), 3u);
+  EXPECT_THAT(join.resultSortedOn(), ElementsAre(0, 1, 2));
+  EXPECT_EQ(join.getDescriptor(), "MultiwayJoin on ?a ?b ?c");
+  for (auto* child : join.getChildren()) {
+    EXPECT_NE(dynamic_cast<const Sort*>(child->getRootOperation().get()),
+              nullptr);
+  }
+  auto varToCol = join.getExternallyVisibleVariableColumns();
+  EXPECT_EQ(varToCol.at(a), makeAlwaysDefinedColumn(0));
+  EXPECT_EQ(varToCol.at(c), makeAlwaysDefinedColumn(2));
+
+  auto result = join.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(), makeIdTableFromVector({{1, 2, 3},
+                                                     {2, 3, 1},
+                                                     {3, 1, 2},
+                                                     {4, 5, 4}}));
+}
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, explicitOrderAndMultiplicities) {
+  auto* qec = getQec();
+  // The row `(1, 2)` of the first input occurs twice, and the row `(2)` of the
+  // third input occurs three times, so the single result row occurs six
+  // times. The last input has a column that is not contained in any other
+  // input.
+  auto ab = makeIdTableFromVector({{1, 2}, {1, 2}, {1, 3}});
+  auto bc = makeIdTableFromVector({{2, 7}, {3, 8}});
+  auto b2 = makeIdTableFromVector({{2}, {2}, {2}, {4}});
+  auto cd = makeIdTableFromVector({{7, 9}});
+  MultiwayJoin join{qec,
+                    {makeValues(qec, ab.clone(), {a, b}),
+                     makeValues(qec, bc.clone(), {b, c}),
+                     makeValues(qec, b2.clone(), {b}),
+                     makeValues(qec, cd.clone(), {c, d})},
+                    {b, c, a, d}};
+  auto result = join.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(), makeIdTableFromVector({{2, 7, 1, 9},
+                                                     {2, 7, 1, 9},
+                                                     {2, 7, 1, 9},
+                                                     {2, 7, 1, 9},
+                                                     {2, 7, 1, 9},
+                                                     {2, 7, 1, 9}}));
+
+  // Invalid variable orders.
+  auto makeJoin = [&](std::vector<Variable> order) {
+    return MultiwayJoin{qec,
+                        {makeValues(qec, ab.clone(), {a, b}),
+                         makeValues(qec, bc.clone(), {b, c})},
+                        std::move(order)};
+  };
+  EXPECT_ANY_THROW(makeJoin({a, b}));
+  EXPECT_ANY_THROW(makeJoin({a, b, c, c}));
+  EXPECT_ANY_THROW(makeJoin({a, b, c, d}));
+  EXPECT_NO_THROW(makeJoin({c, b, a}));
+}
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, emptyInputAndUndef) {
+  auto* qec = getQec();
+  auto ab = makeIdTableFromVector({{1, 2}});
+  auto bc = makeIdTableFromVector({{2, 3}});
+  IdTable empty{2, makeAllocator()};
+  MultiwayJoin join{qec,
+                    {makeValues(qec, ab.clone(), {a, b}),
+                     makeValues(qec, empty.clone(), {b, c}),
+                     makeValues(qec, bc.clone(), {c, a})}};
+  EXPECT_TRUE(join.knownEmptyResult());
+  EXPECT_EQ(join.getSizeEstimate(), 0u);
+  EXPECT_TRUE(join.computeResultOnlyForTesting().idTable().empty());
+
+  auto U = Id::makeUndefined();
+  auto withUndef = makeIdTableFromVector({{U, 2}});
+  auto makeJoinWithUndef = [&]() {
+    return MultiwayJoin{qec,
+                        {makeValues(qec, ab.clone(), {a, b}),
+                         makeValues(qec, withUndef.clone(), {b, c})}};
+  };
+  EXPECT_ANY_THROW(makeJoinWithUndef());
+}
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, estimates) {
+  auto* qec = getQec();
+  auto makeTable = [](size_t numRows) {
+    IdTable table{2, makeAllocator()};
+    for (size_t i = 0; i < numRows; ++i) {
+      auto id = Id::makeFromInt(static_cast<int64_t>(i));
+      table.push_back(std::array{id, id});
+    }
+    return table;
+  };
+  // For a triangle the AGM bound is `sqrt(4 * 9 * 16) = 24`, which is capped
+  // at the size of the largest input.
+  MultiwayJoin triangle{qec,
+                        {makeValues(qec, makeTable(4), {a, b}),
+                         makeValues(qec, makeTable(9), {b, c}),
+                         makeValues(qec, makeTable(16), {c, a})}};
+  EXPECT_EQ(triangle.getSizeEstimate(), 16u);
+  EXPECT_GE(triangle.getCostEstimate(), 16u + 4u + 9u + 16u);
+  EXPECT_GE(triangle.getMultiplicity(0), 1.0f);
+
+  // `?a` and `?c` are only contained in a single input, so these get the
+  // weight 1 and the bound is `2 * 3 = 6`, which is again capped.
+  MultiwayJoin path{qec,
+                    {makeValues(qec, makeTable(2), {a, b}),
+                     makeValues(qec, makeTable(3), {b, c})}};
+  EXPECT_EQ(path.getSizeEstimate(), 3u);
+
+  // The cache key depends on the variable order.
+  MultiwayJoin triangle2{qec,
+                         {makeValues(qec, makeTable(4), {a, b}),
+                          makeValues(qec, makeTable(9), {b, c}),
+                          makeValues(qec, makeTable(16), {c, a})},
+                         {c, b, a}};
+  EXPECT_NE(triangle.getCacheKey(), triangle2.getCacheKey());
+  auto clone = triangle.clone();
+  EXPECT_EQ(clone->getCacheKey(), triangle.getCacheKey());
+}
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, randomTriangles) {
+  auto* qec = getQec();
+  std::mt19937 rng{42};
+  for (size_t numNodes : {3, 10, 30}) {
+    std::uniform_int_distribution<int64_t> node{0,
+                                                static_cast<int64_t>(numNodes)};
+    auto randomEdges = [&]() {
+      IdTable table{2, makeAllocator()};
+      for (size_t i = 0; i < 3 * numNodes; ++i) {
+        table.push_back(std::array{Id::makeFromInt(node(rng)),
+                                   Id::makeFromInt(node(rng))});
+      }
+      return table;
+    };
+    auto ab = randomEdges();
+    auto bc = randomEdges();
+    auto ca = randomEdges();
+    auto expected = naiveTriangles(ab, bc, ca);
+    // Also use a variable order for which the result has a different column
+    // order.
+    for (auto order : {std::vector{a, b, c}, std::vector{c, a, b}}) {
+      MultiwayJoin join{qec,
+                        {makeValues(qec, ab.clone(), {a, b}),
+                         makeValues(qec, bc.clone(), {b, c}),
+                         makeValues(qec, ca.clone(), {c, a})},
+                        order};
+      auto result = join.computeResultOnlyForTesting();
+      std::vector<std::vector<Id>> rows;
+      for (const auto& row : result.idTable()) {
+        auto column = [&](const Variable& v) {
+          return row[ql::ranges::find(order, v) - order.begin()];
+        };
+        rows.push_back({column(a), column(b), column(c)});
+      }
+      EXPECT_TRUE(ql::ranges::is_sorted(toRows(result.idTable())));
+      EXPECT_THAT(rows, ::testing::UnorderedElementsAreArray(toRows(expected)));
+    }
+  }
+}
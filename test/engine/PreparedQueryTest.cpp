@@ -0,0 +1,114 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "engine/PreparedQuery.h"
+#include "engine/QueryExecutionTree.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+
+using namespace ad_utility::testing;
+
+namespace {
+using TC = TripleComponent;
+auto iri = [](std::string_view s) { return TC::Iri::fromIriref(s); };
+
+// Plan the query with a `QueryPlanner`.
+QueryExecutionTree planQuery(ParsedQuery& parsedQuery,
+                             QueryExecutionContext& qec) {
+  QueryPlanner qp{&qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+  return qp.createExecutionTree(parsedQuery);
+}
+
+// Create a `PreparedQuery` for the `query` with the `parameters`.
+PreparedQuery makePreparedQuery(QueryExecutionContext* qec,
+                                const std::string& query,
+                                std::vector<std::string> parameters) {
+  return PreparedQuery{
+      SparqlParser::parseQuery(&qec->getIndex().encodedIriManager(), query),
+      PreparedQuery::parseParameterNames(parameters)};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(PreparedQuery, bindAndExecute) {
+  auto* qec = getQec("<a> <p> <b> . <a> <p> <c> . <b> <p> <c> . <c> <q> 42 .");
+  qec->clearCacheUnpinnedOnly();
+  auto getId = makeGetId(qec->getIndex());
+  auto preparedQuery =
+      makePreparedQuery(qec, "SELECT ?y WHERE { ?x <p> ?y } ORDER BY ?y", {"x"});
+  EXPECT_THAT(preparedQuery.parameters(),
+              ::testing::ElementsAre(Variable{"?x"}));
+  auto createContext = [qec]() { return qec->shared_from_this(); };
+
+  auto execute = [&](std::string_view x) {
+    auto qet =
+        preparedQuery.bind({iri(x)}, *qec, createContext, planQuery).qet_;
+    EXPECT_TRUE(qet->isRoot());
+    auto result = qet->getResult();
+    return result->idTable().clone();
+  };
+  EXPECT_THAT(execute("<a>"),
+              matchesIdTable(makeIdTableFromVector(
+                  {{getId("<b>")}, {getId("<c>")}})));
+  EXPECT_THAT(execute("<b>"),
+              matchesIdTable(makeIdTableFromVector({{getId("<c>")}})));
+  EXPECT_EQ(execute("<c>").numRows(), 0u);
+  // The query was planned only once.
+  EXPECT_EQ(preparedQuery.numPlans(), 1u);
+
+  // The values are part of the cache keys.
+  auto cacheKey = [&](std::string_view x) {
+    return preparedQuery.bind({iri(x)}, *qec, createContext, planQuery)
+        .qet_->getCacheKey();
+  };
+  EXPECT_EQ(cacheKey("<a>"), cacheKey("<a>"));
+  EXPECT_NE(cacheKey("<a>"), cacheKey("<b>"));
+}
+
+// _____________________________________________________________________________
+TEST(PreparedQuery, parseValues) {
+  auto* qec = getQec();
+  auto preparedQuery = makePreparedQuery(
+      qec, "SELECT * WHERE { ?x ?p ?y }", {"?x", "$y"});
+  EXPECT_THAT(preparedQuery.parameters(),
+              ::testing::ElementsAre(Variable{"?x"}, Variable{"?y"}));
+  auto values = preparedQuery.parseValues({{"y", "\"text\"@en"}, {"x", "<x>"}});
+  ASSERT_EQ(values.size(), 2u);
+  EXPECT_EQ(values[0], iri("<x>"));
+  EXPECT_TRUE(values[1].isLiteral());
+
+  AD_EXPECT_THROW_WITH_MESSAGE(preparedQuery.parseValues({{"x", "<x>"}}),
+                               ::testing::HasSubstr("No value"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      preparedQuery.parseValues({{"x", "<x>"}, {"y", "1"}, {"z", "2"}}),
+      ::testing::HasSubstr("no parameter ?z"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      preparedQuery.parseValues({{"x", "<x>"}, {"y", "1"}, {"?y", "2"}}),
+      ::testing::HasSubstr("More than one value"));
+}
+
+// _____________________________________________________________________________
+TEST(PreparedQuery, invalidUsage) {
+  auto* qec = getQec();
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      makePreparedQuery(qec, "SELECT * WHERE { ?x ?p ?y }", {"x", "?x"}),
+      ::testing::HasSubstr("more than once"));
+
+  auto preparedQuery =
+      makePreparedQuery(qec, "SELECT * WHERE { ?x ?p ?y }", {"x"});
+  auto createContext = [qec]() { return qec->shared_from_this(); };
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      preparedQuery.bind({}, *qec, createContext, planQuery),
+      ::testing::HasSubstr("1 parameters, but 0 values"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      preparedQuery.bind({TC{Variable{"?z"}}}, *qec, createContext, planQuery),
+      ::testing::HasSubstr("must be an IRI or a literal"));
+  EXPECT_EQ(preparedQuery.numPlans(), 0u);
+}
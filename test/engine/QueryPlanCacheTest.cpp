@@ -0,0 +1,112 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "../util/IndexTestHelpers.h"
+#include "engine/QueryPlanCache.h"
+#include "parser/SparqlParser.h"
+
+using namespace ad_utility::testing;
+using ::testing::ElementsAre;
+
+namespace {
+using TC = TripleComponent;
+auto iri = [](std::string_view s) { return TC::Iri::fromIriref(s); };
+auto lit = [](std::string s) {
+  return TC{TC::Literal::fromStringRepresentation(std::move(s))};
+};
+
+// Return the texts of the candidates of the `query`.
+std::vector<std::string> candidates(std::string_view query) {
+  auto abstracted = QueryPlanCache::abstractConstants(query);
+  EXPECT_TRUE(abstracted.has_value());
+  std::vector<std::string> result;
+  for (size_t position : abstracted.value().candidatePositions_) {
+    result.push_back(abstracted.value().tokens_.at(position));
+  }
+  return result;
+}
+
+// Parse the `query` and get its `PreparedQuery` from the `cache`.
+auto getPreparedQuery(QueryPlanCache& cache, const std::string& query) {
+  const auto* encodedIriManager = &getQec()->getIndex().encodedIriManager();
+  return cache.getPreparedQuery(
+      SparqlParser::parseQuery(encodedIriManager, query), encodedIriManager);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, abstractConstants) {
+  EXPECT_THAT(candidates("SELECT * { <s> <p> \"o\" . ?x <q> 42 }"),
+              ElementsAre("<s>", "<p>", "\"o\"", "<q>", "42"));
+  // Constants in prefix declarations, `LIMIT`, `VALUES`, property paths,
+  // function calls and literals with language tags or datatypes.
+  EXPECT_THAT(candidates("PREFIX ex: <e> SELECT * { ?s ex:p/ex:q \"o\"@en . "
+                         "VALUES ?x { <a> } FILTER(ex:f(?x) = 3) } LIMIT 10"),
+              ::testing::IsEmpty());
+  EXPECT_THAT(candidates("SELECT * { ?s <p> \"1\"^^<int> }"),
+              ::testing::IsEmpty());
+
+  auto abstracted =
+      QueryPlanCache::abstractConstants("SELECT * { <s> <p> ?o }").value();
+  EXPECT_EQ(abstracted.skeleton(), "SELECT * { $ $ ?o }");
+  EXPECT_EQ(abstracted.instantiate({false, false}), "SELECT * { <s> <p> ?o }");
+  EXPECT_EQ(abstracted.instantiate({true, false}),
+            absl::StrCat("SELECT * { ",
+                         QueryPlanCache::parameterVariable(0).name(),
+                         " <p> ?o }"));
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, getPreparedQuery) {
+  QueryPlanCache cache{10};
+  auto a = getPreparedQuery(cache, "SELECT * { <a> <p> ?o . ?o <q> \"x\" }");
+  auto b = getPreparedQuery(cache, "SELECT * { <b> <p> ?o . ?o <q> \"y\" }");
+  ASSERT_TRUE(a.has_value());
+  ASSERT_TRUE(b.has_value());
+  // Both queries share the same `PreparedQuery`, the predicates are not
+  // parameters.
+  EXPECT_EQ(a->preparedQuery_, b->preparedQuery_);
+  EXPECT_EQ(a->preparedQuery_->parameters().size(), 2u);
+  EXPECT_THAT(a->values_, ElementsAre(iri("<a>"), lit("\"x\"")));
+  EXPECT_THAT(b->values_, ElementsAre(iri("<b>"), lit("\"y\"")));
+  EXPECT_EQ(cache.stats().numMisses_, 1u);
+  EXPECT_EQ(cache.stats().numHits_, 1u);
+
+  // Constants in a `FILTER` are not parameters, so queries that differ in them
+  // get different `PreparedQuery`s.
+  auto c = getPreparedQuery(cache, "SELECT * { <a> <p> ?o FILTER(?o != <x>) }");
+  auto d = getPreparedQuery(cache, "SELECT * { <b> <p> ?o FILTER(?o != <y>) }");
+  ASSERT_TRUE(c.has_value());
+  ASSERT_TRUE(d.has_value());
+  EXPECT_NE(c->preparedQuery_, d->preparedQuery_);
+  EXPECT_THAT(c->values_, ElementsAre(iri("<a>")));
+  EXPECT_THAT(d->values_, ElementsAre(iri("<b>")));
+
+  // Queries without constants in the top-level triples are not cached.
+  auto numUncacheable = cache.stats().numUncacheable_;
+  EXPECT_FALSE(getPreparedQuery(cache, "SELECT * { ?s ?p ?o }").has_value());
+  EXPECT_FALSE(
+      getPreparedQuery(cache, "SELECT * { ?s ?p ?o FILTER(?o = <x>) }")
+          .has_value());
+  EXPECT_EQ(cache.stats().numUncacheable_, numUncacheable + 2);
+
+  // After clearing, the `PreparedQuery` is created again.
+  cache.clear();
+  auto e = getPreparedQuery(cache, "SELECT * { <a> <p> ?o . ?o <q> \"x\" }");
+  ASSERT_TRUE(e.has_value());
+  EXPECT_NE(e->preparedQuery_, a->preparedQuery_);
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, disabled) {
+  QueryPlanCache cache{0};
+  EXPECT_FALSE(getPreparedQuery(cache, "SELECT * { <a> <p> ?o }").has_value());
+  cache.setMaxNumEntries(5);
+  EXPECT_TRUE(getPreparedQuery(cache, "SELECT * { <a> <p> ?o }").has_value());
+  cache.setMaxNumEntries(0);
+  EXPECT_FALSE(getPreparedQuery(cache, "SELECT * { <a> <p> ?o }").has_value());
+}
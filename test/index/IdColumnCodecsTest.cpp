@@ -0,0 +1,158 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "../util/GTestHelpers.h"
+#include "index/CompressedRelation.h"
+#include "index/IdColumnCodecs.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+
+namespace {
+constexpr std::array allCodecs{ColumnCodec::Zstd, ColumnCodec::FrameOfReference,
+                               ColumnCodec::Delta};
+
+// Convert a vector of integers to a vector of `Id`s with the same bits.
+std::vector<Id> toIds(const std::vector<uint64_t>& bits) {
+  std::vector<Id> result;
+  for (auto b : bits) {
+    result.push_back(Id::fromBits(b));
+  }
+  return result;
+}
+
+// Compress the `column` with all codecs, decompress it again and check that
+// the result is the original column. Also check that
+// `compressWithSmallestCodec` chooses a codec that is not larger than any of
+// the others.
+void testRoundTrip(const std::vector<Id>& column,
+                   ad_utility::source_location l = AD_CURRENT_SOURCE_LOC()) {
+  auto trace = generateLocationTrace(l);
+  size_t smallestSize = std::numeric_limits<size_t>::max();
+  for (auto codec : allCodecs) {
+    auto compressed = columnCodecs::compress(column, codec);
+    smallestSize = std::min(smallestSize, compressed.size());
+    std::vector<Id> decompressed(column.size());
+    columnCodecs::decompress(compressed, codec, decompressed);
+    EXPECT_EQ(decompressed, column) << static_cast<int>(codec);
+    // The size of the target has to match exactly.
+    std::vector<Id> tooLarge(column.size() + 1);
+    EXPECT_ANY_THROW(columnCodecs::decompress(compressed, codec, tooLarge));
+  }
+  auto [compressed, codec] = columnCodecs::compressWithSmallestCodec(column);
+  EXPECT_EQ(compressed.size(), smallestSize);
+  std::vector<Id> decompressed(column.size());
+  columnCodecs::decompress(compressed, codec, decompressed);
+  EXPECT_EQ(decompressed, column);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(IdColumnCodecs, RoundTrip) {
+  testRoundTrip({});
+  testRoundTrip(toIds({42}));
+  testRoundTrip(toIds({0, std::numeric_limits<uint64_t>::max(), 17}));
+
+  // Columns of different sizes, s.t. the last group of 64 values is full,
+  // almost full, or contains only a single value.
+  for (size_t size : {63, 64, 65, 128, 1000}) {
+    std::vector<uint64_t> constant(size, 0xABCD'0000'0000'0001);
+    testRoundTrip(toIds(constant));
+
+    std::vector<uint64_t> sorted;
+    for (size_t i = 0; i < size; ++i) {
+      sorted.push_back(1'000'000 + 3 * i + (i % 7));
+    }
+    testRoundTrip(toIds(sorted));
+
+    std::vector<uint64_t> descending(sorted.rbegin(), sorted.rend());
+    testRoundTrip(toIds(descending));
+
+    // Random values with all possible bit widths.
+    std::mt19937_64 randomEngine{size};
+    for (size_t bitWidth = 1; bitWidth <= 64; ++bitWidth) {
+      uint64_t mask = bitWidth == 64 ? ~uint64_t{0}
+                                     : (uint64_t{1} << bitWidth) - 1;
+      std::vector<uint64_t> random;
+      for (size_t i = 0; i < size; ++i) {
+        random.push_back((randomEngine() & mask) + 12345);
+      }
+      testRoundTrip(toIds(random));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(IdColumnCodecs, SmallestCodecIsChosen) {
+  std::vector<Id> constant(10'000, Id::fromBits(0x1234'5678'9ABC'DEF0));
+  auto [compressedConstant, codecConstant] =
+      columnCodecs::compressWithSmallestCodec(constant);
+  // A constant column needs no bits per value with the lightweight codecs.
+  EXPECT_EQ(codecConstant, ColumnCodec::FrameOfReference);
+  EXPECT_LT(compressedConstant.size(), 100U);
+
+  std::vector<Id> sorted;
+  for (uint64_t i = 0; i < 10'000; ++i) {
+    sorted.push_back(Id::fromBits((uint64_t{1} << 60) + 1000 * i + i / 2));
+  }
+  auto [compressedSorted, codecSorted] =
+      columnCodecs::compressWithSmallestCodec(sorted);
+  EXPECT_EQ(codecSorted, ColumnCodec::Delta);
+  // The deltas are `1000` or `1001` (after subtracting the minimum, at most
+  // one bit per value).
+  EXPECT_LT(compressedSorted.size(), 10'000U / 8 + 100);
+}
+
+// _____________________________________________________________________________
+TEST(IdColumnCodecs, CorruptedInput) {
+  std::vector<Id> target(5);
+  std::vector<char> tooShort(3);
+  EXPECT_ANY_THROW(columnCodecs::decompress(
+      tooShort, ColumnCodec::FrameOfReference, target));
+  EXPECT_ANY_THROW(
+      columnCodecs::decompress(tooShort, ColumnCodec::Delta, target));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      columnCodecs::decompress(tooShort, static_cast<ColumnCodec>(17), target),
+      ::testing::HasSubstr("Unknown codec"));
+}
+
+// _____________________________________________________________________________
+TEST(IdColumnCodecs, SerializationOfOffsetAndCompressedSize) {
+  using O = CompressedBlockMetadata::OffsetAndCompressedSize;
+  using namespace ad_utility::serialization;
+  auto roundTrip = [](const O& input) {
+    ByteBufferWriteSerializer writer;
+    writer << input;
+    ByteBufferReadSerializer reader{std::move(writer).data()};
+    O output{0, 0};
+    reader >> output;
+    return output;
+  };
+  for (auto codec : allCodecs) {
+    O input{42, 12345, codec};
+    EXPECT_EQ(roundTrip(input), input);
+  }
+
+  // The metadata of older indices consists only of the offset and the size,
+  // which must be read as `Zstd`.
+  ByteBufferWriteSerializer writer;
+  writer << off_t{42};
+  writer << size_t{12345};
+  ByteBufferReadSerializer reader{std::move(writer).data()};
+  O output{0, 0, ColumnCodec::Delta};
+  reader >> output;
+  EXPECT_EQ(output, (O{42, 12345, ColumnCodec::Zstd}));
+
+  // Unknown codecs (e.g. from a newer version of QLever) are rejected.
+  ByteBufferWriteSerializer writer2;
+  writer2 << off_t{42};
+  writer2 << ((size_t{17} << 56) | 12345);
+  ByteBufferReadSerializer reader2{std::move(writer2).data()};
+  AD_EXPECT_THROW_WITH_MESSAGE(reader2 >> output,
+                               ::testing::HasSubstr("Unknown column codec"));
+}
@@ -0,0 +1,133 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include "../util/AllocatorTestHelpers.h"
+#include "../util/IdTestHelpers.h"
+#include "engine/idTable/IdTable.h"
+#include "index/IdTableRadixSort.h"
+#include "index/IdTableUtils.h"
+
+using namespace ad_utility::testing;
+using ad_utility::radixSort::MIN_NUM_ROWS_FOR_RADIX_SORT;
+using ad_utility::radixSort::sortByBits;
+
+namespace {
+using Row = std::array<Id, 3>;
+
+// Return `numRows` random rows. The values are drawn from a small range, s.t.
+// there are many duplicates, and consist of different datatypes, s.t. also
+// the most significant bits differ.
+std::vector<Row> makeRandomRows(size_t numRows) {
+  std::mt19937_64 gen{42};
+  std::uniform_int_distribution<int64_t> dist{-300, 300};
+  auto randomId = [&]() {
+    int64_t value = dist(gen);
+    switch (value % 3) {
+      case 0:
+        return IntId(value);
+      case 1:
+        return DoubleId(static_cast<double>(value) / 7);
+      default:
+        return VocabId(std::abs(value));
+    }
+  };
+  std::vector<Row> rows(numRows);
+  for (auto& row : rows) {
+    ql::ranges::generate(row, randomId);
+  }
+  return rows;
+}
+
+// Convert the `rows` to an `IdTable` and back.
+IdTable toIdTable(const std::vector<Row>& rows) {
+  IdTable table{3, makeAllocator()};
+  for (const auto& row : rows) {
+    table.push_back(row);
+  }
+  return table;
+}
+std::vector<Row> toRows(const IdTable& table) {
+  std::vector<Row> rows;
+  for (const auto& row : table) {
+    rows.push_back({row[0], row[1], row[2]});
+  }
+  return rows;
+}
+
+// Sort the `rows` with a stable comparison-based sort by the `sortColumns`.
+std::vector<Row> stableSortByColumns(std::vector<Row> rows,
+                                     const std::vector<ColumnIndex>& cols) {
+  ql::ranges::stable_sort(rows, [&cols](const Row& a, const Row& b) {
+    for (auto col : cols) {
+      if (a[col] != b[col]) {
+        return a[col] < b[col];
+      }
+    }
+    return false;
+  });
+  return rows;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(IdTableRadixSort, sortsStablyByTheSortColumns) {
+  // Large enough s.t. multiple threads are actually used.
+  auto rows = makeRandomRows(4 * (1 << 16) + 17);
+  std::vector<std::vector<ColumnIndex>> allSortColumns{
+      {0}, {2}, {1, 0}, {2, 0, 1}, {0, 0}};
+  for (const auto& sortColumns : allSortColumns) {
+    auto expected = stableSortByColumns(rows, sortColumns);
+    for (size_t numThreads : {1u, 2u, 4u, 7u}) {
+      auto table = toIdTable(rows);
+      EXPECT_TRUE(sortByBits(table, sortColumns, numThreads));
+      EXPECT_EQ(toRows(table), expected);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(IdTableRadixSort, fallbackCases) {
+  // Small tables are not sorted.
+  auto smallRows = makeRandomRows(MIN_NUM_ROWS_FOR_RADIX_SORT - 1);
+  auto table = toIdTable(smallRows);
+  EXPECT_FALSE(sortByBits(table, {0}));
+  EXPECT_EQ(toRows(table), smallRows);
+
+  // Tables with a `LocalVocabIndex` in one of the sort columns are not sorted,
+  // because these are not compared by their bits.
+  auto rows = makeRandomRows(MIN_NUM_ROWS_FOR_RADIX_SORT + 1);
+  rows.at(42)[1] = LocalVocabId(3);
+  table = toIdTable(rows);
+  EXPECT_FALSE(sortByBits(table, {0, 1}));
+  EXPECT_EQ(toRows(table), rows);
+  // A `LocalVocabIndex` in another column doesn't matter.
+  EXPECT_TRUE(sortByBits(table, {2, 0}));
+  EXPECT_EQ(toRows(table), stableSortByColumns(rows, {2, 0}));
+
+  // No sort columns.
+  EXPECT_FALSE(sortByBits(table, {}));
+}
+
+// _____________________________________________________________________________
+TEST(IdTableRadixSort, idTableUtilsSort) {
+  // `IdTableUtils::sort` uses the radix sort for large tables, and the
+  // comparison-based sort for tables with a `LocalVocabIndex`. The result is
+  // the same in both cases (up to the order of equal rows).
+  auto rows = makeRandomRows(MIN_NUM_ROWS_FOR_RADIX_SORT + 100);
+  for (bool withLocalVocab : {false, true}) {
+    if (withLocalVocab) {
+      rows.at(7)[0] = LocalVocabId(5);
+    }
+    auto table = toIdTable(rows);
+    IdTableUtils::sort(table, {0, 1, 2});
+    EXPECT_EQ(toRows(table), stableSortByColumns(rows, {0, 1, 2}));
+  }
+}
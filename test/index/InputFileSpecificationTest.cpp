@@ -34,6 +34,7 @@ TEST(InputFileSpecification, FilenameSource) {
   EXPECT_EQ(spec.defaultGraph_, std::nullopt);
   EXPECT_FALSE(spec.parseInParallel_);
   EXPECT_FALSE(spec.parseInParallelSetExplicitly_);
+  EXPECT_EQ(spec.numDecompressionThreads_, DEFAULT_NUM_DECOMPRESSION_THREADS);
 }
 
 // _____________________________________________________________________________
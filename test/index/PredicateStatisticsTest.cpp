@@ -0,0 +1,187 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "../util/IdTestHelpers.h"
+#include "index/PredicateStatistics.h"
+#include "util/File.h"
+#include "util/HyperLogLog.h"
+
+using ad_utility::HyperLogLog;
+using ad_utility::testing::DoubleId;
+using ad_utility::testing::IntId;
+using ad_utility::testing::VocabId;
+using valueIdComparators::Comparison;
+
+namespace {
+// Build the statistics for the predicate `VocabId(1)` with the objects
+// `IntId(0), ..., IntId(numTriples - 1)`, and for the predicate `VocabId(2)`
+// with only a few triples.
+PredicateStatistics makeStatistics(size_t numTriples) {
+  PredicateStatistics::Builder builder{100};
+  for (size_t i = 0; i < numTriples; ++i) {
+    builder.addTriple(VocabId(1), IntId(static_cast<int64_t>(i)));
+  }
+  for (size_t i = 0; i < 10; ++i) {
+    builder.addTriple(VocabId(2), IntId(static_cast<int64_t>(i)));
+  }
+  return std::move(builder).finish();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, estimate) {
+  HyperLogLog empty;
+  EXPECT_DOUBLE_EQ(empty.estimate(), 0.0);
+
+  for (size_t numDistinct : {10, 100, 1'000, 100'000}) {
+    HyperLogLog sketch;
+    // Adding each value several times doesn't change the estimate.
+    for (size_t repetition = 0; repetition < 3; ++repetition) {
+      for (size_t i = 0; i < numDistinct; ++i) {
+        sketch.add(i);
+      }
+    }
+    // The relative standard error is about 6.5%.
+    EXPECT_NEAR(sketch.estimate(), static_cast<double>(numDistinct),
+                0.2 * static_cast<double>(numDistinct))
+        << numDistinct;
+  }
+}
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, merge) {
+  HyperLogLog a;
+  HyperLogLog b;
+  HyperLogLog both;
+  for (size_t i = 0; i < 10'000; ++i) {
+    (i % 2 == 0 ? a : b).add(i);
+    both.add(i);
+  }
+  EXPECT_NE(a, both);
+  a.merge(b);
+  EXPECT_EQ(a, both);
+  // Merging a sketch with itself doesn't change anything.
+  a.merge(both);
+  EXPECT_EQ(a, both);
+}
+
+// _____________________________________________________________________________
+TEST(PredicateStatistics, builder) {
+  auto statistics = makeStatistics(10'000);
+  // The second predicate has too few triples.
+  EXPECT_EQ(statistics.numPredicates(), 1);
+  EXPECT_EQ(statistics.getEntry(VocabId(2)), nullptr);
+  EXPECT_EQ(statistics.getEntry(VocabId(3)), nullptr);
+
+  const auto* entry = statistics.getEntry(VocabId(1));
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->numTriples_, 10'000);
+  auto numSamples = PredicateStatistics::numSamplesPerPredicate;
+  EXPECT_GE(entry->sample_.size(), numSamples);
+  EXPECT_LT(entry->sample_.size(), 2 * numSamples);
+  EXPECT_TRUE(ql::ranges::is_sorted(entry->sample_));
+  // The sample is evenly spaced.
+  const auto& sample = entry->sample_;
+  auto stride = sample.at(1).getInt() - sample.at(0).getInt();
+  EXPECT_EQ(sample.at(0), IntId(0));
+  for (size_t i = 1; i < sample.size(); ++i) {
+    EXPECT_EQ(sample.at(i).getInt() - sample.at(i - 1).getInt(), stride);
+  }
+  EXPECT_NEAR(entry->distinctObjects_.estimate(), 10'000, 2'000);
+
+  // A predicate that doesn't have enough triples for a sample of the full
+  // size contains all the values.
+  auto small = makeStatistics(100);
+  ASSERT_NE(small.getEntry(VocabId(1)), nullptr);
+  EXPECT_EQ(small.getEntry(VocabId(1))->sample_.size(), 100);
+}
+
+// _____________________________________________________________________________
+TEST(PredicateStatistics, estimateFraction) {
+  auto statistics = makeStatistics(10'000);
+  auto estimate = [&statistics](Comparison comparison, Id value) {
+    auto result = statistics.estimateFraction(VocabId(1), comparison, value);
+    EXPECT_TRUE(result.has_value());
+    return result.value_or(-1.0);
+  };
+  using enum Comparison;
+  EXPECT_NEAR(estimate(LT, IntId(1'000)), 0.1, 0.02);
+  EXPECT_NEAR(estimate(LE, IntId(5'000)), 0.5, 0.02);
+  EXPECT_NEAR(estimate(GT, DoubleId(7'500.5)), 0.25, 0.02);
+  EXPECT_NEAR(estimate(GE, IntId(0)), 1.0, 0.02);
+
+  // Ranges that contain no sample value still get a small estimate.
+  EXPECT_GT(estimate(LT, IntId(0)), 0.0);
+  EXPECT_LT(estimate(LT, IntId(0)), 0.01);
+  // Values of an incompatible datatype never match.
+  EXPECT_LT(estimate(LT, VocabId(17)), 0.01);
+
+  // Equality is estimated via the number of distinct values.
+  EXPECT_NEAR(estimate(EQ, IntId(42)), 1.0 / 10'000, 1.0 / 20'000);
+  EXPECT_NEAR(estimate(NE, IntId(42)), 1.0, 0.001);
+
+  // No statistics for the other predicates.
+  EXPECT_FALSE(statistics.estimateFraction(VocabId(2), LT, IntId(3)));
+  EXPECT_FALSE(statistics.estimateFraction(VocabId(3), LT, IntId(3)));
+}
+
+// _____________________________________________________________________________
+TEST(PredicateStatistics, frequentValues) {
+  // Half of the triples have the object `0`.
+  PredicateStatistics::Builder builder{100};
+  for (int64_t i = 0; i < 10'000; ++i) {
+    builder.addTriple(VocabId(1), IntId(i < 5'000 ? 0 : i));
+  }
+  auto statistics = std::move(builder).finish();
+  auto fraction = statistics.estimateFraction(VocabId(1), Comparison::EQ,
+                                              IntId(0));
+  ASSERT_TRUE(fraction.has_value());
+  EXPECT_NEAR(fraction.value(), 0.5, 0.02);
+}
+
+// _____________________________________________________________________________
+TEST(PredicateStatistics, delta) {
+  auto statistics = makeStatistics(10'000);
+  PredicateStatisticsDelta delta;
+  EXPECT_EQ(delta.getEntry(VocabId(1)), nullptr);
+  EXPECT_NEAR(statistics.estimateNumDistinctObjects(VocabId(1), delta).value(),
+              10'000, 2'000);
+
+  // Insert 10'000 triples with new objects and 10'000 triples with existing
+  // objects.
+  std::vector<IdTriple<0>> inserted;
+  for (int64_t i = 0; i < 20'000; ++i) {
+    inserted.emplace_back(
+        std::array{VocabId(100), VocabId(1), IntId(i), VocabId(0)});
+  }
+  delta.addTriples(inserted, true);
+  ASSERT_NE(delta.getEntry(VocabId(1)), nullptr);
+  EXPECT_EQ(delta.getEntry(VocabId(1))->numTriples_, 20'000);
+  EXPECT_NEAR(statistics.estimateNumDistinctObjects(VocabId(1), delta).value(),
+              20'000, 4'000);
+
+  // Deleted triples only change the number of triples.
+  delta.addTriples(ql::span<const IdTriple<0>>{inserted}.subspan(0, 5),
+                   false);
+  EXPECT_EQ(delta.getEntry(VocabId(1))->numTriples_, 19'995);
+
+  // There are no statistics for a predicate that only has delta triples.
+  EXPECT_FALSE(statistics.estimateNumDistinctObjects(VocabId(2), delta));
+
+  delta.clear();
+  EXPECT_EQ(delta.getEntry(VocabId(1)), nullptr);
+}
+
+// _____________________________________________________________________________
+TEST(PredicateStatistics, serialization) {
+  auto statistics = makeStatistics(1'000);
+  auto filename = "predicateStatisticsSerializationTest.dat";
+  statistics.writeToFile(filename);
+  auto readStatistics = PredicateStatistics::readFromFile(filename);
+  EXPECT_EQ(statistics, readStatistics);
+  ad_utility::deleteFile(filename);
+}
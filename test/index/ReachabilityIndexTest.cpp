@@ -0,0 +1,239 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <random>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTestHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "index/IndexImpl.h"
+#include "index/ReachabilityIndex.h"
+#include "util/File.h"
+#include "util/HashMap.h"
+#include "util/HashSet.h"
+
+using ::testing::UnorderedElementsAreArray;
+
+namespace {
+auto V = ad_utility::testing::VocabId;
+
+// The nodes that the `index` returns as reachable from the `start`.
+std::vector<Id> reachable(const ReachabilityIndex& index, Id start,
+                          bool forward, size_t minDist) {
+  std::vector<Id> result;
+  for (auto nodes : index.getReachableNodes(start, forward, minDist)) {
+    result.insert(result.end(), nodes.begin(), nodes.end());
+  }
+  return result;
+}
+
+// The nodes that are reachable from the `start` via a path of length at least
+// `minDist` (0 or 1), computed naively with a breadth-first search.
+std::vector<Id> naiveReachable(const std::vector<Id>& subjects,
+                               const std::vector<Id>& objects, Id start,
+                               bool forward, size_t minDist) {
+  ad_utility::HashMap<Id, std::vector<Id>> successors;
+  for (size_t i = 0; i < subjects.size(); ++i) {
+    auto [from, to] = forward ? std::pair{subjects[i], objects[i]}
+                              : std::pair{objects[i], subjects[i]};
+    successors[from].push_back(to);
+  }
+  ad_utility::HashSet<Id> seen;
+  std::vector<Id> frontier{start};
+  while (!frontier.empty()) {
+    std::vector<Id> next;
+    for (Id node : frontier) {
+      for (Id successor : successors[node]) {
+        if (seen.insert(successor).second) {
+          next.push_back(successor);
+        }
+      }
+    }
+    frontier = std::move(next);
+  }
+  // Only the nodes of the graph are reachable (see `getReachableNodes`).
+  bool isNode = ql::ranges::find(subjects, start) != subjects.end() ||
+                ql::ranges::find(objects, start) != objects.end();
+  if (minDist == 0 && isNode) {
+    seen.insert(start);
+  }
+  return {seen.begin(), seen.end()};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, smallGraph) {
+  // A chain `0 -> 1 -> 2` with a cycle `2 -> 3 -> 2`, a self loop `4 -> 4`,
+  // and a diamond `5 -> 6 -> 8`, `5 -> 7 -> 8`.
+  std::vector<Id> subjects{V(0), V(1), V(2), V(3), V(4), V(5), V(5), V(6),
+                           V(7)};
+  std::vector<Id> objects{V(1), V(2), V(3), V(2), V(4), V(6), V(7), V(8),
+                          V(8)};
+  ReachabilityIndex index{subjects, objects};
+  EXPECT_EQ(index.numNodes(), 9u);
+  EXPECT_EQ(index.numEdges(), 9u);
+
+  EXPECT_THAT(reachable(index, V(0), true, 0),
+              UnorderedElementsAreArray({V(0), V(1), V(2), V(3)}));
+  EXPECT_THAT(reachable(index, V(0), true, 1),
+              UnorderedElementsAreArray({V(1), V(2), V(3)}));
+  // The nodes on a cycle reach themselves.
+  EXPECT_THAT(reachable(index, V(2), true, 1),
+              UnorderedElementsAreArray({V(2), V(3)}));
+  EXPECT_THAT(reachable(index, V(4), true, 1), ::testing::ElementsAre(V(4)));
+  EXPECT_THAT(reachable(index, V(5), true, 1),
+              UnorderedElementsAreArray({V(6), V(7), V(8)}));
+  EXPECT_TRUE(reachable(index, V(8), true, 1).empty());
+  EXPECT_THAT(reachable(index, V(8), true, 0), ::testing::ElementsAre(V(8)));
+
+  // The reversed edges.
+  EXPECT_THAT(reachable(index, V(8), false, 1),
+              UnorderedElementsAreArray({V(5), V(6), V(7)}));
+  EXPECT_THAT(reachable(index, V(3), false, 0),
+              UnorderedElementsAreArray({V(0), V(1), V(2), V(3)}));
+  EXPECT_TRUE(reachable(index, V(0), false, 1).empty());
+
+  // Nodes that are not part of the graph are never reachable.
+  EXPECT_TRUE(reachable(index, V(42), true, 0).empty());
+  EXPECT_FALSE(index.reaches(V(42), V(42), true, 0));
+
+  EXPECT_TRUE(index.reaches(V(0), V(3), true, 1));
+  EXPECT_FALSE(index.reaches(V(3), V(0), true, 1));
+  EXPECT_TRUE(index.reaches(V(3), V(0), false, 1));
+  EXPECT_TRUE(index.reaches(V(0), V(0), true, 0));
+  EXPECT_FALSE(index.reaches(V(0), V(0), true, 1));
+  EXPECT_TRUE(index.reaches(V(3), V(3), true, 1));
+  EXPECT_TRUE(index.reaches(V(4), V(4), false, 1));
+  EXPECT_FALSE(index.reaches(V(6), V(7), true, 0));
+  EXPECT_FALSE(index.reaches(V(0), V(5), true, 0));
+
+  EXPECT_ANY_THROW(index.getReachableNodes(V(0), true, 2));
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, longPathAndEmptyGraph) {
+  // A path with 100k nodes would overflow the stack of a recursive search.
+  const size_t numNodes = 100'000;
+  std::vector<Id> subjects;
+  std::vector<Id> objects;
+  for (size_t i = 0; i + 1 < numNodes; ++i) {
+    subjects.push_back(V(i));
+    objects.push_back(V(i + 1));
+  }
+  ReachabilityIndex index{subjects, objects};
+  // All nodes of a path are in a single interval.
+  EXPECT_EQ(index.numIntervals(), 2 * numNodes);
+  EXPECT_EQ(reachable(index, V(0), true, 1).size(), numNodes - 1);
+  EXPECT_EQ(reachable(index, V(numNodes - 1), false, 0).size(), numNodes);
+  EXPECT_TRUE(index.reaches(V(0), V(numNodes - 1), true, 1));
+  EXPECT_FALSE(index.reaches(V(numNodes - 1), V(0), true, 1));
+
+  ReachabilityIndex empty{{}, {}};
+  EXPECT_EQ(empty.numNodes(), 0u);
+  EXPECT_TRUE(reachable(empty, V(0), true, 0).empty());
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, randomGraphs) {
+  std::mt19937 rng{42};
+  for (size_t numNodes : {5, 30, 200}) {
+    for (size_t edgesPerNode : {1, 2, 4}) {
+      std::uniform_int_distribution<size_t> node{0, numNodes - 1};
+      std::vector<Id> subjects;
+      std::vector<Id> objects;
+      for (size_t i = 0; i < numNodes * edgesPerNode; ++i) {
+        subjects.push_back(V(node(rng)));
+        objects.push_back(V(node(rng)));
+      }
+      ReachabilityIndex index{subjects, objects};
+      for (size_t i = 0; i < numNodes; ++i) {
+        for (bool forward : {true, false}) {
+          for (size_t minDist : {0, 1}) {
+            auto expected =
+                naiveReachable(subjects, objects, V(i), forward, minDist);
+            EXPECT_THAT(reachable(index, V(i), forward, minDist),
+                        UnorderedElementsAreArray(expected));
+            for (size_t j = 0; j < numNodes; ++j) {
+              EXPECT_EQ(index.reaches(V(i), V(j), forward, minDist),
+                        ql::ranges::find(expected, V(j)) != expected.end());
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndexes, addGetAndSerialize) {
+  ReachabilityIndexes indexes;
+  EXPECT_EQ(indexes.get(V(1)), nullptr);
+  std::vector<Id> subjects{V(0), V(1)};
+  std::vector<Id> objects{V(1), V(2)};
+  auto index = std::make_shared<const ReachabilityIndex>(subjects, objects);
+  indexes.add(V(1), index);
+  indexes.add(V(2), std::make_shared<const ReachabilityIndex>());
+  EXPECT_EQ(indexes.numPredicates(), 2u);
+  EXPECT_EQ(indexes.get(V(1)), index);
+  EXPECT_ANY_THROW(indexes.add(V(3), nullptr));
+
+  std::string filename = "reachabilityIndexesTest.dat";
+  indexes.writeToFile(filename, "fingerprint");
+  EXPECT_FALSE(std::filesystem::exists(filename + ".tmp"));
+  ReachabilityIndexes read;
+  // A file for an index with another fingerprint is rejected.
+  EXPECT_FALSE(read.readFromFile(filename, "otherFingerprint"));
+  EXPECT_EQ(read.numPredicates(), 0u);
+  EXPECT_TRUE(read.readFromFile(filename, "fingerprint"));
+  ad_utility::deleteFile(filename);
+  EXPECT_EQ(read.numPredicates(), 2u);
+  ASSERT_NE(read.get(V(1)), nullptr);
+  EXPECT_EQ(*read.get(V(1)), *index);
+  EXPECT_EQ(*read.get(V(2)), ReachabilityIndex{});
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndexes, buildFromIndex) {
+  std::string basename = "ReachabilityIndexesBuildFromIndex";
+  Index index = ad_utility::testing::makeTestIndex(
+      basename, "<a> <sub> <b> . <b> <sub> <c> . <c> <sub> <b> . "
+                "<x> <other> <a> .");
+  auto getId = ad_utility::testing::makeGetId(index);
+  auto& impl = index.getImpl();
+  EXPECT_EQ(impl.getReachabilityIndexes().numPredicates(), 0u);
+
+  auto reachabilityIndex = impl.buildReachabilityIndex("<sub>");
+  EXPECT_EQ(impl.getReachabilityIndexes().get(getId("<sub>")),
+            reachabilityIndex);
+  EXPECT_EQ(reachabilityIndex->numNodes(), 3u);
+  EXPECT_EQ(reachabilityIndex->numEdges(), 3u);
+  EXPECT_THAT(reachable(*reachabilityIndex, getId("<a>"), true, 1),
+              UnorderedElementsAreArray({getId("<b>"), getId("<c>")}));
+  EXPECT_THAT(reachable(*reachabilityIndex, getId("<b>"), false, 1),
+              UnorderedElementsAreArray(
+                  {getId("<a>"), getId("<b>"), getId("<c>")}));
+
+  // The index is written to disk and loaded with the index.
+  ReachabilityIndexes read;
+  EXPECT_TRUE(read.readFromFile(basename + ".reachability-index",
+                                impl.getIndexFingerprint()));
+  ASSERT_NE(read.get(getId("<sub>")), nullptr);
+  EXPECT_EQ(*read.get(getId("<sub>")), *reachabilityIndex);
+
+  AD_EXPECT_THROW_WITH_MESSAGE(impl.buildReachabilityIndex("<unknown>"),
+                               ::testing::HasSubstr("not contained"));
+  AD_EXPECT_THROW_WITH_MESSAGE(impl.buildReachabilityIndex("sub"),
+                               ::testing::HasSubstr("angle brackets"));
+
+  // Rebuilding the index deletes the reachability indexes of the previous
+  // build.
+  Index rebuilt = ad_utility::testing::makeTestIndex(
+      basename, "<a> <sub> <c> . <x> <other> <a> .");
+  EXPECT_FALSE(std::filesystem::exists(basename + ".reachability-index"));
+  EXPECT_EQ(rebuilt.getImpl().getReachabilityIndexes().numPredicates(), 0u);
+}
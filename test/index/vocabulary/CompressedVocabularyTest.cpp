@@ -134,6 +134,11 @@ TYPED_TEST(CompressedVocabularyF, AccessOperator) {
   testAccessOperatorForUnorderedVocabulary(this->createCompressedVocabulary());
 }
 
+// _______________________________________________________
+TYPED_TEST(CompressedVocabularyF, LookupBatch) {
+  testLookupBatchForUnorderedVocabulary(this->createCompressedVocabulary());
+}
+
 // _______________________________________________________
 TYPED_TEST(CompressedVocabularyF, EmptyVocabulary) {
   testEmptyVocabulary(this->createCompressedVocabulary());
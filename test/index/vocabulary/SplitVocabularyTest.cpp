@@ -313,6 +313,17 @@ TEST(Vocabulary, SplitVocabularyItemAt) {
   ASSERT_EQ(v[idx],
             "\"POLYGON((1 2, 3 4))\""
             "^^<http://www.opengis.net/ont/geosparql#wktLiteral>");
+
+  // A batch lookup can mix the indices of the underlying vocabularies.
+  std::vector<VocabIndex> indices{
+      VocabIndex::make(1ULL << 59), VocabIndex::make(3), VocabIndex::make(0),
+      VocabIndex::make((1ULL << 59) | 1), VocabIndex::make(1ULL << 59)};
+  auto words = v.lookupBatch(indices);
+  ASSERT_EQ(words->size(), indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    EXPECT_EQ((*words)[i], v[indices[i]]);
+  }
+  EXPECT_ANY_THROW(v.lookupBatch(std::vector{VocabIndex::make(42)}));
 }
 
 // _____________________________________________________________________________
@@ -45,6 +45,10 @@ TEST(VocabularyInMemory, AccessOperator) {
   testAccessOperatorForUnorderedVocabulary(createVocabulary);
 }
 
+TEST(VocabularyInMemory, LookupBatch) {
+  testLookupBatchForUnorderedVocabulary(createVocabulary);
+}
+
 TEST(VocabularyInMemory, ReadAndWriteFromFile) {
   const std::vector<std::string> words{"alpha", "delta", "beta", "42",
                                        "31",    "0",     "al"};
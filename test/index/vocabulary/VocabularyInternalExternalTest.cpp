@@ -111,6 +111,12 @@ TEST(VocabularyInternalExternal, AccessOperator) {
       createVocabularyFromDisk("AccessOperator2"));
 }
 
+TEST(VocabularyInternalExternal, LookupBatch) {
+  testLookupBatchForUnorderedVocabulary(createVocabulary("LookupBatch1"));
+  testLookupBatchForUnorderedVocabulary(
+      createVocabularyFromDisk("LookupBatch2"));
+}
+
 TEST(VocabularyInternalExternal, EmptyVocabulary) {
   testEmptyVocabulary(createVocabulary("EmptyVocabulary"));
 }
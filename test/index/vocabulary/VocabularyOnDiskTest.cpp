@@ -83,6 +83,15 @@ TEST(VocabularyOnDisk, AccessOperatorWithNonContiguousIds) {
       createVocabulary("AccessOperatorWithNonContiguousIds"));
 }
 
+TEST(VocabularyOnDisk, LookupBatch) {
+  testLookupBatchForUnorderedVocabulary(createVocabulary("LookupBatch"));
+
+  // Out of range indices.
+  auto vocab = createVocabulary("LookupBatchOutOfRange")(
+      std::vector<std::string>{"a", "b"});
+  EXPECT_ANY_THROW(vocab.lookupBatch(std::vector<uint64_t>{1, 2}));
+}
+
 TEST(VocabularyOnDisk, EmptyVocabulary) {
   testEmptyVocabulary(createVocabulary("EmptyVocabulary"));
 }
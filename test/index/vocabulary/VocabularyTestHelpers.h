@@ -247,6 +247,27 @@ auto testAccessOperatorForUnorderedVocabulary(F createVocabulary) {
   testAccessOperatorFromWordsAndIds(createVocabulary(words), words, ids);
 }
 
+// Check that `lookupBatch` works as expected for an unordered vocabulary,
+// created via `createVocabulary(std::vector<std::string>)`. The looked up
+// indices are unsorted and contain duplicates.
+template <typename F>
+auto testLookupBatchForUnorderedVocabulary(F createVocabulary) {
+  const std::vector<std::string> words{"alpha", "delta", "ALPHA", "beta", "42",
+                                       "31",    "0a",    "",      "al"};
+  auto vocabulary = createVocabulary(words);
+  auto expectLookupBatch = [&](const std::vector<uint64_t>& ids) {
+    auto result = vocabulary.lookupBatch(ids);
+    ASSERT_EQ(result->size(), ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+      EXPECT_EQ((*result)[i], words[ids[i]]) << "at position " << i;
+    }
+  };
+  expectLookupBatch({});
+  expectLookupBatch({3});
+  expectLookupBatch({0, 1, 2, 3, 4, 5, 6, 7, 8});
+  expectLookupBatch({8, 7, 3, 3, 0, 5, 8, 1, 7, 7});
+}
+
 // Check that an empty vocabulary, created via
 // `createVocabulary(std::vector<std::string>{})`, works as expected with the
 // given comparator.
@@ -4,9 +4,17 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <zstd.h>
+
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 
 #include "../util/GTestHelpers.h"
+#include "backports/StartsWithAndEndsWith.h"
 #include "parser/ParallelBuffer.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
 
 // ________________________________________________________
 TEST(ParallelBuffer, ParallelFileBuffer) {
@@ -116,3 +124,292 @@ TEST(ParallelBuffer, ParallelBufferWithEndRegexLongLookahead) {
   }
   ad_utility::deleteFile(filename);
 }
+
+namespace {
+// Write the `contents` to the file with the given name.
+void writeFile(const std::string& filename, std::string_view contents) {
+  auto of = ad_utility::makeOfstream(filename);
+  of.write(contents.data(), contents.size());
+}
+
+// Return the concatenation of all the blocks of the `buffer`.
+std::string readAll(ParallelBuffer& buffer) {
+  std::string result;
+  while (auto block = buffer.getNextBlock()) {
+    result.append(block->begin(), block->end());
+  }
+  return result;
+}
+
+// Some text that doesn't compress too well.
+std::string makeText(size_t numLines, size_t seed = 0) {
+  std::string result;
+  for (size_t i = 0; i < numLines; ++i) {
+    result += absl::StrCat("<s", (i * 7919 + seed) % 10007, "> <p> \"",
+                           i * i + seed, "\" .\n");
+  }
+  return result;
+}
+
+// Compress the `text` with gzip or bzip2 via `boost::iostreams`.
+std::string compressWithBoost(std::string_view text, CompressionFormat format) {
+  namespace io = boost::iostreams;
+  std::string result;
+  {
+    io::filtering_ostream stream;
+    if (format == CompressionFormat::Gzip) {
+      stream.push(io::gzip_compressor{});
+    } else {
+      stream.push(io::bzip2_compressor{});
+    }
+    stream.push(io::back_inserter(result));
+    stream.write(text.data(), text.size());
+  }
+  return result;
+}
+
+// Compress the `text` as a single zstd frame. If `storeContentSize` is false,
+// the size of the uncompressed content is not stored in the frame header.
+std::string compressWithZstd(std::string_view text,
+                             bool storeContentSize = true) {
+  if (storeContentSize) {
+    auto result = ZstdWrapper::compress(text.data(), text.size());
+    return {result.begin(), result.end()};
+  }
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{
+      ZSTD_createCCtx(), ZSTD_freeCCtx};
+  ZSTD_CCtx_setParameter(context.get(), ZSTD_c_contentSizeFlag, 0);
+  std::string result(ZSTD_compressBound(text.size()), '\0');
+  auto size = ZSTD_compress2(context.get(), result.data(), result.size(),
+                             text.data(), text.size());
+  EXPECT_FALSE(ZSTD_isError(size));
+  result.resize(size);
+  return result;
+}
+
+// A skippable zstd frame with the given `contents` (e.g. the seek table of
+// the seekable format).
+std::string skippableZstdFrame(std::string_view contents) {
+  std::string result{"\x50\x2a\x4d\x18"};
+  for (size_t i = 0; i < 4; ++i) {
+    result.push_back(static_cast<char>((contents.size() >> (8 * i)) & 0xff));
+  }
+  return absl::StrCat(result, contents);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ParallelBuffer, detectCompressionFormat) {
+  using enum CompressionFormat;
+  EXPECT_EQ(getCompressionFormatFromSuffix("data.ttl.gz"), Gzip);
+  EXPECT_EQ(getCompressionFormatFromSuffix("data.nt.bz2"), Bzip2);
+  EXPECT_EQ(getCompressionFormatFromSuffix("data.nq.zst"), Zstd);
+  EXPECT_EQ(getCompressionFormatFromSuffix("data.ttl"), None);
+  EXPECT_EQ(getCompressionFormatFromSuffix("/dev/stdin"), None);
+
+  // Without a known suffix, the magic bytes are used.
+  std::string filename = "parallelBufferDetectCompression.dat";
+  auto expectFormat = [&](std::string_view contents,
+                          CompressionFormat expected,
+                          ad_utility::source_location l =
+                              AD_CURRENT_SOURCE_LOC()) {
+    auto t = generateLocationTrace(l);
+    writeFile(filename, contents);
+    EXPECT_EQ(detectCompressionFormat(filename), expected);
+  };
+  auto text = makeText(10);
+  expectFormat(compressWithBoost(text, Gzip), Gzip);
+  expectFormat(compressWithBoost(text, Bzip2), Bzip2);
+  expectFormat(compressWithZstd(text), Zstd);
+  expectFormat(text, None);
+  expectFormat("ab", None);
+  expectFormat("", None);
+  ad_utility::deleteFile(filename);
+
+  // The suffix takes precedence, and files that don't exist have no format.
+  EXPECT_EQ(detectCompressionFormat("doesNotExist.zst"), Zstd);
+  EXPECT_EQ(detectCompressionFormat("doesNotExist.ttl"), None);
+}
+
+// _____________________________________________________________________________
+TEST(ParallelBuffer, decompressGzipAndBzip2) {
+  // Two concatenated members, like in a file that was written by `bgzip` or
+  // `pbzip2`.
+  auto first = makeText(1000);
+  auto second = makeText(500, 3);
+  for (auto [format, filename] :
+       {std::pair{CompressionFormat::Gzip, "parallelBufferTest.ttl.gz"},
+        std::pair{CompressionFormat::Bzip2, "parallelBufferTest.ttl.bz2"}}) {
+    writeFile(filename, absl::StrCat(compressWithBoost(first, format),
+                                     compressWithBoost(second, format)));
+    auto buffer = makeParallelFileBuffer(1000, filename);
+    EXPECT_EQ(buffer->getBlocksize(), 1000u);
+    ASSERT_NE(dynamic_cast<ParallelDecompressingFileBuffer*>(buffer.get()),
+              nullptr);
+    // All blocks except the last one are full.
+    std::string result;
+    while (auto block = buffer->getNextBlock()) {
+      result.append(block->begin(), block->end());
+      if (result.size() < first.size() + second.size()) {
+        EXPECT_EQ(block->size(), 1000u);
+      }
+    }
+    EXPECT_EQ(result, first + second);
+    EXPECT_FALSE(buffer->getNextBlock().has_value());
+
+    // Corrupt input.
+    writeFile(filename, absl::StrCat(compressWithBoost(first, format)
+                                         .substr(0, 20),
+                                     "garbage"));
+    ParallelDecompressingFileBuffer corrupt{1000, filename, format};
+    EXPECT_ANY_THROW(readAll(corrupt));
+    ad_utility::deleteFile(filename);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ParallelBuffer, decompressZstdFrames) {
+  std::string filename = "parallelBufferTest.nt.zst";
+  // Many small frames (as written by `pzstd` or in the seekable format), some
+  // without the content size, and skippable frames in between, followed by
+  // a frame that is larger than the blocksize.
+  std::string expected;
+  std::string compressed;
+  for (size_t i = 0; i < 50; ++i) {
+    auto text = makeText(10, i);
+    expected += text;
+    compressed += compressWithZstd(text, i % 3 != 0);
+    if (i % 10 == 0) {
+      compressed += skippableZstdFrame("seek table");
+    }
+  }
+  auto largeText = makeText(2000, 42);
+  auto largeFrame = compressWithZstd(largeText);
+  const size_t blocksize = 2000;
+  ASSERT_GT(largeFrame.size(), blocksize);
+
+  for (size_t numThreads : {1, 3, 8}) {
+    // Only small frames, which are decompressed in parallel.
+    writeFile(filename, compressed);
+    {
+      ParallelDecompressingFileBuffer buffer{blocksize, filename,
+                                             CompressionFormat::Zstd,
+                                             numThreads};
+      EXPECT_EQ(readAll(buffer), expected);
+    }
+    // The large frame is decompressed as a stream, the frames after it are
+    // again decompressed in parallel.
+    writeFile(filename, absl::StrCat(compressed, largeFrame, compressed));
+    {
+      ParallelDecompressingFileBuffer buffer{blocksize, filename,
+                                             CompressionFormat::Zstd,
+                                             numThreads};
+      EXPECT_EQ(readAll(buffer), absl::StrCat(expected, largeText, expected));
+    }
+  }
+
+  // A single large frame, as written by plain `zstd`.
+  writeFile(filename, largeFrame);
+  auto buffer = makeParallelFileBuffer(blocksize, filename);
+  EXPECT_EQ(readAll(*buffer), largeText);
+
+  // An empty file.
+  writeFile(filename, "");
+  EXPECT_EQ(readAll(*makeParallelFileBuffer(blocksize, filename)), "");
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(ParallelBuffer, decompressZstdBlockSizes) {
+  std::string filename = "parallelBufferBlockSizes.nt.zst";
+  const size_t blocksize = 2000;
+  // Check that the blocks of the decompressed `compressed` file are the
+  // `expected` text, and that all the blocks except for the last one have
+  // between `blocksize` and `2 * blocksize` bytes.
+  auto expectBlocks = [&](std::string_view compressed,
+                          std::string_view expected,
+                          ad_utility::source_location l =
+                              AD_CURRENT_SOURCE_LOC()) {
+    auto t = generateLocationTrace(l);
+    writeFile(filename, compressed);
+    ParallelDecompressingFileBuffer buffer{blocksize, filename,
+                                           CompressionFormat::Zstd, 3};
+    std::string result;
+    while (auto block = buffer.getNextBlock()) {
+      EXPECT_LE(block->size(), 2 * blocksize);
+      result.append(block->begin(), block->end());
+      if (result.size() < expected.size()) {
+        EXPECT_GE(block->size(), blocksize);
+      }
+    }
+    EXPECT_EQ(result, expected);
+  };
+
+  // Many frames that are much smaller than the blocksize are combined.
+  std::string expected;
+  std::string compressed;
+  for (size_t i = 0; i < 200; ++i) {
+    auto text = makeText(1, i);
+    expected += text;
+    compressed += compressWithZstd(text);
+  }
+  expectBlocks(compressed, expected);
+
+  // Frames with a high compression ratio don't yield huge blocks.
+  std::string repetitive(50 * blocksize, 'a');
+  auto repetitiveFrame = compressWithZstd(repetitive);
+  ASSERT_LT(repetitiveFrame.size(), blocksize);
+  expectBlocks(absl::StrCat(compressed, repetitiveFrame, compressed),
+               absl::StrCat(expected, repetitive, expected));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(ParallelBuffer, decompressZstdErrors) {
+  std::string filename = "parallelBufferErrors.zst";
+  auto read = [&filename](std::string_view contents) {
+    writeFile(filename, contents);
+    ParallelDecompressingFileBuffer buffer{2000, filename,
+                                           CompressionFormat::Zstd};
+    return readAll(buffer);
+  };
+  auto smallFrame = compressWithZstd(makeText(10));
+  auto largeFrame = compressWithZstd(makeText(2000));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      read(smallFrame.substr(0, smallFrame.size() - 3)),
+      ::testing::HasSubstr("incomplete frame"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      read(largeFrame.substr(0, largeFrame.size() - 3)),
+      ::testing::HasSubstr("incomplete frame"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      read(absl::StrCat(smallFrame, "no zstd frame")),
+      ::testing::HasSubstr("Error while decompressing zstd"));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(ParallelBuffer, ParallelBufferWithEndRegexOnCompressedInput) {
+  std::string filename = "parallelBufferWithEndRegex.ttl.zst";
+  auto text = makeText(1000);
+  // Also frames that are smaller than a single statement (and therefore
+  // contain no statement end) are fine, because they are combined.
+  for (size_t frameSize : {300, 7}) {
+    std::string compressed;
+    for (size_t i = 0; i < text.size(); i += frameSize) {
+      compressed +=
+          compressWithZstd(std::string_view{text}.substr(i, frameSize));
+    }
+    writeFile(filename, compressed);
+    ParallelBufferWithEndRegex buffer{makeParallelFileBuffer(1000, filename),
+                                      "(\\.\\n)"};
+    std::string result;
+    while (auto block = buffer.getNextBlock()) {
+      // Each block ends with a complete statement.
+      EXPECT_TRUE(ql::ends_with(
+          std::string_view{block->data(), block->size()}, ".\n"));
+      result.append(block->begin(), block->end());
+    }
+    EXPECT_EQ(result, text);
+  }
+  ad_utility::deleteFile(filename);
+}